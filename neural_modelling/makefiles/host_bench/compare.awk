@@ -0,0 +1,59 @@
+# Copyright (c) 2026 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+# Tabulates the saved output of "make run" from two builds, as
+#
+#     awk -f compare.awk before.txt after.txt
+#
+# giving the cost of each measurement in both and the change; measurements
+# that are in only one of them are listed with a "-" for the other.  The
+# lines of each result are fixed width up to the number of events, which
+# names the measurement, and the cost is the second to last field.
+
+function key() {
+    return substr($0, 1, 57)
+}
+
+FNR == 1 {
+    file++
+}
+
+/ events / {
+    if (file == 1) {
+        before[key()] = $(NF - 1)
+    } else {
+        after[key()] = $(NF - 1)
+        order[++n] = key()
+        unit = $NF
+    }
+}
+
+END {
+    printf "%-57s %10s %10s %8s\n", "", "before", "after", "change"
+    for (i = 1; i <= n; i++) {
+        k = order[i]
+        if (k in before) {
+            printf "%-57s %10.2f %10.2f %+7.1f%%\n", k, before[k], after[k],
+                (before[k] > 0) ? 100 * (after[k] - before[k]) / before[k] : 0
+            delete before[k]
+        } else {
+            printf "%-57s %10s %10.2f %8s\n", k, "-", after[k], ""
+        }
+    }
+    for (k in before) {
+        printf "%-57s %10.2f %10s %8s\n", k, before[k], "-", ""
+    }
+    printf "(%s)\n", unit
+}
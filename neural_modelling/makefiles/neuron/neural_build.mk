@@ -52,6 +52,181 @@ endif
 #POPULATION_TABLE_IMPL := fixed
 POPULATION_TABLE_IMPL := binary_search
 
+# The number of recently matched population table entries to check before
+# searching the table; 0 disables the cache
+ifndef POP_TABLE_CACHE_SIZE
+    POP_TABLE_CACHE_SIZE = 4
+endif
+
+# Whether to add the weights of pairs of fixed synapses to adjacent neurons in
+# one operation; needs rows sorted by target neuron to be of any benefit
+ifndef PACKED_FIXED_SYNAPSES
+    PACKED_FIXED_SYNAPSES = 0
+endif
+
+# Whether the ring buffers accumulate in 32 bits rather than 16, for
+# populations with a very high fan-in; this doubles their DTCM and needs the
+# host to be told with the wide_ring_buffers option
+ifndef RING_BUFFER_32_BIT
+    RING_BUFFER_32_BIT = 0
+endif
+CFLAGS += -DRING_BUFFER_32_BIT=$(RING_BUFFER_32_BIT)
+
+# Whether the ring buffers hold an entry for exactly each neuron rather than
+# for the next power of two, so that more neurons or delay slots fit in DTCM;
+# this needs the host to be told with the compact_ring_buffers option
+ifndef COMPACT_RING_BUFFERS
+    COMPACT_RING_BUFFERS = 0
+endif
+CFLAGS += -DCOMPACT_RING_BUFFERS=$(COMPACT_RING_BUFFERS)
+
+# Whether the standard neuron implementation updates all neurons one stage at
+# a time from contiguous per-neuron arrays rather than one neuron at a time
+ifndef NEURON_SOA_UPDATE
+    NEURON_SOA_UPDATE = 0
+endif
+
+# Whether the standard neuron implementation skips the update of neurons that
+# have settled with no input (where the neuron components support it)
+ifndef NEURON_QUIESCENT_SKIP
+    NEURON_QUIESCENT_SKIP = 0
+endif
+
+# Whether the standard neuron implementation advances LIF neurons with
+# exponential current synapses over all the sub-steps of a timestep at once
+ifndef NEURON_CLOSED_FORM_SUB_STEPS
+    NEURON_CLOSED_FORM_SUB_STEPS = 0
+endif
+
+# Whether the standard neuron implementation converts the conductances of all
+# the receptors of a LIF or Izhikevich neuron to one current in a single pass
+ifndef NEURON_FUSED_CONDUCTANCE
+    NEURON_FUSED_CONDUCTANCE = 0
+endif
+
+# Whether the DC, AC and step current sources are worked out once per timestep
+# rather than for each neuron they are attached to
+ifndef CURRENT_SOURCE_PRECOMPUTE
+    CURRENT_SOURCE_PRECOMPUTE = 0
+endif
+
+# Whether AC current sources take the sine from a table by phase rather than
+# working it out each time
+ifndef AC_SOURCE_WAVETABLE
+    AC_SOURCE_WAVETABLE = 0
+endif
+
+# The number of normal samples drawn ahead for each noisy current source at the
+# end of each timestep (a power of 2); 0 draws each one as it is needed
+ifndef NOISY_SOURCE_POOL_SIZE
+    NOISY_SOURCE_POOL_SIZE = 0
+endif
+
+# Whether the stochastic threshold and neuron models look up the probability
+# of spiking in a table of quantised values made at initialisation
+ifndef STOCHASTIC_PROBABILITY_TABLE
+    STOCHASTIC_PROBABILITY_TABLE = 0
+endif
+
+# Whether to hold one copy of the input type and constant threshold type for
+# all the neurons of a core when every neuron has the same values
+ifndef NEURON_SHARED_PARAMETERS
+    NEURON_SHARED_PARAMETERS = 0
+endif
+
+# Whether to keep the LIF reset voltage and refractory time, which are only
+# used when a neuron spikes, in SDRAM rather than DTCM
+ifndef NEURON_COLD_PARAMETERS
+    NEURON_COLD_PARAMETERS = 0
+endif
+
+# Whether the LIF and Izhikevich models hold their membrane state in 16 bits
+# (s8.7, saturating) rather than 32
+ifndef NEURON_SHORT_STATE
+    NEURON_SHORT_STATE = 0
+endif
+
+# Whether the Izhikevich model takes one Euler step well below the spike
+# upstroke, and midpoint sub-steps only near it, rather than one midpoint
+# step every time
+ifndef NEURON_IZH_ADAPTIVE_STEP
+    NEURON_IZH_ADAPTIVE_STEP = 0
+endif
+
+# Whether alpha synapses are shaped by exact two-state propagators, with the
+# propagators shared by all the neurons of a core when they are the same
+ifndef SYNAPSE_ALPHA_EXACT
+    SYNAPSE_ALPHA_EXACT = 0
+endif
+CFLAGS += -DSYNAPSE_ALPHA_EXACT=$(SYNAPSE_ALPHA_EXACT)
+
+# Whether to keep the neuron state in DTCM on resume when the host has not
+# written new parameters, rather than loading it again from SDRAM
+ifndef NEURON_HOT_RESUME
+    NEURON_HOT_RESUME = 0
+endif
+
+# Whether to take changes to parameters from the host over SDP while running
+ifndef NEURON_LIVE_PARAMETERS
+    NEURON_LIVE_PARAMETERS = 0
+endif
+
+# Whether to send the spikes of a timestep together after all the neurons have
+# been updated, and if so whether to send repeated spikes as a payload count
+ifndef SPIKE_SEND_BATCHED
+    SPIKE_SEND_BATCHED = 0
+endif
+ifndef SPIKE_SEND_PAYLOAD
+    SPIKE_SEND_PAYLOAD = 0
+endif
+ifndef NEURON_RECORDING_BATCH
+    NEURON_RECORDING_BATCH = 1
+endif
+
+# Whether STDP remembers the last window of post-synaptic events found for
+# each neuron, so that rows in the same timestep with the same window reuse it
+ifndef STDP_POST_WINDOW_CACHE
+    STDP_POST_WINDOW_CACHE = 0
+endif
+
+# Whether to use the specialised synapse update for the STDP timing and weight
+# rules of the binary, where there is one (pair or nearest pair timing with
+# additive or multiplicative weights); 0 always uses the generic update
+ifndef STDP_FUSED_KERNELS
+    STDP_FUSED_KERNELS = 1
+endif
+
+# Whether structural plasticity rejects rewiring attempts that can't change
+# anything before reading the synaptic row; this changes the random draws
+ifndef SYNAPTOGENESIS_EARLY_REJECT
+    SYNAPTOGENESIS_EARLY_REJECT = 0
+endif
+
+# Whether the distance dependent formation rule looks up the probability in a
+# table by the distance in each dimension, made from the grid shape at
+# initialisation
+ifndef FORMATION_DISTANCE_TABLE
+    FORMATION_DISTANCE_TABLE = 0
+endif
+
+# Whether structural plasticity only rewires in the periods after spikes have
+# been received by the core
+ifndef SYNAPTOGENESIS_ACTIVITY_GATED
+    SYNAPTOGENESIS_ACTIVITY_GATED = 0
+endif
+
+# Whether random partner selection chooses the sub-population from an alias
+# table rather than by searching
+ifndef PARTNER_ALIAS_TABLE
+    PARTNER_ALIAS_TABLE = 0
+endif
+
+# The most rewires whose rows are read together in one DMA, when the rows
+# are close enough in SDRAM to fit in one buffer; 1 reads each row on its own
+ifndef REWIRE_BATCH_SIZE
+    REWIRE_BATCH_SIZE = 1
+endif
+
 # Add source directory
 
 # Define the directories
@@ -254,27 +429,33 @@ $(BUILD_DIR)neuron/c_main.o: $(MODIFIED_DIR)neuron/c_main.c
 $(BUILD_DIR)neuron/synapses.o: $(MODIFIED_DIR)neuron/synapses.c
 	#synapses.c
 	-@mkdir -p $(dir $@)
-	$(SYNAPSE_TYPE_COMPILE) -o $@ $<
+	$(SYNAPSE_TYPE_COMPILE) -DPACKED_FIXED_SYNAPSES=$(PACKED_FIXED_SYNAPSES) -o $@ $<
 
 $(BUILD_DIR)neuron/spike_processing.o: $(MODIFIED_DIR)neuron/spike_processing.c
 	#spike_processing.c
 	-@mkdir -p $(dir $@)
-	$(SYNAPSE_TYPE_COMPILE) -o $@ $<
+	$(SYNAPSE_TYPE_COMPILE) -DREWIRE_BATCH_SIZE=$(REWIRE_BATCH_SIZE) -o $@ $<
 
 $(BUILD_DIR)neuron/population_table/population_table_binary_search_impl.o: $(MODIFIED_DIR)neuron/population_table/population_table_binary_search_impl.c
 	#population_table/population_table_binary_search_impl.c
 	-@mkdir -p $(dir $@)
-	$(SYNAPSE_TYPE_COMPILE) -o $@ $<
+	$(SYNAPSE_TYPE_COMPILE) -DPOP_TABLE_CACHE_SIZE=$(POP_TABLE_CACHE_SIZE) -o $@ $<
 
 SYNGEN_INCLUDES:=
 ifeq ($(SYNGEN_ENABLED), 1)
-    SYNGEN_INCLUDES:= -include $(PARTNER_SELECTION_H) -include $(FORMATION_H) -include $(ELIMINATION_H)
+    SYNGEN_INCLUDES:= -include $(PARTNER_SELECTION_H) -include $(FORMATION_H) -include $(ELIMINATION_H) \
+            -DSYNAPTOGENESIS_EARLY_REJECT=$(SYNAPTOGENESIS_EARLY_REJECT) \
+            -DFORMATION_DISTANCE_TABLE=$(FORMATION_DISTANCE_TABLE) \
+            -DSYNAPTOGENESIS_ACTIVITY_GATED=$(SYNAPTOGENESIS_ACTIVITY_GATED) \
+            -DPARTNER_ALIAS_TABLE=$(PARTNER_ALIAS_TABLE)
 endif
 
 #STDP Build rules If and only if STDP used
 ifeq ($(STDP_ENABLED), 1)
     STDP_INCLUDES:= -include $(WEIGHT_DEPENDENCE_H) -include $(TIMING_DEPENDENCE_H)
-    STDP_COMPILE = $(CC) -DLOG_LEVEL=$(PLASTIC_DEBUG) $(CFLAGS) -DSTDP_ENABLED=$(STDP_ENABLED) -DSYNGEN_ENABLED=$(SYNGEN_ENABLED) $(STDP_INCLUDES)
+    STDP_COMPILE = $(CC) -DLOG_LEVEL=$(PLASTIC_DEBUG) $(CFLAGS) -DSTDP_ENABLED=$(STDP_ENABLED) -DSYNGEN_ENABLED=$(SYNGEN_ENABLED) \
+            -DSTDP_POST_WINDOW_CACHE=$(STDP_POST_WINDOW_CACHE) \
+            -DSTDP_FUSED_KERNELS=$(STDP_FUSED_KERNELS) $(STDP_INCLUDES)
 
     $(SYNAPSE_DYNAMICS_O): $(SYNAPSE_DYNAMICS_C)
 	# SYNAPSE_DYNAMICS_O stdp
@@ -321,12 +502,14 @@ $(PARTNER_SELECTION_O): $(PARTNER_SELECTION_C) $(SYNAPSE_TYPE_H) $(MAKEFILE_LIST
 	# PARTNER_SELECTION_O
 	-mkdir -p $(dir $@)
 	$(CC) -DLOG_LEVEL=$(PLASTIC_DEBUG) $(CFLAGS) \
+	        -DPARTNER_ALIAS_TABLE=$(PARTNER_ALIAS_TABLE) \
 	        -include $(SYNAPSE_TYPE_H) -o $@ $<
 
 $(FORMATION_O): $(FORMATION_C) $(SYNAPSE_TYPE_H) $(MAKEFILE_LIST)
 	# FORMATION_O
 	-mkdir -p $(dir $@)
 	$(CC) -DLOG_LEVEL=$(PLASTIC_DEBUG) $(CFLAGS) \
+	        -DFORMATION_DISTANCE_TABLE=$(FORMATION_DISTANCE_TABLE) \
 	        -include $(SYNAPSE_TYPE_H) -o $@ $<
 
 $(ELIMINATION_O): $(ELIMINATION_C) $(SYNAPSE_TYPE_H) $(MAKEFILE_LIST)
@@ -338,6 +521,24 @@ $(ELIMINATION_O): $(ELIMINATION_C) $(SYNAPSE_TYPE_H) $(MAKEFILE_LIST)
 $(BUILD_DIR)neuron/neuron.o: $(MODIFIED_DIR)neuron/neuron.c $(NEURON_INCLUDE_FILES) $(MAKEFILE_LIST)
 	# neuron.o
 	-@mkdir -p $(dir $@)
-	$(CC) -DLOG_LEVEL=$(NEURON_DEBUG) $(CFLAGS) $(NEURON_INCLUDES) -o $@ $<
+	$(CC) -DLOG_LEVEL=$(NEURON_DEBUG) $(CFLAGS) \
+	        -DNEURON_SOA_UPDATE=$(NEURON_SOA_UPDATE) \
+	        -DNEURON_QUIESCENT_SKIP=$(NEURON_QUIESCENT_SKIP) \
+	        -DNEURON_CLOSED_FORM_SUB_STEPS=$(NEURON_CLOSED_FORM_SUB_STEPS) \
+	        -DNEURON_FUSED_CONDUCTANCE=$(NEURON_FUSED_CONDUCTANCE) \
+	        -DCURRENT_SOURCE_PRECOMPUTE=$(CURRENT_SOURCE_PRECOMPUTE) \
+	        -DAC_SOURCE_WAVETABLE=$(AC_SOURCE_WAVETABLE) \
+	        -DNOISY_SOURCE_POOL_SIZE=$(NOISY_SOURCE_POOL_SIZE) \
+	        -DSTOCHASTIC_PROBABILITY_TABLE=$(STOCHASTIC_PROBABILITY_TABLE) \
+	        -DNEURON_SHARED_PARAMETERS=$(NEURON_SHARED_PARAMETERS) \
+	        -DNEURON_COLD_PARAMETERS=$(NEURON_COLD_PARAMETERS) \
+	        -DNEURON_SHORT_STATE=$(NEURON_SHORT_STATE) \
+	        -DNEURON_IZH_ADAPTIVE_STEP=$(NEURON_IZH_ADAPTIVE_STEP) \
+	        -DNEURON_HOT_RESUME=$(NEURON_HOT_RESUME) \
+	        -DNEURON_LIVE_PARAMETERS=$(NEURON_LIVE_PARAMETERS) \
+	        -DSPIKE_SEND_BATCHED=$(SPIKE_SEND_BATCHED) \
+	        -DSPIKE_SEND_PAYLOAD=$(SPIKE_SEND_PAYLOAD) \
+	        -DNEURON_RECORDING_BATCH=$(NEURON_RECORDING_BATCH) \
+	        $(NEURON_INCLUDES) -o $@ $<
 
 .PRECIOUS: $(MODIFIED_DIR)%.c $(MODIFIED_DIR)%.h $(LOG_DICT_FILE) $(EXTRA_PRECIOUS)
@@ -39,6 +39,117 @@ ifndef NEURON_DEBUG
     NEURON_DEBUG = LOG_INFO
 endif
 
+# Whether the standard neuron implementation updates all neurons one stage at
+# a time from contiguous per-neuron arrays rather than one neuron at a time
+ifndef NEURON_SOA_UPDATE
+    NEURON_SOA_UPDATE = 0
+endif
+
+# Whether the standard neuron implementation skips the update of neurons that
+# have settled with no input (where the neuron components support it)
+ifndef NEURON_QUIESCENT_SKIP
+    NEURON_QUIESCENT_SKIP = 0
+endif
+
+# Whether the standard neuron implementation advances LIF neurons with
+# exponential current synapses over all the sub-steps of a timestep at once
+ifndef NEURON_CLOSED_FORM_SUB_STEPS
+    NEURON_CLOSED_FORM_SUB_STEPS = 0
+endif
+
+# Whether the standard neuron implementation converts the conductances of all
+# the receptors of a LIF or Izhikevich neuron to one current in a single pass
+ifndef NEURON_FUSED_CONDUCTANCE
+    NEURON_FUSED_CONDUCTANCE = 0
+endif
+
+# Whether the DC, AC and step current sources are worked out once per timestep
+# rather than for each neuron they are attached to
+ifndef CURRENT_SOURCE_PRECOMPUTE
+    CURRENT_SOURCE_PRECOMPUTE = 0
+endif
+
+# Whether AC current sources take the sine from a table by phase rather than
+# working it out each time
+ifndef AC_SOURCE_WAVETABLE
+    AC_SOURCE_WAVETABLE = 0
+endif
+
+# The number of normal samples drawn ahead for each noisy current source at the
+# end of each timestep (a power of 2); 0 draws each one as it is needed
+ifndef NOISY_SOURCE_POOL_SIZE
+    NOISY_SOURCE_POOL_SIZE = 0
+endif
+
+# Whether the stochastic threshold and neuron models look up the probability
+# of spiking in a table of quantised values made at initialisation
+ifndef STOCHASTIC_PROBABILITY_TABLE
+    STOCHASTIC_PROBABILITY_TABLE = 0
+endif
+
+# Whether to hold one copy of the input type and constant threshold type for
+# all the neurons of a core when every neuron has the same values
+ifndef NEURON_SHARED_PARAMETERS
+    NEURON_SHARED_PARAMETERS = 0
+endif
+
+# Whether to keep the LIF reset voltage and refractory time, which are only
+# used when a neuron spikes, in SDRAM rather than DTCM
+ifndef NEURON_COLD_PARAMETERS
+    NEURON_COLD_PARAMETERS = 0
+endif
+
+# Whether the LIF and Izhikevich models hold their membrane state in 16 bits
+# (s8.7, saturating) rather than 32
+ifndef NEURON_SHORT_STATE
+    NEURON_SHORT_STATE = 0
+endif
+
+# Whether the Izhikevich model takes one Euler step well below the spike
+# upstroke, and midpoint sub-steps only near it, rather than one midpoint
+# step every time
+ifndef NEURON_IZH_ADAPTIVE_STEP
+    NEURON_IZH_ADAPTIVE_STEP = 0
+endif
+
+# Whether alpha synapses are shaped by exact two-state propagators, with the
+# propagators shared by all the neurons of a core when they are the same
+ifndef SYNAPSE_ALPHA_EXACT
+    SYNAPSE_ALPHA_EXACT = 0
+endif
+CFLAGS += -DSYNAPSE_ALPHA_EXACT=$(SYNAPSE_ALPHA_EXACT)
+
+# Whether the synapse cores send their inputs to the neuron core as a list of
+# the non-zero words when few are non-zero, rather than always as a whole
+# block; the synapse and neuron binaries must agree on this
+ifndef SYNAPSE_SPARSE_TRANSFER
+    SYNAPSE_SPARSE_TRANSFER = 0
+endif
+CFLAGS += -DSYNAPSE_SPARSE_TRANSFER=$(SYNAPSE_SPARSE_TRANSFER)
+
+# Whether to keep the neuron state in DTCM on resume when the host has not
+# written new parameters, rather than loading it again from SDRAM
+ifndef NEURON_HOT_RESUME
+    NEURON_HOT_RESUME = 0
+endif
+
+# Whether to take changes to parameters from the host over SDP while running
+ifndef NEURON_LIVE_PARAMETERS
+    NEURON_LIVE_PARAMETERS = 0
+endif
+
+# Whether to send the spikes of a timestep together after all the neurons have
+# been updated, and if so whether to send repeated spikes as a payload count
+ifndef SPIKE_SEND_BATCHED
+    SPIKE_SEND_BATCHED = 0
+endif
+ifndef SPIKE_SEND_PAYLOAD
+    SPIKE_SEND_PAYLOAD = 0
+endif
+ifndef NEURON_RECORDING_BATCH
+    NEURON_RECORDING_BATCH = 1
+endif
+
 # Add source directory
 
 # Define the directories
@@ -155,6 +266,24 @@ $(BUILD_DIR)neuron/neuron.o: $(MODIFIED_DIR)neuron/neuron.c $(NEURON_MODEL_H) \
                              $(SYNAPSE_TYPE_H)
 	# neuron.o
 	-@mkdir -p $(dir $@)
-	$(CC) -DLOG_LEVEL=$(NEURON_DEBUG) $(CFLAGS) $(NEURON_INCLUDES) -o $@ $<
+	$(CC) -DLOG_LEVEL=$(NEURON_DEBUG) $(CFLAGS) \
+	        -DNEURON_SOA_UPDATE=$(NEURON_SOA_UPDATE) \
+	        -DNEURON_QUIESCENT_SKIP=$(NEURON_QUIESCENT_SKIP) \
+	        -DNEURON_CLOSED_FORM_SUB_STEPS=$(NEURON_CLOSED_FORM_SUB_STEPS) \
+	        -DNEURON_FUSED_CONDUCTANCE=$(NEURON_FUSED_CONDUCTANCE) \
+	        -DCURRENT_SOURCE_PRECOMPUTE=$(CURRENT_SOURCE_PRECOMPUTE) \
+	        -DAC_SOURCE_WAVETABLE=$(AC_SOURCE_WAVETABLE) \
+	        -DNOISY_SOURCE_POOL_SIZE=$(NOISY_SOURCE_POOL_SIZE) \
+	        -DSTOCHASTIC_PROBABILITY_TABLE=$(STOCHASTIC_PROBABILITY_TABLE) \
+	        -DNEURON_SHARED_PARAMETERS=$(NEURON_SHARED_PARAMETERS) \
+	        -DNEURON_COLD_PARAMETERS=$(NEURON_COLD_PARAMETERS) \
+	        -DNEURON_SHORT_STATE=$(NEURON_SHORT_STATE) \
+	        -DNEURON_IZH_ADAPTIVE_STEP=$(NEURON_IZH_ADAPTIVE_STEP) \
+	        -DNEURON_HOT_RESUME=$(NEURON_HOT_RESUME) \
+	        -DNEURON_LIVE_PARAMETERS=$(NEURON_LIVE_PARAMETERS) \
+	        -DSPIKE_SEND_BATCHED=$(SPIKE_SEND_BATCHED) \
+	        -DSPIKE_SEND_PAYLOAD=$(SPIKE_SEND_PAYLOAD) \
+	        -DNEURON_RECORDING_BATCH=$(NEURON_RECORDING_BATCH) \
+	        $(NEURON_INCLUDES) -o $@ $<
 
 .PRECIOUS: $(MODIFIED_DIR)%.c $(MODIFIED_DIR)%.h $(LOG_DICT_FILE) $(EXTRA_PRECIOUS)
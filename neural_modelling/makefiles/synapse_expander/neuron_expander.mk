@@ -18,4 +18,16 @@ SOURCES = synapse_expander/rng.c \
           synapse_expander/param_generator.c \
           synapse_expander/neuron_expander.c
 
+# Set to 1 to use xoshiro128++ rather than MARS KISS 64 random numbers
+ifndef EXPANDER_RNG_XOSHIRO
+    EXPANDER_RNG_XOSHIRO = 0
+endif
+CFLAGS += -DEXPANDER_RNG_XOSHIRO=$(EXPANDER_RNG_XOSHIRO)
+
+# Set to 1 to generate normal and exponential parameters from tables
+ifndef EXPANDER_PARAM_TABLES
+    EXPANDER_PARAM_TABLES = 0
+endif
+CFLAGS += -DEXPANDER_PARAM_TABLES=$(EXPANDER_PARAM_TABLES)
+
 include ../neural_support.mk
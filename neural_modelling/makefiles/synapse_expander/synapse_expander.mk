@@ -22,4 +22,23 @@ SOURCES = synapse_expander/rng.c \
           synapse_expander/synapse_expander.c \
           neuron/population_table/population_table_binary_search_impl.c
 
+# Set to 1 to use xoshiro128++ rather than MARS KISS 64 random numbers
+ifndef EXPANDER_RNG_XOSHIRO
+    EXPANDER_RNG_XOSHIRO = 0
+endif
+CFLAGS += -DEXPANDER_RNG_XOSHIRO=$(EXPANDER_RNG_XOSHIRO)
+
+# Set to 1 to generate normal and exponential parameters from tables
+ifndef EXPANDER_PARAM_TABLES
+    EXPANDER_PARAM_TABLES = 0
+endif
+CFLAGS += -DEXPANDER_PARAM_TABLES=$(EXPANDER_PARAM_TABLES)
+
+# Set to 1 to let the expander cores of a chip share the rows they generate;
+# needs EXPANDER_RNG_XOSHIRO=1
+ifndef EXPANDER_WORK_SHARING
+    EXPANDER_WORK_SHARING = 0
+endif
+CFLAGS += -DEXPANDER_WORK_SHARING=$(EXPANDER_WORK_SHARING)
+
 include ../neural_support.mk
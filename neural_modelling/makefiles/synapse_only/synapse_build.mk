@@ -47,6 +47,113 @@ endif
 #POPULATION_TABLE_IMPL := fixed
 POPULATION_TABLE_IMPL := binary_search
 
+# The number of recently matched population table entries to check before
+# searching the table; 0 disables the cache
+ifndef POP_TABLE_CACHE_SIZE
+    POP_TABLE_CACHE_SIZE = 4
+endif
+
+# Whether to add the weights of pairs of fixed synapses to adjacent neurons in
+# one operation; needs rows sorted by target neuron to be of any benefit
+ifndef PACKED_FIXED_SYNAPSES
+    PACKED_FIXED_SYNAPSES = 0
+endif
+
+# The maximum number of adjacent synaptic rows to read in a single DMA
+ifndef MAX_ROWS_PER_DMA
+    MAX_ROWS_PER_DMA = 4
+endif
+
+# Whether to clear the ring buffer entries of a time step just after they are
+# transferred to the neuron core, rather than at the start of the next step
+ifndef FUSED_RING_BUFFER_CLEAR
+    FUSED_RING_BUFFER_CLEAR = 0
+endif
+
+# The number of synaptic rows to keep in DTCM; plastic rows and the rows of
+# sources hinted as hot by the host are kept, and plastic rows are written
+# back only when evicted or the simulation pauses; 0 disables the cache
+ifndef SYNAPTIC_ROW_CACHE_SIZE
+    SYNAPTIC_ROW_CACHE_SIZE = 0
+endif
+
+# The number of plastic rows whose pre-synaptic history is kept in DTCM
+# rather than written back, when no post-synaptic event changed the rest of
+# the row; these are written back when the simulation pauses; 0 disables this
+ifndef SYNAPSE_DEFERRED_HISTORY_SIZE
+    SYNAPSE_DEFERRED_HISTORY_SIZE = 0
+endif
+
+# The number of plastic row write backs that can wait for the read of the
+# next rows while the rows after them, such as static rows, are processed;
+# 0 waits for the read before each write back
+ifndef SYNAPSE_WRITE_BACK_QUEUE_SIZE
+    SYNAPSE_WRITE_BACK_QUEUE_SIZE = 0
+endif
+
+# Whether to move the point at which the ring buffers are transferred to the
+# neuron core each time step, later when spikes are left waiting and there
+# was time to spare, and earlier when the transfer ran over the time step
+ifndef SYNAPSE_ADAPTIVE_TRANSFER
+    SYNAPSE_ADAPTIVE_TRANSFER = 0
+endif
+
+# Whether to receive multicast packets by polling the communications controller
+# during spike processing rather than with an interrupt for each packet, for
+# cores that receive so many packets that the interrupts limit them
+ifndef SYNAPSE_POLLED_RECEIVE
+    SYNAPSE_POLLED_RECEIVE = 0
+endif
+
+# Whether the synapse cores send their inputs to the neuron core as a list of
+# the non-zero words when few are non-zero, rather than always as a whole
+# block; the synapse and neuron binaries must agree on this
+ifndef SYNAPSE_SPARSE_TRANSFER
+    SYNAPSE_SPARSE_TRANSFER = 0
+endif
+CFLAGS += -DSYNAPSE_SPARSE_TRANSFER=$(SYNAPSE_SPARSE_TRANSFER)
+
+# Whether the post-synaptic spikes of each neuron are applied to its plastic
+# synapses while the core has nothing else to do, using an index of the
+# synapses of each neuron made by the synapse expander, rather than only when
+# the row of a synapse is next read; only for STDP MAD synapse dynamics
+ifndef STDP_EAGER_POST
+    STDP_EAGER_POST = 0
+endif
+CFLAGS += -DSTDP_EAGER_POST=$(STDP_EAGER_POST)
+
+# Whether synapses with delays too long for the ring buffers can be added into
+# a larger ring buffer in SDRAM, which is added to the ring buffers in DTCM
+# before each transfer; synapse_delay_wheel must also be set in the config
+ifndef SYNAPSE_DELAY_WHEEL
+    SYNAPSE_DELAY_WHEEL = 0
+endif
+
+# Whether structural plasticity rejects rewiring attempts that can't change
+# anything before reading the synaptic row; this changes the random draws
+ifndef SYNAPTOGENESIS_EARLY_REJECT
+    SYNAPTOGENESIS_EARLY_REJECT = 0
+endif
+
+# Whether the distance dependent formation rule looks up the probability in a
+# table by the distance in each dimension, made from the grid shape at
+# initialisation
+ifndef FORMATION_DISTANCE_TABLE
+    FORMATION_DISTANCE_TABLE = 0
+endif
+
+# Whether structural plasticity only rewires in the periods after spikes have
+# been received by the core
+ifndef SYNAPTOGENESIS_ACTIVITY_GATED
+    SYNAPTOGENESIS_ACTIVITY_GATED = 0
+endif
+
+# Whether random partner selection chooses the sub-population from an alias
+# table rather than by searching
+ifndef PARTNER_ALIAS_TABLE
+    PARTNER_ALIAS_TABLE = 0
+endif
+
 # Add source directory
 
 # Define the directories
@@ -139,6 +246,10 @@ else
 endif
 SYNAPTOGENESIS_DYNAMICS_O := $(BUILD_DIR)$(SYNAPTOGENESIS_DYNAMICS:%.c=%.o)
 
+ifeq ($(STDP_EAGER_POST)$(SYNGEN_ENABLED), 11)
+    $(error STDP_EAGER_POST can't be used with SYNAPTOGENESIS_DYNAMICS, as rewiring would leave the index of the synapses of each neuron out of date)
+endif
+
 ifdef PARTNER_SELECTION
     PARTNER_SELECTION_H := $(call replace_source_dirs,$(PARTNER_SELECTION_H))
     PARTNER_SELECTION_C := $(call replace_source_dirs,$(PARTNER_SELECTION))
@@ -181,7 +292,8 @@ DO_COMPILE = $(CC) -DLOG_LEVEL=$(SYNAPSE_DEBUG) $(CFLAGS) -DSTDP_ENABLED=$(STDP_
 $(BUILD_DIR)neuron/synapses.o: $(MODIFIED_DIR)neuron/synapses.c
 	#synapses.c
 	-@mkdir -p $(dir $@)
-	$(DO_COMPILE) -o $@ $<
+	$(DO_COMPILE) -DPACKED_FIXED_SYNAPSES=$(PACKED_FIXED_SYNAPSES) \
+	        -DSYNAPSE_DELAY_WHEEL=$(SYNAPSE_DELAY_WHEEL) -o $@ $<
 
 $(BUILD_DIR)neuron/direct_synapses.o: $(MODIFIED_DIR)neuron/direct_synapses.c
 	#direct_synapses.c
@@ -191,16 +303,26 @@ $(BUILD_DIR)neuron/direct_synapses.o: $(MODIFIED_DIR)neuron/direct_synapses.c
 $(BUILD_DIR)neuron/spike_processing_fast.o: $(MODIFIED_DIR)neuron/spike_processing_fast.c
 	#spike_processing_fast.c
 	-@mkdir -p $(dir $@)
-	$(DO_COMPILE) -o $@ $<
+	$(DO_COMPILE) -DMAX_ROWS_PER_DMA=$(MAX_ROWS_PER_DMA) \
+	        -DFUSED_RING_BUFFER_CLEAR=$(FUSED_RING_BUFFER_CLEAR) \
+	        -DSYNAPTIC_ROW_CACHE_SIZE=$(SYNAPTIC_ROW_CACHE_SIZE) \
+	        -DSYNAPSE_DEFERRED_HISTORY_SIZE=$(SYNAPSE_DEFERRED_HISTORY_SIZE) \
+	        -DSYNAPSE_WRITE_BACK_QUEUE_SIZE=$(SYNAPSE_WRITE_BACK_QUEUE_SIZE) \
+	        -DSYNAPSE_ADAPTIVE_TRANSFER=$(SYNAPSE_ADAPTIVE_TRANSFER) \
+	        -DSYNAPSE_POLLED_RECEIVE=$(SYNAPSE_POLLED_RECEIVE) -o $@ $<
 
 $(BUILD_DIR)neuron/population_table/population_table_binary_search_impl.o: $(MODIFIED_DIR)neuron/population_table/population_table_binary_search_impl.c
 	#population_table/population_table_binary_search_impl.c
 	-@mkdir -p $(dir $@)
-	$(DO_COMPILE) -o $@ $<
+	$(DO_COMPILE) -DPOP_TABLE_CACHE_SIZE=$(POP_TABLE_CACHE_SIZE) -o $@ $<
 
 SYNGEN_INCLUDES:=
 ifeq ($(SYNGEN_ENABLED), 1)
-    SYNGEN_INCLUDES:= -include $(PARTNER_SELECTION_H) -include $(FORMATION_H) -include $(ELIMINATION_H)
+    SYNGEN_INCLUDES:= -include $(PARTNER_SELECTION_H) -include $(FORMATION_H) -include $(ELIMINATION_H) \
+            -DSYNAPTOGENESIS_EARLY_REJECT=$(SYNAPTOGENESIS_EARLY_REJECT) \
+            -DFORMATION_DISTANCE_TABLE=$(FORMATION_DISTANCE_TABLE) \
+            -DSYNAPTOGENESIS_ACTIVITY_GATED=$(SYNAPTOGENESIS_ACTIVITY_GATED) \
+            -DPARTNER_ALIAS_TABLE=$(PARTNER_ALIAS_TABLE)
 endif
 
 #STDP Build rules If and only if STDP used
@@ -250,12 +372,14 @@ $(TIMING_DEPENDENCE_O): $(TIMING_DEPENDENCE_C) $(WEIGHT_DEPENDENCE_H)
 $(PARTNER_SELECTION_O): $(PARTNER_SELECTION_C)
 	# PARTNER_SELECTION_O
 	-mkdir -p $(dir $@)
-	$(CC) -DLOG_LEVEL=$(PLASTIC_DEBUG) $(CFLAGS) -o $@ $<
+	$(CC) -DLOG_LEVEL=$(PLASTIC_DEBUG) $(CFLAGS) \
+	        -DPARTNER_ALIAS_TABLE=$(PARTNER_ALIAS_TABLE) -o $@ $<
 
 $(FORMATION_O): $(FORMATION_C)
 	# FORMATION_O
 	-mkdir -p $(dir $@)
-	$(CC) -DLOG_LEVEL=$(PLASTIC_DEBUG) $(CFLAGS) -o $@ $<
+	$(CC) -DLOG_LEVEL=$(PLASTIC_DEBUG) $(CFLAGS) \
+	        -DFORMATION_DISTANCE_TABLE=$(FORMATION_DISTANCE_TABLE) -o $@ $<
 
 $(ELIMINATION_O): $(ELIMINATION_C)
 	# ELIMINATION_O
@@ -16,69 +16,168 @@
 
 //! \file
 //! \brief Functions for immediate handling of incoming spikes.
+//!
+//! The spikes are held in a ring with one writer, the packet received
+//! callback, and one reader, the spike processing loop.  Each side only
+//! writes its own index, and each index is a single word, so on the
+//! single-core ARM968 neither side needs to disable interrupts to use the
+//! ring; the reader only needs to do so when it must be sure that the ring
+//! is empty at the same time as it changes some other state.
 
 #ifndef _IN_SPIKES_H_
 #define _IN_SPIKES_H_
 
 #include "neuron-typedefs.h"
-#include <circular_buffer.h>
+#include <spin1_api.h>
+#include <debug.h>
+
+//! \brief Stops the compiler moving memory accesses across this point, so
+//!     that a spike is in the ring before the index that makes it visible
+//!     moves on, and is read before the index that frees its space does
+#define IN_SPIKES_BARRIER() __asm__ volatile("" ::: "memory")
+
+//! A ring of spikes with a single writer and a single reader
+typedef struct in_spikes_ring_t {
+    //! Where the next spike is added; only written by the writer
+    volatile uint32_t input;
+    //! Where the next spike is taken from; only written by the reader
+    volatile uint32_t output;
+    //! The size of the ring minus one, to wrap the indices
+    uint32_t mask;
+    //! The number of spikes that could not be added as the ring was full
+    uint32_t n_overflows;
+    //! The spikes
+    spike_t *spikes;
+} in_spikes_ring_t;
 
 //! \brief Buffer for quickly taking spikes received by a fast interrupt and
 //! queueing them for later processing by less critical code.
-static circular_buffer buffer;
+static in_spikes_ring_t buffer;
 
 //! \brief This function initialises the input spike buffer.
 //!
-//! It configures:
-//! <dl>
-//!    <dt>::buffer</dt>
-//!    <dd>the buffer to hold the spikes (initialised with size spaces)</dd>
-//!    <dt>input</dt>
-//!    <dd>index for next spike inserted into buffer</dd>
-//!    <dt>output</dt>
-//!    <dd>index for next spike extracted from buffer</dd>
-//!    <dt>overflows</dt>
-//!    <dd>a counter for the number of times the buffer overflows</dd>
-//!    <dt>underflows</dt>
-//!    <dd>a counter for the number of times the buffer underflows</dd>
-//! </dl>
-//! If underflows is ever non-zero, then there is a problem with this code.
+//! One space of the ring is always left empty, so that a full ring can be
+//! told apart from an empty one.
 //!
 //! \param[in] size: The number of spikes we expect to handle in the buffer;
 //!     this should be a power of 2 (and will be increased to the next one up
 //!     if it isn't).
 //! \return True if the buffer was successfully initialised
 static inline bool in_spikes_initialize_spike_buffer(uint32_t size) {
-    buffer = circular_buffer_initialize(size);
-    return buffer != 0;
+    uint32_t real_size = 1;
+    while (real_size < size) {
+        real_size <<= 1;
+    }
+    buffer.spikes = spin1_malloc(real_size * sizeof(spike_t));
+    if (buffer.spikes == NULL) {
+        log_error("Could not allocate input spike buffer of %u spikes",
+                real_size);
+        return false;
+    }
+    buffer.input = 0;
+    buffer.output = 0;
+    buffer.mask = real_size - 1;
+    buffer.n_overflows = 0;
+    return true;
 }
 
 //! \brief Adds a spike to the input spike buffer.
+//! \details Must only be called by the writer.
 //! \param[in] spike: The spike to add
 //! \return True if the spike was added
 static inline bool in_spikes_add_spike(spike_t spike) {
-    return circular_buffer_add(buffer, spike);
+    uint32_t input = buffer.input;
+    uint32_t next = (input + 1) & buffer.mask;
+    if (next == buffer.output) {
+        buffer.n_overflows++;
+        return false;
+    }
+    buffer.spikes[input] = spike;
+    IN_SPIKES_BARRIER();
+    buffer.input = next;
+    return true;
 }
 
 //! \brief Retrieves a spike from the input spike buffer.
+//! \details Must only be called by the reader.
 //! \param[out] spike: The spike that was retrieved.
 //! \return True if a spike was retrieved, false if the buffer was empty.
 static inline bool in_spikes_get_next_spike(spike_t* spike) {
-    return circular_buffer_get_next(buffer, spike);
+    uint32_t output = buffer.output;
+    if (output == buffer.input) {
+        return false;
+    }
+    *spike = buffer.spikes[output];
+    IN_SPIKES_BARRIER();
+    buffer.output = (output + 1) & buffer.mask;
+    return true;
+}
+
+//! \brief Retrieves as many spikes as are available from the input spike
+//!     buffer, up to a limit, moving the reader on only once.
+//! \details Must only be called by the reader.
+//! \param[out] spikes: Where to put the spikes retrieved, in order
+//! \param[in] max_spikes: The most spikes to retrieve
+//! \return The number of spikes retrieved; 0 if the buffer was empty.
+static inline uint32_t in_spikes_get_next_spikes(
+        spike_t *spikes, uint32_t max_spikes) {
+    uint32_t output = buffer.output;
+    uint32_t input = buffer.input;
+    uint32_t n_spikes = 0;
+    while (n_spikes < max_spikes && output != input) {
+        spikes[n_spikes++] = buffer.spikes[output];
+        output = (output + 1) & buffer.mask;
+    }
+    IN_SPIKES_BARRIER();
+    buffer.output = output;
+    return n_spikes;
 }
 
 //! \brief Skips the next spike in the buffer if it is equal to an existing
 //!     spike.
+//! \details Must only be called by the reader.
 //! \param[in] spike: The spike to compare against.
 //! \return True if a spike was skipped over, false otherwise.
 static inline bool in_spikes_is_next_spike_equal(spike_t spike) {
-    return circular_buffer_advance_if_next_equals(buffer, spike);
+    uint32_t output = buffer.output;
+    if (output == buffer.input || buffer.spikes[output] != spike) {
+        return false;
+    }
+    buffer.output = (output + 1) & buffer.mask;
+    return true;
+}
+
+//! \brief Removes the spikes in the buffer that a filter rejects, keeping the
+//!     rest in order.
+//! \details Must only be called by the reader.  The kept spikes are moved up
+//!     towards the end, which the writer never writes behind, and the reader
+//!     is moved on past the space freed, so spikes can still be added while
+//!     this runs; those are kept.
+//! \param[in] keep: Says whether to keep each spike
+//! \return The number of spikes removed
+static inline uint32_t in_spikes_filter(bool (*keep)(spike_t)) {
+    uint32_t output = buffer.output;
+    uint32_t write = buffer.input;
+    uint32_t n_removed = 0;
+    for (uint32_t read = write; read != output;) {
+        read = (read - 1) & buffer.mask;
+        spike_t spike = buffer.spikes[read];
+        if (keep(spike)) {
+            write = (write - 1) & buffer.mask;
+            buffer.spikes[write] = spike;
+        } else {
+            n_removed++;
+        }
+    }
+    IN_SPIKES_BARRIER();
+    buffer.output = write;
+    return n_removed;
 }
 
 //! \brief Get the number of times that the input spike buffer overflowed.
 //! \return A count.
 static inline counter_t in_spikes_get_n_buffer_overflows(void) {
-    return circular_buffer_get_n_buffer_overflows(buffer);
+    return buffer.n_overflows;
 }
 
 //! \brief Get the number of times that the input spike buffer underflowed.
@@ -90,7 +189,10 @@ static inline counter_t in_spikes_get_n_buffer_underflows(void) {
 //! \brief Print the input spike buffer.
 //! \details Expected to be mainly for debugging.
 static inline void in_spikes_print_buffer(void) {
-    circular_buffer_print_buffer(buffer);
+    for (uint32_t i = buffer.output; i != buffer.input;
+            i = (i + 1) & buffer.mask) {
+        log_debug("spike %u: 0x%08x", i, buffer.spikes[i]);
+    }
 }
 
 //---------------------------------------
@@ -100,31 +202,33 @@ static inline void in_spikes_print_buffer(void) {
 //!     goes.
 //! \return An index.
 static inline uint32_t in_spikes_input_index(void) {
-    return circular_buffer_input(buffer);
+    return buffer.input;
 }
 
 //! \brief Get the index in the buffer of the point where the next removal
 //!     comes from.
 //! \return An index.
 static inline uint32_t in_spikes_output_index(void) {
-    return circular_buffer_output(buffer);
+    return buffer.output;
 }
 
 //! \brief Get the size of the input spike buffer.
 //! \return The size of the buffer (a power of 2).
 static inline uint32_t in_spikes_real_size(void) {
-    return circular_buffer_real_size(buffer);
+    return buffer.mask + 1;
 }
 
 //! \brief get the size of the input spike buffer
 //! \return The size of the buffer.
 static inline uint32_t in_spikes_size(void) {
-    return circular_buffer_size(buffer);
+    return (buffer.input - buffer.output) & buffer.mask;
 }
 
 //! \brief clears the input spike buffer.
+//! \details Must only be called by the reader; spikes added while this runs
+//!     may or may not be cleared.
 static inline void in_spikes_clear(void) {
-    circular_buffer_clear(buffer);
+    buffer.output = buffer.input;
 }
 
 //! \brief Get the spike at a specific index of the input spike buffer.
@@ -133,6 +237,6 @@ static inline void in_spikes_clear(void) {
 //! \return The spike at the index. **WARNING:** _if there is no spike at that
 //!     index, the value returned may be arbitrary._
 static inline spike_t in_spikes_value_at_index(uint32_t index) {
-    return circular_buffer_value_at_index(buffer, index);
+    return buffer.spikes[index & buffer.mask];
 }
 #endif // _IN_SPIKES_H_
@@ -58,7 +58,8 @@ typedef double		UFRACT;
 #define FRACT_CONST(x)	x
 #define UFRACT_CONST(x)	x
 
-static REAL macro_arg_1, macro_arg_2, macro_arg_3, macro_arg_4;
+static __attribute__((__unused__)) REAL
+        macro_arg_1, macro_arg_2, macro_arg_3, macro_arg_4;
 
 #define ONE		1.00000000000000000
 #define HALF		0.50000000000000000
@@ -31,8 +31,52 @@
 //! the size of the circular queue for packets.
 #define IN_BUFFER_SIZE 256
 
+//! \brief Whether the spike counters are 16 bits rather than 8, so that a
+//!     neuron can be delayed up to 65535 times in a time step instead of 255.
+//!     The spikes are still sent as one packet with the count as payload.
+//!     This can be set per binary at build time.
+#ifndef DELAY_WIDE_COUNTERS
+#define DELAY_WIDE_COUNTERS 0
+#endif
+
+#if DELAY_WIDE_COUNTERS
+//! The count of spikes of a neuron in a delay slot
+typedef uint16_t delay_counter_t;
+
+//! the point where the count has saturated.
+#define COUNTER_SATURATION_VALUE 0xFFFF
+#else
+//! The count of spikes of a neuron in a delay slot
+typedef uint8_t delay_counter_t;
+
 //! the point where the count has saturated.
 #define COUNTER_SATURATION_VALUE 255
+#endif
+
+//! \brief Whether to keep a bit field of the neurons with spikes in each
+//!     delay slot, so that only those are sent and cleared.  This can be set
+//!     per binary at build time.
+#ifndef DELAY_SPARSE_SLOTS
+#define DELAY_SPARSE_SLOTS 1
+#endif
+
+//! \brief Whether to keep, for each time step, a mask per neuron of the delay
+//!     stages with spikes to send then, so that each time step only visits
+//!     the neurons and stages with something to send.  The masks are set as
+//!     spikes arrive.  This can be set per binary at build time.
+#ifndef DELAY_STAGE_MASKS
+#define DELAY_STAGE_MASKS 0
+#endif
+
+//! \brief The most spikes to take from the input queue at once before
+//!     processing them.  This can be set per binary at build
+//!     time.
+#ifndef DELAY_SPIKE_BATCH_SIZE
+#define DELAY_SPIKE_BATCH_SIZE 16
+#endif
+
+//! The multiplier of the hash of a source key
+#define SOURCE_KEY_HASH 0x9E3779B1
 
 //! values for the priority for each callback
 enum delay_extension_callback_priorities {
@@ -58,7 +102,7 @@ struct delay_extension_provenance {
     uint32_t n_buffer_overflows;
     //! Number of times we had to back off because the comms hardware was busy
     uint32_t n_delays;
-    //! number of packets lost due to count saturation of uint8
+    //! number of packets lost due to count saturation of the counters
     uint32_t n_packets_lost_due_to_count_saturation;
     //! number of packets dropped due to invalid neuron value
     uint32_t n_packets_dropped_due_to_invalid_neuron_value;
@@ -77,14 +121,20 @@ struct delay_extension_provenance {
 static bool has_key;
 //! Base multicast key for sending messages
 static uint32_t key = 0;
-//! Key for receiving messages
-static uint32_t incoming_key = 0;
-//! Mask for ::incoming_key to say which messages are for this program
+//! Mask for the key of a source to say which messages are for this program
 static uint32_t incoming_mask = 0;
-//! \brief Mask for key (that matches ::incoming_key/::incoming_mask) to extract
-//! the neuron ID from it
+//! \brief Mask for key (that matches a source key and ::incoming_mask) to
+//! extract the neuron ID from it
 static uint32_t incoming_neuron_mask = 0;
 
+//! \brief The sources, placed by the hash of their key and then in the next
+//!     free entry; entries with no neurons are free
+static struct delay_source *source_table = NULL;
+//! Mask for an index into ::source_table
+static uint32_t source_table_mask = 0;
+//! The shift of the hash of a key to make an index into ::source_table
+static uint32_t source_hash_shift = 0;
+
 //! Number of neurons supported.
 static uint32_t num_neurons = 0;
 
@@ -108,7 +158,32 @@ static uint32_t infinite_run;
 //! Time slots are the time of reception of the spike, masked by
 //! ::num_delay_slots_mask, and neuron IDs are extracted from the spike key by
 //! masking with ::incoming_neuron_mask
-static uint8_t **spike_counters = NULL;
+static delay_counter_t **spike_counters = NULL;
+#if DELAY_SPARSE_SLOTS
+//! \brief For each delay slot, a bit field of the neurons with a non-zero
+//!     counter in ::spike_counters
+static bit_field_t *spike_slot_bits = NULL;
+#endif
+#if DELAY_STAGE_MASKS
+//! The delay stages with spikes of a neuron in a time step, one bit each
+typedef uint8_t stage_mask_t;
+
+//! The most delay stages that a ::stage_mask_t can hold
+#define MAX_STAGE_MASK_STAGES 8
+
+//! \brief The stage masks, as a 2D array
+//! ```
+//! stage_masks[time_slot][neuron_id]
+//! ```
+//! Time slots are the time that the spikes are to be sent, masked by
+//! ::stage_wheel_mask
+static stage_mask_t **stage_masks = NULL;
+//! \brief For each time slot of ::stage_masks, a bit field of the neurons
+//!     with a non-zero mask
+static bit_field_t *stage_slot_bits = NULL;
+//! Mask for converting time into a time slot of ::stage_masks
+static uint32_t stage_wheel_mask = 0;
+#endif
 //! The number of delay stages.
 static uint32_t num_delay_stages = 0;
 //! The number of delays within a delay stage
@@ -177,7 +252,7 @@ static uint32_t colour = 0;
 //! \param[out] counters: The array to zero
 //! \param[in] num_items: The size of the array
 static inline void zero_spike_counters(
-        uint8_t *counters, uint32_t num_items) {
+        delay_counter_t *counters, uint32_t num_items) {
     for (uint32_t i = 0 ; i < num_items ; i++) {
         counters[i] = 0;
     }
@@ -197,6 +272,86 @@ static inline uint32_t round_to_next_pot(uint32_t v) {
     return v;
 }
 
+//! \brief Get the first entry of ::source_table to look at for a key
+//! \param[in] masked_key: The key, masked with ::incoming_mask
+//! \return The index into ::source_table
+static inline uint32_t source_hash(uint32_t masked_key) {
+    return (masked_key * SOURCE_KEY_HASH) >> source_hash_shift;
+}
+
+//! \brief Find the source of a key
+//! \param[in] k: The key
+//! \return The source, or NULL if the key is not from a source
+static inline struct delay_source *find_source(key_t k) {
+    uint32_t masked_key = k & incoming_mask;
+    uint32_t index = source_hash(masked_key);
+    // There is always a free entry, so this ends
+    while (source_table[index].n_neurons != 0) {
+        if (source_table[index].key == masked_key) {
+            return &source_table[index];
+        }
+        index = (index + 1) & source_table_mask;
+    }
+    return NULL;
+}
+
+//! \brief Read the sources into ::source_table
+//! \param[in] params: The configuration region.
+//! \return True if successful
+static bool read_sources(struct delay_parameters *params) {
+    if (params->n_sources == 0) {
+        log_error("No sources of spikes to delay");
+        return false;
+    }
+
+    // Twice the entries keeps the runs of used entries short
+    uint32_t log_n_entries = 1;
+    while ((1u << log_n_entries) < (params->n_sources * 2)) {
+        log_n_entries++;
+    }
+    uint32_t n_entries = 1u << log_n_entries;
+    source_table_mask = n_entries - 1;
+    source_hash_shift = 32 - log_n_entries;
+    source_table = spin1_malloc(n_entries * sizeof(struct delay_source));
+    if (source_table == NULL) {
+        log_error("failed to allocate memory for %u sources",
+                params->n_sources);
+        return false;
+    }
+    for (uint32_t i = 0; i < n_entries; i++) {
+        source_table[i].n_neurons = 0;
+    }
+
+    for (uint32_t s = 0; s < params->n_sources; s++) {
+        struct delay_source *source = &params->sources[s];
+        if (source->first_neuron + source->n_neurons > num_neurons) {
+            log_error("Source %u of neurons %u to %u is beyond %u neurons",
+                    s, source->first_neuron,
+                    source->first_neuron + source->n_neurons, num_neurons);
+            return false;
+        }
+        if (source->n_neurons == 0) {
+            continue;
+        }
+        uint32_t masked_key = source->key & incoming_mask;
+        if (find_source(masked_key) != NULL) {
+            log_error("Source %u has the same key 0x%08x as another source",
+                    s, masked_key);
+            return false;
+        }
+        uint32_t index = source_hash(masked_key);
+        while (source_table[index].n_neurons != 0) {
+            index = (index + 1) & source_table_mask;
+        }
+        source_table[index] = *source;
+        source_table[index].key = masked_key;
+        log_debug("\t source %u key = 0x%08x, neurons %u to %u", s,
+                masked_key, source->first_neuron,
+                source->first_neuron + source->n_neurons);
+    }
+    return true;
+}
+
 //! \brief Read the configuration region.
 //! \param[in] params: The configuration region.
 //! \return True if successful
@@ -205,14 +360,16 @@ static bool read_parameters(struct delay_parameters *params) {
 
     has_key = params->has_key;
     key = params->key;
-    incoming_key = params->incoming_key;
     incoming_mask = params->incoming_mask;
     incoming_neuron_mask = ~incoming_mask;
-    log_debug("\t key = 0x%08x, incoming key = 0x%08x, incoming mask = 0x%08x,"
+    log_debug("\t key = 0x%08x, incoming mask = 0x%08x,"
             "incoming key mask = 0x%08x",
-            key, incoming_key, incoming_mask, incoming_neuron_mask);
+            key, incoming_mask, incoming_neuron_mask);
 
     num_neurons = params->n_atoms;
+    if (!read_sources(params)) {
+        return false;
+    }
     neuron_bit_field_words = get_bit_field_size(num_neurons);
 
     num_delay_stages = params->n_delay_stages;
@@ -235,27 +392,79 @@ static bool read_parameters(struct delay_parameters *params) {
             num_delay_slots_mask, n_delay_in_a_stage);
 
     // Allocate array of counters for each delay slot
-    spike_counters = spin1_malloc(num_delay_slots_pot * sizeof(uint8_t*));
+    spike_counters = spin1_malloc(
+            num_delay_slots_pot * sizeof(delay_counter_t*));
     if (spike_counters == NULL) {
         log_error("failed to allocate memory for array of size %u bytes",
-                num_delay_slots_pot * sizeof(uint8_t*));
+                num_delay_slots_pot * sizeof(delay_counter_t*));
         return false;
     }
 
     for (uint32_t s = 0; s < num_delay_slots_pot; s++) {
         // Allocate an array of counters for each neuron and zero
-        spike_counters[s] = spin1_malloc(num_neurons * sizeof(uint8_t));
+        spike_counters[s] = spin1_malloc(
+                num_neurons * sizeof(delay_counter_t));
         if (spike_counters[s] == NULL) {
             log_error("failed to allocate memory for bitfield of size %u bytes",
-                    num_neurons * sizeof(uint8_t));
+                    num_neurons * sizeof(delay_counter_t));
             return false;
         }
         zero_spike_counters(spike_counters[s], num_neurons);
     }
+#if DELAY_SPARSE_SLOTS
+    spike_slot_bits = spin1_malloc(num_delay_slots_pot * sizeof(bit_field_t));
+    if (spike_slot_bits == NULL) {
+        log_error("failed to allocate memory for array of size %u bytes",
+                num_delay_slots_pot * sizeof(bit_field_t));
+        return false;
+    }
+    for (uint32_t s = 0; s < num_delay_slots_pot; s++) {
+        spike_slot_bits[s] = bit_field_alloc(num_neurons);
+        if (spike_slot_bits[s] == NULL) {
+            log_error("failed to allocate memory for bitfield of size %u bytes",
+                    neuron_bit_field_words * sizeof(uint32_t));
+            return false;
+        }
+        clear_bit_field(spike_slot_bits[s], neuron_bit_field_words);
+    }
+#endif
 
     n_colour_bits = params->n_colour_bits;
     colour_mask = (1 << n_colour_bits) - 1;
 
+#if DELAY_STAGE_MASKS
+    if (num_delay_stages > MAX_STAGE_MASK_STAGES) {
+        log_error("%u delay stages is more than the %u of a stage mask",
+                num_delay_stages, MAX_STAGE_MASK_STAGES);
+        return false;
+    }
+
+    // Spikes can be sent up to the maximum delay after the latest colour
+    uint32_t n_wheel_slots = round_to_next_pot(
+            num_delay_slots + colour_mask + 1);
+    stage_wheel_mask = n_wheel_slots - 1;
+    stage_masks = spin1_malloc(n_wheel_slots * sizeof(stage_mask_t *));
+    stage_slot_bits = spin1_malloc(n_wheel_slots * sizeof(bit_field_t));
+    if (stage_masks == NULL || stage_slot_bits == NULL) {
+        log_error("failed to allocate memory for %u stage mask slots",
+                n_wheel_slots);
+        return false;
+    }
+    for (uint32_t s = 0; s < n_wheel_slots; s++) {
+        stage_masks[s] = spin1_malloc(num_neurons * sizeof(stage_mask_t));
+        stage_slot_bits[s] = bit_field_alloc(num_neurons);
+        if (stage_masks[s] == NULL || stage_slot_bits[s] == NULL) {
+            log_error("failed to allocate memory for stage masks of %u "
+                    "neurons", num_neurons);
+            return false;
+        }
+        for (uint32_t n = 0; n < num_neurons; n++) {
+            stage_masks[s][n] = 0;
+        }
+        clear_bit_field(stage_slot_bits[s], neuron_bit_field_words);
+    }
+#endif
+
     log_debug("read_parameters: completed successfully");
     return true;
 }
@@ -356,55 +565,125 @@ static inline index_t key_n(key_t k) {
     return k & incoming_neuron_mask;
 }
 
+#if DELAY_STAGE_MASKS
+//! \brief Mark the stages of a neuron that will send the spikes that
+//!     arrived in a time slot
+//! \param[in] arrival_time: The time of the time slot of the spikes
+//! \param[in] n: The neuron
+static inline void mark_stages(uint32_t arrival_time, uint32_t n) {
+    for (uint32_t d = 0; d < num_delay_stages; d++) {
+        uint32_t slot = (arrival_time + ((d + 1) * n_delay_in_a_stage)) &
+                stage_wheel_mask;
+        stage_masks[slot][n] |= 1 << d;
+        bit_field_set(stage_slot_bits[slot], n);
+    }
+}
+
+//! \brief Clear the stage masks of a time step without sending anything
+//! \param[in] local_time: The time step to clear
+static inline void clear_stage_slot(uint32_t local_time) {
+    uint32_t slot = local_time & stage_wheel_mask;
+    stage_mask_t *masks = stage_masks[slot];
+    bit_field_t bits = stage_slot_bits[slot];
+    for (uint32_t w = 0; w < neuron_bit_field_words; w++) {
+        uint32_t word = bits[w];
+        bits[w] = 0;
+        while (word != 0) {
+            masks[(w << 5) + __builtin_ctz(word)] = 0;
+            word &= word - 1;
+        }
+    }
+}
+#endif
+
+//! \brief Add a spike to the counters of the current time slot
+//! \param[in] s: The spike
+//! \param[in] n_spikes: The number of copies of the spike
+static inline void add_spike(spike_t s, uint32_t n_spikes) {
+    struct delay_source *source = find_source(s);
+    if (source == NULL) {
+        n_packets_dropped_due_to_invalid_key += n_spikes;
+        log_debug("Invalid spike key 0x%08x", s);
+        return;
+    }
+
+    // Mask out neuron ID
+    uint32_t spike_id = key_n(s);
+    uint32_t spike_colour = spike_id & colour_mask;
+    uint32_t source_neuron_id = spike_id >> n_colour_bits;
+    if (source_neuron_id >= source->n_neurons) {
+        n_packets_dropped_due_to_invalid_neuron_value += n_spikes;
+        log_debug("Invalid neuron ID %u", source_neuron_id);
+        return;
+    }
+    uint32_t neuron_id = source->first_neuron + source_neuron_id;
+
+    // Account for delayed spikes
+    int32_t colour_diff = colour - spike_colour;
+    uint32_t colour_delay = colour_diff & colour_mask;
+
+    // Get current time slot of incoming spike counters
+    uint32_t time_slot = (time + colour_delay) & num_delay_slots_mask;
+    delay_counter_t *time_slot_spike_counters = spike_counters[time_slot];
+
+#if DELAY_STAGE_MASKS
+    // The first spikes of the neuron in the slot need sending from each stage
+    if (time_slot_spike_counters[neuron_id] == 0) {
+        mark_stages(time + colour_delay, neuron_id);
+    }
+#endif
+
+    // Increase counter
+    uint32_t count = time_slot_spike_counters[neuron_id] + n_spikes;
+    if (count > COUNTER_SATURATION_VALUE) {
+        saturation_count += count - COUNTER_SATURATION_VALUE;
+        count = COUNTER_SATURATION_VALUE;
+    }
+    time_slot_spike_counters[neuron_id] = count;
+#if DELAY_SPARSE_SLOTS
+    bit_field_set(spike_slot_bits[time_slot], neuron_id);
+#endif
+    log_debug("Incrementing counter %u = %u\n",
+            neuron_id, time_slot_spike_counters[neuron_id]);
+    n_spikes_added += n_spikes;
+}
+
 //! \brief Processes spikes queued by ::incoming_spike_callback()
+//! \details The spikes are taken from the queue in batches of up to
+//!     ::DELAY_SPIKE_BATCH_SIZE without disabling interrupts, as the queue
+//!     has a single reader and writer; interrupts are only disabled to stop
+//!     once the queue is seen to be empty.  Copies of a spike directly after
+//!     it in the queue (such as those from a packet with a count payload)
+//!     are handled together with it.
 static inline void spike_process(void) {
+    spike_t spikes[DELAY_SPIKE_BATCH_SIZE];
 
     // While there are any incoming spikes
-    spike_t s;
-    uint32_t state = spin1_int_disable();
-    while (in_spikes_get_next_spike(&s)) {
-        spin1_mode_restore(state);
-        n_processed_spikes++;
-
-        if ((s & incoming_mask) == incoming_key) {
-            // Mask out neuron ID
-            uint32_t spike_id = key_n(s);
-            uint32_t spike_colour = spike_id & colour_mask;
-            uint32_t neuron_id = spike_id >> n_colour_bits;
-            if (neuron_id < num_neurons) {
-
-            	// Account for delayed spikes
-            	int32_t colour_diff = colour - spike_colour;
-            	uint32_t colour_delay = colour_diff & colour_mask;
-
-            	// Get current time slot of incoming spike counters
-				uint32_t time_slot = (time + colour_delay) & num_delay_slots_mask;
-				uint8_t *time_slot_spike_counters = spike_counters[time_slot];
-
-                // Increment counter
-                if (time_slot_spike_counters[neuron_id] ==
-                        COUNTER_SATURATION_VALUE) {
-                    saturation_count += 1;
-                } else {
-                	time_slot_spike_counters[neuron_id]++;
-                }
-                log_debug("Incrementing counter %u = %u\n",
-                        neuron_id,
-						time_slot_spike_counters[neuron_id]);
-                n_spikes_added++;
-            } else {
-                n_packets_dropped_due_to_invalid_neuron_value += 1;
-                log_debug("Invalid neuron ID %u", neuron_id);
+    while (true) {
+        uint32_t n_batch = in_spikes_get_next_spikes(
+                spikes, DELAY_SPIKE_BATCH_SIZE);
+        if (n_batch == 0) {
+            uint32_t state = spin1_int_disable();
+            if (in_spikes_size() == 0) {
+                spike_processing = false;
+                spin1_mode_restore(state);
+                return;
             }
-        } else {
-            n_packets_dropped_due_to_invalid_key += 1;
-            log_debug("Invalid spike key 0x%08x", s);
+            spin1_mode_restore(state);
+            continue;
         }
-        state = spin1_int_disable();
-    }
 
-    spike_processing = false;
-    spin1_mode_restore(state);
+        for (uint32_t i = 0; i < n_batch;) {
+            uint32_t n_spikes = 1;
+            while (i + n_spikes < n_batch &&
+                    spikes[i + n_spikes] == spikes[i]) {
+                n_spikes++;
+            }
+            n_processed_spikes += n_spikes;
+            add_spike(spikes[i], n_spikes);
+            i += n_spikes;
+        }
+    }
 }
 
 //! \brief User event callback.
@@ -415,23 +694,94 @@ static void user_callback(UNUSED uint unused0, UNUSED uint unused1) {
     spike_process();
 }
 
+//! \brief Send the delayed spikes of a neuron
+//! \param[in] d: The delay stage
+//! \param[in] n: The neuron
+//! \param[in] count: The number of spikes to send, which is not 0
+static inline void send_delayed_spikes(uint32_t d, uint32_t n, uint32_t count) {
+    // Calculate key all spikes coming from this neuron will be
+    // sent with
+    uint32_t neuron_index = ((d * num_neurons) + n);
+    uint32_t spike_key = (key + (neuron_index << n_colour_bits)) | colour;
+
+    log_debug("Neuron %u sending %u spikes after delay"
+            "stage %u with key %x",
+            n, count, d, spike_key);
+
+    // fire n spikes as payload, 1 as none payload.
+    if (has_key) {
+        if (count > 1) {
+            log_debug(
+                "%d: sending packet with key 0x%08x and payload %d",
+                time, spike_key, count);
+
+            send_spike_mc_payload(spike_key, count);
+
+            // update counter
+            n_spikes_sent += count;
+        } else {
+            log_debug("%d: sending spike with key 0x%08x", time, spike_key);
+
+            send_spike_mc(spike_key);
+
+            // update counter
+            n_spikes_sent++;
+        }
+    }
+}
+
 //! \brief Background event callback.
 //! \details Handles sending delayed spikes at the right time.
 //! \param[in] local_time: current simulation time
 //! \param[in] timer_count: unused
 static void background_callback(uint local_time, UNUSED uint timer_count) {
+#if DELAY_STAGE_MASKS
+    // Loop through the neurons with spikes to send, and then their stages
+    uint32_t wheel_slot = local_time & stage_wheel_mask;
+    stage_mask_t *masks = stage_masks[wheel_slot];
+    bit_field_t bits = stage_slot_bits[wheel_slot];
+    for (uint32_t w = 0; w < neuron_bit_field_words; w++) {
+        uint32_t word = bits[w];
+        bits[w] = 0;
+        while (word != 0) {
+            uint32_t n = (w << 5) + __builtin_ctz(word);
+            word &= word - 1;
+            uint32_t stages = masks[n];
+            masks[n] = 0;
+            while (stages != 0) {
+                uint32_t d = 31 - __builtin_clz(stages);
+                stages &= ~(1u << d);
+                uint32_t slot = (local_time - ((d + 1) * n_delay_in_a_stage)) &
+                        num_delay_slots_mask;
+                send_delayed_spikes(d, n, spike_counters[slot][n]);
+            }
+        }
+    }
+#else
     // Loop through delay stages
     for (uint32_t d = 0; d < num_delay_stages; d++) {
         uint32_t delay_stage_delay = (d + 1) * n_delay_in_a_stage;
         if (local_time >= delay_stage_delay) {
             uint32_t delay_stage_time_slot =
                     (local_time - delay_stage_delay) & num_delay_slots_mask;
-            uint8_t *delay_stage_spike_counters =
+            delay_counter_t *delay_stage_spike_counters =
                     spike_counters[delay_stage_time_slot];
 
             log_debug("%u: Checking time slot %u for delay stage %u (delay %u)",
                     local_time, delay_stage_time_slot, d, delay_stage_delay);
 
+#if DELAY_SPARSE_SLOTS
+            // Loop through the neurons with spikes only
+            bit_field_t bits = spike_slot_bits[delay_stage_time_slot];
+            for (uint32_t w = 0; w < neuron_bit_field_words; w++) {
+                uint32_t word = bits[w];
+                while (word != 0) {
+                    uint32_t n = (w << 5) + __builtin_ctz(word);
+                    word &= word - 1;
+                    send_delayed_spikes(d, n, delay_stage_spike_counters[n]);
+                }
+            }
+#else
             // Loop through neurons
             for (uint32_t n = 0; n < num_neurons; n++) {
 
@@ -440,39 +790,12 @@ static void background_callback(uint local_time, UNUSED uint timer_count) {
                     continue;
                 }
 
-                // Calculate key all spikes coming from this neuron will be
-                // sent with
-                uint32_t neuron_index = ((d * num_neurons) + n);
-                uint32_t spike_key = (key + (neuron_index << n_colour_bits)) | colour;
-
-                log_debug("Neuron %u sending %u spikes after delay"
-                        "stage %u with key %x",
-                        n, delay_stage_spike_counters[n], d,
-                        spike_key);
-
-                // fire n spikes as payload, 1 as none payload.
-                if (has_key) {
-                    if (delay_stage_spike_counters[n] > 1) {
-                        log_debug(
-                            "%d: sending packet with key 0x%08x and payload %d",
-                            time, spike_key, delay_stage_spike_counters[n]);
-
-                        send_spike_mc_payload(spike_key, delay_stage_spike_counters[n]);
-
-                        // update counter
-                        n_spikes_sent += delay_stage_spike_counters[n];
-                    } else if (delay_stage_spike_counters[n] == 1) {
-                        log_debug("%d: sending spike with key 0x%08x", time, spike_key);
-
-                        send_spike_mc(spike_key);
-
-                        // update counter
-                        n_spikes_sent++;
-                    }
-                }
+                send_delayed_spikes(d, n, delay_stage_spike_counters[n]);
             }
+#endif
         }
     }
+#endif
     n_backgrounds_queued--;
 }
 
@@ -493,7 +816,21 @@ static void timer_callback(uint timer_count, UNUSED uint unused1) {
     if (time > num_delay_slots) {
         uint32_t clearable_slot = ((time - 1) - num_delay_slots) & num_delay_slots_mask;
         log_debug("%d: Clearing time slot %d", time, clearable_slot);
+#if DELAY_SPARSE_SLOTS
+        // Only the counters of the neurons with spikes need clearing
+        delay_counter_t *counters = spike_counters[clearable_slot];
+        bit_field_t bits = spike_slot_bits[clearable_slot];
+        for (uint32_t w = 0; w < neuron_bit_field_words; w++) {
+            uint32_t word = bits[w];
+            bits[w] = 0;
+            while (word != 0) {
+                counters[(w << 5) + __builtin_ctz(word)] = 0;
+                word &= word - 1;
+            }
+        }
+#else
         zero_spike_counters(spike_counters[clearable_slot], num_neurons);
+#endif
     }
 
     log_debug("Timer tick %u", time);
@@ -525,6 +862,10 @@ static void timer_callback(uint timer_count, UNUSED uint unused1) {
     if (!spin1_schedule_callback(background_callback, time, timer_count, BACKGROUND)) {
         // We have failed to do this timer tick!
         n_background_overloads++;
+#if DELAY_STAGE_MASKS
+        // The masks must not be seen again when the slot comes round
+        clear_stage_slot(time);
+#endif
     } else {
         n_backgrounds_queued++;
         if (n_backgrounds_queued > max_backgrounds_queued) {
@@ -36,18 +36,27 @@ typedef enum region_identifiers {
     TDMA_REGION = 3,
 } region_identifiers;
 
+//! \brief A source of spikes to be delayed, which is a range of the neurons
+//! delayed by this core
+struct delay_source {
+    uint32_t key;                 //!< Key to accept messages with
+    uint32_t first_neuron;        //!< The neuron that neuron 0 of the source is
+    uint32_t n_neurons;           //!< The number of neurons of the source
+};
+
 //! \brief Delay configuration, as read from SDRAM where it was placed by DSG
 //! or by on-chip generation
 struct delay_parameters {
     uint32_t has_key;             //!< bool for if this vertex has a key.
     uint32_t key;                 //!< Key to use for sending messages
-    uint32_t incoming_key;        //!< Key to accept messages with
-    uint32_t incoming_mask;       //!< Mask to filter delay_parameters::incoming_key
+    uint32_t incoming_mask;       //!< Mask to filter delay_source::key
     uint32_t n_atoms;             //!< Number of atoms
     uint32_t n_delay_stages;      //!< Number of delay stages
     uint32_t n_delay_in_a_stage;  //!< Number of delays in a given stage
     uint32_t clear_packets;       //!< Clear packets each timestep?
     uint32_t n_colour_bits;       //!< The number of bits used for colour
+    uint32_t n_sources;           //!< The number of sources
+    struct delay_source sources[]; //!< The sources, each with its own key
 };
 
 //! \brief Encode a delay as a 16-bit integer
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//! \dir
+//! \brief Event filter for 2D sensor inputs
+//! \file
+//! \brief Crops, pools and rate-limits the events of a 2D sensor, such as a
+//!     retina connected through SPIF, before they are sent on to the network
+
+#include <common/neuron-typedefs.h>
+#include <common/send_mc.h>
+
+#include <data_specification.h>
+#include <debug.h>
+#include <simulation.h>
+#include <stdbool.h>
+
+// ----------------------------------------------------------------------
+
+//! The structure of our configuration region in SDRAM
+typedef struct {
+    //! The shift to get the x coordinate from a received key
+    uint32_t x_shift;
+    //! The mask of the x coordinate after shifting
+    uint32_t x_mask;
+    //! The shift to get the y coordinate from a received key
+    uint32_t y_shift;
+    //! The mask of the y coordinate after shifting
+    uint32_t y_mask;
+    //! The first x coordinate of the region of interest
+    uint32_t x_min;
+    //! The first y coordinate of the region of interest
+    uint32_t y_min;
+    //! The width of the region of interest
+    uint32_t roi_width;
+    //! The height of the region of interest
+    uint32_t roi_height;
+    //! The log2 of the width of the pixels pooled into one output pixel
+    uint32_t pool_x_shift;
+    //! The log2 of the height of the pixels pooled into one output pixel
+    uint32_t pool_y_shift;
+    //! The width of the output
+    uint32_t out_width;
+    //! The height of the output
+    uint32_t out_height;
+    //! The time steps after an output pixel sends before it can send again
+    uint32_t refractory_steps;
+    //! The base key to send with
+    uint32_t key;
+    //! The number of colour bits in the sent keys
+    uint32_t n_colour_bits;
+} event_filter_config_t;
+
+//! The provenance information written on application shutdown.
+struct event_filter_provenance {
+    //! The number of events received
+    uint32_t n_received;
+    //! The number of events dropped as outside the region of interest
+    uint32_t n_outside_roi;
+    //! The number of events dropped as their output pixel was refractory
+    uint32_t n_refractory;
+    //! The number of events sent on
+    uint32_t n_sent;
+};
+
+//! DSG regions in use
+enum event_filter_regions_e {
+    SYSTEM_REGION,          //!< General simulation API control area
+    PARAMS_REGION,          //!< Configuration region for this application
+    PROVENANCE_DATA_REGION  //!< Provenance region for this application
+};
+
+//! values for the priority for each callback
+enum event_filter_callback_priorities {
+    MC = -1,   //!< Multicast message reception is FIQ
+    SDP = 0,   //!< SDP handling is highest normal priority
+    DMA = 1,   //!< DMA complete handling is medium priority
+    TIMER = 2, //!< Timer interrupt processing is lowest priority
+};
+
+// Globals
+//! The simulation time
+static uint32_t time;
+//! Current simulation stop/pause time
+static uint32_t simulation_ticks;
+//! True if the simulation is running continuously
+static uint32_t infinite_run;
+//! The configuration, copied into DTCM
+static event_filter_config_t config;
+//! The colour of the current time step, to add to sent keys
+static uint32_t colour;
+//! The mask of the colour
+static uint32_t colour_mask;
+//! The time each output pixel last sent
+static uint32_t *last_sent;
+//! The provenance counters
+static struct event_filter_provenance counters;
+
+// ----------------------------------------------------------------------
+
+//! \brief Filter an event and send it on if it passes
+//! \param[in] key: The key of the event received
+//! \param payload: ignored
+static void incoming_event_callback(uint key, UNUSED uint payload) {
+    counters.n_received++;
+
+    // Crop; the subtraction wraps, so one compare covers both sides
+    uint32_t x = ((key >> config.x_shift) & config.x_mask) - config.x_min;
+    uint32_t y = ((key >> config.y_shift) & config.y_mask) - config.y_min;
+    if (x >= config.roi_width || y >= config.roi_height) {
+        counters.n_outside_roi++;
+        return;
+    }
+
+    // Pool
+    uint32_t index = ((y >> config.pool_y_shift) * config.out_width) +
+            (x >> config.pool_x_shift);
+
+    // Rate-limit each output pixel
+    if (time - last_sent[index] < config.refractory_steps) {
+        counters.n_refractory++;
+        return;
+    }
+    last_sent[index] = time;
+
+    counters.n_sent++;
+    send_spike_mc(config.key | (index << config.n_colour_bits) | colour);
+}
+
+//! \brief Regular callback that moves on the time and colour.
+//! \param unused0: unused
+//! \param unused1: unused
+static void timer_callback(UNUSED uint unused0, UNUSED uint unused1) {
+    time++;
+
+    if (simulation_is_finished()) {
+        simulation_handle_pause_resume(NULL);
+        log_info("Simulation complete.\n");
+        simulation_ready_to_read();
+        return;
+    }
+
+    colour = time & colour_mask;
+}
+
+//! \brief Callback to store provenance data (format: event_filter_provenance).
+//! \param[out] provenance_region: Where to write the provenance data
+static void c_main_store_provenance_data(address_t provenance_region) {
+    struct event_filter_provenance *prov = (void *) provenance_region;
+    *prov = counters;
+}
+
+//! \brief Reads the configuration and sets up the output pixels
+//! \param[in] config_region: Where to read the configuration from
+//! \return True if the output pixels could be allocated
+static bool read_parameters(event_filter_config_t *config_region) {
+    config = *config_region;
+    colour_mask = (1 << config.n_colour_bits) - 1;
+
+    uint32_t n_pixels = config.out_width * config.out_height;
+    last_sent = spin1_malloc(n_pixels * sizeof(uint32_t));
+    if (last_sent == NULL) {
+        log_error("Not enough DTCM for %u output pixels", n_pixels);
+        return false;
+    }
+
+    // Mark every pixel as having sent long enough before the first time step
+    // that it can send straight away
+    for (uint32_t i = 0; i < n_pixels; i++) {
+        last_sent[i] = UINT32_MAX - config.refractory_steps;
+    }
+
+    log_info("ROI (%u, %u) size %u x %u, pool 2^%u x 2^%u to %u x %u, "
+            "refractory %u steps, key 0x%08x",
+            config.x_min, config.y_min, config.roi_width, config.roi_height,
+            config.pool_x_shift, config.pool_y_shift, config.out_width,
+            config.out_height, config.refractory_steps, config.key);
+    return true;
+}
+
+//! \brief Read all application configuration
+//! \param[out] timer_period: How long to program ticks to be
+//! \return True if initialisation succeeded
+static bool initialize(uint32_t *timer_period) {
+    log_info("initialise: started");
+
+    // Get the address this core's DTCM data starts at from SRAM
+    data_specification_metadata_t *ds_regions =
+            data_specification_get_data_address();
+
+    // Read the header
+    if (!data_specification_read_header(ds_regions)) {
+        return false;
+    }
+
+    // Get the timing details and set up the simulation interface
+    if (!simulation_initialise(
+            data_specification_get_region(SYSTEM_REGION, ds_regions),
+            APPLICATION_NAME_HASH, timer_period, &simulation_ticks,
+            &infinite_run, &time, SDP, DMA)) {
+        return false;
+    }
+
+    simulation_set_provenance_function(
+        c_main_store_provenance_data,
+        data_specification_get_region(PROVENANCE_DATA_REGION, ds_regions));
+
+    // Get the parameters
+    if (!read_parameters(
+            data_specification_get_region(PARAMS_REGION, ds_regions))) {
+        return false;
+    }
+
+    log_info("initialise: completed successfully");
+
+    return true;
+}
+
+//! Entry point
+void c_main(void) {
+    // Initialise
+    uint32_t timer_period = 0;
+    if (!initialize(&timer_period)) {
+        log_error("Error in initialisation - exiting!");
+        rt_error(RTE_SWERR);
+    }
+
+    // Set timer_callback
+    spin1_set_timer_tick(timer_period);
+
+    // Register callbacks
+    spin1_callback_on(MC_PACKET_RECEIVED, incoming_event_callback, MC);
+    spin1_callback_on(TIMER_TICK, timer_callback, TIMER);
+
+    // Start the time at "-1" so that the first tick will be 0
+    time = UINT32_MAX;
+    simulation_run();
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//! \dir
+//! \brief Desktop microbenchmarks of the neural_modelling kernels
+//! \file
+//! \brief Timing and reporting shared by the microbenchmarks
+//! \details The kernels are the SpiNNaker sources themselves, compiled for
+//!     the host against the stand-ins in shim/.  The numbers are only good for
+//!     comparing two versions of a kernel on the same host; an ARM968 has no
+//!     caches or branch prediction to speak of, so the absolute costs differ.
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+
+//! The unit of bench_now()
+#define BENCH_UNIT "cycles"
+
+//! \brief Read the time stamp counter
+//! \return The number of cycles since some point in the past
+static inline uint64_t bench_now(void) {
+    return __rdtsc();
+}
+#else
+//! The unit of bench_now()
+#define BENCH_UNIT "clock ticks"
+
+//! \brief Read the processor time
+//! \return The number of clock ticks since some point in the past
+static inline uint64_t bench_now(void) {
+    return clock();
+}
+#endif
+
+//! The number of times each measurement is repeated; the fastest counts
+#define BENCH_REPEATS 16
+
+//! A value that the compiler must assume is used, so that a kernel whose
+//! results are otherwise unread is not optimised away
+extern volatile uint32_t bench_sink;
+
+//! The state of bench_random()
+extern uint32_t bench_random_state;
+
+//! \brief A fast, repeatable pseudo-random number (xorshift32), so that
+//!     every host builds the same synthetic data
+//! \return The next number
+static inline uint32_t bench_random(void) {
+    uint32_t x = bench_random_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    bench_random_state = x;
+    return x;
+}
+
+//! \brief Write one result line
+//! \param[in] kernel: The name of the kernel
+//! \param[in] variant: What was varied in this measurement
+//! \param[in] time: The time taken, in ::BENCH_UNIT
+//! \param[in] n_events: The number of events processed in that time
+static inline void bench_report(
+        const char *kernel, const char *variant, uint64_t time,
+        uint64_t n_events) {
+    printf("%-24s %-32s %10llu events %10.2f %s/event\n", kernel, variant,
+            (unsigned long long) n_events,
+            n_events ? (double) time / n_events : 0.0, BENCH_UNIT);
+}
+
+//! \brief Keep the fastest of a set of timings
+//! \param[in,out] best: The fastest so far; start with UINT64_MAX
+//! \param[in] start: The time at the start of the run
+static inline void bench_keep_best(uint64_t *best, uint64_t start) {
+    uint64_t time = bench_now() - start;
+    if (time < *best) {
+        *best = time;
+    }
+}
+
+#endif // _BENCH_H_
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+//! \file
+//! \brief Microbenchmark of the convolution of local_only_conv_impl.c
+//! \details Times local_only_impl_process_spike() for spikes from a 2D source
+//!     onto a 2D target on one core, for a range of kernel sizes, strides,
+//!     numbers of channels (connectors with their own kernel from the same
+//!     source) and spikes in each time step.
+#include "bench_local_only.h"
+#include <stdlib.h>
+
+//! The width and height of the source, as a power of 2
+#define LOG_SIDE 5
+//! The number of synapse types
+#define LOG_N_SYNAPSE_TYPES 1
+//! The delay bits of the ring buffers
+#define LOG_MAX_DELAY 4
+//! The number of spikes in each measurement
+#define N_SPIKES 1024
+//! The spikes in each time step, unless the variant says otherwise
+#define SPIKES_PER_STEP 64
+
+//! The width and height of the source, and most of the target
+#define SIDE (1 << LOG_SIDE)
+//! The number of neurons in the source, and most in the target
+#define LOG_N_NEURONS (2 * LOG_SIDE)
+
+//! The mask to get the synaptic delay from a "synapse", as local_only.c has
+uint32_t synapse_delay_mask = (1 << LOG_MAX_DELAY) - 1;
+
+//! The number of bits used by the synapse type and post-neuron index
+uint32_t synapse_type_index_bits = LOG_N_NEURONS + LOG_N_SYNAPSE_TYPES;
+
+//! The number of bits used by just the post-neuron index
+uint32_t synapse_index_bits = LOG_N_NEURONS;
+
+//! The layout of a source in SDRAM, as source_info in local_only_conv_impl.c
+typedef struct {
+    key_info key_info;
+    uint32_t source_height_per_core: 16;
+    uint32_t source_width_per_core: 16;
+    uint32_t source_height_last_core: 16;
+    uint32_t source_width_last_core: 16;
+    uint32_t cores_per_source_height: 16;
+    uint32_t cores_per_source_width: 16;
+    div_const source_width_div;
+    div_const source_width_last_div;
+    div_const cores_per_width_div;
+} bench_source_info;
+
+//! The layout of a connector in SDRAM, as connector in local_only_conv_impl.c
+typedef struct {
+    lc_shape_t kernel;
+    lc_shape_t padding;
+    uint16_t positive_synapse_type;
+    uint16_t negative_synapse_type;
+    uint16_t delay_stage;
+    uint16_t delay;
+    uint16_t kernel_index;
+    uint16_t _PAD;
+    div_const stride_height_div;
+    div_const stride_width_div;
+    div_const pool_stride_height_div;
+    div_const pool_stride_width_div;
+} bench_connector;
+
+//! \brief The layout of the configuration in SDRAM, as conv_config in
+//!     local_only_conv_impl.c, with the one source this uses
+typedef struct {
+    lc_coord_t post_start;
+    lc_coord_t post_end;
+    lc_shape_t post_shape;
+    uint32_t n_sources;
+    uint32_t n_connectors_total;
+    uint32_t n_weights_total;
+    bench_source_info source;
+    bench_connector connectors[];
+    // Followed by the weights of all the kernels
+} bench_conv_config;
+
+//! \brief Make the configuration of one source and some connectors as the
+//!     host writes it
+//! \param[in] kernel_side: The width and height of each kernel, which is odd
+//! \param[in] stride: The stride of each kernel in both dimensions
+//! \param[in] n_channels: The number of connectors, each with its own kernel
+//! \return The configuration
+static void *make_conv_config(
+        uint32_t kernel_side, uint32_t stride, uint32_t n_channels) {
+    uint32_t n_kernel_weights = kernel_side * kernel_side;
+    uint32_t n_weights = n_kernel_weights * n_channels;
+    bench_conv_config *config = calloc(1, sizeof(bench_conv_config) +
+            (n_channels * sizeof(bench_connector)) +
+            ((n_weights + 1) & ~1) * sizeof(lc_weight_t));
+    uint32_t post_side = SIDE / stride;
+    config->post_start = (lc_coord_t) {.row = 0, .col = 0};
+    config->post_end = (lc_coord_t) {
+        .row = post_side - 1, .col = post_side - 1};
+    config->post_shape = (lc_shape_t) {
+        .height = post_side, .width = post_side};
+    config->n_sources = 1;
+    config->n_connectors_total = n_channels;
+    config->n_weights_total = n_weights;
+
+    bench_source_info *source = &config->source;
+    source->key_info.key = 0;
+    source->key_info.mask = 0xFFFFFFFF << LOG_N_NEURONS;
+    source->key_info.start = 0;
+    source->key_info.count = n_channels;
+    source->source_height_per_core = SIDE;
+    source->source_width_per_core = SIDE;
+    source->source_height_last_core = SIDE;
+    source->source_width_last_core = SIDE;
+    source->cores_per_source_height = 1;
+    source->cores_per_source_width = 1;
+    source->source_width_div = make_div_const(SIDE);
+    source->source_width_last_div = make_div_const(SIDE);
+    source->cores_per_width_div = make_div_const(1);
+
+    for (uint32_t c = 0; c < n_channels; c++) {
+        bench_connector *conn = &config->connectors[c];
+        conn->kernel = (lc_shape_t) {
+            .height = kernel_side, .width = kernel_side};
+        conn->padding = (lc_shape_t) {
+            .height = kernel_side / 2, .width = kernel_side / 2};
+        conn->positive_synapse_type = 0;
+        conn->negative_synapse_type = 1;
+        conn->delay = 1;
+        conn->kernel_index = c * n_kernel_weights;
+        conn->stride_height_div = make_div_const(stride);
+        conn->stride_width_div = make_div_const(stride);
+        conn->pool_stride_height_div = make_div_const(1);
+        conn->pool_stride_width_div = make_div_const(1);
+    }
+
+    lc_weight_t *weights = (lc_weight_t *) &config->connectors[n_channels];
+    for (uint32_t w = 0; w < n_weights; w++) {
+        weights[w] = (int16_t) (bench_random() & 0xFF) - 128;
+    }
+    return config;
+}
+
+//! \brief Time processing spikes from random sources with one network
+//! \param[in] kernel_side: The width and height of each kernel
+//! \param[in] stride: The stride of each kernel
+//! \param[in] n_channels: The number of kernels the source is connected by
+//! \param[in] spikes_per_step: The spikes in each time step
+//! \param[in] ring_buffers: The ring buffers to add to
+static void time_spikes(
+        uint32_t kernel_side, uint32_t stride, uint32_t n_channels,
+        uint32_t spikes_per_step, ring_buffer_t *ring_buffers) {
+    void *config = make_conv_config(kernel_side, stride, n_channels);
+    if (!local_only_impl_initialise(config)) {
+        exit(1);
+    }
+    uint32_t spikes[N_SPIKES];
+    make_random_spikes(spikes, N_SPIKES, LOG_N_NEURONS);
+
+    char variant[64];
+    snprintf(variant, sizeof(variant), "%ux%u/%u, %u ch, %u/step",
+            kernel_side, kernel_side, stride, n_channels, spikes_per_step);
+    time_local_only_spikes("local_only_conv", variant, spikes, N_SPIKES,
+            spikes_per_step, 1, ring_buffers);
+    free(config);
+}
+
+int main(void) {
+    ring_buffer_t *ring_buffers = calloc(
+            1 << (LOG_MAX_DELAY + LOG_N_SYNAPSE_TYPES + LOG_N_NEURONS),
+            sizeof(ring_buffer_t));
+
+    // Kernel sizes
+    time_spikes(3, 1, 1, SPIKES_PER_STEP, ring_buffers);
+    time_spikes(5, 1, 1, SPIKES_PER_STEP, ring_buffers);
+    time_spikes(7, 1, 1, SPIKES_PER_STEP, ring_buffers);
+    time_spikes(11, 1, 1, SPIKES_PER_STEP, ring_buffers);
+
+    // Strides
+    time_spikes(3, 2, 1, SPIKES_PER_STEP, ring_buffers);
+    time_spikes(7, 2, 1, SPIKES_PER_STEP, ring_buffers);
+
+    // Channels
+    time_spikes(3, 1, 4, SPIKES_PER_STEP, ring_buffers);
+    time_spikes(3, 1, 16, SPIKES_PER_STEP, ring_buffers);
+
+    // Input event rates
+    time_spikes(3, 1, 1, 4, ring_buffers);
+    time_spikes(3, 1, 1, 1024, ring_buffers);
+
+    bench_sink = ring_buffers[0];
+    free(ring_buffers);
+    return 0;
+}
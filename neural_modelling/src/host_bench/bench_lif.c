@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+//! \file
+//! \brief Microbenchmark of the LIF neuron update
+//! \details Times neuron_model_state_update() with a threshold check over a
+//!     core's worth of neurons.  REAL is a double in the host build, so this
+//!     measures the shape of the update, not the cost of the fixed-point
+//!     arithmetic.
+#include "bench.h"
+// maths-util.h only includes this for fixed point, but the model uses expk()
+#include <stdfix-exp.h>
+#include <neuron/models/neuron_model_lif_impl.h>
+#include <stdlib.h>
+
+//! The number of neurons updated in each time step
+#define N_NEURONS 256
+//! The number of time steps in each measurement
+#define N_STEPS 64
+//! The threshold voltage in mV
+#define V_THRESHOLD -50.0
+
+//! \brief Set up the neurons as neuron_model_initialise() would for
+//!     IF_curr_exp defaults with a 1ms time step
+//! \param[out] neurons: The neurons to set up
+static void make_neurons(neuron_t *neurons) {
+    for (uint32_t n = 0; n < N_NEURONS; n++) {
+        neuron_t *neuron = &neurons[n];
+        neuron->V_membrane = -65.0 + (bench_random() % 15);
+        neuron->V_rest = -65.0;
+        neuron->R_membrane = 20.0;
+        neuron->exp_TC = exp(-1.0 / 20.0);
+        neuron->I_offset = 0.0;
+        neuron->refract_timer = 0;
+        neuron->V_reset = -65.0;
+        neuron->T_refract = 2;
+    }
+}
+
+//! \brief Time updating the neurons for a number of time steps
+//! \param[in] variant: What the input is
+//! \param[in] exc_input: The excitatory input of every neuron
+static void time_updates(const char *variant, input_t exc_input) {
+    neuron_t *neurons = malloc(N_NEURONS * sizeof(neuron_t));
+    uint64_t best = UINT64_MAX;
+    uint32_t n_spikes = 0;
+    input_t inh_input = 0.0;
+    for (uint32_t repeat = 0; repeat < BENCH_REPEATS; repeat++) {
+        make_neurons(neurons);
+        n_spikes = 0;
+        uint64_t start = bench_now();
+        for (uint32_t t = 0; t < N_STEPS; t++) {
+            for (uint32_t n = 0; n < N_NEURONS; n++) {
+                state_t v = neuron_model_state_update(
+                        1, &exc_input, 1, &inh_input, 0.0, 0.0, &neurons[n]);
+                if (v > V_THRESHOLD) {
+                    neuron_model_has_spiked(&neurons[n]);
+                    n_spikes++;
+                }
+            }
+        }
+        bench_keep_best(&best, start);
+    }
+    bench_sink = n_spikes;
+    bench_report("neuron_model_lif", variant, best, N_NEURONS * N_STEPS);
+    free(neurons);
+}
+
+int main(void) {
+    time_updates("no input", 0.0);
+    time_updates("driven to spike", 2.0);
+    return 0;
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+//! \file
+//! \brief Helpers shared by the microbenchmarks of the local-only
+//!     implementations
+#ifndef _BENCH_LOCAL_ONLY_H_
+#define _BENCH_LOCAL_ONLY_H_
+
+#include "bench.h"
+#include <neuron/local_only/local_only_impl.h>
+#include <neuron/local_only/local_only_2d_common.h>
+
+//! \brief Make the constants to divide by a value, as get_div_const() does
+//!     on the host
+//! \param[in] value: The value to divide by
+//! \return The constants
+static inline div_const make_div_const(uint32_t value) {
+    uint32_t log_value = 0;
+    while ((1u << log_value) < value) {
+        log_value++;
+    }
+    uint64_t m = ((((uint64_t) 1 << log_value) - value) << 16) / value + 1;
+    return (div_const) {
+        .m = m,
+        .sh1 = (log_value < 1) ? log_value : 1,
+        .sh2 = (log_value > 1) ? log_value - 1 : 0
+    };
+}
+
+//! \brief Make spikes from random neurons of a source
+//! \param[out] spikes: Where to put the spikes
+//! \param[in] n_spikes: The number of spikes to make
+//! \param[in] log_n_neurons: Log_2 of the number of neurons in the source
+static inline void make_random_spikes(
+        uint32_t *spikes, uint32_t n_spikes, uint32_t log_n_neurons) {
+    for (uint32_t s = 0; s < n_spikes; s++) {
+        spikes[s] = bench_random() & ((1 << log_n_neurons) - 1);
+    }
+}
+
+//! \brief Time local_only_impl_process_spike() for some spikes, as the spike
+//!     processing loop of local_only.c calls it, and report the cost of each
+//! \param[in] kernel: The name of the implementation
+//! \param[in] variant: What the network is
+//! \param[in] spikes: The spikes to process
+//! \param[in] n_spikes: The number of spikes
+//! \param[in] spikes_per_step: The spikes in each time step, which decides
+//!     how far apart in the ring buffers the spikes land
+//! \param[in] count: The number of times each spike was received
+//! \param[in] ring_buffers: The ring buffers to add to
+static inline void time_local_only_spikes(
+        const char *kernel, const char *variant, const uint32_t *spikes,
+        uint32_t n_spikes, uint32_t spikes_per_step, uint32_t count,
+        ring_buffer_t *ring_buffers) {
+    uint64_t best = UINT64_MAX;
+    for (uint32_t repeat = 0; repeat < BENCH_REPEATS; repeat++) {
+        uint32_t time = 0;
+        uint32_t in_step = 0;
+        uint64_t start = bench_now();
+        for (uint32_t s = 0; s < n_spikes; s++) {
+            local_only_impl_process_spike(time, spikes[s], count, ring_buffers);
+            if (++in_step == spikes_per_step) {
+                in_step = 0;
+                time++;
+            }
+        }
+        bench_keep_best(&best, start);
+    }
+    bench_report(kernel, variant, best, n_spikes);
+}
+
+#endif // _BENCH_LOCAL_ONLY_H_
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+//! \file
+//! \brief Microbenchmark of the pooled dense layer of
+//!     local_only_pool_dense_impl.c
+//! \details Times local_only_impl_process_spike() for spikes from a 2D source
+//!     pooled onto all the neurons of a core, for a range of pooling strides,
+//!     targets, numbers of channels (connectors with their own weights from
+//!     the same source) and spikes in each time step.
+#include "bench_local_only.h"
+#include <stdlib.h>
+
+//! The width and height of the source, as a power of 2
+#define LOG_SIDE 4
+//! The number of synapse types
+#define LOG_N_SYNAPSE_TYPES 1
+//! The delay bits of the ring buffers
+#define LOG_MAX_DELAY 4
+//! The most post-neurons, as a power of 2
+#define LOG_MAX_POST 7
+//! The number of spikes in each measurement
+#define N_SPIKES 1024
+//! The spikes in each time step, unless the variant says otherwise
+#define SPIKES_PER_STEP 64
+//! The number of dimensions of the source
+#define N_DIMS 2
+
+//! The width and height of the source
+#define SIDE (1 << LOG_SIDE)
+//! The number of neurons in the source
+#define LOG_N_NEURONS (2 * LOG_SIDE)
+
+//! The mask to get the synaptic delay from a "synapse", as local_only.c has
+uint32_t synapse_delay_mask = (1 << LOG_MAX_DELAY) - 1;
+
+//! The number of bits used by the synapse type and post-neuron index
+uint32_t synapse_type_index_bits = LOG_MAX_POST + LOG_N_SYNAPSE_TYPES;
+
+//! The number of bits used by just the post-neuron index
+uint32_t synapse_index_bits = LOG_MAX_POST;
+
+//! \brief The layout of a dimension of a source in SDRAM, as source_dim in
+//!     local_only_pool_dense_impl.c
+typedef struct {
+    uint32_t size_per_core;
+    uint32_t cum_size_per_core;
+    div_const cum_size_per_core_div;
+    uint32_t cores;
+    uint32_t cum_cores;
+    div_const cum_cores_div;
+    uint32_t size_last_core;
+    uint32_t cum_size_last_core;
+    div_const cum_size_last_core_div;
+} bench_source_dim;
+
+//! \brief The layout of a source in SDRAM, as source_info in
+//!     local_only_pool_dense_impl.c, with the dimensions this uses
+typedef struct {
+    key_info key_info;
+    uint32_t n_dims;
+    bench_source_dim source_dim[N_DIMS];
+} bench_source_info;
+
+//! \brief The layout of a connector in SDRAM, as connector in
+//!     local_only_pool_dense_impl.c, with the dimensions this uses
+typedef struct {
+    uint16_t n_dims;
+    uint16_t n_weights;
+    uint16_t positive_synapse_type;
+    uint16_t negative_synapse_type;
+    uint16_t delay_stage;
+    uint16_t delay;
+    div_const pool_stride_div[N_DIMS];
+    // Followed by the weights, padded to a word
+} bench_connector;
+
+//! \brief The layout of the configuration in SDRAM, as conv_config in
+//!     local_only_pool_dense_impl.c, with the one source this uses
+typedef struct {
+    uint32_t n_post;
+    uint32_t n_sources;
+    uint32_t n_connectors;
+    bench_source_info source;
+    // Followed by the connectors
+} bench_pool_dense_config;
+
+//! \brief Make the configuration of one source and some connectors as the
+//!     host writes it
+//! \param[in] pool_stride: The pooling stride in both dimensions
+//! \param[in] n_post: The number of post-neurons
+//! \param[in] n_channels: The number of connectors, each with its own weights
+//! \return The configuration
+static void *make_pool_dense_config(
+        uint32_t pool_stride, uint32_t n_post, uint32_t n_channels) {
+    uint32_t pooled_side = SIDE / pool_stride;
+    uint32_t n_weights = pooled_side * pooled_side * n_post;
+    uint32_t connector_size = sizeof(bench_connector) +
+            ((n_weights + 1) & ~1) * sizeof(lc_weight_t);
+    bench_pool_dense_config *config = calloc(1,
+            sizeof(bench_pool_dense_config) + (n_channels * connector_size));
+    config->n_post = n_post;
+    config->n_sources = 1;
+    config->n_connectors = n_channels;
+
+    // The dimensions are written from the last, as the host does
+    bench_source_info *source = &config->source;
+    source->key_info.key = 0;
+    source->key_info.mask = 0xFFFFFFFF << LOG_N_NEURONS;
+    source->key_info.start = 0;
+    source->key_info.count = n_channels;
+    source->n_dims = N_DIMS;
+    for (uint32_t d = 0; d < N_DIMS; d++) {
+        uint32_t cum_size = (d == 0) ? SIDE : 1;
+        source->source_dim[d] = (bench_source_dim) {
+            .size_per_core = SIDE,
+            .cum_size_per_core = cum_size,
+            .cum_size_per_core_div = make_div_const(cum_size),
+            .cores = 1,
+            .cum_cores = 1,
+            .cum_cores_div = make_div_const(1),
+            .size_last_core = SIDE,
+            .cum_size_last_core = cum_size,
+            .cum_size_last_core_div = make_div_const(cum_size)
+        };
+    }
+
+    uint8_t *next = (uint8_t *) &config[1];
+    for (uint32_t c = 0; c < n_channels; c++) {
+        bench_connector *conn = (bench_connector *) next;
+        conn->n_dims = N_DIMS;
+        conn->n_weights = n_weights;
+        conn->positive_synapse_type = 0;
+        conn->negative_synapse_type = 1;
+        conn->delay = 1;
+        for (uint32_t d = 0; d < N_DIMS; d++) {
+            conn->pool_stride_div[d] = make_div_const(pool_stride);
+        }
+        lc_weight_t *weights = (lc_weight_t *) &conn[1];
+        for (uint32_t w = 0; w < n_weights; w++) {
+            weights[w] = (int16_t) (bench_random() & 0xFF) - 128;
+        }
+        next += connector_size;
+    }
+    return config;
+}
+
+//! \brief Time processing spikes from random sources with one network
+//! \param[in] pool_stride: The pooling stride
+//! \param[in] n_post: The number of post-neurons
+//! \param[in] n_channels: The number of connectors from the source
+//! \param[in] spikes_per_step: The spikes in each time step
+//! \param[in] count: The number of times each spike was received
+//! \param[in] ring_buffers: The ring buffers to add to
+static void time_spikes(
+        uint32_t pool_stride, uint32_t n_post, uint32_t n_channels,
+        uint32_t spikes_per_step, uint32_t count,
+        ring_buffer_t *ring_buffers) {
+    void *config = make_pool_dense_config(pool_stride, n_post, n_channels);
+    if (!local_only_impl_initialise(config)) {
+        exit(1);
+    }
+    uint32_t spikes[N_SPIKES];
+    make_random_spikes(spikes, N_SPIKES, LOG_N_NEURONS);
+
+    char variant[64];
+    snprintf(variant, sizeof(variant), "pool %u to %u, %u ch, %u/step%s",
+            pool_stride, n_post, n_channels, spikes_per_step,
+            (count > 1) ? ", x2" : "");
+    time_local_only_spikes("local_only_pool_dense", variant, spikes, N_SPIKES,
+            spikes_per_step, count, ring_buffers);
+    free(config);
+}
+
+int main(void) {
+    ring_buffer_t *ring_buffers = calloc(
+            1 << (LOG_MAX_DELAY + LOG_N_SYNAPSE_TYPES + LOG_MAX_POST),
+            sizeof(ring_buffer_t));
+
+    // Pooling strides
+    time_spikes(1, 32, 1, SPIKES_PER_STEP, 1, ring_buffers);
+    time_spikes(2, 32, 1, SPIKES_PER_STEP, 1, ring_buffers);
+    time_spikes(4, 32, 1, SPIKES_PER_STEP, 1, ring_buffers);
+
+    // Targets
+    time_spikes(2, 128, 1, SPIKES_PER_STEP, 1, ring_buffers);
+    time_spikes(2, 31, 1, SPIKES_PER_STEP, 1, ring_buffers);
+
+    // Channels
+    time_spikes(2, 32, 4, SPIKES_PER_STEP, 1, ring_buffers);
+
+    // Input event rates, and spikes received twice, as merged by key
+    time_spikes(2, 32, 1, 4, 1, ring_buffers);
+    time_spikes(2, 32, 1, 1024, 1, ring_buffers);
+    time_spikes(2, 32, 1, SPIKES_PER_STEP, 2, ring_buffers);
+
+    bench_sink = ring_buffers[0];
+    free(ring_buffers);
+    return 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+//! \file
+//! \brief Microbenchmark of the master population table lookup
+//! \details Times population_table_get_first_address() and the following
+//!     population_table_get_next_address() calls for each incoming spike,
+//!     using the binary search and then the direct index into the table.
+#include "bench.h"
+#include <neuron/population_table/population_table.h>
+#include <stdlib.h>
+
+//! The number of entries in the table
+#define LOG_N_ENTRIES 7
+//! The number of neurons per source core; the key bits below the mask
+#define LOG_N_SOURCE_NEURONS 8
+//! The number of spikes looked up in each measurement
+#define N_SPIKES 4096
+//! The spikes in a burst from the same source in the bursty variant
+#define BURST_LENGTH 16
+
+//! The number of entries in the table
+#define N_ENTRIES (1 << LOG_N_ENTRIES)
+
+//! \brief Stand-in for the synaptic matrix; the lookup only computes
+//!     addresses within it
+static uint32_t synaptic_matrix[4];
+
+//! \brief Make the table configuration as the host writes it
+//! \param[in] direct: Whether to add a direct index
+//! \return The configuration
+static address_t make_table(bool direct) {
+    uint32_t n_index = direct ? N_ENTRIES : 0;
+    pop_table_config_t *config = calloc(1, sizeof(pop_table_config_t) +
+            N_ENTRIES * sizeof(master_population_table_entry) +
+            N_ENTRIES * sizeof(address_list_entry) +
+            sizeof(pop_table_direct_config_t) + n_index * sizeof(uint16_t));
+    config->table_length = N_ENTRIES;
+    config->addr_list_length = N_ENTRIES;
+    address_list_entry *addresses =
+            (address_list_entry *) &config->data[N_ENTRIES];
+    for (uint32_t i = 0; i < N_ENTRIES; i++) {
+        master_population_table_entry *entry = &config->data[i];
+        entry->key = i << LOG_N_SOURCE_NEURONS;
+        entry->mask = 0xFFFFFFFF << LOG_N_SOURCE_NEURONS;
+        entry->start = i;
+        entry->count = 1;
+        entry->n_neurons = 1 << LOG_N_SOURCE_NEURONS;
+        entry->n_words = get_bit_field_size(1 << LOG_N_SOURCE_NEURONS);
+        addresses[i].row_length = 63;
+        addresses[i].address = i << 10;
+    }
+    pop_table_direct_config_t *direct_config =
+            (pop_table_direct_config_t *) &addresses[N_ENTRIES];
+    if (direct) {
+        direct_config->shift = LOG_N_SOURCE_NEURONS;
+        direct_config->n_bits = LOG_N_ENTRIES;
+        for (uint32_t i = 0; i < N_ENTRIES; i++) {
+            direct_config->index[i] = i;
+        }
+    }
+    return (address_t) config;
+}
+
+//! \brief Make spikes from random sources
+//! \param[out] spikes: The spikes made
+//! \param[in] burst_length: The number of spikes in a row from one source
+static void make_spikes(spike_t *spikes, uint32_t burst_length) {
+    for (uint32_t s = 0; s < N_SPIKES; s += burst_length) {
+        uint32_t source = (bench_random() % N_ENTRIES) << LOG_N_SOURCE_NEURONS;
+        for (uint32_t b = 0; b < burst_length; b++) {
+            spikes[s + b] = source |
+                    (bench_random() & ((1 << LOG_N_SOURCE_NEURONS) - 1));
+        }
+    }
+}
+
+//! \brief Time looking up a set of spikes
+//! \param[in] variant: What the table and spikes are
+//! \param[in] spikes: The spikes
+static void time_lookups(const char *variant, const spike_t *spikes) {
+    uint64_t best = UINT64_MAX;
+    uint32_t n_bytes = 0;
+    for (uint32_t repeat = 0; repeat < BENCH_REPEATS; repeat++) {
+        n_bytes = 0;
+        uint64_t start = bench_now();
+        for (uint32_t s = 0; s < N_SPIKES; s++) {
+            pop_table_lookup_result_t result;
+            spike_t spike = spikes[s];
+            if (population_table_get_first_address(spike, &result)) {
+                do {
+                    n_bytes += result.n_bytes_to_transfer;
+                } while (population_table_get_next_address(&spike, &result));
+            }
+        }
+        bench_keep_best(&best, start);
+    }
+    bench_sink = n_bytes;
+    bench_report("population_table", variant, best, N_SPIKES);
+}
+
+int main(void) {
+    uint32_t row_max_n_words;
+    spike_t *spikes = malloc(N_SPIKES * sizeof(spike_t));
+
+    // The direct index is only ever added, so the search goes first
+    address_t table = make_table(false);
+    if (!population_table_initialise(
+            table, synaptic_matrix, &row_max_n_words)) {
+        return 1;
+    }
+    make_spikes(spikes, 1);
+    time_lookups("binary search, random", spikes);
+    make_spikes(spikes, BURST_LENGTH);
+    time_lookups("binary search, bursts", spikes);
+    free(table);
+
+    table = make_table(true);
+    if (!population_table_initialise(
+            table, synaptic_matrix, &row_max_n_words)) {
+        return 1;
+    }
+    make_spikes(spikes, 1);
+    time_lookups("direct index, random", spikes);
+    make_spikes(spikes, BURST_LENGTH);
+    time_lookups("direct index, bursts", spikes);
+    free(table);
+
+    free(spikes);
+    return 0;
+}
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+//! \file
+//! \brief Microbenchmark of the STDP synapse processing of
+//!     synapse_dynamics_stdp_mad_impl.c with the pair rule and additive
+//!     weights
+//! \details Times synapses_process_synaptic_row() on plastic rows, with
+//!     post-synaptic spikes added between the rows at a range of rates.
+#include "bench.h"
+#include <neuron/synapses.h>
+#include <neuron/plasticity/synapse_dynamics.h>
+#include <stdlib.h>
+#include <math.h>
+
+//! The number of neurons on the benchmarked core
+#define LOG_N_NEURONS 8
+//! The number of synapse types
+#define LOG_N_SYNAPSE_TYPES 1
+//! The delay bits of the rows and the ring buffers
+#define LOG_MAX_DELAY 4
+//! The number of rows
+#define N_ROWS 64
+//! The number of synapses in each row
+#define N_SYNAPSES 64
+//! The number of time steps in each measurement
+#define N_STEPS 16
+//! The number of post-synaptic events held for each neuron
+#define N_POST_EVENTS 16
+//! The number of entries in each timing lookup table
+#define LUT_SIZE 256
+//! The time constant of both timing lookup tables, in time steps
+#define TAU 20.0
+
+//! The number of neurons on the core
+#define N_NEURONS (1 << LOG_N_NEURONS)
+//! The number of synapse types
+#define N_SYNAPSE_TYPES (1 << LOG_N_SYNAPSE_TYPES)
+//! The bits of a synaptic word below the delay
+#define TYPE_INDEX_BITS (LOG_N_NEURONS + LOG_N_SYNAPSE_TYPES)
+//! The words of the plastic region of a row: the pre-synaptic history of a
+//! time and a 16-bit trace, then a 16-bit weight per synapse
+#define N_PLASTIC_WORDS (2 + (N_SYNAPSES + 1) / 2)
+
+//! \brief The synapse parameters, in the order of struct synapse_params in
+//!     synapses.c
+static uint32_t synapse_params[] = {
+    N_NEURONS, N_SYNAPSE_TYPES,
+    LOG_N_NEURONS, LOG_N_SYNAPSE_TYPES, LOG_MAX_DELAY, LOG_MAX_DELAY,
+    0, 256, 0xFFFFFFFF, 0xFFFFFFFF, 0,
+    // The shifts, peaks and delay bits of each synapse type
+    0, 0, 0, 0, LOG_MAX_DELAY, LOG_MAX_DELAY
+};
+
+//! The simulation time, which only goes forward over all the measurements
+static uint32_t sim_time = 1;
+
+//! \brief Write a timing lookup table of an exponential decay
+//! \param[in] words: Where to write the table
+//! \return The words after the table
+static uint32_t *write_lut(uint32_t *words) {
+    int16_lut *lut = (int16_lut *) words;
+    lut->size = LUT_SIZE;
+    lut->shift = 0;
+    for (uint32_t t = 0; t < LUT_SIZE; t++) {
+        lut->values[t] = (int16_t) (STDP_FIXED_POINT_ONE * exp(-(t / TAU)));
+    }
+    return &words[1 + LUT_SIZE / 2];
+}
+
+//! \brief Make the STDP configuration as the host writes it
+//! \return The configuration
+static address_t make_stdp_config(void) {
+    uint32_t *config = calloc(2 + 2 * (1 + LUT_SIZE / 2) + 4 * N_SYNAPSE_TYPES,
+            sizeof(uint32_t));
+    config[0] = 0;
+    config[1] = N_POST_EVENTS;
+    uint32_t *words = write_lut(write_lut(&config[2]));
+    for (uint32_t s = 0; s < N_SYNAPSE_TYPES; s++) {
+        // min, max, A+ and A- as s16.15
+        *words++ = 0;
+        *words++ = 1 << 15;
+        *words++ = 328;
+        *words++ = 393;
+    }
+    return config;
+}
+
+//! \brief Make plastic rows of random synapses
+//! \param[out] rows: The rows made
+static void make_rows(synaptic_row_t *rows) {
+    for (uint32_t r = 0; r < N_ROWS; r++) {
+        synapse_row_plastic_part_t *row = calloc(1,
+                sizeof(synapse_row_plastic_part_t) +
+                N_PLASTIC_WORDS * sizeof(uint32_t) +
+                sizeof(synapse_row_fixed_part_t) +
+                N_SYNAPSES * sizeof(control_t));
+        row->size = N_PLASTIC_WORDS;
+        uint16_t *weights = (uint16_t *) &row->data[2];
+        for (uint32_t s = 0; s < N_SYNAPSES; s++) {
+            weights[s] = bench_random() & 0x7FFF;
+        }
+        synapse_row_fixed_part_t *fixed = synapse_row_fixed_region(
+                (synaptic_row_t) row);
+        fixed->num_fixed = 0;
+        fixed->num_plastic = N_SYNAPSES;
+        fixed->format = SYNAPSE_ROW_PLASTIC_ONLY;
+        control_t *controls = synapse_row_plastic_controls(fixed);
+        for (uint32_t s = 0; s < N_SYNAPSES; s++) {
+            controls[s] = ((1 + (bench_random() % 15)) << TYPE_INDEX_BITS) |
+                    ((bench_random() & 1) << LOG_N_NEURONS) |
+                    (bench_random() & (N_NEURONS - 1));
+        }
+        rows[r] = (synaptic_row_t) row;
+    }
+}
+
+//! \brief Time processing the rows once each time step, adding post-synaptic
+//!     spikes first
+//! \param[in] variant: What the post-synaptic activity is
+//! \param[in] rows: The rows
+//! \param[in] post_per_step: The number of neurons that spike each time step
+static void time_rows(
+        const char *variant, synaptic_row_t *rows, uint32_t post_per_step) {
+    uint64_t best = UINT64_MAX;
+    for (uint32_t repeat = 0; repeat < BENCH_REPEATS; repeat++) {
+        uint64_t start = bench_now();
+        for (uint32_t t = 0; t < N_STEPS; t++, sim_time++) {
+            for (uint32_t p = 0; p < post_per_step; p++) {
+                synapse_dynamics_process_post_synaptic_event(
+                        sim_time, bench_random() & (N_NEURONS - 1));
+            }
+            for (uint32_t r = 0; r < N_ROWS; r++) {
+                bool write_back;
+                synapses_process_synaptic_row(sim_time, 0, 0, rows[r], &write_back);
+            }
+        }
+        bench_keep_best(&best, start);
+    }
+    bench_report("process_plastic_synapses", variant, best,
+            N_STEPS * N_ROWS * N_SYNAPSES);
+}
+
+int main(void) {
+    uint32_t n_neurons, n_synapse_types, incoming_spike_buffer_size;
+    ring_buffer_t *ring_buffers;
+    uint32_t *ring_buffer_shifts;
+    bool clear_input_buffers;
+    if (!synapses_initialise(synapse_params, &n_neurons, &n_synapse_types,
+            &ring_buffers, &ring_buffer_shifts, &clear_input_buffers,
+            &incoming_spike_buffer_size)) {
+        return 1;
+    }
+    address_t stdp_config = make_stdp_config();
+    if (!synapse_dynamics_initialise(stdp_config, n_neurons, n_synapse_types,
+            ring_buffer_shifts)) {
+        return 1;
+    }
+
+    synaptic_row_t rows[N_ROWS];
+    make_rows(rows);
+    time_rows("no post spikes", rows, 0);
+    time_rows("1 post spike per step", rows, 1);
+    time_rows("16 post spikes per step", rows, 16);
+    time_rows("every neuron spikes", rows, N_NEURONS);
+    for (uint32_t r = 0; r < N_ROWS; r++) {
+        free(rows[r]);
+    }
+    free(stdp_config);
+
+    bench_sink = ring_buffers[0];
+    return 0;
+}
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//! \file
+//! \brief Microbenchmark of the static synapse processing of synapses.c
+//! \details Times synapses_process_synaptic_row() on rows of each fixed
+//!     format, which ends in process_fixed_synapses().
+#include "bench.h"
+#include <neuron/synapses.h>
+#include <stdlib.h>
+
+//! The number of neurons on the benchmarked core
+#define LOG_N_NEURONS 8
+//! The number of synapse types
+#define LOG_N_SYNAPSE_TYPES 1
+//! The delay bits of the rows and the ring buffers
+#define LOG_MAX_DELAY 4
+//! The number of rows processed in each measurement
+#define N_ROWS 256
+//! The number of synapses in each sparse row
+#define N_SPARSE_SYNAPSES 64
+
+//! The bits of a synaptic word below the delay
+#define TYPE_INDEX_BITS (LOG_N_NEURONS + LOG_N_SYNAPSE_TYPES)
+
+//! \brief The synapse parameters, in the order of struct synapse_params in
+//!     synapses.c
+static uint32_t synapse_params[] = {
+    1 << LOG_N_NEURONS, 1 << LOG_N_SYNAPSE_TYPES,
+    LOG_N_NEURONS, LOG_N_SYNAPSE_TYPES, LOG_MAX_DELAY, LOG_MAX_DELAY,
+    0, 256, 0xFFFFFFFF, 0xFFFFFFFF, 0,
+    // The shifts, peaks and delay bits of each synapse type
+    0, 0, 0, 0, LOG_MAX_DELAY, LOG_MAX_DELAY
+};
+
+//! \brief Make a synaptic word
+//! \param[in] weight: The weight
+//! \param[in] delay: The delay, 1 to 15
+//! \param[in] type: The synapse type
+//! \param[in] index: The index of the post-synaptic neuron
+//! \return The word
+static inline uint32_t synaptic_word(
+        uint32_t weight, uint32_t delay, uint32_t type, uint32_t index) {
+    return (weight << (32 - SYNAPSE_WEIGHT_BITS)) |
+            (delay << TYPE_INDEX_BITS) | (type << LOG_N_NEURONS) | index;
+}
+
+//! \brief Sort synaptic words by delay, as the host does for
+//!     ::SYNAPSE_ROW_DELAY_SORTED rows
+static int compare_delays(const void *a, const void *b) {
+    uint32_t delay_a = (*(const uint32_t *) a >> TYPE_INDEX_BITS) & 0xF;
+    uint32_t delay_b = (*(const uint32_t *) b >> TYPE_INDEX_BITS) & 0xF;
+    return (int) delay_a - (int) delay_b;
+}
+
+//! \brief Make a row with no plastic part
+//! \param[in] n_words: The number of fixed words
+//! \param[in] format: The ::synapse_row_format_flags of the row
+//! \return The row, with its fixed words to be filled in
+static synaptic_row_t make_row(uint32_t n_words, uint32_t format) {
+    synapse_row_plastic_part_t *row = calloc(1,
+            sizeof(synapse_row_plastic_part_t) +
+            sizeof(synapse_row_fixed_part_t) + n_words * sizeof(uint32_t));
+    row->size = 0;
+    synapse_row_fixed_part_t *fixed = synapse_row_fixed_region(
+            (synaptic_row_t) row);
+    fixed->num_fixed = n_words;
+    fixed->num_plastic = 0;
+    fixed->format = format;
+    return (synaptic_row_t) row;
+}
+
+//! \brief Make sparse rows of random synapses
+//! \param[out] rows: The rows made
+//! \param[in] format: The ::synapse_row_format_flags of the rows
+static void make_sparse_rows(synaptic_row_t *rows, uint32_t format) {
+    uint32_t single_delay = 1 + (bench_random() % 15);
+    for (uint32_t r = 0; r < N_ROWS; r++) {
+        rows[r] = make_row(N_SPARSE_SYNAPSES, format);
+        uint32_t *words = synapse_row_fixed_weight_controls(
+                synapse_row_fixed_region(rows[r]));
+        for (uint32_t s = 0; s < N_SPARSE_SYNAPSES; s++) {
+            uint32_t delay = (format & SYNAPSE_ROW_SINGLE_DELAY) ?
+                    single_delay : 1 + (bench_random() % 15);
+            words[s] = synaptic_word(1 + (bench_random() & 0xFF), delay,
+                    bench_random() & 1, bench_random() & 0xFF);
+        }
+        if (format & SYNAPSE_ROW_DELAY_SORTED) {
+            qsort(words, N_SPARSE_SYNAPSES, sizeof(uint32_t), compare_delays);
+        }
+    }
+}
+
+//! \brief Make dense rows with a weight for every neuron
+//! \param[out] rows: The rows made
+static void make_dense_rows(synaptic_row_t *rows) {
+    uint32_t n_weights = 1 << LOG_N_NEURONS;
+    for (uint32_t r = 0; r < N_ROWS; r++) {
+        rows[r] = make_row(1 + n_weights / 2, SYNAPSE_ROW_DENSE);
+        uint32_t *words = synapse_row_fixed_weight_controls(
+                synapse_row_fixed_region(rows[r]));
+        words[0] = (n_weights << SYNAPSE_ROW_DENSE_N_WEIGHTS_SHIFT) |
+                ((1 + (bench_random() % 15)) << TYPE_INDEX_BITS);
+        weight_t *weights = (weight_t *) &words[1];
+        for (uint32_t n = 0; n < n_weights; n++) {
+            weights[n] = bench_random() & 0xFF;
+        }
+    }
+}
+
+//! \brief Make shared weight rows with the same number of synapses as the
+//!     sparse rows
+//! \param[out] rows: The rows made
+static void make_shared_weight_rows(synaptic_row_t *rows) {
+    for (uint32_t r = 0; r < N_ROWS; r++) {
+        rows[r] = make_row(2 + N_SPARSE_SYNAPSES / 2,
+                SYNAPSE_ROW_SHARED_WEIGHT | SYNAPSE_ROW_SINGLE_DELAY |
+                SYNAPSE_ROW_SINGLE_TYPE);
+        uint32_t *words = synapse_row_fixed_weight_controls(
+                synapse_row_fixed_region(rows[r]));
+        words[0] = synaptic_word(1 + (bench_random() & 0xFF),
+                1 + (bench_random() % 15), bench_random() & 1, 0);
+        words[1] = N_SPARSE_SYNAPSES;
+        uint16_t *targets = (uint16_t *) &words[2];
+        for (uint32_t s = 0; s < N_SPARSE_SYNAPSES; s++) {
+            targets[s] = bench_random() & 0xFF;
+        }
+    }
+}
+
+//! \brief Time processing a set of rows, spread over 16 time steps so that
+//!     the adds land all over the ring buffers
+//! \param[in] variant: What the rows are
+//! \param[in] rows: The rows
+static void time_rows(const char *variant, synaptic_row_t *rows) {
+    uint64_t best = UINT64_MAX;
+    uint32_t events_before = synapses_get_pre_synaptic_events();
+    for (uint32_t repeat = 0; repeat < BENCH_REPEATS; repeat++) {
+        uint64_t start = bench_now();
+        for (uint32_t r = 0; r < N_ROWS; r++) {
+            bool write_back;
+            synapses_process_synaptic_row(
+                    r >> 4, 0, 0, rows[r], &write_back);
+        }
+        bench_keep_best(&best, start);
+    }
+    uint32_t n_events =
+            (synapses_get_pre_synaptic_events() - events_before) /
+            BENCH_REPEATS;
+    bench_report("process_fixed_synapses", variant, best, n_events);
+}
+
+//! \brief Free a set of rows
+//! \param[in] rows: The rows
+static void free_rows(synaptic_row_t *rows) {
+    for (uint32_t r = 0; r < N_ROWS; r++) {
+        free(rows[r]);
+    }
+}
+
+int main(void) {
+    uint32_t n_neurons, n_synapse_types, incoming_spike_buffer_size;
+    ring_buffer_t *ring_buffers;
+    uint32_t *ring_buffer_shifts;
+    bool clear_input_buffers;
+    if (!synapses_initialise(synapse_params, &n_neurons, &n_synapse_types,
+            &ring_buffers, &ring_buffer_shifts, &clear_input_buffers,
+            &incoming_spike_buffer_size)) {
+        return 1;
+    }
+
+    synaptic_row_t rows[N_ROWS];
+    make_sparse_rows(rows, 0);
+    time_rows("sparse", rows);
+    free_rows(rows);
+    make_sparse_rows(rows, SYNAPSE_ROW_DELAY_SORTED);
+    time_rows("sparse, sorted by delay", rows);
+    free_rows(rows);
+    make_sparse_rows(rows, SYNAPSE_ROW_SINGLE_DELAY);
+    time_rows("sparse, single delay", rows);
+    free_rows(rows);
+    make_dense_rows(rows);
+    time_rows("dense", rows);
+    free_rows(rows);
+    make_shared_weight_rows(rows);
+    time_rows("shared weight", rows);
+    free_rows(rows);
+
+    bench_sink = ring_buffers[0];
+    return 0;
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//! \file
+//! \brief Host stand-in for the spinn_common bit fields
+#ifndef __BIT_FIELD_H__
+#define __BIT_FIELD_H__
+
+#include <common-typedefs.h>
+
+typedef uint32_t *bit_field_t;
+
+static inline bool bit_field_test(bit_field_t b, index_t i) {
+    return (b[i >> 5] & (1u << (i & 0x1F))) != 0;
+}
+
+static inline void bit_field_set(bit_field_t b, index_t i) {
+    b[i >> 5] |= 1u << (i & 0x1F);
+}
+
+static inline void bit_field_clear(bit_field_t b, index_t i) {
+    b[i >> 5] &= ~(1u << (i & 0x1F));
+}
+
+static inline size_t get_bit_field_size(size_t n) {
+    return (n + 31) >> 5;
+}
+
+static inline void clear_bit_field(bit_field_t b, size_t s) {
+    for (size_t i = 0; i < s; i++) {
+        b[i] = 0;
+    }
+}
+
+static inline uint32_t count_bit_field(bit_field_t b, size_t s) {
+    uint32_t n = 0;
+    for (size_t i = 0; i < s; i++) {
+        n += __builtin_popcount(b[i]);
+    }
+    return n;
+}
+
+#endif // __BIT_FIELD_H__
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//! \file
+//! \brief Host stand-in for the spinn_common circular buffer; the kernels
+//!     benchmarked do not use the input buffer, so it is only declared
+#ifndef __HOST_CIRCULAR_BUFFER_H__
+#define __HOST_CIRCULAR_BUFFER_H__
+
+#include <common-typedefs.h>
+
+typedef struct _circular_buffer *circular_buffer;
+
+circular_buffer circular_buffer_initialize(uint32_t size);
+bool circular_buffer_add(circular_buffer buffer, uint32_t item);
+bool circular_buffer_get_next(circular_buffer buffer, uint32_t *item);
+bool circular_buffer_advance_if_next_equals(
+        circular_buffer buffer, uint32_t item);
+uint32_t circular_buffer_get_n_buffer_overflows(circular_buffer buffer);
+void circular_buffer_print_buffer(circular_buffer buffer);
+uint32_t circular_buffer_input(circular_buffer buffer);
+uint32_t circular_buffer_output(circular_buffer buffer);
+uint32_t circular_buffer_real_size(circular_buffer buffer);
+uint32_t circular_buffer_size(circular_buffer buffer);
+void circular_buffer_clear(circular_buffer buffer);
+uint32_t circular_buffer_value_at_index(
+        circular_buffer buffer, uint32_t index);
+
+#endif // __HOST_CIRCULAR_BUFFER_H__
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//! \file
+//! \brief Host stand-in for the spinnaker_tools common types
+#ifndef __COMMON_TYPEDEFS_H__
+#define __COMMON_TYPEDEFS_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "stdfix-full-iso.h"
+
+typedef unsigned int uint;
+typedef unsigned char uchar;
+typedef unsigned short ushort;
+typedef uint32_t *address_t;
+typedef uint32_t index_t;
+typedef uint32_t counter_t;
+typedef uint32_t timer_t;
+
+#define __int_t(n) __int_t_(n)
+#define __int_t_(n) int ## n ## _t
+#define __uint_t(n) __uint_t_(n)
+#define __uint_t_(n) uint ## n ## _t
+#define __type_of__ __typeof__
+#define __U64(x) ((uint64_t) (x))
+#define __LI(x) ((int32_t) (x))
+#define use(x) do { } while ((x) != (x))
+
+static inline uint64_t udiv64(uint64_t num, uint64_t den) {
+    return num / den;
+}
+
+#endif // __COMMON_TYPEDEFS_H__
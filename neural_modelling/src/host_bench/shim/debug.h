@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//! \file
+//! \brief Host stand-in for the spinnaker_tools logging
+//! \details Errors and warnings go to stderr; info and debug messages are
+//!     dropped so that they do not disturb the timing, though their
+//!     arguments are still seen by the compiler.  The fixed-point
+//!     conversions of io_printf are printed as the raw bits that the host
+//!     holds fixed-point values in.
+#ifndef __HOST_DEBUG_H__
+#define __HOST_DEBUG_H__
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define IO_BUF stdout
+#define IO_STD stdout
+#define RTE_SWERR 1
+#define RTE_ABORT 2
+
+//! \brief Print as io_printf does, with each fixed-point conversion (%k,
+//!     %K, %r or %R) printed as the integer that holds it
+//! \param[in] stream: Where to print
+//! \param[in] format: The io_printf format
+static inline void host_printf(FILE *stream, const char *format, ...) {
+    char host_format[256];
+    size_t i = 0;
+    for (const char *c = format; *c != '\0' && i < sizeof(host_format) - 1;
+            c++) {
+        char next = *c;
+        if (next == '%') {
+            // Copy the flags, width and precision up to the conversion
+            host_format[i++] = *c++;
+            while (*c != '\0' && strchr("-+ #0123456789.", *c) != NULL &&
+                    i < sizeof(host_format) - 2) {
+                host_format[i++] = *c++;
+            }
+            if (*c == '\0') {
+                break;
+            }
+            next = *c;
+            if (next == 'k' || next == 'r') {
+                next = 'd';
+            } else if (next == 'K' || next == 'R') {
+                next = 'u';
+            }
+        }
+        host_format[i++] = next;
+    }
+    host_format[i] = '\0';
+
+    va_list args;
+    va_start(args, format);
+    vfprintf(stream, host_format, args);
+    va_end(args);
+}
+
+#define io_printf(stream, ...) host_printf(stream, __VA_ARGS__)
+#define log_error(...) \
+    do { host_printf(stderr, "[ERROR] " __VA_ARGS__); fputc('\n', stderr); } \
+    while (0)
+#define log_warning(...) \
+    do { \
+        host_printf(stderr, "[WARNING] " __VA_ARGS__); fputc('\n', stderr); \
+    } while (0)
+#define log_info(...) \
+    do { if (0) { host_printf(stderr, __VA_ARGS__); } } while (0)
+#define log_debug(...) \
+    do { if (0) { host_printf(stderr, __VA_ARGS__); } } while (0)
+#define rt_error(code, ...) exit(code)
+
+#endif // __HOST_DEBUG_H__
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//! \file
+//! \brief Host stand-in for the bit field filter layout of
+//!     SpiNNFrontEndCommon
+#ifndef __FILTER_INFO_H__
+#define __FILTER_INFO_H__
+
+#include <common-typedefs.h>
+#include <bit_field.h>
+
+//! A bit field filter for one source
+typedef struct filter_info_t {
+    //! The key of the source
+    uint32_t key;
+    //! Whether the filter has been merged into the routing tables
+    uint32_t merged: 1;
+    //! Whether every bit of the filter is set
+    uint32_t all_ones: 1;
+    //! The number of atoms per source core
+    uint32_t n_atoms_per_core: 30;
+    //! The shift to get the source core from a key
+    uint32_t core_shift: 5;
+    //! The number of atoms in the filter
+    uint32_t n_atoms: 27;
+    //! The bits of the filter
+    uint32_t data[];
+} filter_info_t;
+
+//! The filters of a core
+typedef struct filter_region_t {
+    //! The number of filters that only filter redundant packets
+    uint32_t n_redundancy_filters;
+    //! The number of filters
+    uint32_t n_filters;
+    //! The filters
+    filter_info_t filters[];
+} filter_region_t;
+
+#endif // __FILTER_INFO_H__
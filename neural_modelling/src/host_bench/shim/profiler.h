@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//! \file
+//! \brief Host stand-in for the header of the same name; nothing in it is
+//!     used by the kernels benchmarked
+#ifndef __HOST_PROFILER_H__
+#define __HOST_PROFILER_H__
+
+#define profiler_write_entry(tag) do { } while (0)
+#define profiler_write_entry_disable_irq_fiq(tag) do { } while (0)
+#define profiler_write_entry_disable_fiq(tag) do { } while (0)
+
+#endif // __HOST_PROFILER_H__
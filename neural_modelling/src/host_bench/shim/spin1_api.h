@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//! \file
+//! \brief Host stand-in for the parts of the SpiNNaker API used by the
+//!     kernels
+#ifndef __HOST_SPIN1_API_H__
+#define __HOST_SPIN1_API_H__
+
+#include <common-typedefs.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define spin1_malloc(size) malloc(size)
+#define spin1_memcpy(dst, src, size) memcpy(dst, src, size)
+#define sark_alloc(n, size) malloc((n) * (size))
+#define sark_free(p) free(p)
+#define spin1_int_disable() 0
+#define spin1_fiq_disable() 0
+#define spin1_mode_restore(state) ((void) (state))
+#define spin1_get_chip_id() 0
+#define spin1_get_core_id() 1
+#define spin1_get_simulation_time() 0
+#define sark_heap_max(heap, flags) 0
+
+//! Indices of the timer 1 registers in ::tc
+enum {
+    T1_LOAD = 0,
+    T1_COUNT = 1
+};
+
+//! \brief Stands in for the timer registers; the count stays at zero, so
+//!     anything timed on the host reads as taking no time
+static volatile uint32_t tc[2] __attribute__((__unused__));
+
+//! Stands in for the SARK globals
+static struct {
+    void *heap;
+} sark __attribute__((__unused__));
+
+static inline uint32_t __smulbb(int32_t a, int32_t b) {
+    return (int16_t) a * (int16_t) b;
+}
+
+static inline uint32_t __smultb(int32_t a, int32_t b) {
+    return (a >> 16) * (int16_t) b;
+}
+
+static inline uint32_t __smulbt(int32_t a, int32_t b) {
+    return (int16_t) a * (b >> 16);
+}
+
+static inline uint32_t __smultt(int32_t a, int32_t b) {
+    return (a >> 16) * (b >> 16);
+}
+
+#endif // __HOST_SPIN1_API_H__
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//! \file
+//! \brief Host stand-in for the spinn_common header of the same name
+#ifndef __HOST_SQRT_H__
+#define __HOST_SQRT_H__
+
+#include "stdfix-full-iso.h"
+#include <math.h>
+
+//! Only defined for ::REAL as double, as built with FLOATING_POINT
+#define sqrtk(x) sqrt(x)
+
+#endif // __HOST_SQRT_H__
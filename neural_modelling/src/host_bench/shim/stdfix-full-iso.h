@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//! \file
+//! \brief Host stand-in for the fixed-point conversions of spinn_common
+//! \details See stdfix.h; these convert between the raw bits and the types.
+#ifndef __HOST_STDFIX_FULL_ISO_H__
+#define __HOST_STDFIX_FULL_ISO_H__
+
+#include "stdfix.h"
+
+typedef accum s1615;
+typedef unsigned accum u1616;
+typedef fract s015;
+typedef unsigned fract u016;
+typedef long fract s031;
+typedef unsigned long fract u032;
+
+typedef int32_t int_k_t;
+typedef uint32_t uint_uk_t;
+typedef int32_t int_r_t;
+typedef uint32_t uint_ur_t;
+typedef int64_t int_lk_t;
+typedef uint64_t uint_ulk_t;
+typedef int32_t int_lr_t;
+typedef uint32_t uint_ulr_t;
+
+#define kbits(x) ((accum) (x))
+#define ukbits(x) ((unsigned accum) (x))
+#define lkbits(x) ((long accum) (x))
+#define ulkbits(x) ((unsigned long accum) (x))
+#define rbits(x) ((fract) (x))
+#define urbits(x) ((unsigned fract) (x))
+#define lrbits(x) ((long fract) (x))
+#define ulrbits(x) ((unsigned long fract) (x))
+#define bitsk(x) ((int_k_t) (x))
+#define bitsuk(x) ((uint_uk_t) (x))
+#define bitslk(x) ((int_lk_t) (x))
+#define bitsulk(x) ((uint_ulk_t) (x))
+#define bitsr(x) ((int_r_t) (x))
+#define bitsur(x) ((uint_ur_t) (x))
+#define bitslr(x) ((int_lr_t) (x))
+#define bitsulr(x) ((uint_ulr_t) (x))
+
+#define __stdfix_smul_uk(a, b) ((uint32_t) (((uint64_t) (a) * (b)) >> 16))
+#define __stdfix_smul_ulr(a, b) ((uint32_t) (((uint64_t) (a) * (b)) >> 32))
+
+#endif // __HOST_STDFIX_FULL_ISO_H__
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//! \file
+//! \brief Host stand-in for the fixed-point types of the ARM compiler
+//! \details Host compilers do not support ISO/IEC TR 18037 fixed-point
+//!     types, so each type is held as its raw bits in an integer.  The
+//!     conversions to and from bits are exact, as are addition, subtraction
+//!     and comparison; multiplication and division are not rescaled, so
+//!     kernels that multiply fixed-point values run the same instructions
+//!     but compute meaningless values.  Benchmarks time them but must not
+//!     check their results.
+#ifndef __HOST_STDFIX_H__
+#define __HOST_STDFIX_H__
+
+#include <stdint.h>
+
+#define _Accum int
+#define _Fract int
+#define _Sat
+#define accum _Accum
+#define fract _Fract
+#define sat _Sat
+
+#endif // __HOST_STDFIX_H__
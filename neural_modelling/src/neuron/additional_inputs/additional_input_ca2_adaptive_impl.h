@@ -79,6 +79,65 @@ static inline input_t additional_input_get_input_value_as_current(
     return -additional_input->i_ca2;
 }
 
+//! The additional inputs of all neurons can be decayed in one pass; see
+//! additional_input_decay_all()
+#define ADDITIONAL_INPUT_CAN_DECAY_ALL
+
+//! \brief The decay of the calcium current, when all the neurons have the
+//!     same time constant
+static struct {
+    bool shared;        //!< Whether all the neurons have the same decay
+    REAL exp_tau_ca2;   //!< The decay of the calcium current
+} shared_ca2_decay UNUSED;
+
+//! \brief Find whether all the neurons have the same decay, so that
+//!     additional_input_decay_all() can keep it out of the per-neuron state
+//! \param[in] states: The additional inputs of all the neurons
+//! \param[in] n_neurons: The number of neurons
+static inline void additional_input_find_shared_decay(
+        const additional_input_t *states, uint32_t n_neurons) {
+    shared_ca2_decay.shared = n_neurons > 0;
+    if (!shared_ca2_decay.shared) {
+        return;
+    }
+    shared_ca2_decay.exp_tau_ca2 = states[0].exp_tau_ca2;
+    for (uint32_t n = 1; n < n_neurons; n++) {
+        if (states[n].exp_tau_ca2 != shared_ca2_decay.exp_tau_ca2) {
+            shared_ca2_decay.shared = false;
+            return;
+        }
+    }
+}
+
+//! \brief Decay the calcium current of all the neurons in one pass; the
+//!     current of each is then got with additional_input_get_decayed_current()
+//!     rather than additional_input_get_input_value_as_current()
+//! \param[in,out] states: The additional inputs of all the neurons
+//! \param[in] n_neurons: The number of neurons
+static inline void additional_input_decay_all(
+        additional_input_t *states, uint32_t n_neurons) {
+    if (!shared_ca2_decay.shared) {
+        for (uint32_t n = 0; n < n_neurons; n++) {
+            states[n].i_ca2 *= states[n].exp_tau_ca2;
+        }
+        return;
+    }
+    REAL decay = shared_ca2_decay.exp_tau_ca2;
+    for (uint32_t n = 0; n < n_neurons; n++) {
+        states[n].i_ca2 *= decay;
+    }
+}
+
+//! \brief Gets the value of current provided by the additional input this
+//!     timestep, once it has been decayed by additional_input_decay_all()
+//! \param[in] additional_input: The additional input type pointer to the
+//!     parameters
+//! \return The value of the input after scaling
+static inline input_t additional_input_get_decayed_current(
+        const additional_input_t *additional_input) {
+    return -additional_input->i_ca2;
+}
+
 //! \brief Notifies the additional input type that the neuron has spiked
 //! \param[in] additional_input: The additional input type pointer to the
 //!     parameters
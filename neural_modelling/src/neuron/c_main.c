@@ -115,7 +115,7 @@ static uint32_t n_background_overloads = 0;
 static uint32_t max_backgrounds_queued = 0;
 
 //! The ring buffers to be used in the simulation
-static weight_t *ring_buffers;
+static ring_buffer_t *ring_buffers;
 
 //! \brief Callback to store provenance data (format: neuron_provenance).
 //! \param[out] provenance_region: Where to write the provenance data
@@ -146,11 +146,17 @@ void resume_callback(void) {
     synapses_resume(time + 1);
 }
 
-//! Process the ring buffers for the next time step
-static inline void process_ring_buffers(void) {
+//! \brief Process the ring buffers for a time step
+//! \param[in] local_time: The time step to process
+static inline void process_ring_buffers(uint32_t local_time) {
     uint32_t first_index = synapse_row_get_first_ring_buffer_index(
-            time, synapse_type_index_bits, synapse_delay_mask);
+            local_time, synapse_type_index_bits, synapse_delay_mask);
+    synapses_note_ring_buffer_peaks(first_index);
+#if COMPACT_RING_BUFFERS
+    neuron_transfer_compact(ring_buffers, first_index);
+#else
     neuron_transfer(&ring_buffers[first_index]);
+#endif
 
     // Print the neuron inputs.
     #if LOG_LEVEL >= LOG_DEBUG
@@ -165,6 +171,13 @@ static inline void process_ring_buffers(void) {
 void background_callback(uint timer_count, uint local_time) {
     profiler_write_entry_disable_irq_fiq(PROFILER_ENTER | PROFILER_TIMER);
 
+    // Take in the inputs from the last time step.  This is done here rather
+    // than in the timer interrupt so that the DMA complete callback, at a
+    // higher priority, keeps the synaptic rows flowing while it is done;
+    // those rows are of the time step after, so they go to other parts of
+    // the ring buffers
+    process_ring_buffers(local_time);
+
     spike_processing_do_rewiring(synaptogenesis_n_updates());
 
     // Now do neuron time step update
@@ -192,19 +205,23 @@ void timer_callback(uint timer_count, UNUSED uint unused) {
     spin1_mode_restore(state);
     state = spin1_irq_disable();
 
-    // Process ring buffers for the inputs from last time step
-    process_ring_buffers();
-
     /* if a fixed number of simulation ticks that were specified at startup
      * then do reporting for finishing */
     if (simulation_is_finished()) {
 
+        // Process ring buffers for the inputs from last time step, so that
+        // they are in the state that is paused
+        process_ring_buffers(time);
+
         // Enter pause and resume state to avoid another tick
         simulation_handle_pause_resume(resume_callback);
 
         // Pause neuron processing
         neuron_pause();
 
+        // Let the host read the events of each projection
+        population_table_store_event_counters();
+
         // Pause common functions
         common_pause(recording_flags);
 
@@ -104,7 +104,7 @@ static uint32_t n_background_overloads = 0;
 static uint32_t max_backgrounds_queued = 0;
 
 //! The ring buffers to be used in the simulation
-static uint16_t *ring_buffers;
+static ring_buffer_t *ring_buffers;
 
 void synapse_dynamics_process_post_synaptic_event(
         UNUSED uint32_t time, UNUSED index_t neuron_index) {
@@ -179,6 +179,9 @@ void timer_callback(uint timer_count, UNUSED uint unused) {
     // Allow things to interrupt again
     spin1_mode_restore(state);
 
+    // Add in any spikes of the last time step that were merged
+    local_only_process_pending();
+
     // Process ring buffers for the inputs from last time step
     process_ring_buffers();
 
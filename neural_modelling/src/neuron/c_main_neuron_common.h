@@ -76,6 +76,25 @@ struct neuron_regions {
     uint32_t initial_values;
 };
 
+//! \brief The phases of the neuron time step whose timer cycles can be
+//!     recorded, in the order of their recording regions, which follow the
+//!     neuron recording regions
+enum neuron_phases {
+    //! Reading and adding up the inputs from the synapse cores
+    NEURON_PHASE_SYNAPTIC_INPUT,
+    //! Moving the inputs into the neurons
+    NEURON_PHASE_TRANSFER,
+    //! Updating the neurons, not counting recording
+    NEURON_PHASE_UPDATE,
+    //! Recording the neuron state
+    NEURON_PHASE_RECORDING,
+    //! The number of phases
+    N_NEURON_PHASES
+};
+
+//! The first recording region of the neuron phase cycles
+static uint32_t neuron_phase_region;
+
 //! Declare that time exists
 extern uint32_t time;
 
@@ -114,5 +133,9 @@ static inline bool initialise_neuron_regions(
         return false;
     }
 
+    // The neuron phase cycles are recorded in the regions after the neurons
+    neuron_phase_region = *n_rec_regions_used;
+    *n_rec_regions_used += N_NEURON_PHASES;
+
     return true;
 }
@@ -36,8 +36,27 @@
 #include "c_main_common.h"
 #include "profile_tags.h"
 #include "dma_common.h"
+#include "sparse_transfer.h"
 #include <spin1_api_params.h>
 
+#if RING_BUFFER_32_BIT
+#error "The inputs received from synapse cores are 16-bit, so a neuron core \
+can't use 32-bit ring buffers"
+#endif
+
+//! \brief Whether the synapse cores send their inputs as a list of the words
+//!     that are not zero when that is smaller; see sparse_transfer.h.  This
+//!     can be set per binary at build time, and must match that of the
+//!     synapse cores.
+#ifndef SYNAPSE_SPARSE_TRANSFER
+#define SYNAPSE_SPARSE_TRANSFER 0
+#endif
+
+#if COMPACT_RING_BUFFERS
+#error "The inputs received from synapse cores are laid out by the next power \
+of two neurons, so a neuron core can't use compact ring buffers"
+#endif
+
 //! values for the priority for each callback
 typedef enum callback_priorities {
     DMA = -2, SDP = 0, TIMER = 0
@@ -91,11 +110,22 @@ struct sdram_config {
     uint32_t size_in_bytes;
     //! The number of synapse cores feeding into here
     uint32_t n_synapse_cores;
+    //! \brief The number of the cores feeding into here, from the first,
+    //!     that are not synapse cores, and so always send all their inputs
+    //!     with no header after them
+    uint32_t n_dense_sources;
 };
 
+//! \brief The number of bins of the histogram of the time step used: one per
+//!     tenth of the time step, then one for overruns
+#define N_TIME_STEP_USE_BINS 11
+
 //! Provenance for this specific core
 struct neurons_provenance {
     uint32_t n_timer_overruns;
+    //! The number of time steps by the tenth of the time step used by the
+    //! end of the timer callback, then the number that overran
+    uint32_t time_step_use[N_TIME_STEP_USE_BINS];
 };
 
 //! The number of buffers for synaptic data (one processing, one in progress)
@@ -126,6 +156,25 @@ static weight_t *synaptic_contributions[N_SYNAPTIC_BUFFERS];
 //! The timer overruns
 static uint32_t timer_overruns = 0;
 
+//! The histogram of the time step used; see ::neurons_provenance
+static uint32_t time_step_use[N_TIME_STEP_USE_BINS];
+
+//! The timer cycles spent in each phase of the time step, for recording
+static uint32_t phase_cycles[N_NEURON_PHASES];
+
+//! A record of the cycles spent in a phase during a time step
+static struct {
+    uint32_t time;
+    uint32_t cycles;
+} phase_record;
+
+//! Whether the cycles spent in the phases of the time step are measured
+static bool phase_timing = false;
+
+//! The recording flags of the phase regions, so only those recorded are
+//! written
+static uint32_t phase_recording_flags = 0;
+
 //! All the synaptic contributions for adding up in 2 formats
 static union {
     uint32_t *as_int;
@@ -140,7 +189,9 @@ static void store_provenance_data(address_t provenance_region) {
     store_neuron_provenance(prov);
     struct neurons_provenance *n_prov = (void *) &prov[1];
     n_prov->n_timer_overruns = timer_overruns;
-
+    for (uint32_t i = 0; i < N_TIME_STEP_USE_BINS; i++) {
+        n_prov->time_step_use[i] = time_step_use[i];
+    }
 }
 
 //! \brief the function to call when resuming a simulation
@@ -158,16 +209,105 @@ void resume_callback(void) {
 }
 
 //! \brief Add up all the synaptic contributions into a global buffer
+//! \details The contributions are added two at a time, as pairs of 16-bit
+//!     values in words, with each value saturating on its own.
 //! \param[in] syns The weights to be added
 static inline void sum(weight_t *syns) {
     uint32_t n_words = sdram_inputs.size_in_bytes >> 2;
     const uint32_t *src = (const uint32_t *) syns;
     uint32_t *tgt = all_synaptic_contributions.as_int;
     for (uint32_t i = n_words; i > 0; i--) {
-        *tgt++ += *src++;
+        *tgt = synapse_row_packed_add_saturate(*tgt, *src++, NULL);
+        tgt++;
     }
 }
 
+//! \brief Find the inputs of the next core that feeds into here
+//! \param[in] sdram: The inputs of a core
+//! \param[in] index: The index of the core
+//! \return The inputs of the core after it
+static inline uint8_t *next_inputs(uint8_t *sdram, uint32_t index) {
+    sdram += sdram_inputs.size_in_bytes;
+    if (index >= sdram_inputs.n_dense_sources) {
+        sdram += SPARSE_TRANSFER_HEADER_BYTES;
+    }
+    return sdram;
+}
+
+#if SYNAPSE_SPARSE_TRANSFER
+//! \brief Read the inputs sent by a synapse core and add them up with the
+//!     rest, in whichever format they were sent
+//! \param[in] sdram: The inputs of the synapse core
+static inline void sum_sent(uint8_t *sdram) {
+    uint32_t *buffer = (uint32_t *) synaptic_contributions[0];
+    do_fast_dma_read(&sdram[sdram_inputs.size_in_bytes], buffer,
+            SPARSE_TRANSFER_HEADER_BYTES);
+    wait_for_dma_to_complete();
+    uint32_t n_sparse = buffer[0];
+    if (n_sparse == SPARSE_TRANSFER_DENSE) {
+        do_fast_dma_read(sdram, buffer, sdram_inputs.size_in_bytes);
+        wait_for_dma_to_complete();
+        sum(synaptic_contributions[0]);
+        return;
+    }
+    if (n_sparse == 0) {
+        return;
+    }
+    struct sparse_input *sparse = (struct sparse_input *) buffer;
+    do_fast_dma_read(sdram, sparse, n_sparse * sizeof(struct sparse_input));
+    wait_for_dma_to_complete();
+    uint32_t *tgt = all_synaptic_contributions.as_int;
+    for (uint32_t i = 0; i < n_sparse; i++) {
+        uint32_t index = sparse[i].index;
+        tgt[index] = synapse_row_packed_add_saturate(
+                tgt[index], sparse[i].inputs, NULL);
+    }
+}
+#endif
+
+//! \brief Note the timer at the end of a phase of the time step
+//! \param[in] phase: The phase that has ended
+//! \param[in,out] start: The timer at the start of the phase; updated to be
+//!     the timer now, the start of the next phase
+static inline void phase_end(enum neuron_phases phase, uint32_t *start) {
+    if (phase_timing) {
+        uint32_t now = tc[T1_COUNT];
+        phase_cycles[phase] = neuron_timer_cycles(*start, now);
+        *start = now;
+    }
+}
+
+//! \brief Record the cycles spent in each phase of the time step
+static inline void record_phases(void) {
+    // The update includes the recording, which was measured on its own
+    phase_cycles[NEURON_PHASE_RECORDING] = neuron_recording_cycles;
+    phase_cycles[NEURON_PHASE_UPDATE] -= neuron_recording_cycles;
+    phase_record.time = time;
+    for (uint32_t i = 0; i < N_NEURON_PHASES; i++) {
+        uint32_t region = neuron_phase_region + i;
+        if (phase_recording_flags & (1 << region)) {
+            phase_record.cycles = phase_cycles[i];
+            recording_record(region, &phase_record, sizeof(phase_record));
+        }
+    }
+}
+
+//! \brief Add the time step to the histogram of the time step used
+//! \param[in] end_time: The timer at the end of the callback
+//! \param[in] overran: Whether the callback ran into the next time step
+static inline void add_time_step_use(uint32_t end_time, bool overran) {
+    uint32_t bin = N_TIME_STEP_USE_BINS - 1;
+    if (!overran) {
+        // The timer counts down from the load value at the start of the step
+        uint32_t load = tc[T1_LOAD];
+        bin = ((load - end_time) * (N_TIME_STEP_USE_BINS - 1)) / load;
+        if (bin > N_TIME_STEP_USE_BINS - 2) {
+            bin = N_TIME_STEP_USE_BINS - 2;
+        }
+    }
+    time_step_use[bin] += 1;
+}
+
 //! \brief Timer interrupt callback
 //! \param[in] timer_count: the number of times this call back has been
 //!            executed since start of simulation
@@ -205,23 +345,34 @@ void timer_callback(uint timer_count, UNUSED uint unused) {
         return;
     }
 
+    uint32_t phase_start = start_time;
+
     // Start the transfer of the first part of the weight data
     uint8_t *sdram = sdram_inputs.address;
     uint32_t write_index = 0;
     uint32_t read_index = 0;
 
-    // Start the first DMA
-    do_fast_dma_read(sdram, synaptic_contributions[write_index],
-            sdram_inputs.size_in_bytes);
-    write_index = !write_index;
+    // The inputs that are always sent whole are read while the last ones
+    // read are added; those sent in either format are read one at a time
+    uint32_t n_whole = sdram_inputs.n_synapse_cores;
+#if SYNAPSE_SPARSE_TRANSFER
+    n_whole = sdram_inputs.n_dense_sources;
+#endif
 
-    for (uint32_t i = 0; i < sdram_inputs.n_synapse_cores; i++) {
+    if (n_whole > 0) {
+        // Start the first DMA
+        do_fast_dma_read(sdram, synaptic_contributions[write_index],
+                sdram_inputs.size_in_bytes);
+        write_index = !write_index;
+    }
+
+    for (uint32_t i = 0; i < n_whole; i++) {
         // Wait for the last DMA to complete
         wait_for_dma_to_complete();
 
         // Start the next DMA if not finished
-        if (i + 1 < sdram_inputs.n_synapse_cores) {
-            sdram += sdram_inputs.size_in_bytes;
+        sdram = next_inputs(sdram, i);
+        if (i + 1 < n_whole) {
             do_fast_dma_read(sdram, synaptic_contributions[write_index],
                     sdram_inputs.size_in_bytes);
             write_index = !write_index;
@@ -232,15 +383,32 @@ void timer_callback(uint timer_count, UNUSED uint unused) {
         read_index = !read_index;
     }
 
+#if SYNAPSE_SPARSE_TRANSFER
+    for (uint32_t i = n_whole; i < sdram_inputs.n_synapse_cores; i++) {
+        sum_sent(sdram);
+        sdram = next_inputs(sdram, i);
+    }
+#endif
+
+    phase_end(NEURON_PHASE_SYNAPTIC_INPUT, &phase_start);
+
     neuron_transfer(all_synaptic_contributions.as_weight);
+    phase_end(NEURON_PHASE_TRANSFER, &phase_start);
 
     // Now do neuron time step update
     neuron_do_timestep_update(time, timer_count);
+    phase_end(NEURON_PHASE_UPDATE, &phase_start);
+
+    if (phase_timing) {
+        record_phases();
+    }
 
     uint32_t end_time = tc[T1_COUNT];
-    if (end_time > start_time) {
+    bool overran = end_time > start_time;
+    if (overran) {
         timer_overruns += 1;
     }
+    add_time_step_use(end_time, overran);
 
     profiler_write_entry_disable_irq_fiq(PROFILER_EXIT | PROFILER_TIMER);
 }
@@ -264,6 +432,12 @@ static bool initialise(void) {
         return false;
     }
 
+    // Only measure the phases of the time step if any are recorded
+    uint32_t phase_regions = ((1 << N_NEURON_PHASES) - 1) << neuron_phase_region;
+    phase_recording_flags = recording_flags & phase_regions;
+    phase_timing = phase_recording_flags != 0;
+    neuron_recording_timing = phase_timing;
+
     // Setup for reading synaptic inputs at start of each time step
     struct sdram_config * sdram_config = data_specification_get_region(
             SDRAM_PARAMS_REGION, ds_regions);
@@ -291,11 +465,16 @@ static bool initialise(void) {
     for (uint32_t j = 0; j < n_words; j++) {
         all_synaptic_contributions.as_int[j] = 0;
     }
-    uint32_t *sdram_word = (void *) sdram_inputs.address;
+    // This includes the header after the inputs of each synapse core, as a
+    // header of 0 says that none of the inputs were sent
+    uint8_t *sdram = sdram_inputs.address;
     for (uint32_t i = 0; i < sdram_inputs.n_synapse_cores; i++) {
-        for (uint32_t j = 0; j < n_words; j++) {
-            *(sdram_word++) = 0;
+        uint8_t *next = next_inputs(sdram, i);
+        for (uint32_t *word = (void *) sdram; word < (uint32_t *) next;
+                word++) {
+            *word = 0;
         }
+        sdram = next;
     }
     // Set timer tick (in microseconds)
     log_debug("setting timer tick callback for %d microseconds", timer_period);
@@ -62,6 +62,18 @@ struct synapse_provenance {
     uint32_t n_late_spikes;
     //! The maximum lateness of a spike
     uint32_t max_late_spike;
+    //! The number of population table lookups that matched a recent entry
+    uint32_t n_pop_table_cache_hits;
+    //! The number of population table lookups that had to look up the table
+    uint32_t n_pop_table_cache_misses;
+    //! The number of bit fields read in compressed to save DTCM
+    uint32_t n_compressed_bitfield_reads;
+    //! The number of spikes tested against a Bloom filter
+    uint32_t n_bloom_filter_tests;
+    //! The number of spikes that a Bloom filter wrongly passed
+    uint32_t n_bloom_filter_false_positives;
+    //! The number of rows processed by how many time steps late the spike was
+    uint32_t lateness_histogram[N_LATENESS_BINS];
 };
 
 //! \brief Callback to store synapse provenance data (format: synapse_provenance).
@@ -80,6 +92,14 @@ static inline void store_synapse_provenance(struct synapse_provenance *prov) {
     prov->n_synapses_skipped = skipped_synapses;
     prov->n_late_spikes = late_spikes;
     prov->max_late_spike = max_late_spike;
+    prov->n_pop_table_cache_hits = pop_table_cache_hits;
+    prov->n_pop_table_cache_misses = pop_table_cache_misses;
+    prov->n_compressed_bitfield_reads = compressed_bit_field_reads;
+    prov->n_bloom_filter_tests = bloom_filter_tests;
+    prov->n_bloom_filter_false_positives = bloom_filter_false_positives;
+    for (uint32_t i = 0; i < N_LATENESS_BINS; i++) {
+        prov->lateness_histogram[i] = lateness_histogram[i];
+    }
 }
 
 //! \brief Read data to set up synapse processing
@@ -99,7 +119,7 @@ static inline void store_synapse_provenance(struct synapse_provenance *prov) {
 //! \return a Boolean indicating success (True) or failure (False)
 static inline bool initialise_synapse_regions(
         data_specification_metadata_t *ds_regions,
-        struct synapse_regions regions, weight_t **ring_buffers,
+        struct synapse_regions regions, ring_buffer_t **ring_buffers,
         uint32_t *row_max_n_words,
         uint32_t *incoming_spike_buffer_size,
         bool *clear_input_buffer_of_late_packets,
@@ -118,12 +138,18 @@ static inline bool initialise_synapse_regions(
     }
 
     // Set up the population table
+    address_t synaptic_matrix =
+            data_specification_get_region(regions.synaptic_matrix, ds_regions);
     if (!population_table_initialise(
             data_specification_get_region(regions.pop_table, ds_regions),
-            data_specification_get_region(regions.synaptic_matrix, ds_regions),
-            row_max_n_words)) {
+            synaptic_matrix, row_max_n_words)) {
         return false;
     }
+    synapses_set_dirty_rows(synaptic_matrix);
+    if (synapse_event_counters_offset != EVENT_COUNTERS_NONE) {
+        population_table_set_event_counters(&synaptic_matrix[
+                synapse_event_counters_offset / sizeof(uint32_t)]);
+    }
     // Set up the synapse dynamics
     if (!synapse_dynamics_initialise(
             data_specification_get_region(regions.synapse_dynamics, ds_regions),
@@ -62,7 +62,10 @@ enum regions {
     STRUCTURAL_DYNAMICS_REGION,
     BIT_FIELD_FILTER_REGION,
     SDRAM_PARAMS_REGION,
-    KEY_REGION
+    KEY_REGION,
+    CONNECTOR_BUILDER_REGION,
+    DELAY_WHEEL_REGION,
+    POST_INDEX_REGION
 };
 
 //! From the regions, select those that are common
@@ -131,6 +134,9 @@ void resume_callback(void) {
 void timer_callback(UNUSED uint unused0, UNUSED uint unused1) {
     time++;
     if (simulation_is_finished()) {
+        // Make sure the rows and event counters are up to date in SDRAM
+        spike_processing_fast_pause();
+
         // Enter pause and resume state to avoid another tick
         simulation_handle_pause_resume(resume_callback);
 
@@ -161,7 +167,7 @@ static bool initialise(void) {
     uint32_t incoming_spike_buffer_size;
     uint32_t row_max_n_words;
     bool clear_input_buffer_of_late_packets;
-    weight_t *ring_buffers;
+    ring_buffer_t *ring_buffers;
     uint32_t n_rec_regions_used = 0;
     if (!initialise_synapse_regions(
             ds_regions, SYNAPSE_REGIONS, &ring_buffers, &row_max_n_words,
@@ -170,18 +176,37 @@ static bool initialise(void) {
         return false;
     }
 
+    // The delay wheel region is only there if there are delays for it
+    if (!synapses_set_delay_wheel(data_specification_get_region(
+            DELAY_WHEEL_REGION, ds_regions))) {
+        return false;
+    }
+
     // Setup for writing synaptic inputs at the end of each run
     struct sdram_config *sdram_config = data_specification_get_region(
             SDRAM_PARAMS_REGION, ds_regions);
     struct key_config *key_config = data_specification_get_region(
             KEY_REGION, ds_regions);
+    struct row_cache_hints *row_cache_hints = (void *) &key_config[1];
+    struct late_packet_config *late_packet_config =
+            (void *) &row_cache_hints->sources[ROW_CACHE_MAX_HOT_SOURCES];
 
     if (!spike_processing_fast_initialise(
             row_max_n_words, incoming_spike_buffer_size,
-            clear_input_buffer_of_late_packets, n_rec_regions_used, MC,
-            *sdram_config, *key_config, ring_buffers)) {
+            clear_input_buffer_of_late_packets, n_rec_regions_used,
+            recording_flags, MC,
+            *sdram_config, *key_config, ring_buffers, row_cache_hints,
+            late_packet_config)) {
+        return false;
+    }
+
+#if STDP_EAGER_POST
+    // The index of the plastic synapses of each neuron, built by the expander
+    if (!synapse_dynamics_eager_post_initialise(data_specification_get_region(
+            POST_INDEX_REGION, ds_regions))) {
         return false;
     }
+#endif
 
     // Do bitfield configuration last to only use any unused memory
     if (!population_table_load_bitfields(data_specification_get_region(
@@ -46,10 +46,105 @@ static uint32_t n_neurons_on_core;
 
 static neuron_current_source_t **neuron_current_source;
 
+#ifdef _CURRENT_SOURCE_DC_H_
+//! The DC source parameters in SDRAM, so that changes can be kept there
+static dc_source_t *dc_source_sdram;
+#endif
+
 #ifndef SOMETIMES_UNUSED
 #define SOMETIMES_UNUSED __attribute__((unused))
 #endif // !SOMETIMES_UNUSED
 
+//! \brief Whether to work out the value of each DC, AC and step current
+//!     source once per timestep, rather than for each neuron it is attached
+//!     to on each call.  Noisy sources still make a draw for each call.
+//!     This can be set per binary at build time.
+#ifndef CURRENT_SOURCE_PRECOMPUTE
+#define CURRENT_SOURCE_PRECOMPUTE 0
+#endif
+
+#if CURRENT_SOURCE_PRECOMPUTE
+//! \brief The ID that replaces the ID of a source that is worked out once
+//!     per timestep; the index is then the index in ::cs_values
+#define CS_ID_PRECOMPUTED 0
+
+//! The value of ::cs_shared_index when the neurons don't share one source
+#define CS_NO_SHARED_INDEX 0xFFFFFFFF
+
+//! The values of the DC, then AC, then step sources in this timestep
+static REAL *cs_values;
+
+//! The time that ::cs_values were worked out for
+static uint32_t cs_values_time;
+
+//! \brief The index in ::cs_values of the only source of every neuron, if
+//!     they all have one and the same source, or ::CS_NO_SHARED_INDEX
+static uint32_t cs_shared_index;
+
+//! \brief Point the current sources of each neuron at ::cs_values where the
+//!     source can be worked out once per timestep
+//! \return True if successful
+static bool current_source_resolve_indices(void) {
+    uint32_t n_values = n_dc_sources + n_ac_sources + n_step_sources;
+    if (n_values > 0 && cs_values == NULL) {
+        cs_values = spin1_malloc(n_values * sizeof(REAL));
+        if (cs_values == NULL) {
+            log_error("Unable to allocate current source values - out of DTCM");
+            return false;
+        }
+    }
+    cs_values_time = UINT32_MAX;
+
+    // Index 0 is DC, then AC, then step, matching the values
+    uint32_t first_index[] = {
+        0, 0, n_dc_sources, n_dc_sources + n_ac_sources};
+    bool shared = true;
+    uint32_t shared_index = CS_NO_SHARED_INDEX;
+    for (uint32_t n = 0; n < n_neurons_on_core; n++) {
+        neuron_current_source_t *sources = neuron_current_source[n];
+        for (uint32_t n_cs = 0; n_cs < sources->n_current_sources; n_cs++) {
+            cs_id_index_t *cs = &sources->cs_id_index_list[n_cs];
+            if (cs->cs_id >= 1 && cs->cs_id <= 3) {
+                cs->cs_index += first_index[cs->cs_id];
+                cs->cs_id = CS_ID_PRECOMPUTED;
+            }
+        }
+        if (sources->n_current_sources != 1 ||
+                sources->cs_id_index_list[0].cs_id != CS_ID_PRECOMPUTED ||
+                (n > 0 && sources->cs_id_index_list[0].cs_index
+                        != shared_index)) {
+            shared = false;
+        } else {
+            shared_index = sources->cs_id_index_list[0].cs_index;
+        }
+    }
+    cs_shared_index = shared ? shared_index : CS_NO_SHARED_INDEX;
+    return true;
+}
+
+//! \brief Work out the values of the DC, AC and step sources for a timestep
+//! \param[in] time: The current time
+static inline void current_source_update_values(uint32_t time) {
+    REAL *value = cs_values;
+#ifdef _CURRENT_SOURCE_DC_H_
+    for (uint32_t i = 0; i < n_dc_sources; i++) {
+        *value++ = current_source_dc_get_offset(i, time);
+    }
+#endif
+#ifdef _CURRENT_SOURCE_AC_H_
+    for (uint32_t i = 0; i < n_ac_sources; i++) {
+        *value++ = current_source_ac_get_offset(i, time);
+    }
+#endif
+#ifdef _CURRENT_SOURCE_STEP_H_
+    for (uint32_t i = 0; i < n_step_sources; i++) {
+        *value++ = current_source_step_get_offset(i, time);
+    }
+#endif
+    cs_values_time = time;
+}
+#endif // CURRENT_SOURCE_PRECOMPUTE
+
 SOMETIMES_UNUSED // Marked unused as only used sometimes
 //! \brief Initialise the particular implementation of the data
 //! \param[in] cs_address: The address to start reading data from
@@ -179,6 +274,7 @@ static bool current_source_load_parameters(address_t cs_address) {
 
 		// Copy into individual source arrays
 #ifdef _CURRENT_SOURCE_DC_H_
+		dc_source_sdram = (dc_source_t *) &cs_address[next];
 		current_source_dc_load_parameters(cs_address, n_dc_sources, &next);
 #endif
 #ifdef _CURRENT_SOURCE_AC_H_
@@ -190,6 +286,11 @@ static bool current_source_load_parameters(address_t cs_address) {
 #ifdef _CURRENT_SOURCE_NOISY_H_
 		current_source_noisy_load_parameters(cs_address, n_noisy_sources, &next);
 #endif
+#if CURRENT_SOURCE_PRECOMPUTE
+		if (!current_source_resolve_indices()) {
+			return false;
+		}
+#endif
 
     }
 
@@ -199,6 +300,43 @@ static bool current_source_load_parameters(address_t cs_address) {
 }
 
 
+SOMETIMES_UNUSED // Marked unused as only used sometimes
+//! \brief Set the amplitude of a DC source while running; this is also
+//!     written to SDRAM so that it is kept when the parameters are loaded
+//!     again
+//! \param[in] dc_index: The index of the source among the DC sources
+//! \param[in] amplitude: The new amplitude of the source
+//! \return Whether there is such a source
+static inline bool current_source_set_dc_amplitude(
+        uint32_t dc_index, REAL amplitude) {
+#ifdef _CURRENT_SOURCE_DC_H_
+    if ((n_current_sources == 0) || (dc_index >= n_dc_sources)) {
+        return false;
+    }
+    dc_source[dc_index]->amplitude = amplitude;
+    dc_source_sdram[dc_index].amplitude = amplitude;
+    return true;
+#else
+    use(dc_index);
+    use(amplitude);
+    return false;
+#endif
+}
+
+SOMETIMES_UNUSED // Marked unused as only used sometimes
+//! \brief Do the work for the current sources that can be done between
+//!     timesteps, ready for the next one
+//! \param[in] time: The current time
+static inline void current_source_end_of_timestep(uint32_t time) {
+#if defined(_CURRENT_SOURCE_NOISY_H_) && NOISY_SOURCE_POOL_SIZE > 0
+    if (n_current_sources != 0) {
+        current_source_noisy_fill_pools(n_noisy_sources, time);
+    }
+#else
+    use(time);
+#endif
+}
+
 SOMETIMES_UNUSED // Marked unused as only used sometimes
 //! \brief Calculate the current offset from all injected current sources
 //! \param[in] time: The current time
@@ -215,6 +353,14 @@ static inline REAL current_source_get_offset(uint32_t time, uint32_t neuron_inde
 
     // Also avoid the loop if no current sources set by user
     if (n_current_sources != 0) {
+#if CURRENT_SOURCE_PRECOMPUTE
+		if (time != cs_values_time) {
+			current_source_update_values(time);
+		}
+		if (cs_shared_index != CS_NO_SHARED_INDEX) {
+			return cs_values[cs_shared_index];
+		}
+#endif
 		uint32_t n_current_sources_neuron =
 				neuron_current_source[neuron_index]->n_current_sources;
 		if (n_current_sources_neuron > 0) {
@@ -224,6 +370,11 @@ static inline REAL current_source_get_offset(uint32_t time, uint32_t neuron_inde
 				uint32_t cs_index =
 						neuron_current_source[neuron_index]->cs_id_index_list[n_cs].cs_index;
 				// Now do the appropriate calculation based on the ID value
+				#if CURRENT_SOURCE_PRECOMPUTE
+				if (cs_id == CS_ID_PRECOMPUTED) {
+					current_offset += cs_values[cs_index];
+				}
+				#endif
 				#ifdef _CURRENT_SOURCE_DC_H_
 				if (cs_id == 1) {  // DCSource
 					current_offset += current_source_dc_get_offset(cs_index, time);
@@ -35,7 +35,73 @@ typedef struct ac_source_t {
 
 static ac_source_t **ac_source;
 
+//! \brief Whether to take the sine of AC sources from a table shared by all
+//!     the AC sources on the core, indexed by a phase that grows by a fixed
+//!     amount each timestep, rather than working it out each time.  This can
+//!     be set per binary at build time.
+#ifndef AC_SOURCE_WAVETABLE
+#define AC_SOURCE_WAVETABLE 0
+#endif
+
+#if AC_SOURCE_WAVETABLE
+//! The log<sub>2</sub> of the number of entries in the sine table
+#ifndef AC_SINE_TABLE_BITS
+#define AC_SINE_TABLE_BITS 10
+#endif
+
+//! The phase units in a radian, where 2<sup>32</sup> is a full turn
+#define AC_PHASE_PER_RADIAN 683565276LL
+
+//! \brief The sine of each phase in the table, as the bits of an accum;
+//!     1 is just out of range so is held as the largest value below it
+static int16_t *ac_sine_table;
+
+//! The phase of each AC source at its start time
+static uint32_t *ac_phase_start;
+
+//! The phase by which each AC source advances each timestep
+static uint32_t *ac_phase_increment;
+
+//! \brief Convert an accum angle in radians to phase units
+//! \param[in] radians: The angle
+//! \return The phase; whole turns wrap around
+static inline uint32_t ac_to_phase(REAL radians) {
+    return (uint32_t) (((int64_t) bitsk(radians) * AC_PHASE_PER_RADIAN) >> 15);
+}
+
+//! \brief Make the sine table
+//! \return True if successful
+static bool ac_make_sine_table(void) {
+    uint32_t n_entries = 1 << AC_SINE_TABLE_BITS;
+    ac_sine_table = spin1_malloc(n_entries * sizeof(int16_t));
+    if (ac_sine_table == NULL) {
+        log_error("Unable to allocate AC sine table - out of DTCM");
+        return false;
+    }
+    for (uint32_t i = 0; i < n_entries; i++) {
+        REAL angle = kbits((int32_t) (((int64_t) i << (47 - AC_SINE_TABLE_BITS))
+                / AC_PHASE_PER_RADIAN));
+        int32_t value = bitsk(sink(angle));
+        ac_sine_table[i] = (int16_t) ((value > INT16_MAX) ? INT16_MAX : value);
+    }
+    return true;
+}
+#endif
+
 static bool current_source_ac_init(uint32_t n_ac_sources, uint32_t *next) {
+#if AC_SOURCE_WAVETABLE
+	if (n_ac_sources > 0) {
+		ac_phase_start = spin1_malloc(n_ac_sources * sizeof(uint32_t));
+		ac_phase_increment = spin1_malloc(n_ac_sources * sizeof(uint32_t));
+		if (ac_phase_start == NULL || ac_phase_increment == NULL) {
+			log_error("Unable to allocate AC source phases - out of DTCM");
+			return false;
+		}
+		if (!ac_make_sine_table()) {
+			return false;
+		}
+	}
+#endif
 	ac_source = spin1_malloc(n_ac_sources * sizeof(uint32_t*));
 	for (uint32_t n_ac=0; n_ac < n_ac_sources; n_ac++) {
 		ac_source[n_ac] = spin1_malloc(sizeof(ac_source_t));
@@ -53,15 +119,26 @@ static bool current_source_ac_load_parameters(
 	for (uint32_t n_ac=0; n_ac < n_ac_sources; n_ac++) {
 		spin1_memcpy(ac_source[n_ac], &cs_address[*next], sizeof(ac_source_t));
 		*next += sizeof(ac_source_t) / 4;
+#if AC_SOURCE_WAVETABLE
+		ac_phase_start[n_ac] = ac_to_phase(ac_source[n_ac]->phase);
+		ac_phase_increment[n_ac] = ac_to_phase(ac_source[n_ac]->frequency);
+#endif
 	}
 	return true;
 }
 
 static REAL current_source_ac_get_offset(uint32_t cs_index, uint32_t time) {
     if ((time >= ac_source[cs_index]->start) && (time < ac_source[cs_index]->stop)) {
+#if AC_SOURCE_WAVETABLE
+        uint32_t phase = ac_phase_start[cs_index] + ac_phase_increment[cs_index]
+                * (time - ac_source[cs_index]->start);
+        REAL sin_value = kbits(
+                ac_sine_table[phase >> (32 - AC_SINE_TABLE_BITS)]);
+#else
         REAL time_value = kbits((time - ac_source[cs_index]->start) << 15);
         REAL sin_value = sink((time_value * ac_source[cs_index]->frequency) +
                 ac_source[cs_index]->phase);
+#endif
         REAL ac_current_offset = ac_source[cs_index]->offset + (
                 ac_source[cs_index]->amplitude * sin_value);
         return ac_current_offset;
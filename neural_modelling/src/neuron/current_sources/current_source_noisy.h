@@ -36,7 +36,40 @@ typedef struct noisy_current_source_t {
 
 static noisy_current_source_t **noisy_source;
 
+//! \brief The number of normal samples to draw ahead for each noisy source at
+//!     the end of each timestep, so the neuron update only takes them; 0
+//!     draws each as it is needed.  This must be a power of 2.  The samples
+//!     are taken in the order they are drawn, so the values are the same.
+//!     This can be set per binary at build time.
+#ifndef NOISY_SOURCE_POOL_SIZE
+#define NOISY_SOURCE_POOL_SIZE 0
+#endif
+
+#if NOISY_SOURCE_POOL_SIZE > 0
+//! Samples drawn ahead for a noisy source
+typedef struct noisy_pool_t {
+    //! The index of the next sample to take
+    uint32_t head;
+    //! The number of samples waiting
+    uint32_t count;
+    //! The samples, as a ring
+    REAL values[NOISY_SOURCE_POOL_SIZE];
+} noisy_pool_t;
+
+//! The samples drawn ahead for each noisy source
+static noisy_pool_t *noisy_pool;
+#endif
+
 static bool current_source_noisy_init(uint32_t n_noisy_sources, uint32_t *next) {
+#if NOISY_SOURCE_POOL_SIZE > 0
+	if (n_noisy_sources > 0) {
+		noisy_pool = spin1_malloc(n_noisy_sources * sizeof(noisy_pool_t));
+		if (noisy_pool == NULL) {
+			log_error("Unable to allocate noisy source pools - out of DTCM");
+			return false;
+		}
+	}
+#endif
 	noisy_source = spin1_malloc(n_noisy_sources * sizeof(uint32_t*));
 	for (uint32_t n_noisy=0; n_noisy < n_noisy_sources; n_noisy++) {
 		noisy_source[n_noisy] = spin1_malloc(sizeof(noisy_current_source_t));
@@ -54,14 +87,59 @@ static bool current_source_noisy_load_parameters(
 	for (uint32_t n_noisy=0; n_noisy < n_noisy_sources; n_noisy++) {
 		spin1_memcpy(noisy_source[n_noisy], &cs_address[*next], sizeof(noisy_current_source_t));
 		*next += sizeof(noisy_current_source_t) / 4;
+#if NOISY_SOURCE_POOL_SIZE > 0
+		// Samples drawn from any previous seed no longer apply
+		noisy_pool[n_noisy].head = 0;
+		noisy_pool[n_noisy].count = 0;
+#endif
 	}
 	return true;
 }
 
+#if NOISY_SOURCE_POOL_SIZE > 0
+//! \brief Draw samples ahead for the noisy sources that are still to finish
+//! \param[in] n_noisy_sources: The number of noisy sources
+//! \param[in] time: The current time
+static void current_source_noisy_fill_pools(
+		uint32_t n_noisy_sources, uint32_t time) {
+	for (uint32_t n_noisy=0; n_noisy < n_noisy_sources; n_noisy++) {
+		if (time + 1 >= noisy_source[n_noisy]->stop) {
+			continue;
+		}
+		noisy_pool_t *pool = &noisy_pool[n_noisy];
+		while (pool->count < NOISY_SOURCE_POOL_SIZE) {
+			uint32_t tail = (pool->head + pool->count) &
+					(NOISY_SOURCE_POOL_SIZE - 1);
+			pool->values[tail] = norminv_urt(
+					mars_kiss64_seed(noisy_source[n_noisy]->seed));
+			pool->count++;
+		}
+	}
+}
+
+//! \brief Take the next normal sample of a noisy source
+//! \param[in] cs_index: The index of the noisy source
+//! \return The sample
+static inline REAL noisy_next_sample(uint32_t cs_index) {
+	noisy_pool_t *pool = &noisy_pool[cs_index];
+	if (pool->count == 0) {
+		return norminv_urt(mars_kiss64_seed(noisy_source[cs_index]->seed));
+	}
+	REAL value = pool->values[pool->head];
+	pool->head = (pool->head + 1) & (NOISY_SOURCE_POOL_SIZE - 1);
+	pool->count--;
+	return value;
+}
+#endif
+
 static REAL current_source_noisy_get_offset(uint32_t cs_index, uint32_t time) {
     if ((time >= noisy_source[cs_index]->start) && (time < noisy_source[cs_index]->stop)) {
         // Pick a normally-distributed value based on the mean and SD provided
+#if NOISY_SOURCE_POOL_SIZE > 0
+        REAL random_value = noisy_next_sample(cs_index);
+#else
         REAL random_value = norminv_urt(mars_kiss64_seed(noisy_source[cs_index]->seed));
+#endif
         REAL noisy_current_offset = noisy_source[cs_index]->mean + (
                 noisy_source[cs_index]->stdev * random_value);
         return noisy_current_offset;
@@ -102,6 +102,17 @@ static inline u032 decay_s1615_to_u032(s1615 x, decay_t decay) {
 	return ulrbits((uint_ulr_t) ((s * u) >> 15));
 }
 
+//! \brief Combine two decays into one that decays by both
+//! \param[in] a: the first decay
+//! \param[in] b: the second decay
+//! \return the product of the decays
+static inline decay_t decay_product(decay_t a, decay_t b) {
+    uint64_t s = (uint64_t) bitsulr(a);
+    uint64_t u = (uint64_t) bitsulr(b);
+
+    return ulrbits((uint_ulr_t) ((s * u) >> 32));
+}
+
 // The following permits us to do a type-generic macro for decay manipulation
 /*----------------------------------
  * This method is currently assumed to be faulty. Please do not use it yet.
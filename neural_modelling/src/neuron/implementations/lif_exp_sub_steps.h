@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2024 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//! \file
+//! \brief Closed-form update of a LIF neuron with exponential current synapses
+//!     over all the sub-steps of a timestep at once
+//!
+//! With no spike and no refractory period during the timestep, each sub-step
+//! takes the deviation of the voltage from where it is heading, \f$u\f$, to
+//! \f$u' = e u + (1 - e) R I\f$, where \f$e\f$ is the membrane decay per
+//! sub-step, and each synaptic input decays by \f$d\f$.  Over \f$n\f$
+//! sub-steps this sums to
+//! \f[
+//!     u_n = e^n u_0 + (1 - e) R \sum_{k=0}^{n-1} e^{n-1-k} d^k I_0
+//! \f]
+//! so the state after the timestep is a fixed linear function of the state
+//! before it.  The factors are worked out once per neuron when the parameters
+//! are loaded.
+#ifndef _LIF_EXP_SUB_STEPS_H_
+#define _LIF_EXP_SUB_STEPS_H_
+
+#include <neuron/decay.h>
+
+//! The factors that advance a neuron over all the sub-steps of a timestep
+typedef struct lif_exp_propagator_t {
+    //! How much the deviation of the voltage decays over the timestep
+    REAL V_decay;
+    //! How much the excitatory input at the start moves the voltage
+    REAL exc_gain;
+    //! How much the inhibitory input at the start moves the voltage
+    REAL inh_gain;
+    //! How much the excitatory input decays over the timestep
+    decay_t exc_decay;
+    //! How much the inhibitory input decays over the timestep
+    decay_t inh_decay;
+} lif_exp_propagator_t;
+
+//! \brief Work out how much a synaptic input at the start of a timestep moves
+//!     the voltage by the end of it
+//! \param[in] neuron: The neuron the input is to
+//! \param[in] decay: The decay of the input per sub-step
+//! \param[in] n_steps: The number of sub-steps per timestep
+//! \return The gain of the input
+static inline REAL lif_exp_input_gain(
+        const neuron_t *neuron, decay_t decay, uint32_t n_steps) {
+    // Sum of exp_TC^(n-1-k) decay^k over the sub-steps k
+    REAL sum = ZERO;
+    REAL decay_power = ONE;
+    for (uint32_t k = n_steps; k > 0; k--) {
+        sum = sum * neuron->exp_TC + decay_power;
+        decay_power = decay_s1615(decay_power, decay);
+    }
+    return (sum - neuron->exp_TC * sum) * neuron->R_membrane;
+}
+
+//! \brief Work out the factors to advance a neuron over a timestep
+//! \param[out] propagator: The factors to fill in
+//! \param[in] neuron: The neuron, already initialised for the sub-steps
+//! \param[in] synapses: The synapses, already initialised for the sub-steps
+//! \param[in] n_steps: The number of sub-steps per timestep
+static inline void lif_exp_propagator_initialise(
+        lif_exp_propagator_t *propagator, const neuron_t *neuron,
+        const synapse_types_t *synapses, uint32_t n_steps) {
+    propagator->V_decay = ONE;
+    propagator->exc_decay = synapses->exc.decay;
+    propagator->inh_decay = synapses->inh.decay;
+    for (uint32_t k = n_steps; k > 0; k--) {
+        propagator->V_decay = propagator->V_decay * neuron->exp_TC;
+    }
+    for (uint32_t k = n_steps; k > 1; k--) {
+        propagator->exc_decay = decay_product(
+                propagator->exc_decay, synapses->exc.decay);
+        propagator->inh_decay = decay_product(
+                propagator->inh_decay, synapses->inh.decay);
+    }
+    propagator->exc_gain = lif_exp_input_gain(
+            neuron, synapses->exc.decay, n_steps);
+    propagator->inh_gain = lif_exp_input_gain(
+            neuron, synapses->inh.decay, n_steps);
+}
+
+//! \brief Determine if a neuron can be advanced over the whole timestep at
+//!     once
+//! \details This is not the case if the refractory period ends part way
+//!     through the timestep.
+//! \param[in] neuron: The neuron to check
+//! \param[in] n_steps: The number of sub-steps per timestep
+//! \return True if lif_exp_propagator_update() can be used
+static inline bool lif_exp_propagator_applies(
+        const neuron_t *neuron, uint32_t n_steps) {
+    return neuron->refract_timer <= 0
+            || neuron->refract_timer >= (int32_t) n_steps;
+}
+
+//! \brief Advance a neuron and its synapses over all the sub-steps of a
+//!     timestep
+//! \param[in] propagator: The factors for the neuron
+//! \param[in,out] neuron: The neuron to advance
+//! \param[in,out] synapses: The synapses of the neuron, which get shaped
+//! \param[in] external_bias: Any additional input current
+//! \param[in] current_offset: Any injected current
+//! \param[in] n_steps: The number of sub-steps per timestep
+//! \return The membrane voltage to compare with the threshold
+static inline state_t lif_exp_propagator_update(
+        const lif_exp_propagator_t *propagator, neuron_t *restrict neuron,
+        synapse_types_t *restrict synapses, input_t external_bias,
+        REAL current_offset, uint32_t n_steps) {
+    input_t exc = synapses->exc.synaptic_input_value;
+    input_t inh = synapses->inh.synaptic_input_value;
+
+    if (neuron->refract_timer <= 0) {
+        REAL V_target = (external_bias + neuron->I_offset + current_offset)
+                * neuron->R_membrane + membrane_load(neuron->V_rest);
+        neuron->V_membrane = membrane_store(V_target
+                + propagator->V_decay
+                        * (membrane_load(neuron->V_membrane) - V_target)
+                + exc * propagator->exc_gain - inh * propagator->inh_gain);
+    } else {
+        neuron->refract_timer -= n_steps;
+    }
+
+    synapses->exc.synaptic_input_value = decay_s1615(
+            exc, propagator->exc_decay);
+    synapses->inh.synaptic_input_value = decay_s1615(
+            inh, propagator->inh_decay);
+    return membrane_load(neuron->V_membrane);
+}
+
+#endif // _LIF_EXP_SUB_STEPS_H_
@@ -63,8 +63,16 @@ typedef struct packet_firing_data_t {
     uint32_t time_until_next_send;
     //! Send type
     enum send_type type;
+    //! \brief How many neurons back the neuron is that sends the decoded
+    //!     value this neuron adds to, or ::NOT_DECODED to send on its own
+    uint32_t decode_offset;
+    //! The weight of the value of this neuron in the decoded value
+    accum decode_weight;
 } packet_firing_data_t;
 
+//! The decode offset of a neuron that sends its own value
+#define NOT_DECODED 0xFFFFFFFF
+
 //! Indices for recording of words
 enum word_recording_indices {
     //! V (somatic potential) recording index
@@ -97,6 +105,12 @@ static packet_firing_data_t *packet_firing_array;
 //! The synapse shaping parameters
 static synapse_types_t *synapse_types_array;
 
+//! The decoded value of each neuron that sends one, summed this time step
+static accum *decoded_values;
+
+//! Whether each neuron that sends a decoded value is due to send it
+static bool *decoded_due;
+
 //! The number of steps to run per timestep
 static uint n_steps_per_timestep;
 
@@ -150,6 +164,12 @@ static bool neuron_impl_initialise(uint32_t n_neurons) {
 		log_error("Unable to allocate neuron array - Out of DTCM");
 		return false;
 	}
+#ifdef NEURON_MODEL_HAS_COLD_PARAMETERS
+	if (!neuron_model_cold_initialise(neuron_array, n_neurons)) {
+		log_error("Unable to allocate cold neuron parameters - Out of SDRAM");
+		return false;
+	}
+#endif
 
     // Allocate DTCM for packet firing array and copy block of data
 	packet_firing_array =
@@ -168,6 +188,14 @@ static bool neuron_impl_initialise(uint32_t n_neurons) {
 		return false;
 	}
 
+    // Allocate DTCM for the decoded values
+	decoded_values = spin1_malloc(n_neurons * sizeof(accum));
+	decoded_due = spin1_malloc(n_neurons * sizeof(bool));
+	if (decoded_values == NULL || decoded_due == NULL) {
+		log_error("Unable to allocate decoded values - Out of DTCM");
+		return false;
+	}
+
     return true;
 }
 
@@ -249,6 +277,30 @@ static bool _test_will_fire(packet_firing_data_t *packet_firing) {
     return false;
 }
 
+//! \brief Send a value to a device, clipped and scaled as the device needs
+//! \param[in] packet_firing: The parameters of the device
+//! \param[in] value: The value to send
+static inline void _send_value(
+        packet_firing_data_t *packet_firing, accum value) {
+    if (packet_firing->value_as_payload) {
+        accum value_to_send = value;
+        if (value > packet_firing->max_value) {
+            value_to_send = packet_firing->max_value;
+        }
+        if (value < packet_firing->min_value) {
+            value_to_send = packet_firing->min_value;
+        }
+
+        uint payload = _get_payload(
+            packet_firing->type,
+            value_to_send * packet_firing->value_as_payload);
+
+        send_spike_mc_payload(packet_firing->key, payload);
+    } else {
+        send_spike_mc(packet_firing->key);
+    }
+}
+
 SOMETIMES_UNUSED // Marked unused as only used sometimes
 //! \brief Do the timestep update for the particular implementation
 //! \param[in] timer_count: The timer count, used for TDMA packet spreading
@@ -257,6 +309,11 @@ SOMETIMES_UNUSED // Marked unused as only used sometimes
 static void neuron_impl_do_timestep_update(
         UNUSED uint32_t timer_count, UNUSED uint32_t time, uint32_t n_neurons) {
 
+    for (uint32_t neuron_index = 0; neuron_index < n_neurons; neuron_index++) {
+        decoded_values[neuron_index] = ZERO;
+        decoded_due[neuron_index] = false;
+    }
+
     for (uint32_t neuron_index = 0; neuron_index < n_neurons; neuron_index++) {
         // Get the neuron itself
         neuron_t *this_neuron = &neuron_array[neuron_index];
@@ -269,6 +326,8 @@ static void neuron_impl_do_timestep_update(
 
         // Store whether the neuron has spiked
         bool will_fire = false;
+        bool is_decoded = the_packet_firing->decode_offset != NOT_DECODED;
+        state_t result = ZERO;
 
         // Loop however many times requested; do this in reverse for efficiency,
         // and because the index doesn't actually matter
@@ -309,7 +368,7 @@ static void neuron_impl_do_timestep_update(
             REAL current_offset = current_source_get_offset(time, neuron_index);
 
             // update neuron parameters
-            state_t result = neuron_model_state_update(
+            result = neuron_model_state_update(
                     NUM_EXCITATORY_RECEPTORS, exc_input_values,
                     NUM_INHIBITORY_RECEPTORS, inh_input_values,
                     0, current_offset, this_neuron);
@@ -317,24 +376,16 @@ static void neuron_impl_do_timestep_update(
             // determine if a packet should fly
             will_fire = _test_will_fire(the_packet_firing);
 
-            // If spike occurs, communicate to relevant parts of model
+            // If spike occurs, communicate to relevant parts of model; a
+            // decoded value is sent by the first of its neurons once all
+            // of them have added to it
             if (will_fire) {
-                if (the_packet_firing->value_as_payload) {
-                    accum value_to_send = result;
-                    if (result > the_packet_firing->max_value) {
-                        value_to_send = the_packet_firing->max_value;
+                if (is_decoded) {
+                    if (the_packet_firing->decode_offset == 0) {
+                        decoded_due[neuron_index] = true;
                     }
-                    if (result < the_packet_firing->min_value) {
-                        value_to_send = the_packet_firing->min_value;
-                    }
-
-                    uint payload = _get_payload(
-                        the_packet_firing->type,
-                        value_to_send * the_packet_firing->value_as_payload);
-
-                    send_spike_mc_payload(the_packet_firing->key, payload);
                 } else {
-                    send_spike_mc(the_packet_firing->key);
+                    _send_value(the_packet_firing, result);
                 }
             }
 
@@ -342,6 +393,12 @@ static void neuron_impl_do_timestep_update(
             synapse_types_shape_input(the_synapse_type);
         }
 
+        // Add the final value to the decoded value it is part of
+        if (is_decoded) {
+            decoded_values[neuron_index - the_packet_firing->decode_offset] +=
+                    the_packet_firing->decode_weight * result;
+        }
+
         if (will_fire) {
             // Record the spike
             neuron_recording_record_bit(PACKET_RECORDING_BITFIELD, neuron_index);
@@ -351,6 +408,14 @@ static void neuron_impl_do_timestep_update(
         neuron_model_print_state_variables(this_neuron);
     #endif // LOG_LEVEL >= LOG_DEBUG
     }
+
+    // Send one command for each decoded value that is due
+    for (uint32_t neuron_index = 0; neuron_index < n_neurons; neuron_index++) {
+        if (decoded_due[neuron_index]) {
+            _send_value(&packet_firing_array[neuron_index],
+                    decoded_values[neuron_index]);
+        }
+    }
 }
 
 SOMETIMES_UNUSED // Marked unused as only used sometimes
@@ -35,6 +35,107 @@
 #include <bit_field.h>
 #include <recording.h>
 
+#ifndef NEURON_SOA_UPDATE
+//! \brief Whether to update the neurons in stages, each stage being a tight
+//!     loop over all neurons working on contiguous per-neuron arrays, rather
+//!     than taking each neuron through all the stages in turn
+//! \details This costs (1 + ::NUM_EXCITATORY_RECEPTORS +
+//!     ::NUM_INHIBITORY_RECEPTORS) words and a byte of DTCM per neuron.
+#define NEURON_SOA_UPDATE 0
+#endif
+
+#ifndef NEURON_QUIESCENT_SKIP
+//! \brief Whether to skip updating neurons that have settled with no input,
+//!     as updating them would not change them
+//! \details Only has an effect on the neuron-at-a-time update, and only when
+//!     the neuron model, synapse types and threshold type can all be settled
+//!     (see ::NEURON_MODEL_CAN_SETTLE, ::SYNAPSE_TYPES_CAN_SETTLE and
+//!     ::THRESHOLD_TYPE_CONSTANT) and there is no additional input.
+#define NEURON_QUIESCENT_SKIP 0
+#endif
+
+#ifndef NEURON_QUIESCENT_EPSILON
+//! How close the state of a neuron must be to where it would settle without
+//! input before it is treated as settled
+#define NEURON_QUIESCENT_EPSILON REAL_CONST(0.001)
+#endif
+
+#ifndef NEURON_CLOSED_FORM_SUB_STEPS
+//! \brief Whether to advance each neuron over all the sub-steps of a timestep
+//!     in one closed-form update, rather than one sub-step at a time
+//! \details Only has an effect on the neuron-at-a-time update of LIF neurons
+//!     with exponential current synapses and no additional input.  The
+//!     threshold is then only checked at the end of each timestep, and any
+//!     injected current is read once per timestep.
+#define NEURON_CLOSED_FORM_SUB_STEPS 0
+#endif
+
+#ifndef NEURON_FUSED_CONDUCTANCE
+//! \brief Whether to convert the conductances of all the receptors of a
+//!     neuron to one current in a single pass
+//! \details Only has an effect on the neuron-at-a-time update of LIF and
+//!     Izhikevich neurons with conductance input, which only use the total of
+//!     their inputs.
+#define NEURON_FUSED_CONDUCTANCE 0
+#endif
+
+#ifndef NEURON_SHARED_PARAMETERS
+//! \brief Whether to hold one copy of the input type and threshold type for
+//!     all the neurons when these are the same for every neuron, rather than
+//!     one copy per neuron
+//! \details Only the parts that hold no state are shared: the input type, and
+//!     the threshold type where it is constant (see ::THRESHOLD_TYPE_CONSTANT).
+//!     Shared parts are found with the neuron index masked to 0, and the DTCM
+//!     of the other copies is freed.
+#define NEURON_SHARED_PARAMETERS 0
+#endif
+
+#if NEURON_CLOSED_FORM_SUB_STEPS && !NEURON_SOA_UPDATE && \
+        defined(_NEURON_MODEL_LIF_CURR_IMPL_H_) && \
+        defined(_SYNAPSE_TYPES_EXPONENTIAL_IMPL_H_) && \
+        defined(_INPUT_TYPE_CURRENT_H_) && \
+        defined(_ADDITIONAL_INPUT_TYPE_NONE_H_)
+//! Whether the sub-steps are actually done in closed form in this build
+#define CLOSED_FORM_SUB_STEPS 1
+#include "lif_exp_sub_steps.h"
+#else
+#define CLOSED_FORM_SUB_STEPS 0
+#endif
+
+#if NEURON_FUSED_CONDUCTANCE && !NEURON_SOA_UPDATE && \
+        defined(_INPUT_TYPE_CONDUCTANCE_H_) && \
+        (defined(_NEURON_MODEL_LIF_CURR_IMPL_H_) || \
+         defined(_NEURON_MODEL_IZH_CURR_IMPL_H_))
+//! Whether the conductances are actually converted in one pass in this build
+#define FUSED_CONDUCTANCE 1
+#else
+#define FUSED_CONDUCTANCE 0
+#endif
+
+#if NEURON_QUIESCENT_SKIP && !NEURON_SOA_UPDATE && \
+        defined(NEURON_MODEL_CAN_SETTLE) && defined(SYNAPSE_TYPES_CAN_SETTLE) \
+        && defined(THRESHOLD_TYPE_CONSTANT) && \
+        defined(_ADDITIONAL_INPUT_TYPE_NONE_H_)
+//! Whether settled neurons are actually skipped in this build
+#define SKIP_SETTLED_NEURONS 1
+#else
+#define SKIP_SETTLED_NEURONS 0
+#endif
+
+#if NEURON_SHARED_PARAMETERS
+//! Whether the input types can be shared in this build
+#define SHARE_INPUT_TYPES 1
+#else
+#define SHARE_INPUT_TYPES 0
+#endif
+
+#if NEURON_SHARED_PARAMETERS && defined(THRESHOLD_TYPE_CONSTANT)
+//! Whether the threshold types can be shared in this build
+#define SHARE_THRESHOLD_TYPES 1
+#else
+#define SHARE_THRESHOLD_TYPES 0
+#endif
+
 //! Indices for recording of words
 enum word_recording_indices {
     //! V (somatic potential) recording index
@@ -73,9 +174,51 @@ static threshold_type_t *threshold_type_array;
 //! The synapse shaping parameters
 static synapse_types_t *synapse_types_array;
 
+#if SHARE_INPUT_TYPES
+//! Mask of a neuron index to find its input type; 0 when all share one
+static uint32_t input_type_mask = 0xFFFFFFFF;
+//! The index of the input type of a neuron
+#define INPUT_TYPE_INDEX(n) ((n) & input_type_mask)
+#else
+#define INPUT_TYPE_INDEX(n) (n)
+#endif
+
+#if SHARE_THRESHOLD_TYPES
+//! Mask of a neuron index to find its threshold type; 0 when all share one
+static uint32_t threshold_type_mask = 0xFFFFFFFF;
+//! The index of the threshold type of a neuron
+#define THRESHOLD_TYPE_INDEX(n) ((n) & threshold_type_mask)
+#else
+#define THRESHOLD_TYPE_INDEX(n) (n)
+#endif
+
 //! The number of steps to run per timestep
 static uint n_steps_per_timestep;
 
+#if NEURON_SOA_UPDATE
+//! The membrane voltage of each neuron, then the result of its state update
+static state_t *soma_voltages;
+
+//! The excitatory inputs, ::NUM_EXCITATORY_RECEPTORS per neuron
+static input_t *exc_inputs;
+
+//! The inhibitory inputs, ::NUM_INHIBITORY_RECEPTORS per neuron
+static input_t *inh_inputs;
+
+//! Whether each neuron spiked in the current step
+static bool *spiked;
+#endif // NEURON_SOA_UPDATE
+
+#if SKIP_SETTLED_NEURONS
+//! The neurons that have settled, and so need no update until they get input
+static bit_field_t settled_neurons;
+#endif
+
+#if CLOSED_FORM_SUB_STEPS
+//! The factors that advance each neuron over all the sub-steps of a timestep
+static lif_exp_propagator_t *propagator_array;
+#endif
+
 SOMETIMES_UNUSED // Marked unused as only used sometimes
 //! \brief Initialise the particular implementation of the data
 //! \param[in] n_neurons: The number of neurons
@@ -89,6 +232,12 @@ static bool neuron_impl_initialise(uint32_t n_neurons) {
             log_error("Unable to allocate neuron array - Out of DTCM");
             return false;
         }
+#ifdef NEURON_MODEL_HAS_COLD_PARAMETERS
+        if (!neuron_model_cold_initialise(neuron_array, n_neurons)) {
+            log_error("Unable to allocate cold neuron parameters - Out of SDRAM");
+            return false;
+        }
+#endif
     }
 
     // Allocate DTCM for input type array and copy block of data
@@ -131,6 +280,37 @@ static bool neuron_impl_initialise(uint32_t n_neurons) {
         }
     }
 
+#if NEURON_SOA_UPDATE
+    soma_voltages = spin1_malloc(n_neurons * sizeof(state_t));
+    exc_inputs = spin1_malloc(
+            n_neurons * NUM_EXCITATORY_RECEPTORS * sizeof(input_t));
+    inh_inputs = spin1_malloc(
+            n_neurons * NUM_INHIBITORY_RECEPTORS * sizeof(input_t));
+    spiked = spin1_malloc(n_neurons * sizeof(bool));
+    if (soma_voltages == NULL || exc_inputs == NULL || inh_inputs == NULL
+            || spiked == NULL) {
+        log_error("Unable to allocate neuron update arrays - Out of DTCM");
+        return false;
+    }
+#endif // NEURON_SOA_UPDATE
+
+#if SKIP_SETTLED_NEURONS
+    settled_neurons = bit_field_alloc(n_neurons);
+    if (settled_neurons == NULL) {
+        log_error("Unable to allocate settled neuron bit field - Out of DTCM");
+        return false;
+    }
+    clear_bit_field(settled_neurons, get_bit_field_size(n_neurons));
+#endif
+
+#if CLOSED_FORM_SUB_STEPS
+    propagator_array = spin1_malloc(n_neurons * sizeof(lif_exp_propagator_t));
+    if (propagator_array == NULL) {
+        log_error("Unable to allocate propagator array - Out of DTCM");
+        return false;
+    }
+#endif
+
     return true;
 }
 
@@ -146,7 +326,95 @@ static void neuron_impl_add_inputs(
     synapse_types_t *parameters = &synapse_types_array[neuron_index];
     synapse_types_add_neuron_input(synapse_type_index,
             parameters, weights_this_timestep);
+#if SKIP_SETTLED_NEURONS
+    bit_field_clear(settled_neurons, neuron_index);
+#endif
+}
+
+#if NEURON_SHARED_PARAMETERS
+//! \brief Determine if two copies of a part of a neuron are the same
+//! \param[in] a: The first copy
+//! \param[in] b: The second copy
+//! \param[in] size: The size of the part in bytes
+//! \return Whether the copies hold the same bytes
+static inline bool parts_equal(const void *a, const void *b, uint32_t size) {
+    const uint8_t *a_bytes = a;
+    const uint8_t *b_bytes = b;
+    for (uint32_t i = 0; i < size; i++) {
+        if (a_bytes[i] != b_bytes[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! \brief Make an array of a part of the neurons hold one copy for all the
+//!     neurons or one copy for each, reallocating it if that changes
+//! \details The contents are lost if the array is reallocated.
+//! \param[in,out] array: The array
+//! \param[in,out] mask: The mask of a neuron index into the array
+//! \param[in] shared: Whether the neurons are to share one copy
+//! \param[in] size: The size of the part in bytes
+//! \param[in] n_neurons: The number of neurons
+static void share_array(void **array, uint32_t *mask, bool shared,
+        uint32_t size, uint32_t n_neurons) {
+    uint32_t new_mask = shared ? 0 : 0xFFFFFFFF;
+    if (new_mask == *mask) {
+        return;
+    }
+    sark_free(*array);
+    *array = spin1_malloc(shared ? size : (n_neurons * size));
+    if (*array == NULL) {
+        log_error("Unable to reallocate shared neuron parts - Out of DTCM");
+        rt_error(RTE_SWERR);
+    }
+    *mask = new_mask;
+}
+#endif // NEURON_SHARED_PARAMETERS
+
+#if SHARE_INPUT_TYPES
+//! \brief Determine if all the neurons would have the same input type
+//! \param[in] params: The parameters of the input types
+//! \param[in] n_neurons: The number of neurons
+//! \return Whether the neurons can share one input type
+static bool input_types_all_same(
+        input_type_params_t *params, uint32_t n_neurons) {
+    if (n_neurons < 2) {
+        return false;
+    }
+    input_type_t first, other;
+    input_type_initialise(&first, &params[0], n_steps_per_timestep);
+    for (uint32_t i = 1; i < n_neurons; i++) {
+        input_type_initialise(&other, &params[i], n_steps_per_timestep);
+        if (!parts_equal(&first, &other, sizeof(input_type_t))) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif // SHARE_INPUT_TYPES
+
+#if SHARE_THRESHOLD_TYPES
+//! \brief Determine if all the neurons would have the same threshold type
+//! \param[in] params: The parameters of the threshold types
+//! \param[in] n_neurons: The number of neurons
+//! \return Whether the neurons can share one threshold type
+static bool threshold_types_all_same(
+        threshold_type_params_t *params, uint32_t n_neurons) {
+    if (n_neurons < 2) {
+        return false;
+    }
+    threshold_type_t first, other;
+    threshold_type_initialise(&first, &params[0], n_steps_per_timestep);
+    for (uint32_t i = 1; i < n_neurons; i++) {
+        threshold_type_initialise(&other, &params[i], n_steps_per_timestep);
+        if (!parts_equal(&first, &other, sizeof(threshold_type_t))) {
+            return false;
+        }
+    }
+    return true;
 }
+#endif // SHARE_THRESHOLD_TYPES
 
 //! \brief The number of _words_ required to hold an object of given size
 //! \param[in] size: The size of object
@@ -183,7 +451,15 @@ static void neuron_impl_load_neuron_parameters(
 
     if (sizeof(input_type_t)) {
     	input_type_params_t *params = (input_type_params_t *) &address[next];
-		for (uint32_t i = 0; i < n_neurons; i++) {
+#if SHARE_INPUT_TYPES
+    	bool shared = input_types_all_same(params, n_neurons);
+    	share_array((void **) &input_type_array, &input_type_mask, shared,
+    			sizeof(input_type_t), n_neurons);
+    	uint32_t n_copies = shared ? 1 : n_neurons;
+#else
+    	uint32_t n_copies = n_neurons;
+#endif
+		for (uint32_t i = 0; i < n_copies; i++) {
 			input_type_initialise(&input_type_array[i], &params[i],
 					n_steps_per_timestep);
 		}
@@ -192,7 +468,15 @@ static void neuron_impl_load_neuron_parameters(
 
     if (sizeof(threshold_type_t)) {
     	threshold_type_params_t *params = (threshold_type_params_t *) &address[next];
-        for (uint32_t i = 0; i < n_neurons; i++) {
+#if SHARE_THRESHOLD_TYPES
+        bool shared = threshold_types_all_same(params, n_neurons);
+        share_array((void **) &threshold_type_array, &threshold_type_mask,
+                shared, sizeof(threshold_type_t), n_neurons);
+        uint32_t n_copies = shared ? 1 : n_neurons;
+#else
+        uint32_t n_copies = n_neurons;
+#endif
+        for (uint32_t i = 0; i < n_copies; i++) {
         	threshold_type_initialise(&threshold_type_array[i], &params[i],
         			n_steps_per_timestep);
         }
@@ -205,6 +489,9 @@ static void neuron_impl_load_neuron_parameters(
 			synapse_types_initialise(&synapse_types_array[i], &params[i],
 					n_steps_per_timestep);
 		}
+#if NEURON_SOA_UPDATE && defined(SYNAPSE_TYPES_CAN_SHAPE_ALL)
+		synapse_types_find_shared_decay(synapse_types_array, n_neurons);
+#endif
         next += n_words_needed(n_neurons * sizeof(synapse_types_params_t));
     }
 
@@ -214,9 +501,24 @@ static void neuron_impl_load_neuron_parameters(
         	additional_input_initialise(&additional_input_array[i], &params[i],
         			n_steps_per_timestep);
         }
+#if NEURON_SOA_UPDATE && defined(ADDITIONAL_INPUT_CAN_DECAY_ALL)
+        additional_input_find_shared_decay(additional_input_array, n_neurons);
+#endif
         next += n_words_needed(n_neurons * sizeof(additional_input_params_t));
     }
 
+#if CLOSED_FORM_SUB_STEPS
+    for (uint32_t i = 0; i < n_neurons; i++) {
+        lif_exp_propagator_initialise(&propagator_array[i], &neuron_array[i],
+                &synapse_types_array[i], n_steps_per_timestep);
+    }
+#endif
+
+#if SKIP_SETTLED_NEURONS
+    // The state may have changed, so every neuron must be updated again
+    clear_bit_field(settled_neurons, get_bit_field_size(n_neurons));
+#endif
+
     // If we are to save the initial state, copy the whole of the parameters
     // to the initial state
     if (save_initial_state) {
@@ -231,6 +533,148 @@ static void neuron_impl_load_neuron_parameters(
 #endif // LOG_LEVEL >= LOG_DEBUG
 }
 
+#if NEURON_SOA_UPDATE
+//! \brief Copy receptor values into a neuron's slice of an input array if the
+//!     component returned them somewhere else
+//! \param[out] slice: The slice of the input array for the neuron
+//! \param[in] values: The values returned by the component
+//! \param[in] n_receptors: The number of receptors in the slice
+//! \return The sum of the values over the receptors
+static inline REAL gather_inputs(
+        input_t *slice, const input_t *values, uint32_t n_receptors) {
+    REAL total = ZERO;
+    if (values == NULL) {
+        return total;
+    }
+    for (uint32_t i = 0; i < n_receptors; i++) {
+        total += values[i];
+    }
+    if (values != slice) {
+        spin1_memcpy(slice, values, n_receptors * sizeof(input_t));
+    }
+    return total;
+}
+
+//! \brief Read the synaptic inputs and voltage of all neurons, converting the
+//!     inputs to currents
+//! \param[in] n_neurons: The number of neurons
+//! \param[in] record: Whether to record the inputs and voltage
+static inline void stage_gather_inputs(uint32_t n_neurons, bool record) {
+    input_t *exc = exc_inputs;
+    input_t *inh = inh_inputs;
+    for (uint32_t n = 0; n < n_neurons; n++) {
+        input_type_t *input_types = &input_type_array[INPUT_TYPE_INDEX(n)];
+        synapse_types_t *the_synapse_type = &synapse_types_array[n];
+        state_t soma_voltage = neuron_model_get_membrane_voltage(
+                &neuron_array[n]);
+        soma_voltages[n] = soma_voltage;
+
+        REAL total_exc = gather_inputs(exc, input_type_get_input_value(
+                synapse_types_get_excitatory_input(exc, the_synapse_type),
+                input_types, NUM_EXCITATORY_RECEPTORS),
+                NUM_EXCITATORY_RECEPTORS);
+        REAL total_inh = gather_inputs(inh, input_type_get_input_value(
+                synapse_types_get_inhibitory_input(inh, the_synapse_type),
+                input_types, NUM_INHIBITORY_RECEPTORS),
+                NUM_INHIBITORY_RECEPTORS);
+
+        if (record) {
+            neuron_recording_record_accum(V_RECORDING_INDEX, n, soma_voltage);
+            neuron_recording_record_accum(
+                    GSYN_EXC_RECORDING_INDEX, n, total_exc);
+            neuron_recording_record_accum(
+                    GSYN_INH_RECORDING_INDEX, n, total_inh);
+        }
+
+        input_type_convert_excitatory_input_to_current(
+                exc, input_types, soma_voltage);
+        input_type_convert_inhibitory_input_to_current(
+                inh, input_types, soma_voltage);
+        exc += NUM_EXCITATORY_RECEPTORS;
+        inh += NUM_INHIBITORY_RECEPTORS;
+    }
+}
+
+//! \brief Update the state of all neurons from the gathered inputs
+//! \param[in] time: The time step of the update
+//! \param[in] n_neurons: The number of neurons
+static inline void stage_update_state(uint32_t time, uint32_t n_neurons) {
+#ifdef ADDITIONAL_INPUT_CAN_DECAY_ALL
+    additional_input_decay_all(additional_input_array, n_neurons);
+#endif
+    input_t *exc = exc_inputs;
+    input_t *inh = inh_inputs;
+    for (uint32_t n = 0; n < n_neurons; n++) {
+        REAL current_offset = current_source_get_offset(time, n);
+#ifdef ADDITIONAL_INPUT_CAN_DECAY_ALL
+        input_t external_bias = additional_input_get_decayed_current(
+                &additional_input_array[n]);
+#else
+        input_t external_bias = additional_input_get_input_value_as_current(
+                &additional_input_array[n], soma_voltages[n]);
+#endif
+        soma_voltages[n] = neuron_model_state_update(
+                NUM_EXCITATORY_RECEPTORS, exc, NUM_INHIBITORY_RECEPTORS, inh,
+                external_bias, current_offset, &neuron_array[n]);
+        exc += NUM_EXCITATORY_RECEPTORS;
+        inh += NUM_INHIBITORY_RECEPTORS;
+    }
+}
+
+//! \brief Check the updated state of all neurons against their thresholds,
+//!     and then tell the model parts about and send any spikes
+//! \param[in] timer_count: The timer count, used for TDMA packet spreading
+//! \param[in] time: The time step of the update
+//! \param[in] n_neurons: The number of neurons
+static inline void stage_threshold(
+        uint32_t timer_count, uint32_t time, uint32_t n_neurons) {
+    for (uint32_t n = 0; n < n_neurons; n++) {
+        spiked[n] = threshold_type_is_above_threshold(soma_voltages[n],
+                &threshold_type_array[THRESHOLD_TYPE_INDEX(n)]);
+    }
+    for (uint32_t n = 0; n < n_neurons; n++) {
+        if (spiked[n]) {
+            neuron_model_has_spiked(&neuron_array[n]);
+            additional_input_has_spiked(&additional_input_array[n]);
+            neuron_recording_record_bit(SPIKE_RECORDING_BITFIELD, n);
+            send_spike(timer_count, time, n);
+        }
+    }
+}
+
+//! \brief Shape the synaptic input of all neurons
+//! \param[in] n_neurons: The number of neurons
+static inline void stage_shape_input(uint32_t n_neurons) {
+#ifdef SYNAPSE_TYPES_CAN_SHAPE_ALL
+    synapse_types_shape_all(synapse_types_array, n_neurons);
+#else
+    for (uint32_t n = 0; n < n_neurons; n++) {
+        synapse_types_shape_input(&synapse_types_array[n]);
+    }
+#endif
+}
+#endif // NEURON_SOA_UPDATE
+
+#if SKIP_SETTLED_NEURONS
+//! \brief Mark a neuron as settled if all its parts have settled after an
+//!     update in which it did not spike
+//! \details Once settled, the state of the neuron is where the update would
+//!     leave it, below the threshold, until it gets input.
+//! \param[in] neuron_index: The index of the neuron
+static inline void neuron_try_settle(uint32_t neuron_index) {
+    neuron_t *this_neuron = &neuron_array[neuron_index];
+    if (synapse_types_settle(&synapse_types_array[neuron_index],
+                NEURON_QUIESCENT_EPSILON)
+            && neuron_model_settle(this_neuron, NEURON_QUIESCENT_EPSILON)
+            && !threshold_type_is_above_threshold(
+                    neuron_model_get_membrane_voltage(this_neuron),
+                    &threshold_type_array[
+                            THRESHOLD_TYPE_INDEX(neuron_index)])) {
+        bit_field_set(settled_neurons, neuron_index);
+    }
+}
+#endif // SKIP_SETTLED_NEURONS
+
 SOMETIMES_UNUSED // Marked unused as only used sometimes
 //! \brief Do the timestep update for the particular implementation
 //! \param[in] timer_count: The timer count, used for TDMA packet spreading
@@ -239,25 +683,101 @@ SOMETIMES_UNUSED // Marked unused as only used sometimes
 static void neuron_impl_do_timestep_update(
         uint32_t timer_count, uint32_t time, uint32_t n_neurons) {
 
+#if NEURON_SOA_UPDATE
+    // Each step takes all the neurons through one stage at a time; the
+    // neurons are independent within a step so the results are the same as
+    // updating each neuron in turn
+    for (uint32_t i_step = n_steps_per_timestep; i_step > 0; i_step--) {
+        stage_gather_inputs(n_neurons, i_step == n_steps_per_timestep);
+        stage_update_state(time, n_neurons);
+        stage_threshold(timer_count, time, n_neurons);
+        stage_shape_input(n_neurons);
+    }
+
+#if LOG_LEVEL >= LOG_DEBUG
+    for (uint32_t n = 0; n < n_neurons; n++) {
+        neuron_model_print_state_variables(&neuron_array[n]);
+    }
+#endif // LOG_LEVEL >= LOG_DEBUG
+#else
     for (uint32_t neuron_index = 0; neuron_index < n_neurons; neuron_index++) {
 
         // Get the neuron itself
         neuron_t *this_neuron = &neuron_array[neuron_index];
 
         // Get the input_type parameters and voltage for this neuron
-        input_type_t *input_types = &input_type_array[neuron_index];
+        input_type_t *input_types =
+                &input_type_array[INPUT_TYPE_INDEX(neuron_index)];
 
         // Get threshold and additional input parameters for this neuron
-        threshold_type_t *the_threshold_type = &threshold_type_array[neuron_index];
+        threshold_type_t *the_threshold_type =
+                &threshold_type_array[THRESHOLD_TYPE_INDEX(neuron_index)];
         additional_input_t *additional_inputs = &additional_input_array[neuron_index];
         synapse_types_t *the_synapse_type = &synapse_types_array[neuron_index];
 
+#if CLOSED_FORM_SUB_STEPS
+        // Do all the sub-steps at once where possible
+        if (n_steps_per_timestep > 1 && lif_exp_propagator_applies(
+                this_neuron, n_steps_per_timestep)) {
+            state_t soma_voltage = neuron_model_get_membrane_voltage(this_neuron);
+            neuron_recording_record_accum(
+                    V_RECORDING_INDEX, neuron_index, soma_voltage);
+            neuron_recording_record_accum(GSYN_EXC_RECORDING_INDEX,
+                    neuron_index, the_synapse_type->exc.synaptic_input_value);
+            neuron_recording_record_accum(GSYN_INH_RECORDING_INDEX,
+                    neuron_index, the_synapse_type->inh.synaptic_input_value);
+
+            REAL current_offset = current_source_get_offset(time, neuron_index);
+            input_t external_bias = additional_input_get_input_value_as_current(
+                    additional_inputs, soma_voltage);
+            state_t result = lif_exp_propagator_update(
+                    &propagator_array[neuron_index], this_neuron,
+                    the_synapse_type, external_bias, current_offset,
+                    n_steps_per_timestep);
+
+            if (threshold_type_is_above_threshold(result, the_threshold_type)) {
+                neuron_model_has_spiked(this_neuron);
+                additional_input_has_spiked(additional_inputs);
+                neuron_recording_record_bit(
+                        SPIKE_RECORDING_BITFIELD, neuron_index);
+                send_spike(timer_count, time, neuron_index);
+            }
+
+    #if LOG_LEVEL >= LOG_DEBUG
+            neuron_model_print_state_variables(this_neuron);
+    #endif // LOG_LEVEL >= LOG_DEBUG
+            continue;
+        }
+#endif // CLOSED_FORM_SUB_STEPS
+
         // Loop however many times requested; do this in reverse for efficiency,
         // and because the index doesn't actually matter
         for (uint32_t i_step = n_steps_per_timestep; i_step > 0; i_step--) {
+            // Get any input from an injected current source
+            REAL current_offset = current_source_get_offset(time, neuron_index);
+
             // Get the voltage
             state_t soma_voltage = neuron_model_get_membrane_voltage(this_neuron);
 
+#if SKIP_SETTLED_NEURONS
+            // A settled neuron with no injected current stays as it is, with
+            // no synaptic input
+            if (bit_field_test(settled_neurons, neuron_index)) {
+                if (bitsk(current_offset) == 0) {
+                    if (i_step == n_steps_per_timestep) {
+                        neuron_recording_record_accum(
+                                V_RECORDING_INDEX, neuron_index, soma_voltage);
+                        neuron_recording_record_accum(
+                                GSYN_EXC_RECORDING_INDEX, neuron_index, ZERO);
+                        neuron_recording_record_accum(
+                                GSYN_INH_RECORDING_INDEX, neuron_index, ZERO);
+                    }
+                    continue;
+                }
+                bit_field_clear(settled_neurons, neuron_index);
+            }
+#endif // SKIP_SETTLED_NEURONS
+
             // Get the exc and inh values from the synapses
             input_t exc_values[NUM_EXCITATORY_RECEPTORS];
             input_t *exc_syn_values =
@@ -266,6 +786,14 @@ static void neuron_impl_do_timestep_update(
             input_t *inh_syn_values =
                     synapse_types_get_inhibitory_input(inh_values, the_synapse_type);
 
+#if FUSED_CONDUCTANCE
+            // Convert all the conductances to one current in a single pass
+            REAL total_exc;
+            REAL total_inh;
+            input_t synaptic_current = input_type_conductance_current(
+                    exc_syn_values, inh_syn_values, input_types, soma_voltage,
+                    &total_exc, &total_inh);
+#else
             // Call functions to obtain exc_input and inh_input
             input_t *exc_input_values = input_type_get_input_value(
                     exc_syn_values, input_types, NUM_EXCITATORY_RECEPTORS);
@@ -282,6 +810,7 @@ static void neuron_impl_do_timestep_update(
             for (int i = 0; i < NUM_INHIBITORY_RECEPTORS; i++) {
                 total_inh += inh_input_values[i];
             }
+#endif // FUSED_CONDUCTANCE
 
             // Do recording if on the first step
             if (i_step == n_steps_per_timestep) {
@@ -293,24 +822,29 @@ static void neuron_impl_do_timestep_update(
                         GSYN_INH_RECORDING_INDEX, neuron_index, total_inh);
             }
 
+#if !FUSED_CONDUCTANCE
             // Call functions to convert exc_input and inh_input to current
             input_type_convert_excitatory_input_to_current(
                     exc_input_values, input_types, soma_voltage);
             input_type_convert_inhibitory_input_to_current(
                     inh_input_values, input_types, soma_voltage);
-
-            // Get any input from an injected current source
-            REAL current_offset = current_source_get_offset(time, neuron_index);
+#endif // !FUSED_CONDUCTANCE
 
             // Get any external bias input
             input_t external_bias = additional_input_get_input_value_as_current(
                     additional_inputs, soma_voltage);
 
             // update neuron parameters
+#if FUSED_CONDUCTANCE
+            state_t result = neuron_model_state_update(
+                    1, &synaptic_current, 0, NULL,
+                    external_bias, current_offset, this_neuron);
+#else
             state_t result = neuron_model_state_update(
                     NUM_EXCITATORY_RECEPTORS, exc_input_values,
                     NUM_INHIBITORY_RECEPTORS, inh_input_values,
                     external_bias, current_offset, this_neuron);
+#endif // FUSED_CONDUCTANCE
 
             // determine if a spike should occur
             bool spike_now =
@@ -335,12 +869,19 @@ static void neuron_impl_do_timestep_update(
 
             // Shape the existing input according to the included rule
             synapse_types_shape_input(the_synapse_type);
+
+#if SKIP_SETTLED_NEURONS
+            if (!spike_now) {
+                neuron_try_settle(neuron_index);
+            }
+#endif // SKIP_SETTLED_NEURONS
         }
 
     #if LOG_LEVEL >= LOG_DEBUG
         neuron_model_print_state_variables(this_neuron);
     #endif // LOG_LEVEL >= LOG_DEBUG
     }
+#endif // NEURON_SOA_UPDATE
 }
 
 SOMETIMES_UNUSED // Marked unused as only used sometimes
@@ -365,7 +906,8 @@ static void neuron_impl_store_neuron_parameters(
     if (sizeof(input_type_t)) {
         input_type_params_t *params = (input_type_params_t *) &address[next];
 		for (uint32_t i = 0; i < n_neurons; i++) {
-			input_type_save_state(&input_type_array[i], &params[i]);
+			input_type_save_state(
+					&input_type_array[INPUT_TYPE_INDEX(i)], &params[i]);
 		}
         next += n_words_needed(n_neurons * sizeof(input_type_params_t));
     }
@@ -373,7 +915,8 @@ static void neuron_impl_store_neuron_parameters(
     if (sizeof(threshold_type_t)) {
         threshold_type_params_t *params = (threshold_type_params_t *) &address[next];
         for (uint32_t i = 0; i < n_neurons; i++) {
-        	threshold_type_save_state(&threshold_type_array[i], &params[i]);
+        	threshold_type_save_state(
+        			&threshold_type_array[THRESHOLD_TYPE_INDEX(i)], &params[i]);
         }
         next += n_words_needed(n_neurons * sizeof(threshold_type_params_t));
     }
@@ -49,6 +49,21 @@
 
 #define MIN_POWER REAL_CONST(-5)
 
+//! \brief Whether to look up the probability of spiking by the quantised
+//!     power in a table made at initialisation.  This can be set per binary
+//!     at build time.
+#ifndef STOCHASTIC_PROBABILITY_TABLE
+#define STOCHASTIC_PROBABILITY_TABLE 0
+#endif
+
+#if STOCHASTIC_PROBABILITY_TABLE
+//! The log<sub>2</sub> of the number of table entries per unit of power
+#define SIGMA_TABLE_STEP_BITS 5
+//! \brief The number of entries in the table, from ::MIN_POWER, below which
+//!     the probability is 0, up to 16, from which it is 1
+#define SIGMA_TABLE_SIZE (21 << SIGMA_TABLE_STEP_BITS)
+#endif
+
 //! definition of neuron parameters
 typedef struct neuron_params_t {
 
@@ -97,6 +112,20 @@ typedef struct neuron_impl_t {
 //! Array of neuron states
 static neuron_impl_t *neuron_array;
 
+//! \brief Work out the probability of spiking
+//! \param[in] power: The voltage times alpha
+//! \return The probability, out of 2<sup>32</sup>
+static inline uint32_t stoc_sigma_probability(REAL power) {
+	REAL next_power = (REAL) pow_of_2(power * REAL_CONST(-1));
+	UREAL val = pow_of_2(next_power * REAL_CONST(-1));
+	return muliuk(0xFFFFFFFF, val);
+}
+
+#if STOCHASTIC_PROBABILITY_TABLE
+//! The probability of spiking at each quantised power
+static uint32_t sigma_table[SIGMA_TABLE_SIZE];
+#endif
+
 static bool neuron_impl_initialise(uint32_t n_neurons) {
     // Allocate DTCM for neuron array
 	neuron_array = spin1_malloc(n_neurons * sizeof(neuron_impl_t));
@@ -105,6 +134,13 @@ static bool neuron_impl_initialise(uint32_t n_neurons) {
 		return false;
 	}
 
+#if STOCHASTIC_PROBABILITY_TABLE
+	for (uint32_t i = 0; i < SIGMA_TABLE_SIZE; i++) {
+		sigma_table[i] = stoc_sigma_probability(kbits(bitsk(MIN_POWER) +
+				(int32_t) (i << (15 - SIGMA_TABLE_STEP_BITS))));
+	}
+#endif
+
     return true;
 }
 
@@ -208,9 +244,14 @@ static inline void do_non_refrac_update(uint32_t timer_count, uint32_t time,
 
 	// Work out the probability of spiking
 	REAL power = v_membrane * neuron->alpha;
-	REAL next_power = (REAL) pow_of_2(power * REAL_CONST(-1));
-	UREAL val = pow_of_2(next_power * REAL_CONST(-1));
-	uint32_t prob = muliuk(0xFFFFFFFF, val);
+#if STOCHASTIC_PROBABILITY_TABLE
+	uint32_t index = (bitsk(power) - bitsk(MIN_POWER))
+			>> (15 - SIGMA_TABLE_STEP_BITS);
+	uint32_t prob = (power >= MIN_POWER && index < SIGMA_TABLE_SIZE) ?
+			sigma_table[index] : stoc_sigma_probability(power);
+#else
+	uint32_t prob = stoc_sigma_probability(power);
+#endif
 
 	// Record the probability
 	neuron_recording_record_int32(PROB_INDEX, neuron_index, (int32_t) prob);
@@ -94,4 +94,32 @@ static inline void input_type_convert_inhibitory_input_to_current(
     }
 }
 
+//! \brief Converts the conductances of all the receptors to a single
+//!     current in one pass, with one multiply per reversal potential rather
+//!     than one per receptor
+//! \param[in] exc_input: The excitatory conductances before scaling
+//! \param[in] inh_input: The inhibitory conductances before scaling
+//! \param[in] input_type: The input type pointer to the parameters
+//! \param[in] membrane_voltage: The membrane voltage to use for the input
+//! \param[out] total_exc: The total excitatory conductance, after scaling
+//! \param[out] total_inh: The total inhibitory conductance, after scaling
+//! \return The current, excitatory positive
+static inline input_t input_type_conductance_current(
+        const input_t *exc_input, const input_t *inh_input,
+        const input_type_t *input_type, state_t membrane_voltage,
+        REAL *total_exc, REAL *total_inh) {
+    REAL g_exc = ZERO;
+    for (int i = 0; i < NUM_EXCITATORY_RECEPTORS; i++) {
+        g_exc += exc_input[i] >> 10;
+    }
+    REAL g_inh = ZERO;
+    for (int i = 0; i < NUM_INHIBITORY_RECEPTORS; i++) {
+        g_inh += inh_input[i] >> 10;
+    }
+    *total_exc = g_exc;
+    *total_inh = g_inh;
+    return g_exc * (input_type->V_rev_E - membrane_voltage)
+            + g_inh * (input_type->V_rev_I - membrane_voltage);
+}
+
 #endif // _INPUT_TYPE_CONDUCTANCE_H_
@@ -23,8 +23,36 @@
 #include <debug.h>
 #include <circular_buffer.h>
 #include <recording.h>
+#include <profiler.h>
 #include <spin1_api.h>
 
+//! if using profiler import profiler tags
+#ifdef PROFILER_ENABLED
+#include "profile_tags.h"
+#endif //PROFILER_ENABLED
+
+//! \brief The most spikes to take out of the input buffer with interrupts
+//!     disabled at a time
+#ifndef LOCAL_ONLY_SPIKE_BATCH
+#define LOCAL_ONLY_SPIKE_BATCH 16
+#endif
+
+//! \brief Whether to merge the spikes with the same key received in a time
+//!     step, and process each key once at the end of the time step, scaled by
+//!     the number of spikes
+#ifndef LOCAL_ONLY_DEDUPLICATE
+#define LOCAL_ONLY_DEDUPLICATE 0
+#endif
+
+//! Log_2 of the number of keys that can be merged in a time step
+#define LOG_PENDING_SIZE 8
+
+//! The number of keys that can be merged in a time step
+#define PENDING_SIZE (1 << LOG_PENDING_SIZE)
+
+//! The number of places to look for a key in the merged spikes
+#define PENDING_MAX_PROBES 8
+
 //: The configuration of the local only model
 struct local_only_config {
 	//! Log_2 of the number of neurons
@@ -42,11 +70,15 @@ struct local_only_config {
 //! A local copy of the configuration
 static struct local_only_config config;
 
-//! The input buffer for spikes received
+//! \brief The input buffer for spikes received; each entry is a pair of
+//!     words, the key and the number of times the key was received
 static circular_buffer input_buffer;
 
+//! The number of words the input buffer is guaranteed to hold
+static uint32_t input_buffer_capacity;
+
 //! Ring buffers to add weights to on spike processing
-static uint16_t *ring_buffers;
+static ring_buffer_t *ring_buffers;
 
 //! Whether the loop of processing is currently running
 //! (if not, it needs to be restarted on the next spike received)
@@ -64,9 +96,48 @@ static uint32_t n_spikes_dropped = 0;
 //! The maximum size of the input buffer during the run
 static uint32_t max_input_buffer_size = 0;
 
+//! The number of spikes that could not be added to the input buffer
+static uint32_t n_spikes_lost_from_input = 0;
+
 //! The local time step counter
 static uint32_t local_time;
 
+//! The number of spikes merged with an earlier one with the same key
+static uint32_t n_spikes_merged = 0;
+
+//! \brief Process a spike with the implementation, profiled so that the
+//!     cycles of each spike can be measured
+//! \param[in] time: The time step of the spike
+//! \param[in] key: The key of the spike
+//! \param[in] count: The number of times the key was received
+static inline void process_spike(uint32_t time, uint32_t key, uint32_t count) {
+    profiler_write_entry_disable_fiq(
+            PROFILER_ENTER | PROFILER_LOCAL_ONLY_SPIKE);
+    local_only_impl_process_spike(time, key, count, ring_buffers);
+    profiler_write_entry_disable_fiq(
+            PROFILER_EXIT | PROFILER_LOCAL_ONLY_SPIKE);
+}
+
+#if LOCAL_ONLY_DEDUPLICATE
+//! A key and the number of times it was received in a time step
+typedef struct pending_spike {
+    uint32_t key;
+    uint32_t count;
+} pending_spike;
+
+//! The spikes merged in this time step, by hash of the key; count is 0 if free
+static pending_spike pending[PENDING_SIZE];
+
+//! The indices in ::pending that are in use, so that only these are processed
+static uint16_t pending_active[PENDING_SIZE];
+
+//! The number of entries in ::pending_active
+static uint32_t n_pending_active = 0;
+
+//! The time step of the spikes in ::pending
+static uint32_t pending_time;
+#endif
+
 //! The mask to get the synaptic delay from a "synapse"
 uint32_t synapse_delay_mask;
 
@@ -95,27 +166,38 @@ static inline void run_next_process_loop(void) {
 
 //! \brief Update the maximum size of the input buffer
 static inline void update_max_input_buffer(void) {
-    uint32_t sz = circular_buffer_size(input_buffer);
+    uint32_t sz = circular_buffer_size(input_buffer) >> 1;
     if (sz > max_input_buffer_size) {
         max_input_buffer_size = sz;
     }
 }
 
+//! \brief Add a key and the number of times it was received to the input
+//!     buffer, and start the loop running if needed
+//! \param[in] key The key received
+//! \param[in] count The number of times the key was received
+static inline void add_spikes(uint32_t key, uint32_t count) {
+    // Both words must go in or neither, or the pairs will be out of step
+    if (circular_buffer_size(input_buffer) + 2 > input_buffer_capacity) {
+        n_spikes_lost_from_input += count;
+        return;
+    }
+    circular_buffer_add(input_buffer, key);
+    circular_buffer_add(input_buffer, count);
+    update_max_input_buffer();
+
+    // Start the loop running if not already
+    if (!process_loop_running) {
+        run_next_process_loop();
+    }
+}
+
 //! \brief Multicast packet without payload received callback
 //! \param[in] key The key received
 //! \param[in] unused Should be 0
 void mc_rcv_callback(uint key, UNUSED uint unused) {
     n_spikes_received += 1;
-
-    // If there is space in the buffer, add the packet, update the counters
-    if (circular_buffer_add(input_buffer, key)) {
-        update_max_input_buffer();
-
-        // Start the loop running if not already
-        if (!process_loop_running) {
-            run_next_process_loop();
-        }
-    }
+    add_spikes(key, 1);
 }
 
 //! \brief Multicast packet with payload received callback
@@ -124,34 +206,75 @@ void mc_rcv_callback(uint key, UNUSED uint unused) {
 void mc_rcv_payload_callback(uint key, uint n_spikes) {
     n_spikes_received += 1;
 
-    // Check of any one spike can be added to the circular buffer
-    bool added = false;
-    for (uint32_t i = n_spikes; i > 0; i--) {
-        added |= circular_buffer_add(input_buffer, key);
+    // The spikes are kept together, so the weights are only worked out once
+    if (n_spikes > 0) {
+        add_spikes(key, n_spikes);
     }
+}
 
-    // If any spikes were added, update the buffer maximum
-    if (added) {
-        update_max_input_buffer();
+#if LOCAL_ONLY_DEDUPLICATE
+//! \brief Merge a spike with the others of the same key in this time step
+//! \param[in] time The time step of the spike
+//! \param[in] key The key of the spike
+//! \param[in] count The number of times the key was received
+//! \return Whether the spike was merged; if not, it must be processed now
+static inline bool pending_add(uint32_t time, uint32_t key, uint32_t count) {
+    // All the merged spikes are processed with the same time
+    if (n_pending_active == 0) {
+        pending_time = time;
+    } else if (time != pending_time) {
+        return false;
+    }
 
-        // Start the loop running if not already
-        if (!process_loop_running) {
-            run_next_process_loop();
+    uint32_t index = (key * 0x9E3779B1) >> (32 - LOG_PENDING_SIZE);
+    for (uint32_t i = PENDING_MAX_PROBES; i > 0; i--) {
+        pending_spike *p = &pending[index];
+        if (p->count == 0) {
+            p->key = key;
+            p->count = count;
+            pending_active[n_pending_active++] = index;
+            return true;
+        }
+        if (p->key == key) {
+            p->count += count;
+            n_spikes_merged += count;
+            return true;
         }
+        index = (index + 1) & (PENDING_SIZE - 1);
     }
+    return false;
 }
+#endif
 
 //! \brief User callback; performs spike processing loop
 void process_callback(uint time, UNUSED uint unused1) {
-    uint32_t spike;
+    uint32_t spikes[LOCAL_ONLY_SPIKE_BATCH];
+    uint32_t counts[LOCAL_ONLY_SPIKE_BATCH];
     uint32_t cspr = spin1_int_disable();
 
-    // While there is a spike to process, pull it out of the buffer
-    while (process_loop_running && circular_buffer_get_next(input_buffer, &spike)) {
+    // While there are spikes to process, pull a batch of them out of the
+    // buffer, so that interrupts are only disabled once for the batch
+    while (process_loop_running) {
+        uint32_t n_spikes = 0;
+        while (n_spikes < LOCAL_ONLY_SPIKE_BATCH &&
+                circular_buffer_get_next(input_buffer, &spikes[n_spikes])) {
+            circular_buffer_get_next(input_buffer, &counts[n_spikes]);
+            n_spikes++;
+        }
+        if (n_spikes == 0) {
+            break;
+        }
         spin1_mode_restore(cspr);
 
-        // Process the spike using the specific local-only implementation
-        local_only_impl_process_spike(time, spike, ring_buffers);
+        // Process the spikes using the specific local-only implementation
+        for (uint32_t i = 0; i < n_spikes; i++) {
+#if LOCAL_ONLY_DEDUPLICATE
+            if (pending_add(time, spikes[i], counts[i])) {
+                continue;
+            }
+#endif
+            process_spike(time, spikes[i], counts[i]);
+        }
         cspr = spin1_int_disable();
     }
     process_loop_running = false;
@@ -162,7 +285,7 @@ void process_callback(uint time, UNUSED uint unused1) {
 // Implementations of interface (see local_only.h file for details)
 
 bool local_only_initialise(void *local_only_addr, void *local_only_params_addr,
-        uint32_t n_rec_regions_used, uint16_t **ring_buffers_ptr) {
+        uint32_t n_rec_regions_used, ring_buffer_t **ring_buffers_ptr) {
 
     // Set up the implementation
     if (!local_only_impl_initialise(local_only_params_addr)) {
@@ -173,7 +296,9 @@ bool local_only_initialise(void *local_only_addr, void *local_only_params_addr,
     struct local_only_config *sdram_config = local_only_addr;
     config = *sdram_config;
 
-    input_buffer = circular_buffer_initialize(config.input_buffer_size);
+    // Two words per entry; the buffer holds one less than it is made with
+    input_buffer_capacity = config.input_buffer_size * 2;
+    input_buffer = circular_buffer_initialize(input_buffer_capacity + 1);
     if (input_buffer == NULL) {
         log_error("Error setting up input buffer of size %u",
                 config.input_buffer_size);
@@ -193,7 +318,7 @@ bool local_only_initialise(void *local_only_addr, void *local_only_params_addr,
     uint32_t n_ring_buffer_bits = synapse_type_index_bits + synapse_delay_bits;
     uint32_t ring_buffer_size = 1 << (n_ring_buffer_bits);
 
-    ring_buffers = spin1_malloc(ring_buffer_size * sizeof(uint16_t));
+    ring_buffers = spin1_malloc(ring_buffer_size * sizeof(ring_buffer_t));
     if (ring_buffers == NULL) {
         log_error("Could not allocate %u entries for ring buffers",
                 ring_buffer_size);
@@ -224,16 +349,28 @@ void local_only_clear_input(uint32_t time) {
     p_per_ts_struct.time = time;
     recording_record(p_per_ts_region, &p_per_ts_struct, sizeof(p_per_ts_struct));
     n_spikes_received = 0;
-    uint32_t n_spikes_left = circular_buffer_size(input_buffer);
+    uint32_t n_spikes_left = circular_buffer_size(input_buffer) >> 1;
     n_spikes_dropped += n_spikes_left;
     if (config.clear_input_buffer) {
         circular_buffer_clear(input_buffer);
     }
 }
 
+void local_only_process_pending(void) {
+#if LOCAL_ONLY_DEDUPLICATE
+    for (uint32_t i = 0; i < n_pending_active; i++) {
+        pending_spike *p = &pending[pending_active[i]];
+        process_spike(pending_time, p->key, p->count);
+        p->count = 0;
+    }
+    n_pending_active = 0;
+#endif
+}
+
 void local_only_store_provenance(struct local_only_provenance *prov) {
     prov->max_spikes_received_per_timestep = max_spikes_received;
     prov->n_spikes_dropped = n_spikes_dropped;
-    prov->n_spikes_lost_from_input = circular_buffer_get_n_buffer_overflows(input_buffer);
+    prov->n_spikes_lost_from_input = n_spikes_lost_from_input;
     prov->max_input_buffer_size = max_input_buffer_size;
+    prov->n_spikes_merged = n_spikes_merged;
 }
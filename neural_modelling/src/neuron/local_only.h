@@ -20,6 +20,7 @@
 #define __LOCAL_ONLY_H__
 
 #include <common/neuron-typedefs.h>
+#include "synapse_row.h"
 
 //: Provenance data for local-only processing
 struct local_only_provenance {
@@ -31,6 +32,8 @@ struct local_only_provenance {
     uint32_t n_spikes_lost_from_input;
     //! The maximum size of the spike input queue at any time
     uint32_t max_input_buffer_size;
+    //! The number of spikes merged with others of the same key in a time step
+    uint32_t n_spikes_merged;
 };
 
 /**
@@ -44,7 +47,7 @@ struct local_only_provenance {
  * \return Whether the set up was done or not
  */
 bool local_only_initialise(void *local_only_addr, void *local_only_params_addr,
-        uint32_t n_rec_regions_used, uint16_t **ring_buffers);
+        uint32_t n_rec_regions_used, ring_buffer_t **ring_buffers);
 
 /**
  * \brief Clear the spikes for the last time step
@@ -52,6 +55,14 @@ bool local_only_initialise(void *local_only_addr, void *local_only_params_addr,
  */
 void local_only_clear_input(uint32_t time);
 
+/**
+ * \brief Process the spikes of the last time step that were merged by key;
+ *        this must be called after local_only_clear_input() and before
+ *        the ring buffers of the new time step are used.  It does nothing
+ *        unless the spikes are being merged.
+ */
+void local_only_process_pending(void);
+
 /**
  * \brief Store provenance gathered during run.
  * \param[out] prov Pointer to the struct to store the provenance in
@@ -65,6 +65,32 @@ static inline uint32_t div_by_const(uint32_t i, div_const d) {
 	return (t1 + isubt1) >> d.sh2;
 }
 
+//! \brief The largest number of repeats of a spike to scale a weight by; any
+//!     non-zero weight scaled by this saturates a ring buffer anyway
+#define LC_MAX_SPIKE_COUNT 0xFFFF
+
+//! \brief Limit the number of repeats of a spike so that scaled weights
+//!     can't overflow
+//! \param[in] count The number of times the spike was received
+//! \return The number of times to scale the weights by
+static inline uint32_t lc_limit_count(uint32_t count) {
+	if (count > LC_MAX_SPIKE_COUNT) {
+		return LC_MAX_SPIKE_COUNT;
+	}
+	return count;
+}
+
+//! \brief Add a weight, scaled by the number of repeats of a spike, to a
+//!     ring buffer, avoiding saturation
+//! \param[in,out] ring_buffers The ring buffers
+//! \param[in] rb_index The index of the ring buffer to add to
+//! \param[in] weight The magnitude of the weight to add
+//! \param[in] count The number of repeats, from lc_limit_count()
+static inline void lc_add_weight(ring_buffer_t *ring_buffers,
+		uint32_t rb_index, uint32_t weight, uint32_t count) {
+	synapse_row_ring_buffer_add(&ring_buffers[rb_index], weight * count);
+}
+
 static inline uint32_t get_core_id(uint32_t spike, key_info k_info) {
 	return ((spike >> k_info.mask_shift) & k_info.core_mask);
 }
@@ -94,7 +94,9 @@ static conv_config *config;
 
 static connector *connectors;
 
-static lc_weight_t *weights;
+//! \brief The weights of the kernel of each connector; these are in DTCM
+//!     where there is space, and are otherwise read from SDRAM
+static lc_weight_t **connector_weights;
 
 static inline void log_div_const(const char *name, div_const d) {
 	log_debug("    %s=(m: %u, sh1: %u, sh2: %u)", name, d.m, d.sh1, d.sh2);
@@ -139,14 +141,44 @@ bool local_only_impl_initialise(void *address){
     // The weights come after the connectors in SDRAM
     lc_weight_t *kernel_weights =
     		(lc_weight_t *) &(sdram_connectors[config->n_connectors_total]);
-    uint32_t n_weight_bytes = sizeof(lc_weight_t) * config->n_weights_total;
-    weights = spin1_malloc(n_weight_bytes);
-    if (weights == NULL) {
-    	log_error("Can't allocate %u bytes of memory for %u weights!",
-    			n_weight_bytes, config->n_weights_total);
+    connector_weights = spin1_malloc(
+    		sizeof(lc_weight_t *) * config->n_connectors_total);
+    if (connector_weights == NULL) {
+    	log_error("Can't allocate memory for %u connector weights!",
+    			config->n_connectors_total);
     	return false;
     }
-    spin1_memcpy(weights, kernel_weights, n_weight_bytes);
+
+    // Copy each kernel into DTCM while there is space, sharing the copies
+    // between connectors that use the same kernel; the rest are left in SDRAM
+    uint32_t n_kernels_in_sdram = 0;
+    for (uint32_t i = 0; i < config->n_connectors_total; i++) {
+    	connector *conn = &(connectors[i]);
+    	connector_weights[i] = NULL;
+    	for (uint32_t j = 0; j < i; j++) {
+    		if (connectors[j].kernel_index == conn->kernel_index) {
+    			connector_weights[i] = connector_weights[j];
+    			break;
+    		}
+    	}
+    	if (connector_weights[i] != NULL) {
+    		continue;
+    	}
+    	lc_weight_t *sdram_kernel = &kernel_weights[conn->kernel_index];
+    	uint32_t n_kernel_bytes = sizeof(lc_weight_t) *
+    			conn->kernel.width * conn->kernel.height;
+    	connector_weights[i] = spin1_malloc(n_kernel_bytes);
+    	if (connector_weights[i] == NULL) {
+    		connector_weights[i] = sdram_kernel;
+    		n_kernels_in_sdram++;
+    	} else {
+    		spin1_memcpy(connector_weights[i], sdram_kernel, n_kernel_bytes);
+    	}
+    }
+    if (n_kernels_in_sdram > 0) {
+    	log_warning("%u kernels didn't fit in DTCM and will be read from SDRAM",
+    			n_kernels_in_sdram);
+    }
 
     // Print what we have
     for (uint32_t i = 0; i < config->n_sources; i++) {
@@ -196,63 +228,79 @@ static inline lc_coord_t map_pre_to_post(connector *connector, lc_coord_t pre,
 
 //! \brief Given a pre-synaptic coordinate we obtain which post-synaptic
 //!        coordinates will be affected (i.e. which of them are 'reached' by
-//!        the kernel).
+//!        the kernel).  The weights are scaled by the number of times the
+//!        spike was received.
+//!
+//! The kernel is clipped to the post-synaptic neurons of this core once, and
+//! then each row of the kernel that is left is added to a run of ring buffers,
+//! as the neurons of a row of the post-synaptic shape are next to each other.
 static inline void do_convolution_operation(
         uint32_t time, lc_coord_t pre_coord, connector *connector,
-        uint16_t *ring_buffers) {
+        const lc_weight_t *weights, uint32_t count,
+        ring_buffer_t *ring_buffers) {
     int32_t half_kh = connector->kernel.height / 2;
     int32_t half_kw = connector->kernel.width / 2;
     lc_coord_t post_coord = map_pre_to_post(connector, pre_coord, half_kh, half_kw);
     log_debug("pre row %d, col %d AS post row %d, col %d",
             pre_coord.row, pre_coord.col, post_coord.row, post_coord.col);
-    lc_weight_t *connector_weights = &weights[connector->kernel_index];
-    uint32_t sat_flag = 0xFFFF0000;
-    uint32_t sat_value = 0xFFFF;
 
-    int32_t kw = connector->kernel.width;
-    for (int32_t r = -half_kh, kr = 0; r <= half_kh; r++, kr++) {
-        int32_t tmp_row = post_coord.row + r;
-        if ((tmp_row < config->post_start.row) || (tmp_row > config->post_end.row)) {
-            continue;
-        }
-        for (int32_t c = -half_kw, kc = 0; c <= half_kw; c++, kc++) {
-            int32_t tmp_col = post_coord.col + c;
-            if ((tmp_col < config->post_start.col) || (tmp_col > config->post_end.col)) {
-                continue;
-            }
+    // Clip the window of the kernel to the post-synaptic neurons
+    int32_t row_start = post_coord.row - half_kh;
+    int32_t row_end = post_coord.row + half_kh;
+    int32_t col_start = post_coord.col - half_kw;
+    int32_t col_end = post_coord.col + half_kw;
+    if (row_start < config->post_start.row) {
+        row_start = config->post_start.row;
+    }
+    if (row_end > config->post_end.row) {
+        row_end = config->post_end.row;
+    }
+    if (col_start < config->post_start.col) {
+        col_start = config->post_start.col;
+    }
+    if (col_end > config->post_end.col) {
+        col_end = config->post_end.col;
+    }
+    if ((row_start > row_end) || (col_start > col_end)) {
+        return;
+    }
+
+    // The ring buffers for the first post-neuron of the core
+    uint32_t positive_base = synapse_row_get_ring_buffer_index(
+            time + connector->delay, connector->positive_synapse_type, 0,
+            synapse_type_index_bits, synapse_index_bits, synapse_delay_mask);
+    uint32_t negative_base = synapse_row_get_ring_buffer_index(
+            time + connector->delay, connector->negative_synapse_type, 0,
+            synapse_type_index_bits, synapse_index_bits, synapse_delay_mask);
 
-            // This the neuron id relative to the neurons on this core
-            uint32_t post_index =
-                ((tmp_row - config->post_start.row) * config->post_shape.width)
-                    + (tmp_col - config->post_start.col);
-            uint32_t k = (kr * kw) + kc;
-            lc_weight_t weight = connector_weights[k];
+    int32_t kw = connector->kernel.width;
+    uint32_t n_cols = col_end - col_start + 1;
+    for (int32_t tmp_row = row_start; tmp_row <= row_end; tmp_row++) {
+        int32_t kr = tmp_row - (post_coord.row - half_kh);
+        int32_t kc = col_start - (post_coord.col - half_kw);
+        const lc_weight_t *row_weights = &weights[(kr * kw) + kc];
+
+        // This the neuron id relative to the neurons on this core
+        uint32_t post_index =
+            ((tmp_row - config->post_start.row) * config->post_shape.width)
+                + (col_start - config->post_start.col);
+        ring_buffer_t *positive_row = &ring_buffers[positive_base + post_index];
+        ring_buffer_t *negative_row = &ring_buffers[negative_base + post_index];
+
+        for (uint32_t c = 0; c < n_cols; c++) {
+            lc_weight_t weight = row_weights[c];
             if (weight == 0) {
                 continue;
             }
-            uint32_t rb_index = 0;
-            if (weight > 0) {
-                rb_index = synapse_row_get_ring_buffer_index(time + connector->delay,
-                    connector->positive_synapse_type, post_index,
-                    synapse_type_index_bits, synapse_index_bits,
-                    synapse_delay_mask);
-            } else {
-                rb_index = synapse_row_get_ring_buffer_index(time + connector->delay,
-                    connector->negative_synapse_type, post_index,
-                    synapse_type_index_bits, synapse_index_bits,
-                    synapse_delay_mask);
-                weight = -weight;
-            }
-            log_debug("Updating ring_buffers[%u] for post neuron %u = %u, %u, with weight %u",
-                    rb_index, post_index, tmp_col, tmp_row, weight);
+            log_debug("Updating ring buffers for post neuron %u = %u, %u, with weight %d x %u",
+                    post_index + c, col_start + c, tmp_row, weight, count);
 
             // Add weight to current ring buffer value, avoiding saturation
-            uint32_t accumulation = ring_buffers[rb_index] + weight;
-            uint32_t sat_test = accumulation & sat_flag;
-            if (sat_test) {
-                accumulation = sat_value;
+            if (weight > 0) {
+                lc_add_weight(positive_row, c, weight, count);
+            } else {
+                lc_add_weight(negative_row, c, -weight, count);
             }
-            ring_buffers[rb_index] = accumulation;
         }
     }
 }
@@ -293,7 +341,8 @@ static inline bool key_to_index_lookup(uint32_t spike, source_info **rs_info) {
 //!    combination.
 //! 4. Add the weights to the appropriate current buffers
 void local_only_impl_process_spike(
-        uint32_t time, uint32_t spike, uint16_t* ring_buffers) {
+        uint32_t time, uint32_t spike, uint32_t count,
+        ring_buffer_t* ring_buffers) {
 
     // Lookup the spike, and if found, get the appropriate parts
     source_info *s_info;
@@ -324,6 +373,7 @@ void local_only_impl_process_spike(
     }
     uint32_t local_id = get_local_id(spike, s_info->key_info);
     uint32_t neurons_per_core = source_width * source_height;
+    count = lc_limit_count(count);
 
     log_debug("Spike %x, on core %u (%u, %u), is last (%u, %u), local %u",
     		spike, core_id, core_col, core_row, last_core_on_row, last_core_in_col,
@@ -358,6 +408,7 @@ void local_only_impl_process_spike(
     			local_col, local_row, pre_coord.col, pre_coord.col);
 
 		// Compute the convolution
-		do_convolution_operation(time, pre_coord, connector, ring_buffers);
+		do_convolution_operation(time, pre_coord, connector,
+		        connector_weights[i], count, ring_buffers);
     }
 }
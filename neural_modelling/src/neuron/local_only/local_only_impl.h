@@ -20,6 +20,7 @@
 #define _LOCAL_ONLY_H_
 
 #include <common/neuron-typedefs.h>
+#include "../synapse_row.h"
 
 extern uint32_t synapse_delay_mask;
 
@@ -32,7 +33,11 @@ extern uint32_t synapse_index_bits;
 bool local_only_impl_initialise(void *address);
 
 //! \brief Process a spike received
+//! \param[in] time The time of the spike
+//! \param[in] spike The key of the spike
+//! \param[in] count The number of times the spike was received
+//! \param[in] ring_buffers The ring buffers to add the weights to
 void local_only_impl_process_spike(uint32_t time, uint32_t spike,
-        uint16_t* ring_buffers);
+        uint32_t count, ring_buffer_t* ring_buffers);
 
 #endif
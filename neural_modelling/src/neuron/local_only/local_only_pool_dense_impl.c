@@ -61,7 +61,7 @@ typedef struct {
     uint16_t delay_stage;
     uint16_t delay;
     div_const pool_stride_div[];
-    // Also follows:
+    // Also follows in SDRAM, and in DTCM if they are not split into planes:
     // lc_weight_t weights[];
 } connector;
 
@@ -83,10 +83,95 @@ static source_info **source_infos;
 // The per-connection data
 static connector** connectors;
 
+//! \brief The weights of a connector, split by sign so that each weight of a
+//!     row goes into the ring buffer of the same synapse type and delay at
+//!     the position of its post-neuron
+typedef struct {
+    //! \brief The signed weights, if they could not be split; if not NULL,
+    //!     this points to the weights in the connector
+    lc_weight_t *weights;
+    //! The positive weights, or NULL if there are none
+    uint16_t *positive;
+    //! The magnitudes of the negative weights, or NULL if there are none
+    uint16_t *negative;
+} weight_planes;
+
+//! The weights of each connector
+static weight_planes *planes;
+
+//! \brief The number of weights between the rows of a weight plane; this is
+//!     even so that each row starts on a word
+static uint32_t plane_row_stride;
+
+//! A word holding two adjacent ring buffer entries or weights
+typedef uint32_t __attribute__((__may_alias__)) packed_weights_t;
+
 static inline lc_weight_t *get_weights(connector *conn) {
     return (lc_weight_t *) &(conn->pool_stride_div[conn->n_dims]);
 }
 
+//! \brief Make one of the weight planes of a connector
+//! \param[in] weights: The signed weights of the connector
+//! \param[in] n_weights: The number of weights
+//! \param[in] sign: 1 to make the positive plane, -1 for the negative one
+//! \return The plane, or NULL if it couldn't be allocated
+static uint16_t *make_weight_plane(
+        lc_weight_t *weights, uint32_t n_weights, int32_t sign) {
+    uint32_t n_rows = n_weights / config->n_post;
+    uint16_t *plane = spin1_malloc(
+            n_rows * plane_row_stride * sizeof(uint16_t));
+    if (plane == NULL) {
+        return NULL;
+    }
+    for (uint32_t r = 0; r < n_rows; r++) {
+        uint16_t *plane_row = &plane[r * plane_row_stride];
+        lc_weight_t *row = &weights[r * config->n_post];
+        for (uint32_t p = 0; p < plane_row_stride; p++) {
+            int32_t weight = 0;
+            if (p < config->n_post) {
+                weight = row[p] * sign;
+            }
+            plane_row[p] = (weight > 0) ? weight : 0;
+        }
+    }
+    return plane;
+}
+
+//! \brief Split the weights of a connector by sign
+//! \param[in] weights: The signed weights of the connector
+//! \param[in] n_weights: The number of weights
+//! \param[out] conn_planes: Where to put the split weights
+//! \return Whether there was space to split the weights
+static bool make_weight_planes(lc_weight_t *weights, uint32_t n_weights,
+        weight_planes *conn_planes) {
+    bool any_positive = false;
+    bool any_negative = false;
+    for (uint32_t i = 0; i < n_weights; i++) {
+        any_positive |= weights[i] > 0;
+        any_negative |= weights[i] < 0;
+    }
+    conn_planes->weights = NULL;
+    conn_planes->positive = NULL;
+    conn_planes->negative = NULL;
+    if (any_positive) {
+        conn_planes->positive = make_weight_plane(weights, n_weights, 1);
+        if (conn_planes->positive == NULL) {
+            return false;
+        }
+    }
+    if (any_negative) {
+        conn_planes->negative = make_weight_plane(weights, n_weights, -1);
+        if (conn_planes->negative == NULL) {
+            if (conn_planes->positive != NULL) {
+                sark_free(conn_planes->positive);
+                conn_planes->positive = NULL;
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
 //! \brief Load the required data into DTCM.
 bool local_only_impl_initialise(void *address){
     log_info("+++++++++++++++++ CONV init ++++++++++++++++++++");
@@ -120,6 +205,12 @@ bool local_only_impl_initialise(void *address){
         log_error("Can't allocate memory for connectors");
         return false;
     }
+    planes = spin1_malloc(config->n_connectors * sizeof(planes[0]));
+    if (planes == NULL) {
+        log_error("Can't allocate memory for weight planes");
+        return false;
+    }
+    plane_row_stride = (config->n_post + 1) & ~0x1;
 
     // The first source comes after the configuration in SDRAM
     source_info *s_info = (source_info *) &sdram_config[1];
@@ -139,8 +230,17 @@ bool local_only_impl_initialise(void *address){
     connector *conn = (connector *) s_info;
     for (uint32_t i = 0; i < config->n_connectors; i++) {
 
-        uint32_t n_bytes = sizeof(*conn) + (conn->n_weights * sizeof(lc_weight_t)) +
-                (conn->n_dims * sizeof(div_const));
+        // Split the weights if possible, in which case the signed weights
+        // don't need to be copied; if there isn't the space for this, use
+        // the signed weights as they are
+        uint32_t n_bytes = sizeof(*conn) + (conn->n_dims * sizeof(div_const));
+        bool split = make_weight_planes(
+                get_weights(conn), conn->n_weights, &planes[i]);
+        if (!split) {
+            log_warning("Not enough space to split the weights of "
+                    "connector %u", i);
+            n_bytes += conn->n_weights * sizeof(lc_weight_t);
+        }
 
         // Copy the data from SDRAM
         connectors[i] = spin1_malloc(n_bytes);
@@ -149,6 +249,9 @@ bool local_only_impl_initialise(void *address){
             return false;
         }
         spin1_memcpy(connectors[i], conn, n_bytes);
+        if (!split) {
+            planes[i].weights = get_weights(connectors[i]);
+        }
 
         // Move to the next connector; because it is dynamically sized,
         // this comes after the last weight in the last connector, which comes
@@ -199,7 +302,7 @@ static inline bool key_to_index_lookup(uint32_t spike, source_info **rs_info) {
 
 static bool get_conn_weights(connector *c, source_info *s_info, uint32_t local_id,
 		uint32_t *sizes, uint32_t *core_coords, div_const *divs,
-		uint32_t neurons_per_core, lc_weight_t **weights) {
+		uint32_t neurons_per_core, uint32_t *row) {
 
 	// Stop if the delay means it is out of range
 	uint32_t first_neuron = c->delay_stage * neurons_per_core;
@@ -231,11 +334,78 @@ static bool get_conn_weights(connector *c, source_info *s_info, uint32_t local_i
 		last_extent = ((s_dim->cores - 1) * s_dim->size_per_core) + s_dim->size_last_core;
 		last_extent = div_by_const(last_extent, stride_div);
 	}
-	lc_weight_t *all_weights = get_weights(c);
-	*weights = &all_weights[index * config->n_post];
+	*row = index;
 	return true;
 }
 
+//! \brief Add a row of a weight plane to the ring buffers of a synapse type
+//!     and delay
+//! \param[in,out] ring_buffers: The ring buffers, from the one for the first
+//!     post-neuron
+//! \param[in] weights: The row of the weight plane
+//! \param[in] count: The number of times to add the weights
+static inline void add_weight_plane(ring_buffer_t *ring_buffers,
+		const uint16_t *weights, uint32_t count) {
+	uint32_t n_post = config->n_post;
+
+	// Two at a time if the ring buffers start on a word like the weights do,
+	// which they do unless there is only one post-neuron; 32-bit ring buffer
+	// entries don't pair up with the weights
+	if (!RING_BUFFER_32_BIT && count == 1 &&
+			!(((uintptr_t) ring_buffers) & 0x2)) {
+		packed_weights_t *pair = (packed_weights_t *) ring_buffers;
+		const packed_weights_t *packed = (const packed_weights_t *) weights;
+		for (uint32_t n = n_post >> 1; n > 0; n--) {
+			*pair = synapse_row_packed_add_saturate(*pair, *packed++, NULL);
+			pair++;
+		}
+		if (n_post & 0x1) {
+			lc_add_weight(ring_buffers, n_post - 1, weights[n_post - 1], 1);
+		}
+		return;
+	}
+
+	for (uint32_t post_index = 0; post_index < n_post; post_index++) {
+		lc_add_weight(ring_buffers, post_index, weights[post_index], count);
+	}
+}
+
+//! \brief Add a row of signed weights to the ring buffers
+//! \param[in] time: The time of the spike
+//! \param[in] connector: The connector the weights are from
+//! \param[in] weights: The row of signed weights
+//! \param[in] count: The number of times to add the weights
+//! \param[in,out] ring_buffers: The ring buffers
+static inline void add_signed_weights(uint32_t time, connector *connector,
+		const lc_weight_t *weights, uint32_t count,
+		ring_buffer_t *ring_buffers) {
+	for (uint32_t post_index = 0; post_index < config->n_post; post_index++) {
+
+		lc_weight_t weight = weights[post_index];
+		if (weight == 0) {
+			continue;
+		}
+		uint32_t rb_index = 0;
+		if (weight > 0) {
+			rb_index = synapse_row_get_ring_buffer_index(time + connector->delay,
+				connector->positive_synapse_type, post_index,
+				synapse_type_index_bits, synapse_index_bits,
+				synapse_delay_mask);
+		} else {
+			rb_index = synapse_row_get_ring_buffer_index(time + connector->delay,
+				connector->negative_synapse_type, post_index,
+				synapse_type_index_bits, synapse_index_bits,
+				synapse_delay_mask);
+			weight = -weight;
+		}
+		log_debug("Updating ring_buffers[%u] for post neuron %u with weight %u x %u",
+				rb_index, post_index, weight, count);
+
+		// Add weight to current ring buffer value, avoiding saturation
+		lc_add_weight(ring_buffers, rb_index, weight, count);
+	}
+}
+
 //! \brief Process incoming spikes. In this implementation we need to:
 //! 1. Check if it's in the population table
 //! 2. Convert the relative (per core) Id to a global (per population) one
@@ -243,7 +413,8 @@ static bool get_conn_weights(connector *c, source_info *s_info, uint32_t local_i
 //!    combination.
 //! 4. Add the weights to the appropriate current buffers
 void local_only_impl_process_spike(
-        uint32_t time, uint32_t spike, uint16_t* ring_buffers) {
+        uint32_t time, uint32_t spike, uint32_t count,
+        ring_buffer_t* ring_buffers) {
 
     // Lookup the spike, and if found, get the appropriate parts
     source_info *s_info;
@@ -277,45 +448,44 @@ void local_only_impl_process_spike(
 		}
     }
 
-    // Go through the weights and process them into the ring buffers
+    // Go through the weights and process them into the ring buffers, scaled
+    // by the number of times the spike was received
+    count = lc_limit_count(count);
     uint32_t end = s_info->key_info.start + s_info->key_info.count;
     for (uint32_t i = s_info->key_info.start; i < end; i++) {
 	    connector *connector = connectors[i];
-	    lc_weight_t *weights;
+	    uint32_t row;
 	    if (!get_conn_weights(connector, s_info, local_id, sizes, core_coords,
-	    		divs, neurons_per_core, &weights)) {
+	    		divs, neurons_per_core, &row)) {
 	    	continue;
 	    }
 
-		for (uint32_t post_index = 0; post_index < config->n_post; post_index++) {
+	    weight_planes *conn_planes = &planes[i];
+	    if (conn_planes->weights != NULL) {
+	    	add_signed_weights(time, connector,
+	    			&conn_planes->weights[row * config->n_post], count,
+					ring_buffers);
+	    	continue;
+	    }
 
-			lc_weight_t weight = weights[post_index];
-			if (weight == 0) {
-				continue;
-			}
-			uint32_t rb_index = 0;
-			if (weight > 0) {
-				rb_index = synapse_row_get_ring_buffer_index(time + connector->delay,
-					connector->positive_synapse_type, post_index,
+	    // The ring buffers of each synapse type follow on from each other in
+	    // order of post-neuron, so each row is added to a block of them
+	    uint32_t row_offset = row * plane_row_stride;
+	    if (conn_planes->positive != NULL) {
+	    	uint32_t rb_index = synapse_row_get_ring_buffer_index(
+	    			time + connector->delay, connector->positive_synapse_type, 0,
 					synapse_type_index_bits, synapse_index_bits,
 					synapse_delay_mask);
-			} else {
-				rb_index = synapse_row_get_ring_buffer_index(time + connector->delay,
-					connector->negative_synapse_type, post_index,
+	    	add_weight_plane(&ring_buffers[rb_index],
+	    			&conn_planes->positive[row_offset], count);
+	    }
+	    if (conn_planes->negative != NULL) {
+	    	uint32_t rb_index = synapse_row_get_ring_buffer_index(
+	    			time + connector->delay, connector->negative_synapse_type, 0,
 					synapse_type_index_bits, synapse_index_bits,
 					synapse_delay_mask);
-				weight = -weight;
-			}
-			log_debug("Updating ring_buffers[%u] for post neuron %u with weight %u",
-					rb_index, post_index, weight);
-
-			// Add weight to current ring buffer value, avoiding saturation
-			uint32_t accumulation = ring_buffers[rb_index] + weight;
-			uint32_t sat_test = accumulation & 0x10000;
-			if (sat_test) {
-				accumulation = sat_test - 1;
-			}
-			ring_buffers[rb_index] = accumulation;
-		}
+	    	add_weight_plane(&ring_buffers[rb_index],
+	    			&conn_planes->negative[row_offset], count);
+	    }
     }
 }
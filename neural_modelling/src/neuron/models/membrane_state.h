@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2024 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//! \file
+//! \brief How neuron models hold their membrane state
+//!
+//! The membrane state is normally held as ::REAL (s16.15).  It can instead be
+//! held in 16 bits as s8.7, from -256 to just under 256 with a resolution of
+//! 1/128, which is enough for membrane voltages in mV.  The state is still
+//! worked out in ::REAL, and saturates when it is stored.
+#ifndef _MEMBRANE_STATE_H_
+#define _MEMBRANE_STATE_H_
+
+#include <common/neuron-typedefs.h>
+
+#ifndef NEURON_SHORT_STATE
+//! \brief Whether neuron models hold their membrane state in 16 bits rather
+//!     than 32.  This can be set per binary at build time.
+#define NEURON_SHORT_STATE 0
+#endif
+
+#if NEURON_SHORT_STATE
+//! Membrane state held as s8.7
+typedef int16_t membrane_state_t;
+
+//! The number of fractional bits that ::REAL has beyond s8.7
+#define MEMBRANE_STATE_SHIFT 8
+
+//! \brief Get a membrane state to work with
+//! \param[in] value: The state as held
+//! \return The state as ::REAL
+static inline REAL membrane_load(membrane_state_t value) {
+    return kbits(((int32_t) value) << MEMBRANE_STATE_SHIFT);
+}
+
+//! \brief Get a membrane state to hold, rounded to the nearest and saturated
+//! \param[in] value: The state as ::REAL
+//! \return The state to hold
+static inline membrane_state_t membrane_store(REAL value) {
+    // Rounded in two shifts to stay clear of overflow
+    int32_t bits = ((bitsk(value) >> (MEMBRANE_STATE_SHIFT - 1)) + 1) >> 1;
+    if (bits > INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (bits < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (membrane_state_t) bits;
+}
+
+//! \brief Determine if a value can be held as membrane state without
+//!     saturating
+//! \param[in] value: The value to check
+//! \return Whether the value is in range
+static inline bool membrane_in_range(REAL value) {
+    int32_t bits = bitsk(value) >> MEMBRANE_STATE_SHIFT;
+    return bits >= INT16_MIN && bits <= INT16_MAX;
+}
+#else
+//! Membrane state held as ::REAL
+typedef REAL membrane_state_t;
+
+//! \brief Get a membrane state to work with
+//! \param[in] value: The state as held
+//! \return The state as ::REAL
+static inline REAL membrane_load(membrane_state_t value) {
+    return value;
+}
+
+//! \brief Get a membrane state to hold
+//! \param[in] value: The state as ::REAL
+//! \return The state to hold
+static inline membrane_state_t membrane_store(REAL value) {
+    return value;
+}
+
+//! \brief Determine if a value can be held as membrane state
+//! \param[in] value: The value to check
+//! \return Always true
+static inline bool membrane_in_range(UNUSED REAL value) {
+    return true;
+}
+#endif // NEURON_SHORT_STATE
+
+#endif // _MEMBRANE_STATE_H_
@@ -20,6 +20,7 @@
 #define _NEURON_MODEL_IZH_CURR_IMPL_H_
 
 #include "neuron_model.h"
+#include "membrane_state.h"
 
 //! The state parameters of an Izhekevich model neuron
 struct neuron_params_t {
@@ -52,8 +53,8 @@ struct neuron_t {
     REAL D;
 
     // Variable-state parameters
-    REAL V;
-    REAL U;
+    membrane_state_t V;
+    membrane_state_t U;
 
     //! offset current [nA]
     REAL I_offset;
@@ -71,8 +72,12 @@ static inline void neuron_model_initialise(neuron_t *state, neuron_params_t *par
     state->B = params->B;
 	state->C = params->C;
 	state->D = params->D;
-	state->V = params->V;
-	state->U = params->U;
+	if (!membrane_in_range(params->V) || !membrane_in_range(params->U)) {
+	    log_warning("Membrane state %k or %k out of range",
+	            params->V, params->U);
+	}
+	state->V = membrane_store(params->V);
+	state->U = membrane_store(params->U);
 	state->I_offset = params->I_offset;
 	state->this_h = params->next_h;
 	state->reset_h = kdivui(params->time_step, n_steps_per_timestep);
@@ -80,8 +85,8 @@ static inline void neuron_model_initialise(neuron_t *state, neuron_params_t *par
 
 static inline void neuron_model_save_state(neuron_t *state, neuron_params_t *params) {
 	params->next_h = state->this_h;
-	params->V = state->V;
-	params->U = state->U;
+	params->V = membrane_load(state->V);
+	params->U = membrane_load(state->U);
 }
 
 /*! \brief For linear membrane voltages, 1.5 is the correct value. However
@@ -129,8 +134,8 @@ static const REAL MAGIC_MULTIPLIER = REAL_CONST(0.040008544921875);
 static inline void rk2_kernel_midpoint(
         REAL h, neuron_t *neuron, REAL input_this_timestep) {
     // to match Mathematica names
-    REAL lastV1 = neuron->V;
-    REAL lastU1 = neuron->U;
+    REAL lastV1 = membrane_load(neuron->V);
+    REAL lastU1 = membrane_load(neuron->U);
     REAL a = neuron->A;
     REAL b = neuron->B;
 
@@ -142,12 +147,64 @@ static inline void rk2_kernel_midpoint(
     // could be represented as a long fract?
     REAL beta = REAL_HALF(h * (b * lastV1 - lastU1) * a);
 
-    neuron->V += h * (pre_alph - beta
-            + (REAL_CONST(5.0) + MAGIC_MULTIPLIER * eta) * eta);
+    neuron->V = membrane_store(lastV1 + h * (pre_alph - beta
+            + (REAL_CONST(5.0) + MAGIC_MULTIPLIER * eta) * eta));
 
-    neuron->U += a * h * (-lastU1 - beta + b * eta);
+    neuron->U = membrane_store(lastU1 + a * h * (-lastU1 - beta + b * eta));
 }
 
+#ifndef NEURON_IZH_ADAPTIVE_STEP
+//! \brief Whether to take one Euler step well below the spike upstroke, and
+//!     midpoint sub-steps only near it.  This can be set per binary at build
+//!     time.
+#define NEURON_IZH_ADAPTIVE_STEP 0
+#endif
+
+#if NEURON_IZH_ADAPTIVE_STEP
+//! \brief The voltage below which a single Euler step is accurate enough.
+//!     With the usual parameters the upstroke starts at the unstable fixed
+//!     point, which is above this.
+static const REAL IZH_EULER_LIMIT = REAL_CONST(-55.0);
+
+//! The log2 of the number of midpoint sub-steps taken near the upstroke
+#define IZH_SUB_STEP_SHIFT 2
+
+//! \brief The voltage past which no more sub-steps are taken, as the neuron
+//!     will spike anyway; this stops the quadratic term overflowing
+static const REAL IZH_PEAK = REAL_CONST(30.0);
+
+/*!
+ * \brief Takes a cheap Euler step when the neuron stays well below the
+ *      upstroke, and otherwise midpoint sub-steps through it
+ * \param[in] h: The time step
+ * \param[in,out] neuron: The model being updated
+ * \param[in] input_this_timestep: the input
+ */
+static inline void adaptive_kernel(
+        REAL h, neuron_t *neuron, REAL input_this_timestep) {
+    REAL lastV1 = membrane_load(neuron->V);
+    REAL lastU1 = membrane_load(neuron->U);
+
+    REAL dV = REAL_CONST(140.0) + input_this_timestep - lastU1
+            + (REAL_CONST(5.0) + MAGIC_MULTIPLIER * lastV1) * lastV1;
+    REAL nextV = lastV1 + h * dV;
+    if (lastV1 < IZH_EULER_LIMIT && nextV < IZH_EULER_LIMIT) {
+        neuron->V = membrane_store(nextV);
+        neuron->U = membrane_store(
+                lastU1 + h * neuron->A * (neuron->B * lastV1 - lastU1));
+        return;
+    }
+
+    REAL sub_h = kbits(bitsk(h) >> IZH_SUB_STEP_SHIFT);
+    for (uint32_t i = 1 << IZH_SUB_STEP_SHIFT; i > 0; i--) {
+        rk2_kernel_midpoint(sub_h, neuron, input_this_timestep);
+        if (membrane_load(neuron->V) >= IZH_PEAK) {
+            break;
+        }
+    }
+}
+#endif
+
 //! \brief primary function called in timer loop after synaptic updates
 //! \param[in] num_excitatory_inputs: Number of excitatory receptor types.
 //! \param[in] exc_input: Pointer to array of inputs per receptor type received
@@ -180,11 +237,15 @@ static inline state_t neuron_model_state_update(
     input_t input_this_timestep = total_exc - total_inh
             + external_bias + neuron->I_offset + current_offset;
 
+#if NEURON_IZH_ADAPTIVE_STEP
+    adaptive_kernel(neuron->this_h, neuron, input_this_timestep);
+#else
     // the best AR update so far
     rk2_kernel_midpoint(neuron->this_h, neuron, input_this_timestep);
+#endif
     neuron->this_h = neuron->reset_h;
 
-    return neuron->V;
+    return membrane_load(neuron->V);
 }
 
 //! \brief Indicates that the neuron has spiked
@@ -192,10 +253,10 @@ static inline state_t neuron_model_state_update(
 //!     all the parameters for a specific neuron
 static inline void neuron_model_has_spiked(neuron_t *restrict neuron) {
     // reset membrane voltage
-    neuron->V = neuron->C;
+    neuron->V = membrane_store(neuron->C);
 
     // offset 2nd state variable
-    neuron->U += neuron->D;
+    neuron->U = membrane_store(membrane_load(neuron->U) + neuron->D);
 
     // simple threshold correction - next timestep (only) gets a bump
     neuron->this_h = neuron->reset_h * SIMPLE_TQ_OFFSET;
@@ -207,12 +268,12 @@ static inline void neuron_model_has_spiked(neuron_t *restrict neuron) {
 //! \return the membrane voltage for a given neuron with the neuron
 //!     parameters specified in neuron
 static inline state_t neuron_model_get_membrane_voltage(const neuron_t *neuron) {
-    return neuron->V;
+    return membrane_load(neuron->V);
 }
 
 static inline void neuron_model_print_state_variables(const neuron_t *neuron) {
-    log_debug("V = %11.4k ", neuron->V);
-    log_debug("U = %11.4k ", neuron->U);
+    log_debug("V = %11.4k ", membrane_load(neuron->V));
+    log_debug("U = %11.4k ", membrane_load(neuron->U));
     log_debug("This h = %11.4k", neuron->this_h);
 }
 
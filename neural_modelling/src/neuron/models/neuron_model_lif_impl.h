@@ -20,6 +20,17 @@
 #define _NEURON_MODEL_LIF_CURR_IMPL_H_
 
 #include "neuron_model.h"
+#include "membrane_state.h"
+
+#ifndef NEURON_COLD_PARAMETERS
+//! \brief Whether to keep the parameters only used when a neuron spikes (the
+//!     reset voltage and refractory time) in SDRAM rather than DTCM.  This
+//!     can be set per binary at build time.
+//! \details This saves two words of DTCM per neuron, at the cost of two
+//!     SDRAM reads for each spike.  The neuron implementation must call
+//!     neuron_model_cold_initialise() before initialising the neurons.
+#define NEURON_COLD_PARAMETERS 0
+#endif
 
 //! definition for LIF neuron parameters
 struct neuron_params_t {
@@ -55,10 +66,10 @@ struct neuron_params_t {
 //! definition for LIF neuron state
 struct neuron_t {
     //! membrane voltage [mV]
-    REAL     V_membrane;
+    membrane_state_t V_membrane;
 
     //! membrane resting voltage [mV]
-    REAL     V_rest;
+    membrane_state_t V_rest;
 
     //! membrane resistance [MOhm]
     REAL     R_membrane;
@@ -74,13 +85,55 @@ struct neuron_t {
     //! countdown to end of next refractory period [timesteps]
     int32_t  refract_timer;
 
+#if !NEURON_COLD_PARAMETERS
     //! post-spike reset membrane voltage [mV]
     REAL     V_reset;
 
     //! refractory time of neuron [timesteps]
     int32_t  T_refract;
+#endif
 };
 
+#if NEURON_COLD_PARAMETERS
+//! The parameters of a LIF neuron that are only used when it spikes
+typedef struct neuron_cold_t {
+    //! post-spike reset membrane voltage [mV]
+    REAL     V_reset;
+
+    //! refractory time of neuron [timesteps]
+    int32_t  T_refract;
+} neuron_cold_t;
+
+//! The neurons that the cold parameters are for, to find their indices
+static const neuron_t *cold_neurons;
+
+//! The cold parameters of each neuron, in SDRAM
+static neuron_cold_t *cold_params;
+
+//! The neuron model has parameters that can be held away from the neurons
+#define NEURON_MODEL_HAS_COLD_PARAMETERS
+
+//! \brief Allocate the SDRAM for the cold parameters of the neurons; must be
+//!     called before the neurons are initialised
+//! \param[in] neurons: The neurons, in DTCM
+//! \param[in] n_neurons: The number of neurons
+//! \return Whether the SDRAM could be allocated
+static inline bool neuron_model_cold_initialise(
+        const neuron_t *neurons, uint32_t n_neurons) {
+    cold_neurons = neurons;
+    cold_params = sark_xalloc(sv->sdram_heap,
+            n_neurons * sizeof(neuron_cold_t), 0, ALLOC_LOCK);
+    return cold_params != NULL;
+}
+
+//! \brief Get the cold parameters of a neuron
+//! \param[in] neuron: The neuron to get the cold parameters of
+//! \return The cold parameters of the neuron
+static inline neuron_cold_t *neuron_model_cold(const neuron_t *neuron) {
+    return &cold_params[neuron - cold_neurons];
+}
+#endif // NEURON_COLD_PARAMETERS
+
 //! \brief Performs a ceil operation on an accum
 //! \param[in] value The value to ceil
 //! \return The ceil of the value
@@ -97,18 +150,29 @@ static inline int32_t lif_ceil_accum(REAL value) {
 static inline void neuron_model_initialise(
 		neuron_t *state, neuron_params_t *params, uint32_t n_steps_per_timestep) {
 	REAL ts = kdivui(params->time_step, n_steps_per_timestep);
-	state->V_membrane = params->V_init;
-	state->V_rest = params->V_rest;
+	if (!membrane_in_range(params->V_init)
+	        || !membrane_in_range(params->V_rest)) {
+	    log_warning("Membrane voltage %k or %k out of range",
+	            params->V_init, params->V_rest);
+	}
+	state->V_membrane = membrane_store(params->V_init);
+	state->V_rest = membrane_store(params->V_rest);
     state->R_membrane = kdivk(params->tau_m, params->c_m);
 	state->exp_TC = expk(-kdivk(ts, params->tau_m));
 	state->I_offset = params->I_offset;
     state->refract_timer = params->refract_timer_init;
+#if NEURON_COLD_PARAMETERS
+	neuron_cold_t *cold = neuron_model_cold(state);
+	cold->V_reset = params->V_reset;
+	cold->T_refract = lif_ceil_accum(kdivk(params->T_refract_ms, ts));
+#else
 	state->V_reset = params->V_reset;
 	state->T_refract = lif_ceil_accum(kdivk(params->T_refract_ms, ts));
+#endif
 }
 
 static inline void neuron_model_save_state(neuron_t *state, neuron_params_t *params) {
-	params->V_init = state->V_membrane;
+	params->V_init = membrane_load(state->V_membrane);
 	params->refract_timer_init = state->refract_timer;
 }
 
@@ -118,10 +182,12 @@ static inline void neuron_model_save_state(neuron_t *state, neuron_params_t *par
 //! \param[in] input_this_timestep: The input to apply
 static inline void lif_neuron_closed_form(
         neuron_t *neuron, REAL V_prev, input_t input_this_timestep) {
-    REAL alpha = input_this_timestep * neuron->R_membrane + neuron->V_rest;
+    REAL alpha = input_this_timestep * neuron->R_membrane
+            + membrane_load(neuron->V_rest);
 
     // update membrane voltage
-    neuron->V_membrane = alpha - (neuron->exp_TC * (alpha - V_prev));
+    neuron->V_membrane = membrane_store(
+            alpha - (neuron->exp_TC * (alpha - V_prev)));
 }
 
 //! \brief primary function called in timer loop after synaptic updates
@@ -160,23 +226,54 @@ static inline state_t neuron_model_state_update(
                 total_exc - total_inh + external_bias + neuron->I_offset + current_offset;
 
         lif_neuron_closed_form(
-                neuron, neuron->V_membrane, input_this_timestep);
+                neuron, membrane_load(neuron->V_membrane),
+                input_this_timestep);
     } else {
         // countdown refractory timer
         neuron->refract_timer--;
     }
-    return neuron->V_membrane;
+    return membrane_load(neuron->V_membrane);
+}
+
+//! The LIF model can be settled; see neuron_model_settle()
+#define NEURON_MODEL_CAN_SETTLE
+
+//! \brief Move the neuron to the voltage that it decays to without synaptic
+//!     input, if it is already within epsilon of it
+//! \details Once there, the closed form update leaves the voltage unchanged
+//!     until the neuron receives synaptic input.
+//! \param[in,out] neuron: The neuron to settle
+//! \param[in] epsilon: How close to the resting voltage the neuron must be
+//! \return True if the neuron has settled
+static inline bool neuron_model_settle(neuron_t *restrict neuron, REAL epsilon) {
+    if (neuron->refract_timer > 0) {
+        return false;
+    }
+    REAL V_settled = neuron->I_offset * neuron->R_membrane
+            + membrane_load(neuron->V_rest);
+    REAL V_diff = membrane_load(neuron->V_membrane) - V_settled;
+    if (REAL_COMPARE(V_diff, >, epsilon) || REAL_COMPARE(V_diff, <, -epsilon)) {
+        return false;
+    }
+    neuron->V_membrane = membrane_store(V_settled);
+    return true;
 }
 
 //! \brief Indicates that the neuron has spiked
 //! \param[in, out] neuron pointer to a neuron parameter struct which contains
 //!     all the parameters for a specific neuron
 static inline void neuron_model_has_spiked(neuron_t *restrict neuron) {
+#if NEURON_COLD_PARAMETERS
+    const neuron_cold_t *cold = neuron_model_cold(neuron);
+    neuron->V_membrane = membrane_store(cold->V_reset);
+    neuron->refract_timer = cold->T_refract;
+#else
     // reset membrane voltage
-    neuron->V_membrane = neuron->V_reset;
+    neuron->V_membrane = membrane_store(neuron->V_reset);
 
     // reset refractory timer
     neuron->refract_timer  = neuron->T_refract;
+#endif
 }
 
 //! \brief get the neuron membrane voltage for a given neuron parameter set
@@ -185,24 +282,33 @@ static inline void neuron_model_has_spiked(neuron_t *restrict neuron) {
 //! \return the membrane voltage for a given neuron with the neuron
 //!     parameters specified in neuron
 static inline state_t neuron_model_get_membrane_voltage(const neuron_t *neuron) {
-    return neuron->V_membrane;
+    return membrane_load(neuron->V_membrane);
 }
 
 static inline void neuron_model_print_state_variables(const neuron_t *neuron) {
-	log_info("V membrane    = %11.4k mv", neuron->V_membrane);
+	log_info("V membrane    = %11.4k mv", membrane_load(neuron->V_membrane));
 	log_info("Refract timer = %u timesteps", neuron->refract_timer);
 }
 
 static inline void neuron_model_print_parameters(const neuron_t *neuron) {
+#if NEURON_COLD_PARAMETERS
+    const neuron_cold_t *cold = neuron_model_cold(neuron);
+    log_info("V reset       = %11.4k mv", cold->V_reset);
+#else
     log_info("V reset       = %11.4k mv", neuron->V_reset);
-    log_info("V rest        = %11.4k mv", neuron->V_rest);
+#endif
+    log_info("V rest        = %11.4k mv", membrane_load(neuron->V_rest));
 
     log_info("I offset      = %11.4k nA", neuron->I_offset);
     log_info("R membrane    = %11.4k Mohm", neuron->R_membrane);
 
     log_info("exp(-ms/(RC)) = %11.4k [.]", neuron->exp_TC);
 
+#if NEURON_COLD_PARAMETERS
+    log_info("T refract     = %u timesteps", cold->T_refract);
+#else
     log_info("T refract     = %u timesteps", neuron->T_refract);
+#endif
 }
 
 
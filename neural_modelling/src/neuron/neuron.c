@@ -22,12 +22,22 @@
 #include "neuron_recording.h"
 #include "implementations/neuron_impl.h"
 #include "current_sources/current_source.h"
+#include "synapses.h"
 #include "plasticity/synapse_dynamics.h"
 #include <debug.h>
+#include <simulation.h>
+#include <circular_buffer.h>
 
-//! The keys to be used by the neurons (one per neuron)
+//! \brief The keys to be used by the neurons (one per neuron), or NULL if
+//!     the keys are worked out from ::neuron_key_base
 uint32_t *neuron_keys;
 
+//! The key of the first neuron, when the keys of the neurons are contiguous
+uint32_t neuron_key_base;
+
+//! The shift of the neuron index to add to ::neuron_key_base
+uint32_t neuron_key_shift;
+
 //! A checker that says if this model should be transmitting. If set to false
 //! by the data region, then this model should not have a key.
 bool use_key;
@@ -41,6 +51,56 @@ uint32_t earliest_send_time = 0;
 //! The colour of the time step to handle delayed spikes
 uint32_t colour = 0;
 
+//! Whether to measure ::neuron_recording_cycles
+bool neuron_recording_timing = false;
+
+//! The timer cycles spent recording the neuron state in the last time step
+uint32_t neuron_recording_cycles = 0;
+
+#ifndef NEURON_HOT_RESUME
+//! \brief Whether to keep the neuron state in DTCM on resume, rather than
+//!     loading it again, unless the host has written new parameters.  This
+//!     can be set per binary at build time.
+#define NEURON_HOT_RESUME 0
+#endif
+
+#ifndef NEURON_LIVE_PARAMETERS
+//! \brief Whether to take changes to parameters from the host over SDP while
+//!     the simulation runs.  This can be set per binary at build time.
+#define NEURON_LIVE_PARAMETERS 0
+#endif
+
+#if NEURON_LIVE_PARAMETERS
+//! The SDP port that changes to parameters are sent to
+#define LIVE_PARAMETERS_SDP_PORT 3
+
+//! The size of the queue of changes to parameters, in words
+#define LIVE_PARAMETERS_QUEUE_SIZE 256
+
+//! The size of an SDP header with the command words, in bytes
+#define LIVE_PARAMETERS_HEADER_BYTES (sizeof(sdp_hdr_t) + (4 * sizeof(uint32_t)))
+
+//! The commands that change parameters
+enum live_parameters_commands {
+    //! Set the amplitudes of DC sources; the data is pairs of (index, value)
+    LIVE_SET_DC_AMPLITUDE
+};
+
+//! The changes not yet made, as pairs of (DC source index, amplitude)
+static circular_buffer live_changes;
+#endif
+
+#if SPIKE_SEND_BATCHED
+//! The neurons that have spiked in this timestep, to be sent as a batch
+bit_field_t spiked_neurons;
+
+//! The number of words in ::spiked_neurons
+uint32_t n_spiked_neurons_words;
+
+//! The number of times each neuron has spiked in this timestep
+uint16_t *neuron_spike_counts;
+#endif
+
 //! The number of neurons on the core
 static uint32_t n_neurons;
 
@@ -53,6 +113,12 @@ static uint32_t n_synapse_types;
 //! The mask of the colour
 static uint32_t colour_mask;
 
+//! The number of ticks of the simulation in each time step of the neurons
+static uint32_t timestep_multiple;
+
+//! The ticks left before the neurons are next updated
+static uint32_t ticks_to_update = 0;
+
 //! Amount to left shift the ring buffer by to make it an input
 static uint32_t *ring_buffer_to_input_left_shifts;
 
@@ -65,16 +131,37 @@ static void *current_source_address;
 //! The address to save initial values to
 static void *saved_initial_values_address;
 
+//! The core parameters in SDRAM, which say if the host has new parameters
+static struct neuron_core_parameters *core_params_sdram;
+
+//! How the keys of the neurons are given; these match KeyMode in
+//! population_machine_neurons.py
+enum neuron_key_mode {
+    //! The neurons don't send spikes
+    NEURON_NO_KEY,
+    //! There is a key for each neuron
+    NEURON_KEY_ARRAY,
+    //! \brief There is a base key, to which the neuron index shifted by the
+    //!     number of colour bits is added
+    NEURON_KEY_BASE
+};
+
 //! parameters that reside in the neuron_parameter_data_region
 struct neuron_core_parameters {
-    uint32_t has_key;
+    //! The ::neuron_key_mode
+    uint32_t key_mode;
     uint32_t n_neurons_to_simulate;
     uint32_t n_neurons_peak;
     uint32_t n_colour_bits;
+    //! Set by the host when it has written new neuron parameters
+    uint32_t reload_params;
+    //! The number of ticks of the simulation in each time step of the neurons
+    uint32_t timestep_multiple;
     uint32_t n_synapse_types;
     uint32_t ring_buffer_shifts[];
     // Following this struct in memory (as it can't be expressed in C) is:
     // uint32_t neuron_keys[n_neurons_to_simulate];
+    // or, for NEURON_KEY_BASE, just the key of the first neuron
 };
 
 //! \brief does the memory copy for the neuron parameters
@@ -99,9 +186,63 @@ bool neuron_resume(uint32_t time) { // EXPORTED
     // (re)load the current source parameters
     current_source_load_parameters(current_source_address);
 
+    // A reset starts the neurons again from the first tick
+    if (time == 0) {
+        ticks_to_update = 0;
+    }
+
+#if NEURON_HOT_RESUME
+    // What is in DTCM is what was stored on pause, so unless the host has
+    // written something new, or this is a reset, there is nothing to load
+    if (time != 0 && !core_params_sdram->reload_params) {
+        return true;
+    }
+#endif
+    core_params_sdram->reload_params = 0;
     return neuron_load_neuron_parameters(time);
 }
 
+#if NEURON_LIVE_PARAMETERS
+//! \brief Take changes to parameters sent by the host, to be made at the
+//!     start of the next timestep
+//! \param[in] mailbox: The SDP message
+//! \param[in] port: The port the message was sent to
+static void live_parameters_callback(uint mailbox, UNUSED uint port) {
+    sdp_msg_t *msg = (sdp_msg_t *) mailbox;
+    if (msg->cmd_rc == LIVE_SET_DC_AMPLITUDE) {
+        uint32_t *data = (uint32_t *) msg->data;
+        uint32_t max_changes =
+                (msg->length - LIVE_PARAMETERS_HEADER_BYTES) /
+                (2 * sizeof(uint32_t));
+        uint32_t n_changes = msg->arg1;
+        if (n_changes > max_changes) {
+            n_changes = max_changes;
+        }
+        for (uint32_t i = 0; i < n_changes; i++) {
+            if (!circular_buffer_add(live_changes, data[2 * i]) ||
+                    !circular_buffer_add(live_changes, data[(2 * i) + 1])) {
+                log_warning("Too many parameter changes queued");
+                break;
+            }
+        }
+    }
+    spin1_msg_free(msg);
+}
+
+//! \brief Make the changes to parameters sent by the host
+static inline void live_parameters_apply(void) {
+    while (circular_buffer_size(live_changes) >= 2) {
+        uint32_t index;
+        REAL amplitude;
+        circular_buffer_get_next(live_changes, &index);
+        circular_buffer_get_next(live_changes, (uint32_t *) &amplitude);
+        if (!current_source_set_dc_amplitude(index, amplitude)) {
+            log_warning("No DC source %u to change", index);
+        }
+    }
+}
+#endif
+
 bool neuron_initialise(
         void *core_params_address, void *neuron_params_address,
         void *current_sources_address, void *recording_address,
@@ -110,16 +251,23 @@ bool neuron_initialise(
     struct neuron_core_parameters *params = core_params_address;
 
     // Check if there is a key to use
-    use_key = params->has_key;
+    use_key = params->key_mode != NEURON_NO_KEY;
+    core_params_sdram = params;
 
     // Read the neuron details
     n_neurons = params->n_neurons_to_simulate;
     n_neurons_peak = params->n_neurons_peak;
+#if COMPACT_RING_BUFFERS
+    // The ring buffers have an entry for exactly each neuron
+    n_neurons_peak = n_neurons;
+#endif
     n_synapse_types = params->n_synapse_types;
 
     // Get colour details
     colour_mask = (1 << params->n_colour_bits) - 1;
 
+    timestep_multiple = params->timestep_multiple;
+
     // Set up ring buffer left shifts
     uint32_t ring_buffer_bytes = n_synapse_types * sizeof(uint32_t);
     ring_buffer_to_input_left_shifts = spin1_malloc(ring_buffer_bytes);
@@ -133,16 +281,36 @@ bool neuron_initialise(
             ring_buffer_to_input_left_shifts, params->ring_buffer_shifts,
             ring_buffer_bytes);
 
-    // The key list comes after the ring buffer shifts
+    // The key list comes after the ring buffer shifts; when the keys are
+    // contiguous there is just the first, and no need to keep them all
     uint32_t *neuron_keys_sdram =
             (uint32_t *) &params->ring_buffer_shifts[n_synapse_types];
-    uint32_t neuron_keys_size = n_neurons * sizeof(uint32_t);
-    neuron_keys = spin1_malloc(neuron_keys_size);
-    if (neuron_keys == NULL) {
-        log_error("Not enough memory to allocate neuron keys");
+    neuron_key_base = neuron_keys_sdram[0];
+    neuron_key_shift = params->n_colour_bits;
+    neuron_keys = NULL;
+    if (params->key_mode != NEURON_KEY_BASE) {
+        uint32_t neuron_keys_size = n_neurons * sizeof(uint32_t);
+        neuron_keys = spin1_malloc(neuron_keys_size);
+        if (neuron_keys == NULL) {
+            log_error("Not enough memory to allocate neuron keys");
+            return false;
+        }
+        spin1_memcpy(neuron_keys, neuron_keys_sdram, neuron_keys_size);
+    }
+
+#if SPIKE_SEND_BATCHED
+    n_spiked_neurons_words = get_bit_field_size(n_neurons);
+    spiked_neurons = bit_field_alloc(n_neurons);
+    neuron_spike_counts = spin1_malloc(n_neurons * sizeof(uint16_t));
+    if (spiked_neurons == NULL || neuron_spike_counts == NULL) {
+        log_error("Not enough memory to allocate spike batch");
         return false;
     }
-    spin1_memcpy(neuron_keys, neuron_keys_sdram, neuron_keys_size);
+    clear_bit_field(spiked_neurons, n_spiked_neurons_words);
+    for (uint32_t i = 0; i < n_neurons; i++) {
+        neuron_spike_counts[i] = 0;
+    }
+#endif
 
     // Store where the actual neuron parameters start
     saved_neuron_params_address = neuron_params_address;
@@ -161,6 +329,7 @@ bool neuron_initialise(
     if (!neuron_load_neuron_parameters(0)) {
         return false;
     }
+    params->reload_params = 0;
 
     // Initialise for current sources
     if (!current_source_initialise(current_sources_address, n_neurons)) {
@@ -178,11 +347,24 @@ bool neuron_initialise(
         return false;
     }
 
+#if NEURON_LIVE_PARAMETERS
+    live_changes = circular_buffer_initialize(LIVE_PARAMETERS_QUEUE_SIZE);
+    if (live_changes == NULL) {
+        log_error("Not enough memory to allocate parameter change queue");
+        return false;
+    }
+    simulation_sdp_callback_on(
+            LIVE_PARAMETERS_SDP_PORT, live_parameters_callback);
+#endif
+
     return true;
 }
 
 void neuron_pause(void) { // EXPORTED
 
+    // hand over any recordings still waiting in batches
+    neuron_recording_flush();
+
     // call neuron implementation function to do the work
     neuron_impl_store_neuron_parameters(saved_neuron_params_address, 0, n_neurons);
 }
@@ -192,39 +374,134 @@ void neuron_do_timestep_update(timer_t time, uint timer_count) { // EXPORTED
     // Prepare recording for the next timestep
     neuron_recording_setup_for_next_recording();
 
-    neuron_impl_do_timestep_update(timer_count, time, n_neurons);
+#if NEURON_LIVE_PARAMETERS
+    live_parameters_apply();
+#endif
+
+    // Neurons with a coarser time step are only updated on the first of
+    // each group of ticks; the input of the ticks in between builds up in
+    // the synapse state until then, and the recorded values are repeated
+    if (ticks_to_update == 0) {
+        ticks_to_update = timestep_multiple - 1;
+        neuron_impl_do_timestep_update(timer_count, time, n_neurons);
+
+#if SPIKE_SEND_BATCHED
+        // Send the spikes of the timestep together
+        send_spike_batch();
+#endif
+    } else {
+        ticks_to_update--;
+    }
+
+    // Record the recorded variables, timing it if asked
+    if (neuron_recording_timing) {
+        uint32_t start = tc[T1_COUNT];
+        neuron_recording_record(time);
+        neuron_recording_cycles = neuron_timer_cycles(start, tc[T1_COUNT]);
+    } else {
+        neuron_recording_record(time);
+    }
 
-    // Record the recorded variables
-    neuron_recording_record(time);
+    // Get the current sources ready for the next timestep
+    current_source_end_of_timestep(time);
 
     // Update the colour
     colour = (colour + 1) & colour_mask;
 }
 
-void neuron_transfer(weight_t *syns) { // EXPORTED
-    uint32_t synapse_index = 0;
-    uint32_t ring_buffer_index = 0;
-    for (uint32_t s_i = n_synapse_types; s_i > 0; s_i--) {
-        uint32_t rb_shift = ring_buffer_to_input_left_shifts[synapse_index];
-        uint32_t neuron_index = 0;
-        for (uint32_t n_i = n_neurons_peak; n_i > 0; n_i--) {
-            weight_t value = syns[ring_buffer_index];
-            if (value > 0) {
-                if (neuron_index > n_neurons) {
-                    log_error("Neuron index %u out of range", neuron_index);
-                    rt_error(RTE_SWERR);
-                }
-                input_t val_to_add = synapse_row_convert_weight_to_input(
-                        value, rb_shift);
-                neuron_impl_add_inputs(synapse_index, neuron_index, val_to_add);
+//! \brief Add the inputs of one synapse type to the neurons
+//! \param[in] syns: The inputs to be added, one for each neuron
+//! \param[in] synapse_index: The synapse type of the inputs
+static inline void transfer_synapse_type(
+        ring_buffer_t *syns, uint32_t synapse_index) {
+    uint32_t rb_shift = ring_buffer_to_input_left_shifts[synapse_index];
+    uint32_t neuron_index = 0;
+    for (uint32_t n_i = n_neurons_peak; n_i > 0; n_i--) {
+        ring_buffer_t value = syns[neuron_index];
+        if (value > 0) {
+            if (neuron_index > n_neurons) {
+                log_error("Neuron index %u out of range", neuron_index);
+                rt_error(RTE_SWERR);
             }
-            syns[ring_buffer_index] = 0;
-            ring_buffer_index++;
-            neuron_index++;
+            input_t val_to_add = synapse_row_convert_ring_buffer_to_input(
+                    value, rb_shift);
+            neuron_impl_add_inputs(synapse_index, neuron_index, val_to_add);
         }
-        synapse_index++;
+        syns[neuron_index] = 0;
+        neuron_index++;
+    }
+}
+
+#if defined(SYNAPSE_TYPE_COUNT) && (SYNAPSE_TYPE_COUNT == 2)
+//! \brief Add the inputs of both synapse types to the neurons in one pass, for
+//!     the common case of models with two synapse types
+//! \param[in] syns_0: The inputs of the first synapse type, one per neuron
+//! \param[in] syns_1: The inputs of the second synapse type, one per neuron
+static inline void transfer_two_synapse_types(
+        ring_buffer_t *syns_0, ring_buffer_t *syns_1) {
+    uint32_t rb_shift_0 = ring_buffer_to_input_left_shifts[0];
+    uint32_t rb_shift_1 = ring_buffer_to_input_left_shifts[1];
+    for (uint32_t neuron_index = 0; neuron_index < n_neurons_peak;
+            neuron_index++) {
+        ring_buffer_t value_0 = syns_0[neuron_index];
+        ring_buffer_t value_1 = syns_1[neuron_index];
+        if ((value_0 | value_1) == 0) {
+            continue;
+        }
+        if (neuron_index > n_neurons) {
+            log_error("Neuron index %u out of range", neuron_index);
+            rt_error(RTE_SWERR);
+        }
+        if (value_0 > 0) {
+            neuron_impl_add_inputs(0, neuron_index,
+                    synapse_row_convert_ring_buffer_to_input(
+                            value_0, rb_shift_0));
+            syns_0[neuron_index] = 0;
+        }
+        if (value_1 > 0) {
+            neuron_impl_add_inputs(1, neuron_index,
+                    synapse_row_convert_ring_buffer_to_input(
+                            value_1, rb_shift_1));
+            syns_1[neuron_index] = 0;
+        }
+    }
+}
+#endif
+
+void neuron_transfer(ring_buffer_t *syns) { // EXPORTED
+#if defined(SYNAPSE_TYPE_COUNT) && (SYNAPSE_TYPE_COUNT == 2)
+    if (n_synapse_types == 2) {
+        transfer_two_synapse_types(syns, &syns[n_neurons_peak]);
+        return;
+    }
+#endif
+    for (uint32_t synapse_index = 0; synapse_index < n_synapse_types;
+            synapse_index++) {
+        transfer_synapse_type(syns, synapse_index);
+        syns += n_neurons_peak;
+    }
+}
+
+#if COMPACT_RING_BUFFERS
+void neuron_transfer_compact(
+        ring_buffer_t *ring_buffers, uint32_t first_index) { // EXPORTED
+#if defined(SYNAPSE_TYPE_COUNT) && (SYNAPSE_TYPE_COUNT == 2)
+    if (n_synapse_types == 2) {
+        transfer_two_synapse_types(
+                &ring_buffers[synapses_ring_buffer_entry(first_index)],
+                &ring_buffers[synapses_ring_buffer_entry(
+                        first_index + (1 << synapse_index_bits))]);
+        return;
+    }
+#endif
+    for (uint32_t synapse_index = 0; synapse_index < n_synapse_types;
+            synapse_index++) {
+        transfer_synapse_type(&ring_buffers[synapses_ring_buffer_entry(
+                first_index + (synapse_index << synapse_index_bits))],
+                synapse_index);
     }
 }
+#endif
 
 #if LOG_LEVEL >= LOG_DEBUG
 void neuron_print_inputs(void) { // EXPORTED
@@ -35,6 +35,26 @@
 #include <common/neuron-typedefs.h>
 #include <spin1_api.h>
 
+//! Whether to measure ::neuron_recording_cycles
+extern bool neuron_recording_timing;
+
+//! \brief The timer cycles spent recording the neuron state in the last time
+//!     step, if ::neuron_recording_timing is set
+extern uint32_t neuron_recording_cycles;
+
+//! \brief Get the timer cycles between two readings of the timer
+//! \details The timer counts down, reloading at the end of the time step, so
+//!     this allows for one reload in between.
+//! \param[in] start: The value of `tc[T1_COUNT]` at the start
+//! \param[in] end: The value of `tc[T1_COUNT]` at the end
+//! \return The number of cycles in between
+static inline uint32_t neuron_timer_cycles(uint32_t start, uint32_t end) {
+    if (end > start) {
+        start += tc[T1_LOAD];
+    }
+    return start - end;
+}
+
 //! \brief translate the data stored in the NEURON_PARAMS data region in SDRAM
 //!        and convert it into c based objects for use.
 //! \param[in] core_params_address: the absolute address in SDRAM for the start
@@ -72,7 +92,17 @@ void neuron_pause(void);
 //! \brief Add inputs to the neurons
 //! \param[in] syns The inputs to be added; this is an array of size
 //!                 n_synapse_types * 2^ceil(log_2(n_neurons)).
-void neuron_transfer(weight_t *syns);
+void neuron_transfer(ring_buffer_t *syns);
+
+#if COMPACT_RING_BUFFERS
+//! \brief Add inputs to the neurons from compact ring buffers, in which each
+//!     synapse type has a section of its own
+//! \param[in] ring_buffers All of the ring buffers
+//! \param[in] first_index The ring buffer index of the first synapse type
+//!                        and neuron of the time step, as given by
+//!                        synapse_row_get_first_ring_buffer_index()
+void neuron_transfer_compact(ring_buffer_t *ring_buffers, uint32_t first_index);
+#endif
 
 #if LOG_LEVEL >= LOG_DEBUG
 //! \brief Print the inputs to the neurons.
@@ -26,6 +26,23 @@
 #include <wfi.h>
 #include <stddef.h>
 
+#ifndef NEURON_RECORDING_BATCH
+//! \brief The number of recordings of each variable to gather in DTCM before
+//!     handing them to the recording library in one go; 1 hands over each
+//!     recording as it is made
+#define NEURON_RECORDING_BATCH 1
+#endif
+
+#if NEURON_RECORDING_BATCH > 1
+//! A struct of recordings waiting to be handed to the recording library
+typedef struct recording_batch_t {
+    //! The number of recordings waiting
+    uint32_t n_records;
+    //! Space for ::NEURON_RECORDING_BATCH recordings
+    uint8_t *data;
+} recording_batch_t;
+#endif
+
 //! A struct of the different types of recorded data
 // Note data is just bytes here but actual type is used on writing
 typedef struct recording_values_t {
@@ -39,6 +56,20 @@ typedef struct bitfield_values_t {
     uint32_t bits[];
 } bitfield_values_t;
 
+//! Encoding of a recording of values as they are written
+#define RECORDING_ENCODING_NONE 0
+
+//! \brief Encoding of a recording as the mean and variance of the values of
+//!     the neurons, plus the number of fractional bits of the values
+#define RECORDING_ENCODING_MOMENTS 0x100
+
+//! Encoding of a bitfield recording as the bits as they are set
+#define BITFIELD_ENCODING_NONE 0
+
+//! \brief Encoding of a bitfield recording as the number of times each bit
+//!     was set since the last recording, in 16 bits each
+#define BITFIELD_ENCODING_COUNTS 1
+
 //! A struct for information for a non-bitfield recording
 typedef struct recording_info_t {
     uint32_t element_size;
@@ -47,6 +78,20 @@ typedef struct recording_info_t {
     uint32_t increment;
     uint32_t size;
     recording_values_t *values;
+    //! \brief How the values are encoded when recorded; either
+    //!     ::RECORDING_ENCODING_NONE, 1 + the number of bits to shift each
+    //!     32-bit value right by before saturating it to 16 bits, or
+    //!     ::RECORDING_ENCODING_MOMENTS + the fractional bits of the values
+    uint32_t encoding;
+    //! The number of neurons recording the variable
+    uint32_t n_neurons_recording;
+    //! The size of the recording handed over
+    uint32_t encoded_size;
+    //! The recording handed over; the encoded values, or ::values
+    recording_values_t *encoded;
+#if NEURON_RECORDING_BATCH > 1
+    recording_batch_t batch;
+#endif
 } recording_info_t;
 
 //! A struct for information on a bitfield recording
@@ -57,6 +102,19 @@ typedef struct bitfield_info_t {
     uint32_t size;
     uint32_t n_words;
     bitfield_values_t *values;
+    //! \brief How the bits are encoded when recorded; either
+    //!     ::BITFIELD_ENCODING_NONE or ::BITFIELD_ENCODING_COUNTS
+    uint32_t encoding;
+    //! The number of neurons recording the bitfield
+    uint32_t n_neurons_recording;
+    //! The size of the recording handed over
+    uint32_t encoded_size;
+    //! \brief The counts of the bits set since the last recording, when
+    //!     they are counted, as a recording of 16-bit values
+    recording_values_t *counts;
+#if NEURON_RECORDING_BATCH > 1
+    recording_batch_t batch;
+#endif
 } bitfield_info_t;
 
 //! The index to record each variable to for each neuron
@@ -161,6 +219,130 @@ static inline void neuron_recording_record_bit(
     bit_field_set(bitfield_values[var_index], index);
 }
 
+#if NEURON_RECORDING_BATCH > 1
+//! \brief hands the recordings waiting in a batch over to basic recording
+//! \param[in] channel: the recording channel of the batch
+//! \param[in] batch: the batch to hand over
+//! \param[in] size: the size of each recording in the batch
+static inline void neuron_recording_flush_batch(
+        uint32_t channel, recording_batch_t *batch, uint32_t size) {
+    if (batch->n_records > 0) {
+        recording_record(channel, batch->data, batch->n_records * size);
+        batch->n_records = 0;
+    }
+}
+
+//! \brief adds a recording to a batch, handing the batch over to basic
+//!        recording when it is full
+//! \param[in] channel: the recording channel of the batch
+//! \param[in] batch: the batch to add to
+//! \param[in] values: the recording to add
+//! \param[in] size: the size of the recording
+static inline void neuron_recording_batch(
+        uint32_t channel, recording_batch_t *batch, void *values,
+        uint32_t size) {
+    spin1_memcpy(&batch->data[batch->n_records * size], values, size);
+    if (++batch->n_records == NEURON_RECORDING_BATCH) {
+        neuron_recording_flush_batch(channel, batch, size);
+    }
+}
+#endif
+
+//! \brief encodes the values of a recording as the mean and variance of
+//!        the values of the neurons, in the fixed-point type of the values
+//! \param[in] rec_info: the recording to encode
+static inline void neuron_recording_encode_moments(
+        recording_info_t *rec_info) {
+    uint32_t frac_bits = rec_info->encoding - RECORDING_ENCODING_MOMENTS;
+    uint32_t n_neurons = rec_info->n_neurons_recording;
+    int32_t *in = (int32_t *) rec_info->values->data;
+    int32_t *out = (int32_t *) rec_info->encoded->data;
+    rec_info->encoded->time = rec_info->values->time;
+    if (n_neurons == 0) {
+        out[0] = 0;
+        out[1] = 0;
+        return;
+    }
+    int64_t sum = 0;
+    for (uint32_t n = 0; n < n_neurons; n++) {
+        sum += in[n];
+    }
+    int32_t mean = (int32_t) (sum / (int64_t) n_neurons);
+
+    // The squares of the differences have twice the fractional bits
+    uint64_t sum_sq = 0;
+    for (uint32_t n = 0; n < n_neurons; n++) {
+        int64_t diff = (int64_t) in[n] - mean;
+        sum_sq += (uint64_t) (diff * diff);
+    }
+    uint64_t variance = (sum_sq / n_neurons) >> frac_bits;
+    out[0] = mean;
+    out[1] = (variance > INT32_MAX) ? INT32_MAX : (int32_t) variance;
+}
+
+//! \brief encodes the values of a recording ready for handing over, if the
+//!        recording is to be encoded
+//! \param[in] rec_info: the recording to encode
+static inline void neuron_recording_encode(recording_info_t *rec_info) {
+    if (rec_info->encoding == RECORDING_ENCODING_NONE) {
+        return;
+    }
+    if (rec_info->encoding >= RECORDING_ENCODING_MOMENTS) {
+        neuron_recording_encode_moments(rec_info);
+        return;
+    }
+    uint32_t shift = rec_info->encoding - 1;
+    int32_t *in = (int32_t *) rec_info->values->data;
+    int16_t *out = (int16_t *) rec_info->encoded->data;
+    for (uint32_t n = 0; n < rec_info->n_neurons_recording; n++) {
+        int32_t value = in[n] >> shift;
+        if (value > INT16_MAX) {
+            value = INT16_MAX;
+        } else if (value < INT16_MIN) {
+            value = INT16_MIN;
+        }
+        out[n] = (int16_t) value;
+    }
+    rec_info->encoded->time = rec_info->values->time;
+}
+
+//! \brief adds the bits set in a bitfield to the counts of the neurons, and
+//!        clears the bitfield ready for the next time step
+//! \param[in] bf_info: the bitfield recording to count the bits of
+static inline void neuron_recording_count_bits(bitfield_info_t *bf_info) {
+    uint32_t *bits = bf_info->values->bits;
+    uint16_t *counts = (uint16_t *) bf_info->counts->data;
+    uint32_t n_neurons = bf_info->n_neurons_recording;
+    for (uint32_t w = 0; w < bf_info->n_words; w++) {
+        uint32_t word = bits[w];
+        bits[w] = 0;
+        while (word != 0) {
+            uint32_t bit = __builtin_ctz(word);
+            word &= word - 1;
+            uint32_t index = (w << 5) + bit;
+            // The bit after those of the neurons is for those not recording
+            if (index < n_neurons && counts[index] < UINT16_MAX) {
+                counts[index]++;
+            }
+        }
+    }
+}
+
+//! \brief hands over any recordings waiting in batches to basic recording;
+//!        must be called before basic recording is finalised
+static inline void neuron_recording_flush(void) {
+#if NEURON_RECORDING_BATCH > 1
+    for (uint32_t i = 0; i < N_RECORDED_VARS; i++) {
+        neuron_recording_flush_batch(
+                i, &recording_info[i].batch, recording_info[i].encoded_size);
+    }
+    for (uint32_t i = 0; i < N_BITFIELD_VARS; i++) {
+        neuron_recording_flush_batch(i + N_RECORDED_VARS,
+                &bitfield_info[i].batch, bitfield_info[i].encoded_size);
+    }
+#endif
+}
+
 //! \brief does the recording process of handing over to basic recording
 //! \param[in] time: the time to put into the recording stamps.
 static inline void neuron_recording_record(uint32_t time) {
@@ -174,7 +356,13 @@ static inline void neuron_recording_record(uint32_t time) {
             rec_info->count = 1;
             // Set the time and record the data
             rec_info->values->time = time;
-            recording_record(i - 1, rec_info->values, rec_info->size);
+            neuron_recording_encode(rec_info);
+#if NEURON_RECORDING_BATCH > 1
+            neuron_recording_batch(i - 1, &rec_info->batch, rec_info->encoded,
+                    rec_info->encoded_size);
+#else
+            recording_record(i - 1, rec_info->encoded, rec_info->encoded_size);
+#endif
         } else {
 
             // Not recording this time, so increment by specified amount
@@ -184,17 +372,44 @@ static inline void neuron_recording_record(uint32_t time) {
 
     for (uint32_t i = N_BITFIELD_VARS; i > 0; i--) {
         bitfield_info_t *bf_info = &bitfield_info[i - 1];
+        // Counted bits are added up every time step
+        bool counted = bf_info->encoding == BITFIELD_ENCODING_COUNTS;
+        if (counted) {
+            neuron_recording_count_bits(bf_info);
+        }
         // if the rate says record, record now
         if (bf_info->count == bf_info->rate) {
             // Reset the count
             bf_info->count = 1;
+            // Counts are always recorded, so each recording is a window
+            if (counted) {
+                bf_info->counts->time = time;
+#if NEURON_RECORDING_BATCH > 1
+                neuron_recording_batch(i + N_RECORDED_VARS - 1,
+                        &bf_info->batch, bf_info->counts,
+                        bf_info->encoded_size);
+#else
+                recording_record(i + N_RECORDED_VARS - 1, bf_info->counts,
+                        bf_info->encoded_size);
+#endif
+                uint16_t *counts = (uint16_t *) bf_info->counts->data;
+                for (uint32_t n = 0; n < bf_info->n_neurons_recording; n++) {
+                    counts[n] = 0;
+                }
+                continue;
+            }
             // Skip empty bitfields
             if (empty_bit_field(bf_info->values->bits, bf_info->n_words)) {
                 continue;
             }
             // Set the time and record the data (note index is after recorded_vars)
             bf_info->values->time = time;
+#if NEURON_RECORDING_BATCH > 1
+            neuron_recording_batch(i + N_RECORDED_VARS - 1, &bf_info->batch,
+                    bf_info->values, bf_info->size);
+#else
             recording_record(i + N_RECORDED_VARS - 1, bf_info->values, bf_info->size);
+#endif
         } else {
 
             // Not recording this time, so increment by specified amount
@@ -248,6 +463,13 @@ static void reset_record_counter(void) {
             bitfield_info[i].count = bitfield_info[i].rate;
             clear_bit_field(bitfield_info[i].values->bits,
                     bitfield_info[i].n_words);
+            if (bitfield_info[i].encoding == BITFIELD_ENCODING_COUNTS) {
+                uint16_t *counts = (uint16_t *) bitfield_info[i].counts->data;
+                for (uint32_t n = 0; n < bitfield_info[i].n_neurons_recording;
+                        n++) {
+                    counts[n] = 0;
+                }
+            }
         }
     }
 }
@@ -275,6 +497,7 @@ static bool neuron_recording_read_in_elements(
         uint32_t rate;
         uint32_t n_neurons_recording;
         uint32_t element_size;
+        uint32_t encoding;
         uint16_t indices[ceil_n_entries];
     } neuron_recording_data_t;
 
@@ -286,6 +509,17 @@ static bool neuron_recording_read_in_elements(
         recording_info[i].element_size = data[i].element_size;
         recording_info[i].size = sizeof(recording_values_t)
                 + (n_neurons_rec * recording_info[i].element_size);
+        recording_info[i].n_neurons_recording = n_neurons_rec;
+        recording_info[i].encoding = data[i].encoding;
+        recording_info[i].encoded_size = recording_info[i].size;
+        if (recording_info[i].encoding != RECORDING_ENCODING_NONE) {
+            recording_info[i].encoded_size = sizeof(recording_values_t)
+                    + (n_neurons_rec * sizeof(int16_t));
+        }
+        if (recording_info[i].encoding >= RECORDING_ENCODING_MOMENTS) {
+            recording_info[i].encoded_size = sizeof(recording_values_t)
+                    + (2 * sizeof(int32_t));
+        }
         // There is an extra "neuron" in the data used when one of the neurons
         // is *not* recording, to avoid a check
         uint32_t alloc_size = recording_info[i].size +
@@ -300,7 +534,31 @@ static bool neuron_recording_read_in_elements(
                 return false;
             }
             recording_values[i] = recording_info[i].values->data;
+
+            // allocate memory for the encoded recording if needed
+            recording_info[i].encoded = recording_info[i].values;
+            if (recording_info[i].encoding != RECORDING_ENCODING_NONE) {
+                recording_info[i].encoded = spin1_malloc(
+                        recording_info[i].encoded_size);
+                if (recording_info[i].encoded == NULL) {
+                    log_error("couldn't allocate encoded recording data "
+                            "space %u for %d", recording_info[i].encoded_size,
+                            i);
+                    return false;
+                }
+            }
+#if NEURON_RECORDING_BATCH > 1
+            recording_info[i].batch.data = spin1_malloc(
+                    NEURON_RECORDING_BATCH * recording_info[i].encoded_size);
+            if (recording_info[i].batch.data == NULL) {
+                log_error("couldn't allocate recording batch space for %d", i);
+                return false;
+            }
+#endif
         }
+#if NEURON_RECORDING_BATCH > 1
+        recording_info[i].batch.n_records = 0;
+#endif
 
         // copy over the indexes
         spin1_memcpy(neuron_recording_indexes[i], data[i].indices,
@@ -310,6 +568,7 @@ static bool neuron_recording_read_in_elements(
     typedef struct bitfield_recording_data {
         uint32_t rate;
         uint32_t n_neurons_recording;
+        uint32_t encoding;
         uint16_t indices[ceil_n_entries];
     } bitfield_recording_data_t;
 
@@ -320,6 +579,13 @@ static bool neuron_recording_read_in_elements(
         bitfield_info[i].rate = bitfield_data[i].rate;
         uint32_t n_neurons_rec = bitfield_data[i].n_neurons_recording;
         bitfield_info[i].size = bitfield_data_size(n_neurons_rec);
+        bitfield_info[i].n_neurons_recording = n_neurons_rec;
+        bitfield_info[i].encoding = bitfield_data[i].encoding;
+        bitfield_info[i].encoded_size = bitfield_info[i].size;
+        if (bitfield_info[i].encoding == BITFIELD_ENCODING_COUNTS) {
+            bitfield_info[i].encoded_size = sizeof(recording_values_t)
+                    + (n_neurons_rec * sizeof(uint16_t));
+        }
         // There is an extra "neuron" in the data used when one of the neurons
         // is *not* recording, to avoid a check
         uint32_t alloc_size = bitfield_data_size(n_neurons_rec + 1);
@@ -335,7 +601,29 @@ static bool neuron_recording_read_in_elements(
             // neurons is *not* recording, to avoid a check
             bitfield_info[i].n_words = get_bit_field_size(n_neurons_rec + 1);
             bitfield_values[i] = bitfield_info[i].values->bits;
+
+            // allocate memory for the counts if needed
+            if (bitfield_info[i].encoding == BITFIELD_ENCODING_COUNTS) {
+                bitfield_info[i].counts = spin1_malloc(
+                        bitfield_info[i].encoded_size);
+                if (bitfield_info[i].counts == NULL) {
+                    log_error("couldn't allocate bitfield count space %u "
+                            "for %d", bitfield_info[i].encoded_size, i);
+                    return false;
+                }
+            }
+#if NEURON_RECORDING_BATCH > 1
+            bitfield_info[i].batch.data = spin1_malloc(
+                    NEURON_RECORDING_BATCH * bitfield_info[i].encoded_size);
+            if (bitfield_info[i].batch.data == NULL) {
+                log_error("couldn't allocate bitfield batch space for %d", i);
+                return false;
+            }
+#endif
         }
+#if NEURON_RECORDING_BATCH > 1
+        bitfield_info[i].batch.n_records = 0;
+#endif
 
         // copy over the indexes
         spin1_memcpy(bitfield_recording_indexes[i], bitfield_data[i].indices,
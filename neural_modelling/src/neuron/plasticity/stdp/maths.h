@@ -31,15 +31,23 @@
 //! \param X: First value
 //! \param Y: Second value
 //! \return Minimum of two values
+#ifndef MIN
 #define MIN(X, Y)	((X) < (Y) ? (X) : (Y))
+#endif
 //! \brief Maximum. Evaluates arguments twice
 //! \param X: First value
 //! \param Y: Second value
 //! \return Maximum of two values
+#ifndef MAX
 #define MAX(X, Y)	((X) > (Y) ? (X) : (Y))
+#endif
 
 //! \brief Lookup Table of 16-bit integers.
 //!
+//! Entry i holds the value at time i << shift; values between entries are
+//! interpolated, so the host can use a larger shift to keep the table small
+//! when there are many time steps in the time constant.
+//!
 //! Will be padded to a word boundary at the end.
 typedef struct int16_lut {
     uint16_t size;    //!< Number of entries in table
@@ -47,6 +55,20 @@ typedef struct int16_lut {
     int16_t values[]; //!< Table of actual values
 } int16_lut;
 
+//! The number of entries in a ::decay_cache_entry_t cache; a power of 2
+#define DECAY_CACHE_SIZE 32
+
+//! \brief A trace decayed over a time, kept so that other synapses that
+//!     decay the same trace over the same time can use it again
+typedef struct decay_cache_entry_t {
+    //! The time the trace was decayed over
+    uint32_t time;
+    //! The trace before decay
+    int32_t trace;
+    //! The trace after decay
+    int32_t decayed;
+} decay_cache_entry_t;
+
 //---------------------------------------
 // Plasticity maths function inline implementation
 //---------------------------------------
@@ -72,7 +94,8 @@ static inline int16_lut *maths_copy_int16_lut(address_t *address) {
     return lut;
 }
 
-//! \brief Get value from lookup table
+//! \brief Get value from lookup table, linearly interpolating between the
+//!     entries either side of the time
 //! \param[in] time: The time that we are mapping
 //! \param[in] lut: The lookup table (result of maths_copy_int16_lut())
 //! \return The value from the LUT, or zero if out of range
@@ -80,9 +103,49 @@ static inline int32_t maths_lut_exponential_decay(
         uint32_t time, const int16_lut *lut) {
     // Calculate lut index
     uint32_t lut_index = time >> lut->shift;
+    if (lut_index >= lut->size) {
+        return 0;
+    }
+
+    // The value after the end of the table is zero; when the shift is zero
+    // there is nothing to interpolate, so this gives the entry itself
+    int32_t value = lut->values[lut_index];
+    int32_t next = (lut_index + 1 < lut->size) ? lut->values[lut_index + 1] : 0;
+    uint32_t fraction = time & ((1u << lut->shift) - 1);
+    return value - (((value - next) * (int32_t) fraction) >> lut->shift);
+}
 
-    // Return value from LUT
-    return (lut_index < lut->size) ? lut->values[lut_index] : 0;
+//! \brief Empty a cache of decayed traces
+//! \param[out] cache: The cache of ::DECAY_CACHE_SIZE entries
+static inline void maths_init_decay_cache(decay_cache_entry_t *cache) {
+    // No decay is ever over this long
+    for (uint32_t i = 0; i < DECAY_CACHE_SIZE; i++) {
+        cache[i].time = UINT32_MAX;
+    }
+}
+
+//! \brief Decay a trace with a lookup table, using a cache where it can
+//! \details All the synapses onto a neuron that are updated in the same
+//!     time step decay the same post-synaptic trace over the same time, so
+//!     only the first of them needs to use the lookup table.
+//! \param[in,out] cache: The cache of ::DECAY_CACHE_SIZE entries
+//! \param[in] time: The time to decay the trace over
+//! \param[in] trace: The trace to decay
+//! \param[in] lut: The lookup table of the decay
+//! \param[in] fixed_point_position: The location of the fixed point
+//! \return The decayed trace
+static inline int32_t maths_cached_decay(
+        decay_cache_entry_t *cache, uint32_t time, int32_t trace,
+        const int16_lut *lut, const int32_t fixed_point_position) {
+    decay_cache_entry_t *entry =
+            &cache[(time ^ (uint32_t) trace) & (DECAY_CACHE_SIZE - 1)];
+    if (entry->time != time || entry->trace != trace) {
+        entry->time = time;
+        entry->trace = trace;
+        entry->decayed = __smulbb(trace,
+                maths_lut_exponential_decay(time, lut)) >> fixed_point_position;
+    }
+    return entry->decayed;
 }
 
 //! \brief Clamp to fit in number of bits
@@ -29,20 +29,44 @@
 //---------------------------------------
 // Macros
 //---------------------------------------
-//! Maximum number of post-synaptic events supported
+//! \brief The default number of post-synaptic events held for each neuron;
+//!     the host sets the actual number, which must be a power of two
 #define MAX_POST_SYNAPTIC_EVENTS 16
 
+//! \brief Whether to remember the last window found for each neuron, so that
+//!     rows in the same timestep with the same window don't search again
+#ifndef STDP_POST_WINDOW_CACHE
+#define STDP_POST_WINDOW_CACHE 0
+#endif
+
 //---------------------------------------
 // Structures
 //---------------------------------------
-//! Trace history of post-synaptic events
+//! \brief Trace history of post-synaptic events, held as a ring buffer so
+//!     that adding an event doesn't move the others
 typedef struct {
-    //! Number of events stored (minus one)
-    uint32_t count_minus_one;
     //! Event times
-    uint32_t times[MAX_POST_SYNAPTIC_EVENTS];
+    uint32_t *times;
     //! Event traces
-    post_trace_t traces[MAX_POST_SYNAPTIC_EVENTS];
+    post_trace_t *traces;
+    //! The index of the newest event
+    uint16_t newest;
+    //! The number of events stored
+    uint16_t count;
+#if STDP_POST_WINDOW_CACHE
+    //! The start of the last window found
+    uint32_t cache_begin;
+    //! The end of the last window found
+    uint32_t cache_end;
+    //! The index of the first event of the last window found
+    uint16_t cache_next_index;
+    //! The number of events of the last window found
+    uint16_t cache_num_events;
+    //! Whether the last window found is still correct
+    uint8_t cache_valid;
+    //! Whether the last window found has a valid previous event
+    uint8_t cache_prev_valid;
+#endif
 } post_event_history_t;
 
 //! Post event window description
@@ -51,16 +75,19 @@ typedef struct {
     post_trace_t prev_trace;
     //! The previous post-synaptic event time
     uint32_t prev_time;
-    //! The next post-synaptic event trace
-    const post_trace_t *next_trace;
-    //! The next post-synaptic event time
-    const uint32_t *next_time;
+    //! The history that the window is of
+    const post_event_history_t *events;
+    //! The index of the next post-synaptic event in the history
+    uint32_t next_index;
     //! The number of events
     uint32_t num_events;
     //! Whether the previous post-synaptic event is valid (based on time)
     uint32_t prev_time_valid;
 } post_event_window_t;
 
+//! The number of events in each history minus one, to wrap the indices
+static uint32_t post_events_mask;
+
 //---------------------------------------
 // Inline functions
 //---------------------------------------
@@ -70,39 +97,106 @@ typedef struct {
 //! \param[in] events: The history
 static inline void print_event_history(const post_event_history_t *events) {
     log_debug("      ##  printing entire post event history  ##");
-    for (uint32_t i = 0; i <= events->count_minus_one; i++) {
+    uint32_t index = (events->newest - events->count + 1) & post_events_mask;
+    for (uint32_t i = 0; i < events->count; i++) {
         log_debug("post event: %u, time: %u, trace: %u",
-                i, events->times[i], events->traces[i]);
+                i, events->times[index], events->traces[index]);
+        index = (index + 1) & post_events_mask;
     }
 }
 #endif
 
 //! \brief Initialise an array of post-synaptic event histories
 //! \param[in] n_neurons: Number of neurons
+//! \param[in] n_events: The number of events to hold for each neuron, which
+//!     must be a power of two
 //! \return The array
 static inline post_event_history_t *post_events_init_buffers(
-        uint32_t n_neurons) {
+        uint32_t n_neurons, uint32_t n_events) {
+    if (n_events == 0 || (n_events & (n_events - 1)) != 0
+            || n_events > UINT16_MAX) {
+        log_error("The number of post-synaptic events %u is not a power of two"
+                " or is too big", n_events);
+        return NULL;
+    }
+    post_events_mask = n_events - 1;
+
     post_event_history_t *post_event_history =
             spin1_malloc(n_neurons * sizeof(post_event_history_t));
+    uint32_t *times = spin1_malloc(n_neurons * n_events * sizeof(uint32_t));
+    post_trace_t *traces =
+            spin1_malloc(n_neurons * n_events * sizeof(post_trace_t));
     // Check allocations succeeded
-    if (post_event_history == NULL) {
+    if (post_event_history == NULL || times == NULL || traces == NULL) {
         log_error("Unable to allocate global STDP structures - Out of DTCM: Try "
                 "reducing the number of neurons per core to fix this problem ");
         return NULL;
     }
 
-    // Loop through neurons
+    // Loop through neurons; the first event added goes at index 0
     for (uint32_t n = 0; n < n_neurons; n++) {
-        // Add initial placeholder entry to buffer
-        post_event_history[n].times[0] = 0;
-        post_event_history[n].traces[0] = timing_get_initial_post_trace();
-        post_event_history[n].count_minus_one = 0;
+        post_event_history[n].times = &times[n * n_events];
+        post_event_history[n].traces = &traces[n * n_events];
+        post_event_history[n].newest = post_events_mask;
+        post_event_history[n].count = 0;
+#if STDP_POST_WINDOW_CACHE
+        post_event_history[n].cache_valid = 0;
+#endif
     }
 
     return post_event_history;
 }
 
 //---------------------------------------
+//! \brief Get the time of the newest post-synaptic event
+//! \param[in] events: The post-synaptic event history
+//! \return The time, or 0 if there are no events
+static inline uint32_t post_events_last_time(
+        const post_event_history_t *events) {
+    if (events->count == 0) {
+        return 0;
+    }
+    return events->times[events->newest];
+}
+
+//! \brief Get the trace of the newest post-synaptic event
+//! \param[in] events: The post-synaptic event history
+//! \return The trace, or the initial trace if there are no events
+static inline post_trace_t post_events_last_trace(
+        const post_event_history_t *events) {
+    if (events->count == 0) {
+        return timing_get_initial_post_trace();
+    }
+    return events->traces[events->newest];
+}
+
+//---------------------------------------
+//! \brief Make a post-synaptic event window
+//! \param[in] events: The post-synaptic event history
+//! \param[in] next_index: The index of the first event in the window
+//! \param[in] num_events: The number of events in the window
+//! \param[in] prev_time_valid: Whether there is an event before the window,
+//!     or the start of the history was reached
+//! \return The window
+static inline post_event_window_t post_events_make_window(
+        const post_event_history_t *events, uint32_t next_index,
+        uint32_t num_events, bool prev_time_valid) {
+    post_event_window_t window;
+    window.events = events;
+    window.next_index = next_index;
+    window.num_events = num_events;
+    window.prev_time_valid = prev_time_valid;
+    if (prev_time_valid) {
+        uint32_t prev_index = (next_index - 1) & post_events_mask;
+        window.prev_time = events->times[prev_index];
+        window.prev_trace = events->traces[prev_index];
+    } else {
+        window.prev_time = 0;
+        window.prev_trace = timing_get_initial_post_trace();
+    }
+    return window;
+}
+
 //! \brief Get the post-synaptic event window
 //! \param[in] events: The post-synaptic event history
 //! \param[in] begin_time: The start of the window
@@ -111,39 +205,74 @@ static inline post_event_history_t *post_events_init_buffers(
 static inline post_event_window_t post_events_get_window_delayed(
         const post_event_history_t *events, uint32_t begin_time,
         uint32_t end_time) {
-    // Start at end event - beyond end of post-event history
-    const uint32_t count = events->count_minus_one + 1;
-    const uint32_t *end_event_time = events->times + count;
-    const uint32_t *event_time = end_event_time;
-    const post_trace_t *event_trace = events->traces + count;
+    // Start at the newest event and go back through those still in the future
+    uint32_t index = events->newest;
+    uint32_t remaining = events->count;
+    while (remaining > 0 && events->times[index] > end_time) {
+        index = (index - 1) & post_events_mask;
+        remaining--;
+    }
 
-    post_event_window_t window;
-    do {
-        // If this event is still in the future, set it as the end
-        if (*event_time > end_time) {
-            end_event_time = event_time;
-        }
-
-        // Cache pointer to this event as potential next event and go back one
-        // event.
-        // **NOTE** next_time can be invalid
-        window.next_time = event_time--;
-        window.next_trace = event_trace--;
-
-        // Keep looping while event occurred after start of window and we
-        // haven't hit beginning of array...
-    } while (*event_time > begin_time && event_time != events->times);
-
-    // Deference event to use as previous
-    window.prev_time = *event_time;
-    window.prev_trace = *event_trace;
-    window.prev_time_valid = event_time != events->times;
-
-    // Calculate number of events
-    window.num_events = (end_event_time - window.next_time);
-
-    // Return window
+    // Keep going back while events occurred after start of window
+    uint32_t num_events = 0;
+    while (remaining > 0 && events->times[index] > begin_time) {
+        index = (index - 1) & post_events_mask;
+        remaining--;
+        num_events++;
+    }
+
+    // Use the event found as previous, or the initial state if the start of
+    // the history was reached
+    return post_events_make_window(events, (index + 1) & post_events_mask,
+            num_events, remaining > 0);
+}
+
+//! \brief Get the post-synaptic event window, reusing the last window found
+//!     for the neuron if it is for the same times
+//! \details The times include the delays, so rows with different delays
+//!     don't share a window.  Adding an event forgets the window.
+//! \param[in,out] events: The post-synaptic event history
+//! \param[in] begin_time: The start of the window
+//! \param[in] end_time: The end of the window
+//! \return The window
+static inline post_event_window_t post_events_get_window_cached(
+        post_event_history_t *events, uint32_t begin_time,
+        uint32_t end_time) {
+#if STDP_POST_WINDOW_CACHE
+    if (events->cache_valid && events->cache_begin == begin_time
+            && events->cache_end == end_time) {
+        return post_events_make_window(events, events->cache_next_index,
+                events->cache_num_events, events->cache_prev_valid);
+    }
+    post_event_window_t window = post_events_get_window_delayed(
+            events, begin_time, end_time);
+    events->cache_begin = begin_time;
+    events->cache_end = end_time;
+    events->cache_next_index = window.next_index;
+    events->cache_num_events = window.num_events;
+    events->cache_prev_valid = window.prev_time_valid;
+    events->cache_valid = 1;
     return window;
+#else
+    return post_events_get_window_delayed(events, begin_time, end_time);
+#endif
+}
+
+//---------------------------------------
+//! \brief Get the time of the next event of a post-synaptic event window
+//! \param[in] window: The window, which must have events left
+//! \return The time of the event
+static inline uint32_t post_events_next_time(
+        const post_event_window_t *window) {
+    return window->events->times[window->next_index];
+}
+
+//! \brief Get the trace of the next event of a post-synaptic event window
+//! \param[in] window: The window, which must have events left
+//! \return The trace of the event
+static inline post_trace_t post_events_next_trace(
+        const post_event_window_t *window) {
+    return window->events->traces[window->next_index];
 }
 
 //---------------------------------------
@@ -153,8 +282,9 @@ static inline post_event_window_t post_events_get_window_delayed(
 static inline post_event_window_t post_events_next(
         post_event_window_t window) {
     // Update previous time and increment next time
-    window.prev_time = *window.next_time++;
-    window.prev_trace = *window.next_trace++;
+    window.prev_time = post_events_next_time(&window);
+    window.prev_trace = post_events_next_trace(&window);
+    window.next_index = (window.next_index + 1) & post_events_mask;
 
     // Time will now be valid for sure!
     window.prev_time_valid = 1;
@@ -165,30 +295,38 @@ static inline post_event_window_t post_events_next(
 }
 
 //---------------------------------------
-//! \brief Add a post-synaptic event to the history
+//! \brief Advance a post-synaptic event window past all its events
+//! \param[in] window: The window to advance
+//! \return the advanced window
+static inline post_event_window_t post_events_skip_all(
+        post_event_window_t window) {
+    if (window.num_events == 0) {
+        return window;
+    }
+    window.next_index =
+            (window.next_index + window.num_events - 1) & post_events_mask;
+    window.num_events = 1;
+    return post_events_next(window);
+}
+
+//---------------------------------------
+//! \brief Add a post-synaptic event to the history, replacing the oldest
+//!     event if the history is full
 //! \param[in] time: the time of the event
 //! \param[in,out] events: the history to add to
 //! \param[in] trace: the trace of the event
 static inline void post_events_add(
         uint32_t time, post_event_history_t *events, post_trace_t trace) {
-    if (events->count_minus_one < MAX_POST_SYNAPTIC_EVENTS - 1) {
-        // If there's still space, store time at current end
-        // and increment count minus 1
-        const uint32_t new_index = ++events->count_minus_one;
-        events->times[new_index] = time;
-        events->traces[new_index] = trace;
-    } else {
-        // Otherwise Shuffle down elements
-        // **NOTE** 1st element is always an entry at time 0
-        for (uint32_t e = 2; e < MAX_POST_SYNAPTIC_EVENTS; e++) {
-            events->times[e - 1] = events->times[e];
-            events->traces[e - 1] = events->traces[e];
-        }
-
-        // Stick new time at end
-        events->times[MAX_POST_SYNAPTIC_EVENTS - 1] = time;
-        events->traces[MAX_POST_SYNAPTIC_EVENTS - 1] = trace;
+    const uint32_t new_index = (events->newest + 1) & post_events_mask;
+    events->newest = new_index;
+    events->times[new_index] = time;
+    events->traces[new_index] = trace;
+    if (events->count <= post_events_mask) {
+        events->count++;
     }
+#if STDP_POST_WINDOW_CACHE
+    events->cache_valid = 0;
+#endif
 }
 
 #if LOG_LEVEL >= LOG_DEBUG
@@ -206,10 +344,10 @@ static inline void print_delayed_window_events(
 
     while (post_window.num_events > 0) {
         const uint32_t delayed_post_time =
-                *post_window.next_time + delay_dendritic;
+                post_events_next_time(&post_window) + delay_dendritic;
         log_info("post spike: %u, time: %u, trace: %u",
                 post_window.num_events, delayed_post_time,
-                *post_window.next_trace);
+                post_events_next_trace(&post_window));
 
         post_window = post_events_next(post_window);
     }
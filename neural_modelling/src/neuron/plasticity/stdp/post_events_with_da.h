@@ -32,6 +32,9 @@
 //! Maximum number of post-synaptic events supported
 #define MAX_POST_SYNAPTIC_EVENTS 16
 
+//! Maximum number of neuromodulator events shared by all neurons
+#define MAX_SHARED_DOPAMINE_EVENTS 16
+
 typedef struct nm_post_trace_t {
     int16_t dopamine_trace;
     post_trace_t post_trace;
@@ -70,6 +73,36 @@ typedef struct {
     uint32_t dopamine_trace_markers;
 } post_event_window_t;
 
+//! \brief Trace history of neuromodulator events that reach every neuron,
+//!     held once for all of them rather than in each post-synaptic history
+typedef struct {
+    //! Number of events stored (minus one)
+    uint32_t count_minus_one;
+    //! Event times
+    uint32_t times[MAX_SHARED_DOPAMINE_EVENTS];
+    //! The dopamine trace just after each event
+    int16_t traces[MAX_SHARED_DOPAMINE_EVENTS];
+    //! \brief The weight change per unit of eligibility from each event to
+    //!     the newest, for catching up over several events at once
+    int32_t run_sums[MAX_SHARED_DOPAMINE_EVENTS];
+} dopamine_event_history_t;
+
+//! Shared neuromodulator event window description
+typedef struct {
+    //! The previous event trace
+    int16_t prev_trace;
+    //! The previous event time
+    uint32_t prev_time;
+    //! The next event trace
+    const int16_t *next_trace;
+    //! The next event time
+    const uint32_t *next_time;
+    //! The number of events
+    uint32_t num_events;
+    //! Whether the previous event is valid (based on time)
+    uint32_t prev_time_valid;
+} dopamine_event_window_t;
+
 //---------------------------------------
 // Inline functions
 //---------------------------------------
@@ -236,6 +269,106 @@ static inline void post_events_add(
     }
 }
 
+//---------------------------------------
+//! \brief Initialise the shared neuromodulator event history
+//! \param[out] events: The history to initialise
+static inline void dopamine_events_init(dopamine_event_history_t *events) {
+    // Add initial placeholder entry to buffer
+    events->times[0] = 0;
+    events->traces[0] = 0;
+    events->run_sums[0] = 0;
+    events->count_minus_one = 0;
+}
+
+//---------------------------------------
+//! \brief Get the shared neuromodulator event window
+//! \param[in] events: The shared neuromodulator event history
+//! \param[in] begin_time: The start of the window
+//! \param[in] end_time: The end of the window
+//! \return The window
+static inline dopamine_event_window_t dopamine_events_get_window_delayed(
+        const dopamine_event_history_t *events, uint32_t begin_time,
+        uint32_t end_time) {
+    // Start at end event - beyond end of history
+    const uint32_t count = events->count_minus_one + 1;
+    const uint32_t *end_event_time = events->times + count;
+    const uint32_t *event_time = end_event_time;
+    const int16_t *event_trace = events->traces + count;
+
+    dopamine_event_window_t window;
+    do {
+        // If this event is still in the future, set it as the end
+        if (*event_time > end_time) {
+            end_event_time = event_time;
+        }
+
+        // **NOTE** next_time can be invalid
+        window.next_time = event_time--;
+        window.next_trace = event_trace--;
+    } while (*event_time > begin_time && event_time != events->times);
+
+    window.prev_time = *event_time;
+    window.prev_trace = *event_trace;
+    window.prev_time_valid = event_time != events->times;
+    window.num_events = (end_event_time - window.next_time);
+    return window;
+}
+
+//---------------------------------------
+//! \brief Advance a shared neuromodulator event window to the next event
+//! \param[in] window: The window to advance
+//! \return the advanced window
+static inline dopamine_event_window_t dopamine_events_next(
+        dopamine_event_window_t window) {
+    window.prev_time = *window.next_time++;
+    window.prev_trace = *window.next_trace++;
+    window.prev_time_valid = 1;
+    window.num_events--;
+    return window;
+}
+
+//---------------------------------------
+//! \brief Advance a shared neuromodulator event window over several events
+//! \param[in] window: The window to advance
+//! \param[in] n_events: The number of events to advance over; at least 1
+//! \return the advanced window
+static inline dopamine_event_window_t dopamine_events_skip(
+        dopamine_event_window_t window, uint32_t n_events) {
+    window.next_time += n_events;
+    window.next_trace += n_events;
+    window.prev_time = window.next_time[-1];
+    window.prev_trace = window.next_trace[-1];
+    window.prev_time_valid = 1;
+    window.num_events -= n_events;
+    return window;
+}
+
+//---------------------------------------
+//! \brief Add a neuromodulator event to the shared history
+//! \param[in] time: the time of the event
+//! \param[in,out] events: the history to add to
+//! \param[in] dopamine_trace: the dopamine trace just after the event
+static inline void dopamine_events_add(
+        uint32_t time, dopamine_event_history_t *events,
+        int16_t dopamine_trace) {
+    if (events->count_minus_one < MAX_SHARED_DOPAMINE_EVENTS - 1) {
+        const uint32_t new_index = ++events->count_minus_one;
+        events->times[new_index] = time;
+        events->traces[new_index] = dopamine_trace;
+        events->run_sums[new_index] = 0;
+    } else {
+        // Shuffle down elements, keeping the placeholder entry at time 0
+        for (uint32_t e = 2; e < MAX_SHARED_DOPAMINE_EVENTS; e++) {
+            events->times[e - 1] = events->times[e];
+            events->traces[e - 1] = events->traces[e];
+            events->run_sums[e - 1] = events->run_sums[e];
+        }
+        events->times[MAX_SHARED_DOPAMINE_EVENTS - 1] = time;
+        events->traces[MAX_SHARED_DOPAMINE_EVENTS - 1] = dopamine_trace;
+        events->run_sums[MAX_SHARED_DOPAMINE_EVENTS - 1] = 0;
+    }
+}
+
 #if LOG_LEVEL >= LOG_DEBUG
 //! \brief Print the post-synaptic event history
 //! \param[in] post_event_history: the history
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2024 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//! \file
+//! \brief Synapse updates specialised for the most used combinations of
+//!     STDP timing and weight rules
+//!
+//! The generic update applies each event through timing_apply_post_spike()
+//! and timing_apply_pre_spike(), which pass the whole ::update_state_t and
+//! clamp the weight after each event.  For the pair and nearest pair timing
+//! rules with the additive or multiplicative weight rules, the update here
+//! instead holds the weight in a single accum across the window, and:
+//!
+//! - the additive rule clamps to the maximum weight once after all the
+//!   potentiation of the window, which is the same as clamping after each
+//!   event as long as \f$A^+\f$ is not negative;
+//! - the nearest pair rule stops looking at the events of the window after
+//!   the first one that follows another post-synaptic event after the
+//!   pre-synaptic spike, as it gives no potentiation for these.
+//!
+//! The results are the same as those of the generic update.
+#ifndef _STDP_FUSED_KERNELS_H_
+#define _STDP_FUSED_KERNELS_H_
+
+#include "post_events.h"
+
+//! \brief Whether to use a specialised update for the timing and weight
+//!     rules of this build, where there is one.  This can be set per binary
+//!     at build time.
+#ifndef STDP_FUSED_KERNELS
+#define STDP_FUSED_KERNELS 1
+#endif
+
+#if STDP_FUSED_KERNELS && \
+        (defined(TIMING_RULE_PAIR) || defined(TIMING_RULE_NEAREST_PAIR)) && \
+        (defined(WEIGHT_RULE_ADDITIVE_ONE_TERM) || \
+                defined(WEIGHT_RULE_MULTIPLICATIVE))
+//! There is a specialised update for the rules of this build
+#define STDP_HAS_FUSED_KERNEL 1
+
+#if defined(WEIGHT_RULE_ADDITIVE_ONE_TERM)
+//! \brief Potentiate a weight, without clamping it
+//! \param[in] weight: The weight to potentiate
+//! \param[in] region: The configuration of the weight rule
+//! \param[in] potentiation: The amount of potentiation to apply
+//! \return The potentiated weight
+static inline accum fused_potentiate(accum weight,
+        const plasticity_weight_region_data_t *region, int32_t potentiation) {
+    return weight + mul_accum_fixed(region->a2_plus, potentiation);
+}
+
+//! \brief Finish the potentiation of a weight
+//! \param[in] weight: The potentiated weight
+//! \param[in] region: The configuration of the weight rule
+//! \return The weight, clamped to the maximum
+static inline accum fused_end_potentiation(accum weight,
+        const plasticity_weight_region_data_t *region) {
+    return kbits(MIN(bitsk(weight), bitsk(region->max_weight)));
+}
+
+//! \brief Depress a weight
+//! \param[in] weight: The weight to depress
+//! \param[in] region: The configuration of the weight rule
+//! \param[in] depression: The amount of depression to apply
+//! \return The depressed weight, clamped to the minimum
+static inline accum fused_depress(accum weight,
+        const plasticity_weight_region_data_t *region, int32_t depression) {
+    weight -= mul_accum_fixed(region->a2_minus, depression);
+    return kbits(MAX(bitsk(weight), bitsk(region->min_weight)));
+}
+#else
+//! \brief Potentiate a weight towards the maximum
+//! \param[in] weight: The weight to potentiate
+//! \param[in] region: The configuration of the weight rule
+//! \param[in] potentiation: The amount of potentiation to apply
+//! \return The potentiated weight
+static inline accum fused_potentiate(accum weight,
+        const plasticity_weight_region_data_t *region, int32_t potentiation) {
+    accum scale = (region->max_weight - weight) * region->a2_plus;
+    return weight + mul_accum_fixed(scale, potentiation);
+}
+
+//! \brief Finish the potentiation of a weight; the multiplicative rule
+//!     can't go past the maximum, so there is nothing to do
+//! \param[in] weight: The potentiated weight
+//! \param[in] region: The configuration of the weight rule
+//! \return The weight
+static inline accum fused_end_potentiation(accum weight,
+        UNUSED const plasticity_weight_region_data_t *region) {
+    return weight;
+}
+
+//! \brief Depress a weight towards the minimum
+//! \param[in] weight: The weight to depress
+//! \param[in] region: The configuration of the weight rule
+//! \param[in] depression: The amount of depression to apply
+//! \return The depressed weight
+static inline accum fused_depress(accum weight,
+        const plasticity_weight_region_data_t *region, int32_t depression) {
+    accum scale = (weight - region->min_weight) * region->a2_minus;
+    return weight - mul_accum_fixed(scale, depression);
+}
+#endif
+
+//! \brief Update a synapse for a pre-synaptic spike and the post-synaptic
+//!     events since the last one
+//! \param[in] time: The current time
+//! \param[in] last_pre_time: The time of the last previous pre-event
+//! \param[in] last_pre_trace: The last previous pre-trace
+//! \param[in] delay_dendritic: The dendritic delay for the synapse
+//! \param[in] delay_axonal: The axonal delay for the synapse
+//! \param[in] current_state: The current state
+//! \param[in] post_window: The post-synaptic events since the last pre-event
+//! \return The new basic state of the synapse
+static inline final_state_t plasticity_update_synapse_fused(
+        const uint32_t time,
+        const uint32_t last_pre_time, const pre_trace_t last_pre_trace,
+        const uint32_t delay_dendritic, const uint32_t delay_axonal,
+        update_state_t current_state, post_event_window_t post_window) {
+    extern int16_lut *tau_plus_lookup;
+    extern int16_lut *tau_minus_lookup;
+    const plasticity_weight_region_data_t *region =
+            weight_get_region(current_state);
+    const uint32_t delayed_last_pre_time = last_pre_time + delay_axonal;
+    const uint32_t delayed_pre_time = time + delay_axonal;
+    accum weight = current_state.weight;
+    bool potentiated = false;
+
+    // Potentiate for each post-synaptic event after the last pre-event
+    while (post_window.num_events > 0) {
+        const uint32_t delayed_post_time =
+                post_events_next_time(&post_window) + delay_dendritic;
+        const uint32_t time_since_last_pre =
+                delayed_post_time - delayed_last_pre_time;
+#if defined(TIMING_RULE_NEAREST_PAIR)
+        // Only the first pairing counts, and the events are in time order,
+        // so once one is not the first, none of the rest are
+        if ((delayed_post_time - post_window.prev_time) < time_since_last_pre) {
+            potentiated = true;
+            post_window = post_events_skip_all(post_window);
+            break;
+        }
+        if (time_since_last_pre > 0) {
+            weight = fused_potentiate(weight, region,
+                    maths_lut_exponential_decay(
+                            time_since_last_pre, tau_plus_lookup));
+            potentiated = true;
+        }
+#else
+        if (time_since_last_pre > 0) {
+            weight = fused_potentiate(weight, region,
+                    STDP_FIXED_MUL_16X16(last_pre_trace,
+                            maths_lut_exponential_decay(
+                                    time_since_last_pre, tau_plus_lookup)));
+            potentiated = true;
+        }
+#endif
+        post_window = post_events_next(post_window);
+    }
+    if (potentiated) {
+        weight = fused_end_potentiation(weight, region);
+    }
+
+    // Depress for the last post-synaptic event before this pre-event
+    if (post_window.prev_time_valid) {
+        const uint32_t time_since_last_post =
+                delayed_pre_time - (post_window.prev_time + delay_dendritic);
+#if defined(TIMING_RULE_NEAREST_PAIR)
+        int32_t decayed_o1 = maths_lut_exponential_decay(
+                time_since_last_post, tau_minus_lookup);
+#else
+        int32_t decayed_o1 = STDP_FIXED_MUL_16X16(post_window.prev_trace,
+                maths_lut_exponential_decay(
+                        time_since_last_post, tau_minus_lookup));
+#endif
+        weight = fused_depress(weight, region, decayed_o1);
+    }
+
+    current_state.weight = weight;
+    return synapse_structure_get_final_state(current_state);
+}
+#else
+//! There is no specialised update for the rules of this build
+#define STDP_HAS_FUSED_KERNEL 0
+#endif
+
+#endif // _STDP_FUSED_KERNELS_H_
@@ -41,6 +41,16 @@
 //! to STDP_FIXED_POINT format (s4,11)
 #define S1615_TO_STDP_RIGHT_SHIFT 4
 
+#ifndef WEIGHT_HOMOGENEOUS
+//! \brief Whether every synapse type shares one weight dependence
+//!     configuration (minimum, maximum and scale factors).
+//! \details The tools write the same configuration for each synapse type, so
+//!     by default the weight state does not carry a pointer to it and the
+//!     updates read a single global instead.  Build with
+//!     `-DWEIGHT_HOMOGENEOUS=0` to allow a configuration per synapse type.
+#define WEIGHT_HOMOGENEOUS 1
+#endif
+
 //! \brief Multiply an accum by an STDP fixed point and return an accum
 static inline accum mul_accum_fixed(accum a, int32_t stdp_fixed) {
     return a * kbits(stdp_fixed << S1615_TO_STDP_RIGHT_SHIFT);
@@ -80,6 +80,9 @@ typedef struct {
 typedef struct stdp_params {
     //! The back-propagation delay, in basic simulation timesteps
     uint32_t backprop_delay;
+    //! \brief The number of post-synaptic events to hold for each neuron;
+    //!     a power of two
+    uint32_t n_post_events;
 } stdp_params;
 
 typedef struct fixed_stdp_synapse {
@@ -103,6 +106,10 @@ static uint32_t num_plastic_pre_synaptic_events = 0;
 //! Count of times that the plastic math became saturated
 static uint32_t plastic_saturation_count = 0;
 
+//! \brief The words at the start of the plastic region of the last row
+//!     processed that include every change
+static uint32_t plastic_words_changed = 0;
+
 /* PRIVATE FUNCTIONS */
 
 // Mark a value as possibly unused while not using any instructions, guaranteed
@@ -151,6 +158,10 @@ uint32_t synapse_dynamics_get_plastic_saturation_count(void) {
     return plastic_saturation_count;
 }
 
+uint32_t synapse_dynamics_get_plastic_words_changed(void) {
+    return plastic_words_changed;
+}
+
 static inline fixed_stdp_synapse synapse_dynamics_stdp_get_fixed(
         uint32_t control_word, uint32_t time, uint32_t colour_delay) {
     // Extract control-word components
@@ -169,23 +180,20 @@ static inline fixed_stdp_synapse synapse_dynamics_stdp_get_fixed(
        .index = synapse_row_sparse_index(
                 control_word, synapse_index_mask),
        .type_index = type_index,
-       .ring_buffer_index = synapse_row_get_ring_buffer_index_combined(
-                (delay_axonal + delay_dendritic + time) - colour_delay, type_index,
-                synapse_type_index_bits, synapse_delay_mask)
+       .ring_buffer_index = synapses_ring_buffer_entry(
+                synapse_row_get_ring_buffer_index_combined(
+                        (delay_axonal + delay_dendritic + time) - colour_delay,
+                        type_index, synapse_type_index_bits,
+                        synapse_delay_mask))
     };
 }
 
 static inline void synapse_dynamics_stdp_update_ring_buffers(
-        weight_t *ring_buffers, fixed_stdp_synapse s, int32_t weight) {
-    uint32_t accumulation = ring_buffers[s.ring_buffer_index] + weight;
-
-    uint32_t sat_test = accumulation & 0xFFFF0000;
-    if (sat_test) {
-        accumulation = 0xFFFF;
+        ring_buffer_t *ring_buffers, fixed_stdp_synapse s, int32_t weight) {
+    if (synapse_row_ring_buffer_add(
+            &ring_buffers[s.ring_buffer_index], weight)) {
         plastic_saturation_count++;
     }
-
-    ring_buffers[s.ring_buffer_index] = accumulation;
 }
 
 //! packing all of the information into the required plastic control word
@@ -19,6 +19,11 @@
 #include "post_events_with_da.h"
 #include "synapse_dynamics_stdp_common.h"
 #include "stdp_typedefs.h"
+#include <bit_field.h>
+
+#if STDP_EAGER_POST
+#error "STDP_EAGER_POST is only supported by the STDP MAD synapse dynamics"
+#endif
 
 typedef struct neuromodulation_data_t {
     uint32_t synapse_type:30;
@@ -76,6 +81,19 @@ static int16_lut *tau_d_lookup;
 
 static uint32_t *nm_weight_shift;
 
+//! \brief The neuromodulator events that reached every neuron, held once
+//!     rather than in the post-synaptic history of each neuron
+static dopamine_event_history_t shared_dopamine_history;
+
+//! The number of neurons on the core
+static uint32_t n_nm_neurons;
+
+//! Scratch bit field to check that a neuromodulation row reaches every neuron
+static bit_field_t nm_targets_seen;
+
+//! The number of words in ::nm_targets_seen
+static uint32_t n_nm_target_words;
+
 extern uint32_t skipped_synapses;
 
 #define DECAY_LOOKUP_TAU_C(time) \
@@ -83,6 +101,17 @@ extern uint32_t skipped_synapses;
 #define DECAY_LOOKUP_TAU_D(time) \
     maths_lut_exponential_decay(time, tau_d_lookup)
 
+//! \brief Decay a dopamine trace
+//! \param[in] trace: The trace to decay
+//! \param[in] time: The time to decay it over
+//! \return The decayed trace
+static inline int16_t decay_dopamine(int16_t trace, uint32_t time) {
+    if (trace == 0) {
+        return 0;
+    }
+    return STDP_FIXED_MUL_16X16(trace, DECAY_LOOKUP_TAU_D(time));
+}
+
 static inline nm_update_state_t get_nm_update_state(
         neuromodulated_synapse_t synapse, index_t synapse_type) {
     accum s1615_weight = kbits(synapse.weight << nm_weight_shift[synapse_type]);
@@ -122,7 +151,8 @@ static inline neuromodulated_synapse_t get_nm_final_synaptic_word(
 static inline post_event_window_t get_post_event_window(
         const post_event_history_t * post_event_history,
         const uint32_t delayed_pre_time, const uint32_t delayed_last_pre_time,
-        const uint32_t delay_dendritic) {
+        const uint32_t delay_dendritic,
+        dopamine_event_window_t *dopamine_window) {
     // Get the post-synaptic window of events to be processed
     const uint32_t window_begin_time =
             (delayed_last_pre_time >= delay_dendritic)
@@ -132,6 +162,8 @@ static inline post_event_window_t get_post_event_window(
             ? (delayed_pre_time - delay_dendritic) : 0;
     post_event_window_t post_window = post_events_get_window_delayed(
             post_event_history, window_begin_time, window_end_time);
+    *dopamine_window = dopamine_events_get_window_delayed(
+            &shared_dopamine_history, window_begin_time, window_end_time);
 
     log_debug("\t\tbegin_time:%u, end_time:%u - prev_time:%u (valid %u), num_events:%u",
             window_begin_time, window_end_time, post_window.prev_time,
@@ -163,6 +195,65 @@ static inline accum get_weight_update(int16_t decay_eligibility_trace,
     return res;
 }
 
+//! \brief Work out again, for each shared neuromodulator event, the weight
+//!     change per unit of eligibility from it up to the newest event.
+//! \details Each is that of the following event decayed by the eligibility
+//!     decay between them, plus that of the interval up to the following
+//!     event, so the change over a run of events that are not broken up by
+//!     post-synaptic events is found from the sums at each end of the run.
+static inline void update_shared_run_sums(void) {
+    dopamine_event_history_t *events = &shared_dopamine_history;
+    int32_t sum = 0;
+    events->run_sums[events->count_minus_one] = 0;
+    // **NOTE** 1st element is always an entry at time 0, so isn't needed
+    for (uint32_t e = events->count_minus_one; e > 1; e--) {
+        uint32_t interval = events->times[e] - events->times[e - 1];
+        int32_t decay_c = DECAY_LOOKUP_TAU_C(interval);
+        int32_t mul_decay = STDP_FIXED_MUL_16X16(
+                decay_c, DECAY_LOOKUP_TAU_D(interval)) - STDP_FIXED_POINT_ONE;
+        sum = STDP_FIXED_MUL_16X16(events->traces[e - 1], mul_decay) +
+                maths_fixed_mul32(sum, decay_c, STDP_FIXED_POINT);
+        events->run_sums[e - 1] = sum;
+    }
+}
+
+//! \brief Catch up a synapse over a run of shared neuromodulator events in
+//!     one step
+//! \param[in] first: The index of the event the synapse is up to
+//! \param[in] last: The index of the event to catch up to
+//! \param[in,out] current_state: The state of the synapse
+//! \param[in,out] last_dopamine_trace:
+//!     The dopamine trace of the events of the neuron alone
+static inline void catch_up_shared_dopamine(
+        uint32_t first, uint32_t last, nm_update_state_t *current_state,
+        int16_t *last_dopamine_trace) {
+    const dopamine_event_history_t *events = &shared_dopamine_history;
+    uint32_t interval = events->times[last] - events->times[first];
+    int32_t decay_c = DECAY_LOOKUP_TAU_C(interval);
+
+    // The change from the shared events, and from the trace of the neuron's
+    // own events, which only decays over the run
+    int32_t sum = events->run_sums[first] - maths_fixed_mul32(
+            events->run_sums[last], decay_c, STDP_FIXED_POINT);
+    if (*last_dopamine_trace != 0) {
+        int32_t mul_decay = STDP_FIXED_MUL_16X16(
+                decay_c, DECAY_LOOKUP_TAU_D(interval)) - STDP_FIXED_POINT_ONE;
+        sum += STDP_FIXED_MUL_16X16(*last_dopamine_trace, mul_decay);
+        *last_dopamine_trace = decay_dopamine(
+                *last_dopamine_trace, interval);
+    }
+    if (sum != 0) {
+        accum eligibility_weight = synapse_structure_get_update_weight(
+                current_state->eligibility_state);
+        current_state->weight += mul_accum_fixed(eligibility_weight, sum) *
+                nm_params.weight_update_constant_component;
+    }
+
+    // C_ij = C_ij.exp(-(t_last-t_first) / tau_C)
+    synapse_structure_decay_weight(&(current_state->eligibility_state),
+            decay_c);
+}
+
 //---------------------------------------
 //! \brief Synapse update loop core
 //! \param[in] time: The current time
@@ -186,24 +277,36 @@ static inline nm_final_state_t izhikevich_neuromodulation_plasticity_update_syna
     const uint32_t delayed_pre_time = time + delay_axonal;
 
     // history <- getHistoryEntries(j, t_old, t)
+    dopamine_event_window_t dopamine_window;
     post_event_window_t post_window = get_post_event_window(
             post_event_history, delayed_pre_time,
-            delayed_last_pre_time, delay_dendritic);
+            delayed_last_pre_time, delay_dendritic, &dopamine_window);
 
     // t_c = t_old
     uint32_t prev_corr_time = delayed_last_pre_time;
 
-    // D_c = D_prev.exp(-t_c - t_prev / tau_D)
+    // D_c = D_prev.exp(-t_c - t_prev / tau_D), kept apart for the events of
+    // this neuron and the events shared by all neurons, which add up
     int16_t last_dopamine_trace = 0;
     if (post_window.prev_time_valid) {
-        last_dopamine_trace = STDP_FIXED_MUL_16X16(
+        last_dopamine_trace = decay_dopamine(
             post_window.prev_trace.dopamine_trace,
-            DECAY_LOOKUP_TAU_D(delayed_last_pre_time - post_window.prev_time));
+            delayed_last_pre_time - post_window.prev_time);
+    }
+    int16_t last_shared_dopamine_trace = 0;
+    if (dopamine_window.prev_time_valid) {
+        last_shared_dopamine_trace = decay_dopamine(
+            dopamine_window.prev_trace,
+            delayed_last_pre_time - dopamine_window.prev_time);
     }
 
-    // Process events in post-synaptic window
-    while (post_window.num_events > 0) {
-        const uint32_t delayed_post_time = *post_window.next_time + delay_dendritic;
+    // Process events in post-synaptic and shared windows in time order
+    while (post_window.num_events > 0 || dopamine_window.num_events > 0) {
+        const bool shared = (post_window.num_events == 0) ||
+                ((dopamine_window.num_events > 0) &&
+                (*dopamine_window.next_time < *post_window.next_time));
+        const uint32_t delayed_post_time = delay_dendritic + (shared ?
+                *dopamine_window.next_time : *post_window.next_time);
 
         log_debug("\t\tApplying post-synaptic event at delayed time:%u, pre:%u, prev_corr:%u",
                 delayed_post_time, delayed_last_pre_time, prev_corr_time);
@@ -213,51 +316,84 @@ static inline nm_final_state_t izhikevich_neuromodulation_plasticity_update_syna
             delayed_post_time - prev_corr_time);
 
         // No point if dopamine trace is 0 as will just multiply by 0
-        if (last_dopamine_trace != 0) {
+        int16_t dopamine_trace =
+                last_dopamine_trace + last_shared_dopamine_trace;
+        if (dopamine_trace != 0) {
             int16_t decay_dopamine_trace = DECAY_LOOKUP_TAU_D(
                         delayed_post_time - prev_corr_time);
             accum eligibility_weight = synapse_structure_get_update_weight(
                     current_state.eligibility_state);
             current_state.weight += get_weight_update(decay_eligibility_trace,
-                    decay_dopamine_trace, last_dopamine_trace, eligibility_weight);
+                    decay_dopamine_trace, dopamine_trace, eligibility_weight);
         }
 
         // C_ij = C_ij.exp(-(t_j-t_c) / tau_C)
         synapse_structure_decay_weight(&(current_state.eligibility_state),
                 decay_eligibility_trace);
 
-        if (!post_events_next_is_dopamine(post_window)) {
-            current_state.eligibility_state = timing_apply_post_spike(
-                delayed_post_time, post_window.next_trace->post_trace,
-                delayed_last_pre_time, last_pre_trace, post_window.prev_time,
-                post_window.prev_trace.post_trace, current_state.eligibility_state);
-        }
-
-        // Update previous correlation to point to this post-event
+        // Update previous correlation to point to this event
         // D_c = D_j
-        last_dopamine_trace = post_window.next_trace->dopamine_trace;
+        if (shared) {
+            last_dopamine_trace = decay_dopamine(
+                    last_dopamine_trace, delayed_post_time - prev_corr_time);
+            last_shared_dopamine_trace = *dopamine_window.next_trace;
+            dopamine_window = dopamine_events_next(dopamine_window);
+
+            // Catch up in one step over any more shared events that come
+            // before the next post-synaptic event
+            uint32_t n_run = dopamine_window.num_events;
+            if (post_window.num_events > 0) {
+                n_run = 0;
+                while (n_run < dopamine_window.num_events &&
+                        dopamine_window.next_time[n_run] <
+                        *post_window.next_time) {
+                    n_run++;
+                }
+            }
+            if (n_run > 0) {
+                uint32_t first = (dopamine_window.next_time - 1) -
+                        shared_dopamine_history.times;
+                catch_up_shared_dopamine(first, first + n_run,
+                        &current_state, &last_dopamine_trace);
+                dopamine_window = dopamine_events_skip(dopamine_window, n_run);
+                last_shared_dopamine_trace = dopamine_window.prev_trace;
+                prev_corr_time = dopamine_window.prev_time + delay_dendritic;
+                continue;
+            }
+        } else {
+            if (!post_events_next_is_dopamine(post_window)) {
+                current_state.eligibility_state = timing_apply_post_spike(
+                    delayed_post_time, post_window.next_trace->post_trace,
+                    delayed_last_pre_time, last_pre_trace, post_window.prev_time,
+                    post_window.prev_trace.post_trace, current_state.eligibility_state);
+            }
+            last_shared_dopamine_trace = decay_dopamine(
+                    last_shared_dopamine_trace,
+                    delayed_post_time - prev_corr_time);
+            last_dopamine_trace = post_window.next_trace->dopamine_trace;
+            post_window = post_events_next(post_window);
+        }
         // t_c = t_j
         prev_corr_time = delayed_post_time;
-
-        // Go onto next event
-        post_window = post_events_next(post_window);
     }
 
     // Apply spike to state only if there has been a post spike ever
-    if (post_window.prev_time_valid) {
+    if (post_window.prev_time_valid || dopamine_window.prev_time_valid) {
         const uint32_t delayed_last_post = post_window.prev_time + delay_dendritic;
         log_debug("\t\tApplying pre-synaptic event at time:%u last post time:%u, prev_corr=%u",
                 delayed_pre_time, delayed_last_post, prev_corr_time);
         int32_t decay_eligibility_trace = DECAY_LOOKUP_TAU_C(
                 delayed_pre_time - prev_corr_time);
 
-        if (last_dopamine_trace != 0) {
+        int16_t dopamine_trace =
+                last_dopamine_trace + last_shared_dopamine_trace;
+        if (dopamine_trace != 0) {
             int32_t decay_dopamine_trace = DECAY_LOOKUP_TAU_D(
                     delayed_pre_time - prev_corr_time);
             accum eligibility_weight = synapse_structure_get_update_weight(
                     current_state.eligibility_state);
             current_state.weight += get_weight_update(decay_eligibility_trace,
-                    decay_dopamine_trace, last_dopamine_trace, eligibility_weight);
+                    decay_dopamine_trace, dopamine_trace, eligibility_weight);
         }
 
         // C_ij = C_ij.exp(-(t-t_c) / tau_C)
@@ -286,6 +422,14 @@ bool synapse_dynamics_initialise(
     if (post_event_history == NULL) {
         return false;
     }
+    dopamine_events_init(&shared_dopamine_history);
+    n_nm_neurons = n_neurons;
+    n_nm_target_words = get_bit_field_size(n_neurons);
+    nm_targets_seen = bit_field_alloc(n_neurons);
+    if (nm_targets_seen == NULL) {
+        log_error("Could not allocate neuromodulation target bit field");
+        return false;
+    }
 
     // Load parameters
     nm_params_t *sdram_params = (nm_params_t *) address;
@@ -390,7 +534,7 @@ void synapse_dynamics_process_post_synaptic_event(
 //---------------------------------------
 static inline neuromodulated_synapse_t process_plastic_synapse(
         uint32_t control_word, uint32_t last_pre_time, pre_trace_t last_pre_trace,
-		pre_trace_t new_pre_trace, weight_t *ring_buffers, uint32_t time,
+		pre_trace_t new_pre_trace, ring_buffer_t *ring_buffers, uint32_t time,
 		uint32_t colour_delay, neuromodulated_synapse_t synapse) {
     fixed_stdp_synapse s = synapse_dynamics_stdp_get_fixed(control_word, time,
             colour_delay);
@@ -420,6 +564,30 @@ static inline neuromodulated_synapse_t process_plastic_synapse(
     return get_nm_final_synaptic_word(final_state);
 }
 
+//! \brief Check whether a neuromodulation row reaches every neuron on the
+//!     core once, all with the same concentration
+//! \param[in] words: The words of the row
+//! \param[in] n_synapses: The number of words in the row
+//! \return Whether the row reaches every neuron in the same way
+static inline bool is_broadcast_neuromodulation(
+        const uint32_t *words, uint32_t n_synapses) {
+    if (n_synapses != n_nm_neurons) {
+        return false;
+    }
+    clear_bit_field(nm_targets_seen, n_nm_target_words);
+    uint32_t weight = synapse_row_sparse_weight(words[0]);
+    for (uint32_t i = 0; i < n_synapses; i++) {
+        uint32_t neuron_index = synapse_row_sparse_index(words[i], 0xFFFF);
+        if (synapse_row_sparse_weight(words[i]) != weight
+                || neuron_index >= n_nm_neurons
+                || bit_field_test(nm_targets_seen, neuron_index)) {
+            return false;
+        }
+        bit_field_set(nm_targets_seen, neuron_index);
+    }
+    return true;
+}
+
 static inline void process_neuromodulation(
         synapse_row_plastic_data_t *plastic_region_address,
         synapse_row_fixed_part_t *fixed_region, uint32_t time) {
@@ -427,6 +595,24 @@ static inline void process_neuromodulation(
     uint32_t n_synapses = synapse_row_num_plastic_controls(fixed_region);
     const uint32_t *words = (uint32_t *) synapse_row_plastic_controls(fixed_region);
 
+    // If every neuron gets the same, add it once to the shared history
+    if (n_synapses > 0 && is_broadcast_neuromodulation(words, n_synapses)) {
+        int32_t concentration = (int32_t) synapse_row_sparse_weight(words[0]);
+        if (!reward) {
+            concentration = -concentration;
+        }
+        const uint32_t last_time = shared_dopamine_history.times[
+                shared_dopamine_history.count_minus_one];
+        const int16_t last_trace = shared_dopamine_history.traces[
+                shared_dopamine_history.count_minus_one];
+        int32_t new_dopamine_trace =
+                decay_dopamine(last_trace, time - last_time);
+        new_dopamine_trace += concentration;
+        dopamine_events_add(time, &shared_dopamine_history, new_dopamine_trace);
+        update_shared_run_sums();
+        return;
+    }
+
     // Loop through synapses
     for (; n_synapses > 0; n_synapses--) {
         // Get next control word (auto incrementing)
@@ -460,7 +646,7 @@ static inline void process_neuromodulation(
 bool synapse_dynamics_process_plastic_synapses(
         synapse_row_plastic_data_t *plastic_region_address,
         synapse_row_fixed_part_t *fixed_region,
-        weight_t *ring_buffers, uint32_t time, uint32_t colour_delay,
+        ring_buffer_t *ring_buffers, uint32_t time, uint32_t colour_delay,
         bool *write_back) {
 
     // If the flag is set, this is neuromodulation
@@ -499,6 +685,8 @@ bool synapse_dynamics_process_plastic_synapses(
                 colour_delay, plastic_words[0]);
         plastic_words++;
     }
+    plastic_words_changed = synapse_row_plastic_words_to(
+            plastic_region_address, plastic_words);
     *write_back = true;
     return true;
 }
@@ -509,6 +697,11 @@ static inline neuromodulated_synapse_t *get_plastic_synapses(synaptic_row_t row)
     return plastic_data->synapses;
 }
 
+uint32_t synapse_dynamics_get_plastic_header_words(void) {
+    // The header of a neuromodulation row is not a history
+    return 0;
+}
+
 bool synapse_dynamics_find_neuron(
         uint32_t id, synaptic_row_t row, weight_t *weight, uint16_t *delay,
         uint32_t *offset, uint32_t *synapse_type) {
@@ -18,6 +18,11 @@
 //! \brief STDP core implementation
 #include "post_events.h"
 #include "synapse_dynamics_stdp_common.h"
+#include "stdp_fused_kernels.h"
+#if STDP_EAGER_POST
+#include <bit_field.h>
+#include <neuron/dma_common.h>
+#endif
 
 //! The format of the plastic data region of a synaptic row
 struct synapse_row_plastic_data_t {
@@ -29,6 +34,52 @@ struct synapse_row_plastic_data_t {
 
 extern uint32_t skipped_synapses;
 
+#if STDP_EAGER_POST
+//! The most index entries read from SDRAM at once
+#define EAGER_POST_BATCH 16
+
+//! The most synapses in the plastic region of a row
+#define EAGER_POST_MAX_SYNAPSES 256
+
+//! The index of the plastic synapses of each neuron
+static post_index_t *post_index = NULL;
+
+//! \brief The time up to which the post-synaptic spikes of each neuron have
+//!     been applied to all its plastic synapses
+static uint32_t *post_applied_time;
+
+//! The neurons that have spiked in the current time step
+static bit_field_t post_spiked;
+
+//! The neurons with spikes from earlier time steps still to be applied
+static bit_field_t post_pending;
+
+//! The number of words of ::post_spiked and ::post_pending
+static uint32_t post_pending_words;
+
+//! The time step of the spikes in ::post_spiked
+static uint32_t post_spiked_time = 0;
+
+//! Where the entries of a neuron are read into
+static post_index_entry_t eager_entries[EAGER_POST_BATCH];
+
+//! Where the plastic region of a row is read into, up to the synapse updated
+static synapse_row_plastic_data_t *eager_region;
+
+//! \brief Get the time up to which the post-synaptic spikes of a neuron have
+//!     been applied to all its plastic synapses, so they are not applied again
+//! \param[in] history: The post-synaptic spikes of the neuron
+//! \return The time, or 0 if none have been applied
+static inline uint32_t eager_post_applied_time(
+        const post_event_history_t *history) {
+    if (post_index == NULL) {
+        return 0;
+    }
+    uint32_t neuron = history - post_event_history;
+    return (neuron < post_index->n_neurons) ? post_applied_time[neuron] : 0;
+}
+#endif
+
 //---------------------------------------
 //! \brief Synapse update loop core
 //! \param[in] time: The current time
@@ -38,28 +89,41 @@ extern uint32_t skipped_synapses;
 //! \param[in] delay_dendritic: The dendritic delay for the synapse
 //! \param[in] delay_axonal: The axonal delay for the synapse
 //! \param[in] current_state: The current state
-//! \param[in] post_event_history: The history
+//! \param[in,out] post_event_history: The history
 //! \return The new basic state of the synapse
 static inline final_state_t plasticity_update_synapse(
         const uint32_t time,
         const uint32_t last_pre_time, const pre_trace_t last_pre_trace,
         const pre_trace_t new_pre_trace, const uint32_t delay_dendritic,
         const uint32_t delay_axonal, update_state_t current_state,
-        const post_event_history_t *post_event_history) {
+        post_event_history_t *post_event_history) {
     // Apply axonal delay to time of last presynaptic spike
     const uint32_t delayed_last_pre_time = last_pre_time + delay_axonal;
 
     // Get the post-synaptic window of events to be processed
-    const uint32_t window_begin_time =
+    uint32_t window_begin_time =
             (delayed_last_pre_time >= delay_dendritic)
             ? (delayed_last_pre_time - delay_dendritic) : 0;
+#if STDP_EAGER_POST
+    // Spikes that have been applied as they happened are not applied again
+    uint32_t applied_time = eager_post_applied_time(post_event_history);
+    if (applied_time > window_begin_time) {
+        window_begin_time = applied_time;
+    }
+#endif
     const uint32_t delayed_pre_time = time + delay_axonal;
     const uint32_t window_end_time =
             (delayed_pre_time >= delay_dendritic)
             ? (delayed_pre_time - delay_dendritic) : 0;
-    post_event_window_t post_window = post_events_get_window_delayed(
+    post_event_window_t post_window = post_events_get_window_cached(
             post_event_history, window_begin_time, window_end_time);
 
+#if STDP_HAS_FUSED_KERNEL
+    __use(new_pre_trace);
+    return plasticity_update_synapse_fused(time, last_pre_time,
+            last_pre_trace, delay_dendritic, delay_axonal, current_state,
+            post_window);
+#else
     log_debug("\tPerforming deferred synapse update at time:%u", time);
     log_debug("\t\tbegin_time:%u, end_time:%u - prev_time:%u (valid %u), num_events:%u",
             window_begin_time, window_end_time, post_window.prev_time,
@@ -73,16 +137,17 @@ static inline final_state_t plasticity_update_synapse(
 
     // Process events in post-synaptic window
     while (post_window.num_events > 0) {
-        const uint32_t delayed_post_time = *post_window.next_time + delay_dendritic;
+        const uint32_t delayed_post_time =
+                post_events_next_time(&post_window) + delay_dendritic;
 
         log_debug("\t\tApplying post-synaptic event at delayed time:%u, pre:%u\n",
                 delayed_post_time, delayed_last_pre_time);
 
         // Apply spike to state
         current_state = timing_apply_post_spike(
-                delayed_post_time, *post_window.next_trace, delayed_last_pre_time,
-                last_pre_trace, post_window.prev_time, post_window.prev_trace,
-                current_state);
+                delayed_post_time, post_events_next_trace(&post_window),
+                delayed_last_pre_time, last_pre_trace, post_window.prev_time,
+                post_window.prev_trace, current_state);
 
         // Go onto next event
         post_window = post_events_next(post_window);
@@ -100,6 +165,7 @@ static inline final_state_t plasticity_update_synapse(
 
     // Return final synaptic word and weight
     return synapse_structure_get_final_state(current_state);
+#endif
 }
 
 bool synapse_dynamics_initialise(
@@ -111,7 +177,8 @@ bool synapse_dynamics_initialise(
         return false;
     }
 
-    post_event_history = post_events_init_buffers(n_neurons);
+    post_event_history = post_events_init_buffers(
+            n_neurons, params.n_post_events);
     if (post_event_history == NULL) {
         return false;
     }
@@ -185,17 +252,21 @@ void synapse_dynamics_process_post_synaptic_event(
 
     // Add post-event
     post_event_history_t *history = &post_event_history[neuron_index];
-    const uint32_t last_post_time = history->times[history->count_minus_one];
-    const post_trace_t last_post_trace =
-            history->traces[history->count_minus_one];
+    const uint32_t last_post_time = post_events_last_time(history);
+    const post_trace_t last_post_trace = post_events_last_trace(history);
     post_events_add(time, history,
             timing_add_post_spike(time, last_post_time, last_post_trace));
+#if STDP_EAGER_POST
+    if (post_index != NULL && neuron_index < post_index->n_neurons) {
+        bit_field_set(post_spiked, neuron_index);
+    }
+#endif
 }
 
 //---------------------------------------
 static inline plastic_synapse_t process_plastic_synapse(
         uint32_t control_word, uint32_t last_pre_time, pre_trace_t last_pre_trace,
-		pre_trace_t new_pre_trace, weight_t *ring_buffers, uint32_t time,
+		pre_trace_t new_pre_trace, ring_buffer_t *ring_buffers, uint32_t time,
 		uint32_t colour_delay, plastic_synapse_t synapse) {
     fixed_stdp_synapse s = synapse_dynamics_stdp_get_fixed(control_word, time,
             colour_delay);
@@ -228,7 +299,7 @@ static inline plastic_synapse_t process_plastic_synapse(
 bool synapse_dynamics_process_plastic_synapses(
         synapse_row_plastic_data_t *plastic_region_address,
         synapse_row_fixed_part_t *fixed_region,
-        weight_t *ring_buffers, uint32_t time, uint32_t colour_delay,
+        ring_buffer_t *ring_buffers, uint32_t time, uint32_t colour_delay,
         bool *write_back) {
     // Extract separate arrays of plastic synapses (from plastic region),
     // Control words (from fixed region) and number of plastic synapses
@@ -248,21 +319,176 @@ bool synapse_dynamics_process_plastic_synapses(
     plastic_region_address->history.prev_trace =
             timing_add_pre_spike(time - colour_delay, last_pre_time, last_pre_trace);
 
-    // Loop through plastic synapses
+    // Loop through plastic synapses, noting the last one that changes so
+    // that the unchanged synapses after it aren't written back; the history
+    // always changes
+    const plastic_synapse_t *end_of_changes = plastic_words;
     for (; n_plastic_synapses > 0; n_plastic_synapses--) {
         // Get next control word (auto incrementing)
         uint32_t control_word = *control_words++;
 
-        plastic_words[0] = process_plastic_synapse(
+        plastic_synapse_t new_word = process_plastic_synapse(
                 control_word, last_pre_time, last_pre_trace,
                 plastic_region_address->history.prev_trace, ring_buffers, time,
                 colour_delay, plastic_words[0]);
+        if (__builtin_memcmp(&new_word, plastic_words,
+                sizeof(plastic_synapse_t)) != 0) {
+            plastic_words[0] = new_word;
+            end_of_changes = &plastic_words[1];
+        }
         plastic_words++;
     }
+    plastic_words_changed = synapse_row_plastic_words_to(
+            plastic_region_address, end_of_changes);
     *write_back = true;
     return true;
 }
 
+uint32_t synapse_dynamics_get_plastic_header_words(void) {
+    // The history is all there is before the synapses
+    return (sizeof(synapse_row_plastic_data_t) + sizeof(uint32_t) - 1)
+            / sizeof(uint32_t);
+}
+
+#if STDP_EAGER_POST
+bool synapse_dynamics_eager_post_initialise(post_index_t *index) {
+    if (index == NULL) {
+        log_error("No index of the plastic synapses of each neuron");
+        return false;
+    }
+    uint32_t n_neurons = index->n_neurons;
+    if (n_neurons > 0) {
+        post_applied_time = spin1_malloc(n_neurons * sizeof(uint32_t));
+        post_spiked = bit_field_alloc(n_neurons);
+        post_pending = bit_field_alloc(n_neurons);
+        eager_region = spin1_malloc(sizeof(synapse_row_plastic_data_t)
+                + EAGER_POST_MAX_SYNAPSES * sizeof(plastic_synapse_t));
+        if (post_applied_time == NULL || post_spiked == NULL
+                || post_pending == NULL || eager_region == NULL) {
+            log_error("Could not allocate dtcm to apply the post-synaptic "
+                    "spikes of %u neurons", n_neurons);
+            return false;
+        }
+        post_pending_words = get_bit_field_size(n_neurons);
+        clear_bit_field(post_spiked, post_pending_words);
+        clear_bit_field(post_pending, post_pending_words);
+        for (uint32_t n = 0; n < n_neurons; n++) {
+            post_applied_time[n] = 0;
+        }
+    }
+    post_index = index;
+    log_info("Applying post-synaptic spikes to %u plastic synapses as they "
+            "happen", index->starts[n_neurons]);
+    return true;
+}
+
+//! \brief Apply the post-synaptic spikes of a neuron to one of its synapses
+//! \param[in] entry: The synapse to update
+//! \param[in] history: The post-synaptic spikes of the neuron
+//! \param[in] begin_time: The time up to which the spikes have been applied
+//! \param[in] end_time: The time up to which to apply the spikes
+//! \return Whether there were any spikes to apply
+static inline bool eager_post_update_synapse(post_index_entry_t entry,
+        const post_event_history_t *history, uint32_t begin_time,
+        uint32_t end_time) {
+    // Read the plastic region of the row, up to the synapse
+    plastic_synapse_t *synapse = &eager_region->synapses[entry.synapse_index];
+    uint32_t n_words = synapse_row_plastic_words_to(eager_region, &synapse[1]);
+    synapse_row_plastic_data_t *sdram_region =
+            synapse_row_plastic_region(entry.row);
+    do_fast_dma_read(sdram_region, eager_region, n_words * sizeof(uint32_t));
+    wait_for_dma_to_complete();
+
+    // Apply the spikes since the last pre-synaptic spike of the row, as
+    // would be done when the row is next read
+    const uint32_t last_pre_time = eager_region->history.prev_time;
+    const pre_trace_t last_pre_trace = eager_region->history.prev_trace;
+    post_event_window_t window = post_events_get_window_delayed(history,
+            (last_pre_time > begin_time) ? last_pre_time : begin_time,
+            end_time);
+    if (window.num_events == 0) {
+        return false;
+    }
+    update_state_t state = synapse_structure_get_update_state(
+            *synapse, entry.synapse_type);
+    while (window.num_events > 0) {
+        state = timing_apply_post_spike(
+                post_events_next_time(&window),
+                post_events_next_trace(&window), last_pre_time,
+                last_pre_trace, window.prev_time, window.prev_trace, state);
+        window = post_events_next(window);
+    }
+    *synapse = synapse_structure_get_final_synaptic_word(
+            synapse_structure_get_final_state(state));
+
+    // Write back only the words that hold the synapse
+    uint32_t first_word = ((uint8_t *) synapse - (uint8_t *) eager_region)
+            / sizeof(uint32_t);
+    synapses_mark_row_dirty(entry.row);
+    do_fast_dma_write(&((uint32_t *) eager_region)[first_word],
+            &((uint32_t *) sdram_region)[first_word],
+            (n_words - first_word) * sizeof(uint32_t));
+    wait_for_dma_to_complete();
+    return true;
+}
+
+uint32_t synapse_dynamics_apply_post_spikes_eagerly(uint32_t time) {
+    // Spikes are applied once their time step is over, so that no more
+    // spikes of that time step can arrive after they have been applied
+    if (time != post_spiked_time) {
+        for (uint32_t w = 0; w < post_pending_words; w++) {
+            post_pending[w] |= post_spiked[w];
+            post_spiked[w] = 0;
+        }
+        post_spiked_time = time;
+    }
+
+    // Find a neuron with spikes to apply
+    uint32_t w = 0;
+    while (w < post_pending_words && post_pending[w] == 0) {
+        w++;
+    }
+    if (w == post_pending_words) {
+        return 0;
+    }
+    uint32_t neuron = (w << 5) + __builtin_ctz(post_pending[w]);
+    bit_field_clear(post_pending, neuron);
+
+    // A neuron can be found again for spikes already applied with those of
+    // an earlier time step
+    uint32_t begin_time = post_applied_time[neuron];
+    uint32_t end_time = time - 1;
+    const post_event_history_t *history = &post_event_history[neuron];
+    if (post_events_last_time(history) <= begin_time) {
+        return 0;
+    }
+
+    // Update all the synapses of the neuron before anything else reads
+    // them, so that none see the spikes as not yet applied
+    post_index_entry_t *entries = post_index_entries(post_index);
+    uint32_t end = post_index->starts[neuron + 1];
+    uint32_t n_updated = 0;
+    for (uint32_t next = post_index->starts[neuron]; next < end;
+            next += EAGER_POST_BATCH) {
+        uint32_t n_entries = end - next;
+        if (n_entries > EAGER_POST_BATCH) {
+            n_entries = EAGER_POST_BATCH;
+        }
+        do_fast_dma_read(&entries[next], eager_entries,
+                n_entries * sizeof(post_index_entry_t));
+        wait_for_dma_to_complete();
+        for (uint32_t i = 0; i < n_entries; i++) {
+            if (eager_post_update_synapse(eager_entries[i], history,
+                    begin_time, end_time)) {
+                n_updated++;
+            }
+        }
+    }
+    post_applied_time[neuron] = end_time;
+    return n_updated;
+}
+#endif
+
 bool synapse_dynamics_find_neuron(
         uint32_t id, synaptic_row_t row, weight_t *weight, uint16_t *delay,
         uint32_t *offset, uint32_t *synapse_type) {
@@ -30,6 +30,20 @@
 
 static mars_kiss64_seed_t seed = {123456789, 234567891, 345678912, 456789123};
 
+//! \brief Random bits not yet used, shared by every draw on the core so that
+//!     each 32-bit number from the generator gives more than one draw
+static uint32_t random_pool = 0;
+
+//! The number of bits in ::random_pool not yet used
+static uint32_t random_pool_bits = 0;
+
 static inline int32_t mars_kiss_fixed_point(void) {
-    return (int32_t) (mars_kiss64_seed(seed) & (STDP_FIXED_POINT_ONE - 1));
+    if (random_pool_bits < STDP_FIXED_POINT) {
+        random_pool = mars_kiss64_seed(seed);
+        random_pool_bits = 32;
+    }
+    int32_t random = (int32_t) (random_pool & (STDP_FIXED_POINT_ONE - 1));
+    random_pool >>= STDP_FIXED_POINT;
+    random_pool_bits -= STDP_FIXED_POINT;
+    return random;
 }
@@ -19,6 +19,9 @@
 #ifndef _TIMING_PAIR_IMPL_H_
 #define _TIMING_PAIR_IMPL_H_
 
+//! Identifies the rule, for the specialised updates of stdp_fused_kernels.h
+#define TIMING_RULE_PAIR
+
 //---------------------------------------
 // Typedefines
 //---------------------------------------
@@ -31,6 +31,9 @@ int16_lut *tau_x_lookup;
 //! Lookup table for &tau;<sup><i>y</i></sup> exponential decay
 int16_lut *tau_y_lookup;
 
+//! Cache of decayed o1 traces, shared by the synapses onto each neuron
+decay_cache_entry_t o1_cache[DECAY_CACHE_SIZE];
+
 //---------------------------------------
 // Functions
 //---------------------------------------
@@ -43,6 +46,7 @@ address_t timing_initialise(address_t address) {
     tau_minus_lookup = maths_copy_int16_lut(&lut_address);
     tau_x_lookup = maths_copy_int16_lut(&lut_address);
     tau_y_lookup = maths_copy_int16_lut(&lut_address);
+    maths_init_decay_cache(o1_cache);
 
     return lut_address;
 }
@@ -60,6 +60,7 @@ extern int16_lut *tau_plus_lookup;
 extern int16_lut *tau_minus_lookup;
 extern int16_lut *tau_x_lookup;
 extern int16_lut *tau_y_lookup;
+extern decay_cache_entry_t o1_cache[DECAY_CACHE_SIZE];
 
 //---------------------------------------
 // Timing dependence inline functions
@@ -162,8 +163,8 @@ static inline update_state_t timing_apply_pre_spike(
         post_trace_t last_post_trace, update_state_t previous_state) {
     // Get time of event relative to last post-synaptic event
     uint32_t time_since_last_post = time - last_post_time;
-    int32_t decayed_o1 = STDP_FIXED_MUL_16X16(last_post_trace.o1,
-        maths_lut_exponential_decay(time_since_last_post, tau_minus_lookup));
+    int32_t decayed_o1 = maths_cached_decay(o1_cache, time_since_last_post,
+            last_post_trace.o1, tau_minus_lookup, STDP_FIXED_POINT);
 
     // Calculate triplet term
     int32_t decayed_o1_r2 = STDP_FIXED_MUL_16X16(decayed_o1, trace.r2);
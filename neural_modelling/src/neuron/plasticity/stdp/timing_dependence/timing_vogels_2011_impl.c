@@ -24,6 +24,10 @@
 //! Lookup table for pre-computed _&tau;_
 int16_lut *tau_lookup;
 
+//! \brief Cache of decayed traces; the pre and post traces decay with the
+//!     same time constant, so they share it
+decay_cache_entry_t tau_cache[DECAY_CACHE_SIZE];
+
 //! Global plasticity parameter data
 plasticity_trace_region_data_t plasticity_trace_region_data;
 
@@ -47,6 +51,7 @@ address_t timing_initialise(address_t address) {
     // Copy LUTs from following memory
     address_t lut_address = config->lut_data;
     tau_lookup = maths_copy_int16_lut(&lut_address);
+    maths_init_decay_cache(tau_cache);
 
     log_info("timing_initialise: completed successfully");
 
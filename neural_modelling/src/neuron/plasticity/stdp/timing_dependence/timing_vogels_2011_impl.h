@@ -56,6 +56,7 @@ typedef struct {
 // Externals
 //---------------------------------------
 extern int16_lut *tau_lookup;
+extern decay_cache_entry_t tau_cache[DECAY_CACHE_SIZE];
 
 //---------------------------------------
 // Timing dependence inline functions
@@ -137,9 +138,8 @@ static inline update_state_t timing_apply_pre_spike(
 
     // Get time of event relative to last post-synaptic event
     uint32_t time_since_last_post = time - last_post_time;
-    int32_t exponential_decay = maths_lut_exponential_decay(
-            time_since_last_post, tau_lookup);
-    int32_t decayed_o1 = STDP_FIXED_MUL_16X16(last_post_trace, exponential_decay)
+    int32_t decayed_o1 = maths_cached_decay(tau_cache, time_since_last_post,
+            last_post_trace, tau_lookup, STDP_FIXED_POINT)
             - plasticity_trace_region_data.alpha;
 
     log_debug("\t\t\ttime_since_last_post_event=%u, decayed_o1=%d\n",
@@ -165,9 +165,8 @@ static inline update_state_t timing_apply_post_spike(
         UNUSED post_trace_t last_post_trace, update_state_t previous_state) {
     // Get time of event relative to last pre-synaptic event
     uint32_t time_since_last_pre = time - last_pre_time;
-    int32_t exponential_decay = maths_lut_exponential_decay(
-            time_since_last_pre, tau_lookup);
-    int32_t decayed_r1 = STDP_FIXED_MUL_16X16(last_pre_trace, exponential_decay);
+    int32_t decayed_r1 = maths_cached_decay(tau_cache, time_since_last_pre,
+            last_pre_trace, tau_lookup, STDP_FIXED_POINT);
 
     log_debug("\t\t\ttime_since_last_pre_event=%u, decayed_r1=%d\n",
             time_since_last_pre, decayed_r1);
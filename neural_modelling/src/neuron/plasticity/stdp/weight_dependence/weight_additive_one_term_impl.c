@@ -21,8 +21,13 @@
 //---------------------------------------
 // Globals
 //---------------------------------------
+#if WEIGHT_HOMOGENEOUS
+//! Global plasticity parameter data, shared by all synapse types, in DTCM
+plasticity_weight_region_data_t plasticity_weight_region_data[1];
+#else
 //! Global plasticity parameter data
 plasticity_weight_region_data_t *plasticity_weight_region_data;
+#endif
 
 //! Plasticity multiply shift array, in DTCM
 uint32_t *weight_shift;
@@ -46,12 +51,16 @@ address_t weight_initialise(
     // **NOTE** this seems somewhat safer than relying on sizeof
     additive_one_term_config_t *config = (additive_one_term_config_t *) address;
 
+#if WEIGHT_HOMOGENEOUS
+    plasticity_weight_region_data_t *dtcm_copy = plasticity_weight_region_data;
+#else
     plasticity_weight_region_data_t *dtcm_copy = plasticity_weight_region_data =
             spin1_malloc(sizeof(plasticity_weight_region_data_t) * n_synapse_types);
     if (dtcm_copy == NULL) {
         log_error("Could not initialise weight region data");
         return NULL;
     }
+#endif
 
     weight_shift = spin1_malloc(sizeof(uint32_t) * n_synapse_types);
     if (weight_shift == NULL) {
@@ -60,14 +69,28 @@ address_t weight_initialise(
     }
 
     for (uint32_t s = 0; s < n_synapse_types; s++, config++) {
+        // Copy weight shift
+        weight_shift[s] = ring_buffer_to_input_buffer_left_shifts[s];
+
+        // Only the first configuration is kept if they are all the same
+        if (WEIGHT_HOMOGENEOUS && s > 0) {
+            if (config->min_weight != dtcm_copy[0].min_weight ||
+                    config->max_weight != dtcm_copy[0].max_weight ||
+                    config->a2_plus != dtcm_copy[0].a2_plus ||
+                    config->a2_minus != dtcm_copy[0].a2_minus) {
+                log_error("Synapse type %u has different weight parameters to"
+                        " synapse type 0; build with WEIGHT_HOMOGENEOUS=0", s);
+                return NULL;
+            }
+            continue;
+        }
+
+        // Copy parameters
         dtcm_copy[s].min_weight = config->min_weight;
         dtcm_copy[s].max_weight = config->max_weight;
         dtcm_copy[s].a2_plus = config->a2_plus;
         dtcm_copy[s].a2_minus = config->a2_minus;
 
-        // Copy weight shift
-        weight_shift[s] = ring_buffer_to_input_buffer_left_shifts[s];
-
         log_debug("\tSynapse type %u: Min weight:%k, Max weight:%k, A2+:%k, A2-:%k",
                 s, dtcm_copy[s].min_weight, dtcm_copy[s].max_weight,
                 dtcm_copy[s].a2_plus, dtcm_copy[s].a2_minus);
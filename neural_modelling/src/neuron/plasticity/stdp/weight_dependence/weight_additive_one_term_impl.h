@@ -19,6 +19,9 @@
 #ifndef _WEIGHT_ADDITIVE_ONE_TERM_IMPL_H_
 #define _WEIGHT_ADDITIVE_ONE_TERM_IMPL_H_
 
+//! Identifies the rule, for the specialised updates of stdp_fused_kernels.h
+#define WEIGHT_RULE_ADDITIVE_ONE_TERM
+
 // Include generic plasticity maths functions
 #include <neuron/plasticity/stdp/maths.h>
 #include <neuron/plasticity/stdp/stdp_typedefs.h>
@@ -44,8 +47,10 @@ typedef struct {
 
     uint32_t weight_shift; //!< Weight shift to S1615 version
 
+#if !WEIGHT_HOMOGENEOUS
     //! Reference to the configuration data
     const plasticity_weight_region_data_t *weight_region;
+#endif
 } weight_state_t;
 
 #include "weight_one_term.h"
@@ -53,6 +58,24 @@ typedef struct {
 //---------------------------------------
 // STDP weight dependence functions
 //---------------------------------------
+/*!
+ * \brief Gets the configuration of the rule that applies to a weight state
+ * \param[in] state: The weight state
+ * \return The configuration
+ */
+#if WEIGHT_HOMOGENEOUS
+static inline const plasticity_weight_region_data_t *weight_get_region(
+        UNUSED weight_state_t state) {
+    extern plasticity_weight_region_data_t plasticity_weight_region_data[];
+    return &plasticity_weight_region_data[0];
+}
+#else
+static inline const plasticity_weight_region_data_t *weight_get_region(
+        weight_state_t state) {
+    return state.weight_region;
+}
+#endif
+
 /*!
  * \brief Gets the initial weight state.
  * \param[in] weight: The weight at the start
@@ -61,14 +84,18 @@ typedef struct {
  */
 static inline weight_state_t weight_get_initial(
         weight_t weight, index_t synapse_type) {
+#if !WEIGHT_HOMOGENEOUS
     extern plasticity_weight_region_data_t *plasticity_weight_region_data;
+#endif
     extern uint32_t *weight_shift;
 
     accum s1615_weight = kbits(weight << weight_shift[synapse_type]);
     return (weight_state_t) {
         .weight = s1615_weight,
         .weight_shift = weight_shift[synapse_type],
+#if !WEIGHT_HOMOGENEOUS
         .weight_region = &plasticity_weight_region_data[synapse_type]
+#endif
     };
 }
 
@@ -79,8 +106,10 @@ static inline weight_state_t weight_get_initial(
 //! \return the updated weight state
 static inline weight_state_t weight_one_term_apply_depression(
         weight_state_t state, int32_t a2_minus) {
-    state.weight -= mul_accum_fixed(state.weight_region->a2_minus, a2_minus);
-    state.weight = kbits(MAX(bitsk(state.weight), bitsk(state.weight_region->min_weight)));
+    const plasticity_weight_region_data_t *region =
+            weight_get_region(state);
+    state.weight -= mul_accum_fixed(region->a2_minus, a2_minus);
+    state.weight = kbits(MAX(bitsk(state.weight), bitsk(region->min_weight)));
     return state;
 }
 
@@ -91,8 +120,10 @@ static inline weight_state_t weight_one_term_apply_depression(
 //! \return the updated weight state
 static inline weight_state_t weight_one_term_apply_potentiation(
         weight_state_t state, int32_t a2_plus) {
-    state.weight += mul_accum_fixed(state.weight_region->a2_plus, a2_plus);
-    state.weight = kbits(MIN(bitsk(state.weight), bitsk(state.weight_region->max_weight)));
+    const plasticity_weight_region_data_t *region =
+            weight_get_region(state);
+    state.weight += mul_accum_fixed(region->a2_plus, a2_plus);
+    state.weight = kbits(MIN(bitsk(state.weight), bitsk(region->max_weight)));
     return state;
 }
 
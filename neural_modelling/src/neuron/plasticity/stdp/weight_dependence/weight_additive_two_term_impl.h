@@ -45,8 +45,10 @@ typedef struct weight_state_t {
     accum weight;         //!< The weight
     uint32_t weight_shift;  //!< Shift of weight to and from S1615 format
 
+#if !WEIGHT_HOMOGENEOUS
     //! Reference to the configuration data
     const plasticity_weight_region_data_t *weight_region;
+#endif
 } weight_state_t;
 
 #include "weight_two_term.h"
@@ -54,6 +56,24 @@ typedef struct weight_state_t {
 //---------------------------------------
 // STDP weight dependence functions
 //---------------------------------------
+/*!
+ * \brief Gets the configuration of the rule that applies to a weight state
+ * \param[in] state: The weight state
+ * \return The configuration
+ */
+#if WEIGHT_HOMOGENEOUS
+static inline const plasticity_weight_region_data_t *weight_get_region(
+        UNUSED weight_state_t state) {
+    extern plasticity_weight_region_data_t plasticity_weight_region_data[];
+    return &plasticity_weight_region_data[0];
+}
+#else
+static inline const plasticity_weight_region_data_t *weight_get_region(
+        weight_state_t state) {
+    return state.weight_region;
+}
+#endif
+
 /*!
  * \brief Gets the initial weight state.
  * \param[in] weight: The weight at the start
@@ -62,7 +82,9 @@ typedef struct weight_state_t {
  */
 static inline weight_state_t weight_get_initial(
         weight_t weight, index_t synapse_type) {
+#if !WEIGHT_HOMOGENEOUS
     extern plasticity_weight_region_data_t *plasticity_weight_region_data;
+#endif
     extern uint32_t *weight_shift;
 
     accum s1615_weight = kbits(weight << weight_shift[synapse_type]);
@@ -70,7 +92,9 @@ static inline weight_state_t weight_get_initial(
     return (weight_state_t) {
         .weight = s1615_weight,
         .weight_shift = weight_shift[synapse_type],
+#if !WEIGHT_HOMOGENEOUS
         .weight_region = &plasticity_weight_region_data[synapse_type]
+#endif
     };
 }
 
@@ -82,9 +106,11 @@ static inline weight_state_t weight_get_initial(
 //! \return the updated weight state
 static inline weight_state_t weight_two_term_apply_depression(
         weight_state_t state, int32_t a2_minus, int32_t a3_minus) {
-    state.weight -= mul_accum_fixed(state.weight_region->a2_minus, a2_minus);
-    state.weight -= mul_accum_fixed(state.weight_region->a3_minus, a3_minus);
-    state.weight = kbits(MAX(bitsk(state.weight), bitsk(state.weight_region->min_weight)));
+    const plasticity_weight_region_data_t *region =
+            weight_get_region(state);
+    state.weight -= mul_accum_fixed(region->a2_minus, a2_minus);
+    state.weight -= mul_accum_fixed(region->a3_minus, a3_minus);
+    state.weight = kbits(MAX(bitsk(state.weight), bitsk(region->min_weight)));
     return state;
 }
 
@@ -96,9 +122,11 @@ static inline weight_state_t weight_two_term_apply_depression(
 //! \return the updated weight state
 static inline weight_state_t weight_two_term_apply_potentiation(
         weight_state_t state, int32_t a2_plus, int32_t a3_plus) {
-    state.weight += mul_accum_fixed(state.weight_region->a2_plus, a2_plus);
-    state.weight += mul_accum_fixed(state.weight_region->a3_plus, a3_plus);
-    state.weight = kbits(MIN(bitsk(state.weight), bitsk(state.weight_region->max_weight)));
+    const plasticity_weight_region_data_t *region =
+            weight_get_region(state);
+    state.weight += mul_accum_fixed(region->a2_plus, a2_plus);
+    state.weight += mul_accum_fixed(region->a3_plus, a3_plus);
+    state.weight = kbits(MIN(bitsk(state.weight), bitsk(region->max_weight)));
     return state;
 }
 
@@ -19,6 +19,9 @@
 #ifndef _WEIGHT_MULTIPLICATIVE_IMPL_H_
 #define _WEIGHT_MULTIPLICATIVE_IMPL_H_
 
+//! Identifies the rule, for the specialised updates of stdp_fused_kernels.h
+#define WEIGHT_RULE_MULTIPLICATIVE
+
 // Include generic plasticity maths functions
 #include <neuron/plasticity/stdp/maths.h>
 #include <neuron/plasticity/stdp/stdp_typedefs.h>
@@ -44,8 +47,10 @@ typedef struct {
 
     //! The shift to use when multiplying
     uint32_t weight_shift;
+#if !WEIGHT_HOMOGENEOUS
     //! Reference to the configuration data
     const plasticity_weight_region_data_t *weight_region;
+#endif
 } weight_state_t;
 
 #include "weight_one_term.h"
@@ -61,14 +66,18 @@ typedef struct {
  */
 static inline weight_state_t weight_get_initial(
         weight_t weight, index_t synapse_type) {
+#if !WEIGHT_HOMOGENEOUS
     extern plasticity_weight_region_data_t *plasticity_weight_region_data;
+#endif
     extern uint32_t *weight_shift;
 
     accum s1615_weight = kbits(weight << weight_shift[synapse_type]);
     return (weight_state_t) {
         .weight = s1615_weight,
         .weight_shift = weight_shift[synapse_type],
+#if !WEIGHT_HOMOGENEOUS
         .weight_region = &plasticity_weight_region_data[synapse_type]
+#endif
     };
 }
 
@@ -79,9 +88,11 @@ static inline weight_state_t weight_get_initial(
 //! \return the updated weight state
 static inline weight_state_t weight_one_term_apply_depression(
         weight_state_t state, int32_t depression) {
+    const plasticity_weight_region_data_t *region =
+            weight_get_region(state);
     // Calculate scale
-    accum scale = (state.weight - state.weight_region->min_weight) *
-            state.weight_region->a2_minus;
+    accum scale = (state.weight - region->min_weight) *
+            region->a2_minus;
 
     // Multiply scale by depression and subtract
     state.weight -= mul_accum_fixed(scale, depression);
@@ -94,9 +105,11 @@ static inline weight_state_t weight_one_term_apply_depression(
 //! \return the updated weight state
 static inline weight_state_t weight_one_term_apply_potentiation(
         weight_state_t state, int32_t potentiation) {
+    const plasticity_weight_region_data_t *region =
+            weight_get_region(state);
     // Calculate scale
-    accum scale = (state.weight_region->max_weight - state.weight) *
-            state.weight_region->a2_plus;
+    accum scale = (region->max_weight - state.weight) *
+            region->a2_plus;
 
     // Multiply scale by potentiation and add
     // **NOTE** using standard STDP fixed-point format handles format conversion
@@ -23,6 +23,16 @@
 
 #include <common/neuron-typedefs.h>
 #include <neuron/synapse_row.h>
+#include <neuron/post_index.h>
+
+#ifndef STDP_EAGER_POST
+//! \brief Whether the post-synaptic spikes of each neuron are applied to its
+//!     plastic synapses while the core has nothing else to do, using an index
+//!     of the synapses of each neuron, rather than only when the row of a
+//!     synapse is next read for a pre-synaptic spike.
+//!     This can be set per binary at build time.
+#define STDP_EAGER_POST 0
+#endif
 
 //! \brief Initialise the synapse dynamics
 //! \param[in] address: Where the configuration data is
@@ -45,7 +55,7 @@ bool synapse_dynamics_initialise(
 bool synapse_dynamics_process_plastic_synapses(
         synapse_row_plastic_data_t *plastic_region_data,
         synapse_row_fixed_part_t *fixed_region,
-        weight_t *ring_buffers, uint32_t time, uint32_t colour_delay,
+        ring_buffer_t *ring_buffers, uint32_t time, uint32_t colour_delay,
         bool *write_back);
 
 //! \brief Inform the synapses that the neuron fired
@@ -74,6 +84,35 @@ uint32_t synapse_dynamics_get_plastic_pre_synaptic_events(void);
 //! \return counter for saturation events or 0
 uint32_t synapse_dynamics_get_plastic_saturation_count(void);
 
+//! \brief Get how much of the plastic region of the row last processed by
+//!     synapse_dynamics_process_plastic_synapses() has changed, so that only
+//!     that needs to be written back
+//! \return The number of words from the start of the plastic region that
+//!     include every change
+uint32_t synapse_dynamics_get_plastic_words_changed(void);
+
+//! \brief Get the number of words at the start of the plastic region of a
+//!     row that change whenever it is processed, such as the pre-synaptic
+//!     history, so that they can be kept apart from the row when nothing
+//!     after them has changed
+//! \return The number of words, or 0 if they can't be kept apart
+uint32_t synapse_dynamics_get_plastic_header_words(void);
+
+#if STDP_EAGER_POST
+//! \brief Set up the applying of post-synaptic spikes as they happen
+//! \param[in] index: The index of the plastic synapses of each neuron
+//! \return Whether the set up succeeded
+bool synapse_dynamics_eager_post_initialise(post_index_t *index);
+
+//! \brief Apply the post-synaptic spikes of one neuron that have not been
+//!     applied to all its plastic synapses, reading and writing the synapses
+//!     in SDRAM; this must only be done while no other DMA is in progress
+//! \param[in] time: The current simulation time
+//! \return The number of synapses updated, or 0 if there were no spikes to
+//!     apply
+uint32_t synapse_dynamics_apply_post_spikes_eagerly(uint32_t time);
+#endif
+
 //-----------------------------------------------------------------------------
 // Synaptic rewiring functions
 //-----------------------------------------------------------------------------
@@ -26,6 +26,10 @@
 #include <debug.h>
 #include <utils.h>
 
+#if STDP_EAGER_POST
+#error "STDP_EAGER_POST is only supported by the STDP MAD synapse dynamics"
+#endif
+
 bool synapse_dynamics_initialise(
         UNUSED address_t address, UNUSED uint32_t n_neurons,
         UNUSED uint32_t n_synapse_types,
@@ -42,7 +46,7 @@ void synapse_dynamics_process_post_synaptic_event(
 bool synapse_dynamics_process_plastic_synapses(
         UNUSED synapse_row_plastic_data_t *plastic_region_data,
         UNUSED synapse_row_fixed_part_t *fixed_region,
-        UNUSED weight_t *ring_buffer, UNUSED uint32_t time,
+        UNUSED ring_buffer_t *ring_buffer, UNUSED uint32_t time,
         UNUSED uint32_t colour_delay, bool *write_back) {
     log_error("There should be no plastic synapses!");
     *write_back = false;
@@ -63,6 +67,14 @@ uint32_t synapse_dynamics_get_plastic_saturation_count(void) {
     return 0;
 }
 
+uint32_t synapse_dynamics_get_plastic_words_changed(void) {
+    return 0;
+}
+
+uint32_t synapse_dynamics_get_plastic_header_words(void) {
+    return 0;
+}
+
 bool synapse_dynamics_find_neuron(
         uint32_t id, synaptic_row_t row, weight_t *weight, uint16_t *delay,
         uint32_t *offset, uint32_t *synapse_type) {
@@ -99,8 +111,9 @@ bool synapse_dynamics_remove_neuron(uint32_t offset, synaptic_row_t row) {
     // Delete control word at offset (contains weight)
     synaptic_words[offset] = synaptic_words[fixed_synapse - 1];
 
-    // Decrement FF
+    // Decrement FF; moving the last synapse breaks any ordering of the row
     fixed_region->num_fixed--;
+    fixed_region->format &= ~SYNAPSE_ROW_DELAY_SORTED;
     return true;
 }
 
@@ -127,8 +140,9 @@ bool synapse_dynamics_add_neuron(
     // Add control word at offset
     synaptic_words[fixed_synapse] = new_synapse;
 
-    // Increment FF
+    // Increment FF; the new synapse might not match the row format
     fixed_region->num_fixed++;
+    fixed_region->format = 0;
     return true;
 }
 
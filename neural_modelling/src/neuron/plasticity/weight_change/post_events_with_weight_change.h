@@ -33,6 +33,12 @@
 //! Maximum number of pre-synaptic events per post neuron
 #define MAX_EVENTS 16
 
+//! Maximum number of whole rows of weight changes waiting at once
+#define MAX_ROW_CHANGES 4
+
+//! The fewest changes in an update row for it to be held as a whole row
+#define MIN_ROW_CHANGE_SIZE 8
+
 typedef struct update_post_trace_t {
 
     //! The amount to change the weight by (positive or negative)
@@ -56,6 +62,28 @@ typedef struct {
     update_post_trace_t traces[MAX_EVENTS];
 } post_event_history_t;
 
+//! A whole row of weight changes, waiting for the row they change
+typedef struct {
+    //! The pre-spike to look out for in doing the update
+    uint32_t pre_spike;
+    //! The synapse type
+    uint32_t synapse_type;
+    //! The number of changes not yet done
+    uint32_t n_pending;
+    //! The amount to change the weight to each post neuron by
+    int16_t *weight_changes;
+} row_change_t;
+
+//! The whole rows of weight changes waiting, oldest first
+typedef struct {
+    //! Number of rows of changes stored
+    uint32_t count;
+    //! The number of post neurons
+    uint32_t n_neurons;
+    //! The rows of changes
+    row_change_t rows[MAX_ROW_CHANGES];
+} row_changes_t;
+
 //---------------------------------------
 // Inline functions
 //---------------------------------------
@@ -120,6 +148,89 @@ static inline void post_events_add(
     }
 }
 
+//---------------------------------------
+//! \brief Initialise the whole rows of weight changes
+//! \param[out] changes: The rows to initialise
+//! \param[in] n_neurons: Number of neurons
+//! \return Whether the rows could be allocated
+static inline bool row_changes_init(
+        row_changes_t *changes, uint32_t n_neurons) {
+    changes->count = 0;
+    changes->n_neurons = n_neurons;
+    for (uint32_t r = 0; r < MAX_ROW_CHANGES; r++) {
+        int16_t *weight_changes = spin1_malloc(n_neurons * sizeof(int16_t));
+        if (weight_changes == NULL) {
+            log_error("Unable to allocate row weight changes");
+            return false;
+        }
+        for (uint32_t n = 0; n < n_neurons; n++) {
+            weight_changes[n] = 0;
+        }
+        changes->rows[r].weight_changes = weight_changes;
+    }
+    return true;
+}
+
+//---------------------------------------
+//! \brief Find the whole row of weight changes for a pre-spike
+//! \param[in] changes: The rows to look in
+//! \param[in] pre_spike: The pre-spike to look for
+//! \return The row of changes, or NULL if there is none
+static inline row_change_t *row_changes_find(
+        row_changes_t *changes, uint32_t pre_spike) {
+    for (uint32_t r = 0; r < changes->count; r++) {
+        if (changes->rows[r].pre_spike == pre_spike) {
+            return &changes->rows[r];
+        }
+    }
+    return NULL;
+}
+
+//---------------------------------------
+//! \brief Remove a whole row of weight changes, keeping the rest in order
+//! \param[in,out] changes: The rows to remove from
+//! \param[in] index: The index of the row to remove
+static inline void row_changes_remove(row_changes_t *changes, uint32_t index) {
+    row_change_t removed = changes->rows[index];
+
+    // Clear any changes that were never done so the space can be used again
+    if (removed.n_pending > 0) {
+        for (uint32_t n = 0; n < changes->n_neurons; n++) {
+            removed.weight_changes[n] = 0;
+        }
+        removed.n_pending = 0;
+    }
+    for (uint32_t r = index + 1; r < changes->count; r++) {
+        changes->rows[r - 1] = changes->rows[r];
+    }
+    changes->rows[--changes->count] = removed;
+}
+
+//---------------------------------------
+//! \brief Get the whole row of weight changes to add changes for a pre-spike
+//!     to, replacing the oldest row if there is no space
+//! \param[in,out] changes: The rows to add to
+//! \param[in] pre_spike: The pre-spike of the changes
+//! \param[in] synapse_type: The synapse type of the changes
+//! \return The row of changes to add to
+static inline row_change_t *row_changes_get(
+        row_changes_t *changes, uint32_t pre_spike, uint32_t synapse_type) {
+    row_change_t *row = row_changes_find(changes, pre_spike);
+    if (row != NULL && row->synapse_type == synapse_type) {
+        return row;
+    }
+    if (row != NULL) {
+        row_changes_remove(changes, row - changes->rows);
+    } else if (changes->count == MAX_ROW_CHANGES) {
+        log_debug("Row changes full, dropping the oldest");
+        row_changes_remove(changes, 0);
+    }
+    row = &changes->rows[changes->count++];
+    row->pre_spike = pre_spike;
+    row->synapse_type = synapse_type;
+    return row;
+}
+
 static inline bool post_events_remove(post_event_history_t *events, uint32_t index) {
     // Already gone? nothing to do!
     if (index >= events->count) {
@@ -21,6 +21,10 @@
 #include <neuron/plasticity/synapse_dynamics.h>
 #include <stddef.h>
 
+#if STDP_EAGER_POST
+#error "STDP_EAGER_POST is only supported by the STDP MAD synapse dynamics"
+#endif
+
 typedef struct limits {
 	weight_t min;
 	weight_t max;
@@ -53,12 +57,20 @@ typedef struct fixed_stdp_synapse {
 //! \brief The history data of post-events
 static post_event_history_t *post_event_history;
 
+//! \brief Whole rows of weight changes, done in one pass over the row they
+//!     change rather than being looked up in each post-neuron history
+static row_changes_t row_changes;
+
 //! Count of pre-synaptic events relevant to plastic processing
 static uint32_t num_plastic_pre_synaptic_events = 0;
 
 //! Count of times that the plastic math became saturated
 static uint32_t plastic_saturation_count = 0;
 
+//! \brief The words at the start of the plastic region of the last row
+//!     processed that include every change
+static uint32_t plastic_words_changed = 0;
+
 //! Parameters
 static change_params *params;
 
@@ -86,6 +98,10 @@ bool synapse_dynamics_initialise(
         return false;
     }
 
+    if (!row_changes_init(&row_changes, n_neurons)) {
+        return false;
+    }
+
     return true;
 }
 
@@ -111,38 +127,63 @@ static inline fixed_stdp_synapse synapse_dynamics_stdp_get_fixed(
        .delay = delay,
        .type = type,
 	   .index = index,
-       .ring_buffer_index = synapse_row_get_ring_buffer_index_combined(
-                (delay + time) - colour_delay, type_index,
-                synapse_type_index_bits, synapse_delay_mask)
+       .ring_buffer_index = synapses_ring_buffer_entry(
+                synapse_row_get_ring_buffer_index_combined(
+                        (delay + time) - colour_delay, type_index,
+                        synapse_type_index_bits, synapse_delay_mask))
     };
 }
 
 static inline void synapse_dynamics_stdp_update_ring_buffers(
-        weight_t *ring_buffers, fixed_stdp_synapse s, int32_t weight) {
-    uint32_t accumulation = ring_buffers[s.ring_buffer_index] + weight;
-
-    uint32_t sat_test = accumulation & 0xFFFF0000;
-    if (sat_test) {
-        accumulation = 0xFFFF;
+        ring_buffer_t *ring_buffers, fixed_stdp_synapse s, int32_t weight) {
+    if (synapse_row_ring_buffer_add(
+            &ring_buffers[s.ring_buffer_index], weight)) {
         plastic_saturation_count++;
     }
+}
 
-    ring_buffers[s.ring_buffer_index] = accumulation;
+//! \brief Change a weight, saturating at the limits
+//! \param[in] weight: The weight to change
+//! \param[in] weight_change: The amount to change it by
+//! \param[in] min_weight: The smallest weight allowed
+//! \param[in] max_weight: The largest weight allowed
+//! \return The changed weight
+static inline weight_t change_weight(weight_t weight, int32_t weight_change,
+        weight_t min_weight, weight_t max_weight) {
+    int32_t new_weight = weight + weight_change;
+    if (new_weight < min_weight) {
+        return min_weight;
+    } else if (new_weight > max_weight) {
+        return max_weight;
+    }
+    return (weight_t) new_weight;
 }
 
 //---------------------------------------
 static inline updatable_synapse_t process_plastic_synapse(
-        uint32_t pre_spike, uint32_t control_word, weight_t *ring_buffers,
+        uint32_t pre_spike, uint32_t control_word, ring_buffer_t *ring_buffers,
         uint32_t time, uint32_t colour_delay, updatable_synapse_t synapse,
-        uint32_t *changed) {
+        row_change_t *row_change, uint32_t *changed) {
     fixed_stdp_synapse s = synapse_dynamics_stdp_get_fixed(control_word, time,
             colour_delay);
 
+    weight_t min_weight = params->weight_limits[s.type].min;
+    weight_t max_weight = params->weight_limits[s.type].max;
+
+    // Do any change from a whole row of changes first
+    if (row_change != NULL && row_change->synapse_type == s.type) {
+        int16_t *weight_change = &row_change->weight_changes[s.index];
+        if (*weight_change != 0) {
+            synapse.weight = change_weight(synapse.weight, *weight_change,
+                    min_weight, max_weight);
+            *weight_change = 0;
+            row_change->n_pending--;
+            *changed = 1;
+        }
+    }
 
     // Work out if the weight needs to be updated
     post_event_history_t *history = &post_event_history[s.index];
-    weight_t min_weight = params->weight_limits[s.type].min;
-    weight_t max_weight = params->weight_limits[s.type].max;
     log_debug("    Looking at change weight history 0x%08x of %u items to post"
     		" neuron index %u", history, history->count, s.index);
     for (uint32_t i = 0; i < history->count; i++) {
@@ -152,14 +193,8 @@ static inline updatable_synapse_t process_plastic_synapse(
 				" pre-neuron %u, synapse_type = %u",
 				i, trace->weight_change, trace->pre_spike, trace->synapse_type);
         if (trace->pre_spike == pre_spike && s.type == trace->synapse_type) {
-        	int32_t new_weight = synapse.weight + trace->weight_change;
-            if (new_weight < min_weight) {
-                synapse.weight = min_weight;
-            } else if (new_weight > max_weight) {
-                synapse.weight = max_weight;
-            } else {
-                synapse.weight = (weight_t) new_weight;
-            }
+            synapse.weight = change_weight(synapse.weight,
+                    trace->weight_change, min_weight, max_weight);
             log_debug("        Weight now %d", synapse.weight);
             *changed = 1;
 
@@ -191,6 +226,48 @@ static inline int16_t change_sign(weight_t weight) {
     return converter.value;
 }
 
+//! \brief Add a row of weight changes as a whole row
+//! \param[in] pre_spike: The pre-spike of the changes
+//! \param[in] words: The changes
+//! \param[in] n_synapses: The number of changes
+//! \return Whether the changes were added; they are not if they are not all
+//!     of the same synapse type
+static inline bool add_row_change(
+        uint32_t pre_spike, const uint32_t *words, uint32_t n_synapses) {
+    uint32_t synapse_type = synapse_row_sparse_type(words[0],
+            synapse_index_bits, synapse_type_mask);
+    for (uint32_t i = 1; i < n_synapses; i++) {
+        if (synapse_row_sparse_type(words[i], synapse_index_bits,
+                synapse_type_mask) != synapse_type) {
+            return false;
+        }
+    }
+
+    row_change_t *row = row_changes_get(&row_changes, pre_spike, synapse_type);
+    for (uint32_t i = 0; i < n_synapses; i++) {
+        uint32_t neuron_index = synapse_row_sparse_index(words[i],
+                synapse_index_mask);
+        int16_t *weight_change = &row->weight_changes[neuron_index];
+        int32_t new_change = *weight_change +
+                change_sign(synapse_row_sparse_weight(words[i]));
+        if (new_change > INT16_MAX) {
+            new_change = INT16_MAX;
+        } else if (new_change < INT16_MIN) {
+            new_change = INT16_MIN;
+        }
+        if (*weight_change == 0 && new_change != 0) {
+            row->n_pending++;
+        } else if (*weight_change != 0 && new_change == 0) {
+            row->n_pending--;
+        }
+        *weight_change = (int16_t) new_change;
+    }
+    if (row->n_pending == 0) {
+        row_changes_remove(&row_changes, row - row_changes.rows);
+    }
+    return true;
+}
+
 static inline void process_weight_update(
         synapse_row_plastic_data_t *plastic_region_address,
         synapse_row_fixed_part_t *fixed_region) {
@@ -200,6 +277,12 @@ static inline void process_weight_update(
 
 	log_debug("Weight change update for pre-neuron %u", pre_spike);
 
+    // Keep big rows of changes whole, to be done in one pass
+    if (n_synapses >= MIN_ROW_CHANGE_SIZE &&
+            add_row_change(pre_spike, words, n_synapses)) {
+        return;
+    }
+
     // Loop through synapses
     for (; n_synapses > 0; n_synapses--) {
         // Get next control word (auto incrementing)
@@ -224,7 +307,7 @@ static inline void process_weight_update(
 bool synapse_dynamics_process_plastic_synapses(
         synapse_row_plastic_data_t *plastic_region_address,
         synapse_row_fixed_part_t *fixed_region,
-        weight_t *ring_buffers, uint32_t time, uint32_t colour_delay,
+        ring_buffer_t *ring_buffers, uint32_t time, uint32_t colour_delay,
         bool *write_back) {
 
     // If the flag is set, this is neuromodulation
@@ -242,6 +325,7 @@ bool synapse_dynamics_process_plastic_synapses(
 
     num_plastic_pre_synaptic_events += n_plastic_synapses;
     uint32_t pre_spike = plastic_region_address->pre_spike;
+    row_change_t *row_change = row_changes_find(&row_changes, pre_spike);
 
     log_debug("Checking for weight changes for pre-neuron %u", pre_spike);
 
@@ -251,12 +335,20 @@ bool synapse_dynamics_process_plastic_synapses(
         uint32_t control_word = *control_words++;
         uint32_t changed = 0;
         plastic_words[0] = process_plastic_synapse(pre_spike, control_word,
-                ring_buffers, time, colour_delay, plastic_words[0], &changed);
+                ring_buffers, time, colour_delay, plastic_words[0],
+                row_change, &changed);
         plastic_words++;
         if (changed) {
             *write_back = true;
+            plastic_words_changed = synapse_row_plastic_words_to(
+                    plastic_region_address, plastic_words);
         }
     }
+
+    // Once every change of a whole row has been done, it is finished with
+    if (row_change != NULL && row_change->n_pending == 0) {
+        row_changes_remove(&row_changes, row_change - row_changes.rows);
+    }
     return true;
 }
 
@@ -272,3 +364,12 @@ uint32_t synapse_dynamics_get_plastic_pre_synaptic_events(void) {
 uint32_t synapse_dynamics_get_plastic_saturation_count(void) {
     return plastic_saturation_count;
 }
+
+uint32_t synapse_dynamics_get_plastic_words_changed(void) {
+    return plastic_words_changed;
+}
+
+uint32_t synapse_dynamics_get_plastic_header_words(void) {
+    // The header also says whether the row is an update, so it stays
+    return 0;
+}
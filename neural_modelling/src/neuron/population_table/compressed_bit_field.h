@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2024 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//! \file
+//! \brief Compressed forms of the connectivity bit fields, used when the
+//!     plain bit field of a source is too big for the DTCM available
+//!
+//! - A run-length form holds the ranges of set bits, which is small when
+//!   a field is mostly empty or mostly full.
+//! - A Bloom filter holds the set bits in a fixed space, which is small
+//!   when a large source connects to only a few of its neurons here.  A
+//!   Bloom filter can say that a bit is set when it isn't, so anything it
+//!   passes is checked against the full bit field in SDRAM, which is still
+//!   much cheaper than transferring the row.
+#ifndef _COMPRESSED_BIT_FIELD_H_
+#define _COMPRESSED_BIT_FIELD_H_
+
+#include <common-typedefs.h>
+#include <bit_field.h>
+#include <spin1_api.h>
+
+//! The kinds of compressed bit field
+enum compressed_bit_field_type {
+    //! There is no compressed bit field
+    COMPRESSED_NONE,
+    //! Pairs of (first, last + 1) of each run of set bits, sorted
+    COMPRESSED_RUNS,
+    //! A Bloom filter of the set bits with two hash functions
+    COMPRESSED_BLOOM
+};
+
+//! The multipliers of the hash functions of a Bloom filter
+#define BLOOM_HASH_1 0x9E3779B1
+#define BLOOM_HASH_2 0x85EBCA77
+
+//! \brief The smallest number of Bloom filter bits per set bit; with two
+//!     hash functions this gives a false positive rate of at most 16%
+#define BLOOM_MIN_BITS_PER_ITEM 4
+
+//! A compressed bit field
+typedef struct compressed_bit_field {
+    //! The compressed data
+    uint32_t *data;
+    //! The full bit field in SDRAM, to check what a Bloom filter passes
+    bit_field_t sdram_data;
+    //! The ::compressed_bit_field_type of the data
+    uint16_t type;
+    //! The number of runs, or the shift of the hashes of a Bloom filter
+    uint16_t n_runs_or_shift;
+} compressed_bit_field_t;
+
+//! \brief Count the runs of set bits in a bit field
+//! \param[in] bit_field: The bit field to count the runs of
+//! \param[in] n_atoms: The number of bits in the bit field
+//! \return The number of runs
+static inline uint32_t compressed_count_runs(
+        bit_field_t bit_field, uint32_t n_atoms) {
+    uint32_t n_runs = 0;
+    bool last = false;
+    for (uint32_t i = 0; i < n_atoms; i++) {
+        bool bit = bit_field_test(bit_field, i);
+        if (bit && !last) {
+            n_runs++;
+        }
+        last = bit;
+    }
+    return n_runs;
+}
+
+//! \brief Make the run-length form of a bit field
+//! \param[out] compressed: Where to put the compressed bit field
+//! \param[in] bit_field: The bit field to compress
+//! \param[in] n_atoms: The number of bits in the bit field
+//! \param[in] n_runs: The number of runs, from compressed_count_runs()
+//! \return True if there was space for the compressed bit field
+static inline bool compressed_make_runs(compressed_bit_field_t *compressed,
+        bit_field_t bit_field, uint32_t n_atoms, uint32_t n_runs) {
+    // An empty field needs no runs, and filters everything
+    uint32_t *runs = NULL;
+    if (n_runs > 0) {
+        runs = spin1_malloc(2 * n_runs * sizeof(uint32_t));
+        if (runs == NULL) {
+            return false;
+        }
+    }
+    uint32_t pos = 0;
+    bool last = false;
+    for (uint32_t i = 0; i < n_atoms; i++) {
+        bool bit = bit_field_test(bit_field, i);
+        if (bit && !last) {
+            runs[pos++] = i;
+        } else if (!bit && last) {
+            runs[pos++] = i;
+        }
+        last = bit;
+    }
+    if (last) {
+        runs[pos] = n_atoms;
+    }
+    compressed->data = runs;
+    compressed->sdram_data = NULL;
+    compressed->type = COMPRESSED_RUNS;
+    compressed->n_runs_or_shift = n_runs;
+    return true;
+}
+
+//! \brief Get the bits of the Bloom filter to test for an item
+//! \param[in] shift: The shift of the hashes
+//! \param[in] id: The item to hash
+//! \param[out] h1: The first bit
+//! \param[out] h2: The second bit
+static inline void compressed_bloom_hashes(
+        uint32_t shift, uint32_t id, uint32_t *h1, uint32_t *h2) {
+    *h1 = (id * BLOOM_HASH_1) >> shift;
+    *h2 = (id * BLOOM_HASH_2) >> shift;
+}
+
+//! \brief Make a Bloom filter of a bit field, as large as will fit up to a
+//!     size that is worth having
+//! \param[out] compressed: Where to put the compressed bit field
+//! \param[in] bit_field: The bit field to compress, which must stay where
+//!     it is as it is used to check what the filter passes
+//! \param[in] n_atoms: The number of bits in the bit field
+//! \param[in] n_words: The number of words in the bit field
+//! \return True if a Bloom filter could be made
+static inline bool compressed_make_bloom(compressed_bit_field_t *compressed,
+        bit_field_t bit_field, uint32_t n_atoms, uint32_t n_words) {
+    // Start at the largest power of two words that saves at least half
+    uint32_t log_n_bits = 5;
+    while ((2u << log_n_bits) <= (n_words * 32) / 2) {
+        log_n_bits++;
+    }
+    uint32_t n_set = count_bit_field(bit_field, n_words);
+    uint32_t *bloom = NULL;
+    while ((1u << log_n_bits) >= n_set * BLOOM_MIN_BITS_PER_ITEM &&
+            (1u << log_n_bits) <= (n_words * 32) / 2) {
+        bloom = spin1_malloc(1u << (log_n_bits - 3));
+        if (bloom != NULL) {
+            break;
+        }
+        log_n_bits--;
+        if (log_n_bits < 5) {
+            break;
+        }
+    }
+    if (bloom == NULL) {
+        return false;
+    }
+    uint32_t shift = 32 - log_n_bits;
+    clear_bit_field(bloom, 1u << (log_n_bits - 5));
+    for (uint32_t i = 0; i < n_atoms; i++) {
+        if (bit_field_test(bit_field, i)) {
+            uint32_t h1, h2;
+            compressed_bloom_hashes(shift, i, &h1, &h2);
+            bit_field_set(bloom, h1);
+            bit_field_set(bloom, h2);
+        }
+    }
+    compressed->data = bloom;
+    compressed->sdram_data = bit_field;
+    compressed->type = COMPRESSED_BLOOM;
+    compressed->n_runs_or_shift = shift;
+    return true;
+}
+
+//! \brief Test a bit of a run-length form bit field
+//! \param[in] compressed: The compressed bit field
+//! \param[in] id: The bit to test
+//! \return Whether the bit is set
+static inline bool compressed_test_runs(
+        const compressed_bit_field_t *compressed, uint32_t id) {
+    // Find the last run that starts at or before the id
+    const uint32_t *runs = compressed->data;
+    uint32_t lo = 0;
+    uint32_t hi = compressed->n_runs_or_shift;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) >> 1;
+        if (runs[mid * 2] <= id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return (lo > 0) && (id < runs[(lo * 2) - 1]);
+}
+
+//! \brief Test a bit of a Bloom filter
+//! \param[in] compressed: The compressed bit field
+//! \param[in] id: The bit to test
+//! \return Whether the bit might be set
+static inline bool compressed_test_bloom(
+        const compressed_bit_field_t *compressed, uint32_t id) {
+    uint32_t h1, h2;
+    compressed_bloom_hashes(compressed->n_runs_or_shift, id, &h1, &h2);
+    return bit_field_test(compressed->data, h1)
+            && bit_field_test(compressed->data, h2);
+}
+
+#endif // _COMPRESSED_BIT_FIELD_H_
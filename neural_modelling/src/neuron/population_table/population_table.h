@@ -80,15 +80,76 @@ typedef struct {
 //! \details Used to keep indices aligned between delayed and undelayed tables
 #define INVALID_ADDRESS ((1 << N_ADDRESS_BITS) - 1)
 
+//! \brief A row length and address in the extended table format, which
+//!     reaches the whole of a 32-bit address space
+typedef struct {
+    //! the length of the row, less one
+    uint32_t row_length;
+    //! the offset of the matrix in bytes, or ::INVALID_EXTENDED_OFFSET
+    uint32_t offset;
+} extended_address_list_entry;
+
+//! \brief An invalid offset in the extended format
+//! \details Used to keep indices aligned between delayed and undelayed tables
+#define INVALID_EXTENDED_OFFSET 0xFFFFFFFF
+
+//! \brief The value of pop_table_config_t::format for the standard format
+#define POP_TABLE_STANDARD_FORMAT 0
+
+//! \brief The value of pop_table_config_t::format for the extended format
+//! \details In this format, the ::master_population_table_entry::start of
+//!     each entry is ignored and its start is instead held in a full word,
+//!     and the address list is made of ::extended_address_list_entry items.
+//!     The host only uses this format when the table doesn't fit the
+//!     standard format, as it takes more DTCM.
+#define POP_TABLE_EXTENDED_FORMAT 1
+
+//! \brief The events counted for each item of the address list, and so for
+//!     each projection (or its delayed part), if the host asks for them
+typedef struct {
+    //! The number of rows fetched
+    uint32_t n_rows;
+    //! The number of words of the rows fetched, including headers
+    uint32_t n_words;
+    //! \brief The number of packets of the item's entry that the bit field
+    //!     filtered out before any row was fetched
+    uint32_t n_filtered;
+} pop_table_event_counters_t;
+
 //! \brief The memory layout in SDRAM of the first part of the population table
-//!     configuration. Address list data (array of ::address_and_row_length) is
-//!     packed on the end.
+//!     configuration. In the standard format, address list data (array of
+//!     ::address_list_entry) is packed on the end; in the extended format,
+//!     the start of each entry (array of uint32_t) is packed on the end,
+//!     followed by address list data (array of
+//!     ::extended_address_list_entry).  Either is followed by a
+//!     ::pop_table_direct_config_t.
 typedef struct {
     uint32_t table_length;
     uint32_t addr_list_length;
+    //! ::POP_TABLE_STANDARD_FORMAT or ::POP_TABLE_EXTENDED_FORMAT
+    uint32_t format;
     master_population_table_entry data[];
 } pop_table_config_t;
 
+//! \brief The value of a direct lookup index that has no table entry
+#define NO_DIRECT_ENTRY 0xFFFF
+
+//! \brief The memory layout in SDRAM of the direct lookup index, which follows
+//!     the address list.
+//! \details The bits of the key selected by \p shift and \p n_bits are inside
+//!     the mask of every table entry and are different for each entry, so they
+//!     can be used to index the table directly.  If \p n_bits is 0, no index
+//!     was generated and the table must be searched.
+typedef struct {
+    //! The shift to apply to the key to get the index bits
+    uint32_t shift;
+    //! The number of bits of index; the index has 2^n_bits items
+    uint32_t n_bits;
+    //! The index into the table for each value of the index bits, or
+    //! ::NO_DIRECT_ENTRY if there is no entry for that value
+    uint16_t index[];
+} pop_table_direct_config_t;
+
 //! \brief A structure to hold a response to a population table lookup
 typedef struct {
 	// Updated with the address of the row
@@ -168,20 +229,90 @@ static inline uint32_t get_local_neuron_id(
     return spike & ~(entry.mask | (entry.core_mask << entry.mask_shift));
 }
 
-//! \brief Get the row address and size for a given neuron
-//! \param[in] item The address list item
-//! \param[in] synaptic_rows_based_address The address of all synaptic rows
+//! \brief Get the starts of the entries of an extended format table
+//! \param[in] config: The table configuration
+//! \return The start of each entry in the address list
+static inline uint32_t *pop_table_extended_starts(pop_table_config_t *config) {
+    return (uint32_t *) &config->data[config->table_length];
+}
+
+//! \brief Get the address list of a table, in either format
+//! \param[in] config: The table configuration
+//! \return The address list, of ::address_list_entry in the standard format
+//!     or of ::extended_address_list_entry in the extended format
+static inline void *pop_table_address_list(pop_table_config_t *config) {
+    if (config->format == POP_TABLE_EXTENDED_FORMAT) {
+        return &pop_table_extended_starts(config)[config->table_length];
+    }
+    return &config->data[config->table_length];
+}
+
+//! \brief Get the size of the address list of a table, in either format
+//! \param[in] config: The table configuration
+//! \return The size of the address list in bytes
+static inline uint32_t pop_table_address_list_bytes(
+        pop_table_config_t *config) {
+    if (config->format == POP_TABLE_EXTENDED_FORMAT) {
+        return config->addr_list_length * sizeof(extended_address_list_entry);
+    }
+    return config->addr_list_length * sizeof(address_list_entry);
+}
+
+//! \brief Get the direct lookup index configuration that follows a table
+//! \param[in] config: The table configuration
+//! \return The direct lookup index configuration
+static inline pop_table_direct_config_t *pop_table_direct_config(
+        pop_table_config_t *config) {
+    return (pop_table_direct_config_t *) ((uint8_t *)
+            pop_table_address_list(config) +
+            pop_table_address_list_bytes(config));
+}
+
+//! \brief Get the offset and row length of an item of an address list, in
+//!     either format
+//! \param[in] address_list: The address list
+//! \param[in] extended: Whether the list is in the extended format
+//! \param[in] index: The index of the item in the list
+//! \param[out] offset: Updated with the offset of the matrix in bytes
+//! \param[out] row_length: Updated with the length of the rows
+//! \return Whether the item is valid; if not, the outputs are not updated
+static inline bool get_address_list_item(
+        const void *address_list, bool extended, uint32_t index,
+        uint32_t *offset, uint32_t *row_length) {
+    if (extended) {
+        extended_address_list_entry item =
+                ((const extended_address_list_entry *) address_list)[index];
+        if (item.offset == INVALID_EXTENDED_OFFSET) {
+            return false;
+        }
+        *offset = item.offset;
+        *row_length = item.row_length + 1;
+        return true;
+    }
+    address_list_entry item =
+            ((const address_list_entry *) address_list)[index];
+    if (item.address == INVALID_ADDRESS) {
+        return false;
+    }
+    *offset = get_offset(item);
+    *row_length = get_row_length(item);
+    return true;
+}
+
+//! \brief Get the row address and size for a given neuron from the offset
+//!     and row length of its block
+//! \param[in] block_address The address of the block of rows
+//! \param[in] row_length The length of the rows of the block
 //! \param[in] neuron_id The incoming neuron to get the address of
 //! \param[out] result The place to write results to
-static inline void get_row_addr_and_size(address_list_entry item,
-		uint32_t synaptic_rows_base_address, uint32_t neuron_id,
+static inline void get_block_row_addr_and_size(uint32_t block_address,
+		uint32_t row_length, uint32_t neuron_id,
 		pop_table_lookup_result_t *result) {
-	uint32_t row_length = get_row_length(item);
-	uint32_t block_address = get_address(item, synaptic_rows_base_address);
 	uint32_t stride = (row_length + N_SYNAPSE_ROW_HEADER_WORDS);
 	uint32_t neuron_offset = neuron_id * stride * sizeof(uint32_t);
 
-	result->row_address = (synaptic_row_t) (block_address + neuron_offset);
+	result->row_address =
+			(synaptic_row_t) (uintptr_t) (block_address + neuron_offset);
 	result->n_bytes_to_transfer = stride * sizeof(uint32_t);
 
     log_debug("neuron_id = %u, block_address = 0x%.8x, "
@@ -190,6 +321,19 @@ static inline void get_row_addr_and_size(address_list_entry item,
             result->n_bytes_to_transfer);
 }
 
+//! \brief Get the row address and size for a given neuron
+//! \param[in] item The address list item
+//! \param[in] synaptic_rows_based_address The address of all synaptic rows
+//! \param[in] neuron_id The incoming neuron to get the address of
+//! \param[out] result The place to write results to
+static inline void get_row_addr_and_size(address_list_entry item,
+		uint32_t synaptic_rows_base_address, uint32_t neuron_id,
+		pop_table_lookup_result_t *result) {
+	get_block_row_addr_and_size(
+			get_address(item, synaptic_rows_base_address),
+			get_row_length(item), neuron_id, result);
+}
+
 //! \brief the number of times a DMA resulted in 0 entries
 extern uint32_t ghost_pop_table_searches;
 
@@ -204,6 +348,21 @@ extern uint32_t failed_bit_field_reads;
 //!     they don't hit anything
 extern uint32_t bit_field_filtered_packets;
 
+//! \brief The number of bit fields which were read in compressed to save DTCM
+extern uint32_t compressed_bit_field_reads;
+
+//! \brief The number of spikes tested against a Bloom filter
+extern uint32_t bloom_filter_tests;
+
+//! \brief The number of spikes that a Bloom filter wrongly passed
+extern uint32_t bloom_filter_false_positives;
+
+//! \brief The number of lookups that matched a recently matched entry
+extern uint32_t pop_table_cache_hits;
+
+//! \brief The number of lookups that had to look up the table
+extern uint32_t pop_table_cache_misses;
+
 //! \brief The number of addresses from the same spike left to process
 extern uint16_t items_to_go;
 
@@ -213,12 +372,17 @@ extern uint16_t items_to_go;
 //!                              the table in words
 //! \param[out] master_pop_table_length: Updated with the length of the table
 //! \param[out] master_pop_table: Updated with the table entries
-//! \param[out] address_list: Updated with the address list
+//! \param[out] address_list: Updated with the address list, of
+//!                           ::address_list_entry or, if \p entry_starts is
+//!                           not NULL, of ::extended_address_list_entry
+//! \param[out] entry_starts: Updated with the start of each entry in the
+//!                           address list if the table is in the extended
+//!                           format, or NULL if not
 //! \return True if the table was setup successfully, False otherwise
 bool population_table_setup(address_t table_address, uint32_t *row_max_n_words,
     uint32_t *master_pop_table_length,
     master_population_table_entry **master_pop_table,
-    address_list_entry **address_list);
+    void **address_list, uint32_t **entry_starts);
 
 //! \brief Set up the table
 //! \param[in] table_address: The address of the start of the table data
@@ -231,6 +395,16 @@ bool population_table_initialise(
         address_t table_address, address_t synapse_rows_address,
         uint32_t *row_max_n_words);
 
+//! \brief Count the events of each item of the address list, storing them in
+//!     SDRAM when population_table_store_event_counters() is called
+//! \param[in] sdram_counters: Where to store the counters, with space for a
+//!     ::pop_table_event_counters_t for each address list item
+void population_table_set_event_counters(address_t sdram_counters);
+
+//! \brief Store the events counted in SDRAM for the host to read, if they are
+//!     being counted
+void population_table_store_event_counters(void);
+
 //! \brief Initialise the bitfield filtering system.
 //! \param[in] filter_region: Where the bitfield configuration is
 //! \return True on success
@@ -15,12 +15,20 @@
  */
 
 //! \file
-//! \brief Master population table implementation that uses binary search
+//! \brief Master population table implementation that uses binary search,
+//!     or a direct index into the table when one has been generated
 #include "population_table.h"
+#include "compressed_bit_field.h"
 #include <neuron/synapse_row.h>
 #include <debug.h>
 #include <stdbool.h>
 
+#ifndef POP_TABLE_CACHE_SIZE
+//! \brief The number of recently matched table positions to check before
+//!     looking up the table; 0 disables the cache
+#define POP_TABLE_CACHE_SIZE 4
+#endif
+
 
 //! The master population table. This is sorted.
 static master_population_table_entry *master_population_table;
@@ -28,12 +36,40 @@ static master_population_table_entry *master_population_table;
 //! The length of ::master_population_table
 static uint32_t master_population_table_length;
 
-//! The array of information that points into the synaptic matrix
-static address_list_entry *address_list;
+//! \brief The array of information that points into the synaptic matrix,
+//!     of ::address_list_entry or, in the extended format, of
+//!     ::extended_address_list_entry
+static void *address_list;
+
+//! \brief The start of each entry of ::master_population_table in
+//!     ::address_list if the table is in the extended format, or NULL if not
+static uint32_t *entry_starts = NULL;
+
+//! Whether the table is in the extended format
+static bool extended_format = false;
 
 //! Base address for the synaptic matrix's indirect rows
 static uint32_t synaptic_rows_base_address;
 
+//! \brief The direct index into ::master_population_table, or NULL if the
+//!     table must be searched
+static uint16_t *direct_lookup = NULL;
+
+//! The shift to apply to a spike to get the direct index bits
+static uint32_t direct_lookup_shift;
+
+//! The mask to apply to the shifted spike to get the direct index
+static uint32_t direct_lookup_mask;
+
+#if POP_TABLE_CACHE_SIZE > 0
+//! \brief Positions in ::master_population_table that were recently matched,
+//!     most recently matched first
+static uint32_t position_cache[POP_TABLE_CACHE_SIZE];
+
+//! The number of valid items in ::position_cache
+static uint32_t position_cache_count = 0;
+#endif
+
 //! \brief The last spike received
 static spike_t last_spike = 0;
 
@@ -46,8 +82,17 @@ static uint32_t last_colour_mask = 0;
 //! \brief The last neuron id for the key
 static uint32_t last_neuron_id = 0;
 
+//! The number of items in the ::address_list
+static uint32_t address_list_length;
+
+//! The events counted for each ::address_list item, or NULL if not counted
+static pop_table_event_counters_t *event_counters = NULL;
+
+//! Where to store the ::event_counters for the host
+static pop_table_event_counters_t *sdram_event_counters = NULL;
+
 //! the index for the next item in the ::address_list
-static uint16_t next_item = 0;
+static uint32_t next_item = 0;
 
 //! The number of relevant items remaining in the ::address_list
 //! NOTE: Exported for speed of check
@@ -56,6 +101,10 @@ uint16_t items_to_go = 0;
 //! The bitfield map
 static bit_field_t *connectivity_bit_field = NULL;
 
+//! \brief The compressed bit fields of the entries whose plain bit field is
+//!     not in ::connectivity_bit_field, or NULL if there are none
+static compressed_bit_field_t *compressed_bit_fields = NULL;
+
 //! \brief the number of times a DMA resulted in 0 entries
 uint32_t ghost_pop_table_searches = 0;
 
@@ -70,6 +119,22 @@ uint32_t failed_bit_field_reads = 0;
 //!     they don't hit anything
 uint32_t bit_field_filtered_packets = 0;
 
+//! \brief The number of bit fields that were read in compressed to save DTCM
+uint32_t compressed_bit_field_reads = 0;
+
+//! \brief The number of spikes tested against a Bloom filter
+uint32_t bloom_filter_tests = 0;
+
+//! \brief The number of spikes that a Bloom filter passed but which were
+//!     then filtered by the full bit field
+uint32_t bloom_filter_false_positives = 0;
+
+//! \brief The number of lookups that matched a recently matched entry
+uint32_t pop_table_cache_hits = 0;
+
+//! \brief The number of lookups that had to look up the table
+uint32_t pop_table_cache_misses = 0;
+
 //! \brief Prints the master pop table.
 //! \details For debugging
 static inline void print_master_population_table(void) {
@@ -78,18 +143,19 @@ static inline void print_master_population_table(void) {
     for (uint32_t i = 0; i < master_population_table_length; i++) {
         master_population_table_entry entry = master_population_table[i];
         log_info("key: 0x%08x, mask: 0x%08x", entry.key, entry.mask);
-        int count = entry.count;
-        int start = entry.start;
+        uint32_t count = entry.count;
+        uint32_t start = extended_format ? entry_starts[i] : entry.start;
 		log_info("    core_mask: 0x%08x, core_shift: %u, n_neurons: %u, n_words: %u, n_colour_bits: %u",
 				entry.core_mask, entry.mask_shift, entry.n_neurons, entry.n_words, entry.n_colour_bits);
-        for (uint16_t j = start; j < (start + count); j++) {
-            address_list_entry addr = address_list[j];
-            if (addr.address == INVALID_ADDRESS) {
+        for (uint32_t j = start; j < (start + count); j++) {
+            uint32_t offset, row_length;
+            if (!get_address_list_item(address_list, extended_format, j,
+                    &offset, &row_length)) {
                 log_info("    index %d: INVALID", j);
             } else {
                 log_info("    index %d: offset: %u, address: 0x%08x, row_length: %u",
-                    j, get_offset(addr), get_address(addr, synaptic_rows_base_address),
-                    get_row_length(addr));
+                    j, offset, offset + synaptic_rows_base_address,
+                    row_length);
             }
         }
     }
@@ -115,6 +181,62 @@ static inline void print_bitfields(uint32_t mp_i, filter_info_t *filters) {
 #endif
 }
 
+//! \brief Read in a compressed form of a bit field
+//! \param[in] mp_i: The master population table entry index
+//! \param[in] filter: The bit field to read
+//! \param[in] n_runs: The number of runs of set bits in the bit field
+//! \param[in] use_runs: Whether to use the run-length form; if not, a Bloom
+//!     filter is made
+//! \return Whether there was space to read in the compressed bit field
+static bool load_compressed_bit_field(uint32_t mp_i, filter_info_t *filter,
+        uint32_t n_runs, bool use_runs) {
+    if (compressed_bit_fields == NULL) {
+        compressed_bit_fields = spin1_malloc(
+                sizeof(compressed_bit_field_t) * master_population_table_length);
+        if (compressed_bit_fields == NULL) {
+            return false;
+        }
+        for (uint32_t i = 0; i < master_population_table_length; i++) {
+            compressed_bit_fields[i].type = COMPRESSED_NONE;
+        }
+    }
+    uint32_t n_atoms = filter->n_atoms;
+    compressed_bit_field_t *compressed = &compressed_bit_fields[mp_i];
+    bool loaded;
+    if (use_runs) {
+        loaded = compressed_make_runs(compressed, filter->data, n_atoms, n_runs);
+    } else {
+        loaded = compressed_make_bloom(compressed, filter->data, n_atoms,
+                get_bit_field_size(n_atoms));
+    }
+    if (loaded) {
+        compressed_bit_field_reads += 1;
+        log_debug("Bit field for key 0x%08x compressed as type %u",
+                master_population_table[mp_i].key, compressed->type);
+    }
+    return loaded;
+}
+
+//! \brief Test a compressed bit field
+//! \param[in] compressed: The compressed bit field
+//! \param[in] id: The bit to test
+//! \return Whether the bit is set
+static inline bool compressed_bit_field_test(
+        const compressed_bit_field_t *compressed, uint32_t id) {
+    if (compressed->type == COMPRESSED_RUNS) {
+        return compressed_test_runs(compressed, id);
+    }
+    bloom_filter_tests += 1;
+    if (!compressed_test_bloom(compressed, id)) {
+        return false;
+    }
+    if (!bit_field_test(compressed->sdram_data, id)) {
+        bloom_filter_false_positives += 1;
+        return false;
+    }
+    return true;
+}
+
 bool population_table_load_bitfields(filter_region_t *filter_region) {
 
     if (master_population_table_length == 0) {
@@ -154,16 +276,44 @@ bool population_table_load_bitfields(filter_region_t *filter_region) {
                      mp_i, filters[mp_i].key, master_population_table[mp_i].key);
              return false;
          }
+    }
+
+    // Load in the order written after the last bit field, which puts those
+    // that filter the most spikes per word first in case DTCM runs out
+    filter_info_t *last = &filters[master_population_table_length - 1];
+    uint32_t *load_order = &last->data[get_bit_field_size(last->n_atoms)];
+    for (uint32_t i = 0; i < master_population_table_length; i++) {
+         uint32_t mp_i = load_order[i];
+         if (mp_i >= master_population_table_length) {
+             log_error("Bitfield load order item %u is %u of %u entries",
+                     i, mp_i, master_population_table_length);
+             return false;
+         }
          uint32_t useful = !(filters[mp_i].merged || filters[mp_i].all_ones);
 
          if (useful) {
-             // Try to allocate all the bitfields for this entry
              uint32_t n_words = get_bit_field_size(filters[mp_i].n_atoms);
              uint32_t size = sizeof(bit_field_t) * n_words;
+
+             // A short enough run-length form leaves space for other entries
+             uint32_t n_runs = compressed_count_runs(
+                     filters[mp_i].data, filters[mp_i].n_atoms);
+             bool runs_smaller = (n_runs < 0xFFFF) && ((2 * n_runs) < n_words);
+             if (runs_smaller && (4 * n_runs) <= n_words &&
+                     load_compressed_bit_field(
+                             mp_i, &filters[mp_i], n_runs, true)) {
+                 continue;
+             }
+
+             // Try to allocate all the bitfields for this entry
              connectivity_bit_field[mp_i] = spin1_malloc(size);
              if (connectivity_bit_field[mp_i] == NULL) {
-                 // There might be more than one that has failed
-                 failed_bit_field_reads += 1;
+                 // Try to fit a compressed form instead
+                 if (!load_compressed_bit_field(
+                         mp_i, &filters[mp_i], n_runs, runs_smaller)) {
+                     // There might be more than one that has failed
+                     failed_bit_field_reads += 1;
+                 }
              } else {
                  spin1_memcpy(connectivity_bit_field[mp_i], filters[mp_i].data, size);
                  print_bitfields(mp_i, filters);
@@ -179,6 +329,20 @@ bool population_table_load_bitfields(filter_region_t *filter_region) {
 //! \return True if there is a matching entry, False otherwise
 static inline bool population_table_position_in_the_master_pop_array(
         spike_t spike, uint32_t *position) {
+    if (direct_lookup != NULL) {
+        uint32_t index = direct_lookup[
+                (spike >> direct_lookup_shift) & direct_lookup_mask];
+        if (index == NO_DIRECT_ENTRY) {
+            return false;
+        }
+        master_population_table_entry entry = master_population_table[index];
+        if ((spike & entry.mask) != entry.key) {
+            return false;
+        }
+        *position = index;
+        return true;
+    }
+
     uint32_t imin = 0;
     uint32_t imax = master_population_table_length;
 
@@ -200,14 +364,58 @@ static inline bool population_table_position_in_the_master_pop_array(
     return false;
 }
 
+//! \brief Get the position in the master population table, checking the
+//!     recently matched entries before looking up the table.
+//! \param[in] spike: The spike received
+//! \param[out] position: The position found (only if returns true)
+//! \return True if there is a matching entry, False otherwise
+static inline bool population_table_cached_position(
+        spike_t spike, uint32_t *position) {
+#if POP_TABLE_CACHE_SIZE > 0
+    for (uint32_t i = 0; i < position_cache_count; i++) {
+        uint32_t cached = position_cache[i];
+        master_population_table_entry entry = master_population_table[cached];
+        if ((spike & entry.mask) == entry.key) {
+            // Move to the front so the most recent is checked first
+            for (; i > 0; i--) {
+                position_cache[i] = position_cache[i - 1];
+            }
+            position_cache[0] = cached;
+            pop_table_cache_hits++;
+            *position = cached;
+            return true;
+        }
+    }
+    pop_table_cache_misses++;
+
+    if (!population_table_position_in_the_master_pop_array(spike, position)) {
+        return false;
+    }
+
+    // Insert at the front, dropping the least recently matched if full
+    if (position_cache_count < POP_TABLE_CACHE_SIZE) {
+        position_cache_count++;
+    }
+    for (uint32_t i = position_cache_count - 1; i > 0; i--) {
+        position_cache[i] = position_cache[i - 1];
+    }
+    position_cache[0] = *position;
+    return true;
+#else
+    pop_table_cache_misses++;
+    return population_table_position_in_the_master_pop_array(spike, position);
+#endif
+}
+
 bool population_table_setup(address_t table_address, uint32_t *row_max_n_words,
         uint32_t *master_pop_table_length,
         master_population_table_entry **master_pop_table,
-        address_list_entry **address_list) {
+        void **address_list, uint32_t **entry_starts) {
     pop_table_config_t *config = (pop_table_config_t *) table_address;
     *row_max_n_words = 0xFF + N_SYNAPSE_ROW_HEADER_WORDS;
 
     *master_pop_table_length = config->table_length;
+    *entry_starts = NULL;
 
     if (*master_pop_table_length == 0) {
         return true;
@@ -224,9 +432,7 @@ bool population_table_setup(address_t table_address, uint32_t *row_max_n_words,
         return false;
     }
 
-    uint32_t address_list_length = config->addr_list_length;
-    uint32_t n_address_list_bytes =
-            address_list_length * sizeof(address_list_entry);
+    uint32_t n_address_list_bytes = pop_table_address_list_bytes(config);
 
     *address_list = spin1_malloc(n_address_list_bytes);
     if (*address_list == NULL) {
@@ -235,36 +441,69 @@ bool population_table_setup(address_t table_address, uint32_t *row_max_n_words,
         return false;
     }
 
+    // The extended format has the start of each entry in a whole word
+    if (config->format == POP_TABLE_EXTENDED_FORMAT) {
+        uint32_t n_start_bytes = *master_pop_table_length * sizeof(uint32_t);
+        *entry_starts = spin1_malloc(n_start_bytes);
+        if (*entry_starts == NULL) {
+            log_error("Could not allocate master population entry starts of"
+                    " %u bytes", n_start_bytes);
+            return false;
+        }
+        spin1_memcpy(*entry_starts, pop_table_extended_starts(config),
+                n_start_bytes);
+    }
+
     // Copy the master population table
     spin1_memcpy(*master_pop_table, config->data, n_master_pop_bytes);
-    spin1_memcpy(*address_list, &config->data[*master_pop_table_length],
+    spin1_memcpy(*address_list, pop_table_address_list(config),
             n_address_list_bytes);
     return true;
 }
-//! \}
-
-//! \name API functions
-//! \{
 
-bool population_table_initialise(
-        address_t table_address, address_t synapse_rows_address,
-        uint32_t *row_max_n_words) {
-    population_table_setup(table_address, row_max_n_words,
-            &master_population_table_length,
-            &master_population_table, &address_list);
+//! \brief Count a packet filtered out by a bit field against each item of the
+//!     entry it matched, which are from ::next_item for ::items_to_go items
+static inline void count_filtered_packet(void) {
+    if (event_counters != NULL) {
+        for (uint32_t i = next_item; i < next_item + items_to_go; i++) {
+            event_counters[i].n_filtered++;
+        }
+    }
+}
 
-    // Store the base address
-    synaptic_rows_base_address = (uint32_t) synapse_rows_address;
+//! \brief Set up the direct index into the table, if there is one
+//! \param[in] table_address: The address of the start of the table data
+static void population_table_setup_direct_lookup(address_t table_address) {
+    pop_table_config_t *config = (pop_table_config_t *) table_address;
+    pop_table_direct_config_t *direct_config = pop_table_direct_config(config);
+    if (direct_config->n_bits == 0) {
+        log_info("Using binary search of the master population table");
+        return;
+    }
 
-    print_master_population_table();
-    return true;
+    uint32_t n_index_bytes = (1 << direct_config->n_bits) * sizeof(uint16_t);
+    direct_lookup = spin1_malloc(n_index_bytes);
+    if (direct_lookup == NULL) {
+        log_warning("Could not allocate direct population table index of %u"
+                " bytes; falling back to binary search", n_index_bytes);
+        return;
+    }
+    spin1_memcpy(direct_lookup, direct_config->index, n_index_bytes);
+    direct_lookup_shift = direct_config->shift;
+    direct_lookup_mask = (1 << direct_config->n_bits) - 1;
+    log_info("Using direct population table index of %u bits at shift %u",
+            direct_config->n_bits, direct_lookup_shift);
 }
+//! \}
 
-bool population_table_get_first_address(spike_t spike, pop_table_lookup_result_t *result) {
-
+//! \brief Find the entry of a spike and get ready to go through its address
+//!     list items
+//! \param[in] spike: The spike received
+//! \return True if there are items to go through, False if not
+static inline bool start_lookup(spike_t spike) {
     // check we don't have a complete miss
     uint32_t position;
-    if (!population_table_position_in_the_master_pop_array(spike, &position)) {
+    if (!population_table_cached_position(spike, &position)) {
         invalid_master_pop_hits++;
         return false;
     }
@@ -272,7 +511,7 @@ bool population_table_get_first_address(spike_t spike, pop_table_lookup_result_t
     master_population_table_entry entry = master_population_table[position];
 
     last_spike = spike;
-    next_item = entry.start;
+    next_item = extended_format ? entry_starts[position] : entry.start;
     items_to_go = entry.count;
 	uint32_t local_neuron_id = get_local_neuron_id(entry, spike);
 	if (entry.n_colour_bits) {
@@ -294,10 +533,109 @@ bool population_table_get_first_address(spike_t spike, pop_table_lookup_result_t
         if (!bit_field_test(
                 connectivity_bit_field[position], last_neuron_id)) {
             bit_field_filtered_packets += 1;
+            count_filtered_packet();
+            items_to_go = 0;
+            return false;
+        }
+    } else if (compressed_bit_fields != NULL &&
+            compressed_bit_fields[position].type != COMPRESSED_NONE) {
+        // The entry might have a bit field compressed to fit in DTCM
+        if (!compressed_bit_field_test(
+                &compressed_bit_fields[position], last_neuron_id)) {
+            bit_field_filtered_packets += 1;
+            count_filtered_packet();
             items_to_go = 0;
             return false;
         }
     }
+    return true;
+}
+
+//! \brief Go through the next address list item of the last spike
+//! \param[out] result: Updated with the lookup details if there is a row
+//! \return True if the item has a row to read, False if not
+static inline bool next_item_address(pop_table_lookup_result_t *result) {
+    bool is_valid = false;
+    uint32_t offset, row_length;
+    if (get_address_list_item(address_list, extended_format, next_item,
+            &offset, &row_length)) {
+
+        get_block_row_addr_and_size(offset + synaptic_rows_base_address,
+                row_length, last_neuron_id, result);
+        result->colour = last_colour;
+        result->colour_mask = last_colour_mask;
+        if (event_counters != NULL) {
+            event_counters[next_item].n_rows++;
+            event_counters[next_item].n_words +=
+                    result->n_bytes_to_transfer >> 2;
+        }
+        is_valid = true;
+    }
+
+    next_item++;
+    items_to_go--;
+    return is_valid;
+}
+
+//! \name API functions
+//! \{
+
+bool population_table_initialise(
+        address_t table_address, address_t synapse_rows_address,
+        uint32_t *row_max_n_words) {
+    if (!population_table_setup(table_address, row_max_n_words,
+            &master_population_table_length,
+            &master_population_table, &address_list, &entry_starts)) {
+        return false;
+    }
+    extended_format = (entry_starts != NULL);
+    pop_table_config_t *config = (pop_table_config_t *) table_address;
+    address_list_length = config->addr_list_length;
+    if (extended_format) {
+        log_info("Using the extended master population table format");
+    }
+    if (master_population_table_length > 0) {
+        population_table_setup_direct_lookup(table_address);
+    }
+
+    // Store the base address
+    synaptic_rows_base_address = (uint32_t) (uintptr_t) synapse_rows_address;
+
+    print_master_population_table();
+    return true;
+}
+
+void population_table_set_event_counters(address_t sdram_counters) {
+    if (address_list_length == 0) {
+        return;
+    }
+    uint32_t n_bytes =
+            address_list_length * sizeof(pop_table_event_counters_t);
+    event_counters = spin1_malloc(n_bytes);
+    if (event_counters == NULL) {
+        log_warning("Could not allocate %u bytes to count the events of each"
+                " projection; these will not be counted", n_bytes);
+        return;
+    }
+    for (uint32_t i = 0; i < address_list_length; i++) {
+        event_counters[i] = (pop_table_event_counters_t) {0, 0, 0};
+    }
+    sdram_event_counters = (pop_table_event_counters_t *) sdram_counters;
+    log_info("Counting the events of %u address list items at 0x%08x",
+            address_list_length, sdram_event_counters);
+}
+
+void population_table_store_event_counters(void) {
+    if (event_counters != NULL) {
+        spin1_memcpy(sdram_event_counters, event_counters,
+                address_list_length * sizeof(pop_table_event_counters_t));
+    }
+}
+
+bool population_table_get_first_address(spike_t spike, pop_table_lookup_result_t *result) {
+    if (!start_lookup(spike)) {
+        return false;
+    }
 
     // A local address is used here as the interface requires something
     // to be passed in but using the address of an argument is odd!
@@ -319,21 +657,10 @@ bool population_table_get_next_address(spike_t *spike, pop_table_lookup_result_t
 
     bool is_valid = false;
     do {
-        address_list_entry item = address_list[next_item];
-        if (item.address != INVALID_ADDRESS) {
-
-        	get_row_addr_and_size(item, synaptic_rows_base_address,
-        			last_neuron_id, result);
-            *spike = last_spike;
-            result->colour = last_colour;
-            result->colour_mask = last_colour_mask;
-            is_valid = true;
-        }
-
-        next_item++;
-        items_to_go--;
+        is_valid = next_item_address(result);
     } while (!is_valid && (items_to_go > 0));
 
+    *spike = last_spike;
     return is_valid;
 }
 
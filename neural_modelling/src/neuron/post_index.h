@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*! \file
+ * \brief The format of the index of the plastic synapses of each neuron of a
+ *     synapse core, so that a post-synaptic spike can be applied to the
+ *     synapses of a neuron without waiting for their rows to be read
+ *
+ * The host writes the header and leaves room for the entries; the synapse
+ * expander fills in the rest once the synaptic matrix is complete.  The
+ * entries of neuron n are from `starts[n]` up to `starts[n + 1]`.
+ */
+
+#ifndef _POST_INDEX_H_
+#define _POST_INDEX_H_
+
+#include <common/neuron-typedefs.h>
+#include <neuron/synapse_row.h>
+
+//! A plastic synapse of a neuron
+typedef struct post_index_entry {
+    //! The address in SDRAM of the row that holds the synapse
+    synaptic_row_t row;
+    //! The index of the synapse in the plastic region of the row
+    uint16_t synapse_index;
+    //! The synapse type of the synapse
+    uint16_t synapse_type;
+} post_index_entry_t;
+
+//! The index of the plastic synapses of each neuron
+typedef struct post_index {
+    //! The number of neurons indexed
+    uint32_t n_neurons;
+    //! The bits of the control word of a synapse that hold its neuron
+    uint32_t synapse_index_bits;
+    //! The bits of the control word above the neuron that hold its type
+    uint32_t synapse_type_bits;
+    //! The most entries there is room for
+    uint32_t max_entries;
+    //! The first entry of each neuron, and one past the last of the last
+    uint32_t starts[];
+    // Followed by the entries
+} post_index_t;
+
+//! \brief Get the entries of an index
+//! \param[in] index: The index
+//! \return The entries, which follow the starts
+static inline post_index_entry_t *post_index_entries(post_index_t *index) {
+    return (post_index_entry_t *) &index->starts[index->n_neurons + 1];
+}
+
+#endif  // _POST_INDEX_H_
@@ -24,5 +24,18 @@ enum profiler_tags_e {
     PROFILER_DMA_READ,                  //!< DMA read
     PROFILER_INCOMING_SPIKE,            //!< incoming spike handling
     PROFILER_PROCESS_FIXED_SYNAPSES,    //!< fixed synapse processing
-    PROFILER_PROCESS_PLASTIC_SYNAPSES   //!< plastic synapse processing
+    PROFILER_PROCESS_PLASTIC_SYNAPSES,  //!< plastic synapse processing
+    // The phases of the synapse core time step; see spike_processing_fast.c
+    PROFILER_DMA_WAIT,                  //!< waiting for a synaptic row DMA
+    PROFILER_PROCESS_ROWS,              //!< processing synaptic rows
+    PROFILER_WRITE_BACK,                //!< writing back plastic rows
+    PROFILER_TRANSFER,                  //!< transferring the ring buffers
+    PROFILER_POP_TABLE_LOOKUP,          //!< master population table lookup
+    PROFILER_LOCAL_ONLY_SPIKE           //!< local-only spike processing
 };
+
+//! The first of the tags of the phases of the synapse core time step
+#define PROFILER_FIRST_PHASE PROFILER_DMA_WAIT
+
+//! The number of phases of the synapse core time step
+#define PROFILER_N_PHASES (PROFILER_POP_TABLE_LOOKUP - PROFILER_FIRST_PHASE + 1)
@@ -18,13 +18,33 @@
 
 #include "plasticity/synapse_dynamics.h"
 #include <common/send_mc.h>
+#include <bit_field.h>
+
+#ifndef SPIKE_SEND_BATCHED
+//! \brief Whether to note the spikes of a timestep and send them all together
+//!     once every neuron has been updated, rather than as each neuron spikes
+#define SPIKE_SEND_BATCHED 0
+#endif
+
+#ifndef SPIKE_SEND_PAYLOAD
+//! \brief Whether a neuron that spikes more than once in a batched timestep
+//!     sends one packet with the number of spikes as the payload, rather than
+//!     one packet per spike
+#define SPIKE_SEND_PAYLOAD 0
+#endif
 
 //! Whether to use key from neuron.c
 extern bool use_key;
 
-//! Keys for each neuron
+//! Keys for each neuron, or NULL if they are worked out
 extern uint32_t *neuron_keys;
 
+//! The key of the first neuron, if the keys are worked out
+extern uint32_t neuron_key_base;
+
+//! The shift of the neuron index in the key, if the keys are worked out
+extern uint32_t neuron_key_shift;
+
 //! Earliest time from neuron.c
 extern uint32_t earliest_send_time;
 
@@ -34,6 +54,27 @@ extern uint32_t latest_send_time;
 //! The time step colour to account for delay
 extern uint32_t colour;
 
+#if SPIKE_SEND_BATCHED
+//! The neurons that have spiked in this timestep, from neuron.c
+extern bit_field_t spiked_neurons;
+
+//! The number of words in ::spiked_neurons
+extern uint32_t n_spiked_neurons_words;
+
+//! The number of times each neuron has spiked in this timestep, from neuron.c
+extern uint16_t *neuron_spike_counts;
+#endif
+
+//! \brief Get the key of a neuron
+//! \param[in] neuron_index: The index of the neuron
+//! \return The key, without the colour
+static inline uint32_t neuron_key(uint32_t neuron_index) {
+    if (neuron_keys == NULL) {
+        return neuron_key_base + (neuron_index << neuron_key_shift);
+    }
+    return neuron_keys[neuron_index];
+}
+
 //! \brief Performs the sending of a spike.  Inlined for speed.
 //! \param[in] timer_count The global timer count when the time step started
 //! \param[in] time The current time step
@@ -44,7 +85,11 @@ static inline void send_spike(UNUSED uint32_t timer_count, uint32_t time,
     synapse_dynamics_process_post_synaptic_event(time, neuron_index);
 
     if (use_key) {
-        send_spike_mc(neuron_keys[neuron_index] | colour);
+#if SPIKE_SEND_BATCHED
+        bit_field_set(spiked_neurons, neuron_index);
+        neuron_spike_counts[neuron_index]++;
+#else
+        send_spike_mc(neuron_key(neuron_index) | colour);
 
         // Keep track of provenance data
         uint32_t clocks = tc[T1_COUNT];
@@ -54,7 +99,60 @@ static inline void send_spike(UNUSED uint32_t timer_count, uint32_t time,
         if (clocks < latest_send_time) {
             latest_send_time = clocks;
         }
+#endif
+    }
+}
+
+#if SPIKE_SEND_BATCHED
+//! \brief Send the spikes noted in this timestep by send_spike()
+//! \details Only the words of ::spiked_neurons with a bit set are looked at
+//!     in detail, so this is cheap when few neurons spike.
+static inline void send_spike_batch(void) {
+    if (!use_key) {
+        return;
+    }
+
+    uint32_t start_clocks = tc[T1_COUNT];
+    bool sent = false;
+    for (uint32_t w = 0; w < n_spiked_neurons_words; w++) {
+        uint32_t bits = spiked_neurons[w];
+        if (bits == 0) {
+            continue;
+        }
+        spiked_neurons[w] = 0;
+        sent = true;
+        while (bits != 0) {
+            uint32_t neuron_index = (w << 5) + __builtin_ctz(bits);
+            bits &= bits - 1;
+            uint32_t key = neuron_key(neuron_index) | colour;
+            uint32_t n_spikes = neuron_spike_counts[neuron_index];
+            neuron_spike_counts[neuron_index] = 0;
+#if SPIKE_SEND_PAYLOAD
+            if (n_spikes > 1) {
+                send_spike_mc_payload(key, n_spikes);
+                continue;
+            }
+            send_spike_mc(key);
+#else
+            for (; n_spikes > 0; n_spikes--) {
+                send_spike_mc(key);
+            }
+#endif
+        }
+    }
+
+    // Keep track of provenance data; the whole batch is sent between the
+    // two times
+    if (sent) {
+        uint32_t end_clocks = tc[T1_COUNT];
+        if (start_clocks > earliest_send_time) {
+            earliest_send_time = start_clocks;
+        }
+        if (end_clocks < latest_send_time) {
+            latest_send_time = end_clocks;
+        }
     }
 }
+#endif // SPIKE_SEND_BATCHED
 
 #endif // __SEND_SPIKE_H__
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*! \file
+ * \brief The format of the inputs sent by a synapse core to a neuron core
+ *     when only the words that are not zero are sent
+ *
+ * The SDRAM of each synapse core has room for the inputs of all the neurons,
+ * followed by a header word.  The header is either ::SPARSE_TRANSFER_DENSE,
+ * when all the inputs are there, or the number of ::sparse_input that are at
+ * the start instead, each of which is a word of the inputs that is not zero
+ * and its index.
+ */
+
+#ifndef _SPARSE_TRANSFER_H_
+#define _SPARSE_TRANSFER_H_
+
+#include <common/neuron-typedefs.h>
+
+//! The header of inputs that are all sent
+#define SPARSE_TRANSFER_DENSE 0xFFFFFFFF
+
+//! The size of the header that follows the inputs
+#define SPARSE_TRANSFER_HEADER_BYTES sizeof(uint32_t)
+
+//! A word of the inputs that is not zero
+struct sparse_input {
+    //! The index of the word in the inputs
+    uint32_t index;
+    //! The word, holding two inputs
+    uint32_t inputs;
+};
+
+//! \brief List the words of some inputs that are not zero, as long as that
+//!     is smaller than the inputs
+//! \param[in] inputs: The inputs to list
+//! \param[in] n_words: The number of words of the inputs
+//! \param[out] sparse: Where to list them; room for half of the words
+//! \return The number listed, or ::SPARSE_TRANSFER_DENSE if there are so many
+//!     that the inputs should be sent as they are
+static inline uint32_t sparse_transfer_pack(
+        const uint32_t *inputs, uint32_t n_words,
+        struct sparse_input *sparse) {
+    uint32_t max_sparse = (n_words - 1) >> 1;
+    uint32_t n_sparse = 0;
+    for (uint32_t i = 0; i < n_words; i++) {
+        if (inputs[i] != 0) {
+            if (n_sparse == max_sparse) {
+                return SPARSE_TRANSFER_DENSE;
+            }
+            sparse[n_sparse].index = i;
+            sparse[n_sparse].inputs = inputs[i];
+            n_sparse++;
+        }
+    }
+    return n_sparse;
+}
+
+#endif  // _SPARSE_TRANSFER_H_
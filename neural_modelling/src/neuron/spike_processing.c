@@ -20,12 +20,20 @@
 #include "population_table/population_table.h"
 #include "synapse_row.h"
 #include "synapses.h"
+#include "plasticity/synapse_dynamics.h"
 #include "structural_plasticity/synaptogenesis_dynamics.h"
 #include <simulation.h>
 #include <debug.h>
 #include <common/in_spikes.h>
 #include <recording.h>
 
+//! \brief The most rewires that can be done on one DMA of a span of rows;
+//!     1 reads the row of each rewire on its own.  This can be set per binary
+//!     at build time.
+#ifndef REWIRE_BATCH_SIZE
+#define REWIRE_BATCH_SIZE 1
+#endif
+
 //! DMA buffer structure combines the row read from SDRAM with information
 //! about the read.
 typedef struct dma_buffer {
@@ -47,6 +55,14 @@ typedef struct dma_buffer {
 
     //! Row data
     synaptic_row_t row;
+
+#if REWIRE_BATCH_SIZE > 1
+    //! The number of rewires to do on the rows in the buffer
+    uint32_t n_rewire_rows;
+
+    //! The SDRAM addresses of the rows to rewire, in the order to rewire them
+    synaptic_row_t rewire_rows[REWIRE_BATCH_SIZE];
+#endif
 } dma_buffer;
 
 //! The number of DMA Buffers to use
@@ -97,6 +113,18 @@ static uint32_t spike_processing_count;
 //! The number of successful rewires
 static uint32_t n_successful_rewires;
 
+#if REWIRE_BATCH_SIZE > 1
+//! The size of each DMA buffer in bytes, which limits the span of a batch
+static uint32_t dma_buffer_bytes;
+
+//! \brief Whether there is a rewire that has been set up but did not fit in
+//!     the last batch, which must be done next to keep the rewiring in order
+static bool rewire_pending;
+
+//! The result of the lookup of the rewire that is pending
+static pop_table_lookup_result_t pending_rewire;
+#endif
+
 //! \brief How many packets were lost from the input buffer because of
 //!     late arrival
 static uint32_t count_input_buffer_packets_late;
@@ -153,6 +181,16 @@ static inline void do_dma_read(
 static inline bool is_something_to_do(
         spike_t *spike, pop_table_lookup_result_t *result, uint32_t *n_rewire,
 		uint32_t *n_process_spike) {
+#if REWIRE_BATCH_SIZE > 1
+    // A rewire left over from the last batch goes next
+    if (rewire_pending) {
+        rewire_pending = false;
+        *result = pending_rewire;
+        *n_rewire += 1;
+        return true;
+    }
+#endif
+
     // Disable interrupts here as dma_busy modification is a critical section
     uint cpsr = spin1_int_disable();
 
@@ -173,7 +211,6 @@ static inline bool is_something_to_do(
         *n_process_spike += 1;
         return true;
     }
-    cpsr = spin1_int_disable();
 
     // track for provenance
     uint32_t input_buffer_filled_size = in_spikes_size();
@@ -181,19 +218,22 @@ static inline bool is_something_to_do(
         biggest_fill_size_of_input_buffer = input_buffer_filled_size;
     }
 
-    // Are there any more spikes to process?
-    while (in_spikes_get_next_spike(spike)) {
-        // Enable interrupts while looking up in the master pop table,
-        // as this can be slow
-        spin1_mode_restore(cpsr);
-        if (population_table_get_first_address(*spike, result)) {
-            synaptogenesis_spike_received(time, *spike);
-            *n_process_spike += 1;
-            return true;
+    // Are there any more spikes to process?  The input buffer has a single
+    // reader and writer, so this doesn't need interrupts disabled, except to
+    // be sure that it is empty when the DMA is marked as not busy
+    while (true) {
+        while (in_spikes_get_next_spike(spike)) {
+            if (population_table_get_first_address(*spike, result)) {
+                synaptogenesis_spike_received(time, *spike);
+                *n_process_spike += 1;
+                return true;
+            }
         }
-
-        // Disable interrupts before checking if there is another spike
         cpsr = spin1_int_disable();
+        if (in_spikes_size() == 0) {
+            break;
+        }
+        spin1_mode_restore(cpsr);
     }
 
     // If nothing to do, the DMA is not busy
@@ -204,6 +244,75 @@ static inline bool is_something_to_do(
     return false;
 }
 
+#if REWIRE_BATCH_SIZE > 1
+//! \brief Take one of the outstanding rewires, if there are any
+//! \return True if a rewire was taken
+static inline bool take_rewire(void) {
+    uint cpsr = spin1_int_disable();
+    bool taken = rewires_to_do > 0;
+    if (taken) {
+        rewires_to_do--;
+    }
+    spin1_mode_restore(cpsr);
+    return taken;
+}
+
+//! \brief Add a rewire to a buffer if its row is already in the buffer
+//! \param[in] buffer: The buffer to add to
+//! \param[in] result: The result of the lookup of the rewire
+//! \return True if the rewire was added
+static inline bool add_rewire_in_buffer(
+        dma_buffer *buffer, const pop_table_lookup_result_t *result) {
+    uint8_t *start = (uint8_t *) buffer->sdram_writeback_address;
+    uint8_t *row = (uint8_t *) result->row_address;
+    if (buffer->n_rewire_rows >= REWIRE_BATCH_SIZE || row < start ||
+            (row + result->n_bytes_to_transfer) >
+            (start + buffer->n_bytes_transferred)) {
+        return false;
+    }
+    buffer->rewire_rows[buffer->n_rewire_rows++] = result->row_address;
+    return true;
+}
+
+//! \brief Set up more rewires and widen the read of the first to take in
+//!     their rows too, as long as the rows fit in a buffer together.
+//! \details The rewires are done in the order they are set up, so the
+//!     first one that doesn't fit is left pending to start the next read.
+//! \param[in,out] result: The result of the lookup of the first rewire,
+//!     which is updated to cover the rows of the batch
+//! \param[out] rewire_rows: The rows of the batch in order
+//! \return The number of rewires in the batch
+static inline uint32_t gather_rewires(pop_table_lookup_result_t *result,
+        synaptic_row_t *rewire_rows) {
+    uint8_t *start = (uint8_t *) result->row_address;
+    uint8_t *end = start + result->n_bytes_to_transfer;
+    rewire_rows[0] = result->row_address;
+    uint32_t n_rows = 1;
+    spike_t spike;
+    while (n_rows < REWIRE_BATCH_SIZE && take_rewire()) {
+        pop_table_lookup_result_t next;
+        if (!synaptogenesis_dynamics_rewire(time, &spike, &next)) {
+            continue;
+        }
+        uint8_t *row = (uint8_t *) next.row_address;
+        uint8_t *row_end = row + next.n_bytes_to_transfer;
+        uint8_t *new_start = (row < start) ? row : start;
+        uint8_t *new_end = (row_end > end) ? row_end : end;
+        if ((uint32_t) (new_end - new_start) > dma_buffer_bytes) {
+            pending_rewire = next;
+            rewire_pending = true;
+            break;
+        }
+        start = new_start;
+        end = new_end;
+        rewire_rows[n_rows++] = next.row_address;
+    }
+    result->row_address = (synaptic_row_t) start;
+    result->n_bytes_to_transfer = end - start;
+    return n_rows;
+}
+#endif
+
 //! \brief Set up a new synaptic DMA read.
 //! \details
 //! If a current_buffer is passed in, any spike found that matches the
@@ -229,6 +338,25 @@ static bool setup_synaptic_dma_read(dma_buffer *current_buffer,
     bool setup_done = false;
     while (!setup_done && is_something_to_do(
             &spike, &result, &dma_n_rewires, &dma_n_spikes)) {
+#if REWIRE_BATCH_SIZE > 1
+        if (dma_n_rewires > 0) {
+            if (current_buffer != NULL &&
+                    add_rewire_in_buffer(current_buffer, &result)) {
+                *n_rewires += dma_n_rewires;
+                dma_n_rewires = 0;
+            } else {
+                // Read the rows of as many rewires as fit together
+                dma_buffer *next_buffer = &dma_buffers[next_buffer_to_fill];
+                dma_n_rewires = gather_rewires(
+                        &result, next_buffer->rewire_rows);
+                next_buffer->n_rewire_rows = dma_n_rewires;
+                do_dma_read(spike, &result);
+                setup_done = true;
+            }
+            spike_processing_count++;
+            continue;
+        }
+#endif
         if (current_buffer != NULL &&
                 current_buffer->sdram_writeback_address == result.row_address) {
             // If we can reuse the row, add on what we can use it for
@@ -242,6 +370,9 @@ static bool setup_synaptic_dma_read(dma_buffer *current_buffer,
             current_buffer->colour = result.colour;
         } else {
             // If the row is in SDRAM, set up the transfer and we are done
+#if REWIRE_BATCH_SIZE > 1
+            dma_buffers[next_buffer_to_fill].n_rewire_rows = 0;
+#endif
             do_dma_read(spike, &result);
             setup_done = true;
         }
@@ -257,8 +388,11 @@ static bool setup_synaptic_dma_read(dma_buffer *current_buffer,
 //! \param[in] dma_buffer_index: Index of DMA buffer to use
 //! \param[in] plastic_only: If false, write the whole synaptic row.
 //!     If true, only write the plastic data region of the synaptic row.
+//! \param[in] n_plastic_words: The words at the start of the plastic region
+//!     which have changed, when only writing the plastic region
 static inline void setup_synaptic_dma_write(
-        uint32_t dma_buffer_index, bool plastic_only) {
+        uint32_t dma_buffer_index, bool plastic_only,
+        uint32_t n_plastic_words) {
     // Get pointer to current buffer
     dma_buffer *buffer = &dma_buffers[dma_buffer_index];
 
@@ -268,12 +402,14 @@ static inline void setup_synaptic_dma_write(
     void *sdram_start_address = buffer->sdram_writeback_address;
     void *dtcm_start_address = buffer->row;
     if (plastic_only) {
-        write_size = synapse_row_plastic_size(buffer->row) * sizeof(uint32_t);
+        write_size = n_plastic_words * sizeof(uint32_t);
         sdram_start_address = synapse_row_plastic_region(
                 buffer->sdram_writeback_address);
         dtcm_start_address = synapse_row_plastic_region(buffer->row);
     }
 
+    synapses_mark_row_dirty(buffer->sdram_writeback_address);
+
     // Start transfer
     while (!spin1_dma_transfer(DMA_TAG_WRITE_PLASTIC_REGION, sdram_start_address,
             dtcm_start_address, DMA_WRITE, write_size)) {
@@ -346,8 +482,26 @@ static void dma_complete_callback(UNUSED uint unused, UNUSED uint tag) {
     // Assume no write back but assume any write back is plastic only
     bool write_back = false;
     bool plastic_only = true;
+    uint32_t n_plastic_words = 0;
 
     // If rewiring, do rewiring first
+#if REWIRE_BATCH_SIZE > 1
+    // Each rewire works on its own row within the span read
+    use(n_rewires);
+    for (uint32_t i = 0; i < current_buffer->n_rewire_rows; i++) {
+        uint32_t offset = (uint8_t *) current_buffer->rewire_rows[i] -
+                (uint8_t *) current_buffer->sdram_writeback_address;
+        synaptic_row_t row = (synaptic_row_t)
+                (((uint8_t *) current_buffer->row) + offset);
+        if (synaptogenesis_row_restructure(time, row)) {
+            write_back = true;
+            plastic_only = false;
+            n_successful_rewires++;
+            synapses_mark_row_dirty(current_buffer->rewire_rows[i]);
+        }
+    }
+    current_buffer->n_rewire_rows = 0;
+#else
     for (uint32_t i = n_rewires; i > 0; i--) {
         if (synaptogenesis_row_restructure(time, current_buffer->row)) {
             write_back = true;
@@ -355,6 +509,7 @@ static void dma_complete_callback(UNUSED uint unused, UNUSED uint tag) {
             n_successful_rewires++;
         }
     }
+#endif
 
     // Process synaptic row repeatedly for any upcoming spikes
     while (n_spikes > 0) {
@@ -381,12 +536,19 @@ static void dma_complete_callback(UNUSED uint unused, UNUSED uint tag) {
             rt_error(RTE_SWERR);
         }
 
-        write_back |= write_back_now;
+        if (write_back_now) {
+            write_back = true;
+            uint32_t n_words = synapse_dynamics_get_plastic_words_changed();
+            if (n_words > n_plastic_words) {
+                n_plastic_words = n_words;
+            }
+        }
         n_spikes--;
     }
 
     if (write_back) {
-        setup_synaptic_dma_write(current_buffer_index, plastic_only);
+        setup_synaptic_dma_write(
+                current_buffer_index, plastic_only, n_plastic_words);
     }
 }
 
@@ -440,6 +602,13 @@ bool spike_processing_initialise( // EXPORTED
             return false;
         }
     }
+#if REWIRE_BATCH_SIZE > 1
+    dma_buffer_bytes = row_max_n_words * sizeof(uint32_t);
+    rewire_pending = false;
+    for (uint32_t i = 0; i < N_DMA_BUFFERS; i++) {
+        dma_buffers[i].n_rewire_rows = 0;
+    }
+#endif
     dma_busy = false;
     clear_input_buffers_of_late_packets =
         clear_input_buffers_of_late_packets_init;
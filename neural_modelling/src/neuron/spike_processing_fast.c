@@ -20,31 +20,130 @@
 #include "plasticity/synapse_dynamics.h"
 #include "structural_plasticity/synaptogenesis_dynamics.h"
 #include "dma_common.h"
+#include "profile_tags.h"
+#include "sparse_transfer.h"
 #include <scamp_spin1_sync.h>
 #include <simulation.h>
 #include <recording.h>
+#include <profiler.h>
 #include <debug.h>
 #include <wfi.h>
 
-//! DMA buffer structure combines the row read from SDRAM with information
+#if RING_BUFFER_32_BIT
+#error "The inputs sent to neuron cores are 16-bit, so the ring buffers of a \
+split synapse core must be too"
+#endif
+
+#if COMPACT_RING_BUFFERS
+#error "The inputs sent to neuron cores are laid out by the next power of two \
+neurons, so the ring buffers of a split synapse core must be too"
+#endif
+
+//! \brief The maximum number of rows that are adjacent in SDRAM that can be
+//!     merged into a single DMA.  This can be set per binary at build time.
+#ifndef MAX_ROWS_PER_DMA
+#define MAX_ROWS_PER_DMA 4
+#endif
+
+//! \brief Whether to clear the ring buffer entries of a time step as soon as
+//!     they have been transferred, instead of at the start of the next time
+//!     step.  This can be set per binary at build time.
+#ifndef FUSED_RING_BUFFER_CLEAR
+#define FUSED_RING_BUFFER_CLEAR 0
+#endif
+
+//! \brief The number of synaptic rows to keep in DTCM, so that rows used
+//!     again are not read again, and plastic rows are only written back when
+//!     they are evicted; 0 reads and writes back every row.  This can be set
+//!     per binary at build time.
+#ifndef SYNAPTIC_ROW_CACHE_SIZE
+#define SYNAPTIC_ROW_CACHE_SIZE 0
+#endif
+
+//! \brief Whether to move the point at which the ring buffers are
+//!     transferred each time step, according to the spikes left waiting and
+//!     the time left after the transfer.  This can be set per binary at
+//!     build time.
+#ifndef SYNAPSE_ADAPTIVE_TRANSFER
+#define SYNAPSE_ADAPTIVE_TRANSFER 0
+#endif
+
+//! \brief Whether to receive multicast packets by polling the communications
+//!     controller during spike processing instead of with an interrupt per
+//!     packet.  This raises the packet rate a core with a lot of input can
+//!     sustain, but packets arriving while rows are processed wait in the
+//!     router until the next poll.  This can be set per binary at build time.
+#ifndef SYNAPSE_POLLED_RECEIVE
+#define SYNAPSE_POLLED_RECEIVE 0
+#endif
+
+//! \brief Whether to send the inputs to the neuron core as a list of the
+//!     words that are not zero when that is smaller than the inputs; see
+//!     sparse_transfer.h.  This can be set per binary at build time, and
+//!     must match that of the neuron core.
+#ifndef SYNAPSE_SPARSE_TRANSFER
+#define SYNAPSE_SPARSE_TRANSFER 0
+#endif
+
+//! \brief The number of rows whose plastic header (such as the pre-synaptic
+//!     history) is kept in DTCM instead of being written back, when nothing
+//!     else in the row has changed; 0 writes back every changed header.  This
+//!     can be set per binary at build time.
+#ifndef SYNAPSE_DEFERRED_HISTORY_SIZE
+#define SYNAPSE_DEFERRED_HISTORY_SIZE 0
+#endif
+
+//! The most words of plastic header that can be kept for a row
+#define DEFERRED_HISTORY_MAX_WORDS 4
+
+//! \brief The number of plastic write backs that can wait for the DMA of the
+//!     next rows while the rows after them are processed, so that the rows
+//!     of static projections are not held up behind the write backs of
+//!     plastic ones; 0 waits for the DMA before each write back.  This can be
+//!     set per binary at build time.
+#ifndef SYNAPSE_WRITE_BACK_QUEUE_SIZE
+#define SYNAPSE_WRITE_BACK_QUEUE_SIZE 0
+#endif
+
+#if STDP_EAGER_POST && \
+        (SYNAPTIC_ROW_CACHE_SIZE > 0 || SYNAPSE_DEFERRED_HISTORY_SIZE > 0)
+#error "STDP_EAGER_POST updates synapses in SDRAM, so rows can't be kept in DTCM"
+#endif
+
+//! Mask to recognise the Comms Controller "packet received" flag
+#define RX_FULL_MASK 0x80000000
+
+//! DMA buffer structure combines the rows read from SDRAM with information
 //! about the read.
 typedef struct dma_buffer {
-    //! Address in SDRAM to write back plastic region to
+    //! Address in SDRAM of the first row, to write back plastic regions to
     synaptic_row_t sdram_writeback_address;
 
-    //! \brief Key of originating spike
+    //! \brief Keys of the originating spikes, one per row
     //! \details used to allow row data to be re-used for multiple spikes
-    spike_t originating_spike;
+    spike_t originating_spikes[MAX_ROWS_PER_DMA];
 
-    //! Number of bytes transferred in the read
+    //! Number of bytes in each row of the read
     uint32_t n_bytes_transferred;
 
-    //! Spike colour
-    uint32_t colour;
+    //! The number of rows in the read
+    uint32_t n_rows;
+
+    //! Spike colours, one per row
+    uint32_t colours[MAX_ROWS_PER_DMA];
+
+    //! The number of times to apply each row, one per row
+    uint32_t n_repeats[MAX_ROWS_PER_DMA];
 
-    //! Spike colour mask
+    //! The number of spikes the rows are for, counting repeats
+    uint32_t n_spikes;
+
+    //! Spike colour mask, shared by all the rows
     uint32_t colour_mask;
 
+    //! Whether the row is in the row cache, so it isn't read
+    bool cached;
+
     //! Row data
     synaptic_row_t row;
 } dma_buffer;
@@ -55,9 +154,154 @@ typedef struct dma_buffer {
 //! Mask to apply to perform modulo on the DMA buffer index
 #define DMA_BUFFER_MOD_MASK 0x1
 
+//! A spike that has been looked up in the population table but whose row has
+//! not yet been requested
+typedef struct lookahead_entry {
+    //! The spike that the row is for
+    spike_t spike;
+    //! The number of times the spike was received in a row
+    uint32_t n_repeats;
+    //! The details of the row to read
+    pop_table_lookup_result_t result;
+} lookahead_entry;
+
 //! The DTCM buffers for the synapse rows
 static dma_buffer dma_buffers[N_DMA_BUFFERS];
 
+#if SYNAPTIC_ROW_CACHE_SIZE > 0
+//! A synaptic row held in DTCM
+typedef struct row_cache_entry {
+    //! The address of the row in SDRAM, or NULL if the entry is not in use
+    synaptic_row_t sdram_address;
+    //! When the entry was last used, to find the least recently used
+    uint32_t last_used;
+    //! \brief The words at the start of the plastic region that have changed
+    //!     since the row was last written back; 0 if nothing has changed
+    uint32_t dirty_words;
+    //! The number of buffers waiting to be processed that use the row, which
+    //! can't be evicted until they are done
+    uint32_t pins;
+    //! The local copy of the row
+    synaptic_row_t row;
+} row_cache_entry;
+
+//! The synaptic rows held in DTCM
+static row_cache_entry row_cache[SYNAPTIC_ROW_CACHE_SIZE];
+
+//! Counts uses of the row cache, to order the entries by when last used
+static uint32_t row_cache_clock = 0;
+
+//! \brief The sources whose rows are expected to be used often enough to be
+//!     worth keeping; if there are none, only plastic rows are kept
+static struct row_cache_hints *hot_sources;
+#endif
+
+#if SYNAPSE_WRITE_BACK_QUEUE_SIZE > 0
+//! A write back of the plastic region of a row waiting for the DMA engine
+typedef struct queued_write_back {
+    //! The local copy of the changed words
+    void *tcm_address;
+    //! Where in SDRAM to write them
+    void *system_address;
+    //! The number of bytes to write
+    uint32_t n_bytes;
+} queued_write_back;
+
+//! The write backs waiting for the DMA engine, oldest first from the start
+static queued_write_back write_back_queue[SYNAPSE_WRITE_BACK_QUEUE_SIZE];
+
+//! The index of the oldest write back in the queue
+static uint32_t write_back_queue_start = 0;
+
+//! The number of write backs in the queue
+static uint32_t write_back_queue_count = 0;
+#endif
+
+#if SYNAPSE_DEFERRED_HISTORY_SIZE > 0
+//! The plastic header of a row that is newer than the one in SDRAM
+typedef struct deferred_history {
+    //! The address of the row in SDRAM, or NULL if the entry is not in use
+    synaptic_row_t sdram_address;
+    //! The words at the start of the plastic region of the row
+    uint32_t words[DEFERRED_HISTORY_MAX_WORDS];
+} deferred_history;
+
+//! The plastic headers kept in DTCM
+static deferred_history deferred_histories[SYNAPSE_DEFERRED_HISTORY_SIZE];
+
+//! \brief The words of plastic header of each row, or 0 if they can't be
+//!     kept apart from the row
+static uint32_t deferred_history_words = 0;
+#endif
+
+//! The number of rows processed from the row cache
+static uint32_t n_row_cache_hits = 0;
+
+//! The number of rows processed that were not in the row cache
+static uint32_t n_row_cache_misses = 0;
+
+//! The number of row write backs saved by keeping updated rows in DTCM
+static uint32_t n_write_backs_deferred = 0;
+
+//! The number of words of unchanged plastic data not written back
+static uint32_t n_write_back_words_saved = 0;
+
+//! The number of row write backs saved by keeping the plastic header in DTCM
+static uint32_t n_history_write_backs_deferred = 0;
+
+//! \brief The number of plastic synapses updated with post-synaptic spikes
+//!     while there were no spikes to process
+static uint32_t n_eager_post_updates = 0;
+
+//! \brief The number of plastic write backs that waited in the queue while
+//!     the rows after them were processed
+static uint32_t n_write_backs_queued = 0;
+
+//! \brief Whether a DMA has been started and not waited for; this is not
+//!     the same as having a buffer to process, as rows in the row cache are
+//!     not read
+static bool dma_outstanding = false;
+
+#if SYNAPTIC_ROW_CACHE_SIZE > 0
+//! \brief Find a row in the row cache
+//! \param[in] sdram_row The address of the row in SDRAM
+//! \return The entry of the row, or NULL if the row is not in the cache
+static inline row_cache_entry *row_cache_find(synaptic_row_t sdram_row) {
+    for (uint32_t i = 0; i < SYNAPTIC_ROW_CACHE_SIZE; i++) {
+        if (row_cache[i].sdram_address == sdram_row) {
+            return &row_cache[i];
+        }
+    }
+    return NULL;
+}
+
+//! \brief Determine if a spike is from a source that the host expects to be
+//!     hot enough for its rows to be worth keeping
+//! \param[in] spike The spike to check
+//! \return Whether the rows of the spike should be kept
+static inline bool row_cache_is_hot(spike_t spike) {
+    for (uint32_t i = 0; i < hot_sources->n_sources; i++) {
+        if ((spike & hot_sources->sources[i].mask)
+                == hot_sources->sources[i].key) {
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
+//! The row looked up ahead of the one being read, if ::lookahead_valid
+static lookahead_entry lookahead;
+
+//! Whether ::lookahead holds a row waiting to be read
+static bool lookahead_valid;
+
+//! The size of each DMA buffer in bytes
+static uint32_t dma_buffer_n_bytes;
+
+//! The number of rows that were read as part of the DMA of an earlier row
+static uint32_t n_rows_coalesced = 0;
+
 //! The index of the next buffer to be filled by a DMA
 static uint32_t next_buffer_to_fill;
 
@@ -71,13 +315,65 @@ static uint32_t count_input_buffer_packets_late;
 //! tracker of how full the input buffer got.
 static uint32_t biggest_fill_size_of_input_buffer;
 
-//! \brief Whether if we should clear packets from the input buffer at the
-//!     end of a timer tick.
-static bool clear_input_buffers_of_late_packets;
+//! \brief The number of times the last spike taken from the input buffer was
+//!     received in a row, so that its rows are read once and applied that many
+//!     times
+static uint32_t spike_n_repeats;
+
+//! The number of row reads saved by applying rows more than once
+static uint32_t n_repeated_row_applications = 0;
+
+//! How to drop the late packets, when they are cleared
+static struct late_packet_config late_packets;
+
+//! The time step about to start, to work out the age of late packets
+static uint32_t late_packet_time;
+
+//! The number of late packets dropped by the policy
+static uint32_t n_late_packets_dropped = 0;
 
 //! The number of CPU cycles taken to transfer spikes (measured later)
 static uint32_t clocks_to_transfer = 0;
 
+//! \brief The number of CPU cycles taken to read and add the inputs of
+//!     another synapse core (measured later)
+static uint32_t clocks_to_reduce = 0;
+
+#if SYNAPSE_ADAPTIVE_TRANSFER
+//! Whether the point of the transfer is moved each time step
+static bool adaptive_transfer = false;
+
+//! The CPU cycles before the end of the time step to stop and transfer
+static uint32_t transfer_offset = 0;
+
+//! \brief The earliest the transfer is stopped for, used after the transfer
+//!     ran into the next time step
+static uint32_t max_transfer_offset = 0;
+
+//! \brief The latest the transfer is stopped for, so that there is still a
+//!     little time left if the transfer is slower than measured
+static uint32_t min_transfer_offset = 0;
+#endif
+
+//! \brief The CPU cycles before the end of the time step at which the
+//!     transfer was stopped for last time step, for recording
+static uint32_t last_transfer_offset = 0;
+
+//! A word holding two adjacent ring buffer entries
+typedef uint32_t __attribute__((__may_alias__)) packed_inputs_t;
+
+//! \brief The inputs read from another synapse core or from the delay wheel,
+//!     to be added to this one's
+static packed_inputs_t *reduce_buffer;
+
+#if SYNAPSE_SPARSE_TRANSFER
+//! The inputs that are not zero, listed to be sent to the neuron core
+static struct sparse_input *sparse_inputs;
+
+//! The header of the inputs sent, which follows them in SDRAM
+static uint32_t sparse_header;
+#endif
+
 //! The number of successful rewiring attempts
 static uint32_t n_successful_rewires = 0;
 
@@ -114,6 +410,16 @@ static uint32_t earliest_spike_received_time = 0;
 //! The maximum number of spikes left at the end of a time step
 static uint32_t max_spikes_overflow = 0;
 
+//! The number of packets received in each eighth of the time step
+static uint32_t arrival_histogram[N_ARRIVAL_BINS];
+
+//! \brief The fraction of the time step per clock tick, scaled so that
+//!     the top 32 bits of a 64-bit product give the arrival bin
+static uint32_t arrival_bin_scale = 0;
+
+//! The timer load value that ::arrival_bin_scale was computed from
+static uint32_t arrival_bin_load = 0;
+
 //! The number of packets received this time step for recording
 static struct {
     uint32_t time;
@@ -123,6 +429,24 @@ static struct {
 //! the region to record the packets per time step in
 static uint32_t p_per_ts_region;
 
+//! The timer cycles spent in each phase of the time step, for recording
+static uint32_t phase_cycles[PROFILER_N_PHASES];
+
+//! A record of the cycles spent in a phase during a time step
+static struct {
+    uint32_t time;
+    uint32_t cycles;
+} phase_record;
+
+//! Whether the cycles spent in the phases of the time step are measured
+static bool phase_timing = false;
+
+//! The recording flags of the regions, so only those recorded are written
+static uint32_t phase_recording_flags = 0;
+
+//! Whether the point of the transfer in each time step is recorded
+static bool offset_recording = false;
+
 //! Where synaptic input is to be written
 static struct sdram_config sdram_inputs;
 
@@ -130,7 +454,7 @@ static struct sdram_config sdram_inputs;
 static struct key_config key_config;
 
 //! The ring buffers to use
-static weight_t *ring_buffers;
+static ring_buffer_t *ring_buffers;
 
 //! \brief Determine if this is the end of the time step
 //! \return True if end of time step
@@ -143,6 +467,80 @@ static inline void clear_end_of_time_step(void) {
     tc[T2_INT_CLR] = 1;
 }
 
+//! \brief Note the start of a phase of the time step
+//! \param[in] tag The profiler tag of the phase
+//! \return The timer count at the start, to pass to phase_end()
+static inline uint32_t phase_start(uint32_t tag) {
+    profiler_write_entry(PROFILER_ENTER | tag);
+    return phase_timing ? tc[T1_COUNT] : 0;
+}
+
+//! \brief Add the cycles spent since the start of a phase to the phase
+//! \param[in] tag The profiler tag of the phase
+//! \param[in] start The value returned by phase_start()
+static inline void phase_end(uint32_t tag, uint32_t start) {
+    profiler_write_entry(PROFILER_EXIT | tag);
+    if (phase_timing) {
+        // The timer counts down, reloading at the end of the time step
+        uint32_t now = tc[T1_COUNT];
+        if (now > start) {
+            start += tc[T1_LOAD];
+        }
+        phase_cycles[tag - PROFILER_FIRST_PHASE] += start - now;
+    }
+}
+
+//! \brief Record the time a packet was received within the time step
+static inline void check_times(void) {
+    uint32_t tc_time = tc[T1_COUNT];
+    if (tc_time > earliest_spike_received_time) {
+        earliest_spike_received_time = tc_time;
+    }
+    if (tc_time < latest_spike_received_time) {
+        latest_spike_received_time = tc_time;
+    }
+
+    // The clock counts down from the load value, so the time elapsed is the
+    // difference; the scale avoids a division for each packet
+    uint32_t elapsed = tc[T1_LOAD] - tc_time;
+    uint32_t bin = (uint32_t) (((uint64_t) elapsed * arrival_bin_scale) >> 32);
+    if (bin >= N_ARRIVAL_BINS) {
+        bin = N_ARRIVAL_BINS - 1;
+    }
+    arrival_histogram[bin]++;
+}
+
+//! \brief Add a received packet to the input buffer
+//! \param[in] key: The key of the packet. The spike.
+//! \param[in] count: The number of times to add the spike
+static inline void receive_packet(uint32_t key, uint32_t count) {
+    p_per_ts_struct.packets_this_time_step++;
+
+    // cycle through the packet insertion
+    for (; count > 0; count--) {
+        in_spikes_add_spike(key);
+    }
+    check_times();
+}
+
+//! \brief Move any packets waiting in the communications controller into the
+//!     input buffer, when packets are received by polling; the payload of a
+//!     packet that has one is the number of times to add the spike
+static inline void poll_received_packets(void) {
+#if SYNAPSE_POLLED_RECEIVE
+    uint32_t status;
+    while ((status = cc[CC_RSR]) & RX_FULL_MASK) {
+        uint32_t count = 1;
+        if (status & PKT_PL) {
+            count = cc[CC_RXDATA];
+        }
+
+        // Reading the key frees the controller for the next packet
+        receive_packet(cc[CC_RXKEY], count);
+    }
+#endif
+}
+
 //! \brief Wait for a DMA to complete or the end of a time step, whichever
 //!        happens first.
 //! \return True if the DMA is completed first, False if the time step ended first
@@ -152,6 +550,7 @@ static inline bool wait_for_dma_to_complete_or_end(void) {
     // needed in normal code
     uint32_t n_loops = 0;
     while (!is_end_of_time_step() && !dma_done() && n_loops < 10000) {
+        poll_received_packets();
         n_loops++;
     }
     if (!is_end_of_time_step() && !dma_done()) {
@@ -161,7 +560,7 @@ static inline bool wait_for_dma_to_complete_or_end(void) {
 #else
     // This is the normal loop, done without checking
     while (!dma_done()) {
-        continue;
+        poll_received_packets();
     }
 #endif
     dma[DMA_CTRL] = 0x8;
@@ -169,19 +568,169 @@ static inline bool wait_for_dma_to_complete_or_end(void) {
     return !is_end_of_time_step();
 }
 
-//! \brief Transfer the front of the ring buffers to SDRAM to be read by the
-//!        neuron core at the next time step.
+//! \brief Read the inputs of another synapse core and add them to some of
+//!     this core's
+//! \param[in] partner The address of the inputs of the other core
+//! \param[in,out] inputs The inputs of this core to add to
+static inline void reduce_from(uint32_t *partner, packed_inputs_t *inputs) {
+    do_fast_dma_read(partner, reduce_buffer, sdram_inputs.size_in_bytes);
+    wait_for_dma_to_complete();
+    for (uint32_t i = 0; i < (sdram_inputs.size_in_bytes >> 2); i++) {
+        inputs[i] = synapse_row_packed_add_saturate(
+                inputs[i], reduce_buffer[i], NULL);
+    }
+}
+
+#if SYNAPSE_SPARSE_TRANSFER
+//! \brief Read the inputs that another synapse core sent and add them to
+//!     some of this core's, in whichever format they were sent
+//! \param[in] partner The address of the inputs of the other core
+//! \param[in,out] inputs The inputs of this core to add to
+static inline void reduce_from_sparse(
+        uint32_t *partner, packed_inputs_t *inputs) {
+    uint32_t size = sdram_inputs.size_in_bytes;
+    do_fast_dma_read(&partner[size >> 2], reduce_buffer,
+            SPARSE_TRANSFER_HEADER_BYTES);
+    wait_for_dma_to_complete();
+    uint32_t n_sparse = reduce_buffer[0];
+    if (n_sparse == SPARSE_TRANSFER_DENSE) {
+        reduce_from(partner, inputs);
+        return;
+    }
+    if (n_sparse == 0) {
+        return;
+    }
+    struct sparse_input *sparse = (struct sparse_input *) reduce_buffer;
+    do_fast_dma_read(partner, sparse, n_sparse * sizeof(struct sparse_input));
+    wait_for_dma_to_complete();
+    for (uint32_t i = 0; i < n_sparse; i++) {
+        uint32_t index = sparse[i].index;
+        inputs[index] = synapse_row_packed_add_saturate(
+                inputs[index], sparse[i].inputs, NULL);
+    }
+}
+#endif
+
+//! \brief Write the front of the ring buffers to SDRAM
 //! \param[in] time The current time step being executed.
-static inline void transfer_buffers(uint32_t time) {
+//! \param[in] sparse Whether the inputs can be sent as a list of those that
+//!     are not zero, if that is enabled; they are always listed, so that the
+//!     time to do so is included when the transfer is measured
+static inline void write_buffers(uint32_t time, bool sparse) {
     uint32_t first_ring_buffer = synapse_row_get_first_ring_buffer_index(
             time + 1, synapse_type_index_bits, synapse_delay_mask);
+#if SYNAPSE_SPARSE_TRANSFER
+    uint32_t n_words = sdram_inputs.size_in_bytes >> 2;
+    sparse_header = sparse_transfer_pack(
+            (uint32_t *) &ring_buffers[first_ring_buffer], n_words,
+            sparse_inputs);
+    if (!sparse) {
+        sparse_header = SPARSE_TRANSFER_DENSE;
+    }
+    if (sparse_header != SPARSE_TRANSFER_DENSE) {
+        log_debug("Writing %u sparse inputs to 0x%08x", sparse_header,
+                sdram_inputs.address);
+        if (sparse_header > 0) {
+            do_fast_dma_write(sparse_inputs, sdram_inputs.address,
+                    sparse_header * sizeof(struct sparse_input));
+            wait_for_dma_to_complete();
+        }
+        do_fast_dma_write(&sparse_header, &sdram_inputs.address[n_words],
+                SPARSE_TRANSFER_HEADER_BYTES);
+        return;
+    }
+#else
+    use(sparse);
+#endif
     log_debug("Writing %d bytes to 0x%08x from ring buffer %d at 0x%08x",
              sdram_inputs.size_in_bytes, sdram_inputs.address, first_ring_buffer,
              &ring_buffers[first_ring_buffer]);
     do_fast_dma_write(&ring_buffers[first_ring_buffer], sdram_inputs.address,
             sdram_inputs.size_in_bytes);
+#if SYNAPSE_SPARSE_TRANSFER
+    wait_for_dma_to_complete();
+    do_fast_dma_write(&sparse_header, &sdram_inputs.address[n_words],
+            SPARSE_TRANSFER_HEADER_BYTES);
+#endif
 }
 
+//! \brief Add the inputs of a time step from the synapses with delays too
+//!     long for the ring buffers into the ring buffers, and clear them
+//! \param[in] time: The time step to add the inputs of
+static inline void add_delay_wheel(uint32_t time) {
+    weight_t *slot = synapses_delay_wheel_slot(time);
+    if (slot == NULL) {
+        return;
+    }
+    uint32_t first_ring_buffer = synapse_row_get_first_ring_buffer_index(
+            time, synapse_type_index_bits, synapse_delay_mask);
+    reduce_from((uint32_t *) slot,
+            (packed_inputs_t *) &ring_buffers[first_ring_buffer]);
+    for (uint32_t i = 0; i < (sdram_inputs.size_in_bytes >> 2); i++) {
+        reduce_buffer[i] = 0;
+    }
+    do_fast_dma_write(reduce_buffer, slot, sdram_inputs.size_in_bytes);
+    wait_for_dma_to_complete();
+}
+
+//! \brief Transfer the front of the ring buffers to SDRAM to be read by the
+//!        neuron core at the next time step.  If the inputs of other synapse
+//!        cores are added here first, they are added in the order that they
+//!        are ready in; the times that each core stops at make sure that each
+//!        has written its inputs by the time they are read.
+//! \param[in] time The current time step being executed.
+static inline void transfer_buffers(uint32_t time) {
+    uint32_t first_ring_buffer = synapse_row_get_first_ring_buffer_index(
+            time + 1, synapse_type_index_bits, synapse_delay_mask);
+    add_delay_wheel(time + 1);
+    for (uint32_t i = 0; i < sdram_inputs.n_reduce_partners; i++) {
+#if SYNAPSE_SPARSE_TRANSFER
+        reduce_from_sparse(sdram_inputs.reduce_partners[i],
+                (packed_inputs_t *) &ring_buffers[first_ring_buffer]);
+#else
+        reduce_from(sdram_inputs.reduce_partners[i],
+                (packed_inputs_t *) &ring_buffers[first_ring_buffer]);
+#endif
+    }
+    synapses_note_ring_buffer_peaks(first_ring_buffer);
+    write_buffers(time, true);
+}
+
+#if SYNAPSE_ADAPTIVE_TRANSFER
+//! \brief Move the point of the transfer for the next time step; called
+//!     just after the transfer, before the end of the time step
+//! \param[in] backlog Whether there were spikes left waiting when the
+//!     transfer started
+static inline void adapt_transfer_offset(bool backlog) {
+    if (!adaptive_transfer) {
+        return;
+    }
+
+    // If the transfer ran into the next time step, it is safest to go back
+    // to the earliest point straight away
+    if (tc[T1_MASK_INT]) {
+        transfer_offset = max_transfer_offset;
+        return;
+    }
+
+    // If spikes were left waiting, stop later by half of the time that was
+    // left over, as long as there is still some left; otherwise go a quarter
+    // of the way back to the measured time, as there is no need to take the
+    // risk
+    if (backlog) {
+        uint32_t spare = tc[T1_COUNT] >> 1;
+        if (transfer_offset - min_transfer_offset > spare) {
+            transfer_offset -= spare;
+        } else {
+            transfer_offset = min_transfer_offset;
+        }
+    } else {
+        int32_t diff = (int32_t) (clocks_to_transfer - transfer_offset);
+        transfer_offset += diff / 4;
+    }
+}
+#endif
+
 //! \brief Do processing related to the end of the time step
 //! \param[in] time The time step that is ending.
 static inline void process_end_of_time_step(uint32_t time) {
@@ -189,10 +738,20 @@ static inline void process_end_of_time_step(uint32_t time) {
     uint32_t cspr = spin1_int_disable();
 
     cancel_dmas();
+#if SYNAPSE_ADAPTIVE_TRANSFER
+    bool backlog = in_spikes_size() > 0;
+#endif
 
     // Start transferring buffer data for next time step
+    uint32_t start = phase_start(PROFILER_TRANSFER);
     transfer_buffers(time);
     wait_for_dma_to_complete();
+#if FUSED_RING_BUFFER_CLEAR
+    // Nothing more is added until the next time step, so clear the entries
+    // just transferred now rather than at the start of the next time step
+    synapses_flush_ring_buffers(time + 1);
+#endif
+    phase_end(PROFILER_TRANSFER, start);
 
     // uint32_t end = tc[T1_COUNT];
     if (tc[T1_MASK_INT]) {
@@ -202,27 +761,60 @@ static inline void process_end_of_time_step(uint32_t time) {
             max_transfer_timer_overrun = diff;
         }
     }
+#if SYNAPSE_ADAPTIVE_TRANSFER
+    adapt_transfer_offset(backlog);
+#endif
 
     spin1_mode_restore(cspr);
 }
 
-//! \brief Read a synaptic row from SDRAM into a local buffer.
-static inline void read_synaptic_row(spike_t spike, pop_table_lookup_result_t *result) {
+//! \brief Start gathering rows to be read into the next buffer to fill.
+//! \param[in] spike The spike that the first row is for
+//! \param[in] result The details of the first row
+//! \param[in] n_repeats The number of times to apply the first row
+static inline void begin_row_batch(spike_t spike, uint32_t n_repeats,
+        pop_table_lookup_result_t *result) {
     dma_buffer *buffer = &dma_buffers[next_buffer_to_fill];
     buffer->sdram_writeback_address = result->row_address;
-    buffer->originating_spike = spike;
+    buffer->originating_spikes[0] = spike;
     buffer->n_bytes_transferred = result->n_bytes_to_transfer;
-    buffer->colour = result->colour;
+    buffer->n_rows = 1;
+    buffer->colours[0] = result->colour;
+    buffer->n_repeats[0] = n_repeats;
+    buffer->n_spikes = n_repeats;
     buffer->colour_mask = result->colour_mask;
-    do_fast_dma_read(result->row_address, buffer->row, result->n_bytes_to_transfer);
+    buffer->cached = false;
+#if SYNAPTIC_ROW_CACHE_SIZE > 0
+    // A row in the cache doesn't need to be read; keep it until it is used
+    row_cache_entry *entry = row_cache_find(result->row_address);
+    if (entry != NULL) {
+        entry->pins++;
+        buffer->cached = true;
+    }
+#endif
+}
+
+//! \brief Read the gathered synaptic rows from SDRAM into a local buffer,
+//!     unless the row is in the row cache.
+static inline void read_synaptic_rows(void) {
+    dma_buffer *buffer = &dma_buffers[next_buffer_to_fill];
+    if (!buffer->cached) {
+        do_fast_dma_read(buffer->sdram_writeback_address, buffer->row,
+                buffer->n_rows * buffer->n_bytes_transferred);
+        dma_outstanding = true;
+    }
     next_buffer_to_fill = (next_buffer_to_fill + 1) & DMA_BUFFER_MOD_MASK;
 }
 
 //! \brief Get the next spike, keeping track of provenance data
+//! \details Copies of the spike directly after it in the input buffer (such as
+//!     those from a packet with a count payload) are taken with it, and the
+//!     number of copies is left in ::spike_n_repeats.
 //! \param[in] time Simulation time step
 //! \param[out] spike Pointer to receive the next spike
 //! \return True if a spike was retrieved
 static inline bool get_next_spike(uint32_t time, spike_t *spike) {
+    poll_received_packets();
     uint32_t n_spikes = in_spikes_size();
     if (biggest_fill_size_of_input_buffer < n_spikes) {
         biggest_fill_size_of_input_buffer = n_spikes;
@@ -230,73 +822,161 @@ static inline bool get_next_spike(uint32_t time, spike_t *spike) {
     if (!in_spikes_get_next_spike(spike)) {
         return false;
     }
+    spike_n_repeats = 1;
+    while (in_spikes_is_next_spike_equal(*spike)) {
+        spike_n_repeats++;
+    }
     // Detect a looped back spike
     if ((*spike & key_config.mask) == key_config.key) {
         // Process event if not self-connected (if it is, this happens later)
     	if (!key_config.self_connected) {
-            synapse_dynamics_process_post_synaptic_event(
-                    time, (*spike & key_config.spike_id_mask) >> key_config.colour_shift);
+    	    for (uint32_t i = spike_n_repeats; i > 0; i--) {
+                synapse_dynamics_process_post_synaptic_event(time,
+                        (*spike & key_config.spike_id_mask)
+                        >> key_config.colour_shift);
+    	    }
     	}
         return key_config.self_connected;
     }
     return true;
 }
 
-//! \brief Start the first DMA after awaking from spike reception.  Loops over
-//!        available spikes until one causes a DMA.
+//! \brief Get the details for the next DMA, but don't start it.
 //! \param[in] time Simulation time step
-//! \param[in/out] spike Starts as the first spike received, but might change
-//!                      if the first spike doesn't cause a DMA
-//! \param[out] result The result of the lookup
-//! \return True if a DMA was started
-static inline bool start_first_dma(uint32_t time, spike_t *spike,
+//! \param[out] spike Pointer to receive the spike the DMA relates to
+//! \param[out] result The details of the transfer to do
+//! \return True if there is a DMA to do
+static inline bool get_next_dma(uint32_t time, spike_t *spike,
 		pop_table_lookup_result_t *result) {
+    if (population_table_is_next()) {
+        uint32_t start = phase_start(PROFILER_POP_TABLE_LOOKUP);
+        bool found = population_table_get_next_address(spike, result);
+        phase_end(PROFILER_POP_TABLE_LOOKUP, start);
+        if (found) {
+            return true;
+        }
+    }
 
-    do {
-        if (population_table_get_first_address(*spike, result)) {
-            read_synaptic_row(*spike, result);
+    while (!is_end_of_time_step() && get_next_spike(time, spike)) {
+        uint32_t start = phase_start(PROFILER_POP_TABLE_LOOKUP);
+        bool found = population_table_get_first_address(*spike, result);
+        phase_end(PROFILER_POP_TABLE_LOOKUP, start);
+        if (found) {
             return true;
         }
-    } while (!is_end_of_time_step() && get_next_spike(time, spike));
+    }
 
     return false;
 }
 
-//! \brief Get the details for the next DMA, but don't start it.
+//! \brief Look up the row of the next spike, if there isn't one already, so
+//!        that the population table lookup overlaps with the DMA in progress
 //! \param[in] time Simulation time step
-//! \param[out] spike Pointer to receive the spike the DMA relates to
-//! \param[out] result The details of the transfer to do
-//! \return True if there is a DMA to do
-static inline bool get_next_dma(uint32_t time, spike_t *spike,
-		pop_table_lookup_result_t *result) {
-    if (population_table_is_next() && population_table_get_next_address(spike, result)) {
-        return true;
+static inline void fill_lookahead(uint32_t time) {
+    if (!lookahead_valid && get_next_dma(
+            time, &lookahead.spike, &lookahead.result)) {
+        lookahead.n_repeats = spike_n_repeats;
+        lookahead_valid = true;
     }
+}
 
-    while (!is_end_of_time_step() && get_next_spike(time, spike)) {
-        if (population_table_get_first_address(*spike, result)) {
-            return true;
+//! \brief Take the row looked up ahead, if there is one
+//! \param[out] spike Pointer to receive the spike the row relates to
+//! \param[out] n_repeats Pointer to receive the number of times to apply it
+//! \param[out] result Pointer to receive the details of the transfer to do
+//! \return True if there was a row looked up
+static inline bool lookahead_next(spike_t *spike, uint32_t *n_repeats,
+        pop_table_lookup_result_t *result) {
+    if (!lookahead_valid) {
+        return false;
+    }
+    *spike = lookahead.spike;
+    *n_repeats = lookahead.n_repeats;
+    *result = lookahead.result;
+    lookahead_valid = false;
+    return true;
+}
+
+//! \brief Add the rows of upcoming spikes to the rows being gathered in the
+//!        next buffer to fill, as long as they follow on directly in SDRAM
+//!        and are the same size, and there is space in the buffer.
+//! \param[in] time Simulation time step
+static inline void extend_row_batch(uint32_t time) {
+    dma_buffer *buffer = &dma_buffers[next_buffer_to_fill];
+    if (buffer->cached) {
+        return;
+    }
+    uint32_t n_bytes = buffer->n_bytes_transferred;
+    while ((buffer->n_rows < MAX_ROWS_PER_DMA) &&
+            (((buffer->n_rows + 1) * n_bytes) <= dma_buffer_n_bytes)) {
+        fill_lookahead(time);
+        if (!lookahead_valid) {
+            return;
+        }
+        lookahead_entry *next = &lookahead;
+        uint32_t next_address = (uint32_t) buffer->sdram_writeback_address
+                + (buffer->n_rows * n_bytes);
+        if (((uint32_t) next->result.row_address != next_address) ||
+                (next->result.n_bytes_to_transfer != n_bytes) ||
+                (next->result.colour_mask != buffer->colour_mask)) {
+            return;
         }
+        buffer->originating_spikes[buffer->n_rows] = next->spike;
+        buffer->colours[buffer->n_rows] = next->result.colour;
+        buffer->n_repeats[buffer->n_rows] = next->n_repeats;
+        buffer->n_spikes += next->n_repeats;
+        buffer->n_rows++;
+        n_rows_coalesced++;
+        lookahead_valid = false;
     }
+}
+
+//! \brief Start the first DMA after awaking from spike reception.  Loops over
+//!        available spikes until one causes a DMA.
+//! \param[in] time Simulation time step
+//! \param[in/out] spike Starts as the first spike received, but might change
+//!                      if the first spike doesn't cause a DMA
+//! \param[out] result The result of the lookup
+//! \return True if a DMA was started
+static inline bool start_first_dma(uint32_t time, spike_t *spike,
+		pop_table_lookup_result_t *result) {
+
+    do {
+        uint32_t start = phase_start(PROFILER_POP_TABLE_LOOKUP);
+        bool found = population_table_get_first_address(*spike, result);
+        phase_end(PROFILER_POP_TABLE_LOOKUP, start);
+        if (found) {
+            begin_row_batch(*spike, spike_n_repeats, result);
+            extend_row_batch(time);
+            read_synaptic_rows();
+            return true;
+        }
+    } while (!is_end_of_time_step() && get_next_spike(time, spike));
 
     return false;
 }
 
 //! \brief Handle a synapse processing error.
 //! \param[in] buffer The DMA buffer that was being processed
-static inline void handle_row_error(dma_buffer *buffer) {
+//! \param[in] row_index The index of the row in the buffer that failed
+//! \param[in] local_row The row that failed
+static inline void handle_row_error(dma_buffer *buffer, uint32_t row_index,
+        synaptic_row_t local_row) {
     log_error(
         "Error processing spike 0x%.8x for address 0x%.8x (local=0x%.8x)",
-        buffer->originating_spike, buffer->sdram_writeback_address, buffer->row);
+        buffer->originating_spikes[row_index],
+        (uint32_t) buffer->sdram_writeback_address
+                + (row_index * buffer->n_bytes_transferred),
+        local_row);
 
     // Print out the row for debugging
-    address_t row = (address_t) buffer->row;
+    address_t row = (address_t) local_row;
     for (uint32_t i = 0; i < (buffer->n_bytes_transferred >> 2); i++) {
         log_error("    %u: 0x%08x", i, row[i]);
     }
 
     // Print out parsed data for static synapses
-    synapse_row_fixed_part_t *fixed_region = synapse_row_fixed_region(buffer->row);
+    synapse_row_fixed_part_t *fixed_region = synapse_row_fixed_region(local_row);
     uint32_t *synaptic_words = synapse_row_fixed_weight_controls(fixed_region);
     uint32_t fixed_synapse = synapse_row_num_fixed_synapses(fixed_region);
     if (fixed_synapse > (buffer->n_bytes_transferred >> 2)) {
@@ -318,37 +998,319 @@ static inline void handle_row_error(dma_buffer *buffer) {
     rt_error(RTE_SWERR);
 }
 
-//! \brief Process a row that has been transferred
+//! \brief Write the changed part of the plastic region of a row back to SDRAM
+//! \param[in] row The local copy of the row
+//! \param[in] sdram_row The address of the row in SDRAM
+//! \param[in] n_words The words at the start of the plastic region to write
+//! \param[in] dma_in_progress Whether there was a DMA started and not checked
+static inline void write_back_plastic_region(synaptic_row_t row,
+        synaptic_row_t sdram_row, uint32_t n_words, bool dma_in_progress) {
+    uint32_t start = phase_start(PROFILER_WRITE_BACK);
+    uint32_t n_bytes = n_words * sizeof(uint32_t);
+    n_write_back_words_saved += synapse_row_plastic_size(row) - n_words;
+    void *system_address = synapse_row_plastic_region(sdram_row);
+    void *tcm_address = synapse_row_plastic_region(row);
+    synapses_mark_row_dirty(sdram_row);
+    // Make sure an outstanding DMA is completed before starting this one
+    if (dma_in_progress) {
+        wait_for_dma_to_complete();
+    }
+    do_fast_dma_write(tcm_address, system_address, n_bytes);
+    // Only wait for this DMA to complete if there isn't another running,
+    // as otherwise the next wait will fail!
+    if (!dma_in_progress) {
+        wait_for_dma_to_complete();
+    }
+    phase_end(PROFILER_WRITE_BACK, start);
+}
+
+#if SYNAPSE_WRITE_BACK_QUEUE_SIZE > 0
+//! \brief Start the oldest queued write back; the DMA engine must be free
+static inline void write_back_queue_start_next(void) {
+    queued_write_back *next = &write_back_queue[write_back_queue_start];
+    do_fast_dma_write(next->tcm_address, next->system_address, next->n_bytes);
+    write_back_queue_start =
+            (write_back_queue_start + 1) % SYNAPSE_WRITE_BACK_QUEUE_SIZE;
+    write_back_queue_count--;
+}
+
+//! \brief Start the oldest queued write back if the DMA that is running has
+//!     finished; there is still a DMA running afterwards
+static inline void write_back_queue_poll(void) {
+    if (write_back_queue_count > 0 && dma_done()) {
+        dma[DMA_CTRL] = 0x8;
+        write_back_queue_start_next();
+    }
+}
+
+//! \brief Start all the queued write backs in turn; the last is left running
+static inline void write_back_queue_drain(void) {
+    while (write_back_queue_count > 0) {
+        wait_for_dma_to_complete();
+        write_back_queue_start_next();
+    }
+}
+
+//! \brief Queue the write back of the changed part of the plastic region of a
+//!     row, to be done when the DMA that is running has finished, so that the
+//!     rows after it can be processed in the meantime
+//! \param[in] row The local copy of the row, which must not change until the
+//!     queue is drained
+//! \param[in] sdram_row The address of the row in SDRAM
+//! \param[in] n_words The words at the start of the plastic region to write
+static inline void write_back_queue_add(synaptic_row_t row,
+        synaptic_row_t sdram_row, uint32_t n_words) {
+    n_write_back_words_saved += synapse_row_plastic_size(row) - n_words;
+    synapses_mark_row_dirty(sdram_row);
+    if (write_back_queue_count == SYNAPSE_WRITE_BACK_QUEUE_SIZE) {
+        uint32_t start = phase_start(PROFILER_WRITE_BACK);
+        wait_for_dma_to_complete();
+        write_back_queue_start_next();
+        phase_end(PROFILER_WRITE_BACK, start);
+    }
+    uint32_t end = (write_back_queue_start + write_back_queue_count)
+            % SYNAPSE_WRITE_BACK_QUEUE_SIZE;
+    write_back_queue[end].tcm_address = synapse_row_plastic_region(row);
+    write_back_queue[end].system_address =
+            synapse_row_plastic_region(sdram_row);
+    write_back_queue[end].n_bytes = n_words * sizeof(uint32_t);
+    write_back_queue_count++;
+    n_write_backs_queued++;
+}
+#endif
+
+#if SYNAPTIC_ROW_CACHE_SIZE > 0
+//! \brief Put a row in the row cache, evicting the least recently used row
+//!     if the cache is full, and writing it back if it has changed
+//! \param[in] row The local copy of the row
+//! \param[in] sdram_row The address of the row in SDRAM
+//! \param[in] n_bytes The size of the row
+//! \param[in] dma_in_progress Whether there was a DMA started and not checked
+//! \return The entry that the row is now in, or NULL if all the entries are
+//!     pinned
+static inline row_cache_entry *row_cache_add(synaptic_row_t row,
+        synaptic_row_t sdram_row, uint32_t n_bytes, bool dma_in_progress) {
+    row_cache_entry *entry = NULL;
+    for (uint32_t i = 0; i < SYNAPTIC_ROW_CACHE_SIZE; i++) {
+        if (row_cache[i].sdram_address == NULL) {
+            entry = &row_cache[i];
+            break;
+        }
+        if (row_cache[i].pins == 0 && (entry == NULL ||
+                row_cache[i].last_used < entry->last_used)) {
+            entry = &row_cache[i];
+        }
+    }
+    if (entry == NULL) {
+        return NULL;
+    }
+    if (entry->sdram_address != NULL && entry->dirty_words > 0) {
+        write_back_plastic_region(entry->row, entry->sdram_address,
+                entry->dirty_words, dma_in_progress);
+    }
+    spin1_memcpy(entry->row, row, n_bytes);
+    entry->sdram_address = sdram_row;
+    entry->dirty_words = 0;
+    entry->pins = 0;
+    return entry;
+}
+#endif
+
+//! \brief Write back all the rows in the row cache, so that SDRAM is up to
+//!     date before it is read by anything else
+static inline void row_cache_flush(void) {
+#if SYNAPTIC_ROW_CACHE_SIZE > 0
+    for (uint32_t i = 0; i < SYNAPTIC_ROW_CACHE_SIZE; i++) {
+        if (row_cache[i].sdram_address != NULL &&
+                row_cache[i].dirty_words > 0) {
+            write_back_plastic_region(row_cache[i].row,
+                    row_cache[i].sdram_address, row_cache[i].dirty_words,
+                    false);
+        }
+        row_cache[i].sdram_address = NULL;
+        row_cache[i].dirty_words = 0;
+        row_cache[i].pins = 0;
+    }
+#endif
+}
+
+#if SYNAPSE_DEFERRED_HISTORY_SIZE > 0
+//! \brief Put the plastic header kept for a row into a copy of the row just
+//!     read, as it is newer than the one in SDRAM, and free its entry as the
+//!     copy now holds it
+//! \param[in] row The local copy of the row
+//! \param[in] sdram_row The address of the row in SDRAM
+static inline void deferred_history_restore(synaptic_row_t row,
+        synaptic_row_t sdram_row) {
+    for (uint32_t i = 0; i < SYNAPSE_DEFERRED_HISTORY_SIZE; i++) {
+        if (deferred_histories[i].sdram_address == sdram_row) {
+            spin1_memcpy(synapse_row_plastic_region(row),
+                    deferred_histories[i].words,
+                    deferred_history_words * sizeof(uint32_t));
+            deferred_histories[i].sdram_address = NULL;
+            return;
+        }
+    }
+}
+
+//! \brief Keep the plastic header of a row instead of writing it back, if
+//!     nothing after it has changed and there is a free entry
+//! \param[in] row The local copy of the row
+//! \param[in] sdram_row The address of the row in SDRAM
+//! \param[in] n_words The words at the start of the plastic region that have
+//!     changed
+//! \return Whether the header was kept, so the row needs no write back
+static inline bool deferred_history_add(synaptic_row_t row,
+        synaptic_row_t sdram_row, uint32_t n_words) {
+    if (deferred_history_words == 0 || n_words > deferred_history_words) {
+        return false;
+    }
+    for (uint32_t i = 0; i < SYNAPSE_DEFERRED_HISTORY_SIZE; i++) {
+        if (deferred_histories[i].sdram_address == NULL) {
+            spin1_memcpy(deferred_histories[i].words,
+                    synapse_row_plastic_region(row),
+                    deferred_history_words * sizeof(uint32_t));
+            deferred_histories[i].sdram_address = sdram_row;
+            n_history_write_backs_deferred++;
+            return true;
+        }
+    }
+    // When all the entries are in use, the row is written back as usual
+    return false;
+}
+#endif
+
+//! \brief Write back all the plastic headers kept in DTCM, so that SDRAM is
+//!     up to date before it is read by anything else
+static inline void deferred_history_flush(void) {
+#if SYNAPSE_DEFERRED_HISTORY_SIZE > 0
+    for (uint32_t i = 0; i < SYNAPSE_DEFERRED_HISTORY_SIZE; i++) {
+        synaptic_row_t sdram_row = deferred_histories[i].sdram_address;
+        if (sdram_row != NULL) {
+            uint32_t start = phase_start(PROFILER_WRITE_BACK);
+            synapses_mark_row_dirty(sdram_row);
+            do_fast_dma_write(deferred_histories[i].words,
+                    synapse_row_plastic_region(sdram_row),
+                    deferred_history_words * sizeof(uint32_t));
+            wait_for_dma_to_complete();
+            phase_end(PROFILER_WRITE_BACK, start);
+            deferred_histories[i].sdram_address = NULL;
+        }
+    }
+#endif
+}
+
+//! \brief Process the rows that have been transferred
 //! \param[in] time The current time step of the simulation
 //! \param[in] dma_in_progress Whether there was a DMA started and not checked
 static inline void process_current_row(uint32_t time, bool dma_in_progress) {
-    bool write_back = false;
     dma_buffer *buffer = &dma_buffers[next_buffer_to_process];
-
-    if (!synapses_process_synaptic_row(time, buffer->colour, buffer->colour_mask,
-    		buffer->row, &write_back)) {
-        handle_row_error(buffer);
-    }
-    synaptogenesis_spike_received(time, buffer->originating_spike);
-    spike_processing_count++;
-    if (write_back) {
-        uint32_t n_bytes = synapse_row_plastic_size(buffer->row) * sizeof(uint32_t);
-        void *system_address = synapse_row_plastic_region(
-                buffer->sdram_writeback_address);
-        void *tcm_address = synapse_row_plastic_region(buffer->row);
-        // Make sure an outstanding DMA is completed before starting this one
-        if (dma_in_progress) {
-            wait_for_dma_to_complete();
+    uint32_t row_offset = 0;
+
+    for (uint32_t i = 0; i < buffer->n_rows; i++) {
+        bool write_back = false;
+        uint32_t n_write_back_words = 0;
+        synaptic_row_t row = (synaptic_row_t) ((uint8_t *) buffer->row + row_offset);
+        synaptic_row_t sdram_row = (synaptic_row_t)
+                ((uint32_t) buffer->sdram_writeback_address + row_offset);
+#if SYNAPTIC_ROW_CACHE_SIZE > 0
+        // A cached copy is at least as new as anything that has been read
+        row_cache_entry *cached = row_cache_find(sdram_row);
+        if (cached != NULL) {
+            row = cached->row;
+            if (buffer->cached) {
+                cached->pins--;
+            }
+            n_row_cache_hits++;
+        } else {
+            n_row_cache_misses++;
         }
-        do_fast_dma_write(tcm_address, system_address, n_bytes);
-        // Only wait for this DMA to complete if there isn't another running,
-        // as otherwise the next wait will fail!
-        if (!dma_in_progress) {
-            wait_for_dma_to_complete();
+#endif
+#if SYNAPSE_DEFERRED_HISTORY_SIZE > 0
+        // A plastic header kept back is newer than the one read; rows in the
+        // row cache never have one kept back, as their copy is kept instead
+        deferred_history_restore(row, sdram_row);
+#endif
+        uint32_t start = phase_start(PROFILER_PROCESS_ROWS);
+
+        // Apply the row once for each repeat of the spike; any plastic
+        // updates build up in the local copy, which is written back once
+        uint32_t n_repeats = buffer->n_repeats[i];
+        for (uint32_t r = n_repeats; r > 0; r--) {
+            bool write_back_now;
+            if (!synapses_process_synaptic_row(time, buffer->colours[i],
+                    buffer->colour_mask, row, &write_back_now)) {
+                handle_row_error(buffer, i, row);
+            }
+            if (write_back_now) {
+                write_back = true;
+                uint32_t n_words = synapse_dynamics_get_plastic_words_changed();
+                if (n_words > n_write_back_words) {
+                    n_write_back_words = n_words;
+                }
+            }
+            synaptogenesis_spike_received(
+                    time, buffer->originating_spikes[i]);
+        }
+        phase_end(PROFILER_PROCESS_ROWS, start);
+        spike_processing_count += n_repeats;
+        n_repeated_row_applications += n_repeats - 1;
+#if SYNAPTIC_ROW_CACHE_SIZE > 0
+        // Keep plastic rows to defer their write back, and the rows of hot
+        // sources to avoid reading them again
+        if (cached == NULL && (write_back ||
+                row_cache_is_hot(buffer->originating_spikes[i]))) {
+            cached = row_cache_add(row, sdram_row,
+                    buffer->n_bytes_transferred, dma_in_progress);
         }
+        if (cached != NULL) {
+            cached->last_used = row_cache_clock++;
+            if (write_back) {
+                if (cached->dirty_words > 0) {
+                    n_write_backs_deferred++;
+                }
+                if (n_write_back_words > cached->dirty_words) {
+                    cached->dirty_words = n_write_back_words;
+                }
+                write_back = false;
+            }
+        }
+#endif
+#if SYNAPSE_DEFERRED_HISTORY_SIZE > 0
+        // When only the plastic header has changed, as there were no post
+        // events to change the synapses, it can be kept back
+        if (write_back && deferred_history_add(
+                row, sdram_row, n_write_back_words)) {
+            write_back = false;
+        }
+#endif
+#if SYNAPSE_WRITE_BACK_QUEUE_SIZE > 0
+        // While the next rows are being read, a write back can wait for the
+        // read to finish instead of holding up the rows after it
+        if (write_back && dma_in_progress) {
+            write_back_queue_add(row, sdram_row, n_write_back_words);
+            write_back = false;
+        }
+#endif
+        if (write_back) {
+            write_back_plastic_region(
+                    row, sdram_row, n_write_back_words, dma_in_progress);
+        }
+        row_offset += buffer->n_bytes_transferred;
+        spikes_processed_this_time_step += n_repeats;
+        poll_received_packets();
+#if SYNAPSE_WRITE_BACK_QUEUE_SIZE > 0
+        write_back_queue_poll();
+#endif
     }
+#if SYNAPSE_WRITE_BACK_QUEUE_SIZE > 0
+    // The rows of the buffer must be written back before it is read into
+    // again, and before any row is read again
+    uint32_t start = phase_start(PROFILER_WRITE_BACK);
+    write_back_queue_drain();
+    phase_end(PROFILER_WRITE_BACK, start);
+#endif
     next_buffer_to_process = (next_buffer_to_process + 1) & DMA_BUFFER_MOD_MASK;
-    spikes_processed_this_time_step++;
 }
 
 //! \brief Store data for provenance and recordings
@@ -365,6 +1327,27 @@ static inline void store_data(uint32_t time) {
     p_per_ts_struct.time = time;
     recording_record(p_per_ts_region, &p_per_ts_struct, sizeof(p_per_ts_struct));
 
+    // Record the cycles spent in each phase of the last time step
+    if (phase_timing) {
+        phase_record.time = time;
+        for (uint32_t i = 0; i < PROFILER_N_PHASES; i++) {
+            uint32_t region = p_per_ts_region + 1 + i;
+            if (phase_recording_flags & (1 << region)) {
+                phase_record.cycles = phase_cycles[i];
+                recording_record(region, &phase_record, sizeof(phase_record));
+            }
+            phase_cycles[i] = 0;
+        }
+    }
+
+    // Record the point at which the transfer was done last time step
+    if (offset_recording) {
+        phase_record.time = time;
+        phase_record.cycles = last_transfer_offset;
+        recording_record(p_per_ts_region + 1 + PROFILER_N_PHASES,
+                &phase_record, sizeof(phase_record));
+    }
+
     if (p_per_ts_struct.packets_this_time_step > max_spikes_received) {
         max_spikes_received = p_per_ts_struct.packets_this_time_step;
     }
@@ -378,13 +1361,82 @@ static inline void measure_transfer_time(void) {
     // Measure the time to do an upload to know when to schedule the timer
     tc[T2_LOAD] = 0xFFFFFFFF;
     tc[T2_CONTROL] = 0x82;
-    transfer_buffers(0);
+    add_delay_wheel(1);
+    write_buffers(0, false);
     wait_for_dma_to_complete();
-    clocks_to_transfer = (0xFFFFFFFF - tc[T2_COUNT])
-            + sdram_inputs.time_for_transfer_overhead;
+#if FUSED_RING_BUFFER_CLEAR
+    synapses_flush_ring_buffers(1);
+#endif
+    uint32_t dma_cycles = 0xFFFFFFFF - tc[T2_COUNT];
+    clocks_to_transfer = dma_cycles + sdram_inputs.time_for_transfer_overhead;
     tc[T2_CONTROL] = 0;
-    log_info("Transfer of %u bytes to 0x%08x took %u cycles",
-            sdram_inputs.size_in_bytes, sdram_inputs.address, clocks_to_transfer);
+#if SYNAPSE_ADAPTIVE_TRANSFER
+    // Between the measured time with a quarter of the overhead and with
+    // twice the overhead
+    transfer_offset = clocks_to_transfer;
+    min_transfer_offset = dma_cycles +
+            (sdram_inputs.time_for_transfer_overhead >> 2);
+    max_transfer_offset = clocks_to_transfer +
+            sdram_inputs.time_for_transfer_overhead;
+#endif
+
+    // The reads of the inputs of other cores are measured separately, as the
+    // time for each is needed to work out when to stop; adding into the
+    // buffer read into takes as long as adding into the ring buffers
+    if (sdram_inputs.n_reduce_partners > 0) {
+        tc[T2_LOAD] = 0xFFFFFFFF;
+        tc[T2_CONTROL] = 0x82;
+        reduce_from(sdram_inputs.reduce_partners[0], reduce_buffer);
+        clocks_to_reduce = (0xFFFFFFFF - tc[T2_COUNT])
+                + sdram_inputs.time_for_transfer_overhead;
+        tc[T2_CONTROL] = 0;
+    }
+    log_info("Transfer of %u bytes to 0x%08x took %u cycles, reading from "
+            "%u other cores took %u cycles each", sdram_inputs.size_in_bytes,
+            sdram_inputs.address, clocks_to_transfer,
+            sdram_inputs.n_reduce_partners, clocks_to_reduce);
+}
+
+//! \brief Whether a late packet was sent recently enough to keep
+//! \param[in] spike The key of the packet
+//! \return True if the colour of the packet is no older than allowed
+static bool is_late_packet_young(spike_t spike) {
+    uint32_t colour_mask = late_packets.colour_mask;
+    uint32_t age = (late_packet_time - (spike & colour_mask)) & colour_mask;
+    return age <= late_packets.max_age;
+}
+
+//! \brief Whether a late packet is from one of the priority sources
+//! \param[in] spike The key of the packet
+//! \return True if the packet is from a priority source
+static bool is_late_packet_priority(spike_t spike) {
+    for (uint32_t i = 0; i < late_packets.n_priority_sources; i++) {
+        if ((spike & late_packets.priority_sources[i].mask) ==
+                late_packets.priority_sources[i].key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//! \brief Drop the packets left in the input buffer according to the policy
+//! \param[in] time The time step about to start
+static inline void drop_late_packets(uint32_t time) {
+    switch (late_packets.policy) {
+    case LATE_PACKETS_DROP_ALL:
+        n_late_packets_dropped += in_spikes_size();
+        in_spikes_clear();
+        break;
+    case LATE_PACKETS_DROP_AGED:
+        late_packet_time = time;
+        n_late_packets_dropped += in_spikes_filter(is_late_packet_young);
+        break;
+    case LATE_PACKETS_KEEP_PRIORITY:
+        n_late_packets_dropped += in_spikes_filter(is_late_packet_priority);
+        break;
+    default:
+        break;
+    }
 }
 
 //! \brief Prepare the start of a time step
@@ -396,6 +1448,15 @@ static inline bool prepare_timestep(uint32_t time) {
     // Reset these to ensure consistency
     next_buffer_to_fill = 0;
     next_buffer_to_process = 0;
+    lookahead_valid = false;
+    dma_outstanding = false;
+#if SYNAPTIC_ROW_CACHE_SIZE > 0
+    // Any buffers that used the row cache were dropped at the end of the
+    // last time step
+    for (uint32_t i = 0; i < SYNAPTIC_ROW_CACHE_SIZE; i++) {
+        row_cache[i].pins = 0;
+    }
+#endif
 
     // We do this here rather than during init, as it should have similar
     // contention to the expected time of execution
@@ -403,12 +1464,21 @@ static inline bool prepare_timestep(uint32_t time) {
         measure_transfer_time();
     }
 
-    // Start timer2 to tell us when to stop
+    // Start timer2 to tell us when to stop, leaving time for the transfers at
+    // the end of the time step
     uint32_t timer = tc[T1_COUNT];
-    if (timer < clocks_to_transfer) {
+    uint32_t clocks_before_end =
+            (sdram_inputs.n_transfers_before_end * clocks_to_transfer) +
+            (sdram_inputs.n_reduces_before_end * clocks_to_reduce);
+#if SYNAPSE_ADAPTIVE_TRANSFER
+    if (adaptive_transfer) {
+        clocks_before_end = transfer_offset;
+    }
+#endif
+    if (timer < clocks_before_end) {
         return false;
     }
-    uint32_t time_until_stop = timer - clocks_to_transfer;
+    uint32_t time_until_stop = timer - clocks_before_end;
     tc[T2_CONTROL] = 0;
     tc[T2_LOAD] = time_until_stop;
     tc[T2_CONTROL] = 0xe3;
@@ -418,15 +1488,16 @@ static inline bool prepare_timestep(uint32_t time) {
 
     // Store recording data from last time step
     store_data(time);
+    last_transfer_offset = clocks_before_end;
 
-    // Clear the buffer if needed
-    if (clear_input_buffers_of_late_packets) {
-        in_spikes_clear();
-    }
+    // Drop late packets if needed
+    drop_late_packets(time);
     p_per_ts_struct.packets_this_time_step = 0;
     spikes_processed_this_time_step = 0;
 
+#if !FUSED_RING_BUFFER_CLEAR
     synapses_flush_ring_buffers(time);
+#endif
     spin1_mode_restore(cspr);
     return true;
 }
@@ -441,6 +1512,12 @@ static inline void do_rewiring(uint32_t time, uint32_t n_rewires) {
     uint32_t next_buffer = 0;
     bool dma_in_progress = false;
 
+    // Rewiring reads rows from SDRAM, so they must be up to date
+    if (n_rewires > 0) {
+        row_cache_flush();
+        deferred_history_flush();
+    }
+
     // Start the first transfer
     uint32_t rewires_to_go = n_rewires;
     while (rewires_to_go > 0 && !dma_in_progress) {
@@ -483,6 +1560,8 @@ static inline void do_rewiring(uint32_t time, uint32_t n_rewires) {
         if (synaptogenesis_row_restructure(
                 time, dma_buffers[current_buffer].row)) {
             n_successful_rewires++;
+            synapses_mark_row_dirty(
+                    dma_buffers[current_buffer].sdram_writeback_address);
             if (dma_in_progress) {
                 wait_for_dma_to_complete();
             }
@@ -500,6 +1579,13 @@ static inline void do_rewiring(uint32_t time, uint32_t n_rewires) {
 
 void spike_processing_fast_time_step_loop(uint32_t time, uint32_t n_rewires) {
 
+    // Work out the arrival bin scale only when the time step length changes
+    uint32_t load = tc[T1_LOAD];
+    if (load != arrival_bin_load) {
+        arrival_bin_load = load;
+        arrival_bin_scale = (uint32_t) (((uint64_t) N_ARRIVAL_BINS << 32) / load);
+    }
+
     // Prepare for the start
     if (!prepare_timestep(time)) {
         skipped_time_steps++;
@@ -516,6 +1602,12 @@ void spike_processing_fast_time_step_loop(uint32_t time, uint32_t n_rewires) {
         // Wait for a spike, or the timer to expire
         uint32_t spike;
         while (!is_end_of_time_step() && !get_next_spike(time, &spike)) {
+#if STDP_EAGER_POST
+            // There is nothing else to do, so apply the post-synaptic spikes
+            // of a neuron to its synapses
+            n_eager_post_updates +=
+                    synapse_dynamics_apply_post_spikes_eagerly(time);
+#endif
             // This doesn't wait for interrupt currently because there isn't
             // a way to have a T2 interrupt without a callback function, and
             // a callback function is too slow!  This is therefore a busy wait.
@@ -534,52 +1626,77 @@ void spike_processing_fast_time_step_loop(uint32_t time, uint32_t n_rewires) {
         bool dma_in_progress = start_first_dma(time, &spike, &result);
         while (dma_in_progress && !is_end_of_time_step()) {
 
-            // If self-connected looped back spike then process post event here
-            if (((spike & key_config.mask) == key_config.key) &&
-                    (key_config.self_connected)) {
-                synapse_dynamics_process_post_synaptic_event(
-                        time, (spike & key_config.spike_id_mask) >> key_config.colour_shift);
+            // If self-connected looped back spikes then process post events
+            // here
+            if (key_config.self_connected) {
+                dma_buffer *in_flight = &dma_buffers[
+                        (next_buffer_to_fill - 1) & DMA_BUFFER_MOD_MASK];
+                for (uint32_t i = 0; i < in_flight->n_rows; i++) {
+                    spike_t row_spike = in_flight->originating_spikes[i];
+                    if ((row_spike & key_config.mask) == key_config.key) {
+                        for (uint32_t r = in_flight->n_repeats[i]; r > 0; r--) {
+                            synapse_dynamics_process_post_synaptic_event(time,
+                                    (row_spike & key_config.spike_id_mask)
+                                    >> key_config.colour_shift);
+                        }
+                    }
+                }
             }
 
-            // See if there is another DMA to do
-            dma_in_progress = get_next_dma(time, &spike, &result);
+            // Look up rows for upcoming spikes while the DMA progresses, and
+            // see if there is another DMA to do, merging any rows that follow
+            // on from it in SDRAM
+            fill_lookahead(time);
+            uint32_t n_repeats;
+            dma_in_progress = lookahead_next(&spike, &n_repeats, &result);
+            if (dma_in_progress) {
+                begin_row_batch(spike, n_repeats, &result);
+                extend_row_batch(time);
+            }
 
-            // Finish the current DMA before starting the next
-            if (!wait_for_dma_to_complete_or_end()) {
-                count_input_buffer_packets_late += 1;
+            // Finish the current DMA before starting the next; there is none
+            // if the row was in the row cache
+            bool dma_complete = !is_end_of_time_step();
+            if (dma_outstanding) {
+                uint32_t start = phase_start(PROFILER_DMA_WAIT);
+                dma_complete = wait_for_dma_to_complete_or_end();
+                phase_end(PROFILER_DMA_WAIT, start);
+                dma_outstanding = false;
+                if (dma_complete) {
+                    dma_complete_count++;
+                }
+            }
+            if (!dma_complete) {
+                count_input_buffer_packets_late +=
+                        dma_buffers[next_buffer_to_process].n_spikes;
+                if (dma_in_progress) {
+                    count_input_buffer_packets_late +=
+                            dma_buffers[next_buffer_to_fill].n_spikes;
+                }
+                if (lookahead_valid) {
+                    count_input_buffer_packets_late += lookahead.n_repeats;
+                    lookahead_valid = false;
+                }
                 break;
             }
-            dma_complete_count++;
             if (dma_in_progress) {
-                read_synaptic_row(spike, &result);
+                read_synaptic_rows();
             }
 
             // Process the row we already have while the DMA progresses
-            process_current_row(time, dma_in_progress);
+            process_current_row(time, dma_outstanding);
 
         }
 
     }
 }
 
-static inline void check_times(void) {
-    uint32_t tc_time = tc[T1_COUNT];
-    if (tc_time > earliest_spike_received_time) {
-        earliest_spike_received_time = tc_time;
-    }
-    if (tc_time < latest_spike_received_time) {
-        latest_spike_received_time = tc_time;
-    }
-}
-
 //! \brief Called when a multicast packet is received
 //! \param[in] key: The key of the packet. The spike.
 //! \param payload: the payload of the packet. The count.
 void multicast_packet_received_callback(uint key, UNUSED uint unused) {
     log_debug("Received spike %x", key);
-    p_per_ts_struct.packets_this_time_step++;
-    in_spikes_add_spike(key);
-    check_times();
+    receive_packet(key, 1);
 }
 
 //! \brief Called when a multicast packet is received
@@ -587,21 +1704,19 @@ void multicast_packet_received_callback(uint key, UNUSED uint unused) {
 //! \param payload: the payload of the packet. The count.
 void multicast_packet_pl_received_callback(uint key, uint payload) {
     log_debug("Received spike %x with payload %d", key, payload);
-    p_per_ts_struct.packets_this_time_step++;
-
-    // cycle through the packet insertion
-    for (uint count = payload; count > 0; count--) {
-        in_spikes_add_spike(key);
-    }
-    check_times();
+    receive_packet(key, payload);
 }
 
 bool spike_processing_fast_initialise(
         uint32_t row_max_n_words, uint32_t spike_buffer_size,
         bool discard_late_packets, uint32_t pkts_per_ts_rec_region,
-        uint32_t multicast_priority, struct sdram_config sdram_inputs_param,
-        struct key_config key_config_param, weight_t *ring_buffers_param) {
+        uint32_t recording_flags, uint32_t multicast_priority,
+        struct sdram_config sdram_inputs_param,
+        struct key_config key_config_param, ring_buffer_t *ring_buffers_param,
+        struct row_cache_hints *hints,
+        struct late_packet_config *late_config) {
     // Allocate the DMA buffers
+    dma_buffer_n_bytes = row_max_n_words * sizeof(uint32_t);
     for (uint32_t i = 0; i < N_DMA_BUFFERS; i++) {
         dma_buffers[i].row = spin1_malloc(row_max_n_words * sizeof(uint32_t));
         if (dma_buffers[i].row == NULL) {
@@ -612,8 +1727,48 @@ bool spike_processing_fast_initialise(
         log_debug("DMA buffer %u allocated at 0x%08x",
                 i, dma_buffers[i].row);
     }
+#if SYNAPTIC_ROW_CACHE_SIZE > 0
+    for (uint32_t i = 0; i < SYNAPTIC_ROW_CACHE_SIZE; i++) {
+        row_cache[i].sdram_address = NULL;
+        row_cache[i].last_used = 0;
+        row_cache[i].dirty_words = 0;
+        row_cache[i].pins = 0;
+        row_cache[i].row = spin1_malloc(row_max_n_words * sizeof(uint32_t));
+        if (row_cache[i].row == NULL) {
+            log_error("Could not initialise row cache of %u rows of %u words",
+                    SYNAPTIC_ROW_CACHE_SIZE, row_max_n_words);
+            return false;
+        }
+    }
+    uint32_t n_hints = hints->n_sources;
+    if (n_hints > ROW_CACHE_MAX_HOT_SOURCES) {
+        n_hints = ROW_CACHE_MAX_HOT_SOURCES;
+    }
+    uint32_t hints_size = sizeof(struct row_cache_hints)
+            + n_hints * sizeof(hints->sources[0]);
+    hot_sources = spin1_malloc(hints_size);
+    if (hot_sources == NULL) {
+        log_error("Could not allocate %u bytes for row cache hints",
+                hints_size);
+        return false;
+    }
+    spin1_memcpy(hot_sources, hints, hints_size);
+    hot_sources->n_sources = n_hints;
+#else
+    use(hints);
+#endif
+#if SYNAPSE_DEFERRED_HISTORY_SIZE > 0
+    for (uint32_t i = 0; i < SYNAPSE_DEFERRED_HISTORY_SIZE; i++) {
+        deferred_histories[i].sdram_address = NULL;
+    }
+    deferred_history_words = synapse_dynamics_get_plastic_header_words();
+    if (deferred_history_words > DEFERRED_HISTORY_MAX_WORDS) {
+        deferred_history_words = 0;
+    }
+#endif
     next_buffer_to_fill = 0;
     next_buffer_to_process = 0;
+    lookahead_valid = false;
 
     // Allocate incoming spike buffer
     if (!in_spikes_initialize_spike_buffer(spike_buffer_size)) {
@@ -621,26 +1776,85 @@ bool spike_processing_fast_initialise(
     }
 
     // Store parameters and data
-    clear_input_buffers_of_late_packets = discard_late_packets;
+    late_packets = *late_config;
+    if (!discard_late_packets) {
+        late_packets.policy = LATE_PACKETS_KEEP;
+    }
+    if (late_packets.n_priority_sources > LATE_PACKETS_MAX_PRIORITY_SOURCES) {
+        log_error("Too many late packet priority sources: %u",
+                late_packets.n_priority_sources);
+        return false;
+    }
     p_per_ts_region = pkts_per_ts_rec_region;
+    uint32_t phase_regions = ((1 << PROFILER_N_PHASES) - 1) <<
+            (pkts_per_ts_rec_region + 1);
+    phase_recording_flags = recording_flags & phase_regions;
+    phase_timing = phase_recording_flags != 0;
+    offset_recording = (recording_flags &
+            (1 << (pkts_per_ts_rec_region + 1 + PROFILER_N_PHASES))) != 0;
     sdram_inputs = sdram_inputs_param;
     key_config = key_config_param;
     ring_buffers = ring_buffers_param;
+    if (sdram_inputs.n_reduce_partners > MAX_REDUCE_PARTNERS) {
+        log_error("Too many synapse cores to add inputs from: %u",
+                sdram_inputs.n_reduce_partners);
+        return false;
+    }
+    if (sdram_inputs.n_reduce_partners > 0 ||
+            synapses_delay_wheel_slot(0) != NULL) {
+        reduce_buffer = spin1_malloc(sdram_inputs.size_in_bytes);
+        if (reduce_buffer == NULL) {
+            log_error("Could not allocate %u bytes to read inputs into",
+                    sdram_inputs.size_in_bytes);
+            return false;
+        }
+    }
+#if SYNAPSE_SPARSE_TRANSFER
+    sparse_inputs = spin1_malloc(sdram_inputs.size_in_bytes);
+    if (sparse_inputs == NULL) {
+        log_error("Could not allocate %u bytes to list sparse inputs in",
+                sdram_inputs.size_in_bytes);
+        return false;
+    }
+#endif
+#if SYNAPSE_ADAPTIVE_TRANSFER
+    // The cores that add up their inputs rely on each other's timing, so
+    // only a core that transfers on its own can move its transfer
+    adaptive_transfer = (sdram_inputs.n_reduce_partners == 0) &&
+            (sdram_inputs.n_transfers_before_end == 1) &&
+            (sdram_inputs.n_reduces_before_end == 0);
+#endif
 
-    // Configure for multicast reception
+    // Configure for multicast reception; when polling, no callback is
+    // registered so that the packets stay in the communications controller
+    // until the spike processing loop takes them
+#if SYNAPSE_POLLED_RECEIVE
+    use(multicast_priority);
+#else
     spin1_callback_on(MC_PACKET_RECEIVED, multicast_packet_received_callback,
             multicast_priority);
     spin1_callback_on(MCPL_PACKET_RECEIVED, multicast_packet_pl_received_callback,
             multicast_priority);
+#endif
 
     // Wipe the inputs using word writes
     for (uint32_t i = 0; i < (sdram_inputs.size_in_bytes >> 2); i++) {
         sdram_inputs.address[i] = 0;
     }
+#if SYNAPSE_SPARSE_TRANSFER
+    // A header of 0 says that none of the inputs are sent
+    sdram_inputs.address[sdram_inputs.size_in_bytes >> 2] = 0;
+#endif
 
     return true;
 }
 
+void spike_processing_fast_pause(void) {
+    row_cache_flush();
+    deferred_history_flush();
+    population_table_store_event_counters();
+}
+
 void spike_processing_fast_store_provenance(
         struct spike_processing_fast_provenance *prov) {
     prov->n_input_buffer_overflows = in_spikes_get_n_buffer_overflows();
@@ -657,4 +1871,17 @@ void spike_processing_fast_store_provenance(
     prov->earliest_receive = earliest_spike_received_time;
     prov->latest_receive = latest_spike_received_time;
     prov->max_spikes_overflow = max_spikes_overflow;
+    prov->n_rows_coalesced = n_rows_coalesced;
+    prov->n_repeated_row_applications = n_repeated_row_applications;
+    prov->n_row_cache_hits = n_row_cache_hits;
+    prov->n_row_cache_misses = n_row_cache_misses;
+    prov->n_write_backs_deferred = n_write_backs_deferred;
+    prov->n_write_back_words_saved = n_write_back_words_saved;
+    prov->n_history_write_backs_deferred = n_history_write_backs_deferred;
+    prov->n_eager_post_updates = n_eager_post_updates;
+    prov->n_write_backs_queued = n_write_backs_queued;
+    prov->n_late_packets_dropped = n_late_packets_dropped;
+    for (uint32_t i = 0; i < N_ARRIVAL_BINS; i++) {
+        prov->arrival_histogram[i] = arrival_histogram[i];
+    }
 }
@@ -24,6 +24,10 @@
 #include <spin1_api.h>
 #include "synapse_row.h"
 
+//! \brief The most other synapse cores whose inputs can be added to those of
+//!     this core before they are transferred to the neuron core
+#define MAX_REDUCE_PARTNERS 5
+
 //! A region of SDRAM used to transfer synapses
 struct sdram_config {
     //! The address of the input data to be transferred
@@ -32,6 +36,17 @@ struct sdram_config {
     uint32_t size_in_bytes;
     //! The time of the transfer in us
     uint32_t time_for_transfer_overhead;
+    //! \brief The number of other synapse cores whose inputs are added to
+    //!     those of this core before the transfer; 0 if none
+    uint32_t n_reduce_partners;
+    //! \brief The number of transfers to leave time for at the end of the
+    //!     time step, including this core's and those that follow it
+    uint32_t n_transfers_before_end;
+    //! \brief The number of reads and adds of the inputs of other cores to
+    //!     leave time for at the end of the time step
+    uint32_t n_reduces_before_end;
+    //! The addresses of the inputs of the other cores, in the order to add
+    uint32_t *reduce_partners[MAX_REDUCE_PARTNERS];
 };
 
 //! The key and mask being used to send spikes from neurons processed on this
@@ -49,6 +64,60 @@ struct key_config {
     uint32_t self_connected;
 };
 
+//! The most sources that can be hinted to be hot
+#define ROW_CACHE_MAX_HOT_SOURCES 8
+
+//! \brief The sources that the host expects to spike often enough for their
+//!     rows to be worth keeping in DTCM, hottest first
+struct row_cache_hints {
+    //! The number of sources
+    uint32_t n_sources;
+    //! The key and mask of each source
+    struct {
+        //! The key of the source
+        uint32_t key;
+        //! The mask of the source
+        uint32_t mask;
+    } sources[];
+};
+
+//! How to treat the packets left in the input buffer at the end of a time step
+typedef enum late_packet_policy_e {
+    //! Keep them all, to process in the next time step
+    LATE_PACKETS_KEEP = 0,
+    //! Drop them all
+    LATE_PACKETS_DROP_ALL = 1,
+    //! Drop those sent more time steps ago than allowed, going by the colour
+    LATE_PACKETS_DROP_AGED = 2,
+    //! Keep those of the priority sources, and drop the rest
+    LATE_PACKETS_KEEP_PRIORITY = 3
+} late_packet_policy_e;
+
+//! The most sources whose late packets can be kept by priority
+#define LATE_PACKETS_MAX_PRIORITY_SOURCES 8
+
+//! How to drop the packets left at the end of a time step, when dropping
+struct late_packet_config {
+    //! The policy to use; a late_packet_policy_e
+    uint32_t policy;
+    //! The most time steps ago a packet can have been sent and be kept
+    uint32_t max_age;
+    //! The mask of the colour in the keys of the packets received
+    uint32_t colour_mask;
+    //! The number of priority sources
+    uint32_t n_priority_sources;
+    //! The key and mask of each priority source
+    struct {
+        //! The key of the source
+        uint32_t key;
+        //! The mask of the source
+        uint32_t mask;
+    } priority_sources[LATE_PACKETS_MAX_PRIORITY_SOURCES];
+};
+
+//! The number of bins of the histogram of when spikes arrive in the time step
+#define N_ARRIVAL_BINS 8
+
 //! Provenance for spike processing
 struct spike_processing_fast_provenance {
     //! A count of the times that the synaptic input circular buffers overflowed
@@ -79,26 +148,59 @@ struct spike_processing_fast_provenance {
     uint32_t latest_receive;
     //! The most spikes left at the end of any time step
     uint32_t max_spikes_overflow;
+    //! The number of rows read as part of the DMA of an adjacent row
+    uint32_t n_rows_coalesced;
+    //! The number of times a row was applied again for a repeated spike
+    uint32_t n_repeated_row_applications;
+    //! The number of rows processed from the row cache
+    uint32_t n_row_cache_hits;
+    //! The number of rows processed that were not in the row cache
+    uint32_t n_row_cache_misses;
+    //! The number of plastic row write backs saved by the row cache
+    uint32_t n_write_backs_deferred;
+    //! The number of words of unchanged plastic data not written back
+    uint32_t n_write_back_words_saved;
+    //! The number of row write backs saved by keeping the plastic header
+    uint32_t n_history_write_backs_deferred;
+    //! The number of plastic synapses updated as the post-synaptic spikes
+    //! happened
+    uint32_t n_eager_post_updates;
+    //! The number of plastic write backs that waited for the DMA of the next
+    //! rows while the rows after them were processed
+    uint32_t n_write_backs_queued;
+    //! The number of late packets dropped by the late packet policy
+    uint32_t n_late_packets_dropped;
+    //! The number of packets received in each eighth of the time step
+    uint32_t arrival_histogram[N_ARRIVAL_BINS];
 };
 
 //! \brief Set up spike processing
 //! \param[in] row_max_n_words The maximum row length in words
 //! \param[in] spike_buffer_size The size to make the spike buffer
 //! \param[in] discard_late_packets Whether to throw away packets not processed
-//!                                 at the end of a time step or keep them for
-//!                                 the next time step
+//!                                 at the end of a time step, as set by
+//!                                 late_config, or keep them all for the
+//!                                 next time step
 //! \param[in] pkts_per_ts_rec_region The ID of the recording region to record
-//!                                   packets-per-time-step to
+//!                                   packets-per-time-step to; the cycles
+//!                                   spent in each phase of the time step
+//!                                   are recorded to the regions after this,
+//!                                   followed by the point of the transfer
+//! \param[in] recording_flags The flags of the regions being recorded
 //! \param[in] multicast_priority The priority of multicast processing
 //! \param[in] sdram_inputs_param Details of the SDRAM transfer for the ring buffers
 //! \param[in] key_config_param Details of the key used by the neuron core
 //! \param[in] ring_buffers_param The ring buffers to update with synapse weights
+//! \param[in] hints The sources whose rows are worth keeping in DTCM
+//! \param[in] late_config How to drop late packets, if they are discarded
 //! \return Whether the setup was successful or not
 bool spike_processing_fast_initialise(
         uint32_t row_max_n_words, uint32_t spike_buffer_size,
         bool discard_late_packets, uint32_t pkts_per_ts_rec_region,
+        uint32_t recording_flags,
         uint32_t multicast_priority, struct sdram_config sdram_inputs_param,
-        struct key_config key_config_param, weight_t *ring_buffers_param);
+        struct key_config key_config_param, ring_buffer_t *ring_buffers_param,
+        struct row_cache_hints *hints, struct late_packet_config *late_config);
 
 //! \brief The main loop of spike processing to be run once per time step.
 //!        Note that this function will not return until the end of the time
@@ -107,6 +209,10 @@ bool spike_processing_fast_initialise(
 //! \param[in] n_rewires The number of rewiring attempts to be done
 void spike_processing_fast_time_step_loop(uint32_t time, uint32_t n_rewires);
 
+//! \brief Write back anything held locally that is newer than SDRAM, so that
+//!        the synapses can be read while paused
+void spike_processing_fast_pause(void);
+
 //! \brief Store any provenance data gathered from spike processing
 //! \param[in] prov The structure to store the provenance data in
 void spike_processing_fast_store_provenance(
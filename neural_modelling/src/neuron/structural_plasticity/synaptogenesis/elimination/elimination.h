@@ -31,6 +31,14 @@ typedef struct elimination_params elimination_params_t;
 //! \return the read parameters data structure
 elimination_params_t *synaptogenesis_elimination_init(uint8_t **data);
 
+//! \brief The part of the elimination rule that doesn't need the synaptic
+//!     row; if this says no, the elimination won't happen
+//! \param[in,out] current_state: Pointer to current state
+//! \param[in] params: The elimination rule configuration.
+//! \return Whether the elimination might happen
+static inline bool synaptogenesis_elimination_may_eliminate(
+        current_state_t *current_state, const elimination_params_t *params);
+
 //! \brief Elimination rule for synaptogenesis
 //! \param[in,out] current_state: Pointer to current state
 //! \param[in] params: The elimination rule configuration.
@@ -32,6 +32,31 @@ struct elimination_params {
     uint32_t threshold;
 };
 
+//! \brief Draw the random number of the rule, and decide whether it would
+//!     eliminate a synapse of any weight
+//! \param[in,out] current_state: Pointer to current state
+//! \param[in] params: The elimination rule configuration.
+//! \return Whether the elimination might happen
+static inline bool synaptogenesis_elimination_may_eliminate(
+        current_state_t *restrict current_state,
+        const elimination_params_t *params) {
+#if SYNAPTOGENESIS_EARLY_REJECT
+#if SYNAPTOGENESIS_EARLY_REJECT
+    // Drawn by synaptogenesis_elimination_may_eliminate() before the row read
+    uint32_t random_number = current_state->random;
+#else
+    uint32_t random_number = mars_kiss64_seed(*(current_state->local_seed));
+#endif
+    current_state->random = random_number;
+    return random_number <= params->prob_elim_depression ||
+            random_number <= params->prob_elim_potentiation;
+#else
+    use(current_state);
+    use(params);
+    return true;
+#endif
+}
+
 //! \brief Elimination rule for synaptogenesis
 //! \param[in,out] current_state: Pointer to current state
 //! \param[in] params: The elimination rule configuration.
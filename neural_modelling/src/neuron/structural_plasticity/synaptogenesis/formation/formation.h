@@ -31,6 +31,14 @@ typedef struct formation_params formation_params_t;
 //! \return the read parameters data structure
 formation_params_t *synaptogenesis_formation_init(uint8_t **data);
 
+//! \brief The part of the formation rule that doesn't need the synaptic row;
+//!     if this says no, the formation won't happen
+//! \param[in] current_state: Pointer to current state
+//! \param[in] params: Pointer to rewiring data
+//! \return Whether the formation might happen
+static inline bool synaptogenesis_formation_may_form(
+        current_state_t *current_state, const formation_params_t *params);
+
 //! \brief Formation rule for synaptogenesis; picks what neuron in the
 //!     _current_ population will have a synapse added, and then performs the
 //!     addition.
@@ -18,19 +18,66 @@
 //! \brief Support code for formation_distance_dependent_impl.h
 #include "formation_distance_dependent_impl.h"
 
+#if FORMATION_DISTANCE_TABLE
+//! \brief Get a probability for the distance table
+//! \param[in] probs: The probability table, keyed by squared distance
+//! \param[in] n_probs: The size of the probability table
+//! \param[in] distance: The squared distance
+//! \return The probability, or ::FORMATION_NO_PROBABILITY if out of range
+static inline uint32_t table_probability(
+        const uint16_t *probs, uint32_t n_probs, uint32_t distance) {
+    if (distance >= n_probs) {
+        return FORMATION_NO_PROBABILITY;
+    }
+    return probs[distance];
+}
+
+//! \brief Fill in the distance table from the probability tables
+//! \param[in] params: The formation parameters, with space for the table
+static void build_distance_table(formation_params_t *params) {
+    uint32_t width_x = formation_table_width(params->grid_x);
+    uint32_t width_y = formation_table_width(params->grid_y);
+    uint32_t n_entries = width_x * width_y;
+    const uint16_t *lat_probs = &params->prob_tables[params->ff_prob_size];
+    uint32_t *table = (uint32_t *) formation_distance_table(params);
+    for (uint32_t x = 0; x < width_x; x++) {
+        for (uint32_t y = 0; y < width_y; y++) {
+            uint32_t distance = x * x + y * y;
+            uint32_t index = x * width_y + y;
+            table[index] = table_probability(
+                    params->prob_tables, params->ff_prob_size, distance);
+            table[n_entries + index] = table_probability(
+                    lat_probs, params->lat_prob_size, distance);
+        }
+    }
+}
+#endif
+
 formation_params_t *synaptogenesis_formation_init(uint8_t **data) {
     // Reference the parameters to read the sizes
     formation_params_t *form_params = (formation_params_t *) *data;
     uint32_t data_size = sizeof(formation_params_t) + (sizeof(uint16_t) *
             (form_params->ff_prob_size + form_params->lat_prob_size));
+    uint32_t alloc_size = data_size;
+#if FORMATION_DISTANCE_TABLE
+    // The distance table goes after the probabilities, word aligned
+    alloc_size = sizeof(formation_params_t) + sizeof(uint16_t) *
+            ((form_params->ff_prob_size + form_params->lat_prob_size + 1) & ~1);
+    alloc_size += 2 * sizeof(uint32_t) *
+            formation_table_width(form_params->grid_x) *
+            formation_table_width(form_params->grid_y);
+#endif
 
     // Allocate the space for the data and copy it in
-    form_params = spin1_malloc(data_size);
+    form_params = spin1_malloc(alloc_size);
     if (form_params == NULL) {
         log_error("Out of memory when allocating parameters");
         rt_error(RTE_SWERR);
     }
     spin1_memcpy(form_params, *data, data_size);
+#if FORMATION_DISTANCE_TABLE
+    build_distance_table(form_params);
+#endif
     log_debug("Formation distance dependent %u bytes, grid=(%u, %u), %u ff probs, %u lat probs",
             data_size, form_params->grid_x, form_params->grid_y,
             form_params->ff_prob_size, form_params->lat_prob_size);
@@ -24,6 +24,17 @@
 //! Largest value in a `uint16_t`
 #define MAX_SHORT 65535
 
+//! \brief Whether to look up the probability by the distance in each
+//!     dimension in a table made at initialisation, rather than working out
+//!     the squared distance on each attempt.  This can be set per binary at
+//!     build time.
+#ifndef FORMATION_DISTANCE_TABLE
+#define FORMATION_DISTANCE_TABLE 0
+#endif
+
+//! The value in the distance table where no formation can happen
+#define FORMATION_NO_PROBABILITY 0xFFFFFFFF
+
 //! \brief Configuration of synapse formation rule
 //!
 //! Describes the size of grid containing the neurons (the total number of
@@ -53,6 +64,26 @@ struct formation_params {
     uint16_t prob_tables[];
 };
 
+#if FORMATION_DISTANCE_TABLE
+//! \brief Get the number of distances in a dimension of the distance table
+//! \param[in] grid_size: The size of the grid in the dimension
+//! \return The number of distances, with wrap-around
+static inline uint32_t formation_table_width(uint32_t grid_size) {
+    return (grid_size > 1) ? (grid_size >> 1) + 1 : 1;
+}
+
+//! \brief Get the distance table, which is after the probability tables in
+//!     the same allocation; the FF table is first, then the LAT table, each
+//!     indexed by `delta_x * width_y + delta_y`
+//! \param[in] params: The formation parameters
+//! \return The distance table
+static inline const uint32_t *formation_distance_table(
+        const formation_params_t *params) {
+    uint32_t n_probs = params->ff_prob_size + params->lat_prob_size;
+    return (const uint32_t *) &params->prob_tables[(n_probs + 1) & ~1];
+}
+#endif
+
 //! \brief abs function
 //! \param[in] a: value (must not be `INT_MIN`)
 //! \return Absolute value of \a a
@@ -60,17 +91,13 @@ static int my_abs(int a) {
     return a < 0 ? -a : a;
 }
 
-//! \brief Formation rule for synaptogenesis; picks what neuron in the
-//!     _current_ population will have a synapse added, and then performs the
-//!     addition.
+//! \brief Decide, by the distance between the neurons, whether a formation
+//!     may happen
 //! \param[in] current_state: Pointer to current state
 //! \param[in] params: Pointer to rewiring data
-//! \param[in] time: Time of formation
-//! \param[in] row: The row to form within
-//! \return if row was modified
-static inline bool synaptogenesis_formation_rule(
-        current_state_t *current_state, const formation_params_t *params,
-        UNUSED uint32_t time, synaptic_row_t row) {
+//! \return Whether the formation might happen
+static inline bool synaptogenesis_formation_may_form(
+        current_state_t *current_state, const formation_params_t *params) {
     // Compute distances
     // To do this I need to take the DIV and MOD of the
     // post-synaptic neuron ID, of the pre-synaptic neuron ID
@@ -106,18 +133,29 @@ static inline bool synaptogenesis_formation_rule(
     delta_y = my_abs(pre_y - post_y);
 
     if (delta_x > params->grid_x >> 1 && params->grid_x > 1) {
-        delta_x -= params->grid_x;
+        delta_x = params->grid_x - delta_x;
     }
 
     if (delta_y > params->grid_y >> 1 && params->grid_y > 1) {
-        delta_y -= params->grid_y;
+        delta_y = params->grid_y - delta_y;
     }
 
+    int16_t controls = current_state->pre_population_info->sp_control;
+#if FORMATION_DISTANCE_TABLE
+    uint32_t width_y = formation_table_width(params->grid_y);
+    uint32_t index = delta_x * width_y + delta_y;
+    if (controls & IS_CONNECTION_LAT) {
+        index += formation_table_width(params->grid_x) * width_y;
+    }
+    uint32_t probability = formation_distance_table(params)[index];
+    if (probability == FORMATION_NO_PROBABILITY) {
+        return false;
+    }
+#else
     uint32_t distance = delta_x * delta_x + delta_y * delta_y;
 
     // Distance based probability extracted from the appropriate LUT
     uint16_t probability;
-    int16_t controls = current_state->pre_population_info->sp_control;
     if (!(controls & IS_CONNECTION_LAT)) {
         if (distance >= params->ff_prob_size) {
             return false;
@@ -129,10 +167,30 @@ static inline bool synaptogenesis_formation_rule(
         }
         probability = params->prob_tables[params->ff_prob_size + distance];
     }
+#endif
     uint32_t r = rand_int(MAX_SHORT, *(current_state->local_seed));
-    if (r > probability) {
+    return r <= probability;
+}
+
+//! \brief Formation rule for synaptogenesis; picks what neuron in the
+//!     _current_ population will have a synapse added, and then performs the
+//!     addition.
+//! \param[in] current_state: Pointer to current state
+//! \param[in] params: Pointer to rewiring data
+//! \param[in] time: Time of formation
+//! \param[in] row: The row to form within
+//! \return if row was modified
+static inline bool synaptogenesis_formation_rule(
+        current_state_t *current_state, const formation_params_t *params,
+        UNUSED uint32_t time, synaptic_row_t row) {
+#if SYNAPTOGENESIS_EARLY_REJECT
+    // synaptogenesis_formation_may_form() has been done before the row read
+    use(params);
+#else
+    if (!synaptogenesis_formation_may_form(current_state, params)) {
         return false;
     }
+#endif
 
     return sp_structs_add_synapse(current_state, row);
 }
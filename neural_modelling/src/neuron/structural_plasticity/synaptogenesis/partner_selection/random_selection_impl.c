@@ -18,5 +18,96 @@
 //! \brief Support code for random_selection_impl.h
 #include "random_selection_impl.h"
 
+#if PARTNER_ALIAS_TABLE
+//! The alias table of the pre-synaptic sub-populations
+partner_alias_entry_t *partner_alias_table;
+
+//! The number of entries in ::partner_alias_table
+uint32_t partner_alias_table_size;
+
+//! \brief Make the alias table, in which each sub-population has the same
+//!     chance of being chosen as with the search: each population equally
+//!     likely, and then each of its sub-populations by its number of atoms
+static void build_alias_table(void) {
+    extern pre_pop_info_table_t pre_info;
+
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < pre_info.no_pre_pops; i++) {
+        n += pre_info.prepop_info[i]->no_pre_vertices;
+    }
+    partner_alias_table_size = n;
+    partner_alias_table = spin1_malloc(n * sizeof(partner_alias_entry_t));
+    uint64_t *scaled = spin1_malloc(n * sizeof(uint64_t));
+    uint16_t *work = spin1_malloc(2 * n * sizeof(uint16_t));
+    if (partner_alias_table == NULL || scaled == NULL || work == NULL) {
+        log_error("Out of memory when creating partner alias table");
+        rt_error(RTE_SWERR);
+    }
+
+    // Find the chance of each, out of about 2^32, times the number of
+    // entries, so that the mean is the total
+    uint64_t total = 0;
+    uint32_t k = 0;
+    for (uint32_t i = 0; i < pre_info.no_pre_pops; i++) {
+        pre_info_t *info = pre_info.prepop_info[i];
+        uint64_t pop_total = (uint64_t) info->total_no_atoms *
+                pre_info.no_pre_pops;
+        for (uint32_t j = 0; j < info->no_pre_vertices; j++) {
+            uint64_t weight =
+                    ((uint64_t) info->key_atom_info[j].n_atoms << 32) /
+                    pop_total;
+            partner_alias_table[k].population_id = i;
+            partner_alias_table[k].sub_population_id = j;
+            scaled[k] = weight * n;
+            total += weight;
+            k++;
+        }
+    }
+
+    // Pair each entry below the mean with one above it (Vose's method)
+    uint16_t *small = work;
+    uint16_t *large = &work[n];
+    uint32_t n_small = 0, n_large = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        if (scaled[i] < total) {
+            small[n_small++] = i;
+        } else {
+            large[n_large++] = i;
+        }
+    }
+    while (n_small > 0 && n_large > 0) {
+        uint32_t s = small[--n_small];
+        uint32_t l = large[--n_large];
+        partner_alias_table[s].threshold =
+                (uint32_t) ((scaled[s] << 16) / (total >> 16));
+        partner_alias_table[s].alias = l;
+        scaled[l] -= total - scaled[s];
+        if (scaled[l] < total) {
+            small[n_small++] = l;
+        } else {
+            large[n_large++] = l;
+        }
+    }
+
+    // Anything left is (within rounding) exactly at the mean
+    while (n_small > 0) {
+        uint32_t s = small[--n_small];
+        partner_alias_table[s].threshold = UINT32_MAX;
+        partner_alias_table[s].alias = s;
+    }
+    while (n_large > 0) {
+        uint32_t l = large[--n_large];
+        partner_alias_table[l].threshold = UINT32_MAX;
+        partner_alias_table[l].alias = l;
+    }
+    sark_free(scaled);
+    sark_free(work);
+    log_debug("Random selection alias table of %u sub-populations", n);
+}
+#endif
+
 void partner_init(UNUSED uint8_t **data) {
+#if PARTNER_ALIAS_TABLE
+    build_alias_table();
+#endif
 }
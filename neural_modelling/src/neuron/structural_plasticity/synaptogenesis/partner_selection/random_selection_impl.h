@@ -22,6 +22,30 @@
 #include "partner.h"
 #include <neuron/spike_processing.h>
 
+//! \brief Whether to choose the sub-population from an alias table made at
+//!     initialisation, which takes one random draw and no search, rather
+//!     than choosing a population and then searching its sub-populations.
+//!     This can be set per binary at build time.
+#ifndef PARTNER_ALIAS_TABLE
+#define PARTNER_ALIAS_TABLE 0
+#endif
+
+#if PARTNER_ALIAS_TABLE
+//! \brief An entry of the alias table, one for each pre-synaptic
+//!     sub-population
+typedef struct partner_alias_entry {
+    //! The chance, out of 2<sup>32</sup>, of choosing this entry, rather
+    //! than its alias, when this entry is drawn
+    uint32_t threshold;
+    //! The index of the entry to choose otherwise
+    uint16_t alias;
+    //! The ID of the population
+    uint16_t population_id;
+    //! The ID of the sub-population within the population
+    uint32_t sub_population_id;
+} partner_alias_entry_t;
+#endif
+
 //! \brief Notifies the rule that a spike has been received
 //! \details Not used by this rule
 //! \param[in] time: The time that the spike was received at
@@ -48,28 +72,46 @@ static inline bool potential_presynaptic_partner(
     extern rewiring_data_t rewiring_data;
     extern pre_pop_info_table_t pre_info;
 
+#if PARTNER_ALIAS_TABLE
+    extern partner_alias_entry_t *partner_alias_table;
+    extern uint32_t partner_alias_table_size;
+
+    // The top of the scaled draw picks the entry, and the rest decides
+    // between the entry and its alias
+    uint64_t r = (uint64_t) mars_kiss64_seed(rewiring_data.local_seed) *
+            partner_alias_table_size;
+    const partner_alias_entry_t *entry = &partner_alias_table[r >> 32];
+    if ((uint32_t) r >= entry->threshold) {
+        entry = &partner_alias_table[entry->alias];
+    }
+    *population_id = entry->population_id;
+    uint32_t subpop_id = entry->sub_population_id;
+    pre_info_t *preapppop_info = pre_info.prepop_info[entry->population_id];
+#else
     uint32_t pop_id = ulrbits(mars_kiss64_seed(rewiring_data.local_seed)) *
             pre_info.no_pre_pops;
     *population_id = pop_id;
     pre_info_t *preapppop_info = pre_info.prepop_info[pop_id];
 
     // Select presynaptic sub-population
-    uint32_t n_id = ulrbits(mars_kiss64_seed(rewiring_data.local_seed)) *
+    uint32_t sub_n_id = ulrbits(mars_kiss64_seed(rewiring_data.local_seed)) *
             preapppop_info->total_no_atoms;
     uint32_t subpop_id = 0;
     uint32_t sum = 0;
     for (uint32_t i = 0; i < preapppop_info->no_pre_vertices; i++) {
         sum += preapppop_info->key_atom_info[i].n_atoms;
-        if (sum >= n_id) {
+        if (sum >= sub_n_id) {
             subpop_id = i;
             break;
         }
     }
+#endif
     *sub_population_id = subpop_id;
     key_atom_info_t *kai = &preapppop_info->key_atom_info[subpop_id];
 
     // Select a presynaptic neuron ID
-    n_id = ulrbits(mars_kiss64_seed(rewiring_data.local_seed)) * kai->n_atoms;
+    uint32_t n_id =
+            ulrbits(mars_kiss64_seed(rewiring_data.local_seed)) * kai->n_atoms;
 
     *neuron_id = n_id;
     *spike = kai->key | (n_id << kai->n_colour_bits);
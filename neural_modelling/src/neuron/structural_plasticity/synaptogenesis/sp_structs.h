@@ -33,6 +33,15 @@ struct formation_params;
 //! Flag: Is connection lateral?
 #define IS_CONNECTION_LAT 1
 
+//! \brief Whether to reject rewiring attempts that can't succeed before the
+//!     synaptic row is read, using the parts of the formation and elimination
+//!     rules that don't need the row.  This draws the random numbers of the
+//!     rules in a different order, so the results are not the same as
+//!     without it.  This can be set per binary at build time.
+#ifndef SYNAPTOGENESIS_EARLY_REJECT
+#define SYNAPTOGENESIS_EARLY_REJECT 0
+#endif
+
 #ifndef SOMETIMES_UNUSED
 #define SOMETIMES_UNUSED __attribute__((unused))
 #endif // !SOMETIMES_UNUSED
@@ -114,6 +123,10 @@ typedef struct {
     uint16_t weight;
     //! synapse type
     uint32_t synapse_type;
+#if SYNAPTOGENESIS_EARLY_REJECT
+    //! The random number of the rule, drawn before the row is read
+    uint32_t random;
+#endif
 } current_state_t;
 
 //! Get a random unsigned integer up to (but not including) a given maximum
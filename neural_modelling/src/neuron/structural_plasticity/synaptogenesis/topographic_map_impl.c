@@ -54,6 +54,13 @@ enum {
 //! How much to shift pre-IDs by
 #define PRE_ID_SHIFT 9
 
+//! \brief Whether rewiring is only done in the periods after spikes have been
+//!     received, so that a quiet core does no rewiring.  This can be set per
+//!     binary at build time.
+#ifndef SYNAPTOGENESIS_ACTIVITY_GATED
+#define SYNAPTOGENESIS_ACTIVITY_GATED 0
+#endif
+
 //-----------------------------------------------------------------------------
 // Structures and global data                                                 |
 //-----------------------------------------------------------------------------
@@ -99,6 +106,20 @@ structural_recording_values_t structural_recording_values;
 //! Timer callbacks since last rewiring
 static uint32_t last_rewiring_time = 0;
 
+#if SYNAPTOGENESIS_ACTIVITY_GATED
+//! The number of spikes received since the rewiring was last due
+static volatile uint32_t n_spikes_since_rewiring = 0;
+
+//! Whether any spikes were received in the last rewiring period
+static bool rewiring_active = false;
+#endif
+
+#if SYNAPTOGENESIS_EARLY_REJECT
+//! \brief The number of free synaptic elements of each post-neuron, so that
+//!     the search for an existing synapse can be skipped if it has none
+static uint16_t *n_free_elements;
+#endif
+
 void print_post_to_pre_entry(void) {
     uint32_t n_elements =
             rewiring_data.s_max * rewiring_data.machine_no_atoms;
@@ -209,6 +230,25 @@ bool synaptogenesis_dynamics_initialise(
         elimination_params[i] = synaptogenesis_elimination_init(&data);
     }
 
+#if SYNAPTOGENESIS_EARLY_REJECT
+    n_free_elements = spin1_malloc(
+            rewiring_data.machine_no_atoms * sizeof(uint16_t));
+    if (n_free_elements == NULL) {
+        log_error("Could not allocate free element counts");
+        rt_error(RTE_SWERR);
+    }
+    for (uint32_t i = 0; i < rewiring_data.machine_no_atoms; i++) {
+        uint32_t n_free = 0;
+        for (uint32_t j = 0; j < rewiring_data.s_max; j++) {
+            if (post_to_pre_table[(i * rewiring_data.s_max) + j].neuron_index
+                    == 0xFFFF) {
+                n_free++;
+            }
+        }
+        n_free_elements[i] = n_free;
+    }
+#endif
+
     rewiring_recording_index = *recording_regions_used;
     *recording_regions_used = rewiring_recording_index + 1;
 
@@ -217,6 +257,49 @@ bool synaptogenesis_dynamics_initialise(
     return true;
 }
 
+#if SYNAPTOGENESIS_EARLY_REJECT
+//! \brief Determine if a post-neuron already has a synapse from a pre-neuron,
+//!     from the post to pre table rather than the synaptic row
+//! \param[in] post_id: The post-neuron
+//! \param[in] pre: The pre-neuron
+//! \return Whether there is a synapse
+static inline bool has_synapse_from(uint32_t post_id, post_to_pre_entry pre) {
+    if (n_free_elements[post_id] == rewiring_data.s_max) {
+        return false;
+    }
+    post_to_pre_entry *entries = &post_to_pre_table[
+            post_id * rewiring_data.s_max];
+    for (uint32_t i = 0; i < rewiring_data.s_max; i++) {
+        if (entries[i].neuron_index == pre.neuron_index &&
+                entries[i].pop_index == pre.pop_index &&
+                entries[i].sub_pop_index == pre.sub_pop_index) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//! \brief Determine, before the synaptic row is read, whether a rewiring
+//!     attempt might change it
+//! \param[in] current_state: The attempt
+//! \return Whether the row is worth reading
+static inline bool may_restructure(current_state_t *current_state) {
+    uint32_t pop_index = current_state->post_to_pre.pop_index;
+    if (current_state->element_exists) {
+        return synaptogenesis_elimination_may_eliminate(
+                current_state, elimination_params[pop_index]);
+    }
+
+    // Without replacement, a pair that is connected can't be connected again
+    if (!current_state->with_replacement && has_synapse_from(
+            current_state->post_syn_id, current_state->post_to_pre)) {
+        return false;
+    }
+    return synaptogenesis_formation_may_form(
+            current_state, formation_params[pop_index]);
+}
+#endif
+
 bool synaptogenesis_dynamics_rewire(
         uint32_t time, spike_t *spike, pop_table_lookup_result_t *result) {
 
@@ -224,6 +307,13 @@ bool synaptogenesis_dynamics_rewire(
     uint32_t post_id = rand_int(rewiring_data.app_no_atoms,
         rewiring_data.shared_seed);
 
+#if SYNAPTOGENESIS_ACTIVITY_GATED
+    // The neuron is still chosen above to keep in step with the other cores
+    if (!rewiring_active) {
+        return false;
+    }
+#endif
+
     // Check if neuron is in the current machine vertex
     if (post_id < rewiring_data.low_atom ||
             post_id > rewiring_data.high_atom) {
@@ -255,20 +345,6 @@ bool synaptogenesis_dynamics_rewire(
         m_pop_index = key_atom_info->m_pop_index;
     }
 
-    if (!population_table_get_first_address(*spike, result)) {
-        log_error("FAIL@key %d", *spike);
-        rt_error(RTE_SWERR);
-    }
-    uint32_t index = 0;
-    while (index < m_pop_index) {
-        if (!population_table_get_next_address(spike, result)) {
-            log_error("FAIL@key %d, index %d (failed at %d)",
-                    *spike, m_pop_index, index);
-            rt_error(RTE_SWERR);
-        }
-        index++;
-    }
-
     // Saving current state
     current_state_t *current_state = _alloc_state();
     current_state->pre_syn_id = neuron_id;
@@ -283,6 +359,29 @@ bool synaptogenesis_dynamics_rewire(
     current_state->local_seed = &rewiring_data.local_seed;
     current_state->post_low_atom = rewiring_data.low_atom;
     current_state->with_replacement = rewiring_data.with_replacement;
+
+#if SYNAPTOGENESIS_EARLY_REJECT
+    // Don't read the row if nothing can come of it
+    if (!may_restructure(current_state)) {
+        _free_state(current_state);
+        return false;
+    }
+#endif
+
+    if (!population_table_get_first_address(*spike, result)) {
+        log_error("FAIL@key %d", *spike);
+        rt_error(RTE_SWERR);
+    }
+    uint32_t index = 0;
+    while (index < m_pop_index) {
+        if (!population_table_get_next_address(spike, result)) {
+            log_error("FAIL@key %d, index %d (failed at %d)",
+                    *spike, m_pop_index, index);
+            rt_error(RTE_SWERR);
+        }
+        index++;
+    }
+
     _queue_state(current_state);
     return true;
 }
@@ -302,6 +401,9 @@ static bool do_formation(uint32_t time, synaptic_row_t restrict row,
 		structural_recording_values.value = record_value;
 		recording_record(rewiring_recording_index, &structural_recording_values,
 				sizeof(structural_recording_values_t));
+#if SYNAPTOGENESIS_EARLY_REJECT
+		n_free_elements[current_state->post_syn_id]--;
+#endif
 
 		return true;
 	}
@@ -341,6 +443,9 @@ static inline bool row_restructure(
             structural_recording_values.value = record_value;
             recording_record(rewiring_recording_index, &structural_recording_values,
                     sizeof(structural_recording_values_t));
+#if SYNAPTOGENESIS_EARLY_REJECT
+            n_free_elements[current_state->post_syn_id]++;
+#endif
 
             return true;
         } else {
@@ -381,17 +486,35 @@ bool synaptogenesis_row_restructure(uint32_t time, synaptic_row_t row) {
 }
 
 void synaptogenesis_spike_received(uint32_t time, spike_t spike) {
+#if SYNAPTOGENESIS_ACTIVITY_GATED
+    n_spikes_since_rewiring++;
+#endif
     partner_spike_received(time, spike);
 }
 
+#if SYNAPTOGENESIS_ACTIVITY_GATED
+//! \brief Note whether there has been activity since the rewiring was last
+//!     due, for the rewiring that is now due
+static inline void update_rewiring_active(void) {
+    rewiring_active = n_spikes_since_rewiring > 0;
+    n_spikes_since_rewiring = 0;
+}
+#endif
+
 uint32_t synaptogenesis_n_updates(void) {
     if (rewiring_data.fast) {
+#if SYNAPTOGENESIS_ACTIVITY_GATED
+        update_rewiring_active();
+#endif
         return rewiring_data.p_rew;
     }
 
     last_rewiring_time++;
     if (last_rewiring_time >= rewiring_data.p_rew) {
         last_rewiring_time = 0;
+#if SYNAPTOGENESIS_ACTIVITY_GATED
+        update_rewiring_active();
+#endif
         return 1;
     }
 
@@ -32,6 +32,7 @@
  * - synapse_row_fixed_region()
  * - synapse_row_num_fixed_synapses()
  * - synapse_row_num_plastic_controls()
+ * - synapse_row_format()
  * - synapse_row_plastic_controls()
  * - synapse_row_fixed_weight_controls()
  * - synapse_row_sparse_index()
@@ -73,7 +74,7 @@
  * in some learning-rule-specific format in the plastic region)
  * ```
  *   0:           [ F = Num fixed synapses                                    ]
- *   1:           [ P = Size of plastic region in HALF-WORDS                  ]
+ *   1:           [ Format flags (8 bits) | P = Num plastic controls (24 bits)]
  *   2:           [ First fixed synaptic word                                 ]
  *   ...
  * F+1:           [ Last fixed synaptic word                                  ]
@@ -83,6 +84,64 @@
  * ```
  * Note that \p P is effectively rounded up to a multiple of two for storage
  * purposes.
+ *
+ * The format flags (::synapse_row_format_flags) describe properties of the
+ * fixed synapses that allow them to be processed by a specialised handler;
+ * rows with no flags are processed word by word.  A row of a plastic
+ * projection has the ::SYNAPSE_ROW_PLASTIC_ONLY flag, as its fixed-fixed
+ * region is always empty, so it is processed without a pass over the fixed
+ * synapses.
+ *
+ * \section dense Dense Fixed Region
+ *
+ * If the ::SYNAPSE_ROW_DENSE flag is set, the F fixed words instead hold a
+ * header word followed by one 16-bit weight for each of the first W neurons
+ * of the core, where a weight of 0 means there is no synapse:
+ * ```
+ *   2:           [ W = Num weights (16 bits) | Delay | Type | Index = 0      ]
+ *   3:           [ Weight of neuron 1              | Weight of neuron 0      ]
+ *   ...
+ * F+1:           [ Weight of neuron W-1 (or 0)     | Weight of neuron W-2    ]
+ * ```
+ * All the synapses of a dense row share the delay and type of the header.
+ *
+ * \section byte_targets Byte Target Fixed Region
+ *
+ * If the ::SYNAPSE_ROW_BYTE_TARGETS flag is set, all the synapses of the row
+ * have the same weight, and the delay, type and index of each fit in the
+ * bottom 8 bits of a synaptic word, so the F fixed words instead hold a
+ * header word followed by these 8 bits of each of the N synapses:
+ * ```
+ *   2:           [ Weight (16 bits)      | N = Num synapses (16 bits)        ]
+ *   3:           [ Target 3    | Target 2    | Target 1    | Target 0        ]
+ *   ...
+ * F+1:           [ Target N-1 (or 0 if beyond the last) | ...               ]
+ * ```
+ *
+ * \section shared_weight Shared Weight Fixed Region
+ *
+ * If the ::SYNAPSE_ROW_SHARED_WEIGHT flag is set, all the synapses of the row
+ * have the same weight, delay and type, so the F fixed words instead hold a
+ * header word with these, the number of synapses, and then the 16-bit index
+ * of the target neuron of each synapse:
+ * ```
+ *   2:           [ Weight (16 bits)      | Delay | Type | Index = 0          ]
+ *   3:           [ N = Num synapses                                          ]
+ *   4:           [ Index of target 1             | Index of target 0         ]
+ *   ...
+ * F+1:           [ Index of target N-1 (or 0)    | Index of target N-2       ]
+ * ```
+ *
+ * \section write_back Write Back
+ *
+ * Only the plastic region changes when a row is processed, so only the
+ * plastic region (the pre-synaptic history and the plastic weights) is
+ * written back to SDRAM, and only as far as the last synapse that changed
+ * (see synapse_dynamics_get_plastic_words_changed()); the plastic control
+ * words stay in the fixed region and are never written.  This is why the weights and control words of the
+ * plastic synapses are kept apart rather than stored in pairs: a DMA can
+ * only transfer one contiguous block, so pairs would mean writing back the
+ * control words as well.
  */
 
 #ifndef _SYNAPSE_ROW_H_
@@ -105,6 +164,33 @@ typedef __uint_t(SYNAPSE_WEIGHT_BITS) weight_t;
 //! Define the type of the control data
 typedef uint16_t control_t;
 
+//! \brief Whether the ring buffers accumulate in 32 bits rather than in the
+//!     width of a weight; this costs twice the DTCM per entry but means that
+//!     populations with a very high fan-in need not saturate or lose
+//!     precision to a large ring buffer shift
+#ifndef RING_BUFFER_32_BIT
+#define RING_BUFFER_32_BIT 0
+#endif
+
+#if RING_BUFFER_32_BIT
+//! The type of a ring buffer entry
+typedef uint32_t ring_buffer_t;
+//! The largest value a ring buffer entry can hold
+#define RING_BUFFER_MAX UINT32_MAX
+#else
+//! The type of a ring buffer entry
+typedef uint16_t ring_buffer_t;
+//! The largest value a ring buffer entry can hold
+#define RING_BUFFER_MAX 0xFFFF
+#endif
+
+//! \brief Whether the ring buffers of a delay slot hold exactly as many
+//!     entries per synapse type as there are neurons, rather than the next
+//!     power of two, so that more neurons or delay slots fit in DTCM
+#ifndef COMPACT_RING_BUFFERS
+#define COMPACT_RING_BUFFERS 0
+#endif
+
 //! Number of header words per synaptic row
 #define N_SYNAPSE_ROW_HEADER_WORDS 3
 
@@ -117,10 +203,42 @@ typedef struct {
 //! The type of the fixed part of the row. The fixed-plastic part follows.
 typedef struct {
     size_t num_fixed;           //!< The number of fixed synapses in `data`
-    size_t num_plastic;         //!< The number of plastic controls in `data`
+    uint32_t num_plastic: 24;   //!< The number of plastic controls in `data`
+    uint32_t format: 8;         //!< The ::synapse_row_format_flags of the row
     uint32_t data[];            //!< The data, first the fixed then the plastic
 } synapse_row_fixed_part_t;
 
+//! The shift of the format flags within the fixed-plastic size word
+#define SYNAPSE_ROW_FORMAT_SHIFT 24
+
+//! Flags describing the fixed synapses of a row
+typedef enum synapse_row_format_flags {
+    //! All the fixed synapses in the row have the same delay
+    SYNAPSE_ROW_SINGLE_DELAY = 0x1,
+    //! All the fixed synapses in the row have the same synapse type
+    SYNAPSE_ROW_SINGLE_TYPE = 0x2,
+    //! The fixed synapses are stored as a header and a weight per neuron
+    SYNAPSE_ROW_DENSE = 0x4,
+    //! The fixed synapses are in increasing order of delay, with a delay of
+    //! 0 (which represents the maximum delay) last
+    SYNAPSE_ROW_DELAY_SORTED = 0x8,
+    //! The fixed synapses are stored as a header with a weight shared by all
+    //! of them and a byte with the delay, type and index of each
+    SYNAPSE_ROW_BYTE_TARGETS = 0x10,
+    //! The fixed synapses are stored as a header with the weight, delay and
+    //! type shared by all of them and the index of the target of each
+    SYNAPSE_ROW_SHARED_WEIGHT = 0x20,
+    //! The row has only plastic synapses, so there are no fixed synapses to
+    //! process
+    SYNAPSE_ROW_PLASTIC_ONLY = 0x40
+} synapse_row_format_flags;
+
+//! The shift of the number of weights within the header of a dense row
+#define SYNAPSE_ROW_DENSE_N_WEIGHTS_SHIFT 16
+
+//! The mask of the number of synapses within the header of a byte target row
+#define SYNAPSE_ROW_BYTE_TARGETS_N_MASK 0xFFFF
+
 typedef struct synapse_row_plastic_data_t synapse_row_plastic_data_t;
 
 //! \brief Get the size of the plastic region
@@ -141,6 +259,17 @@ static inline synapse_row_plastic_data_t *synapse_row_plastic_region(
     return (synapse_row_plastic_data_t *) the_row->data;
 }
 
+//! \brief Get the number of words from the start of a plastic region up to
+//!     a point within it
+//! \param[in] plastic_region: The plastic region of the row
+//! \param[in] end: The point after the last byte to count
+//! \return The number of words, rounded up
+static inline uint32_t synapse_row_plastic_words_to(
+        const synapse_row_plastic_data_t *plastic_region, const void *end) {
+    return ((const uint8_t *) end - (const uint8_t *) plastic_region
+            + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+}
+
 //! \brief Get the address of the non-plastic (or fixed) region
 //! \param[in] row: The synaptic row
 //! \return Address of the fixed region of the row
@@ -166,6 +295,14 @@ static inline size_t synapse_row_num_plastic_controls(
     return fixed->num_plastic;
 }
 
+//! \brief Get the format flags of the fixed synapses in the row
+//! \param[in] fixed: The fixed region of the synaptic row
+//! \return The ::synapse_row_format_flags of the row
+static inline uint32_t synapse_row_format(
+        const synapse_row_fixed_part_t *fixed) {
+    return fixed->format;
+}
+
 //! \brief Get the array of plastic controls in the row
 //! \param[in] fixed: The fixed region of the synaptic row
 //! \return Address of the fixed-plastic region of the row
@@ -247,6 +384,76 @@ static inline input_t synapse_row_convert_weight_to_input(
     return converter.output_type;
 }
 
+//! \brief Converts an accumulated ring buffer entry to an input
+//! \param[in] value: the ring buffer entry to convert
+//! \param[in] left_shift: the shift to use when decoding
+//! \return the actual input for the model
+static inline input_t synapse_row_convert_ring_buffer_to_input(
+        ring_buffer_t value, uint32_t left_shift) {
+#if RING_BUFFER_32_BIT
+    // A wide entry can overflow the input once shifted, so clamp it to the
+    // largest input that can be represented instead
+    if (value > ((uint32_t) INT32_MAX >> left_shift)) {
+        value = (uint32_t) INT32_MAX >> left_shift;
+    }
+    union {
+        int_k_t input_type;
+        s1615 output_type;
+    } converter;
+
+    converter.input_type = (int_k_t) (value) << left_shift;
+
+    return converter.output_type;
+#else
+    return synapse_row_convert_weight_to_input(value, left_shift);
+#endif
+}
+
+//! \brief Add a weight to a ring buffer entry, saturating at
+//!     ::RING_BUFFER_MAX
+//! \param[in,out] entry: The ring buffer entry to add to
+//! \param[in] weight: The weight to add
+//! \return Whether the entry saturated
+static inline bool synapse_row_ring_buffer_add(
+        ring_buffer_t *entry, uint32_t weight) {
+    uint32_t accumulation = *entry + weight;
+#if RING_BUFFER_32_BIT
+    // The sum has wrapped if it is smaller than what was added
+    if (accumulation < weight) {
+#else
+    if (accumulation & ~RING_BUFFER_MAX) {
+#endif
+        *entry = RING_BUFFER_MAX;
+        return true;
+    }
+    *entry = accumulation;
+    return false;
+}
+
+//! \brief Add two pairs of 16-bit values held in words, saturating each at
+//!     UINT16_MAX.
+//! \details The ARM968 has no UQADD16, so the lanes are added with the top
+//!     bit of each held back so that a carry out of the lower lane can't reach
+//!     the upper one; the carries out of the lanes are then worked out from
+//!     the top bits.
+//! \param[in] a: The values added to, such as a pair of ring buffer entries
+//! \param[in] b: The values to add
+//! \param[in,out] n_saturated: Counts the values that saturated, if not NULL
+//! \return The saturated sums
+static inline uint32_t synapse_row_packed_add_saturate(
+        uint32_t a, uint32_t b, uint32_t *n_saturated) {
+    uint32_t sum = (a & 0x7FFF7FFF) + (b & 0x7FFF7FFF);
+    uint32_t carry = ((a & b) | ((a | b) & sum)) & 0x80008000;
+    sum ^= (a ^ b) & 0x80008000;
+    if (carry) {
+        if (n_saturated != NULL) {
+            *n_saturated += ((carry >> 15) & 0x1) + (carry >> 31);
+        }
+        sum |= (carry >> 15) * 0xFFFF;
+    }
+    return sum;
+}
+
 //! \brief Get the index of the ring buffer for a given timestep, synapse type
 //!     and neuron index
 //! \param[in] simulation_timestep: The timestep
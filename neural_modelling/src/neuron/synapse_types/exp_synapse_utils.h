@@ -55,12 +55,33 @@ static inline void decay_and_init(exp_state_t *state, exp_params_t *params,
 	state->synaptic_input_value = params->init_input;
 }
 
+//! \brief Shapes a single parameter with a given decay
+//! \param[in,out] exp_param: The parameter to shape
+//! \param[in] decay: The decay to use, which is the decay of the parameter
+//!     or one that it shares with others
+static inline void exp_shaping_by(exp_state_t *exp_param, decay_t decay) {
+	exp_param->synaptic_input_value =
+			decay_s1615(exp_param->synaptic_input_value, decay);
+}
+
 //! \brief Shapes a single parameter
 //! \param[in,out] exp_param: The parameter to shape
 static inline void exp_shaping(exp_state_t *exp_param) {
     // decay value according to decay constant
-	exp_param->synaptic_input_value =
-			decay_s1615(exp_param->synaptic_input_value, exp_param->decay);
+	exp_shaping_by(exp_param, exp_param->decay);
+}
+
+//! \brief Zero a parameter that has decayed to within epsilon of zero
+//! \param[in,out] exp_param: The parameter to settle
+//! \param[in] epsilon: How close to zero the parameter must be
+//! \return True if the parameter is now zero
+static inline bool exp_settle(exp_state_t *exp_param, input_t epsilon) {
+    input_t value = exp_param->synaptic_input_value;
+    if (REAL_COMPARE(value, >, epsilon) || REAL_COMPARE(value, <, -epsilon)) {
+        return false;
+    }
+    exp_param->synaptic_input_value = ZERO;
+    return true;
 }
 
 //! \brief helper function to add input for a given timer period to a given
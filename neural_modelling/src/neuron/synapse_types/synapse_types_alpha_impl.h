@@ -41,6 +41,18 @@
 #include <debug.h>
 #include "synapse_types.h"
 
+#ifndef SYNAPSE_ALPHA_EXACT
+//! \brief Whether to shape the input with the exact propagators of the two
+//!     states of an alpha synapse, rather than with separate linear and
+//!     exponential terms
+//! \details The state is then a rising term, which input adds to, and the
+//!     current itself; each shaping step is two multiply-accumulates per
+//!     receptor.  The current is the same as the linear and exponential terms
+//!     give after a single input, and exact after several.  The state is saved
+//!     as an exponential term of 1, with the current in the linear term.
+#define SYNAPSE_ALPHA_EXACT 0
+#endif
+
 //---------------------------------------
 // Synapse parameters
 //---------------------------------------
@@ -58,6 +70,18 @@ struct synapse_types_params_t {
 	REAL time_step_ms;
 };
 
+#if SYNAPSE_ALPHA_EXACT
+//! Internal structure of an alpha-shaped synaptic input, as two states
+typedef struct alpha_state_t {
+    input_t rise;               //!< The rising term, which input adds to
+    input_t current;            //!< The alpha-shaped current
+    decay_t decay;              //!< exp(-d<i>t</i> / _&tau;_)
+    //! d<i>t</i> exp(-d<i>t</i> / _&tau;_), the propagator from rise to current
+    input_t rise_to_current;
+    //! _&tau;_<sup>-2</sup>, the scale of the input into the rising term
+    input_t inv_tau_sqr;
+} alpha_state_t;
+#else
 //! Internal structure of an alpha-shaped synaptic input
 typedef struct alpha_state_t {
     input_t lin_buff;           //!< buffer for linear term
@@ -67,6 +91,7 @@ typedef struct alpha_state_t {
     decay_t decay;              //!< Exponential decay multiplier
     input_t q_buff;             //!< Temporary value of input
 } alpha_state_t;
+#endif // SYNAPSE_ALPHA_EXACT
 
 struct synapse_types_t {
 	alpha_state_t exc;         //!< Excitatory synaptic input
@@ -83,6 +108,27 @@ typedef enum {
 // Synapse shaping inline implementation
 //---------------------------------------
 
+#if SYNAPSE_ALPHA_EXACT
+static inline void get_alpha_state(alpha_state_t *state, alpha_params_t *params,
+		REAL time_step_ms, uint32_t n_steps_per_timestep) {
+	REAL ts = kdivui(time_step_ms, n_steps_per_timestep);
+	decay_t decay = expulr(-kdivk(ts, params->tau));
+	state->decay = decay;
+	state->rise_to_current = decay_s1615(ts, decay);
+	state->inv_tau_sqr = kdivk(ONE, params->tau * params->tau);
+	// The linear term grows by q / tau^2 each unit of time, and the
+	// exponential term scales both it and the current
+	state->current = params->lin_init * params->exp_init;
+	state->rise = params->q_init * params->exp_init * state->inv_tau_sqr;
+}
+
+static inline void save_alpha_state(
+		alpha_state_t *state, alpha_params_t *params) {
+	params->lin_init = state->current;
+	params->exp_init = ONE;
+	params->q_init = kdivk(state->rise, state->inv_tau_sqr);
+}
+#else
 static inline void get_alpha_state(alpha_state_t *state, alpha_params_t *params,
 		REAL time_step_ms, uint32_t n_steps_per_timestep) {
 	REAL ts = kdivui(time_step_ms, n_steps_per_timestep);
@@ -95,6 +141,14 @@ static inline void get_alpha_state(alpha_state_t *state, alpha_params_t *params,
 	state->decay = decay;
 }
 
+static inline void save_alpha_state(
+		alpha_state_t *state, alpha_params_t *params) {
+	params->lin_init = state->lin_buff;
+	params->exp_init = state->exp_buff;
+	params->q_init = state->q_buff;
+}
+#endif // SYNAPSE_ALPHA_EXACT
+
 static inline void synapse_types_initialise(synapse_types_t *state,
 		synapse_types_params_t *params, uint32_t n_steps_per_timestep) {
 	get_alpha_state(&state->exc, &params->exc, params->time_step_ms, n_steps_per_timestep);
@@ -102,14 +156,35 @@ static inline void synapse_types_initialise(synapse_types_t *state,
 }
 
 static void synapse_types_save_state(synapse_types_t *state, synapse_types_params_t *params) {
-	params->exc.lin_init = state->exc.lin_buff;
-	params->exc.exp_init = state->exc.exp_buff;
-	params->exc.q_init = state->exc.q_buff;
-	params->inh.lin_init = state->inh.lin_buff;
-	params->inh.exp_init = state->inh.exp_buff;
-	params->inh.q_init = state->inh.q_buff;
+	save_alpha_state(&state->exc, &params->exc);
+	save_alpha_state(&state->inh, &params->inh);
+}
+
+#if SYNAPSE_ALPHA_EXACT
+//! \brief Applies alpha shaping to a parameter with given propagators
+//! \param[in,out] a_params: The parameter to shape
+//! \param[in] decay: The decay of both states
+//! \param[in] rise_to_current: The propagator from the rise to the current
+static inline void alpha_shaping_by(alpha_state_t *a_params, decay_t decay,
+		input_t rise_to_current) {
+    a_params->current = decay_s1615(a_params->current, decay)
+            + a_params->rise * rise_to_current;
+    a_params->rise = decay_s1615(a_params->rise, decay);
+}
+
+//! \brief Applies alpha shaping to a parameter
+//! \param[in,out] a_params: The parameter to shape
+static inline void alpha_shaping(alpha_state_t* a_params) {
+    alpha_shaping_by(a_params, a_params->decay, a_params->rise_to_current);
 }
 
+//! \brief Gets the current of an alpha-shaped input
+//! \param[in] a_params: The parameter
+//! \return The current
+static inline input_t alpha_response(const alpha_state_t *a_params) {
+    return a_params->current;
+}
+#else
 //! \brief Applies alpha shaping to a parameter
 //! \param[in,out] a_params: The parameter to shape
 static inline void alpha_shaping(alpha_state_t* a_params) {
@@ -120,6 +195,14 @@ static inline void alpha_shaping(alpha_state_t* a_params) {
     a_params->exp_buff = decay_s1615(a_params->exp_buff, a_params->decay);
 }
 
+//! \brief Gets the current of an alpha-shaped input
+//! \param[in] a_params: The parameter
+//! \return The current
+static inline input_t alpha_response(const alpha_state_t *a_params) {
+    return a_params->lin_buff * a_params->exp_buff;
+}
+#endif // SYNAPSE_ALPHA_EXACT
+
 //! \brief decays the stuff thats sitting in the input buffers as these have not
 //!     yet been processed and applied to the neuron.
 //!
@@ -134,11 +217,77 @@ static inline void synapse_types_shape_input(
     alpha_shaping(&parameters->inh);
 }
 
+#if SYNAPSE_ALPHA_EXACT
+//! The synapses of all neurons can be shaped in one pass; see
+//! synapse_types_shape_all()
+#define SYNAPSE_TYPES_CAN_SHAPE_ALL
+
+//! \brief The propagators of the receptors, when all the neurons have the
+//!     same time constants
+static struct {
+    bool shared;                //!< Whether all the neurons share them
+    decay_t exc_decay;          //!< The decay of the excitatory input
+    input_t exc_rise;           //!< The excitatory rise to current propagator
+    decay_t inh_decay;          //!< The decay of the inhibitory input
+    input_t inh_rise;           //!< The inhibitory rise to current propagator
+} shared_decay UNUSED;
+
+//! \brief Find whether all the neurons have the same propagators, so that
+//!     synapse_types_shape_all() can keep them out of the per-neuron state
+//! \param[in] states: The synapse states of all the neurons
+//! \param[in] n_neurons: The number of neurons
+static inline void synapse_types_find_shared_decay(
+        const synapse_types_t *states, uint32_t n_neurons) {
+    shared_decay.shared = n_neurons > 0;
+    if (!shared_decay.shared) {
+        return;
+    }
+    shared_decay.exc_decay = states[0].exc.decay;
+    shared_decay.exc_rise = states[0].exc.rise_to_current;
+    shared_decay.inh_decay = states[0].inh.decay;
+    shared_decay.inh_rise = states[0].inh.rise_to_current;
+    for (uint32_t n = 1; n < n_neurons; n++) {
+        if (states[n].exc.decay != shared_decay.exc_decay
+                || states[n].exc.rise_to_current != shared_decay.exc_rise
+                || states[n].inh.decay != shared_decay.inh_decay
+                || states[n].inh.rise_to_current != shared_decay.inh_rise) {
+            shared_decay.shared = false;
+            return;
+        }
+    }
+}
+
+//! \brief Shape the inputs of all the neurons, propagating all the receptors
+//!     of each neuron in turn; the same as synapse_types_shape_input() on each
+//! \param[in,out] states: The synapse states of all the neurons
+//! \param[in] n_neurons: The number of neurons
+static inline void synapse_types_shape_all(
+        synapse_types_t *states, uint32_t n_neurons) {
+    if (!shared_decay.shared) {
+        for (uint32_t n = 0; n < n_neurons; n++) {
+            synapse_types_shape_input(&states[n]);
+        }
+        return;
+    }
+    decay_t exc_decay = shared_decay.exc_decay;
+    input_t exc_rise = shared_decay.exc_rise;
+    decay_t inh_decay = shared_decay.inh_decay;
+    input_t inh_rise = shared_decay.inh_rise;
+    for (uint32_t n = 0; n < n_neurons; n++) {
+        alpha_shaping_by(&states[n].exc, exc_decay, exc_rise);
+        alpha_shaping_by(&states[n].inh, inh_decay, inh_rise);
+    }
+}
+#endif // SYNAPSE_ALPHA_EXACT
+
 //! \brief helper function to add input for a given timer period to a given
 //!     neuron
 //! \param[in] a_params: the parameter to update
 //! \param[in] input: the input to add.
 static inline void add_input_alpha(alpha_state_t *a_params, input_t input) {
+#if SYNAPSE_ALPHA_EXACT
+    a_params->rise += input * a_params->inv_tau_sqr;
+#else
     a_params->q_buff = input;
 
 	a_params->exp_buff =
@@ -147,6 +296,7 @@ static inline void add_input_alpha(alpha_state_t *a_params, input_t input) {
     a_params->lin_buff =
             (a_params->lin_buff + (input * a_params->dt_divided_by_tau_sqr))
             * (ONE - kdivk(ONE, a_params->exp_buff));
+#endif // SYNAPSE_ALPHA_EXACT
 }
 
 //! \brief adds the inputs for a give timer period to a given neuron that is
@@ -180,7 +330,7 @@ static inline void synapse_types_add_neuron_input(
 static inline input_t* synapse_types_get_excitatory_input(
         input_t *excitatory_response, synapse_types_t *parameters) {
     excitatory_response[0] =
-            parameters->exc.lin_buff * parameters->exc.exp_buff;
+            alpha_response(&parameters->exc);
     return &excitatory_response[0];
 }
 
@@ -192,7 +342,7 @@ static inline input_t* synapse_types_get_excitatory_input(
 static inline input_t* synapse_types_get_inhibitory_input(
         input_t *inhibitory_response, synapse_types_t *parameters) {
     inhibitory_response[0] =
-            parameters->inh.lin_buff * parameters->inh.exp_buff;
+            alpha_response(&parameters->inh);
     return &inhibitory_response[0];
 }
 
@@ -222,8 +372,8 @@ static inline const char *synapse_types_get_type_char(
 static inline void synapse_types_print_input(
         synapse_types_t *parameters) {
     io_printf(IO_BUF, "%12.6k - %12.6k",
-            parameters->exc.lin_buff * parameters->exc.exp_buff,
-            parameters->inh.lin_buff * parameters->inh.exp_buff);
+            alpha_response(&parameters->exc),
+            alpha_response(&parameters->inh));
 }
 
 //! \brief prints the parameters of the synapse type
@@ -231,9 +381,9 @@ static inline void synapse_types_print_input(
 static inline void synapse_types_print_parameters(synapse_types_t *parameters) {
     log_debug("-------------------------------------\n");
     log_debug("exc_response  = %11.4k\n",
-            parameters->exc.lin_buff * parameters->exc.exp_buff);
+            alpha_response(&parameters->exc));
     log_debug("inh_response  = %11.4k\n",
-            parameters->inh.lin_buff * parameters->inh.exp_buff);
+            alpha_response(&parameters->inh));
 }
 
 #endif // _ALPHA_SYNAPSE_H_
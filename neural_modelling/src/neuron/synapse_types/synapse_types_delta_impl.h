@@ -94,6 +94,20 @@ static inline void synapse_types_shape_input(
 	parameters->inh = ZERO;
 }
 
+//! Delta synapses can be settled; see synapse_types_settle()
+#define SYNAPSE_TYPES_CAN_SETTLE
+
+//! \brief Determine if the inputs are zero, after which shaping leaves them
+//!     unchanged until more input arrives
+//! \details Shaping always zeroes delta inputs, so this holds after shaping.
+//! \param[in] parameters: the parameters to check
+//! \param[in] epsilon: Not used
+//! \return True if the inputs are all zero
+static inline bool synapse_types_settle(
+        synapse_types_t *parameters, UNUSED input_t epsilon) {
+    return bitsk(parameters->exc) == 0 && bitsk(parameters->inh) == 0;
+}
+
 //! \brief adds the inputs for a give timer period to a given neuron that is
 //!     being simulated by this model
 //! \param[in] synapse_type_index the type of input that this input is to be
@@ -100,6 +100,64 @@ static inline void synapse_types_shape_input(synapse_types_t *parameters) {
 	exp_shaping(&parameters->inh);
 }
 
+//! The synapses of all neurons can be shaped in one pass; see
+//! synapse_types_shape_all()
+#define SYNAPSE_TYPES_CAN_SHAPE_ALL
+
+//! \brief The decays of the receptors, when all the neurons have the same
+//!     time constants
+static struct {
+    bool shared;        //!< Whether all the neurons have the same decays
+    decay_t exc;        //!< The decay of the first excitatory input
+    decay_t exc2;       //!< The decay of the second excitatory input
+    decay_t inh;        //!< The decay of the inhibitory input
+} shared_decay UNUSED;
+
+//! \brief Find whether all the neurons have the same decays, so that
+//!     synapse_types_shape_all() can keep them out of the per-neuron state
+//! \param[in] states: The synapse states of all the neurons
+//! \param[in] n_neurons: The number of neurons
+static inline void synapse_types_find_shared_decay(
+        const synapse_types_t *states, uint32_t n_neurons) {
+    shared_decay.shared = n_neurons > 0;
+    if (!shared_decay.shared) {
+        return;
+    }
+    shared_decay.exc = states[0].exc.decay;
+    shared_decay.exc2 = states[0].exc2.decay;
+    shared_decay.inh = states[0].inh.decay;
+    for (uint32_t n = 1; n < n_neurons; n++) {
+        if (states[n].exc.decay != shared_decay.exc
+                || states[n].exc2.decay != shared_decay.exc2
+                || states[n].inh.decay != shared_decay.inh) {
+            shared_decay.shared = false;
+            return;
+        }
+    }
+}
+
+//! \brief Shape the inputs of all the neurons, decaying all the receptors of
+//!     each neuron in turn; the same as synapse_types_shape_input() on each
+//! \param[in,out] states: The synapse states of all the neurons
+//! \param[in] n_neurons: The number of neurons
+static inline void synapse_types_shape_all(
+        synapse_types_t *states, uint32_t n_neurons) {
+    if (!shared_decay.shared) {
+        for (uint32_t n = 0; n < n_neurons; n++) {
+            synapse_types_shape_input(&states[n]);
+        }
+        return;
+    }
+    decay_t exc_decay = shared_decay.exc;
+    decay_t exc2_decay = shared_decay.exc2;
+    decay_t inh_decay = shared_decay.inh;
+    for (uint32_t n = 0; n < n_neurons; n++) {
+        exp_shaping_by(&states[n].exc, exc_decay);
+        exp_shaping_by(&states[n].exc2, exc2_decay);
+        exp_shaping_by(&states[n].inh, inh_decay);
+    }
+}
+
 //! \brief adds the inputs for a give timer period to a given neuron that is
 //!     being simulated by this model
 //! \param[in] synapse_type_index: the type of input that this input is to be
@@ -30,6 +30,40 @@
 #include "profile_tags.h"
 #endif //PROFILER_ENABLED
 
+#ifndef PACKED_FIXED_SYNAPSES
+//! \brief Whether to add pairs of weights to adjacent ring buffer entries
+//!     together
+#define PACKED_FIXED_SYNAPSES 0
+#endif
+
+#if PACKED_FIXED_SYNAPSES
+#if SYNAPSE_WEIGHT_BITS != 16 || defined(SYNAPSE_WEIGHTS_SIGNED)
+#error "PACKED_FIXED_SYNAPSES needs unsigned 16-bit weights"
+#endif
+#if RING_BUFFER_32_BIT
+#error "PACKED_FIXED_SYNAPSES needs 16-bit ring buffers"
+#endif
+#endif
+
+#if COMPACT_RING_BUFFERS
+uint32_t *synapse_ring_buffer_bases;
+#endif
+
+#ifndef SYNAPSE_DELAY_WHEEL
+//! \brief Whether synapses with delays too long for the ring buffers can be
+//!     added into a ring buffer in SDRAM instead
+#define SYNAPSE_DELAY_WHEEL 0
+#endif
+
+//! A word holding two adjacent ring buffer entries
+typedef uint32_t __attribute__((__may_alias__)) packed_weights_t;
+
+//! The number of delay wheel entries in a word
+#define WEIGHTS_PER_WORD (sizeof(uint32_t) / sizeof(weight_t))
+
+//! The number of ring buffer entries in a word
+#define ENTRIES_PER_WORD (sizeof(uint32_t) / sizeof(ring_buffer_t))
+
 //! Globals required for synapse benchmarking to work.
 uint32_t  num_fixed_pre_synaptic_events = 0;
 
@@ -40,7 +74,7 @@ static uint32_t n_neurons;
 static uint32_t n_synapse_types;
 
 //! Ring buffers to handle delays between synapses and neurons
-static weight_t *ring_buffers;
+static ring_buffer_t *ring_buffers;
 
 //! Ring buffer size
 static uint32_t ring_buffer_size;
@@ -89,12 +123,57 @@ uint32_t late_spikes = 0;
 //! The maximum lateness of a spike
 uint32_t max_late_spike = 0;
 
-//! Number of neurons
+//! The number of rows processed by how many time steps late the spike was
+uint32_t lateness_histogram[N_LATENESS_BINS];
+
+//! The number of ring buffer entries of each synapse type in a delay slot
 static uint32_t n_neurons_peak;
 
-//! The mask of the delay shifted into position i.e. pre-shift
+//! \brief The mask of the delay of a synaptic word shifted into position
+//!     i.e. pre-shift; this can have more bits than ::synapse_delay_mask if
+//!     there is a delay wheel
 static uint32_t synapse_delay_mask_shifted = 0;
 
+//! \brief The mask of the delay of a synaptic word, which can have more bits
+//!     than ::synapse_delay_mask if there is a delay wheel
+static uint32_t synapse_row_delay_mask = 0;
+
+#if SYNAPSE_DELAY_WHEEL
+//! \brief The ring buffers in SDRAM for the synapses with delays too long
+//!     for ::ring_buffers, indexed like those but with all the delay bits of
+//!     a synaptic word; NULL if there are no such delays
+static weight_t *delay_wheel = NULL;
+
+//! The mask of the whole index into ::delay_wheel
+static uint32_t delay_wheel_mask = 0;
+
+//! \brief The bits of the delay of a synaptic word, shifted into position,
+//!     that mean the synapse goes into ::delay_wheel
+static uint32_t long_delay_mask_shifted = 0;
+
+//! The time to add to a synaptic word to index ::delay_wheel for this row
+static uint32_t delay_wheel_time = 0;
+
+//! \brief Add a weight to the delay wheel
+//! \param[in] index: The index in the delay wheel
+//! \param[in] weight: The weight to add
+static inline void add_to_delay_wheel(uint32_t index, uint32_t weight) {
+    uint32_t accumulation = delay_wheel[index] + weight;
+    if (accumulation & 0xFFFF0000) {
+        accumulation = 0xFFFF;
+        synapses_saturation_count++;
+    }
+    delay_wheel[index] = accumulation;
+}
+#endif
+
+#if PACKED_FIXED_SYNAPSES
+//! \brief The bits of a synaptic word that must differ by one for two
+//!     synapses to go to the same packed ring buffer word; 0 if there are no
+//!     index bits, so pairs can't be formed
+static uint32_t packed_pair_mask = 0;
+#endif
+
 
 /* PRIVATE FUNCTIONS */
 
@@ -113,7 +192,8 @@ static inline const char *get_type_char(uint32_t synapse_type) {
 //! \param[in] synaptic_row: The synaptic row to print
 static inline void print_synaptic_row(synaptic_row_t synaptic_row) {
     log_debug("Synaptic row, at address %08x, Num plastic words:%u",
-            (uint32_t) synaptic_row, synapse_row_plastic_size(synaptic_row));
+            (uint32_t) (uintptr_t) synaptic_row,
+            synapse_row_plastic_size(synaptic_row));
     if (synaptic_row == NULL) {
         return;
     }
@@ -171,9 +251,11 @@ static inline void print_ring_buffers(uint32_t time) {
         for (uint32_t t = 0; t < n_synapse_types; t++) {
             // Determine if this row can be omitted
             for (uint32_t d = 0; d < n_delay_bits; d++) {
-                if (ring_buffers[synapse_row_get_ring_buffer_index(
-                        d + time, t, n, synapse_type_index_bits,
-                        synapse_index_bits, synapse_delay_mask)] != 0) {
+                uint32_t ring_buffer_index = synapses_ring_buffer_entry(
+                        synapse_row_get_ring_buffer_index(
+                                d + time, t, n, synapse_type_index_bits,
+                                synapse_index_bits, synapse_delay_mask));
+                if (ring_buffers[ring_buffer_index] != 0) {
                     goto doPrint;
                 }
             }
@@ -183,9 +265,10 @@ static inline void print_ring_buffers(uint32_t time) {
             io_printf(IO_BUF, "%3d(%s):", n, get_type_char(t));
             for (uint32_t d = 0; d < n_delay_bits; d++) {
                 io_printf(IO_BUF, " ");
-                uint32_t ring_buffer_index = synapse_row_get_ring_buffer_index(
-                        d + time, t, n, synapse_type_index_bits,
-                        synapse_index_bits, synapse_delay_mask);
+                uint32_t ring_buffer_index = synapses_ring_buffer_entry(
+                        synapse_row_get_ring_buffer_index(
+                                d + time, t, n, synapse_type_index_bits,
+                                synapse_index_bits, synapse_delay_mask));
                 synapses_print_weight(ring_buffers[ring_buffer_index],
                         ring_buffer_to_input_left_shifts[t]);
             }
@@ -197,57 +280,326 @@ static inline void print_ring_buffers(uint32_t time) {
 }
 
 
+//! \brief Test whether a synapse has a delay that is too small for a spike
+//!     that arrived late.
+//! \param[in] synaptic_word: The synaptic word
+//! \param[in] colour_delay_shifted: The lateness of the spike, shifted into
+//!     the delay position of the word
+//! \return Whether the synapse should be skipped
+static inline bool delay_too_small(
+        uint32_t synaptic_word, uint32_t colour_delay_shifted) {
+    // If the (shifted) delay is non zero and too small, skip
+    return ((synaptic_word & synapse_delay_mask_shifted) != 0) &&
+            ((synaptic_word & synapse_delay_mask_shifted) <= colour_delay_shifted);
+}
+
 //! \brief The "inner loop" of the neural simulation.
 //! \details Every spike event could cause up to 256 different weights to
-//!     be put into the ring buffer.
-//! \param[in] fixed_region: The fixed region of the synaptic matrix
-//! \param[in] time: The current simulation time
-//! \return Always true
-static inline bool process_fixed_synapses(
-        synapse_row_fixed_part_t *fixed_region, uint32_t time,
-        uint32_t colour_delay) {
-    uint32_t *synaptic_words = synapse_row_fixed_weight_controls(fixed_region);
-    uint32_t fixed_synapse = synapse_row_num_fixed_synapses(fixed_region);
-
-    num_fixed_pre_synaptic_events += fixed_synapse;
-
-    // Pre-mask the time and account for colour delay
-    uint32_t colour_delay_shifted = colour_delay << synapse_type_index_bits;
-    uint32_t masked_time = ((time - colour_delay) & synapse_delay_mask) << synapse_type_index_bits;
-    uint32_t sat_flag = 0xFFFF0000;
-    uint32_t sat_value = 0xFFFF;
-
+//!     be put into the ring buffer.  This is inlined with constant
+//!     \p check_delays so that the loop for rows with a single delay doesn't
+//!     test each synapse.
+//! \param[in] synaptic_words: The fixed synaptic words to process
+//! \param[in] fixed_synapse: The number of synaptic words
+//! \param[in] masked_time: The time to add to each word, shifted into place
+//! \param[in] colour_delay_shifted: The lateness of the spike, shifted into
+//!     the delay position of the words
+//! \param[in] check_delays: Whether to test the delay of each synapse
+static inline void process_fixed_synapse_words(
+        uint32_t *synaptic_words, uint32_t fixed_synapse, uint32_t masked_time,
+        uint32_t colour_delay_shifted, bool check_delays) {
     for (; fixed_synapse > 0; fixed_synapse--) {
         // Get the next 32 bit word from the synaptic_row
         // (should auto increment pointer in single instruction)
         uint32_t synaptic_word = *synaptic_words++;
 
-        // If the (shifted) delay is non zero and too small, skip
-        if (((synaptic_word & synapse_delay_mask_shifted) != 0) &&
-        		((synaptic_word & synapse_delay_mask_shifted) <= colour_delay_shifted)) {
+        if (check_delays && delay_too_small(synaptic_word, colour_delay_shifted)) {
             skipped_synapses++;
             continue;
         }
 
+#if SYNAPSE_DELAY_WHEEL
+        // Delays beyond the ring buffers go into the wheel in SDRAM
+        if (synaptic_word & long_delay_mask_shifted) {
+            add_to_delay_wheel(
+                    (synaptic_word + delay_wheel_time) & delay_wheel_mask,
+                    synapse_row_sparse_weight(synaptic_word));
+            continue;
+        }
+#endif
+
         // The ring buffer index can be found by adding on the time to the delay
         // in the synaptic word directly, and then masking off the whole index.
         // The addition of the masked time to the delay even with the mask might
         // overflow into the weight at worst but can't affect the lower bits.
-        uint32_t ring_buffer_index = (synaptic_word + masked_time) & ring_buffer_mask;
+        uint32_t ring_buffer_index = synapses_ring_buffer_entry(
+                (synaptic_word + masked_time) & ring_buffer_mask);
+
+#if PACKED_FIXED_SYNAPSES
+        // If the next synapse is to the other entry in the same ring buffer
+        // word (which needs the same delay and type, so the delay check above
+        // also holds for it), add both weights at once
+        if ((fixed_synapse > 1) && !(ring_buffer_index & 0x1) &&
+                ((*synaptic_words & packed_pair_mask) ==
+                        ((synaptic_word & packed_pair_mask) + 1))) {
+            uint32_t next_word = *synaptic_words++;
+            fixed_synapse--;
+            packed_weights_t *pair =
+                    (packed_weights_t *) &ring_buffers[ring_buffer_index];
+            *pair = synapse_row_packed_add_saturate(*pair,
+                    (synaptic_word >> 16) | (next_word & 0xFFFF0000),
+                    &synapses_saturation_count);
+            continue;
+        }
+#endif
+
         uint32_t weight = synapse_row_sparse_weight(synaptic_word);
 
-        // Add weight to current ring buffer value
-        uint32_t accumulation = ring_buffers[ring_buffer_index] + weight;
+        // Add weight to current ring buffer value, saturating if needed
+        if (synapse_row_ring_buffer_add(
+                &ring_buffers[ring_buffer_index], weight)) {
+            synapses_saturation_count++;
+        }
+    }
+}
+
+//! \brief Find the number of synapses at the start of a delay-sorted row that
+//!     are too late to be processed
+//! \param[in] synaptic_words: The fixed synaptic words of the row
+//! \param[in] fixed_synapse: The number of synaptic words
+//! \param[in] colour_delay_shifted: The lateness of the spike, shifted into
+//!     the delay position of the words
+//! \return The number of synapses to skip
+static inline uint32_t n_delay_sorted_too_small(
+        uint32_t *synaptic_words, uint32_t fixed_synapse,
+        uint32_t colour_delay_shifted) {
+    uint32_t lo = 0;
+    uint32_t hi = fixed_synapse;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) >> 1;
+        if (delay_too_small(synaptic_words[mid], colour_delay_shifted)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+//! \brief Process the weights of a dense row, which all go to consecutive
+//!     ring buffer entries from that of the header word.
+//! \param[in] synaptic_words: The fixed words of the row, header first
+//! \param[in] masked_time: The time to add to the header, shifted into place
+//! \param[in] colour_delay_shifted: The lateness of the spike, shifted into
+//!     the delay position of the words
+static inline void process_dense_synapse_words(
+        uint32_t *synaptic_words, uint32_t masked_time,
+        uint32_t colour_delay_shifted) {
+    uint32_t header = *synaptic_words++;
+    uint32_t n_weights = header >> SYNAPSE_ROW_DENSE_N_WEIGHTS_SHIFT;
+    if (delay_too_small(header, colour_delay_shifted)) {
+        skipped_synapses += n_weights;
+        return;
+    }
+
+    // The header has the index of the first neuron, so add the time as for
+    // any other synaptic word; the rest of the weights follow on from there
+    uint32_t ring_buffer_index = synapses_ring_buffer_entry(
+            (header + masked_time) & ring_buffer_mask);
+    weight_t *weights = (weight_t *) synaptic_words;
+
+#if SYNAPSE_DELAY_WHEEL
+    if (header & long_delay_mask_shifted) {
+        uint32_t index = (header + delay_wheel_time) & delay_wheel_mask;
+        for (; n_weights > 0; n_weights--) {
+            add_to_delay_wheel(index++, *weights++);
+        }
+        return;
+    }
+#endif
+
+#if PACKED_FIXED_SYNAPSES
+    // The header index is 0 so the weights pair up with ring buffer words
+    if (!(ring_buffer_index & 0x1)) {
+        packed_weights_t *pair =
+                (packed_weights_t *) &ring_buffers[ring_buffer_index];
+        packed_weights_t *packed = (packed_weights_t *) synaptic_words;
+        for (uint32_t n = n_weights >> 1; n > 0; n--) {
+            *pair = synapse_row_packed_add_saturate(*pair, *packed++,
+                    &synapses_saturation_count);
+            pair++;
+        }
+        ring_buffer_index += n_weights & ~0x1;
+        weights += n_weights & ~0x1;
+        n_weights &= 0x1;
+    }
+#endif
+
+    for (; n_weights > 0; n_weights--) {
+        if (synapse_row_ring_buffer_add(
+                &ring_buffers[ring_buffer_index++], *weights++)) {
+            synapses_saturation_count++;
+        }
+    }
+}
+
+//! \brief Process the synapses of a byte target row, which all have the
+//!     weight of the header word and a byte each for the rest of the word.
+//! \param[in] synaptic_words: The fixed words of the row, header first
+//! \param[in] masked_time: The time to add to each byte, shifted into place
+//! \param[in] colour_delay_shifted: The lateness of the spike, shifted into
+//!     the delay position of the bytes
+static inline void process_byte_target_synapse_words(
+        uint32_t *synaptic_words, uint32_t masked_time,
+        uint32_t colour_delay_shifted) {
+    uint32_t header = *synaptic_words++;
+    uint32_t n_synapses = header & SYNAPSE_ROW_BYTE_TARGETS_N_MASK;
+    uint32_t weight = synapse_row_sparse_weight(header);
+    uint8_t *targets = (uint8_t *) synaptic_words;
+
+    for (; n_synapses > 0; n_synapses--) {
+        uint32_t target = *targets++;
+
+        if (delay_too_small(target, colour_delay_shifted)) {
+            skipped_synapses++;
+            continue;
+        }
+
+#if SYNAPSE_DELAY_WHEEL
+        if (target & long_delay_mask_shifted) {
+            add_to_delay_wheel(
+                    (target + delay_wheel_time) & delay_wheel_mask, weight);
+            continue;
+        }
+#endif
 
-        // If any of bits 31-17 are set, saturate accumulator at UINT16_MAX (0xFFFF)
-        uint32_t sat_test = accumulation & sat_flag;
-        if (sat_test) {
-            accumulation = sat_value;
+        // The byte is the bottom of a synaptic word, so is indexed likewise
+        uint32_t ring_buffer_index = synapses_ring_buffer_entry(
+                (target + masked_time) & ring_buffer_mask);
+        if (synapse_row_ring_buffer_add(
+                &ring_buffers[ring_buffer_index], weight)) {
             synapses_saturation_count++;
         }
+    }
+}
 
-        // Store saturated value back in ring-buffer
-        ring_buffers[ring_buffer_index] = accumulation;
+//! \brief Process the synapses of a shared weight row, which all add the
+//!     weight of the header word to the ring buffer entries from that of the
+//!     header, offset by the index of each target.
+//! \param[in] synaptic_words: The fixed words of the row, header first
+//! \param[in] masked_time: The time to add to the header, shifted into place
+//! \param[in] colour_delay_shifted: The lateness of the spike, shifted into
+//!     the delay position of the words
+static inline void process_shared_weight_synapse_words(
+        uint32_t *synaptic_words, uint32_t masked_time,
+        uint32_t colour_delay_shifted) {
+    uint32_t header = *synaptic_words++;
+    uint32_t n_synapses = *synaptic_words++;
+    if (delay_too_small(header, colour_delay_shifted)) {
+        skipped_synapses += n_synapses;
+        return;
+    }
+
+    uint32_t weight = synapse_row_sparse_weight(header);
+    uint16_t *targets = (uint16_t *) synaptic_words;
+
+#if SYNAPSE_DELAY_WHEEL
+    if (header & long_delay_mask_shifted) {
+        uint32_t index = (header + delay_wheel_time) & delay_wheel_mask;
+        for (; n_synapses > 0; n_synapses--) {
+            add_to_delay_wheel(index + *targets++, weight);
+        }
+        return;
+    }
+#endif
+
+    // The header has an index of 0, so the index of each target can be added
+    // to the masked index of the header without a carry into the type
+    uint32_t first_index = (header + masked_time) & ring_buffer_mask;
+    for (; n_synapses > 0; n_synapses--) {
+        uint32_t ring_buffer_index =
+                synapses_ring_buffer_entry(first_index + *targets++);
+        if (synapse_row_ring_buffer_add(
+                &ring_buffers[ring_buffer_index], weight)) {
+            synapses_saturation_count++;
+        }
+    }
+}
+
+//! \brief Process the fixed synapses of a row, choosing the handler from the
+//!     format flags of the row.
+//! \param[in] fixed_region: The fixed region of the synaptic matrix
+//! \param[in] time: The current simulation time
+//! \param[in] colour_delay: The number of time steps the spike was late by
+//! \return Always true
+static inline bool process_fixed_synapses(
+        synapse_row_fixed_part_t *fixed_region, uint32_t time,
+        uint32_t colour_delay) {
+    uint32_t *synaptic_words = synapse_row_fixed_weight_controls(fixed_region);
+    uint32_t fixed_synapse = synapse_row_num_fixed_synapses(fixed_region);
+    uint32_t format = synapse_row_format(fixed_region);
+
+    // Pre-mask the time and account for colour delay
+    uint32_t colour_delay_shifted = colour_delay << synapse_type_index_bits;
+    uint32_t masked_time = ((time - colour_delay) & synapse_delay_mask) << synapse_type_index_bits;
+#if SYNAPSE_DELAY_WHEEL
+    delay_wheel_time = ((time - colour_delay) & synapse_row_delay_mask) <<
+            synapse_type_index_bits;
+#endif
+
+    if (format & SYNAPSE_ROW_DENSE) {
+        if (fixed_synapse > 0) {
+            num_fixed_pre_synaptic_events +=
+                    synaptic_words[0] >> SYNAPSE_ROW_DENSE_N_WEIGHTS_SHIFT;
+            process_dense_synapse_words(
+                    synaptic_words, masked_time, colour_delay_shifted);
+        }
+        return true;
+    }
+
+    if (format & SYNAPSE_ROW_BYTE_TARGETS) {
+        if (fixed_synapse > 0) {
+            num_fixed_pre_synaptic_events +=
+                    synaptic_words[0] & SYNAPSE_ROW_BYTE_TARGETS_N_MASK;
+            process_byte_target_synapse_words(
+                    synaptic_words, masked_time, colour_delay_shifted);
+        }
+        return true;
+    }
+
+    if (format & SYNAPSE_ROW_SHARED_WEIGHT) {
+        if (fixed_synapse > 0) {
+            num_fixed_pre_synaptic_events += synaptic_words[1];
+            process_shared_weight_synapse_words(
+                    synaptic_words, masked_time, colour_delay_shifted);
+        }
+        return true;
+    }
+
+    num_fixed_pre_synaptic_events += fixed_synapse;
+
+    if (format & SYNAPSE_ROW_SINGLE_DELAY) {
+        // All synapses share the delay of the first, so test that only
+        if (fixed_synapse > 0 &&
+                delay_too_small(synaptic_words[0], colour_delay_shifted)) {
+            skipped_synapses += fixed_synapse;
+            return true;
+        }
+        process_fixed_synapse_words(synaptic_words, fixed_synapse,
+                masked_time, colour_delay_shifted, false);
+    } else if (format & SYNAPSE_ROW_DELAY_SORTED) {
+        // The synapses that are too late are all at the start of the row
+        if (colour_delay_shifted) {
+            uint32_t n_skip = n_delay_sorted_too_small(
+                    synaptic_words, fixed_synapse, colour_delay_shifted);
+            skipped_synapses += n_skip;
+            synaptic_words += n_skip;
+            fixed_synapse -= n_skip;
+        }
+        process_fixed_synapse_words(synaptic_words, fixed_synapse,
+                masked_time, colour_delay_shifted, false);
+    } else {
+        process_fixed_synapse_words(synaptic_words, fixed_synapse,
+                masked_time, colour_delay_shifted, true);
     }
     return true;
 }
@@ -259,22 +611,56 @@ struct synapse_params {
     uint32_t log_n_neurons;
     uint32_t log_n_synapse_types;
     uint32_t log_max_delay;
+    //! The delay bits of the ring buffers, which can be fewer than those of
+    //! the synaptic words if there is a delay wheel
+    uint32_t log_ring_buffer_delay;
     uint32_t drop_late_packets;
     uint32_t incoming_spike_buffer_size;
+    //! The offset in the synaptic matrix region of the bit field of the rows
+    //! written back, or ::DIRTY_ROWS_NONE if the host doesn't want these
+    uint32_t dirty_rows_offset;
+    //! The offset in the synaptic matrix region of the events counted for
+    //! each projection, or ::EVENT_COUNTERS_NONE if not wanted
+    uint32_t event_counters_offset;
+    //! Whether to note the peak ring buffer value of each synapse type
+    uint32_t profile_ring_buffers;
+    //! The shift of each synapse type, followed by space for the peak ring
+    //! buffer value of each synapse type, followed by the delay bits needed
+    //! by each synapse type (used by ::COMPACT_RING_BUFFERS)
     uint32_t ring_buffer_shifts[];
 };
 
+//! The dirty rows offset when the rows written back are not tracked
+#define DIRTY_ROWS_NONE 0xFFFFFFFF
+
+//! The offset of the dirty rows bit field, from the parameters
+static uint32_t dirty_rows_offset = DIRTY_ROWS_NONE;
+
+bit_field_t synapse_dirty_rows = NULL;
+
+address_t synapse_dirty_rows_base = NULL;
+
+uint32_t synapse_event_counters_offset = EVENT_COUNTERS_NONE;
+
+//! The peak ring buffer value of each synapse type, or NULL if not profiled
+static uint32_t *ring_buffer_peaks = NULL;
+
+//! Where to store the ::ring_buffer_peaks for the host to read
+static uint32_t *sdram_ring_buffer_peaks = NULL;
+
 /* INTERFACE FUNCTIONS */
 bool synapses_initialise(
         address_t synapse_params_address,
         uint32_t *n_neurons_out, uint32_t *n_synapse_types_out,
-        weight_t **ring_buffers_out,
+        ring_buffer_t **ring_buffers_out,
         uint32_t **ring_buffer_to_input_buffer_left_shifts,
         bool* clear_input_buffers_of_late_packets_init,
         uint32_t *incoming_spike_buffer_size) {
     struct synapse_params *params = (struct synapse_params *) synapse_params_address;
     *clear_input_buffers_of_late_packets_init = params->drop_late_packets;
     *incoming_spike_buffer_size = params->incoming_spike_buffer_size;
+    dirty_rows_offset = params->dirty_rows_offset;
+    synapse_event_counters_offset = params->event_counters_offset;
     n_neurons = params->n_neurons;
     *n_neurons_out = n_neurons;
     n_synapse_types = params->n_synapse_types;
@@ -299,15 +685,50 @@ bool synapses_initialise(
     *ring_buffer_to_input_buffer_left_shifts =
             ring_buffer_to_input_left_shifts;
 
+    // The peaks go after the shifts, so the host can read them with the
+    // shifts that they were measured with
+    if (params->profile_ring_buffers) {
+        ring_buffer_peaks = spin1_malloc(n_synapse_types * sizeof(uint32_t));
+        if (ring_buffer_peaks == NULL) {
+            log_error("Not enough memory to profile the ring buffers");
+            return false;
+        }
+        sdram_ring_buffer_peaks = &params->ring_buffer_shifts[n_synapse_types];
+        for (uint32_t i = 0; i < n_synapse_types; i++) {
+            ring_buffer_peaks[i] = 0;
+            sdram_ring_buffer_peaks[i] = 0;
+        }
+    }
+
     synapse_type_index_bits = log_n_neurons + log_n_synapse_types;
     synapse_type_index_mask = (1 << synapse_type_index_bits) - 1;
     synapse_index_bits = log_n_neurons;
     synapse_index_mask = (1 << synapse_index_bits) - 1;
     synapse_type_bits = log_n_synapse_types;
     synapse_type_mask = (1 << log_n_synapse_types) - 1;
-    synapse_delay_bits = log_max_delay;
+    synapse_delay_bits = params->log_ring_buffer_delay;
     synapse_delay_mask = (1 << synapse_delay_bits) - 1;
-    synapse_delay_mask_shifted = synapse_delay_mask << synapse_type_index_bits;
+    synapse_row_delay_mask = (1 << log_max_delay) - 1;
+    synapse_delay_mask_shifted =
+            synapse_row_delay_mask << synapse_type_index_bits;
+    if (log_max_delay > synapse_delay_bits) {
+#if SYNAPSE_DELAY_WHEEL
+        delay_wheel_mask =
+                (1 << (log_max_delay + synapse_type_index_bits)) - 1;
+        long_delay_mask_shifted = synapse_delay_mask_shifted &
+                ~(synapse_delay_mask << synapse_type_index_bits);
+#else
+        log_error("Delays of %u bits need a delay wheel, but ring buffers "
+                "only have %u bits of delay", log_max_delay,
+                synapse_delay_bits);
+        return false;
+#endif
+    }
+#if PACKED_FIXED_SYNAPSES
+    if (synapse_index_bits > 0) {
+        packed_pair_mask = 0xFFFF;
+    }
+#endif
 
     n_neurons_peak = 1 << log_n_neurons;
 
@@ -316,7 +737,39 @@ bool synapses_initialise(
     ring_buffer_size = 1 << (n_ring_buffer_bits);
     ring_buffer_mask = ring_buffer_size - 1;
 
-    ring_buffers = spin1_malloc(ring_buffer_size * sizeof(weight_t));
+#if COMPACT_RING_BUFFERS
+    // Each synapse type has a section of its own, with only as many delay
+    // slots as its synapses need, and each slot has an entry for exactly each
+    // neuron; the index of a synaptic word is still made as above and then
+    // mapped to these with a base for each delay slot and synapse type, which
+    // also wraps the slots of the types with fewer of them
+    uint32_t n_bases = 1 << (log_n_synapse_types + synapse_delay_bits);
+    synapse_ring_buffer_bases = spin1_malloc(n_bases * sizeof(uint32_t));
+    if (synapse_ring_buffer_bases == NULL) {
+        log_error("Could not allocate %u ring buffer bases", n_bases);
+        return false;
+    }
+    uint32_t *log_type_delays =
+            &params->ring_buffer_shifts[2 * n_synapse_types];
+    uint32_t section = 0;
+    for (uint32_t t = 0; t < n_synapse_types; t++) {
+        uint32_t log_type_delay = log_type_delays[t];
+        if (log_type_delay > synapse_delay_bits) {
+            log_type_delay = synapse_delay_bits;
+        }
+        uint32_t type_delay_mask = (1 << log_type_delay) - 1;
+        for (uint32_t d = 0; d < (1u << synapse_delay_bits); d++) {
+            synapse_ring_buffer_bases[(d << log_n_synapse_types) | t] =
+                    section + ((d & type_delay_mask) * n_neurons);
+        }
+        log_info("Synapse type %u has %u delay slots", t, 1 << log_type_delay);
+        section += n_neurons << log_type_delay;
+    }
+    n_neurons_peak = n_neurons;
+    ring_buffer_size = section;
+#endif
+
+    ring_buffers = spin1_malloc(ring_buffer_size * sizeof(ring_buffer_t));
     if (ring_buffers == NULL) {
         log_error("Could not allocate %u entries for ring buffers; Biggest space %u",
                 ring_buffer_size, sark_heap_max(sark.heap, 0));
@@ -333,21 +786,137 @@ bool synapses_initialise(
     return true;
 }
 
+void synapses_set_dirty_rows(address_t synaptic_matrix) {
+    if (dirty_rows_offset == DIRTY_ROWS_NONE) {
+        return;
+    }
+    // The bit field follows the rows, with a bit for each word before it
+    synapse_dirty_rows_base = synaptic_matrix;
+    synapse_dirty_rows = (bit_field_t)
+            &synaptic_matrix[dirty_rows_offset / sizeof(uint32_t)];
+    clear_bit_field(synapse_dirty_rows,
+            get_bit_field_size(dirty_rows_offset / sizeof(uint32_t)));
+    log_info("Tracking rows written back at 0x%08x", synapse_dirty_rows);
+}
+
+bool synapses_set_delay_wheel(weight_t *wheel) {
+#if SYNAPSE_DELAY_WHEEL
+    if (delay_wheel_mask == 0) {
+        return true;
+    }
+    if (wheel == NULL) {
+        log_error("No delay wheel region for delays of over %u steps",
+                synapse_delay_mask + 1);
+        return false;
+    }
+    if (synapse_type_index_bits == 0) {
+        log_error("A delay wheel needs at least two ring buffers per delay");
+        return false;
+    }
+    delay_wheel = wheel;
+    uint32_t n_words = (delay_wheel_mask + 1) / WEIGHTS_PER_WORD;
+    packed_weights_t *words = (packed_weights_t *) delay_wheel;
+    for (uint32_t i = 0; i < n_words; i++) {
+        words[i] = 0;
+    }
+    log_info("Delay wheel of %u entries at 0x%08x", delay_wheel_mask + 1,
+            delay_wheel);
+#else
+    use(wheel);
+#endif
+    return true;
+}
+
+weight_t *synapses_delay_wheel_slot(timer_t time) {
+#if SYNAPSE_DELAY_WHEEL
+    if (delay_wheel != NULL) {
+        return &delay_wheel[(time & synapse_row_delay_mask) <<
+                synapse_type_index_bits];
+    }
+#else
+    use(time);
+#endif
+    return NULL;
+}
+
+void synapses_note_ring_buffer_peaks(uint32_t first_index) {
+    if (ring_buffer_peaks == NULL) {
+        return;
+    }
+    for (uint32_t t = 0; t < n_synapse_types; t++) {
+        ring_buffer_t *buffers = &ring_buffers[synapses_ring_buffer_entry(
+                first_index + (t << synapse_index_bits))];
+        uint32_t peak = ring_buffer_peaks[t];
+        for (uint32_t n = 0; n < n_neurons; n++) {
+            if (buffers[n] > peak) {
+                peak = buffers[n];
+            }
+        }
+        // A new peak is rare once the network has settled, so it is written
+        // straight through for the host rather than at pause; the synapse
+        // cores of a split population share the parameters, so only raise
+        // the peak that is there
+        if (peak > ring_buffer_peaks[t]) {
+            ring_buffer_peaks[t] = peak;
+            if (peak > sdram_ring_buffer_peaks[t]) {
+                sdram_ring_buffer_peaks[t] = peak;
+            }
+        }
+    }
+}
+
 void synapses_flush_ring_buffers(timer_t time) {
-    uint32_t synapse_index = 0;
     uint32_t ring_buffer_index = synapse_row_get_first_ring_buffer_index(
-            time, synapse_type_index_bits, synapse_delay_mask);;
-    for (uint32_t s_i = n_synapse_types; s_i > 0; s_i--) {
-        uint32_t neuron_index = 0;
-        for (uint32_t n_i = n_neurons_peak; n_i > 0; n_i--) {
-            ring_buffers[ring_buffer_index] = 0;
-            ring_buffer_index++;
-            neuron_index++;
+            time, synapse_type_index_bits, synapse_delay_mask);
+    uint32_t n_weights = n_synapse_types * n_neurons_peak;
+    ring_buffer_t *weights = &ring_buffers[ring_buffer_index];
+
+    // The entries for a time step are contiguous and start on a word boundary
+    // unless there is only one of them, so clear them a word at a time, four
+    // words to a loop so that the compiler can use multi-word stores
+    if (!(ring_buffer_index & (ENTRIES_PER_WORD - 1))) {
+        packed_weights_t *words = (packed_weights_t *) weights;
+        uint32_t n_words = n_weights / ENTRIES_PER_WORD;
+        for (; n_words >= 4; n_words -= 4) {
+            words[0] = 0;
+            words[1] = 0;
+            words[2] = 0;
+            words[3] = 0;
+            words += 4;
         }
-        synapse_index++;
+        for (; n_words > 0; n_words--) {
+            *words++ = 0;
+        }
+        weights = (ring_buffer_t *) words;
+        n_weights &= ENTRIES_PER_WORD - 1;
+    }
+    for (; n_weights > 0; n_weights--) {
+        *weights++ = 0;
     }
 }
 
+//! \brief Process the plastic synapses of a row
+//! \param[in] row: The row
+//! \param[in] fixed_region: The fixed region of the row
+//! \param[in] time: The current simulation time
+//! \param[in] colour_delay: The number of time steps the spike was late by
+//! \param[out] write_back: Whether the row needs to be written back
+//! \return Whether the synapses were processed
+static inline bool process_plastic_synapses(
+        synaptic_row_t row, synapse_row_fixed_part_t *fixed_region,
+        uint32_t time, uint32_t colour_delay, bool *write_back) {
+    profiler_write_entry_disable_fiq(
+            PROFILER_ENTER | PROFILER_PROCESS_PLASTIC_SYNAPSES);
+    if (!synapse_dynamics_process_plastic_synapses(
+            synapse_row_plastic_region(row), fixed_region, ring_buffers,
+            time, colour_delay, write_back)) {
+        return false;
+    }
+    profiler_write_entry_disable_fiq(
+            PROFILER_EXIT | PROFILER_PROCESS_PLASTIC_SYNAPSES);
+    return true;
+}
+
 bool synapses_process_synaptic_row(
         uint32_t time, uint32_t spike_colour, uint32_t colour_mask,
 		synaptic_row_t row, bool *write_back) {
@@ -368,6 +937,11 @@ bool synapses_process_synaptic_row(
     if (colour_delay > max_late_spike) {
         max_late_spike = colour_delay;
     }
+    if (colour_delay < N_LATENESS_BINS) {
+        lateness_histogram[colour_delay]++;
+    } else {
+        lateness_histogram[N_LATENESS_BINS - 1]++;
+    }
 
     // By default don't write back
     *write_back = false;
@@ -375,23 +949,16 @@ bool synapses_process_synaptic_row(
     // Get address of non-plastic region from row
     synapse_row_fixed_part_t *fixed_region = synapse_row_fixed_region(row);
 
-    // **TODO** multiple optimised synaptic row formats
-    //if (plastic_tag(row) == 0) {
-    // If this row has a plastic region
-    if (synapse_row_plastic_size(row) > 0) {
-        // Get region's address
-        synapse_row_plastic_data_t *plastic_data =
-                synapse_row_plastic_region(row);
+    // A row of only plastic synapses has no fixed synapses to look at
+    if (synapse_row_format(fixed_region) & SYNAPSE_ROW_PLASTIC_ONLY) {
+        return process_plastic_synapses(
+                row, fixed_region, time, colour_delay, write_back);
+    }
 
-        // Process any plastic synapses
-        profiler_write_entry_disable_fiq(
-                PROFILER_ENTER | PROFILER_PROCESS_PLASTIC_SYNAPSES);
-        if (!synapse_dynamics_process_plastic_synapses(plastic_data,
-                fixed_region, ring_buffers, time, colour_delay, write_back)) {
-            return false;
-        }
-        profiler_write_entry_disable_fiq(
-                PROFILER_EXIT | PROFILER_PROCESS_PLASTIC_SYNAPSES);
+    // If this row has a plastic region
+    if (synapse_row_plastic_size(row) > 0 && !process_plastic_synapses(
+            row, fixed_region, time, colour_delay, write_back)) {
+        return false;
     }
 
     // Process any fixed synapses
@@ -399,7 +966,6 @@ bool synapses_process_synaptic_row(
     // to hide cost of DMA behind this loop to improve the chance
     // that the DMA controller is ready to read next synaptic row afterwards
     return process_fixed_synapses(fixed_region, time, colour_delay);
-    //}
 }
 
 uint32_t synapses_get_pre_synaptic_events(void) {
@@ -21,6 +21,7 @@
 
 #include <common/neuron-typedefs.h>
 #include <debug.h>
+#include <bit_field.h>
 #include "synapse_row.h"
 
 //! \brief Number of bits needed for the synapse type and index
@@ -48,6 +49,28 @@ extern uint32_t synapse_delay_bits;
 //! Mask to pick out the delay
 extern uint32_t synapse_delay_mask;
 
+#if COMPACT_RING_BUFFERS
+//! \brief The first compact ring buffer entry of each delay slot and synapse
+//!     type, indexed by the delay and synapse type of a ring buffer index
+extern uint32_t *synapse_ring_buffer_bases;
+#endif
+
+//! \brief Get the ring buffer entry of a ring buffer index made with the
+//!     synapse_row_get_ring_buffer_index() family of functions
+//! \details With ::COMPACT_RING_BUFFERS the neuron index is added to the base
+//!     of its delay slot and synapse type, taken from a table so that there
+//!     is no multiply; otherwise the index is the entry.
+//! \param[in] index: The ring buffer index
+//! \return The index of the entry in the ring buffers
+static inline index_t synapses_ring_buffer_entry(uint32_t index) {
+#if COMPACT_RING_BUFFERS
+    return synapse_ring_buffer_bases[index >> synapse_index_bits]
+            + (index & synapse_index_mask);
+#else
+    return index;
+#endif
+}
+
 //! Count of the number of times the synapses have saturated their weights.
 extern uint32_t synapses_saturation_count;
 
@@ -61,15 +84,37 @@ extern uint32_t late_spikes;
 //! The maximum lateness of a spike
 extern uint32_t max_late_spike;
 
+//! The number of bins of the histogram of spike lateness: one per time step
+//! late, with the last also counting anything later
+#define N_LATENESS_BINS 4
+
+//! The number of rows processed by how many time steps late the spike was
+extern uint32_t lateness_histogram[N_LATENESS_BINS];
+
+//! \brief A bit for each word of the synaptic matrix region, set where the
+//!     word starts a row that has been written back since the host last read
+//!     it, or NULL if this is not tracked
+extern bit_field_t synapse_dirty_rows;
+
+//! The start of the synaptic matrix region, which the dirty rows refer to
+extern address_t synapse_dirty_rows_base;
+
+//! The event counters offset when the events of each projection aren't counted
+#define EVENT_COUNTERS_NONE 0xFFFFFFFF
+
+//! \brief The offset in the synaptic matrix region of the events counted for
+//!     each projection, or ::EVENT_COUNTERS_NONE if these are not counted
+extern uint32_t synapse_event_counters_offset;
+
 
 //! \brief Print the weight of a synapse
-//! \param[in] weight: the weight to print in synapse-row form
+//! \param[in] weight: the weight to print in synapse-row or ring buffer form
 //! \param[in] left_shift: the shift to use when decoding
 static inline void synapses_print_weight(
-        weight_t weight, uint32_t left_shift) {
+        ring_buffer_t weight, uint32_t left_shift) {
     if (weight != 0) {
         io_printf(IO_BUF, "%12.6k",
-                synapse_row_convert_weight_to_input(weight, left_shift));
+                synapse_row_convert_ring_buffer_to_input(weight, left_shift));
     } else {
         io_printf(IO_BUF, "      ");
     }
@@ -91,7 +136,7 @@ static inline void synapses_print_weight(
 bool synapses_initialise(
         address_t synapse_params_address,
         uint32_t *n_neurons, uint32_t *n_synapse_types,
-        weight_t **ring_buffers,
+        ring_buffer_t **ring_buffers,
         uint32_t **ring_buffer_to_input_buffer_left_shifts,
         bool* clear_input_buffers_of_late_packets_init,
         uint32_t *incoming_spike_buffer_size);
@@ -117,8 +162,44 @@ uint32_t synapses_get_pre_synaptic_events(void);
 //! \param[in] time: The time at which the simulation is to start
 void synapses_resume(timer_t time);
 
+//! \brief Note the peak value of the ring buffers of each synapse type for the
+//!     host, if it has asked for this, just before they are used
+//! \param[in] first_index: The index of the first ring buffer of the time step
+void synapses_note_ring_buffer_peaks(uint32_t first_index);
+
 //! \brief Reset the ring buffers to 0 at the given time
 //! \param[in] time: the simulated time to reset the buffers at
 void synapses_flush_ring_buffers(timer_t time);
 
+//! \brief Set the SDRAM to use for the synapses with delays too long for the
+//!     ring buffers, if there are any, and clear it
+//! \param[in] wheel: The SDRAM, with space for ring buffers for all the
+//!     delays of a synaptic word
+//! \return True if successful
+bool synapses_set_delay_wheel(weight_t *wheel);
+
+//! \brief Set the synaptic matrix region, in which the rows written back are
+//!     tracked if the host has asked for this, and clear the tracking
+//! \param[in] synaptic_matrix: The start of the synaptic matrix region
+void synapses_set_dirty_rows(address_t synaptic_matrix);
+
+//! \brief Note that a row has been written back to SDRAM, so that the host
+//!     can read only the rows that have changed
+//! \param[in] sdram_row: The address of the row in SDRAM
+static inline void synapses_mark_row_dirty(synaptic_row_t sdram_row) {
+    if (synapse_dirty_rows != NULL) {
+        bit_field_set(synapse_dirty_rows,
+                ((address_t) sdram_row) - synapse_dirty_rows_base);
+    }
+}
+
+//! \brief Get the ring buffers of a time step in the SDRAM for the synapses
+//!     with delays too long for the ring buffers
+//! \details The caller must add these into the ring buffers of the time step
+//!     before they are used, and then set them to 0.  They are laid out like
+//!     the ring buffers of a time step.
+//! \param[in] time: The time step
+//! \return The ring buffers of the time step, or NULL if there are none
+weight_t *synapses_delay_wheel_slot(timer_t time);
+
 #endif // _SYNAPSES_H_
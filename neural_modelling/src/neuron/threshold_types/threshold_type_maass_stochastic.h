@@ -26,6 +26,24 @@
 //! Probability of firing when at saturation
 #define PROB_SATURATION 0.8k
 
+//! \brief Whether to look up the probability of firing by the quantised
+//!     exponent in a table made at initialisation, for the neurons that share
+//!     the time constant and time step of the first.  This can be set per
+//!     binary at build time.
+#ifndef STOCHASTIC_PROBABILITY_TABLE
+#define STOCHASTIC_PROBABILITY_TABLE 0
+#endif
+
+#if STOCHASTIC_PROBABILITY_TABLE
+//! The smallest exponent in the table; below this it is worked out each time
+#define MAASS_TABLE_MIN -8.0k
+//! The log<sub>2</sub> of the number of table entries per unit of exponent
+#define MAASS_TABLE_STEP_BITS 5
+//! \brief The number of entries in the table, from the minimum up to 5,
+//!     where the probability saturates
+#define MAASS_TABLE_SIZE (13 << MAASS_TABLE_STEP_BITS)
+#endif
+
 //! Stochastic threshold parameters
 struct threshold_type_params_t {
     //! sensitivity of soft threshold to membrane voltage [mV<sup>-1</sup>]
@@ -50,11 +68,54 @@ struct threshold_type_t {
     REAL     v_thresh;
     //! time step scaling factor
     REAL     neg_machine_time_step_ms_div_10;
+#if STOCHASTIC_PROBABILITY_TABLE
+    //! Whether the probability of firing can be taken from the table
+    bool     use_table;
+#endif
 };
 
 // HACK: Needed to make some versions of gcc not mess up
 static volatile REAL ten = 10k;
 
+//! \brief Work out the probability of firing below saturation
+//! \param[in] exponent: The scaled distance of the voltage from threshold
+//! \param[in] tau_th_inv: The inverse of the threshold time constant
+//! \param[in] neg_time_step: The scaled negative of the time step
+//! \return The probability of firing
+static inline UREAL maass_probability(
+        REAL exponent, REAL tau_th_inv, REAL neg_time_step) {
+    REAL hazard = expk(exponent) * tau_th_inv;
+    return (1.0k - expk(hazard * neg_time_step)) * PROB_SATURATION;
+}
+
+#if STOCHASTIC_PROBABILITY_TABLE
+//! The probability of firing at each quantised exponent
+static UREAL maass_table[MAASS_TABLE_SIZE];
+
+//! Whether ::maass_table has been made
+static bool maass_table_made = false;
+
+//! The inverse threshold time constant that ::maass_table was made for
+static REAL maass_table_tau_th_inv;
+
+//! The scaled negative time step that ::maass_table was made for
+static REAL maass_table_neg_time_step;
+
+//! \brief Make the table for the time constant and step of a neuron
+//! \param[in] state: The threshold of the neuron
+static void maass_make_table(const threshold_type_t *state) {
+    for (uint32_t i = 0; i < MAASS_TABLE_SIZE; i++) {
+        REAL exponent = kbits(bitsk(MAASS_TABLE_MIN) +
+                (int32_t) (i << (15 - MAASS_TABLE_STEP_BITS)));
+        maass_table[i] = maass_probability(exponent, state->tau_th_inv,
+                state->neg_machine_time_step_ms_div_10);
+    }
+    maass_table_tau_th_inv = state->tau_th_inv;
+    maass_table_neg_time_step = state->neg_machine_time_step_ms_div_10;
+    maass_table_made = true;
+}
+#endif
+
 static void threshold_type_initialise(threshold_type_t *state, threshold_type_params_t *params,
 		uint32_t n_steps_per_timestep) {
 	REAL ts = kdivui(params->time_step_ms, n_steps_per_timestep);
@@ -62,6 +123,15 @@ static void threshold_type_initialise(threshold_type_t *state, threshold_type_pa
 	state->tau_th_inv = kdivk(ONE, params->tau_th);
 	state->v_thresh = params->v_thresh;
 	state->neg_machine_time_step_ms_div_10 = kdivk(ts, ten);
+#if STOCHASTIC_PROBABILITY_TABLE
+	if (!maass_table_made) {
+		maass_make_table(state);
+	}
+	state->use_table =
+			bitsk(state->tau_th_inv) == bitsk(maass_table_tau_th_inv) &&
+			bitsk(state->neg_machine_time_step_ms_div_10) ==
+					bitsk(maass_table_neg_time_step);
+#endif
 }
 
 static void threshold_type_save_state(UNUSED threshold_type_t *state,
@@ -83,10 +153,18 @@ static inline bool threshold_type_is_above_threshold(
     // (result --> prob_saturation).
     UREAL result;
     if (exponent < 5.0k) {
-        REAL hazard = expk(exponent) * threshold_type->tau_th_inv;
-        result = (1.0k - expk(hazard *
-                threshold_type->neg_machine_time_step_ms_div_10)) *
-                        PROB_SATURATION;
+#if STOCHASTIC_PROBABILITY_TABLE
+        if (threshold_type->use_table && exponent >= MAASS_TABLE_MIN) {
+            result = maass_table[(bitsk(exponent) - bitsk(MAASS_TABLE_MIN))
+                    >> (15 - MAASS_TABLE_STEP_BITS)];
+        } else {
+            result = maass_probability(exponent, threshold_type->tau_th_inv,
+                    threshold_type->neg_machine_time_step_ms_div_10);
+        }
+#else
+        result = maass_probability(exponent, threshold_type->tau_th_inv,
+                threshold_type->neg_machine_time_step_ms_div_10);
+#endif
     } else {
         result = PROB_SATURATION;
     }
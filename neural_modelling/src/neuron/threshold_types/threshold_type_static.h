@@ -41,6 +41,10 @@ static void threshold_type_save_state(UNUSED threshold_type_t *state,
 		UNUSED threshold_type_params_t *params) {
 }
 
+//! \brief The threshold never changes, so a neuron held at a value below it
+//!     never crosses it
+#define THRESHOLD_TYPE_CONSTANT
+
 //! \brief Determines if the value given is above the threshold value
 //! \param[in] value: The value to determine if it is above the threshold
 //! \param[in] threshold_type: The parameters to use to determine the result
@@ -46,6 +46,13 @@ typedef struct {
     int delta_threshold;
     //! Whether we should continue moving if there is no change
     uint32_t continue_if_not_different;
+    //! Whether to send the speeds of all the axes together in one command
+    uint32_t batch_commands;
+    //! The least time between batched commands, in ticks
+    uint32_t batch_interval;
+    //! The total change in speed over all the axes needed to send a batch
+    //! before the next update
+    uint32_t batch_delta_threshold;
 } motor_control_config_t;
 
 //! The provenance information written on application shutdown.
@@ -70,6 +77,13 @@ typedef enum {
 //! Mask for selecting the neuron ID from a spike
 #define NEURON_ID_MASK     0x7FF
 
+//! The number of axes, each of which is a pair of opposite directions
+#define N_AXES             3
+
+//! \brief The key offset of a batched command, whose payload holds a signed
+//!     byte per axis: forwards, left and clockwise, from the lowest byte up
+#define MOTION_BATCH       0x07
+
 // Globals
 //! The simulation time
 static uint32_t time;
@@ -91,6 +105,16 @@ static uint32_t delay_time;
 static int delta_threshold;
 //! Whether we should continue moving if there is no change
 static bool continue_if_not_different;
+//! Whether to send the speeds of all the axes together in one command
+static bool batch_commands;
+//! The least time between batched commands, in ticks
+static uint32_t batch_interval;
+//! The total change in speed needed to send a batch before the next update
+static uint32_t batch_delta_threshold;
+//! The signed speed of each axis in the last batch sent
+static int batch_sent[N_AXES];
+//! The time the last batch was sent
+static uint32_t batch_time;
 //! Current simulation stop/pause time
 static uint32_t simulation_ticks;
 //! True if the simulation is running continuously
@@ -114,11 +138,11 @@ enum robot_motor_control_callback_priorities {
 // ----------------------------------------------------------------------
 
 //! \brief Send a SpiNNaker multicast-with-payload message to the motor hardware
-//! \param[in] direction: Which direction to move in
-//! \param[in] the_speed: What speed to move at
-static inline void send_to_motor(uint32_t direction, uint32_t the_speed) {
-    uint32_t direction_key = direction | key;
-    while (!spin1_send_mc_packet(direction_key, the_speed, WITH_PAYLOAD)) {
+//! \param[in] command: The key offset of the command
+//! \param[in] payload: The payload of the command
+static inline void send_command(uint32_t command, uint32_t payload) {
+    uint32_t command_key = command | key;
+    while (!spin1_send_mc_packet(command_key, payload, WITH_PAYLOAD)) {
         spin1_delay_us(1);
     }
     if (delay_time > 0) {
@@ -126,6 +150,61 @@ static inline void send_to_motor(uint32_t direction, uint32_t the_speed) {
     }
 }
 
+//! \brief Send the speed of one direction to the motor hardware, unless the
+//!     speeds are being batched, in which case send_batch() sends them
+//! \param[in] direction: Which direction to move in
+//! \param[in] the_speed: What speed to move at
+static inline void send_to_motor(uint32_t direction, uint32_t the_speed) {
+    if (!batch_commands) {
+        send_command(direction, the_speed);
+    }
+}
+
+//! \brief Get the signed speed of an axis from the last speeds
+//! \param[in] direction_index: The positive sense of the axis
+//! \param[in] opposite_index: The negative sense of the axis
+//! \return The speed, clamped to fit in a signed byte
+static inline int axis_speed(
+        direction_t direction_index, direction_t opposite_index) {
+    int axis = last_speed[direction_index - 1] - last_speed[opposite_index - 1];
+    if (axis > INT8_MAX) {
+        return INT8_MAX;
+    } else if (axis < INT8_MIN) {
+        return INT8_MIN;
+    }
+    return axis;
+}
+
+//! \brief Send the speeds of all the axes in one command, if it is long
+//!     enough since the last batch and the speeds have changed enough
+//! \param[in] is_update: Whether to send even if the speeds have not changed
+static void send_batch(bool is_update) {
+    if (time - batch_time < batch_interval) {
+        return;
+    }
+    int speeds[N_AXES] = {
+        axis_speed(MOTION_FORWARD, MOTION_BACK),
+        axis_speed(MOTION_LEFT, MOTION_RIGHT),
+        axis_speed(MOTION_CLOCKWISE, MOTION_C_CLOCKWISE)
+    };
+    uint32_t delta = 0;
+    uint32_t payload = 0;
+    for (uint32_t i = 0; i < N_AXES; i++) {
+        int change = speeds[i] - batch_sent[i];
+        delta += (change < 0) ? -change : change;
+        payload |= ((uint32_t) speeds[i] & 0xFF) << (i * 8);
+    }
+    if (!is_update && (delta == 0 || delta < batch_delta_threshold)) {
+        return;
+    }
+    log_debug("Sending batch 0x%06x", payload);
+    send_command(MOTION_BATCH, payload);
+    for (uint32_t i = 0; i < N_AXES; i++) {
+        batch_sent[i] = speeds[i];
+    }
+    batch_time = time;
+}
+
 //! \brief Commands the robot's motors to start doing a motion
 //! \param[in] direction_index: The "forward" sense of motion
 //! \param[in] opposite_index: The "reverse" sense of motion
@@ -221,6 +300,9 @@ static void timer_callback(UNUSED uint unused0, UNUSED uint unused1) {
         do_motion(MOTION_LEFT, MOTION_RIGHT, "Left", "Right");
         do_motion(MOTION_CLOCKWISE, MOTION_C_CLOCKWISE, "Clockwise",
                 "Anti-clockwise");
+        if (batch_commands) {
+            send_batch(false);
+        }
 
         // Reset the counters
         for (uint32_t i = 0; i < N_COUNTERS; i++) {
@@ -232,6 +314,9 @@ static void timer_callback(UNUSED uint unused0, UNUSED uint unused1) {
         do_update(MOTION_LEFT, MOTION_RIGHT, "Left", "Right");
         do_update(MOTION_CLOCKWISE, MOTION_C_CLOCKWISE, "Clockwise",
                 "Anti-clockwise");
+        if (batch_commands) {
+            send_batch(true);
+        }
     }
 }
 
@@ -246,6 +331,15 @@ static void read_parameters(motor_control_config_t *config_region) {
     delay_time = config_region->delay_time;
     delta_threshold = config_region->delta_threshold;
     continue_if_not_different = config_region->continue_if_not_different;
+    batch_commands = config_region->batch_commands;
+    batch_interval = config_region->batch_interval;
+    batch_delta_threshold = config_region->batch_delta_threshold;
+
+    // Allow the first batch to be sent straight away
+    batch_time = UINT32_MAX - batch_interval;
+    for (uint32_t i = 0; i < N_AXES; i++) {
+        batch_sent[i] = 0;
+    }
 
     // Allocate the space for the schedule
     counters = spin1_malloc(N_COUNTERS * sizeof(int));
@@ -260,6 +354,9 @@ static void read_parameters(motor_control_config_t *config_region) {
             " delay_time = %d, delta_threshold = %d, continue_if_not_different = %d",
             key, speed, sample_time, update_time, delay_time, delta_threshold,
             continue_if_not_different);
+    log_info("Batch commands = %d, batch_interval = %d,"
+            " batch_delta_threshold = %d", batch_commands, batch_interval,
+            batch_delta_threshold);
 }
 
 //! \brief Add incoming spike message (in FIQ) to circular buffer
@@ -0,0 +1,582 @@
+/*
+ * Copyright (c) 2024 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*!
+ * \dir
+ * \brief Implementation of the compact spike source array
+ * \file
+ * \brief Plays back spikes held in SDRAM in a compact form.
+ *
+ * The spikes of each time step that has any are held as a frame, which is
+ * the time step, a word holding the number of spikes and whether they are
+ * held as a bit field, and then either:
+ *
+ * - a bit field of the sources that spike, or
+ * - the index of each source that spikes, in order, as the difference from
+ *   the one before (or from 0 for the first).  Each difference is a run of
+ *   bytes that add up to it, where every byte but the last is 255.  A
+ *   difference of 0 after the first is another spike of the same source.
+ *
+ * The frames of all the time steps are held at once, so nothing needs to be
+ * sent from the host while running.
+ *
+ * If a pattern period is given, the frames are a pattern that is played
+ * again every period, with the time steps of the frames relative to the
+ * start of each repetition.  Each repetition can start late by a random
+ * number of time steps, up to the pattern jitter.
+ *
+ * If the sources are the only input of a synapse type of a population on the
+ * same chip, the spikes are added to the weights of the sources instead, and
+ * the sum written to SDRAM for the neurons to read, as the Poisson source
+ * does.
+ */
+
+#include <common/send_mc.h>
+#include <data_specification.h>
+#include <recording.h>
+#include <debug.h>
+#include <simulation.h>
+#include <spin1_api.h>
+#include <bit_field.h>
+#include <random.h>
+
+//! spike source array region IDs in human readable form
+typedef enum region {
+    SYSTEM,               //!< simulation interface master control
+    SPIKE_ARRAY_PARAMS,   //!< application configuration; spike_array_params
+    SPIKE_FRAMES,         //!< the spikes to send; spike_frame
+    SPIKE_HISTORY_REGION, //!< spike history recording region
+    SDRAM_EDGE_PARAMS,    //!< where to send input over SDRAM; sdram_config
+} region;
+
+//! Priorities of the callbacks
+typedef enum callback_priorities {
+    //! Handling SDP messages
+    SDP = 0,
+    //! Handling DMA completion
+    DMA = 1,
+    //! The timer
+    TIMER = 2
+} callback_priorities;
+
+//! DMA tags
+enum ssa_dma_tags {
+    //! Writing the input of this timestep to SDRAM
+    DMA_TAG_WRITE_INPUT
+};
+
+//! The flag in the information of a frame that says it is a bit field
+#define FRAME_IS_BIT_FIELD 0x80000000
+
+//! The mask of the number of spikes in the information of a frame
+#define FRAME_N_SPIKES_MASK 0x7FFFFFFF
+
+//! A byte of a difference that is not the last byte of it
+#define DIFFERENCE_CONTINUES 255
+
+//! The parameters of the spike source array
+typedef struct spike_array_params {
+    //! Whether the spikes are to be sent
+    uint32_t has_key;
+    //! The number of sources
+    uint32_t n_sources;
+    //! The number of bits of the keys used for colour
+    uint32_t n_colour_bits;
+    //! The most times any one source spikes in one time step
+    uint32_t max_spikes_per_source;
+    //! The number of frames
+    uint32_t n_frames;
+    //! The period at which the pattern repeats, or 0 to play it once
+    uint32_t pattern_period;
+    //! The most time steps a repetition of the pattern can start late by
+    uint32_t pattern_jitter;
+    //! The seed of the random start of each repetition
+    mars_kiss64_seed_t pattern_seed;
+    //! The key of each source
+    uint32_t keys[];
+} spike_array_params;
+
+//! The spikes of one time step
+typedef struct spike_frame {
+    //! The time step of the spikes
+    uint32_t time;
+    //! The number of spikes, and whether they are held as a bit field
+    uint32_t info;
+    //! The spikes
+    uint32_t data[];
+} spike_frame;
+
+//! A region of SDRAM used to transfer synapses; as for the Poisson source
+struct sdram_config {
+    //! The address of the input data to be transferred
+    uint32_t *address;
+    //! The size of the input data to be transferred
+    uint32_t size_in_bytes;
+    //! The offset into the data to write the weights (to account for different
+    //! synapse types)
+    uint32_t offset;
+    //! The weight to send for each source
+    uint16_t weights[];
+};
+
+//! data structure for recording spikes
+typedef struct timed_out_spikes {
+    //! Time of recording
+    uint32_t time;
+    //! Number of spike-recording buffers
+    uint32_t n_buffers;
+    //! Spike recording buffers; sort of a bit_field_t[]
+    uint32_t out_spikes[];
+} timed_out_spikes;
+
+//! The keys of the sources
+static uint32_t *keys;
+
+//! Whether the spikes are to be sent
+static bool has_key;
+
+//! The number of sources
+static uint32_t n_sources;
+
+//! The mask of the colour in the keys
+static uint32_t colour_mask;
+
+//! The colour of the current time step
+static uint32_t colour;
+
+//! The number of frames
+static uint32_t n_frames;
+
+//! The first frame
+static const spike_frame *first_frame;
+
+//! The next frame to be played
+static const spike_frame *next_frame;
+
+//! The index of the next frame to be played
+static uint32_t next_frame_index;
+
+//! The period at which the pattern repeats, or 0 to play it once
+static uint32_t pattern_period;
+
+//! The most time steps a repetition of the pattern can start late by
+static uint32_t pattern_jitter;
+
+//! The seed of the pattern jitter as loaded, used again on reset
+static mars_kiss64_seed_t initial_pattern_seed;
+
+//! The seed of the pattern jitter
+static mars_kiss64_seed_t pattern_seed;
+
+//! The time step the current repetition of the pattern started at
+static uint32_t pattern_start;
+
+//! The time step the next repetition of the pattern would start at if late
+//! by nothing
+static uint32_t next_pattern_base;
+
+//! The time step the next repetition of the pattern starts at
+static uint32_t next_pattern_start;
+
+//! keeps track of which types of recording should be done to this model.
+static uint32_t recording_flags = 0;
+
+//! the current time step
+static uint32_t time;
+
+//! the number of timer ticks that this model should run for before exiting.
+static uint32_t simulation_ticks = 0;
+
+//! the int that represents the bool for if the run is infinite or not.
+static uint32_t infinite_run;
+
+//! The timer period
+static uint32_t timer_period;
+
+//! The recorded spikes
+static timed_out_spikes *spikes = NULL;
+
+//! The number of recording spike buffers that have been allocated
+static uint32_t n_spike_buffers_allocated;
+
+//! The number of words needed for 1 bit per source
+static uint32_t n_spike_buffer_words;
+
+//! Where synaptic input is to be written
+static struct sdram_config *sdram_inputs;
+
+//! The inputs to be sent at the end of this timestep
+static uint16_t *input_this_timestep;
+
+//! The number of times the weights of the spikes saturated the input
+static uint32_t n_saturations = 0;
+
+//! \brief Get a spike recording buffer
+//! \param[in] n: the spike array index
+//! \return bit field at the location n
+static inline bit_field_t out_spikes_bitfield(uint32_t n) {
+    return &spikes->out_spikes[n * n_spike_buffer_words];
+}
+
+//! \brief Reset the spike buffers that have been used by clearing them
+static inline void reset_spikes(void) {
+    for (uint32_t n = spikes->n_buffers; n > 0; n--) {
+        clear_bit_field(out_spikes_bitfield(n - 1), n_spike_buffer_words);
+    }
+    spikes->n_buffers = 0;
+}
+
+//! \brief Send and record a spike of a source
+//! \param[in] index: The index of the source
+//! \param[in] repeat: How many times the source has already spiked in this
+//!     time step
+static inline void spike(uint32_t index, uint32_t repeat) {
+    if (index >= n_sources) {
+        return;
+    }
+    if (has_key) {
+        send_spike_mc(keys[index] | colour);
+    }
+    if (sdram_inputs->address != 0) {
+        uint32_t accumulation = input_this_timestep[
+                sdram_inputs->offset + index] + sdram_inputs->weights[index];
+        if (accumulation & 0xFFFF0000) {
+            accumulation = 0xFFFF;
+            n_saturations++;
+        }
+        input_this_timestep[sdram_inputs->offset + index] =
+                (uint16_t) accumulation;
+    }
+    if ((recording_flags > 0) && (repeat < n_spike_buffers_allocated)) {
+        bit_field_set(out_spikes_bitfield(repeat), index);
+        if (spikes->n_buffers <= repeat) {
+            spikes->n_buffers = repeat + 1;
+        }
+    }
+}
+
+//! \brief Go through the spikes of a frame
+//! \param[in] frame: The frame
+//! \param[in] do_spikes:
+//!     Whether to send and record the spikes, or just to skip over them
+//! \return The frame after the given one
+static const spike_frame *process_frame(
+        const spike_frame *frame, bool do_spikes) {
+    if (frame->info & FRAME_IS_BIT_FIELD) {
+        if (do_spikes) {
+            for (uint32_t w = 0; w < n_spike_buffer_words; w++) {
+                uint32_t bits = frame->data[w];
+                while (bits != 0) {
+                    uint32_t bit = __builtin_ctz(bits);
+                    bits &= bits - 1;
+                    spike((w << 5) + bit, 0);
+                }
+            }
+        }
+        return (const spike_frame *) &frame->data[n_spike_buffer_words];
+    }
+
+    uint32_t n_spikes = frame->info & FRAME_N_SPIKES_MASK;
+    const uint8_t *bytes = (const uint8_t *) frame->data;
+    uint32_t n_bytes = 0;
+    uint32_t index = 0;
+    uint32_t repeat = 0;
+    for (uint32_t s = 0; s < n_spikes; s++) {
+        uint32_t difference = 0;
+        uint32_t byte;
+        do {
+            byte = bytes[n_bytes++];
+            difference += byte;
+        } while (byte == DIFFERENCE_CONTINUES);
+        if ((s > 0) && (difference == 0)) {
+            repeat++;
+        } else {
+            repeat = 0;
+        }
+        index += difference;
+        if (do_spikes) {
+            spike(index, repeat);
+        }
+    }
+    return (const spike_frame *) &frame->data[(n_bytes + 3) >> 2];
+}
+
+//! \brief Move to the first frame at or after a time step
+//! \param[in] next_time: The time step to move to
+static void seek_frames(uint32_t next_time) {
+    next_frame = first_frame;
+    next_frame_index = 0;
+    while ((next_frame_index < n_frames) && (next_frame->time < next_time)) {
+        next_frame = process_frame(next_frame, false);
+        next_frame_index++;
+    }
+}
+
+//! \brief Get how late a repetition of the pattern starts
+//! \return A random number of time steps, from 0 to the jitter inclusive
+static inline uint32_t pattern_offset(void) {
+    if (pattern_jitter == 0) {
+        return 0;
+    }
+    return ((uint64_t) mars_kiss64_seed(pattern_seed) *
+            (uint64_t) (pattern_jitter + 1)) >> 32;
+}
+
+//! \brief Start the next repetition of the pattern
+static inline void start_repetition(void) {
+    pattern_start = next_pattern_start;
+    next_pattern_base += pattern_period;
+    next_pattern_start = next_pattern_base + pattern_offset();
+    seek_frames(0);
+}
+
+//! \brief Play the spikes again from the start
+static void reset_playback(void) {
+    pattern_start = 0;
+    if (pattern_period == 0) {
+        seek_frames(0);
+        return;
+    }
+
+    // Nothing is played until the first repetition starts
+    spin1_memcpy(pattern_seed, initial_pattern_seed,
+            sizeof(mars_kiss64_seed_t));
+    next_pattern_base = 0;
+    next_pattern_start = pattern_offset();
+    next_frame_index = n_frames;
+}
+
+//! \brief Read the parameters of the spike source array
+//! \param[in] sdram_params: The parameters in SDRAM
+//! \param[in] frames: The frames in SDRAM
+//! \return Whether the parameters were read successfully
+static bool read_parameters(
+        const spike_array_params *sdram_params, const spike_frame *frames) {
+    has_key = sdram_params->has_key;
+    n_sources = sdram_params->n_sources;
+    colour_mask = (1 << sdram_params->n_colour_bits) - 1;
+    n_frames = sdram_params->n_frames;
+    first_frame = frames;
+    pattern_period = sdram_params->pattern_period;
+    pattern_jitter = sdram_params->pattern_jitter;
+    spin1_memcpy(initial_pattern_seed, sdram_params->pattern_seed,
+            sizeof(mars_kiss64_seed_t));
+
+    uint32_t keys_size = n_sources * sizeof(uint32_t);
+    keys = spin1_malloc(keys_size);
+    if (keys == NULL) {
+        log_error("Could not allocate %u bytes for the keys", keys_size);
+        return false;
+    }
+    spin1_memcpy(keys, sdram_params->keys, keys_size);
+
+    n_spike_buffer_words = get_bit_field_size(n_sources);
+    n_spike_buffers_allocated = sdram_params->max_spikes_per_source;
+    uint32_t spikes_size = sizeof(timed_out_spikes) + (
+            n_spike_buffers_allocated * n_spike_buffer_words *
+            sizeof(uint32_t));
+    spikes = spin1_malloc(spikes_size);
+    if (spikes == NULL) {
+        log_error("Could not allocate %u bytes for recording spikes",
+                spikes_size);
+        return false;
+    }
+    spikes->n_buffers = n_spike_buffers_allocated;
+    reset_spikes();
+
+    log_info("%u sources with %u frames of spikes", n_sources, n_frames);
+    if (pattern_period > 0) {
+        log_info("Pattern repeats every %u time steps with jitter %u",
+                pattern_period, pattern_jitter);
+    }
+    return true;
+}
+
+//! \brief Read where to send the input over SDRAM, if anywhere
+//! \param[in] sdram_conf: The configuration in SDRAM
+//! \return Whether the configuration was read successfully
+static bool read_sdram_config(const struct sdram_config *sdram_conf) {
+    uint32_t sdram_inputs_size = sizeof(struct sdram_config) + (
+            n_sources * sizeof(uint16_t));
+    sdram_inputs = spin1_malloc(sdram_inputs_size);
+    if (sdram_inputs == NULL) {
+        log_error("Could not allocate %u bytes for SDRAM inputs",
+                sdram_inputs_size);
+        return false;
+    }
+    spin1_memcpy(sdram_inputs, sdram_conf, sdram_inputs_size);
+    if (sdram_inputs->size_in_bytes != 0) {
+        input_this_timestep = spin1_malloc(sdram_inputs->size_in_bytes);
+        if (input_this_timestep == NULL) {
+            log_error("Could not allocate %u bytes for input this timestep",
+                    sdram_inputs->size_in_bytes);
+            return false;
+        }
+        sark_word_set(input_this_timestep, 0, sdram_inputs->size_in_bytes);
+        log_info("Writing input to 0x%08x, %u bytes, offset in half-words %u",
+                sdram_inputs->address, sdram_inputs->size_in_bytes,
+                sdram_inputs->offset);
+    }
+    return true;
+}
+
+//! \brief Initialise the model by reading in the regions.
+//! \return Whether it successfully read all the regions and set up
+//!     all its internal data structures.
+static bool initialize(void) {
+    log_info("Initialise: started");
+
+    // Get the address this core's DTCM data starts at from SRAM
+    data_specification_metadata_t *ds_regions =
+            data_specification_get_data_address();
+
+    // Read the header
+    if (!data_specification_read_header(ds_regions)) {
+        return false;
+    }
+
+    // Get the timing details and set up the simulation interface
+    if (!simulation_initialise(
+            data_specification_get_region(SYSTEM, ds_regions),
+            APPLICATION_NAME_HASH, &timer_period, &simulation_ticks,
+            &infinite_run, &time, SDP, DMA)) {
+        return false;
+    }
+
+    // setup recording region
+    void *recording_region = data_specification_get_region(
+            SPIKE_HISTORY_REGION, ds_regions);
+    if (!recording_initialize(&recording_region, &recording_flags)) {
+        return false;
+    }
+
+    if (!read_parameters(
+            data_specification_get_region(SPIKE_ARRAY_PARAMS, ds_regions),
+            data_specification_get_region(SPIKE_FRAMES, ds_regions))) {
+        return false;
+    }
+
+    if (!read_sdram_config(data_specification_get_region(
+            SDRAM_EDGE_PARAMS, ds_regions))) {
+        return false;
+    }
+    reset_playback();
+
+    log_info("Initialise: completed successfully");
+    return true;
+}
+
+//! \brief Run any functions needed at resume time.
+static void resume_callback(void) {
+    recording_reset();
+
+    // If we are resetting, play the frames from the start again
+    if (time == UINT32_MAX) {
+        reset_playback();
+    }
+
+    log_info("Successfully resumed spike source array at time: %u", time);
+}
+
+//! \brief Timer interrupt callback
+//! \param[in] timer_count: the number of times this call back has been
+//!     executed since start of simulation
+//! \param[in] unused: unused parameter kept for API consistency
+static void timer_callback(UNUSED uint timer_count, UNUSED uint unused) {
+    time++;
+
+    log_debug("Timer tick %u", time);
+
+    // If a fixed number of simulation ticks are specified and these have passed
+    if (simulation_is_finished()) {
+        // go into pause and resume state to avoid another tick
+        simulation_handle_pause_resume(resume_callback);
+
+        // Finalise any recordings that are in progress, writing back the final
+        // amounts of samples recorded to SDRAM
+        if (recording_flags > 0) {
+            recording_finalise();
+        }
+
+        if (n_saturations > 0) {
+            log_warning("The input over SDRAM saturated %u times",
+                    n_saturations);
+        }
+
+        // Subtract 1 from the time so this tick gets done again on the next
+        // run
+        time--;
+        simulation_ready_to_read();
+        return;
+    }
+
+    // Set the colour for the time step
+    colour = time & colour_mask;
+
+    // Start the next repetition of the pattern if it is due
+    if ((pattern_period > 0) && (time >= next_pattern_start)) {
+        start_repetition();
+    }
+
+    // Clear the input of the last time step
+    if (sdram_inputs->address != 0) {
+        sark_word_set(input_this_timestep, 0, sdram_inputs->size_in_bytes);
+    }
+
+    // Play the frame of this time step, if there is one
+    uint32_t pattern_time = time - pattern_start;
+    while ((next_frame_index < n_frames) &&
+            (next_frame->time <= pattern_time)) {
+        next_frame = process_frame(
+                next_frame, next_frame->time == pattern_time);
+        next_frame_index++;
+    }
+
+    // If transferring over SDRAM, transfer now
+    if (sdram_inputs->address != 0) {
+        spin1_dma_transfer(DMA_TAG_WRITE_INPUT, sdram_inputs->address,
+                input_this_timestep, DMA_WRITE, sdram_inputs->size_in_bytes);
+    }
+
+    // Record output spikes if required
+    if ((recording_flags > 0) && (spikes->n_buffers > 0)) {
+        spikes->time = time;
+        recording_record(0, spikes, sizeof(timed_out_spikes) + (
+                spikes->n_buffers * n_spike_buffer_words * sizeof(uint32_t)));
+        reset_spikes();
+    }
+}
+
+//! The entry point for this model
+void c_main(void) {
+    // Load DTCM data
+    time = 0;
+    if (!initialize()) {
+        log_error("Error in initialisation - exiting!");
+        rt_error(RTE_SWERR);
+    }
+
+    // Start the time at "-1" so that the first tick will be 0
+    time = UINT32_MAX;
+
+    // Set timer tick (in microseconds)
+    spin1_set_timer_tick(timer_period);
+
+    // Register callback
+    spin1_callback_on(TIMER_TICK, timer_callback, TIMER);
+
+    simulation_run();
+}
@@ -19,6 +19,11 @@
  * \brief Implementation of the Poisson spike source
  * \file
  * \brief This file contains the main functions for a Poisson spike generator.
+ *
+ * If the host gives a correlated rate, the sources are correlated: a shared
+ * "mother" Poisson process is generated once per time step for the whole
+ * core, and each source keeps each of its spikes with a probability that is
+ * the rate of the source over the rate of the mother process.
  */
 
 #include <common/maths-util.h>
@@ -65,6 +70,12 @@ typedef struct spike_source_t {
     uint32_t mean_isi_ticks;
     //! Planned time to spike, in ticks
     uint32_t time_to_spike_ticks;
+    //! \brief The tick at which a slow source next spikes, or ::END_OF_TIME
+    //!     if it is not in the queue of slow sources
+    uint32_t next_spike_tick;
+    //! \brief The chance of keeping each spike of the mother process when
+    //!     the sources are correlated, out of 2<sup>32</sup>
+    uint32_t correlated_keep;
 } spike_source_t;
 
 //! \brief data structure for recording spikes
@@ -96,6 +107,32 @@ typedef enum region {
 //! A scale factor to allow the use of integers for "inter-spike intervals"
 #define ISI_SCALE_FACTOR 1000
 
+#ifndef POISSON_PLAIN_SINGLE_SPIKES
+//! \brief Whether a source that spikes once in a time step sends a packet
+//!     without a payload; more spikes are always sent as one packet with the
+//!     count as the payload
+#define POISSON_PLAIN_SINGLE_SPIKES 1
+#endif
+
+#ifndef POISSON_PREFETCH_RATES
+//! \brief Whether the rates that follow the current rate of each source are
+//!     read from SDRAM by DMA in the background, so that moving on to the
+//!     next rate in a time step does not wait for SDRAM reads
+#define POISSON_PREFETCH_RATES 0
+#endif
+
+//! The number of rates of each source to prefetch (the next rate, and the one
+//! after it, which gives when the next rate ends)
+#define N_PREFETCHED_RATES 2
+
+//! DMA tags
+enum ssp_dma_tags {
+    //! Writing the input of this timestep to SDRAM
+    DMA_TAG_WRITE_INPUT,
+    //! Reading prefetched rates from SDRAM
+    DMA_TAG_READ_RATES
+};
+
 //! Priorities for interrupt handlers
 typedef enum ssp_callback_priorities {
     //! Multicast packet reception uses the FIQ
@@ -138,6 +175,13 @@ typedef struct global_parameters {
     uint32_t max_spikes_per_tick;
     //! Number of bits to use for colour
     uint32_t n_colour_bits;
+    //! \brief The rate per tick of the mother process of correlated
+    //!     sources, or 0 if the sources are independent
+    UREAL correlated_rate_per_tick;
+    //! exp(-&lambda;) of the mother process, if it is not a faster source
+    UFRACT correlated_exp_minus_lambda;
+    //! sqrt(&lambda;) of the mother process, if it is a faster source
+    UREAL correlated_sqrt_lambda;
     //! The seed for the Poisson generation process
     rng_seed_t spike_source_seed;
 } global_parameters;
@@ -169,6 +213,23 @@ typedef struct source_info {
     source_details details[];
 } source_info;
 
+#if POISSON_PREFETCH_RATES
+//! \brief A DTCM copy of where a source is in its rates, and of the rates
+//!     that follow, filled in by DMA
+typedef struct prefetched_rates {
+    //! The number of rates of the source
+    uint32_t n_rates;
+    //! Where in the array of rate descriptors we are
+    uint32_t index;
+    //! The index of the rate at the start of ::details
+    uint32_t first;
+    //! The number of rates in ::details that have arrived
+    uint32_t n_ready;
+    //! The rates from index ::first
+    source_details details[N_PREFETCHED_RATES];
+} prefetched_rates;
+#endif
+
 typedef struct source_expand_details {
     //! The number of items to expand
     uint32_t count;
@@ -209,6 +270,26 @@ static source_info **source_data;
 //! The currently applied rate descriptors
 static spike_source_t *source;
 
+#if POISSON_PREFETCH_RATES
+//! The prefetched rates of each source
+static prefetched_rates *prefetched;
+
+//! The IDs of the sources waiting for their rates to be prefetched
+static circular_buffer prefetch_queue;
+
+//! Whether a prefetch DMA is in progress
+static bool prefetch_busy = false;
+
+//! The source being prefetched by the DMA in progress
+static uint32_t prefetch_id;
+
+//! The index of the first rate being prefetched by the DMA in progress
+static uint32_t prefetch_first;
+
+//! The number of rates being prefetched by the DMA in progress
+static uint32_t prefetch_n;
+#endif
+
 //! keeps track of which types of recording should be done to this model.
 static uint32_t recording_flags = 0;
 
@@ -259,26 +340,192 @@ static uint32_t colour_mask;
 //! (only when doing SDRAM transfers)
 static uint32_t n_saturations = 0;
 
+//! Marker for a source that is not in the queue of slow sources
+#define NOT_QUEUED 0xFFFF
+
+//! \brief The slow sources that will spike, as a binary heap ordered by the
+//!     tick of the next spike and then by source ID
+static uint16_t *slow_queue;
+
+//! The number of sources in ::slow_queue
+static uint32_t n_slow_queued = 0;
+
+//! The position of each source in ::slow_queue, or ::NOT_QUEUED
+static uint16_t *slow_queue_index;
+
+//! The IDs of the fast sources, in increasing order
+static uint16_t *fast_source_ids;
+
+//! The number of sources in ::fast_source_ids
+static uint32_t n_fast_sources = 0;
+
+//! The sources that have had their rate set since they were last queued
+static bit_field_t sources_to_queue;
+
+//! Whether any bit is set in ::sources_to_queue
+static bool any_sources_to_queue = false;
+
+//! The earliest time at which any source moves on to its next rate
+static uint32_t next_rate_change_ticks = 0;
+
+//! \brief Whether a source should come out of the queue before another
+//! \param[in] a: The ID of the first source
+//! \param[in] b: The ID of the second source
+//! \return True if \p a spikes before \p b, or at the same time and has the
+//!     lower ID
+static inline bool queue_before(uint32_t a, uint32_t b) {
+    uint32_t a_tick = source[a].next_spike_tick;
+    uint32_t b_tick = source[b].next_spike_tick;
+    return (a_tick < b_tick) || ((a_tick == b_tick) && (a < b));
+}
+
+//! \brief Put a source at a position in the queue
+//! \param[in] pos: The position in the heap
+//! \param[in] s_id: The ID of the source
+static inline void queue_place(uint32_t pos, uint32_t s_id) {
+    slow_queue[pos] = s_id;
+    slow_queue_index[s_id] = pos;
+}
+
+//! \brief Move a source towards the top of the queue until it is in order
+//! \param[in] pos: The position that is free for the source
+//! \param[in] s_id: The ID of the source
+static inline void queue_sift_up(uint32_t pos, uint32_t s_id) {
+    while (pos > 0) {
+        uint32_t parent = (pos - 1) >> 1;
+        uint32_t parent_id = slow_queue[parent];
+        if (!queue_before(s_id, parent_id)) {
+            break;
+        }
+        queue_place(pos, parent_id);
+        pos = parent;
+    }
+    queue_place(pos, s_id);
+}
+
+//! \brief Move a source towards the bottom of the queue until it is in order
+//! \param[in] pos: The position that is free for the source
+//! \param[in] s_id: The ID of the source
+static inline void queue_sift_down(uint32_t pos, uint32_t s_id) {
+    while (true) {
+        uint32_t child = (pos << 1) + 1;
+        if (child >= n_slow_queued) {
+            break;
+        }
+        uint32_t child_id = slow_queue[child];
+        if ((child + 1) < n_slow_queued
+                && queue_before(slow_queue[child + 1], child_id)) {
+            child++;
+            child_id = slow_queue[child];
+        }
+        if (!queue_before(child_id, s_id)) {
+            break;
+        }
+        queue_place(pos, child_id);
+        pos = child;
+    }
+    queue_place(pos, s_id);
+}
+
+//! \brief Put a source back in order in the queue after it has been moved
+//!     to a given position or its next spike tick has changed
+//! \param[in] pos: The position of the source
+//! \param[in] s_id: The ID of the source
+static inline void queue_restore(uint32_t pos, uint32_t s_id) {
+    if ((pos > 0) && queue_before(s_id, slow_queue[(pos - 1) >> 1])) {
+        queue_sift_up(pos, s_id);
+    } else {
+        queue_sift_down(pos, s_id);
+    }
+}
+
+//! \brief Take a source out of the queue if it is in it
+//! \param[in] s_id: The ID of the source
+static inline void queue_remove(uint32_t s_id) {
+    uint32_t pos = slow_queue_index[s_id];
+    if (pos == NOT_QUEUED) {
+        return;
+    }
+    slow_queue_index[s_id] = NOT_QUEUED;
+    n_slow_queued--;
+    if (pos != n_slow_queued) {
+        queue_restore(pos, slow_queue[n_slow_queued]);
+    }
+}
+
+//! \brief Work out when a slow source next spikes and queue it for that tick
+//! \details The time to spike only counts down in ticks where the source is
+//!     active, so this matches visiting the source on every tick.
+//! \param[in] s_id: The ID of the source
+//! \param[in] first_tick: The first tick at which the source will count
+//!     down its time to spike
+static inline void queue_slow_source(uint32_t s_id, uint32_t first_tick) {
+    spike_source_t *p = &source[s_id];
+    uint32_t from = (first_tick > p->start_ticks) ? first_tick : p->start_ticks;
+    if ((p->mean_isi_ticks != 0) && (from < p->end_ticks)) {
+        uint32_t ticks = p->time_to_spike_ticks / ISI_SCALE_FACTOR;
+        if (ticks < (p->end_ticks - from)) {
+            p->time_to_spike_ticks -= ticks * ISI_SCALE_FACTOR;
+            p->next_spike_tick = from + ticks;
+            uint32_t pos = slow_queue_index[s_id];
+            if (pos == NOT_QUEUED) {
+                queue_sift_up(n_slow_queued++, s_id);
+            } else {
+                queue_restore(pos, s_id);
+            }
+            return;
+        }
+    }
+
+    // The source will not spike before the end of its current rate
+    p->next_spike_tick = END_OF_TIME;
+    queue_remove(s_id);
+}
+
+//! \brief Queue the sources whose rates have been set, and list the fast
+//!     sources in order of ID
+//! \param[in] first_tick: The tick about to be processed
+static void queue_new_sources(uint32_t first_tick) {
+    n_fast_sources = 0;
+    for (uint32_t s_id = 0; s_id < ssp_params.n_spike_sources; s_id++) {
+        if (source[s_id].is_fast_source) {
+            fast_source_ids[n_fast_sources++] = s_id;
+            queue_remove(s_id);
+        } else if (bit_field_test(sources_to_queue, s_id)) {
+            queue_slow_source(s_id, first_tick);
+        }
+    }
+    clear_bit_field(sources_to_queue,
+            get_bit_field_size(ssp_params.n_spike_sources));
+    any_sources_to_queue = false;
+}
+
 //! \brief Random number generation for the Poisson sources.
 //!        This is a local version for speed of operation.
+//! \details When processing all the sources in a time step, \p seed is a
+//!     local copy of the seed, so that with everything inlined the state
+//!     stays in registers rather than being loaded and stored for every
+//!     number.
+//! \param[in,out] seed: The seed to update
 //! \return A random number
-static inline uint32_t rng(void) {
-    ssp_params.spike_source_seed.x = 314527869 * ssp_params.spike_source_seed.x + 1234567;
-    ssp_params.spike_source_seed.y ^= ssp_params.spike_source_seed.y << 5;
-    ssp_params.spike_source_seed.y ^= ssp_params.spike_source_seed.y >> 7;
-    ssp_params.spike_source_seed.y ^= ssp_params.spike_source_seed.y << 22;
-    uint64_t t = 4294584393ULL * ssp_params.spike_source_seed.z + ssp_params.spike_source_seed.c;
-    ssp_params.spike_source_seed.c = t >> 32;
-    ssp_params.spike_source_seed.z = t;
-
-    return (uint32_t) ssp_params.spike_source_seed.x
-            + ssp_params.spike_source_seed.y + ssp_params.spike_source_seed.z;
+static inline uint32_t rng(rng_seed_t *seed) {
+    seed->x = 314527869 * seed->x + 1234567;
+    seed->y ^= seed->y << 5;
+    seed->y ^= seed->y >> 7;
+    seed->y ^= seed->y << 22;
+    uint64_t t = 4294584393ULL * seed->z + seed->c;
+    seed->c = t >> 32;
+    seed->z = t;
+
+    return (uint32_t) seed->x + seed->y + seed->z;
 }
 
 //! \brief How many spikes to generate for a fast Poisson source
 //! \param[in] exp_minus_lambda e^(-mean_rate)
+//! \param[in,out] seed: The random seed to use
 //! \return How many spikes to generate
-static inline uint32_t n_spikes_poisson_fast(UFRACT exp_minus_lambda) {
+static inline uint32_t n_spikes_poisson_fast(
+        UFRACT exp_minus_lambda, rng_seed_t *seed) {
     UFRACT p = UFRACT_CONST(1.0);
     uint32_t k = 0;
 
@@ -286,28 +533,29 @@ static inline uint32_t n_spikes_poisson_fast(UFRACT exp_minus_lambda) {
         k++;
         //  p = p * ulrbits(uni_rng(seed_arg));
         // Possibly faster multiplication by using DRL's routines
-        p = ulrbits(__stdfix_smul_ulr(bitsulr(p), rng()));
+        p = ulrbits(__stdfix_smul_ulr(bitsulr(p), rng(seed)));
     } while (bitsulr(p) > bitsulr(exp_minus_lambda));
     return k - 1;
 }
 
 //! \brief How many time steps until the next spike for a slow Poisson source
+//! \param[in,out] seed: The random seed to use
 //! \return The number of time steps until the next spike
-static inline REAL n_steps_until_next(void) {
+static inline REAL n_steps_until_next(rng_seed_t *seed) {
     REAL A = REAL_CONST(0.0);
     uint32_t U, U0, USTAR;
 
     while (true) {
-        U = rng();
+        U = rng(seed);
         U0 = U;
 
         do {
-            USTAR = rng();
+            USTAR = rng(seed);
             if (U < USTAR) {
                 return A + (REAL) ulrbits(U0);
             }
 
-            U = rng();
+            U = rng(seed);
         } while (U < USTAR);
 
         A += 1.0k;
@@ -319,12 +567,13 @@ static inline REAL n_steps_until_next(void) {
 //!     until the next spike is to occur given the mean inter-spike interval
 //! \param[in] mean_inter_spike_interval_in_ticks: The mean number of ticks
 //!     before a spike is expected to occur in a slow process.
+//! \param[in,out] seed: The random seed to use
 //! \return "time" in timer ticks * ISI_SCALE_FACTOR until the next spike occurs
 static inline uint32_t slow_spike_source_get_time_to_spike(
-        uint32_t mean_inter_spike_interval_in_ticks) {
+        uint32_t mean_inter_spike_interval_in_ticks, rng_seed_t *seed) {
     // Round (dist variate * ISI_SCALE_FACTOR), convert to uint32
     uint32_t value = (uint32_t) roundk(
-            n_steps_until_next() * ISI_SCALE_FACTOR, (15));
+            n_steps_until_next(seed) * ISI_SCALE_FACTOR, (15));
     // Now multiply by the mean ISI
     uint32_t exp_variate = value * mean_inter_spike_interval_in_ticks;
     // Note that this will be compared to ISI_SCALE_FACTOR in the main loop!
@@ -335,15 +584,16 @@ static inline uint32_t slow_spike_source_get_time_to_spike(
 //!     source
 //! \param[in] exp_minus_lambda: exp(-&lambda;), &lambda; is amount of spikes
 //!     expected to be produced this timer interval (timer tick in real time)
+//! \param[in,out] seed: The random seed to use
 //! \return the number of spikes to transmit this timer tick
 static inline uint32_t fast_spike_source_get_num_spikes(
-        UFRACT exp_minus_lambda) {
+        UFRACT exp_minus_lambda, rng_seed_t *seed) {
     // If the value of exp_minus_lambda is very small then it's not worth
     // using the algorithm, so just return 0
     if (bitsulr(exp_minus_lambda) == bitsulr(UFRACT_CONST(0.0))) {
         return 0;
     }
-    return n_spikes_poisson_fast(exp_minus_lambda);
+    return n_spikes_poisson_fast(exp_minus_lambda, seed);
 }
 
 //! \brief Determine how many spikes to transmit this timer tick, for a faster
@@ -351,11 +601,12 @@ static inline uint32_t fast_spike_source_get_num_spikes(
 //!     instead of a Poisson)
 //! \param[in] sqrt_lambda: Square root of the amount of spikes expected to be
 //!     produced this timer interval (timer tick in real time)
+//! \param[in,out] seed: The random seed to use
 //! \return The number of spikes to transmit this timer tick
 static inline uint32_t faster_spike_source_get_num_spikes(
-        REAL sqrt_lambda) {
+        REAL sqrt_lambda, rng_seed_t *seed) {
     // First we do x = (inv_gauss_cdf(U(0, 1)) * 0.5) + sqrt(lambda)
-    uint32_t U = rng();
+    uint32_t U = rng(seed);
     REAL x = (norminv_urt(U) * HALF) + sqrt_lambda;
     // Then we return int(roundk(x * x))
     return (uint32_t) roundk(x * x, 15);
@@ -365,7 +616,8 @@ static inline uint32_t faster_spike_source_get_num_spikes(
 //! \param[in] id: the ID of the source to be updated
 //! \param[in] rate:
 //!     the rate in Hz, to be multiplied to get per-tick values
-void set_spike_source_rate(uint32_t sub_id, UREAL rate) {
+//! \param[in,out] seed: The random seed to use
+void set_spike_source_rate(uint32_t sub_id, UREAL rate, rng_seed_t *seed) {
 
     UREAL rate_per_tick = ukbits(
             (__U64(bitsuk(rate)) * __U64(bitsulr(ssp_params.seconds_per_tick))) >> 32);
@@ -400,8 +652,24 @@ void set_spike_source_rate(uint32_t sub_id, UREAL rate) {
         spike_source->sqrt_lambda = 0.0K;
         spike_source->is_fast_source = 0;
         spike_source->time_to_spike_ticks =
-                slow_spike_source_get_time_to_spike(spike_source->mean_isi_ticks);
+                slow_spike_source_get_time_to_spike(
+                        spike_source->mean_isi_ticks, seed);
     }
+
+    // Work out the chance of keeping each spike of the mother process
+    UREAL mother_rate = ssp_params.correlated_rate_per_tick;
+    if (bitsuk(mother_rate) == 0) {
+        spike_source->correlated_keep = 0;
+    } else if (rate_per_tick >= mother_rate) {
+        spike_source->correlated_keep = UINT32_MAX;
+    } else {
+        spike_source->correlated_keep = (uint32_t) (
+                (__U64(bitsuk(rate_per_tick)) << 32) / bitsuk(mother_rate));
+    }
+
+    // Put the source in the right place in the queue on the next tick
+    bit_field_set(sources_to_queue, sub_id);
+    any_sources_to_queue = true;
 }
 
 // ----------------------------------------------------------------------
@@ -421,13 +689,91 @@ static inline uint32_t ms_to_ticks(unsigned long accum ms) {
     return (uint32_t) ((ms * ssp_params.ticks_per_ms) + 0.5k);
 }
 
-static inline void set_spike_source_details(uint32_t id, bool rate_changed) {
+#if POISSON_PREFETCH_RATES
+//! \brief Start the DMA for the next source waiting for a prefetch, if any
+//! \note Called with interrupts disabled or from the DMA callback
+static void start_next_prefetch(void) {
+    uint32_t id;
+    while (circular_buffer_get_next(prefetch_queue, &id)) {
+        prefetched_rates *p = &prefetched[id];
+        // Skip sources that are already done, or that no longer need it
+        if ((p->n_ready > 0) || (p->first >= p->n_rates)) {
+            continue;
+        }
+        prefetch_id = id;
+        prefetch_first = p->first;
+        prefetch_n = p->n_rates - p->first;
+        if (prefetch_n > N_PREFETCHED_RATES) {
+            prefetch_n = N_PREFETCHED_RATES;
+        }
+        prefetch_busy = true;
+        spin1_dma_transfer(DMA_TAG_READ_RATES,
+                &source_data[id]->details[prefetch_first], p->details,
+                DMA_READ, prefetch_n * sizeof(source_details));
+        return;
+    }
+    prefetch_busy = false;
+}
+
+//! \brief Called when a prefetch DMA has completed
+//! \param unused: unused
+//! \param tag: unused
+static void prefetch_complete_callback(UNUSED uint unused, UNUSED uint tag) {
+    // If the source has moved on while this was in progress, the rates are
+    // not the ones it wants, and it has been queued again
+    prefetched_rates *p = &prefetched[prefetch_id];
+    if (p->first == prefetch_first) {
+        p->n_ready = prefetch_n;
+    }
+    start_next_prefetch();
+}
+
+//! \brief Ask for the rates of a source from a given index to be prefetched
+//! \param[in] id: The ID of the source
+//! \param[in] first: The index of the first rate to prefetch
+static inline void prefetch_rates(uint32_t id, uint32_t first) {
+    uint32_t state = spin1_int_disable();
+    prefetched_rates *p = &prefetched[id];
+    p->first = first;
+    p->n_ready = 0;
+    // If the queue is full, the rates are read directly from SDRAM instead
+    if ((first < p->n_rates) && circular_buffer_add(prefetch_queue, id)
+            && !prefetch_busy) {
+        start_next_prefetch();
+    }
+    spin1_mode_restore(state);
+}
+#endif
+
+//! \brief Get a rate descriptor of a source
+//! \param[in] id: The ID of the source
+//! \param[in] index: The index of the rate descriptor
+//! \return The descriptor, from the prefetched rates if they are there, or
+//!     else from SDRAM
+static inline source_details *rate_details(uint32_t id, uint32_t index) {
+#if POISSON_PREFETCH_RATES
+    prefetched_rates *p = &prefetched[id];
+    if ((index >= p->first) && ((index - p->first) < p->n_ready)) {
+        return &p->details[index - p->first];
+    }
+#endif
+    return &source_data[id]->details[index];
+}
+
+static inline void set_spike_source_details(
+        uint32_t id, bool rate_changed, rng_seed_t *seed) {
+#if POISSON_PREFETCH_RATES
+    uint32_t index = prefetched[id].index;
+    uint32_t n_rates = prefetched[id].n_rates;
+#else
     uint32_t index = source_data[id]->index;
+    uint32_t n_rates = source_data[id]->n_rates;
+#endif
     log_debug("Source %u is at index %u", id, index);
-    source_details details = source_data[id]->details[index];
+    source_details details = *rate_details(id, index);
     if (rate_changed) {
         log_debug("Setting rate of %u to %k at %u", id, (s1615) details.rate, time);
-        set_spike_source_rate(id, details.rate);
+        set_spike_source_rate(id, details.rate, seed);
     }
     spike_source_t *p = &(source[id]);
     p->start_ticks = ms_to_ticks(details.start);
@@ -440,14 +786,19 @@ static inline void set_spike_source_details(uint32_t id, bool rate_changed) {
         p->end_ticks = p->start_ticks + duration_ticks;
         log_debug("Duration of %u is %u, end = %u", id, duration_ticks, p->end_ticks);
     }
-    if ((index + 1) >= source_data[id]->n_rates) {
+    if ((index + 1) >= n_rates) {
         log_debug("Next of %u never happens", id);
         p->next_ticks = END_OF_TIME;
     } else {
-        accum next_start = source_data[id]->details[index + 1].start;
+        accum next_start = rate_details(id, index + 1)->start;
         p->next_ticks = ms_to_ticks(next_start);
         log_debug("Next of %u at %u", id, p->next_ticks);
     }
+
+#if POISSON_PREFETCH_RATES
+    // Fetch the next rate, and when it ends, ready for moving on to it
+    prefetch_rates(id, index + 1);
+#endif
 }
 
 //! \brief Set specific spikes for recording
@@ -480,6 +831,7 @@ static void print_spike_source(index_t s) {
     log_info("sqrt_lambda = %K", p->sqrt_lambda);
     log_info("isi_val = %u", p->mean_isi_ticks);
     log_info("time_to_spike = %u", p->time_to_spike_ticks);
+    log_info("next_spike_tick = %u", p->next_spike_tick);
 }
 
 //! Print all spike sources
@@ -525,6 +877,10 @@ static bool read_global_parameters(global_parameters *sdram_globals) {
             ssp_params.slow_rate_per_tick_cutoff);
     log_info("fast_rate_per_tick_cutoff = %K",
             ssp_params.fast_rate_per_tick_cutoff);
+    if (bitsuk(ssp_params.correlated_rate_per_tick) != 0) {
+        log_info("correlated with mother rate per tick = %K",
+                ssp_params.correlated_rate_per_tick);
+    }
 #if LOG_LEVEL >= LOG_DEBUG
     for (uint32_t i = 0; i < ssp_params.n_spike_sources; i++) {
         log_debug("Key %u: 0x%08x", i, keys[i]);
@@ -537,11 +893,22 @@ static bool read_global_parameters(global_parameters *sdram_globals) {
 
 //! \brief Get the next chunk of rates read
 //! \param[in] id: The spike source ID
-static inline void read_next_rates(uint32_t id) {
+//! \param[in,out] seed: The random seed to use
+static inline void read_next_rates(uint32_t id, rng_seed_t *seed) {
+#if POISSON_PREFETCH_RATES
+    // Use the DTCM copy of the index, but keep SDRAM up to date as it is
+    // checked when the rates are read again
+    if (prefetched[id].index < prefetched[id].n_rates) {
+        prefetched[id].index++;
+        source_data[id]->index = prefetched[id].index;
+        set_spike_source_details(id, true, seed);
+    }
+#else
     if (source_data[id]->index < source_data[id]->n_rates) {
         source_data[id]->index++;
-        set_spike_source_details(id, true);
+        set_spike_source_details(id, true, seed);
     }
+#endif
 }
 
 //! \brief Read the rates of the Poisson.
@@ -569,6 +936,42 @@ static bool read_rates(source_info *sdram_sources, bool rate_changed, uint32_t n
                 return false;
             }
 
+            // Allocate the queue of slow sources and the list of fast ones;
+            // source IDs must fit in the 16-bit entries
+            if (ssp_params.n_spike_sources >= NOT_QUEUED) {
+                log_error("Too many sources (%u) to queue",
+                        ssp_params.n_spike_sources);
+                return false;
+            }
+            uint32_t n_queue_bytes =
+                    ssp_params.n_spike_sources * sizeof(uint16_t);
+            slow_queue = spin1_malloc(n_queue_bytes);
+            slow_queue_index = spin1_malloc(n_queue_bytes);
+            fast_source_ids = spin1_malloc(n_queue_bytes);
+            sources_to_queue = bit_field_alloc(ssp_params.n_spike_sources);
+            if (slow_queue == NULL || slow_queue_index == NULL
+                    || fast_source_ids == NULL || sources_to_queue == NULL) {
+                log_error("Failed to allocate the source queues");
+                return false;
+            }
+            for (uint32_t i = 0; i < ssp_params.n_spike_sources; i++) {
+                slow_queue_index[i] = NOT_QUEUED;
+                source[i].next_spike_tick = END_OF_TIME;
+            }
+            clear_bit_field(sources_to_queue,
+                    get_bit_field_size(ssp_params.n_spike_sources));
+
+#if POISSON_PREFETCH_RATES
+            prefetched = spin1_malloc(
+                    ssp_params.n_spike_sources * sizeof(prefetched_rates));
+            prefetch_queue = circular_buffer_initialize(
+                    (ssp_params.n_spike_sources * 2) + 1);
+            if (prefetched == NULL || prefetch_queue == NULL) {
+                log_error("Failed to allocate the prefetched rates");
+                return false;
+            }
+#endif
+
             // Copy the address of each source
             source_info *sdram_source = sdram_sources;
             for (uint32_t i = 0; i < ssp_params.n_spike_sources; i++) {
@@ -590,7 +993,22 @@ static bool read_rates(source_info *sdram_sources, bool rate_changed, uint32_t n
             }
             bool new_index = source_data[i]->index != index;
             source_data[i]->index = index;
-            set_spike_source_details(i, rate_changed || new_index);
+#if POISSON_PREFETCH_RATES
+            // The rates in SDRAM might have changed, so drop any prefetched
+            prefetched[i].n_rates = n_rates;
+            prefetched[i].index = index;
+            prefetched[i].n_ready = 0;
+#endif
+            set_spike_source_details(i, rate_changed || new_index,
+                    &ssp_params.spike_source_seed);
+        }
+
+        // Find when the first source moves on to its next rate
+        next_rate_change_ticks = END_OF_TIME;
+        for (uint32_t i = 0; i < ssp_params.n_spike_sources; i++) {
+            if (source[i].next_ticks < next_rate_change_ticks) {
+                next_rate_change_ticks = source[i].next_ticks;
+            }
         }
     }
     log_info("read_poisson_parameters: completed successfully");
@@ -717,6 +1135,11 @@ static bool initialize(void) {
         return false;
     }
 
+#if POISSON_PREFETCH_RATES
+    simulation_dma_transfer_done_callback_on(
+            DMA_TAG_READ_RATES, prefetch_complete_callback);
+#endif
+
     // Setup regions that specify spike source array data
     if (!read_global_parameters(
             data_specification_get_region(POISSON_PARAMS, ds_regions))) {
@@ -825,6 +1248,19 @@ static void resume_callback(void) {
 #endif
 }
 
+//! \brief Send the spikes of a source in this time step as one packet
+//! \param[in] key: The key to send
+//! \param[in] n_spikes: The number of times the source has spiked
+static inline void send_spikes(uint32_t key, uint32_t n_spikes) {
+#if POISSON_PLAIN_SINGLE_SPIKES
+    if (n_spikes == 1) {
+        send_spike_mc(key);
+        return;
+    }
+#endif
+    send_spike_mc_payload(key, n_spikes);
+}
+
 //! \brief records spikes as needed
 //! \param[in] neuron_id: the neurons to store spikes from
 //! \param[in] n_spikes: the number of times this neuron has spiked
@@ -863,10 +1299,29 @@ static inline void add_sdram_spikes(uint32_t s_id, uint32_t num_spikes) {
 	input_this_timestep[sdram_inputs->offset + s_id] = (uint16_t) accumulation;
 }
 
+//! \brief Record and send the spikes of a source in this time step
+//! \param[in] s_id: Source ID
+//! \param[in] n_spikes: The number of times the source has spiked
+static inline void source_spikes(uint32_t s_id, uint32_t n_spikes) {
+    // Write spike to out spikes
+    mark_spike(s_id, n_spikes);
+
+    // If no key has been given, do not send spikes to fabric
+    if (ssp_params.has_key) {
+        // Send spikes
+        const uint32_t spike_key = keys[s_id] | colour;
+        send_spikes(spike_key, n_spikes);
+    } else if (sdram_inputs->address != 0) {
+        add_sdram_spikes(s_id, n_spikes);
+    }
+}
+
 //! \brief Handle a fast spike source
 //! \param s_id: Source ID
 //! \param source: Source descriptor
-static void process_fast_source(index_t s_id, spike_source_t *source) {
+//! \param[in,out] seed: The random seed to use
+static inline void process_fast_source(
+        index_t s_id, spike_source_t *source, rng_seed_t *seed) {
     if ((time >= source->start_ticks) && (time < source->end_ticks)) {
         // Get number of spikes to send this tick
         uint32_t num_spikes = 0;
@@ -877,7 +1332,7 @@ static void process_fast_source(index_t s_id, spike_source_t *source) {
             profiler_write_entry_disable_irq_fiq(
                     PROFILER_ENTER | PROFILER_PROB_FUNC);
             num_spikes = faster_spike_source_get_num_spikes(
-                    source->sqrt_lambda);
+                    source->sqrt_lambda, seed);
             profiler_write_entry_disable_irq_fiq(
                     PROFILER_EXIT | PROFILER_PROB_FUNC);
         } else {
@@ -885,7 +1340,7 @@ static void process_fast_source(index_t s_id, spike_source_t *source) {
             profiler_write_entry_disable_irq_fiq(
                     PROFILER_ENTER | PROFILER_PROB_FUNC);
             num_spikes = fast_spike_source_get_num_spikes(
-                    source->exp_minus_lambda);
+                    source->exp_minus_lambda, seed);
             profiler_write_entry_disable_irq_fiq(
                     PROFILER_EXIT | PROFILER_PROB_FUNC);
         }
@@ -894,57 +1349,106 @@ static void process_fast_source(index_t s_id, spike_source_t *source) {
 
         // If there are any
         if (num_spikes > 0) {
-            // Write spike to out spikes
-            mark_spike(s_id, num_spikes);
-
-            // If no key has been given, do not send spikes to fabric
-            if (ssp_params.has_key) {
-                // Send spikes
-                const uint32_t spike_key = keys[s_id] | colour;
-                send_spike_mc_payload(spike_key, num_spikes);
-            } else if (sdram_inputs->address != 0) {
-            	add_sdram_spikes(s_id, num_spikes);
-            }
+            source_spikes(s_id, num_spikes);
         }
     }
 }
 
-//! \brief Handle a slow spike source
+//! \brief Handle a slow spike source that is due to spike in this tick
+//! \details The source is only taken from the queue when it is active and
+//!     its time to spike is below the scale factor, so it spikes at least
+//!     once; it is then queued again for its next spike.
 //! \param s_id: Source ID
 //! \param source: Source descriptor
-static void process_slow_source(index_t s_id, spike_source_t *source) {
-    if ((time >= source->start_ticks) && (time < source->end_ticks)
-            && (source->mean_isi_ticks != 0)) {
-        uint32_t count = 0;
-        // Mark a spike while the "timer" is below the scale factor value
-        while (source->time_to_spike_ticks < ISI_SCALE_FACTOR) {
-            count++;
+//! \param[in,out] seed: The random seed to use
+static inline void process_slow_source(
+        index_t s_id, spike_source_t *source, rng_seed_t *seed) {
+    uint32_t count = 0;
+    // Mark a spike while the "timer" is below the scale factor value
+    while (source->time_to_spike_ticks < ISI_SCALE_FACTOR) {
+        count++;
+
+        // Update time to spike (note, this might not get us back above
+        // the scale factor, particularly if the mean_isi is smaller)
+        profiler_write_entry_disable_irq_fiq(
+                PROFILER_ENTER | PROFILER_PROB_FUNC);
+        source->time_to_spike_ticks +=
+                slow_spike_source_get_time_to_spike(
+                        source->mean_isi_ticks, seed);
+        profiler_write_entry_disable_irq_fiq(
+                PROFILER_EXIT | PROFILER_PROB_FUNC);
+    }
 
-            // Update time to spike (note, this might not get us back above
-            // the scale factor, particularly if the mean_isi is smaller)
-            profiler_write_entry_disable_irq_fiq(
-                    PROFILER_ENTER | PROFILER_PROB_FUNC);
-            source->time_to_spike_ticks +=
-                    slow_spike_source_get_time_to_spike(source->mean_isi_ticks);
-            profiler_write_entry_disable_irq_fiq(
-                    PROFILER_EXIT | PROFILER_PROB_FUNC);
+    source_spikes(s_id, count);
+
+    // Now we have finished for this tick, subtract the scale factor and
+    // queue the source for when it next spikes
+    source->time_to_spike_ticks -= ISI_SCALE_FACTOR;
+    queue_slow_source(s_id, time + 1);
+}
+
+//! \brief Process every fast source and the slow sources that spike in this
+//!     tick, in order of source ID so that the random numbers are used in the
+//!     same order as when visiting every source
+//! \param[in,out] seed: The random seed to use
+static inline void process_independent_sources(rng_seed_t *seed) {
+    uint32_t next_fast = 0;
+    while (true) {
+        uint32_t fast_id = NOT_QUEUED;
+        if (next_fast < n_fast_sources) {
+            fast_id = fast_source_ids[next_fast];
         }
-        if (count) {
-            // Write spike to out_spikes
-            mark_spike(s_id, count);
-
-            // if no key has been given, do not send spike to fabric.
-            if (ssp_params.has_key) {
-                // Send package
-                const uint32_t spike_key = keys[s_id] | colour;
-                send_spike_mc_payload(spike_key, count);
-            } else if (sdram_inputs->address != 0) {
-                add_sdram_spikes(s_id, count);
-            }
+        uint32_t slow_id = NOT_QUEUED;
+        if ((n_slow_queued > 0)
+                && (source[slow_queue[0]].next_spike_tick <= time)) {
+            slow_id = slow_queue[0];
         }
+        if (fast_id < slow_id) {
+            process_fast_source(fast_id, &source[fast_id], seed);
+            next_fast++;
+        } else if (slow_id != NOT_QUEUED) {
+            process_slow_source(slow_id, &source[slow_id], seed);
+        } else {
+            break;
+        }
+    }
+}
+
+//! \brief Handle every source as a thinned copy of the mother process shared
+//!     by the sources of the core
+//! \details Each spike of the mother process is kept by each active source
+//!     with a Bernoulli draw, so the sources share some of their spikes.
+//! \param[in,out] seed: The random seed to use
+static inline void process_correlated_sources(rng_seed_t *seed) {
+    profiler_write_entry_disable_irq_fiq(PROFILER_ENTER | PROFILER_PROB_FUNC);
+    uint32_t n_mother;
+    if (REAL_COMPARE(ssp_params.correlated_sqrt_lambda, >, ZERO)) {
+        n_mother = faster_spike_source_get_num_spikes(
+                ssp_params.correlated_sqrt_lambda, seed);
+    } else {
+        n_mother = fast_spike_source_get_num_spikes(
+                ssp_params.correlated_exp_minus_lambda, seed);
+    }
+    profiler_write_entry_disable_irq_fiq(PROFILER_EXIT | PROFILER_PROB_FUNC);
+    if (n_mother == 0) {
+        return;
+    }
 
-        // Now we have finished for this tick, subtract the scale factor
-        source->time_to_spike_ticks -= ISI_SCALE_FACTOR;
+    for (index_t s_id = 0; s_id < ssp_params.n_spike_sources; s_id++) {
+        spike_source_t *p = &source[s_id];
+        if ((time < p->start_ticks) || (time >= p->end_ticks)) {
+            continue;
+        }
+        uint32_t keep = p->correlated_keep;
+        uint32_t count = 0;
+        for (uint32_t m = n_mother; m > 0; m--) {
+            if (rng(seed) < keep) {
+                count++;
+            }
+        }
+        if (count > 0) {
+            source_spikes(s_id, count);
+        }
     }
 }
 
@@ -986,13 +1490,17 @@ static void timer_callback(UNUSED uint timer_count, UNUSED uint unused) {
     // Set the colour for the time step
     colour = time & colour_mask;
 
+    // Work on a local copy of the seed for the whole time step, including
+    // the rate changes, so that there is only one generator state
+    rng_seed_t seed = ssp_params.spike_source_seed;
+
     // Do any rate changes
     while (circular_buffer_size(rate_change_buffer) >= 2) {
     	uint32_t id = 0;
     	UREAL rate = 0.0k;
     	circular_buffer_get_next(rate_change_buffer, &id);
     	circular_buffer_get_next(rate_change_buffer, (uint32_t *) &rate);
-        set_spike_source_rate(id, rate);
+        set_spike_source_rate(id, rate, &seed);
     }
 
     // Reset the inputs this timestep if using them
@@ -1000,40 +1508,50 @@ static void timer_callback(UNUSED uint timer_count, UNUSED uint unused) {
         sark_word_set(input_this_timestep, 0, sdram_inputs->size_in_bytes);
     }
 
-    // Loop through spike sources and see if they need updating
+    // Loop through spike sources and see if they need updating, if any
+    // source is due to move on to its next rate
     // NOTE: This full loop needs to happen first with processing in a second
     // separate loop.  This is to ensure that the random generator use matches
     // between a single run and a split run (as slow sources can produce
     // multiple spikes in a single time step).
-    for (index_t s_id = 0; s_id < ssp_params.n_spike_sources; s_id++) {
-        spike_source_t *spike_source = &source[s_id];
-
-        // Move to the next tick now if needed
-        if (time >= spike_source->next_ticks) {
-            log_debug("Moving to next rate at time %d", time);
-            read_next_rates(s_id);
+    if (time >= next_rate_change_ticks) {
+        next_rate_change_ticks = END_OF_TIME;
+        for (index_t s_id = 0; s_id < ssp_params.n_spike_sources; s_id++) {
+            spike_source_t *spike_source = &source[s_id];
+
+            // Move to the next tick now if needed
+            if (time >= spike_source->next_ticks) {
+                log_debug("Moving to next rate at time %d", time);
+                read_next_rates(s_id, &seed);
 #if LOG_LEVEL >= LOG_DEBUG
-            print_spike_source(s_id);
+                print_spike_source(s_id);
 #endif
+            }
+            if (spike_source->next_ticks < next_rate_change_ticks) {
+                next_rate_change_ticks = spike_source->next_ticks;
+            }
         }
     }
 
-    // Loop through the sources and process them
-    for (index_t s_id = 0; s_id < ssp_params.n_spike_sources; s_id++) {
-        spike_source_t *spike_source = &source[s_id];
-        if (spike_source->is_fast_source) {
-            process_fast_source(s_id, spike_source);
-        } else {
-            process_slow_source(s_id, spike_source);
-        }
+    // Queue any sources that have had their rate set
+    if (any_sources_to_queue) {
+        queue_new_sources(time);
+    }
+
+    // Process the sources
+    if (bitsuk(ssp_params.correlated_rate_per_tick) != 0) {
+        process_correlated_sources(&seed);
+    } else {
+        process_independent_sources(&seed);
     }
+    ssp_params.spike_source_seed = seed;
 
     profiler_write_entry_disable_irq_fiq(PROFILER_EXIT | PROFILER_TIMER);
 
     // If transferring over SDRAM, transfer now
     if (sdram_inputs->address != 0) {
-        spin1_dma_transfer(0, sdram_inputs->address, input_this_timestep,
-                DMA_WRITE, sdram_inputs->size_in_bytes);
+        spin1_dma_transfer(DMA_TAG_WRITE_INPUT, sdram_inputs->address,
+                input_this_timestep, DMA_WRITE, sdram_inputs->size_in_bytes);
     }
 
     // Record output spikes if required
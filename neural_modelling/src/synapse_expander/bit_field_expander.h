@@ -17,17 +17,22 @@
 //! \file
 //! \brief Expands bitfields on SpiNNaker to reduce data transfer times
 #include <bit_field.h>
+#include <stdfix-full-iso.h>
 #include <neuron/synapse_row.h>
+#include <neuron/post_index.h>
 #include <neuron/population_table/population_table.h>
 #include <neuron/structural_plasticity/synaptogenesis/sp_structs.h>
 #include <filter_info.h>
 #include <key_atom_map.h>
+#include "matrix_generator.h"
 
 /***************************************************************/
 
 static uint32_t master_pop_table_length;
 static master_population_table_entry* master_pop_table;
-static address_list_entry *address_list;
+static void *address_list;
+static uint32_t *entry_starts;
+static bool extended_format;
 
 //! \brief Read row and test if there are any synapses
 //! \param[in] row_data: The DTCM address to read into
@@ -73,11 +78,60 @@ static inline void determine_redundancy(filter_region_t *bitfield_filters) {
     }
 }
 
+//! \brief Write the order in which to load the bit fields into DTCM, so
+//!     that if there isn't space for all of them, those that filter the most
+//!     spikes per word of DTCM are loaded
+//! \param[in] bitfield_filters: The bit fields made
+//! \param[in] rates: The expected spikes per second of each atom of each
+//!     source, in the order of the bit fields
+//! \param[out] order: Where to write the indices of the bit fields in the
+//!     order to load them
+static inline void write_load_order(filter_region_t *bitfield_filters,
+        accum *rates, uint32_t *order) {
+    filter_info_t *filters = bitfield_filters->filters;
+    uint32_t n_filters = bitfield_filters->n_filters;
+    uint32_t *scores = spin1_malloc(2 * n_filters * sizeof(uint32_t));
+    if (scores == NULL) {
+        log_warning("Could not allocate dtcm to order the bit fields");
+        for (uint32_t i = 0; i < n_filters; i++) {
+            order[i] = i;
+        }
+        return;
+    }
+    uint32_t *local_order = &scores[n_filters];
+
+    // The spikes filtered per second per word; those that filter nothing
+    // are left to last
+    for (uint32_t i = 0; i < n_filters; i++) {
+        uint32_t score = 0;
+        if (!filters[i].merged && !filters[i].all_ones) {
+            uint32_t n_words = get_bit_field_size(filters[i].n_atoms);
+            uint32_t n_empty = filters[i].n_atoms -
+                    count_bit_field(filters[i].data, n_words);
+            uint64_t per_word = ((uint64_t) bitsk(rates[i]) * n_empty) / n_words;
+            score = (per_word > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32_t) per_word;
+        }
+
+        // Insertion sort, highest first; equal scores keep the key order
+        uint32_t j = i;
+        while (j > 0 && scores[j - 1] < score) {
+            scores[j] = scores[j - 1];
+            local_order[j] = local_order[j - 1];
+            j--;
+        }
+        scores[j] = score;
+        local_order[j] = i;
+    }
+    spin1_memcpy(order, local_order, n_filters * sizeof(uint32_t));
+    sark_free(scores);
+}
+
 //! \brief Create the bitfield for this master pop table and synaptic matrix.
 //! \return Whether it was successful at generating the bitfield
 static inline bool generate_bit_field(filter_region_t *bitfield_filters,
         uint32_t *n_atom_data, void *synaptic_matrix, void *structural_matrix,
-        pre_pop_info_table_t *pre_info, synaptic_row_t row_data) {
+        pre_pop_info_table_t *pre_info, synaptic_row_t row_data,
+        uint32_t **load_order) {
 
     // Get the location just after the structs for the actual bit fields
     uint32_t *bit_field_words_location = (uint32_t *)
@@ -115,16 +169,29 @@ static inline bool generate_bit_field(filter_region_t *bitfield_filters,
         } else {
 
 			// Go through the addresses of the master pop entry
-			uint32_t pos = mp_entry.start;
+			uint32_t pos = extended_format ? entry_starts[i] : mp_entry.start;
 			for (uint32_t j = mp_entry.count; j > 0; j--, pos++) {
 
 				// Find the base address and row length of the address entry
-				address_list_entry entry = address_list[pos];
+				uint32_t offset, row_length;
 
 				// Skip invalid addresses
-				if (entry.address == INVALID_ADDRESS) {
+				if (!get_address_list_item(address_list, extended_format, pos,
+				        &offset, &row_length)) {
 					continue;
 				}
+				uint32_t block_address = offset + (uint32_t) synaptic_matrix;
+
+				// Rows generated here were recorded as they were written, so
+				// only rows generated on the host have to be read back
+				pop_table_lookup_result_t result;
+				get_block_row_addr_and_size(block_address, row_length,
+				        0, &result);
+				uint32_t first_row = 0;
+				const written_rows_t *rows = matrix_generator_find_rows(
+				        result.row_address,
+				        result.n_bytes_to_transfer / sizeof(uint32_t),
+				        &first_row);
 
 				// Go through each neuron and check the row
 				for (uint32_t n = 0; n < n_neurons; n++) {
@@ -134,8 +201,14 @@ static inline bool generate_bit_field(filter_region_t *bitfield_filters,
 						continue;
 					}
 
-					pop_table_lookup_result_t result;
-					get_row_addr_and_size(entry, (uint32_t) synaptic_matrix,
+					if (rows != NULL && (first_row + n) < rows->n_rows) {
+						if (written_rows_has_synapses(rows, first_row + n)) {
+							bit_field_set(bit_field, n);
+						}
+						continue;
+					}
+
+					get_block_row_addr_and_size(block_address, row_length,
 					        n, &result);
 
 					// Check if the row is non-empty and if so set a bit
@@ -165,13 +238,120 @@ static inline bool generate_bit_field(filter_region_t *bitfield_filters,
 
     // write how many entries (thus bitfields) have been generated into sdram
     bitfield_filters->n_filters = master_pop_table_length;
+
+    // The load order goes after the last bit field
+    *load_order = &bit_field_words_location[position];
+    return true;
+}
+
+//! \brief Go through the plastic synapses of every row of the matrix, and
+//!     either count those of each neuron or add them to the index
+//! \param[in,out] index: The index being built
+//! \param[in] n_atom_data: The number of rows of each master pop entry
+//! \param[in] synaptic_matrix: The synaptic matrix
+//! \param[in] row_data: Where to read each row into
+//! \param[in,out] next: The number of synapses of each neuron found so far
+//!     when counting, or the next entry of each neuron when adding
+//! \param[in] add: Whether to add the synapses to the index
+static void index_plastic_synapses(post_index_t *index, uint32_t *n_atom_data,
+        void *synaptic_matrix, synaptic_row_t row_data, uint32_t *next,
+        bool add) {
+    uint32_t index_mask = (1 << index->synapse_index_bits) - 1;
+    uint32_t type_mask = (1 << index->synapse_type_bits) - 1;
+    post_index_entry_t *entries = post_index_entries(index);
+    for (uint32_t i = 0; i < master_pop_table_length; i++) {
+        master_population_table_entry mp_entry = master_pop_table[i];
+        uint32_t pos = extended_format ? entry_starts[i] : mp_entry.start;
+        for (uint32_t j = mp_entry.count; j > 0; j--, pos++) {
+            uint32_t offset, row_length;
+            if (!get_address_list_item(address_list, extended_format, pos,
+                    &offset, &row_length)) {
+                continue;
+            }
+            uint32_t block_address = offset + (uint32_t) synaptic_matrix;
+            for (uint32_t n = 0; n < n_atom_data[i]; n++) {
+                pop_table_lookup_result_t result;
+                get_block_row_addr_and_size(block_address, row_length, n,
+                        &result);
+                spin1_memcpy(row_data, result.row_address,
+                        result.n_bytes_to_transfer);
+                if (synapse_row_plastic_size(row_data) == 0) {
+                    continue;
+                }
+                synapse_row_fixed_part_t *fixed_region =
+                        synapse_row_fixed_region(row_data);
+                uint32_t n_plastic =
+                        synapse_row_num_plastic_controls(fixed_region);
+                control_t *controls =
+                        synapse_row_plastic_controls(fixed_region);
+                for (uint32_t k = 0; k < n_plastic; k++) {
+                    uint32_t neuron = controls[k] & index_mask;
+                    if (neuron >= index->n_neurons) {
+                        continue;
+                    }
+                    if (!add) {
+                        next[neuron]++;
+                        continue;
+                    }
+                    uint32_t e = next[neuron]++;
+                    entries[e].row = result.row_address;
+                    entries[e].synapse_index = k;
+                    entries[e].synapse_type =
+                            (controls[k] >> index->synapse_index_bits)
+                            & type_mask;
+                }
+            }
+        }
+    }
+}
+
+//! \brief Build the index of the plastic synapses of each neuron, reading
+//!     the whole matrix once to count them and again to add them
+//! \param[in,out] index: The index, with the header written by the host
+//! \param[in] n_atom_data: The number of rows of each master pop entry
+//! \param[in] synaptic_matrix: The synaptic matrix
+//! \param[in] row_data: Where to read each row into
+//! \return Whether the index was built
+static bool build_post_index(post_index_t *index, uint32_t *n_atom_data,
+        void *synaptic_matrix, synaptic_row_t row_data) {
+    uint32_t n_neurons = index->n_neurons;
+    uint32_t *next = spin1_malloc((n_neurons + 1) * sizeof(uint32_t));
+    if (next == NULL) {
+        log_error("Could not allocate dtcm to index %u neurons", n_neurons);
+        return false;
+    }
+    for (uint32_t n = 0; n <= n_neurons; n++) {
+        next[n] = 0;
+    }
+    index_plastic_synapses(index, n_atom_data, synaptic_matrix, row_data,
+            next, false);
+
+    // Turn the counts into the start of each neuron
+    uint32_t total = 0;
+    for (uint32_t n = 0; n <= n_neurons; n++) {
+        uint32_t count = next[n];
+        next[n] = total;
+        index->starts[n] = total;
+        total += count;
+    }
+    if (total > index->max_entries) {
+        log_error("The %u plastic synapses are more than the %u indexed",
+                total, index->max_entries);
+        sark_free(next);
+        return false;
+    }
+    index_plastic_synapses(index, n_atom_data, synaptic_matrix, row_data,
+            next, true);
+    log_info("Indexed %u plastic synapses of %u neurons", total, n_neurons);
+    sark_free(next);
     return true;
 }
 
 //! Entry point
 static bool do_bitfield_generation(
         uint32_t *n_atom_data_sdram, void *master_pop,
-        void *synaptic_matrix, void *bitfield_filters, void *structural_matrix) {
+        void *synaptic_matrix, void *bitfield_filters, void *structural_matrix,
+        post_index_t *post_index) {
 
 	pop_table_config_t *config = (pop_table_config_t *) master_pop;
 	master_pop_table_length = config->table_length;
@@ -181,7 +361,9 @@ static bool do_bitfield_generation(
     }
 
     master_pop_table = &config->data[0];
-    address_list = (address_list_entry *) &config->data[master_pop_table_length];
+    address_list = pop_table_address_list(config);
+    extended_format = (config->format == POP_TABLE_EXTENDED_FORMAT);
+    entry_starts = pop_table_extended_starts(config);
 
     uint32_t n_atom_bytes = master_pop_table_length * sizeof(uint32_t);
     uint32_t *n_atom_data = spin1_malloc(n_atom_bytes);
@@ -207,11 +389,24 @@ static bool do_bitfield_generation(
             structural_matrix, &rewiring_data, &pre_info, &post_to_pre_table);
     }
 
+    uint32_t *load_order;
     if (!generate_bit_field(bitfield_filters, n_atom_data, synaptic_matrix,
-            structural_matrix, &pre_info, row_data)) {
+            structural_matrix, &pre_info, row_data, &load_order)) {
         log_error("Failed to generate bit fields");
         return false;
     }
     determine_redundancy(bitfield_filters);
+
+    // The expected rates of the sources follow their numbers of atoms
+    accum *rates = (accum *) &n_atom_data_sdram[master_pop_table_length];
+    write_load_order(bitfield_filters, rates, load_order);
+
+    // The index of the plastic synapses of each neuron is only wanted when
+    // they are to be updated as the neurons spike
+    if (post_index != NULL && !build_post_index(
+            post_index, n_atom_data, synaptic_matrix, row_data)) {
+        log_error("Failed to index the plastic synapses of each neuron");
+        return false;
+    }
     return true;
 }
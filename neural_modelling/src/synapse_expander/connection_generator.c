@@ -33,6 +33,10 @@
 #include "connection_generators/connection_generator_kernel.h"
 #include "connection_generators/connection_generator_all_but_me.h"
 #include "connection_generators/connection_generator_one_to_one_offset.h"
+#include "connection_generators/connection_generator_from_list.h"
+#include "connection_generators/connection_generator_distance_dependent.h"
+#include "connection_generators/connection_generator_index_based.h"
+#include "connection_generators/connection_generator_small_world.h"
 
 //! \brief Known "hashes" of connection generators
 //!
@@ -47,6 +51,10 @@ enum {
     KERNEL,                //!< Convolution kernel connection generator
 	ALL_BUT_ME,            //!< AllButMe connection generator
 	ONE_TO_ONE_OFFSET,     //!< One-to-one offset connection generator
+    FROM_LIST,             //!< From list connection generator
+    DISTANCE_DEPENDENT,    //!< Distance-dependent connection generator
+    INDEX_BASED,           //!< Index-based probability connection generator
+    SMALL_WORLD,           //!< Small world connection generator
     N_CONNECTION_GENERATORS//!< The number of known generators
 };
 
@@ -108,7 +116,23 @@ static const connection_generator_info connection_generators[] = {
 	{ONE_TO_ONE_OFFSET,
 			connection_generator_one_to_one_offset_initialise,
 			connection_generator_one_to_one_offset_generate,
-			connection_generator_one_to_one_offset_free}
+			connection_generator_one_to_one_offset_free},
+    {FROM_LIST,
+            connection_generator_from_list_initialise,
+            connection_generator_from_list_generate,
+            connection_generator_from_list_free},
+    {DISTANCE_DEPENDENT,
+            connection_generator_distance_dependent_initialise,
+            connection_generator_distance_dependent_generate,
+            connection_generator_distance_dependent_free},
+    {INDEX_BASED,
+            connection_generator_index_based_initialise,
+            connection_generator_index_based_generate,
+            connection_generator_index_based_free},
+    {SMALL_WORLD,
+            connection_generator_small_world_initialise,
+            connection_generator_small_world_generate,
+            connection_generator_small_world_free}
 };
 
 connection_generator_t connection_generator_init(
@@ -152,6 +176,21 @@ bool connection_generator_generate(
             weight_generator, delay_generator, matrix_generator);
 }
 
+bool connection_generator_rows_independent(uint32_t hash) {
+    // These draw only from the core RNG, and only loop over the pre-neurons
+    switch (hash) {
+    case ALL_TO_ALL:
+    case FIXED_PROBABILITY:
+    case KERNEL:
+    case DISTANCE_DEPENDENT:
+    case INDEX_BASED:
+    case SMALL_WORLD:
+        return true;
+    default:
+        return false;
+    }
+}
+
 void connection_generator_free(connection_generator_t generator) {
     generator->type->free(generator->data);
     sark_free(generator);
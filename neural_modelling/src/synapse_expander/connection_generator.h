@@ -42,6 +42,15 @@ typedef struct connection_generator *connection_generator_t;
 connection_generator_t connection_generator_init(
         uint32_t hash, void **region);
 
+/**
+ * \brief Determine if a connection generator can generate any range of the
+ *        pre-neurons independently of the rest, given its own RNG, so that
+ *        the ranges can be shared between cores
+ * \param[in] hash: The identifier of the generator
+ * \return Whether the rows of the generator are independent
+ */
+bool connection_generator_rows_independent(uint32_t hash);
+
 /**
  * \brief Finish with a connection generator
  * \param[in] generator: The generator to free
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2024 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file
+ * \brief Distance-Dependent Probability Connection generator implementation
+ *
+ * A restricted family of distance expressions is evaluated directly, and
+ * others the host can compile are evaluated with expression.h.  The neurons
+ * of each population must be laid out on a regular grid (which includes
+ * lines; see lattice.h).
+ */
+
+#include <stdfix-exp.h>
+#include <sqrt.h>
+#include <synapse_expander/rng.h>
+#include <synapse_expander/generator_types.h>
+#include <synapse_expander/expression.h>
+#include <synapse_expander/lattice.h>
+
+// Eclipse does *NOT* like this type!
+typedef unsigned long fract probability_t;
+
+//! The families of distance expression supported
+enum dist_dep_kind {
+    //! p = amplitude if d^2 < max_d2
+    DIST_DEP_STEP,
+    //! p = amplitude * exp(-d * shape)
+    DIST_DEP_EXPONENTIAL,
+    //! p = amplitude * exp(-d^2 * shape)
+    DIST_DEP_GAUSSIAN,
+    //! p = a compiled expression of d * shape, which follows the parameters
+    DIST_DEP_EXPRESSION
+};
+
+//! The parameters that can be copied in from SDRAM
+struct dist_dep_params {
+    uint32_t allow_self_connections;
+    //! The dist_dep_kind of the expression
+    uint32_t kind;
+    //! The largest probability of the expression
+    probability_t amplitude;
+    //! \brief The length scale of the expression, as a multiplier, or for
+    //!     ::DIST_DEP_EXPRESSION the length of a scaled unit
+    accum shape;
+    //! The squared distance beyond which the probability is taken to be 0
+    accum max_d2;
+    //! The layout of the pre-population
+    struct lattice pre;
+    //! The layout of the post-population
+    struct lattice post;
+};
+
+/**
+ * \brief The data structure to be passed around for this connector.
+ */
+struct dist_dep {
+    struct dist_dep_params params;
+    //! The compiled expression of a ::DIST_DEP_EXPRESSION, or NULL
+    expression_t *expression;
+};
+
+/**
+ * \brief Initialise the distance-dependent connection generator
+ * \param[in,out] region: Region to read parameters from.  Should be updated
+ *                        to position just after parameters after calling.
+ * \return A data item to be passed in to other functions later on
+ */
+static void *connection_generator_distance_dependent_initialise(
+        void **region) {
+    // Allocate memory for the data
+    struct dist_dep *obj = spin1_malloc(sizeof(struct dist_dep));
+    if (obj == NULL) {
+        log_error("Could not allocate distance dependent connector");
+        return NULL;
+    }
+
+    // Copy the parameters in
+    struct dist_dep_params *params_sdram = *region;
+    obj->params = *params_sdram;
+    *region = &params_sdram[1];
+    obj->expression = NULL;
+    if (obj->params.kind == DIST_DEP_EXPRESSION) {
+        obj->expression = expression_init(region);
+        if (obj->expression == NULL) {
+            sark_free(obj);
+            return NULL;
+        }
+    }
+
+    log_debug("Distance Dependent Connector, allow self connections = %u, "
+            "kind = %u, amplitude = %k, shape = %k, max_d2 = %k",
+            obj->params.allow_self_connections, obj->params.kind,
+            (accum) obj->params.amplitude, obj->params.shape,
+            obj->params.max_d2);
+    return obj;
+}
+
+/**
+ * \brief Free the distance-dependent connection generator
+ * \param[in] generator: The generator to free
+ */
+static void connection_generator_distance_dependent_free(void *generator) {
+    struct dist_dep *obj = generator;
+    if (obj->expression != NULL) {
+        sark_free(obj->expression);
+    }
+    sark_free(generator);
+}
+
+/**
+ * \brief Get the probability of a connection at a distance
+ * \param[in] obj: The connector
+ * \param[in] d2: The squared distance between the neurons
+ * \param[in] pre: The index of the pre-neuron
+ * \param[in] post: The index of the post-neuron
+ * \return The probability of a connection
+ */
+static inline probability_t dist_dep_probability(
+        const struct dist_dep *obj, accum d2, uint32_t pre, uint32_t post) {
+    const struct dist_dep_params *params = &obj->params;
+    // Beyond this the probability is 0 (or too small to matter)
+    if (d2 >= params->max_d2) {
+        return 0;
+    }
+    accum scale;
+    switch (params->kind) {
+    case DIST_DEP_EXPRESSION: {
+        // The host makes sure that the indices and distance fit in an accum
+        accum vars[EXPR_N_VARS];
+        vars[EXPR_VAR_I] = kbits(pre << 15);
+        vars[EXPR_VAR_J] = kbits(post << 15);
+        vars[EXPR_VAR_D] = sqrtk(d2) * params->shape;
+        scale = expression_evaluate(obj->expression, vars);
+        if (scale <= 0.0k) {
+            return 0;
+        }
+        break;
+    }
+    case DIST_DEP_EXPONENTIAL:
+        scale = expk(-(sqrtk(d2) * params->shape));
+        break;
+    case DIST_DEP_GAUSSIAN:
+        scale = expk(-(d2 * params->shape));
+        break;
+    default:
+        return params->amplitude;
+    }
+
+    // 1.0 won't fit in a probability
+    if (scale >= 1.0k) {
+        return params->amplitude;
+    }
+    return params->amplitude * (probability_t) scale;
+}
+
+/**
+ * \brief Generate connections with the distance-dependent connection generator
+ * \param[in] generator: The generator to use to generate connections
+ * \param[in] pre_lo: The lowest pre-neuron index of the projection
+ * \param[in] pre_hi: The highest pre-neuron index of the projection
+ * \param[in] post_lo: The lowest post-neuron index of the projection
+ * \param[in] post_hi: The highest post-neuron index of the projection
+ * \param[in] post_index: The index of the core being generated for
+ * \param[in] post_slice_start: The start of the slice of the post-population
+ *                              being generated
+ * \param[in] post_slice_count: The number of neurons in the slice of the
+ *                              post-population being generated
+ * \param[in] weight_scale: The scale to apply to the weights
+ * \param[in] timestep_per_delay: The delay value multiplier to get to
+ *                                timesteps
+ * \param[in] weight_generator: The generator of weights
+ * \param[in] delay_generator: The generator of delays
+ * \param[in] matrix_generator: The generator of the matrix to write to
+ * \return Whether generation succeeded
+ */
+static bool connection_generator_distance_dependent_generate(
+        void *generator, uint32_t pre_lo, uint32_t pre_hi,
+        uint32_t post_lo, uint32_t post_hi, UNUSED uint32_t post_index,
+        uint32_t post_slice_start, uint32_t post_slice_count,
+        unsigned long accum weight_scale, accum timestep_per_delay,
+        param_generator_t weight_generator, param_generator_t delay_generator,
+        matrix_generator_t matrix_generator) {
+    struct dist_dep *obj = generator;
+    const struct dist_dep_params *params = &obj->params;
+
+    // Get the actual ranges to generate within
+    uint32_t post_start = max(post_slice_start, post_lo);
+    uint32_t post_end = min(post_slice_start + post_slice_count - 1, post_hi);
+
+    accum pre_pos[N_DIMS];
+    accum post_pos[N_DIMS];
+    for (uint32_t pre = pre_lo; pre <= pre_hi; pre++) {
+        lattice_position(&params->pre, pre, pre_pos);
+        for (uint32_t post = post_start; post <= post_end; post++) {
+            if (pre == post && !params->allow_self_connections) {
+                continue;
+            }
+
+            lattice_position(&params->post, post, post_pos);
+            accum d2 = lattice_distance2(pre_pos, post_pos);
+
+            // Generate a random number
+            probability_t value = ulrbits(rng_generator(core_rng));
+
+            // If less than our probability, generate a connection
+            if (value < dist_dep_probability(obj, d2, pre, post)) {
+                uint32_t local_post = post - post_slice_start;
+                accum weight = param_generator_generate(weight_generator);
+                uint16_t delay = rescale_delay(
+                        param_generator_generate(delay_generator),
+                        timestep_per_delay);
+                if (!matrix_generator_write_synapse(matrix_generator, pre,
+                        local_post, weight, delay, weight_scale)) {
+                    // Retry not useful here
+                    log_warning("Could not add to matrix!");
+                }
+            }
+        }
+    }
+    return true;
+}
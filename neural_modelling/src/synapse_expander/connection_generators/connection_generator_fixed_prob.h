@@ -29,6 +29,11 @@ typedef unsigned long fract probability_t;
 struct fixed_prob_params {
     uint32_t allow_self_connections;
     probability_t probability;
+    //! \brief -1 / ln(1 - probability), scaled up by 2^skip_shift, or 0 to
+    //!     draw a number for every possible connection
+    uint32_t skip_scale;
+    //! The shift of skip_scale
+    uint32_t skip_shift;
 };
 
 /**
@@ -56,8 +61,9 @@ static void *connection_generator_fixed_prob_initialise(void **region) {
     *region = &params_sdram[1];
 
     log_debug("Fixed Probability Connector, allow self connections = %u, "
-            "probability = %k",
-			obj->params.allow_self_connections, (accum) obj->params.probability);
+            "probability = %k, skip scale = %u, skip shift = %u",
+			obj->params.allow_self_connections, (accum) obj->params.probability,
+			obj->params.skip_scale, obj->params.skip_shift);
     return obj;
 }
 
@@ -69,6 +75,103 @@ static void connection_generator_fixed_prob_free(void *generator) {
     sark_free(generator);
 }
 
+/**
+ * \brief Get the number of possible connections to skip before the next
+ *        one that is made, which is geometrically distributed
+ * \param[in] params: The parameters of the connector
+ * \return The number of possible connections to skip
+ */
+static inline uint32_t fixed_prob_skip(const struct fixed_prob_params *params) {
+    // floor(E / -ln(1 - p)) where E is exponentially distributed
+    accum e = rng_exponential(core_rng);
+    uint64_t skip = ((uint64_t) bitsk(e) * params->skip_scale)
+            >> (15 + params->skip_shift);
+    if (skip > UINT32_MAX) {
+        return UINT32_MAX;
+    }
+    return (uint32_t) skip;
+}
+
+/**
+ * \brief Write a connection made by the fixed-probability connection
+ *        generator
+ * \param[in] pre: The pre-neuron of the connection
+ * \param[in] local_post: The core-relative post-neuron of the connection
+ * \param[in] weight_scale: The scale to apply to the weights
+ * \param[in] timestep_per_delay: The delay value multiplier to get to
+ *                                timesteps
+ * \param[in] weight_generator: The generator of weights
+ * \param[in] delay_generator: The generator of delays
+ * \param[in] matrix_generator: The generator of the matrix to write to
+ */
+static inline void fixed_prob_write(
+        uint32_t pre, uint32_t local_post, unsigned long accum weight_scale,
+        accum timestep_per_delay, param_generator_t weight_generator,
+        param_generator_t delay_generator,
+        matrix_generator_t matrix_generator) {
+    accum weight = param_generator_generate(weight_generator);
+    uint16_t delay = rescale_delay(
+            param_generator_generate(delay_generator), timestep_per_delay);
+    if (!matrix_generator_write_synapse(matrix_generator, pre, local_post,
+            weight, delay, weight_scale)) {
+        // Retry not useful here
+        log_warning("Could not add to matrix!");
+    }
+}
+
+/**
+ * \brief Generate connections by skipping between the connections made,
+ *        which needs one random draw per connection rather than one per
+ *        possible connection
+ * \param[in] obj: The connector
+ * \param[in] pre_lo: The first pre-neuron to connect from
+ * \param[in] pre_hi: The last pre-neuron to connect from
+ * \param[in] post_start: The first post-neuron to connect to
+ * \param[in] post_end: The last post-neuron to connect to
+ * \param[in] post_slice_start: The start of the slice of the post-population
+ *                              being generated
+ * \param[in] weight_scale: The scale to apply to the weights
+ * \param[in] timestep_per_delay: The delay value multiplier to get to
+ *                                timesteps
+ * \param[in] weight_generator: The generator of weights
+ * \param[in] delay_generator: The generator of delays
+ * \param[in] matrix_generator: The generator of the matrix to write to
+ */
+static void fixed_prob_generate_skip(
+        struct fixed_prob *obj, uint32_t pre_lo, uint32_t pre_hi,
+        uint32_t post_start, uint32_t post_end, uint32_t post_slice_start,
+        unsigned long accum weight_scale, accum timestep_per_delay,
+        param_generator_t weight_generator, param_generator_t delay_generator,
+        matrix_generator_t matrix_generator) {
+    uint32_t n_post = post_end - post_start + 1;
+    uint32_t pre = pre_lo;
+    uint32_t post_offset = 0;
+    while (true) {
+        // Move through the rows to the next connection; this is bounded by
+        // the number of rows, whatever the skip
+        uint32_t skip = fixed_prob_skip(&obj->params);
+        while (skip >= n_post - post_offset) {
+            skip -= n_post - post_offset;
+            post_offset = 0;
+            pre++;
+            if (pre > pre_hi) {
+                return;
+            }
+        }
+        post_offset += skip;
+
+        uint32_t post = post_start + post_offset;
+        if (pre != post || obj->params.allow_self_connections) {
+            fixed_prob_write(pre, post - post_slice_start, weight_scale,
+                    timestep_per_delay, weight_generator, delay_generator,
+                    matrix_generator);
+        }
+
+        // The next possible connection is the one after this
+        post_offset++;
+    }
+}
+
 /**
  * \brief Generate connections with the fixed-probability connection generator
  * \param[in] generator: The generator to use to generate connections
@@ -100,6 +203,16 @@ static bool connection_generator_fixed_prob_generate(
     // Get the actual ranges to generate within
     uint32_t post_start = max(post_slice_start, post_lo);
     uint32_t post_end = min(post_slice_start + post_slice_count - 1, post_hi);
+    if (post_start > post_end) {
+        return true;
+    }
+
+    if (obj->params.skip_scale != 0) {
+        fixed_prob_generate_skip(obj, pre_lo, pre_hi, post_start, post_end,
+                post_slice_start, weight_scale, timestep_per_delay,
+                weight_generator, delay_generator, matrix_generator);
+        return true;
+    }
 
     for (uint32_t pre = pre_lo; pre <= pre_hi; pre++) {
         for (uint32_t post = post_start; post <= post_end; post++) {
@@ -112,15 +225,9 @@ static bool connection_generator_fixed_prob_generate(
 
             // If less than our probability, generate a connection
             if (value < obj->params.probability) {
-                uint32_t local_post = post - post_slice_start;
-                accum weight = param_generator_generate(weight_generator);
-                uint16_t delay = rescale_delay(
-                        param_generator_generate(delay_generator), timestep_per_delay);
-                if (!matrix_generator_write_synapse(matrix_generator, pre, local_post,
-                        weight, delay, weight_scale)) {
-                    // Retry not useful here
-                    log_warning("Could not add to matrix!");
-                }
+                fixed_prob_write(pre, post - post_slice_start, weight_scale,
+                        timestep_per_delay, weight_generator, delay_generator,
+                        matrix_generator);
             }
         }
     }
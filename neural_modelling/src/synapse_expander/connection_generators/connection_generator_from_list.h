@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2024 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file
+ * \brief From-list connection generator implementation
+ *
+ * Each core is sent the part of the list that targets its own neurons,
+ * sorted by post-neuron, with an index of where the connections of each
+ * post-neuron start.
+ */
+
+#include <synapse_expander/generator_types.h>
+
+//! Flag set if the pre-neuron indices are 16-bit rather than 32-bit
+#define FROM_LIST_PRE_16_BIT 0x1
+//! Flag set if the list has a weight for each connection
+#define FROM_LIST_HAS_WEIGHTS 0x2
+//! Flag set if the list has a delay for each connection
+#define FROM_LIST_HAS_DELAYS 0x4
+
+//! \brief The parameters of the list, as found in SDRAM
+struct from_list_sdram {
+    //! The post-neuron of the first index entry
+    uint32_t first_post;
+    //! The number of post-neurons that have an index entry
+    uint32_t n_post;
+    //! The number of connections in the list
+    uint32_t n_connections;
+    //! The FROM_LIST_* flags describing what is in the list
+    uint32_t flags;
+    //! \brief The list itself:
+    //!
+    //! - n_post + 1 indices into the list of where the connections of each
+    //!   post-neuron start;
+    //! - n_connections pre-neuron indices, of 16 or 32 bits, padded to a word;
+    //! - n_connections weights, if present;
+    //! - n_connections delays, if present.
+    uint32_t data[];
+};
+
+//! \brief The parameters to be passed around for this connector
+struct from_list {
+    //! The post-neuron of the first index entry
+    uint32_t first_post;
+    //! The number of post-neurons that have an index entry
+    uint32_t n_post;
+    //! The FROM_LIST_* flags describing what is in the list
+    uint32_t flags;
+    //! Where the connections of each post-neuron start
+    const uint32_t *post_starts;
+    //! The pre-neuron indices, if 16-bit
+    const uint16_t *pre_16;
+    //! The pre-neuron indices, if 32-bit
+    const uint32_t *pre_32;
+    //! The weights, if present
+    const accum *weights;
+    //! The delays, if present
+    const accum *delays;
+};
+
+/**
+ * \brief Initialise the from-list connection generator
+ * \param[in,out] region: Region to read parameters from.  Should be updated
+ *                        to position just after parameters after calling.
+ * \return A data item to be passed in to other functions later on
+ */
+static void *connection_generator_from_list_initialise(void **region) {
+    struct from_list *obj = spin1_malloc(sizeof(struct from_list));
+    if (obj == NULL) {
+        log_error("Could not allocate from-list connector");
+        return NULL;
+    }
+    struct from_list_sdram *sdram = *region;
+    uint32_t n_connections = sdram->n_connections;
+    obj->first_post = sdram->first_post;
+    obj->n_post = sdram->n_post;
+    obj->flags = sdram->flags;
+
+    // The list stays in SDRAM, as it is likely too big for DTCM
+    const uint32_t *data = sdram->data;
+    obj->post_starts = data;
+    data = &data[obj->n_post + 1];
+    obj->pre_16 = NULL;
+    obj->pre_32 = NULL;
+    if (obj->flags & FROM_LIST_PRE_16_BIT) {
+        obj->pre_16 = (const uint16_t *) data;
+        data = &data[(n_connections + 1) >> 1];
+    } else {
+        obj->pre_32 = data;
+        data = &data[n_connections];
+    }
+    obj->weights = NULL;
+    if (obj->flags & FROM_LIST_HAS_WEIGHTS) {
+        obj->weights = (const accum *) data;
+        data = &data[n_connections];
+    }
+    obj->delays = NULL;
+    if (obj->flags & FROM_LIST_HAS_DELAYS) {
+        obj->delays = (const accum *) data;
+        data = &data[n_connections];
+    }
+    *region = (void *) data;
+
+    log_debug("From list connector, first_post = %u, n_post = %u, "
+            "n_connections = %u, flags = 0x%08x", obj->first_post, obj->n_post,
+            n_connections, obj->flags);
+    return obj;
+}
+
+/**
+ * \brief Free the from-list connection generator
+ * \param[in] generator: The generator to free
+ */
+static void connection_generator_from_list_free(void *generator) {
+    sark_free(generator);
+}
+
+/**
+ * \brief Generate connections with the from-list connection generator
+ * \param[in] generator: The generator to use to generate connections
+ * \param[in] pre_lo: The lowest pre-neuron index of the projection
+ * \param[in] pre_hi: The highest pre-neuron index of the projection
+ * \param[in] post_lo: The lowest post-neuron index of the projection
+ * \param[in] post_hi: The highest post-neuron index of the projection
+ * \param[in] post_index: The index of the core being generated for
+ * \param[in] post_slice_start: The start of the slice of the post-population
+ *                              being generated
+ * \param[in] post_slice_count: The number of neurons in the slice of the
+ *                              post-population being generated
+ * \param[in] weight_scale: The scale to apply to the weights
+ * \param[in] timestep_per_delay: The delay value multiplier to get to
+ *                                timesteps
+ * \param[in] weight_generator: Generates weights not in the list
+ * \param[in] delay_generator: Generates delays not in the list
+ * \param[in] matrix_generator: The generator of the matrix to write to
+ * \return Whether generation succeeded
+ */
+static bool connection_generator_from_list_generate(
+        void *generator, uint32_t pre_lo, UNUSED uint32_t pre_hi,
+        uint32_t post_lo, uint32_t post_hi, UNUSED uint32_t post_index,
+        uint32_t post_slice_start, uint32_t post_slice_count,
+        unsigned long accum weight_scale, accum timestep_per_delay,
+        param_generator_t weight_generator, param_generator_t delay_generator,
+        matrix_generator_t matrix_generator) {
+    struct from_list *obj = generator;
+
+    if (obj->n_post == 0) {
+        return true;
+    }
+
+    // Get the actual ranges to generate within, which are those of the
+    // post-neurons that have an index entry
+    uint32_t index_lo = post_lo + obj->first_post;
+    uint32_t post_start = max(max(post_slice_start, post_lo), index_lo);
+    uint32_t post_end = min(post_slice_start + post_slice_count - 1, post_hi);
+    post_end = min(post_end, index_lo + obj->n_post - 1);
+    if (post_start > post_end) {
+        return true;
+    }
+
+    uint32_t first = obj->post_starts[post_start - index_lo];
+    for (uint32_t post = post_start; post <= post_end; post++) {
+        uint32_t last = obj->post_starts[post - index_lo + 1];
+        uint32_t local_post = post - post_slice_start;
+        for (uint32_t i = first; i < last; i++) {
+            uint32_t pre = pre_lo +
+                    ((obj->pre_16 != NULL) ? obj->pre_16[i] : obj->pre_32[i]);
+            accum weight = (obj->weights != NULL) ? obj->weights[i] :
+                    param_generator_generate(weight_generator);
+            accum delay = (obj->delays != NULL) ? obj->delays[i] :
+                    param_generator_generate(delay_generator);
+            if (!matrix_generator_write_synapse(
+                    matrix_generator, pre, local_post, weight,
+                    rescale_delay(delay, timestep_per_delay), weight_scale)) {
+                log_error("Matrix not sized correctly!");
+                return false;
+            }
+        }
+        first = last;
+    }
+    return true;
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file
+ * \brief Index-Based Probability Connection generator implementation
+ *
+ * The probability is an expression of the indices of the neurons, compiled
+ * by the host (see expression.h).
+ */
+
+#include <synapse_expander/rng.h>
+#include <synapse_expander/generator_types.h>
+#include <synapse_expander/expression.h>
+
+// Eclipse does *NOT* like this type!
+typedef unsigned long fract probability_t;
+
+//! The parameters that can be copied in from SDRAM
+struct index_based_params {
+    uint32_t allow_self_connections;
+};
+
+/**
+ * \brief The data structure to be passed around for this connector.
+ */
+struct index_based {
+    struct index_based_params params;
+    //! The expression of the probability
+    expression_t *probability;
+};
+
+/**
+ * \brief Initialise the index-based connection generator
+ * \param[in,out] region: Region to read parameters from.  Should be updated
+ *                        to position just after parameters after calling.
+ * \return A data item to be passed in to other functions later on
+ */
+static void *connection_generator_index_based_initialise(void **region) {
+    // Allocate memory for the data
+    struct index_based *obj = spin1_malloc(sizeof(struct index_based));
+    if (obj == NULL) {
+        log_error("Could not allocate index based connector");
+        return NULL;
+    }
+
+    // Copy the parameters in, then the expression after them
+    struct index_based_params *params_sdram = *region;
+    obj->params = *params_sdram;
+    *region = &params_sdram[1];
+    obj->probability = expression_init(region);
+    if (obj->probability == NULL) {
+        sark_free(obj);
+        return NULL;
+    }
+
+    log_debug("Index Based Connector, allow self connections = %u, "
+            "expression of %u words", obj->params.allow_self_connections,
+            obj->probability->n_words);
+    return obj;
+}
+
+/**
+ * \brief Free the index-based connection generator
+ * \param[in] generator: The generator to free
+ */
+static void connection_generator_index_based_free(void *generator) {
+    struct index_based *obj = generator;
+    sark_free(obj->probability);
+    sark_free(generator);
+}
+
+/**
+ * \brief Generate connections with the index-based connection generator
+ * \param[in] generator: The generator to use to generate connections
+ * \param[in] pre_lo: The lowest pre-neuron index of the projection
+ * \param[in] pre_hi: The highest pre-neuron index of the projection
+ * \param[in] post_lo: The lowest post-neuron index of the projection
+ * \param[in] post_hi: The highest post-neuron index of the projection
+ * \param[in] post_index: The index of the core being generated for
+ * \param[in] post_slice_start: The start of the slice of the post-population
+ *                              being generated
+ * \param[in] post_slice_count: The number of neurons in the slice of the
+ *                              post-population being generated
+ * \param[in] weight_scale: The scale to apply to the weights
+ * \param[in] timestep_per_delay: The delay value multiplier to get to
+ *                                timesteps
+ * \param[in] weight_generator: The generator of weights
+ * \param[in] delay_generator: The generator of delays
+ * \param[in] matrix_generator: The generator of the matrix to write to
+ * \return Whether generation succeeded
+ */
+static bool connection_generator_index_based_generate(
+        void *generator, uint32_t pre_lo, uint32_t pre_hi,
+        uint32_t post_lo, uint32_t post_hi, UNUSED uint32_t post_index,
+        uint32_t post_slice_start, uint32_t post_slice_count,
+        unsigned long accum weight_scale, accum timestep_per_delay,
+        param_generator_t weight_generator, param_generator_t delay_generator,
+        matrix_generator_t matrix_generator) {
+    struct index_based *obj = generator;
+
+    // Get the actual ranges to generate within
+    uint32_t post_start = max(post_slice_start, post_lo);
+    uint32_t post_end = min(post_slice_start + post_slice_count - 1, post_hi);
+
+    // The host makes sure that the indices fit in an accum
+    accum vars[EXPR_N_VARS] = {0};
+    for (uint32_t pre = pre_lo; pre <= pre_hi; pre++) {
+        vars[EXPR_VAR_I] = kbits(pre << 15);
+        for (uint32_t post = post_start; post <= post_end; post++) {
+            if (pre == post && !obj->params.allow_self_connections) {
+                continue;
+            }
+            vars[EXPR_VAR_J] = kbits(post << 15);
+            accum probability = expression_evaluate(obj->probability, vars);
+            if (probability <= 0.0k) {
+                continue;
+            }
+
+            // Generate a random number; 1.0 won't fit in a probability
+            probability_t value = ulrbits(rng_generator(core_rng));
+            if (probability >= 1.0k || value < (probability_t) probability) {
+                uint32_t local_post = post - post_slice_start;
+                accum weight = param_generator_generate(weight_generator);
+                uint16_t delay = rescale_delay(
+                        param_generator_generate(delay_generator),
+                        timestep_per_delay);
+                if (!matrix_generator_write_synapse(matrix_generator, pre,
+                        local_post, weight, delay, weight_scale)) {
+                    // Retry not useful here
+                    log_warning("Could not add to matrix!");
+                }
+            }
+        }
+    }
+    return true;
+}
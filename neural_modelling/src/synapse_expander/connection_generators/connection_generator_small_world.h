@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file
+ * \brief Small World Connection generator implementation
+ *
+ * Each pre-neuron connects to the post-neurons within a distance of it, and
+ * each of those connections is rewired with some probability to a random
+ * post-neuron of the same core, as on the host.  The neurons of each
+ * population must be laid out on a regular grid (see lattice.h).
+ */
+
+#include <synapse_expander/rng.h>
+#include <synapse_expander/generator_types.h>
+#include <synapse_expander/lattice.h>
+
+// Eclipse does *NOT* like this type!
+typedef unsigned long fract probability_t;
+
+//! The parameters that can be copied in from SDRAM
+struct small_world_params {
+    uint32_t allow_self_connections;
+    //! The probability of rewiring each connection
+    probability_t rewiring;
+    //! The squared distance within which neurons are connected
+    accum max_d2;
+    //! The layout of the pre-population
+    struct lattice pre;
+    //! The layout of the post-population
+    struct lattice post;
+};
+
+/**
+ * \brief Initialise the small-world connection generator
+ * \param[in,out] region: Region to read parameters from.  Should be updated
+ *                        to position just after parameters after calling.
+ * \return A data item to be passed in to other functions later on
+ */
+static void *connection_generator_small_world_initialise(void **region) {
+    // Allocate memory for the parameters
+    struct small_world_params *obj =
+            spin1_malloc(sizeof(struct small_world_params));
+    if (obj == NULL) {
+        log_error("Could not allocate small world connector");
+        return NULL;
+    }
+
+    // Copy the parameters in
+    struct small_world_params *params_sdram = *region;
+    *obj = *params_sdram;
+    *region = &params_sdram[1];
+
+    log_debug("Small World Connector, allow self connections = %u, "
+            "rewiring = %k, max_d2 = %k", obj->allow_self_connections,
+            (accum) obj->rewiring, obj->max_d2);
+    return obj;
+}
+
+/**
+ * \brief Free the small-world connection generator
+ * \param[in] generator: The generator to free
+ */
+static void connection_generator_small_world_free(void *generator) {
+    sark_free(generator);
+}
+
+/**
+ * \brief Generate connections with the small-world connection generator
+ * \param[in] generator: The generator to use to generate connections
+ * \param[in] pre_lo: The lowest pre-neuron index of the projection
+ * \param[in] pre_hi: The highest pre-neuron index of the projection
+ * \param[in] post_lo: The lowest post-neuron index of the projection
+ * \param[in] post_hi: The highest post-neuron index of the projection
+ * \param[in] post_index: The index of the core being generated for
+ * \param[in] post_slice_start: The start of the slice of the post-population
+ *                              being generated
+ * \param[in] post_slice_count: The number of neurons in the slice of the
+ *                              post-population being generated
+ * \param[in] weight_scale: The scale to apply to the weights
+ * \param[in] timestep_per_delay: The delay value multiplier to get to
+ *                                timesteps
+ * \param[in] weight_generator: The generator of weights
+ * \param[in] delay_generator: The generator of delays
+ * \param[in] matrix_generator: The generator of the matrix to write to
+ * \return Whether generation succeeded
+ */
+static bool connection_generator_small_world_generate(
+        void *generator, uint32_t pre_lo, uint32_t pre_hi,
+        uint32_t post_lo, uint32_t post_hi, UNUSED uint32_t post_index,
+        uint32_t post_slice_start, uint32_t post_slice_count,
+        unsigned long accum weight_scale, accum timestep_per_delay,
+        param_generator_t weight_generator, param_generator_t delay_generator,
+        matrix_generator_t matrix_generator) {
+    struct small_world_params *params = generator;
+
+    // Get the actual ranges to generate within
+    uint32_t post_start = max(post_slice_start, post_lo);
+    uint32_t post_end = min(post_slice_start + post_slice_count - 1, post_hi);
+    if (post_start > post_end) {
+        return true;
+    }
+    uint32_t n_post = post_end - post_start + 1;
+
+    accum pre_pos[N_DIMS];
+    accum post_pos[N_DIMS];
+    for (uint32_t pre = pre_lo; pre <= pre_hi; pre++) {
+        lattice_position(&params->pre, pre, pre_pos);
+        for (uint32_t post = post_start; post <= post_end; post++) {
+            if (pre == post && !params->allow_self_connections) {
+                continue;
+            }
+            lattice_position(&params->post, post, post_pos);
+            if (lattice_distance2(pre_pos, post_pos) >= params->max_d2) {
+                continue;
+            }
+
+            // Rewire to a random post-neuron of this core
+            uint32_t target = post;
+            probability_t value = ulrbits(rng_generator(core_rng));
+            if (value < params->rewiring) {
+                unsigned long fract u01 = ulrbits(rng_generator(core_rng));
+                target = post_start + muliulr(n_post, u01);
+            }
+
+            uint32_t local_post = target - post_slice_start;
+            accum weight = param_generator_generate(weight_generator);
+            uint16_t delay = rescale_delay(
+                    param_generator_generate(delay_generator),
+                    timestep_per_delay);
+            if (!matrix_generator_write_synapse(matrix_generator, pre,
+                    local_post, weight, delay, weight_scale)) {
+                // Retry not useful here
+                log_warning("Could not add to matrix!");
+            }
+        }
+    }
+    return true;
+}
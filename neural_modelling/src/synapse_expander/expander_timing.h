@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file
+ * \brief The timing of the expanders, written to an SDRAM buffer that the
+ *        host gives through USER3 and reads back into provenance
+ *
+ * Times are in ticks of timer 2, which runs free at a sixteenth of the
+ * clock so that it takes minutes rather than seconds to wrap.
+ */
+
+#ifndef __EXPANDER_TIMING_H__
+#define __EXPANDER_TIMING_H__
+
+#include <common-typedefs.h>
+#include <spin1_api.h>
+
+//! Timer 2 enabled, free running, 32 bits, divided by 16
+#define EXPANDER_TIMER_CONTROL 0x86
+
+//! The buffer of timings; these match expander_timings.py
+typedef struct expander_timings {
+    //! The ticks taken by the whole of the expansion
+    uint32_t total_ticks;
+    //! The number of records that there were, even if not all were kept
+    uint32_t n_records;
+    //! The number of records there is space for
+    uint32_t max_records;
+    //! The records, whose format depends on the expander
+    uint32_t records[];
+} expander_timings_t;
+
+//! The timings of this core, or NULL if they aren't wanted
+static expander_timings_t *expander_timings = NULL;
+
+/**
+ * \brief Start timing, if the host has given a buffer
+ * \param[in] buffer: The address in USER3, or 0 for none
+ */
+static inline void expander_timing_init(uint32_t buffer) {
+    expander_timings = (expander_timings_t *) buffer;
+    if (expander_timings != NULL) {
+        tc[T2_CONTROL] = 0;
+        tc[T2_LOAD] = 0xFFFFFFFF;
+        tc[T2_CONTROL] = EXPANDER_TIMER_CONTROL;
+    }
+}
+
+/**
+ * \brief Get the time now
+ * \return The ticks since timing started
+ */
+static inline uint32_t expander_timing_now(void) {
+    // The timer counts down
+    return ~tc[T2_COUNT];
+}
+
+/**
+ * \brief Get space for the next record
+ * \param[in] n_words: The size of a record
+ * \return The record, or NULL if there is no space or timing is not wanted
+ */
+static inline uint32_t *expander_timing_next_record(uint32_t n_words) {
+    if (expander_timings == NULL) {
+        return NULL;
+    }
+    uint32_t index = expander_timings->n_records++;
+    if (index >= expander_timings->max_records) {
+        return NULL;
+    }
+    return &expander_timings->records[index * n_words];
+}
+
+/**
+ * \brief Record the time taken by the whole of the expansion
+ * \param[in] start: The time the expansion started
+ */
+static inline void expander_timing_finish(uint32_t start) {
+    if (expander_timings != NULL) {
+        expander_timings->total_ticks = expander_timing_now() - start;
+    }
+}
+
+#endif // __EXPANDER_TIMING_H__
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file
+ * \brief A small stack machine that evaluates expressions compiled by the
+ *        host, such as the probability of a connection from the indices of,
+ *        or the distance between, the neurons
+ *
+ * Values are S16.15 fixed point, held as their bits so that each operation
+ * saturates rather than wraps; the host evaluates the same operations to
+ * check that an expression can be done this way before sending it.
+ */
+
+#ifndef __EXPRESSION_H__
+#define __EXPRESSION_H__
+
+#include <common-typedefs.h>
+#include <stdfix-full-iso.h>
+#include <stdfix-exp.h>
+#include <sqrt.h>
+#include <debug.h>
+
+//! The deepest stack an expression can use
+#define EXPRESSION_MAX_STACK 16
+
+//! The largest argument of exp() whose result fits
+#define EXPRESSION_MAX_EXP 11.0k
+
+//! The operations of an expression; these match _Op in expression_compiler.py
+enum expression_op {
+    //! Push the value in the next word
+    EXPR_CONST,
+    //! Push the variable indexed by the next word
+    EXPR_VAR,
+    EXPR_ADD,   //!< Pop b and a, push a + b
+    EXPR_SUB,   //!< Pop b and a, push a - b
+    EXPR_MUL,   //!< Pop b and a, push a * b
+    EXPR_NEG,   //!< Pop a, push -a
+    EXPR_ABS,   //!< Pop a, push |a|
+    EXPR_EXP,   //!< Pop a, push e^a
+    EXPR_SQRT,  //!< Pop a, push the square root of a, or 0 if negative
+    EXPR_LT,    //!< Pop b and a, push 1 if a < b else 0
+    EXPR_LE,    //!< Pop b and a, push 1 if a <= b else 0
+    EXPR_MIN,   //!< Pop b and a, push the smaller
+    EXPR_MAX    //!< Pop b and a, push the larger
+};
+
+//! The variables an expression can use
+enum expression_var {
+    EXPR_VAR_I,     //!< The index of the pre-neuron
+    EXPR_VAR_J,     //!< The index of the post-neuron
+    EXPR_VAR_D,     //!< The distance between the neurons
+    EXPR_N_VARS     //!< The number of variables
+};
+
+//! A compiled expression, as written by the host
+typedef struct expression {
+    //! The number of words of code
+    uint32_t n_words;
+    //! The code; each operation is a word, some followed by an operand word
+    uint32_t code[];
+} expression_t;
+
+/**
+ * \brief Limit a value to those an S16.15 number can hold
+ * \param[in] value: The value as the bits of an S16.15 number
+ * \return The saturated bits
+ */
+static inline int32_t expression_saturate(int64_t value) {
+    if (value > INT32_MAX) {
+        return INT32_MAX;
+    }
+    if (value < INT32_MIN) {
+        return INT32_MIN;
+    }
+    return (int32_t) value;
+}
+
+/**
+ * \brief Copy an expression from SDRAM
+ * \param[in,out] region: Where to read the expression from; updated to
+ *                        the position after it
+ * \return The copy, or NULL if it couldn't be allocated
+ */
+static inline expression_t *expression_init(void **region) {
+    expression_t *sdram_expr = *region;
+    uint32_t size = sizeof(expression_t) + sdram_expr->n_words * sizeof(uint32_t);
+    expression_t *expr = spin1_malloc(size);
+    if (expr == NULL) {
+        log_error("Could not allocate expression of %u words",
+                sdram_expr->n_words);
+        return NULL;
+    }
+    spin1_memcpy(expr, sdram_expr, size);
+    *region = &sdram_expr->code[sdram_expr->n_words];
+    return expr;
+}
+
+/**
+ * \brief Evaluate an expression; the host has checked that the code is
+ *        well-formed and fits in the stack
+ * \param[in] expr: The expression to evaluate
+ * \param[in] vars: The values of the ::expression_var variables
+ * \return The value of the expression
+ */
+static inline accum expression_evaluate(
+        const expression_t *expr, const accum vars[EXPR_N_VARS]) {
+    int32_t stack[EXPRESSION_MAX_STACK];
+    int32_t *top = stack - 1;
+    const uint32_t *code = expr->code;
+    const uint32_t *end = &code[expr->n_words];
+    while (code < end) {
+        uint32_t op = *code++;
+        switch (op) {
+        case EXPR_CONST:
+            *++top = (int32_t) *code++;
+            continue;
+        case EXPR_VAR:
+            *++top = bitsk(vars[*code++]);
+            continue;
+        case EXPR_NEG:
+            *top = expression_saturate(-(int64_t) *top);
+            continue;
+        case EXPR_ABS:
+            if (*top < 0) {
+                *top = expression_saturate(-(int64_t) *top);
+            }
+            continue;
+        case EXPR_EXP:
+            *top = (kbits(*top) > EXPRESSION_MAX_EXP) ?
+                    INT32_MAX : bitsk(expk(kbits(*top)));
+            continue;
+        case EXPR_SQRT:
+            *top = (*top <= 0) ? 0 : bitsk(sqrtk(kbits(*top)));
+            continue;
+        }
+
+        // The rest pop two values and push one
+        int32_t b = *top--;
+        int32_t a = *top;
+        switch (op) {
+        case EXPR_ADD:
+            *top = expression_saturate((int64_t) a + b);
+            break;
+        case EXPR_SUB:
+            *top = expression_saturate((int64_t) a - b);
+            break;
+        case EXPR_MUL:
+            *top = expression_saturate(((int64_t) a * b) >> 15);
+            break;
+        case EXPR_LT:
+            *top = (a < b) ? bitsk(1.0k) : 0;
+            break;
+        case EXPR_LE:
+            *top = (a <= b) ? bitsk(1.0k) : 0;
+            break;
+        case EXPR_MIN:
+            *top = (a < b) ? a : b;
+            break;
+        case EXPR_MAX:
+            *top = (a > b) ? a : b;
+            break;
+        }
+    }
+    return kbits(*top);
+}
+
+#endif // __EXPRESSION_H__
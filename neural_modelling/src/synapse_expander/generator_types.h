@@ -58,9 +58,12 @@ typedef void* (initialize_connector_func)(void **region);
  * \param[in,out] region: Region to read parameters from.  Should be updated
  *                        to position just after parameters after calling.
  * \param[in] synaptic_matrix: The address of the base of the synaptic matrix
+ * \param[in] set_up_rows: Whether to set up the rows; false if another
+ *                         generator of the same matrix has done so
  * \return A data item to be passed in to other functions later on
  */
-typedef void* (initialize_matrix_func)(void **region, void *synaptic_matrix);
+typedef void* (initialize_matrix_func)(void **region, void *synaptic_matrix,
+        bool set_up_rows);
 
 /**
  * \brief How to free any data for the generator; all generator types use
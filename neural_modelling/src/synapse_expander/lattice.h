@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 The University of Manchester
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file
+ * \brief The positions of neurons laid out on a regular grid, for the
+ *        connection generators that depend on distance
+ *
+ * Positions are pre-scaled by the host so that squared distances fit in an
+ * accum.
+ */
+
+#ifndef __LATTICE_H__
+#define __LATTICE_H__
+
+#include <common-typedefs.h>
+
+//! The number of spatial dimensions
+#define N_DIMS 3
+
+//! \brief The layout of a population; the position of neuron i is
+//!     origin + (i / n_minor) * major + (i % n_minor) * minor
+struct lattice {
+    //! The position of the first neuron
+    accum origin[N_DIMS];
+    //! The step between rows of the grid
+    accum major[N_DIMS];
+    //! The step between neurons in a row of the grid
+    accum minor[N_DIMS];
+    //! The number of neurons in a row of the grid
+    uint32_t n_minor;
+};
+
+/**
+ * \brief Get the position of a neuron
+ * \param[in] lattice: The layout of the population of the neuron
+ * \param[in] index: The index of the neuron in the population
+ * \param[out] pos: Where to put the position
+ */
+static inline void lattice_position(
+        const struct lattice *lattice, uint32_t index, accum pos[N_DIMS]) {
+    int32_t row = index / lattice->n_minor;
+    int32_t col = index - (row * lattice->n_minor);
+    // Multiplied as integers, as the row and column might not fit in an
+    // accum even though the result does
+    for (uint32_t i = 0; i < N_DIMS; i++) {
+        pos[i] = lattice->origin[i] + kbits(bitsk(lattice->major[i]) * row)
+                + kbits(bitsk(lattice->minor[i]) * col);
+    }
+}
+
+/**
+ * \brief Get the squared distance between two positions; the host makes
+ *        sure this can't overflow
+ * \param[in] a: The first position
+ * \param[in] b: The second position
+ * \return The squared distance
+ */
+static inline accum lattice_distance2(
+        const accum a[N_DIMS], const accum b[N_DIMS]) {
+    accum d2 = 0;
+    for (uint32_t i = 0; i < N_DIMS; i++) {
+        accum diff = b[i] - a[i];
+        d2 += diff * diff;
+    }
+    return d2;
+}
+
+#endif // __LATTICE_H__
@@ -97,7 +97,7 @@ static const struct matrix_generator_info matrix_generators[] = {
 };
 
 matrix_generator_t matrix_generator_init(uint32_t hash, void **in_region,
-        void *synaptic_matrix) {
+        void *synaptic_matrix, bool set_up_rows) {
     // Look through the known generators
     for (uint32_t i = 0; i < N_MATRIX_GENERATORS; i++) {
         const matrix_generator_info *type = &matrix_generators[i];
@@ -116,7 +116,8 @@ matrix_generator_t matrix_generator_init(uint32_t hash, void **in_region,
             generator->type = type;
 
             // Initialise the generator and store the data
-            generator->data = type->initialize(in_region, synaptic_matrix);
+            generator->data = type->initialize(
+                    in_region, synaptic_matrix, set_up_rows);
             return generator;
         }
     }
@@ -137,3 +138,77 @@ bool matrix_generator_write_synapse(
     return generator->type->write_synapse(
             generator->data, pre_index, post_index, weight, delay, weight_scale);
 }
+
+//! The records of the blocks of rows set up, most recent first
+static written_rows_t *written_rows = NULL;
+
+void matrix_generator_record_rows(uint32_t *matrix, uint32_t n_rows,
+        uint32_t max_row_n_words, bool all_have_synapses) {
+    written_rows_t *rows = spin1_malloc(sizeof(written_rows_t));
+    if (rows == NULL) {
+        log_warning("No space to record rows at 0x%08x; they will be read "
+                "back to make bit fields", matrix);
+        return;
+    }
+    rows->has_synapses = NULL;
+    if (!all_have_synapses) {
+        rows->has_synapses = bit_field_alloc(n_rows);
+        if (rows->has_synapses == NULL) {
+            log_warning("No space to record rows at 0x%08x; they will be "
+                    "read back to make bit fields", matrix);
+            sark_free(rows);
+            return;
+        }
+        clear_bit_field(rows->has_synapses, get_bit_field_size(n_rows));
+    }
+    rows->start = matrix;
+    rows->row_n_words = max_row_n_words + N_HEADER_WORDS;
+    rows->n_rows = n_rows;
+    rows->next = written_rows;
+    written_rows = rows;
+}
+
+void matrix_generator_row_has_synapses(void *row) {
+    // The block being generated was recorded last, so is found first
+    uint32_t *row_words = row;
+    for (written_rows_t *rows = written_rows; rows != NULL;
+            rows = rows->next) {
+        if (row_words >= rows->start &&
+                row_words < &rows->start[rows->n_rows * rows->row_n_words]) {
+            if (rows->has_synapses != NULL) {
+                uint32_t index = (row_words - rows->start) / rows->row_n_words;
+                bit_field_set(rows->has_synapses, index);
+            }
+            return;
+        }
+    }
+}
+
+const written_rows_t *matrix_generator_find_rows(
+        void *address, uint32_t row_n_words, uint32_t *first_row) {
+    uint32_t *row_words = address;
+    for (written_rows_t *rows = written_rows; rows != NULL;
+            rows = rows->next) {
+        if (rows->row_n_words != row_n_words || row_words < rows->start) {
+            continue;
+        }
+        uint32_t offset = row_words - rows->start;
+        uint32_t index = offset / row_n_words;
+        if (index < rows->n_rows && (index * row_n_words) == offset) {
+            *first_row = index;
+            return rows;
+        }
+    }
+    return NULL;
+}
+
+void matrix_generator_free_rows(void) {
+    while (written_rows != NULL) {
+        written_rows_t *next = written_rows->next;
+        if (written_rows->has_synapses != NULL) {
+            sark_free(written_rows->has_synapses);
+        }
+        sark_free(written_rows);
+        written_rows = next;
+    }
+}
@@ -18,7 +18,12 @@
  * \file
  * \brief Interface for matrix generation
  */
+
+#ifndef __MATRIX_GENERATOR_H__
+#define __MATRIX_GENERATOR_H__
+
 #include <common-typedefs.h>
+#include <bit_field.h>
 
 /**
  * \brief Data type for matrix generator
@@ -31,11 +36,13 @@ typedef struct matrix_generator *matrix_generator_t;
  * \param[in,out] region: The address to read data from; updated to position
  *                        after data has been read
  * \param[in] synaptic_matrix: The address of the base of the synaptic matrix
+ * \param[in] set_up_rows: Whether to set up (and record) the rows; false if
+ *                         another generator of the same matrix has done so
  * \return An initialised matrix generator that can be used with other
  *         functions, or NULL if it couldn't be initialised for any reason
  */
 matrix_generator_t matrix_generator_init(uint32_t hash, void **region,
-        void *synaptic_matrix);
+        void *synaptic_matrix, bool set_up_rows);
 
 /**
  * \brief Finish with a matrix generator
@@ -56,3 +63,73 @@ void matrix_generator_free(matrix_generator_t generator);
 bool matrix_generator_write_synapse(matrix_generator_t generator,
         uint32_t pre_index, uint16_t post_index, accum weight, uint16_t delay,
 		unsigned long accum weight_scale);
+
+/**
+ * \brief A record of which rows of a block of the synaptic matrix have
+ *        synapses, kept as the rows are written so that the bit fields can
+ *        be made without reading the rows back from SDRAM
+ */
+typedef struct written_rows {
+    //! The first row of the block
+    uint32_t *start;
+    //! The number of words in each row, including the header
+    uint32_t row_n_words;
+    //! The number of rows in the block
+    uint32_t n_rows;
+    //! Bit i is set if row i has synapses, or NULL if all rows have them
+    bit_field_t has_synapses;
+    //! The record of another block
+    struct written_rows *next;
+} written_rows_t;
+
+/**
+ * \brief Start recording which rows of a block of the synaptic matrix have
+ *        synapses; called by matrix generators once the rows are set up.
+ *        If there isn't the space for a record, the rows are read back
+ *        instead.
+ * \param[in] matrix: The first row of the block
+ * \param[in] n_rows: The number of rows in the block
+ * \param[in] max_row_n_words: The maximum number of words (excluding
+ *                             headers) in each row of the block
+ * \param[in] all_have_synapses: Whether every row is to be taken as having
+ *                               synapses, as is the case for plastic rows
+ */
+void matrix_generator_record_rows(uint32_t *matrix, uint32_t n_rows,
+        uint32_t max_row_n_words, bool all_have_synapses);
+
+/**
+ * \brief Record that a row has been given a synapse; called by matrix
+ *        generators when they write the first synapse of a row
+ * \param[in] row: The row written to
+ */
+void matrix_generator_row_has_synapses(void *row);
+
+/**
+ * \brief Find the record of a block of rows
+ * \param[in] address: The address of the first row to look for
+ * \param[in] row_n_words: The number of words in each row, including the
+ *                         header
+ * \param[out] first_row: The index in the record of the row at the address
+ * \return The record of the rows, or NULL if the rows were not recorded
+ */
+const written_rows_t *matrix_generator_find_rows(
+        void *address, uint32_t row_n_words, uint32_t *first_row);
+
+/**
+ * \brief Test if a recorded row has synapses
+ * \param[in] rows: The record of the rows
+ * \param[in] row: The index of the row in the record
+ * \return Whether the row has synapses
+ */
+static inline bool written_rows_has_synapses(
+        const written_rows_t *rows, uint32_t row) {
+    return (rows->has_synapses == NULL)
+            || bit_field_test(rows->has_synapses, row);
+}
+
+/**
+ * \brief Free all the records of rows
+ */
+void matrix_generator_free_rows(void);
+
+#endif // __MATRIX_GENERATOR_H__
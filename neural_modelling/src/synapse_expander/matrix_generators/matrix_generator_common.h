@@ -25,10 +25,20 @@
 #define __MATRIX_GENERATOR_COMMON_H__
 
 #include <debug.h>
+#include <synapse_expander/matrix_generator.h>
+#include <neuron/synapse_row.h>
 
 //! The number of header words per row
 #define N_HEADER_WORDS 3
 
+//! \brief The format flags of a new plastic row, which never has fixed
+//!     synapses
+#define PLASTIC_ROW_FORMAT \
+    (SYNAPSE_ROW_PLASTIC_ONLY << SYNAPSE_ROW_FORMAT_SHIFT)
+
+//! The mask of the number of plastic synapses of a row within its format
+#define PLASTIC_ROW_N_SYNAPSES_MASK ((1 << SYNAPSE_ROW_FORMAT_SHIFT) - 1)
+
 /**
  * \brief A converted final delay value and delay stage
  */
@@ -24,13 +24,15 @@
 #include <delay_extension/delay_extension.h>
 #include "matrix_generator_common.h"
 #include <synapse_expander/generator_types.h>
+#include <neuron/synapse_row.h>
 #include <utils.h>
 
 //! The layout of a purely static row of a synaptic matrix.
 typedef struct {
     uint32_t plastic_plastic_size;  //!< the plastic-plastic size within a row
     uint32_t fixed_fixed_size;      //!< the fixed-fixed size within a row
-    uint32_t fixed_plastic_size;    //!< the fixed-plastic size within a row
+    uint32_t fixed_plastic_size;    //!< the fixed-plastic size and format flags
+                                    //!< within a row
     uint32_t fixed_fixed_data[];    //!< the fixed-fixed data within a row
 } static_row_t;
 
@@ -78,21 +80,82 @@ typedef struct matrix_generator_static_data {
     uint32_t n_pre_neurons;
     //! The number of pre-synaptic neurons per core
     uint32_t n_pre_neurons_per_core;
+    //! Whether the rows are written in the dense format
+    uint32_t dense;
+    //! Whether the rows are written in the byte target format
+    uint32_t byte_targets;
+    //! Whether the rows are written in the shared weight format
+    uint32_t shared_weight;
 } matrix_genetator_static_data_t;
 
+/**
+ * \brief The format flags of a new static row; a single matrix has a single
+ *        synapse type, and the row has a single delay until a synapse with a
+ *        different delay is added.  The rows are sorted by delay once
+ *        generated.
+ */
+#define STATIC_ROW_INITIAL_FORMAT \
+    ((SYNAPSE_ROW_SINGLE_DELAY | SYNAPSE_ROW_SINGLE_TYPE | \
+            SYNAPSE_ROW_DELAY_SORTED) << SYNAPSE_ROW_FORMAT_SHIFT)
+
+/**
+ * \brief The format flags of a new dense row; the delay and type are in the
+ *        header so are the same for all synapses
+ */
+#define STATIC_ROW_DENSE_FORMAT \
+    ((SYNAPSE_ROW_DENSE | SYNAPSE_ROW_SINGLE_DELAY | SYNAPSE_ROW_SINGLE_TYPE) << \
+            SYNAPSE_ROW_FORMAT_SHIFT)
+
+/**
+ * \brief The format flags of a new byte target row; the type is that of the
+ *        matrix, but the delay is in each target
+ */
+#define STATIC_ROW_BYTE_TARGETS_FORMAT \
+    ((SYNAPSE_ROW_BYTE_TARGETS | SYNAPSE_ROW_SINGLE_TYPE) << \
+            SYNAPSE_ROW_FORMAT_SHIFT)
+
+/**
+ * \brief The format flags of a new shared weight row; the weight, delay and
+ *        type are in the header so are the same for all synapses
+ */
+#define STATIC_ROW_SHARED_WEIGHT_FORMAT \
+    ((SYNAPSE_ROW_SHARED_WEIGHT | SYNAPSE_ROW_SINGLE_DELAY | \
+            SYNAPSE_ROW_SINGLE_TYPE) << SYNAPSE_ROW_FORMAT_SHIFT)
+
 /**
  * \brief Set up the rows so that they are ready for writing to
  * \param[in] matrix The base address of the matrix to set up
  * \param[in] n_rows The number of rows in the matrix
  * \param[in] max_row_n_words The maximum number of words used by a row
+ * \param[in] dense Whether the rows are dense, so the weights must start at 0
+ * \param[in] byte_targets Whether the rows hold a byte per target
+ * \param[in] shared_weight Whether the rows hold an index per target
  */
-static void setup_rows(uint32_t *matrix, uint32_t n_rows, uint32_t max_row_n_words) {
+static void setup_rows(uint32_t *matrix, uint32_t n_rows, uint32_t max_row_n_words,
+        bool dense, bool byte_targets, bool shared_weight) {
     for (uint32_t i = 0; i < n_rows; i++) {
         static_row_t *row = get_row(matrix, max_row_n_words, i);
         log_debug("Setting up row %u at 0x%08x with %u max words", i, row, max_row_n_words);
         row->plastic_plastic_size = 0;
-        row->fixed_plastic_size = 0;
         row->fixed_fixed_size = 0;
+        if (dense) {
+            row->fixed_plastic_size = STATIC_ROW_DENSE_FORMAT;
+            for (uint32_t j = 0; j < max_row_n_words; j++) {
+                row->fixed_fixed_data[j] = 0;
+            }
+        } else if (byte_targets) {
+            row->fixed_plastic_size = STATIC_ROW_BYTE_TARGETS_FORMAT;
+            for (uint32_t j = 0; j < max_row_n_words; j++) {
+                row->fixed_fixed_data[j] = 0;
+            }
+        } else if (shared_weight) {
+            row->fixed_plastic_size = STATIC_ROW_SHARED_WEIGHT_FORMAT;
+            for (uint32_t j = 0; j < max_row_n_words; j++) {
+                row->fixed_fixed_data[j] = 0;
+            }
+        } else {
+            row->fixed_plastic_size = STATIC_ROW_INITIAL_FORMAT;
+        }
     }
 }
 
@@ -128,10 +191,11 @@ static uint32_t build_static_word(
  * \param[in,out] region: Region to read parameters from.  Should be updated
  *                        to position just after parameters after calling.
  * \param[in] synaptic_matrix: The address of the base of the synaptic matrix
+ * \param[in] set_up_rows: Whether to set up the rows
  * \return A data item to be passed in to other functions later on
  */
 static void *matrix_generator_static_initialize(void **region,
-        void *synaptic_matrix) {
+        void *synaptic_matrix, bool set_up_rows) {
     matrix_genetator_static_data_t *sdram_data = *region;
     *region = &sdram_data[1];
     matrix_genetator_static_data_t *data = spin1_malloc(
@@ -142,16 +206,27 @@ static void *matrix_generator_static_initialize(void **region,
     uint32_t *syn_mat = synaptic_matrix;
     if (data->synaptic_matrix_offset != 0xFFFFFFFF) {
         data->synaptic_matrix = &(syn_mat[data->synaptic_matrix_offset]);
-        setup_rows(data->synaptic_matrix, data->n_pre_neurons,
-                data->max_row_n_words);
+        if (set_up_rows) {
+            setup_rows(data->synaptic_matrix, data->n_pre_neurons,
+                    data->max_row_n_words, data->dense, data->byte_targets,
+                    data->shared_weight);
+            matrix_generator_record_rows(data->synaptic_matrix,
+                    data->n_pre_neurons, data->max_row_n_words, false);
+        }
     } else {
         data->synaptic_matrix = NULL;
     }
     if (data->delayed_matrix_offset != 0xFFFFFFFF) {
         data->delayed_synaptic_matrix = &(syn_mat[data->delayed_matrix_offset]);
-        setup_rows(data->delayed_synaptic_matrix,
-                data->n_pre_neurons * (data->max_stage - 1),
-                data->max_delayed_row_n_words);
+        if (set_up_rows) {
+            setup_rows(data->delayed_synaptic_matrix,
+                    data->n_pre_neurons * (data->max_stage - 1),
+                    data->max_delayed_row_n_words, data->dense,
+                    data->byte_targets, data->shared_weight);
+            matrix_generator_record_rows(data->delayed_synaptic_matrix,
+                    data->n_pre_neurons * (data->max_stage - 1),
+                    data->max_delayed_row_n_words, false);
+        }
     } else {
         data->delayed_synaptic_matrix = NULL;
     }
@@ -160,10 +235,180 @@ static void *matrix_generator_static_initialize(void **region,
 }
 
 /**
- * \brief How to free any data for the static synaptic matrix generator
+ * \brief Add a synapse to a dense row, where the weights are indexed by the
+ *        post-neuron and the delay and type are in the header word
+ * \param[in] data: The generator data
+ * \param[in] row: The row to add the synapse to
+ * \param[in] max_row_n_words: The maximum number of words in the row
+ * \param[in] weight: The scaled weight of the synapse
+ * \param[in] delay: The delay of the synapse within the stage
+ * \param[in] post_index: The index of the post-neuron on this core
+ * \return whether the synapse was added or not
+ */
+static bool write_dense_synapse(matrix_genetator_static_data_t *data,
+        static_row_t *row, uint32_t max_row_n_words, uint16_t weight,
+        uint16_t delay, uint16_t post_index) {
+    uint32_t n_words = 1 + ((post_index + 2) >> 1);
+    if (n_words > max_row_n_words) {
+        log_warning("Dense row at 0x%08x can't hold neuron %u in %u words",
+                row, post_index, max_row_n_words);
+        return false;
+    }
+
+    // The header holds the number of weights in place of the weight
+    uint32_t header = row->fixed_fixed_data[0];
+    uint32_t n_weights = header >> SYNAPSE_ROW_DENSE_N_WEIGHTS_SHIFT;
+    if (post_index >= n_weights) {
+        n_weights = post_index + 1;
+    }
+    row->fixed_fixed_data[0] = build_static_word(n_weights, delay,
+            data->synapse_type, 0, data->synapse_type_bits,
+            data->synapse_index_bits, data->delay_bits);
+    if (row->fixed_fixed_size == 0) {
+        matrix_generator_row_has_synapses(row);
+    }
+    if (n_words > row->fixed_fixed_size) {
+        row->fixed_fixed_size = n_words;
+    }
+
+    // Repeated synapses are combined, as they would be in the ring buffer
+    uint16_t *weights = (uint16_t *) &row->fixed_fixed_data[1];
+    uint32_t total = weights[post_index] + weight;
+    weights[post_index] = (total > SYNAPSE_WEIGHT_MASK) ? SYNAPSE_WEIGHT_MASK : total;
+    return true;
+}
+
+/**
+ * \brief Add a synapse to a byte target row, where the weight is in the
+ *        header word and the delay, type and post-neuron are in a byte
+ * \param[in] data: The generator data
+ * \param[in] row: The row to add the synapse to
+ * \param[in] max_row_n_words: The maximum number of words in the row
+ * \param[in] weight: The scaled weight of the synapse
+ * \param[in] delay: The delay of the synapse within the stage
+ * \param[in] post_index: The index of the post-neuron on this core
+ * \return whether the synapse was added or not
+ */
+static bool write_byte_target_synapse(matrix_genetator_static_data_t *data,
+        static_row_t *row, uint32_t max_row_n_words, uint16_t weight,
+        uint16_t delay, uint16_t post_index) {
+    uint32_t header = row->fixed_fixed_data[0];
+    uint32_t pos = header & SYNAPSE_ROW_BYTE_TARGETS_N_MASK;
+    uint32_t n_words = 1 + ((pos + 4) >> 2);
+    if (n_words > max_row_n_words) {
+        log_warning("Byte target row at 0x%08x is already full (%u of %u words)",
+                row, n_words - 1, max_row_n_words);
+        return false;
+    }
+
+    // The weight is the same for every synapse so is just written again
+    row->fixed_fixed_data[0] =
+            ((uint32_t) weight << SYNAPSE_WEIGHT_SHIFT) | (pos + 1);
+    if (row->fixed_fixed_size == 0) {
+        matrix_generator_row_has_synapses(row);
+    }
+    row->fixed_fixed_size = n_words;
+
+    uint8_t *targets = (uint8_t *) &row->fixed_fixed_data[1];
+    targets[pos] = build_static_word(0, delay, data->synapse_type, post_index,
+            data->synapse_type_bits, data->synapse_index_bits,
+            data->delay_bits);
+    return true;
+}
+
+/**
+ * \brief Add a synapse to a shared weight row, where the weight, delay and
+ *        type are in the header word and the post-neuron is in a half-word
+ * \param[in] data: The generator data
+ * \param[in] row: The row to add the synapse to
+ * \param[in] max_row_n_words: The maximum number of words in the row
+ * \param[in] weight: The scaled weight of the synapse
+ * \param[in] delay: The delay of the synapse within the stage
+ * \param[in] post_index: The index of the post-neuron on this core
+ * \return whether the synapse was added or not
+ */
+static bool write_shared_weight_synapse(matrix_genetator_static_data_t *data,
+        static_row_t *row, uint32_t max_row_n_words, uint16_t weight,
+        uint16_t delay, uint16_t post_index) {
+    uint32_t pos = row->fixed_fixed_data[1];
+    uint32_t n_words = 2 + ((pos + 2) >> 1);
+    if (n_words > max_row_n_words) {
+        log_warning("Shared weight row at 0x%08x is already full (%u of %u words)",
+                row, n_words - 1, max_row_n_words);
+        return false;
+    }
+
+    // The weight, delay and type are the same for every synapse so are just
+    // written again
+    row->fixed_fixed_data[0] = build_static_word(weight, delay,
+            data->synapse_type, 0, data->synapse_type_bits,
+            data->synapse_index_bits, data->delay_bits);
+    row->fixed_fixed_data[1] = pos + 1;
+    if (row->fixed_fixed_size == 0) {
+        matrix_generator_row_has_synapses(row);
+    }
+    row->fixed_fixed_size = n_words;
+
+    uint16_t *targets = (uint16_t *) &row->fixed_fixed_data[2];
+    targets[pos] = post_index;
+    return true;
+}
+
+/**
+ * \brief Sort the synapses of the rows of a matrix by delay, so that those
+ *        that are too late for a spike can be found with a search.
+ * \details The delay of 0 represents the maximum delay so is sorted last; the
+ *        order within a delay is kept so that the neuron ids stay in order.
+ * \param[in] data: The generator data
+ * \param[in] matrix: The base address of the matrix to sort
+ * \param[in] n_rows: The number of rows in the matrix
+ * \param[in] max_row_n_words: The maximum number of words used by a row
+ */
+static void sort_rows_by_delay(matrix_genetator_static_data_t *data,
+        uint32_t *matrix, uint32_t n_rows, uint32_t max_row_n_words) {
+    uint32_t delay_shift = data->synapse_index_bits + data->synapse_type_bits;
+    uint32_t delay_mask = (1 << data->delay_bits) - 1;
+    uint32_t single_delay = SYNAPSE_ROW_SINGLE_DELAY << SYNAPSE_ROW_FORMAT_SHIFT;
+    for (uint32_t i = 0; i < n_rows; i++) {
+        static_row_t *row = get_row(matrix, max_row_n_words, i);
+        if (row->fixed_plastic_size & single_delay) {
+            continue;
+        }
+
+        // Insertion sort, as the rows are short and often nearly sorted
+        uint32_t *words = row->fixed_fixed_data;
+        for (uint32_t j = 1; j < row->fixed_fixed_size; j++) {
+            uint32_t word = words[j];
+            uint32_t key = ((word >> delay_shift) - 1) & delay_mask;
+            uint32_t k = j;
+            while (k > 0 &&
+                    (((words[k - 1] >> delay_shift) - 1) & delay_mask) > key) {
+                words[k] = words[k - 1];
+                k--;
+            }
+            words[k] = word;
+        }
+    }
+}
+
+/**
+ * \brief How to free any data for the static synaptic matrix generator; this
+ *        is done once all the synapses are written, so finishes the rows
  * \param[in] generator: The data to free
  */
 static void matrix_generator_static_free(void *generator) {
+    matrix_genetator_static_data_t *data = generator;
+    if (!data->dense && !data->byte_targets && !data->shared_weight) {
+        if (data->synaptic_matrix != NULL) {
+            sort_rows_by_delay(data, data->synaptic_matrix,
+                    data->n_pre_neurons, data->max_row_n_words);
+        }
+        if (data->delayed_synaptic_matrix != NULL) {
+            sort_rows_by_delay(data, data->delayed_synaptic_matrix,
+                    data->n_pre_neurons * (data->max_stage - 1),
+                    data->max_delayed_row_n_words);
+        }
+    }
     sark_free(generator);
 }
 
@@ -186,6 +431,47 @@ static bool matrix_generator_static_write_synapse(void *generator,
             data->max_delay_per_stage);
     static_row_t *row;
     uint32_t pos;
+    if (data->dense) {
+        uint16_t scaled_weight = rescale_weight(weight, weight_scale);
+        if (delay_and_stage.stage == 0) {
+            row = get_row(data->synaptic_matrix, data->max_row_n_words, pre_index);
+            return write_dense_synapse(data, row, data->max_row_n_words,
+                    scaled_weight, delay_and_stage.delay, post_index);
+        }
+        row = get_delay_row(data->delayed_synaptic_matrix,
+                data->max_delayed_row_n_words, pre_index, delay_and_stage.stage,
+                data->n_pre_neurons_per_core, data->max_stage, data->n_pre_neurons);
+        return write_dense_synapse(data, row, data->max_delayed_row_n_words,
+                scaled_weight, delay_and_stage.delay, post_index);
+    }
+    if (data->byte_targets) {
+        uint16_t scaled_weight = rescale_weight(weight, weight_scale);
+        if (delay_and_stage.stage == 0) {
+            row = get_row(data->synaptic_matrix, data->max_row_n_words, pre_index);
+            return write_byte_target_synapse(data, row, data->max_row_n_words,
+                    scaled_weight, delay_and_stage.delay, post_index);
+        }
+        row = get_delay_row(data->delayed_synaptic_matrix,
+                data->max_delayed_row_n_words, pre_index, delay_and_stage.stage,
+                data->n_pre_neurons_per_core, data->max_stage, data->n_pre_neurons);
+        return write_byte_target_synapse(data, row,
+                data->max_delayed_row_n_words, scaled_weight,
+                delay_and_stage.delay, post_index);
+    }
+    if (data->shared_weight) {
+        uint16_t scaled_weight = rescale_weight(weight, weight_scale);
+        if (delay_and_stage.stage == 0) {
+            row = get_row(data->synaptic_matrix, data->max_row_n_words, pre_index);
+            return write_shared_weight_synapse(data, row, data->max_row_n_words,
+                    scaled_weight, delay_and_stage.delay, post_index);
+        }
+        row = get_delay_row(data->delayed_synaptic_matrix,
+                data->max_delayed_row_n_words, pre_index, delay_and_stage.stage,
+                data->n_pre_neurons_per_core, data->max_stage, data->n_pre_neurons);
+        return write_shared_weight_synapse(data, row,
+                data->max_delayed_row_n_words, scaled_weight,
+                delay_and_stage.delay, post_index);
+    }
     if (delay_and_stage.stage == 0) {
         row = get_row(data->synaptic_matrix, data->max_row_n_words, pre_index);
         pos = row->fixed_fixed_size;
@@ -210,9 +496,22 @@ static bool matrix_generator_static_write_synapse(void *generator,
 
     uint16_t scaled_weight = rescale_weight(weight, weight_scale);
 
-    row->fixed_fixed_size = pos + 1;
-    row->fixed_fixed_data[pos] = build_static_word(scaled_weight, delay_and_stage.delay,
+    uint32_t word = build_static_word(scaled_weight, delay_and_stage.delay,
             data->synapse_type, post_index, data->synapse_type_bits,
             data->synapse_index_bits, data->delay_bits);
+
+    // The row no longer has a single delay if this differs from the first
+    uint32_t delay_mask = ((1 << data->delay_bits) - 1) <<
+            (data->synapse_index_bits + data->synapse_type_bits);
+    if ((pos > 0) && ((word ^ row->fixed_fixed_data[0]) & delay_mask)) {
+        row->fixed_plastic_size &=
+                ~(SYNAPSE_ROW_SINGLE_DELAY << SYNAPSE_ROW_FORMAT_SHIFT);
+    }
+
+    row->fixed_fixed_size = pos + 1;
+    row->fixed_fixed_data[pos] = word;
+    if (pos == 0) {
+        matrix_generator_row_has_synapses(row);
+    }
     return true;
 }
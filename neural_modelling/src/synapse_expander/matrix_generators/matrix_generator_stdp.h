@@ -165,7 +165,12 @@ static void setup_stdp_rows(uint32_t *matrix, uint32_t n_rows,
         row_fixed_t *fixed = get_stdp_fixed_row(row, n_half_words_per_pp_header,
                 n_half_words_per_pp_synapse, max_row_n_synapses);
         fixed->fixed_fixed_size = 0;
-        fixed->fixed_plastic_size = 0;
+        fixed->fixed_plastic_size = PLASTIC_ROW_FORMAT;
+    }
+
+    // A row with a plastic region is never empty, so needs no more record
+    if (plastic_words > 0) {
+        matrix_generator_record_rows(matrix, n_rows, max_row_n_words, true);
     }
 }
 
@@ -202,9 +207,11 @@ static uint16_t build_fixed_plastic_half_word(
  * \param[in,out] region: Region to read parameters from.  Should be updated
  *                        to position just after parameters after calling.
  * \param[in] synaptic_matrix: The base address of the synaptic matrix
+ * \param[in] set_up_rows: Whether to set up the rows
  * \return A data item to be passed in to other functions later on
  */
-void *matrix_generator_stdp_initialize(void **region, void *synaptic_matrix) {
+void *matrix_generator_stdp_initialize(void **region, void *synaptic_matrix,
+        bool set_up_rows) {
     // Allocate memory for the parameters
     matrix_generator_stdp_data_t *obj =
             spin1_malloc(sizeof(matrix_generator_stdp_data_t));
@@ -218,25 +225,29 @@ void *matrix_generator_stdp_initialize(void **region, void *synaptic_matrix) {
     uint32_t *syn_mat = synaptic_matrix;
     if (obj->synaptic_matrix_offset != 0xFFFFFFFF) {
         obj->synaptic_matrix = &(syn_mat[obj->synaptic_matrix_offset]);
+    } else {
+        obj->synaptic_matrix = NULL;
+    }
+    if (obj->synaptic_matrix != NULL && set_up_rows) {
         setup_stdp_rows(obj->synaptic_matrix, obj->n_pre_neurons,
                 obj->n_half_words_per_pp_row_header,
                 obj->n_half_words_per_pp_synapse, obj->max_row_n_synapses,
                 obj->max_row_n_words, obj->first_word_is_row_index,
 				obj->row_offset);
-    } else {
-        obj->synaptic_matrix = NULL;
     }
 
     if (obj->delayed_matrix_offset != 0xFFFFFFFF) {
         obj->delayed_synaptic_matrix = &(syn_mat[obj->delayed_matrix_offset]);
+    } else {
+        obj->delayed_synaptic_matrix = NULL;
+    }
+    if (obj->delayed_synaptic_matrix != NULL && set_up_rows) {
         setup_stdp_rows(obj->delayed_synaptic_matrix,
                 obj->n_pre_neurons * (obj->max_stage - 1),
                 obj->n_half_words_per_pp_row_header,
                 obj->n_half_words_per_pp_synapse,
                 obj->max_delayed_row_n_synapses, obj->max_delayed_row_n_words,
 				obj->first_word_is_row_index, obj->row_offset);
-    } else {
-        obj->delayed_synaptic_matrix = NULL;
     }
 
     return obj;
@@ -275,7 +286,7 @@ static bool matrix_generator_stdp_write_synapse(void *generator,
         fixed_row = get_stdp_fixed_row(plastic_row,
                 data->n_half_words_per_pp_row_header,
                 data->n_half_words_per_pp_synapse, data->max_row_n_synapses);
-        pos = fixed_row->fixed_plastic_size;
+        pos = fixed_row->fixed_plastic_size & PLASTIC_ROW_N_SYNAPSES_MASK;
         if (pos >= data->max_row_n_synapses) {
             log_warning("Row %u at 0x%08x, 0x%08x of matrix 0x%08x is already full (%u of %u)",
                 pre_index, plastic_row, fixed_row, data->synaptic_matrix, pos,
@@ -289,7 +300,7 @@ static bool matrix_generator_stdp_write_synapse(void *generator,
         fixed_row = get_stdp_fixed_row(plastic_row,
                 data->n_half_words_per_pp_row_header,
                 data->n_half_words_per_pp_synapse, data->max_delayed_row_n_synapses);
-        pos = fixed_row->fixed_plastic_size;
+        pos = fixed_row->fixed_plastic_size & PLASTIC_ROW_N_SYNAPSES_MASK;
         if (pos >= data->max_delayed_row_n_synapses) {
             log_warning("Row %u at 0x%08x, 0x%08x of matrix 0x%08x is already full (%u of %u)",
                 pre_index, plastic_row, fixed_row, data->synaptic_matrix, pos,
@@ -300,7 +311,7 @@ static bool matrix_generator_stdp_write_synapse(void *generator,
 
     uint16_t scaled_weight = rescale_weight(weight, weight_scale);
 
-    fixed_row->fixed_plastic_size = pos + 1;
+    fixed_row->fixed_plastic_size = PLASTIC_ROW_FORMAT | (pos + 1);
     fixed_row->fixed_plastic_data[pos] = build_fixed_plastic_half_word(
             delay_and_stage.delay, data->synapse_type, post_index,
             data->synapse_type_bits, data->synapse_index_bits, data->delay_bits);
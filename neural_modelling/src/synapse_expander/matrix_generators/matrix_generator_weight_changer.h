@@ -95,8 +95,11 @@ static void setup_changer_rows(uint32_t *matrix, uint32_t n_rows,
         row->is_update = 1;
         row_changer_fixed_t *fixed = get_changer_fixed_row(row);
         fixed->fixed_fixed_size = 0;
-        fixed->fixed_plastic_size = 0;
+        fixed->fixed_plastic_size = PLASTIC_ROW_FORMAT;
     }
+
+    // A row with a plastic region is never empty
+    matrix_generator_record_rows(matrix, n_rows, max_row_n_words, true);
 }
 
 
@@ -105,10 +108,11 @@ static void setup_changer_rows(uint32_t *matrix, uint32_t n_rows,
  * \param[in,out] region: Region to read parameters from.  Should be updated
  *                        to position just after parameters after calling.
  * \param[in] synaptic_matrix: The base address of the synaptic matrix
+ * \param[in] set_up_rows: Whether to set up the rows
  * \return A data item to be passed in to other functions later on
  */
 void *matrix_generator_changer_initialize(void **region,
-        void *synaptic_matrix) {
+        void *synaptic_matrix, bool set_up_rows) {
     // Allocate memory for the parameters
     matrix_generator_weight_changer *conf =
             spin1_malloc(sizeof(matrix_generator_weight_changer));
@@ -121,8 +125,10 @@ void *matrix_generator_changer_initialize(void **region,
     // Offsets are in words
     uint32_t *syn_mat = synaptic_matrix;
     conf->synaptic_matrix = &(syn_mat[conf->synaptic_matrix_offset]);
-    setup_changer_rows(conf->synaptic_matrix, conf->n_pre_neurons,
-    		conf->max_row_n_words, conf->row_offset);
+    if (set_up_rows) {
+        setup_changer_rows(conf->synaptic_matrix, conf->n_pre_neurons,
+                conf->max_row_n_words, conf->row_offset);
+    }
 
     return conf;
 }
@@ -156,7 +162,7 @@ static bool matrix_generator_changer_write_synapse(void *generator,
     row_changer_plastic_t *plastic_row = get_changer_row(conf->synaptic_matrix,
             conf->max_row_n_words, pre_index);
     row_changer_fixed_t *fixed_row = get_changer_fixed_row(plastic_row);
-    uint32_t pos = fixed_row->fixed_plastic_size;
+    uint32_t pos = fixed_row->fixed_plastic_size & PLASTIC_ROW_N_SYNAPSES_MASK;
     if (pos >= conf->max_row_n_synapses) {
         log_warning("Row %u at 0x%08x, 0x%08x of matrix 0x%08x is already full (%u of %u)",
                 pre_index, plastic_row, fixed_row, conf->synaptic_matrix, pos,
@@ -168,7 +174,7 @@ static bool matrix_generator_changer_write_synapse(void *generator,
     if (weight < 0) {
         signed_weight = -signed_weight;
     }
-    fixed_row->fixed_plastic_size = pos + 1;
+    fixed_row->fixed_plastic_size = PLASTIC_ROW_FORMAT | (pos + 1);
 	fixed_row->fixed_plastic_data[pos] = build_changer_word(conf->synapse_type,
 			post_index, conf->synapse_type_bits, conf->synapse_index_bits,
 			signed_weight);
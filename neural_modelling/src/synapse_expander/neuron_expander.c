@@ -23,6 +23,7 @@
 #include "param_generator.h"
 #include "rng.h"
 #include "type_writers.h"
+#include "expander_timing.h"
 
 #include <spin1_api.h>
 #include <data_specification.h>
@@ -33,6 +34,10 @@
 
 #define REPEAT_PER_NEURON_RECORDED 0x7FFFFFFF
 
+//! \brief The timing record of a type of parameter generator: the type, the
+//!     number of values generated and the ticks taken
+#define GENERATOR_TIMING_WORDS 3
+
 // Mask to work out MOD 4
 #define MOD_4 0x3
 
@@ -53,6 +58,40 @@ static const uint32_t ADD[4][3] = {
     {1, 0, 1}   // Offset 3 - needs shift for 2, 4 and 8 (indices 2, 0, 0)
 };
 
+/**
+ * \brief Add the time taken by a parameter generator to the record of its
+ *        type, so that there is one record for each type used
+ * \param[in] generator: The type of the generator
+ * \param[in] n_values: The number of values generated
+ * \param[in] start: The time the generation started
+ */
+static void record_generator_time(
+        uint32_t generator, uint32_t n_values, uint32_t start) {
+    uint32_t ticks = expander_timing_now() - start;
+    if (expander_timings == NULL) {
+        return;
+    }
+    uint32_t n_kept = expander_timings->n_records;
+    if (n_kept > expander_timings->max_records) {
+        n_kept = expander_timings->max_records;
+    }
+    for (uint32_t i = 0; i < n_kept; i++) {
+        uint32_t *record =
+                &expander_timings->records[i * GENERATOR_TIMING_WORDS];
+        if (record[0] == generator) {
+            record[1] += n_values;
+            record[2] += ticks;
+            return;
+        }
+    }
+    uint32_t *record = expander_timing_next_record(GENERATOR_TIMING_WORDS);
+    if (record != NULL) {
+        record[0] = generator;
+        record[1] = n_values;
+        record[2] = ticks;
+    }
+}
+
 static inline uint32_t align_offset(uint32_t offset, uint32_t size) {
     if (size == 0) {
         log_error("Size of 0!");
@@ -101,12 +140,14 @@ typedef struct sdram_variable_recording_data {
     uint32_t rate;
     uint32_t n_recording;
     uint32_t element_size;
+    uint32_t encoding;
     uint16_t indices[];
 } sdram_variable_recording_data_t;
 
 typedef struct sdram_bitfield_recording_data {
     uint32_t rate;
     uint32_t n_recording;
+    uint32_t encoding;
     uint16_t indices[];
 } sdram_bitfield_recording_data_t;
 
@@ -118,6 +159,7 @@ typedef struct recording_index {
 typedef struct variable_recording {
     uint32_t rate;
     uint32_t element_size;
+    uint32_t encoding;
     uint32_t n_recording;
     uint32_t n_index_items;
     recording_index_t index_items[];
@@ -125,6 +167,7 @@ typedef struct variable_recording {
 
 typedef struct bitfield_recording {
     uint32_t rate;
+    uint32_t encoding;
     uint32_t n_recording;
     uint32_t n_index_items;
     recording_index_t index_items[];
@@ -214,6 +257,7 @@ static bool read_struct_builder_region(void **region,
             log_debug("            Item %u, generator=%u, n_repeats=%u",
                     i, item.generator, item.n_repeats);
 
+            uint32_t start = expander_timing_now();
             param_generator_t gen = param_generator_init(item.generator, region);
             if (gen == NULL) {
                 return false;
@@ -236,6 +280,7 @@ static bool read_struct_builder_region(void **region,
 
             // Finish with the generator
             param_generator_free(gen);
+            record_generator_time(item.generator, n_repeats, start);
         }
 
         // After writing, add to the offset for the next parameter
@@ -320,6 +365,7 @@ static void read_recorded_variable(void **region, void **recording_region,
     uint32_t n_recording = get_n_recording(rec->n_recording, n_neurons);
     sdram_out->rate = rate;
     sdram_out->element_size = rec->element_size;
+    sdram_out->encoding = rec->encoding;
     sdram_out->n_recording = n_recording;
 
     if (rate == 0) {
@@ -346,6 +392,7 @@ static void read_recorded_bitfield(void **region, void **recording_region,
     uint32_t n_recording = get_n_recording(rec->n_recording, n_neurons);
     sdram_out->rate = rate;
     sdram_out->n_recording = n_recording;
+    sdram_out->encoding = rec->encoding;
 
     if (rate == 0) {
         write_zero_index(n_neurons_max, &sdram_out->indices[0]);
@@ -446,6 +493,10 @@ void c_main(void) {
     vcpu_t *virtual_processor_table = (vcpu_t*) SV_VCPU;
     uint user1 = virtual_processor_table[spin1_get_core_id()].user1;
 
+    // USER3 is where to put the timings, if they are wanted
+    expander_timing_init(virtual_processor_table[spin1_get_core_id()].user3);
+    uint32_t start = expander_timing_now();
+
     // Get the addresses of the regions
     data_specification_metadata_t *ds_regions =
             data_specification_get_data_address();
@@ -457,6 +508,7 @@ void c_main(void) {
         log_info("!!!   Error reading SDRAM data   !!!");
         rt_error(RTE_ABORT);
     }
+    expander_timing_finish(start);
 
     log_info("Finished On Machine Connectors!");
 }
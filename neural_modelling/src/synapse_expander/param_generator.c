@@ -22,6 +22,7 @@
 #include <spin1_api.h>
 #include <debug.h>
 #include "generator_types.h"
+#include "rng.h"
 
 #include "param_generators/param_generator_constant.h"
 #include "param_generators/param_generator_uniform.h"
@@ -30,6 +31,7 @@
 #include "param_generators/param_generator_normal_clipped_to_boundary.h"
 #include "param_generators/param_generator_exponential.h"
 #include "param_generators/param_generator_exponential_clipped.h"
+#include "param_generators/param_generator_lognormal.h"
 
 //! The "hashes" for parameter generators
 enum {
@@ -47,6 +49,8 @@ enum {
     EXPONENTIAL,
 	//! A parameter that is a clipped-exponentially-distributed random variable
 	EXPONENTIAL_CLIPPED,
+    //! A parameter that is a log-normally-distributed random variable
+    LOGNORMAL,
     //! The number of known generators
     N_PARAM_GENERATORS
 };
@@ -108,7 +112,11 @@ static const struct param_generator_info param_generators[] = {
 	{EXPONENTIAL_CLIPPED,
 			param_generator_exponential_clipped_initialize,
 			param_generator_exponential_clipped_generate,
-			param_generator_exponential_clipped_free}
+			param_generator_exponential_clipped_free},
+    {LOGNORMAL,
+            param_generator_lognormal_initialize,
+            param_generator_lognormal_generate,
+            param_generator_lognormal_free}
 };
 
 param_generator_t param_generator_init(uint32_t hash, void **in_region) {
@@ -129,6 +137,11 @@ param_generator_t param_generator_init(uint32_t hash, void **in_region) {
             // Store the index
             generator->type = type;
 
+#if EXPANDER_PARAM_TABLES
+            // The tables are shared by all generators
+            rng_build_tables();
+#endif
+
             // Initialise the generator and store the data
             generator->data = type->initialize(in_region);
             return generator;
@@ -87,7 +87,7 @@ static accum param_generator_exponential_clipped_generate(void *generator) {
     uint32_t n_draws = 0;
 	accum value = 0k;
 	do {
-		value = rng_normal(core_rng);
+		value = rng_exponential(core_rng);
 		value = value * obj->params.beta;
 		n_draws++;
 	} while ((value < obj->params.low || value > obj->params.high)
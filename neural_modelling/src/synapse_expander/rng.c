@@ -21,17 +21,165 @@
 #include "rng.h"
 #include <spin1_api.h>
 #include <normal.h>
+#include <stdfix-exp.h>
 #include "common_mem.h"
 
+#if EXPANDER_RNG_XOSHIRO
+//! \brief Rotate a value left
+//! \param[in] x: The value to rotate
+//! \param[in] k: The number of bits to rotate by
+//! \return The rotated value
+static inline uint32_t rotl(uint32_t x, uint32_t k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+//! \brief Generate a number with xoshiro128++
+//! \param[in,out] s: The state of the generator
+//! \return The number generated between 0 and 0xFFFFFFFF
+static uint32_t xoshiro128pp(uint32_t *s) {
+    uint32_t result = rotl(s[0] + s[3], 7) + s[0];
+    uint32_t t = s[1] << 9;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 11);
+    return result;
+}
+
+//! The function that generates uniform numbers
+#define RNG_NEXT xoshiro128pp
+
+//! \brief Move a generator on by the polynomial of a jump
+//! \param[in,out] rng: The random number generator instance to move on
+//! \param[in] jump: The jump polynomial
+static void rng_jump_by(rng_t *rng, const uint32_t jump[4]) {
+    uint32_t s[4] = {0, 0, 0, 0};
+    for (uint32_t i = 0; i < 4; i++) {
+        for (uint32_t b = 0; b < 32; b++) {
+            if (jump[i] & (1u << b)) {
+                for (uint32_t j = 0; j < 4; j++) {
+                    s[j] ^= rng->seed[j];
+                }
+            }
+            xoshiro128pp(rng->seed);
+        }
+    }
+    for (uint32_t j = 0; j < 4; j++) {
+        rng->seed[j] = s[j];
+    }
+}
+
+void rng_jump(rng_t *rng) {
+    static const uint32_t JUMP[] = {
+        0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b};
+    rng_jump_by(rng, JUMP);
+}
+
+void rng_long_jump(rng_t *rng) {
+    static const uint32_t LONG_JUMP[] = {
+        0xb523952e, 0x0b6f099f, 0xccf5a0ef, 0x1c580662};
+    rng_jump_by(rng, LONG_JUMP);
+}
+#else
+//! The function that generates uniform numbers
+#define RNG_NEXT mars_kiss64_seed
+#endif
+
 uint32_t rng_generator(rng_t *rng) {
-    return mars_kiss64_seed(rng->seed);
+    return RNG_NEXT(rng->seed);
 }
 
+#if EXPANDER_PARAM_TABLES
+//! The number of top bits of a uniform number that select a table entry
+#define TABLE_BITS 8
+//! The number of entries in each table
+#define TABLE_SIZE (1 << TABLE_BITS)
+//! The shift to get the table entry from a uniform number
+#define TABLE_SHIFT (32 - TABLE_BITS)
+//! The mask to get the fraction between table entries from a uniform number
+#define TABLE_FRAC_MASK ((1u << TABLE_SHIFT) - 1)
+//! \brief The number of entries at each end of the normal table that are
+//!     computed exactly instead, as interpolation is poor in the tails
+#define NORMAL_TAIL_ENTRIES 4
+//! \brief The entry of the exponential table beyond which the tail is
+//!     generated by drawing again, as interpolation is poor in the tail
+#define EXPONENTIAL_TAIL_ENTRY (TABLE_SIZE - 8)
+//! The number of Newton steps to take to find each exponential table entry
+#define N_NEWTON_STEPS 4
+
+//! The normal inverse distribution at i / TABLE_SIZE; entry 0 is not used
+static accum normal_table[TABLE_SIZE];
+
+//! The exponential inverse distribution at i / TABLE_SIZE
+static accum exponential_table[TABLE_SIZE];
+
+//! Whether the tables have been built
+static bool tables_built = false;
+
+void rng_build_tables(void) {
+    if (tables_built) {
+        return;
+    }
+    for (uint32_t i = 1; i < TABLE_SIZE; i++) {
+        normal_table[i] = norminv_urt(i << TABLE_SHIFT);
+    }
+
+    // Solve exp(-x) = 1 - i / TABLE_SIZE by Newton's method; starting from
+    // the entry before means that this converges without overshooting
+    accum x = 0k;
+    exponential_table[0] = x;
+    for (uint32_t i = 1; i < TABLE_SIZE; i++) {
+        accum c = kbits((TABLE_SIZE - i) << (15 - TABLE_BITS));
+        for (uint32_t n = 0; n < N_NEWTON_STEPS; n++) {
+            x = x + 1k - (c * expk(x));
+        }
+        exponential_table[i] = x;
+    }
+    tables_built = true;
+}
+
+//! \brief Interpolate linearly between two entries of a table
+//! \param[in] table: The table to interpolate in
+//! \param[in] u: The uniform number; the entry it selects must not be the
+//!     last in the table
+//! \return The interpolated value
+static inline accum table_interpolate(const accum *table, uint32_t u) {
+    uint32_t i = u >> TABLE_SHIFT;
+    int32_t low = bitsk(table[i]);
+    int32_t diff = bitsk(table[i + 1]) - low;
+    return kbits(low + (int32_t)
+            (((int64_t) diff * (u & TABLE_FRAC_MASK)) >> TABLE_SHIFT));
+}
+
+accum rng_exponential(rng_t *rng) {
+    // The exponential distribution is memoryless, so the tail is the same
+    // shape again, just moved along
+    accum offset = 0k;
+    uint32_t u = rng_generator(rng);
+    while ((u >> TABLE_SHIFT) >= EXPONENTIAL_TAIL_ENTRY) {
+        offset += exponential_table[EXPONENTIAL_TAIL_ENTRY];
+        u = rng_generator(rng);
+    }
+    return offset + table_interpolate(exponential_table, u);
+}
+
+accum rng_normal(rng_t *rng) {
+    uint32_t u = rng_generator(rng);
+    uint32_t i = u >> TABLE_SHIFT;
+    if (i < NORMAL_TAIL_ENTRIES || i >= TABLE_SIZE - NORMAL_TAIL_ENTRIES) {
+        return norminv_urt(u);
+    }
+    return table_interpolate(normal_table, u);
+}
+#else
 accum rng_exponential(rng_t *rng) {
-    return exponential_dist_variate(mars_kiss64_seed, rng->seed);
+    return exponential_dist_variate(RNG_NEXT, rng->seed);
 }
 
 accum rng_normal(rng_t *rng) {
     uint32_t random_value = rng_generator(rng);
     return norminv_urt(random_value);
 }
+#endif
@@ -24,6 +24,18 @@
 #include <common-typedefs.h>
 #include <random.h>
 
+#ifndef EXPANDER_RNG_XOSHIRO
+//! \brief Whether to use xoshiro128++ rather than MARS KISS 64 to generate
+//!     random numbers; both use the same 128 bits of seed
+#define EXPANDER_RNG_XOSHIRO 0
+#endif
+
+#ifndef EXPANDER_PARAM_TABLES
+//! \brief Whether to generate normal and exponential numbers by
+//!     interpolating in tables of their inverse distribution functions
+#define EXPANDER_PARAM_TABLES 0
+#endif
+
 /**
  * \brief The Random number generator parameters
  */
@@ -61,6 +73,30 @@ accum rng_exponential(rng_t *rng);
  */
 accum rng_normal(rng_t *rng);
 
+#if EXPANDER_PARAM_TABLES
+/**
+ * \brief Build the tables used by rng_normal() and rng_exponential(); does
+ *     nothing after the first call
+ */
+void rng_build_tables(void);
+#endif
+
+#if EXPANDER_RNG_XOSHIRO
+/**
+ * \brief Move a random number generator on by 2^64 numbers, in constant
+ *     time; used to give independent streams from the same seed
+ * \param[in,out] rng: The random number generator instance to move on
+ */
+void rng_jump(rng_t *rng);
+
+/**
+ * \brief Move a random number generator on by 2^96 numbers, in constant
+ *     time; used to give independent streams within the stream of a core
+ * \param[in,out] rng: The random number generator instance to move on
+ */
+void rng_long_jump(rng_t *rng);
+#endif
+
 /**
  * \brief Finish with a random number generator
  * \param[in] rng: The generator to free
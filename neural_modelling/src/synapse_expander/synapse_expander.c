@@ -31,9 +31,41 @@
 #include <key_atom_map.h>
 #include "common_mem.h"
 #include "bit_field_expander.h"
+#include "expander_timing.h"
 
 #define INVALID_REGION_ID 0xFFFFFFFF
 
+#ifndef EXPANDER_WORK_SHARING
+//! \brief Whether the expander cores of a chip that finish first generate
+//!     ranges of rows of the matrices of those still going; needs
+//!     EXPANDER_RNG_XOSHIRO, to give each range its own stream of numbers
+#define EXPANDER_WORK_SHARING 0
+#endif
+
+#if EXPANDER_WORK_SHARING && !EXPANDER_RNG_XOSHIRO
+#error "EXPANDER_WORK_SHARING needs EXPANDER_RNG_XOSHIRO"
+#endif
+
+#ifndef EXPANDER_WORK_ITEM_PAIRS
+//! The number of pairs of neurons in each range of rows shared
+#define EXPANDER_WORK_ITEM_PAIRS 65536
+#endif
+
+//! The number of cores of a chip that can share work
+#define EXPANDER_N_CORES 18
+
+//! The time to wait between checks that the work shared is done
+#define EXPANDER_WAIT_US 10
+
+//! \brief The longest time to wait for the work shared to make progress
+//!     before giving up on it, in case a core helping with it has stopped
+#define EXPANDER_STALL_US 10000000
+
+//! \brief The timing record of a range of rows of a connector:
+//!     the matrix, connector, weight and delay types, the number of rows and
+//!     the ticks taken
+#define BUILDER_TIMING_WORDS 6
+
 //! The configuration of the connection builder
 typedef struct connection_builder_config {
     // the per-connector parameters
@@ -56,76 +88,483 @@ typedef struct expander_config {
     uint32_t master_pop_region;
     uint32_t bitfield_filter_region;
     uint32_t structural_region;
+    uint32_t post_index_region;
     uint32_t n_in_edges;
     uint32_t post_slice_start;
     uint32_t post_slice_count;
     uint32_t post_index;
     uint32_t n_synapse_types;
     accum timestep_per_delay;
+    //! Keeps the weight scales on a double word boundary
+    uint32_t padding;
     rng_t population_rng;
     rng_t core_rng;
     unsigned long accum weight_scales[];
 } expander_config_t;
 
+//! The generators of a connection builder
+typedef struct connection_builder {
+    connection_builder_config_t config;
+    matrix_generator_t matrix_generator;
+    connection_generator_t connection_generator;
+    param_generator_t weight_generator;
+    param_generator_t delay_generator;
+} connection_builder_t;
+
 rng_t *population_rng;
 rng_t *core_rng;
 
 /**
- * \brief Generate the synapses for a single connector
- * \param[in,out] in_region: The address to read the parameters from. Should be
- *                           updated to the position just after the parameters
- *                           after calling.
- * \param[in] synaptic_matrix_region: The address of the synaptic matrices
- * \param[in] post_slice_start: The start of the slice of the post-population to
- *                              generate for
- * \param[in] post_slice_count: The number of neurons to generate for
- * \param[in] n_synapse_type_bits: The number of bits in the synapse type
- * \param[in] n_synapse_index_bits: The number of bits for the neuron index id
- * \param[in] weight_scales: An array of weight scales, one for each synapse
- *                           type
+ * \brief Read the parameters of a connector and make its generators
+ * \param[out] builder: The generators made
+ * \param[in,out] region: The address to read the parameters from. Should be
+ *                        updated to the position just after the parameters
+ *                        after calling.
+ * \param[in] synaptic_matrix: The address of the synaptic matrices
+ * \param[in] set_up_rows: Whether to set up the rows of the matrix
  * \return true on success, false on failure
  */
-static bool read_connection_builder_region(void **region,
-        void *synaptic_matrix, uint32_t post_slice_start,
-        uint32_t post_slice_count, uint32_t post_index,
-        unsigned long accum *weight_scales, accum timestep_per_delay) {
+static bool connection_builder_init(connection_builder_t *builder,
+        void **region, void *synaptic_matrix, bool set_up_rows) {
     connection_builder_config_t *sdram_config = *region;
-    connection_builder_config_t config = *sdram_config;
+    builder->config = *sdram_config;
     *region = &sdram_config[1];
 
     // Get the matrix, connector, weight and delay parameter generators
-    matrix_generator_t matrix_generator =
-            matrix_generator_init(config.matrix_type, region, synaptic_matrix);
-    connection_generator_t connection_generator =
-            connection_generator_init(config.connector_type, region);
-    param_generator_t weight_generator =
-            param_generator_init(config.weight_type, region);
-    param_generator_t delay_generator =
-            param_generator_init(config.delay_type, region);
+    builder->matrix_generator = matrix_generator_init(
+            builder->config.matrix_type, region, synaptic_matrix,
+            set_up_rows);
+    builder->connection_generator = connection_generator_init(
+            builder->config.connector_type, region);
+    builder->weight_generator = param_generator_init(
+            builder->config.weight_type, region);
+    builder->delay_generator = param_generator_init(
+            builder->config.delay_type, region);
 
     // If any components couldn't be created return false
-    if (matrix_generator == NULL || connection_generator == NULL
-            || delay_generator == NULL || weight_generator == NULL) {
+    return builder->matrix_generator != NULL
+            && builder->connection_generator != NULL
+            && builder->delay_generator != NULL
+            && builder->weight_generator != NULL;
+}
+
+/**
+ * \brief Generate the synapses of a connector from a range of pre-neurons
+ * \param[in] builder: The generators of the connector
+ * \param[in] pre_lo: The first pre-neuron to generate from
+ * \param[in] pre_hi: The last pre-neuron to generate from
+ * \param[in] config: The configuration of the core the matrix is for
+ * \return true on success, false on failure
+ */
+static bool connection_builder_generate(const connection_builder_t *builder,
+        uint32_t pre_lo, uint32_t pre_hi, const expander_config_t *config) {
+    return connection_generator_generate(
+            builder->connection_generator, pre_lo, pre_hi,
+            builder->config.post_lo, builder->config.post_hi,
+            config->post_index, config->post_slice_start,
+            config->post_slice_count,
+            config->weight_scales[builder->config.synapse_type],
+            config->timestep_per_delay, builder->weight_generator,
+            builder->delay_generator, builder->matrix_generator);
+}
+
+/**
+ * \brief Free the generators of a connector
+ * \param[in] builder: The generators to free
+ */
+static void connection_builder_free(connection_builder_t *builder) {
+    // Free the neuron four!
+    matrix_generator_free(builder->matrix_generator);
+    connection_generator_free(builder->connection_generator);
+    param_generator_free(builder->weight_generator);
+    param_generator_free(builder->delay_generator);
+}
+
+/**
+ * \brief Record the time taken to generate a range of rows of a connector
+ * \param[in] builder: The generators of the connector
+ * \param[in] n_rows: The number of rows generated
+ * \param[in] start: The time the generation started
+ */
+static void connection_builder_record_time(
+        const connection_builder_t *builder, uint32_t n_rows, uint32_t start) {
+    uint32_t *record = expander_timing_next_record(BUILDER_TIMING_WORDS);
+    if (record != NULL) {
+        record[0] = builder->config.matrix_type;
+        record[1] = builder->config.connector_type;
+        record[2] = builder->config.weight_type;
+        record[3] = builder->config.delay_type;
+        record[4] = n_rows;
+        record[5] = expander_timing_now() - start;
+    }
+}
+
+/**
+ * \brief Generate the synapses for a single connector
+ * \param[in,out] region: The address to read the parameters from. Should be
+ *                        updated to the position just after the parameters
+ *                        after calling.
+ * \param[in] synaptic_matrix: The address of the synaptic matrices
+ * \param[in] config: The configuration of the expander
+ * \return true on success, false on failure
+ */
+static bool read_connection_builder_region(void **region,
+        void *synaptic_matrix, const expander_config_t *config) {
+    uint32_t start = expander_timing_now();
+    connection_builder_t builder;
+    if (!connection_builder_init(&builder, region, synaptic_matrix, true)) {
+        return false;
+    }
+    if (!connection_builder_generate(&builder, builder.config.pre_lo,
+            builder.config.pre_hi, config)) {
         return false;
     }
+    connection_builder_free(&builder);
+    connection_builder_record_time(&builder,
+            builder.config.pre_hi - builder.config.pre_lo + 1, start);
+
+    // Return success!
+    return true;
+}
+
+/**
+ * \brief Generate the synapses for all the connectors, one after another
+ * \param[in,out] region: The address of the first connector; updated to the
+ *                        position after the last
+ * \param[in] synaptic_matrix: The address of the synaptic matrices
+ * \param[in] config: The configuration of the expander
+ * \return true on success, false on failure
+ */
+static bool generate_all(void **region, void *synaptic_matrix,
+        const expander_config_t *config) {
+    for (uint32_t edge = 0; edge < config->n_in_edges; edge++) {
+        if (!read_connection_builder_region(region, synaptic_matrix, config)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#if EXPANDER_WORK_SHARING
+//! \brief A range of rows of a connector, that any expander core of the chip
+//!     can generate
+typedef struct expander_item {
+    //! The parameters of the connector in SDRAM
+    void *params;
+    //! The first pre-neuron of the range
+    uint32_t pre_lo;
+    //! The last pre-neuron of the range
+    uint32_t pre_hi;
+    //! \brief The state of the RNG of the range, so that the synapses are
+    //!     the same whichever core generates them
+    rng_t rng;
+} expander_item_t;
+
+//! \brief The work of an expander core that can be shared, in an SDRAM table
+//!     of one per core of the chip that the host makes
+typedef struct expander_share {
+    //! Whether the rows are set up so that the items can be taken
+    volatile uint32_t ready;
+    //! The configuration of the core, in SDRAM
+    expander_config_t *config;
+    //! The synaptic matrices of the core
+    void *synaptic_matrix;
+    //! The items of the core, in SDRAM
+    expander_item_t *items;
+    //! The number of items
+    uint32_t n_items;
+    //! The next item to take
+    volatile uint32_t next_item;
+    //! The number of items finished
+    volatile uint32_t n_done;
+    //! The number of items finished by other cores
+    volatile uint32_t n_helped;
+    //! Whether any item failed
+    volatile uint32_t failed;
+} expander_share_t;
+
+//! The table of shared work, or NULL if work is not shared
+static expander_share_t *shares = NULL;
+
+/**
+ * \brief Take the next item of a core, if there is one
+ * \param[in] share: The shared work of the core
+ * \param[out] item: The index of the item taken
+ * \return Whether an item was taken
+ */
+static bool share_take(expander_share_t *share, uint32_t *item) {
+    bool taken = false;
+    uint cpsr = sark_lock_get(LOCK_SEMA);
+    if (share->ready && share->next_item < share->n_items) {
+        *item = share->next_item++;
+        taken = true;
+    }
+    sark_lock_free(cpsr, LOCK_SEMA);
+    return taken;
+}
+
+/**
+ * \brief Mark the work of a core as failed, and the items not yet taken as
+ *        done, so that no more are taken and the core does not wait for them
+ * \note Called with the lock held
+ * \param[in] share: The shared work of the core
+ */
+static inline void share_fail_locked(expander_share_t *share) {
+    share->failed = 1;
+    share->n_done += share->n_items - share->next_item;
+    share->next_item = share->n_items;
+}
+
+/**
+ * \brief Mark the work of a core as failed, and the items not yet taken as
+ *        done
+ * \param[in] share: The shared work of the core
+ */
+static void share_fail(expander_share_t *share) {
+    uint cpsr = sark_lock_get(LOCK_SEMA);
+    share_fail_locked(share);
+    sark_lock_free(cpsr, LOCK_SEMA);
+}
+
+/**
+ * \brief Mark the work of a core as failed before it had any items to share,
+ *        so that it is ready with nothing to take
+ * \param[in] share: The shared work of the core
+ */
+static void share_fail_empty(expander_share_t *share) {
+    share->items = NULL;
+    share->n_items = 0;
+    share->next_item = 0;
+    share->n_done = 0;
+    share->n_helped = 0;
+    share->failed = 1;
+    share->ready = 1;
+}
+
+/**
+ * \brief Generate an item of a core
+ * \param[in] share: The shared work of the core
+ * \param[in] index: The index of the item to generate
+ * \param[in] helping: Whether the core is not the one that the item is for
+ */
+static void share_generate(
+        expander_share_t *share, uint32_t index, bool helping) {
+    expander_item_t *item = &share->items[index];
+
+    // The rows are already set up, and the item has its own RNG
+    uint32_t start = expander_timing_now();
+    rng_t rng = item->rng;
+    rng_t *own_core_rng = core_rng;
+    core_rng = &rng;
+    void *region = item->params;
+    connection_builder_t builder;
+    bool success = connection_builder_init(
+            &builder, &region, share->synaptic_matrix, false);
+    if (success) {
+        success = connection_builder_generate(
+                &builder, item->pre_lo, item->pre_hi, share->config);
+        connection_builder_free(&builder);
+        connection_builder_record_time(
+                &builder, item->pre_hi - item->pre_lo + 1, start);
+    }
+    core_rng = own_core_rng;
 
-    if (!connection_generator_generate(
-            connection_generator, config.pre_lo, config.pre_hi, config.post_lo,
-            config.post_hi, post_index, post_slice_start, post_slice_count,
-            weight_scales[config.synapse_type], timestep_per_delay,
-            weight_generator, delay_generator, matrix_generator)) {
+    uint cpsr = sark_lock_get(LOCK_SEMA);
+    share->n_done++;
+    if (helping) {
+        share->n_helped++;
+    }
+    if (!success) {
+        share_fail_locked(share);
+    }
+    sark_lock_free(cpsr, LOCK_SEMA);
+}
+
+/**
+ * \brief Generate any items of the other cores that are left to take
+ * \return Whether any item was generated
+ */
+static bool share_help_others(void) {
+    uint32_t core = spin1_get_core_id();
+    bool helped = false;
+    uint32_t item;
+    for (uint32_t c = 0; c < EXPANDER_N_CORES; c++) {
+        if (c == core) {
+            continue;
+        }
+        while (share_take(&shares[c], &item)) {
+            share_generate(&shares[c], item, true);
+            helped = true;
+        }
+    }
+    return helped;
+}
+
+/**
+ * \brief Generate the synapses for all the connectors, sharing the ranges of
+ *        rows of those that can be split with the other expander cores of
+ *        the chip, and helping them with theirs
+ * \param[in,out] region: The address of the first connector; updated to the
+ *                        position after the last
+ * \param[in] synaptic_matrix: The address of the synaptic matrices
+ * \param[in] sdram_config: The configuration of the expander in SDRAM
+ * \param[in] config: The configuration of the expander
+ * \return true on success, false on failure
+ */
+static bool generate_shared(void **region, void *synaptic_matrix,
+        expander_config_t *sdram_config, const expander_config_t *config) {
+    expander_share_t *share = &shares[spin1_get_core_id()];
+    uint32_t n_edges = config->n_in_edges;
+    void **edges = spin1_malloc((n_edges + 1) * sizeof(void *));
+    if (edges == NULL) {
+        log_error("Could not allocate the %u connectors to share", n_edges);
+        share_fail_empty(share);
         return false;
     }
 
-    // Free the neuron four!
-    matrix_generator_free(matrix_generator);
-    connection_generator_free(connection_generator);
-    param_generator_free(weight_generator);
-    param_generator_free(delay_generator);
+    // Set up all the rows first, so that the items can be taken as soon as
+    // they are known, and count the items
+    uint32_t rows_per_item = EXPANDER_WORK_ITEM_PAIRS;
+    if (config->post_slice_count > 0) {
+        rows_per_item = max(
+                EXPANDER_WORK_ITEM_PAIRS / config->post_slice_count, 1);
+    }
+    uint32_t n_items = 0;
+    edges[0] = *region;
+    for (uint32_t edge = 0; edge < n_edges; edge++) {
+        void *address = edges[edge];
+        connection_builder_t builder;
+        if (!connection_builder_init(&builder, &address, synaptic_matrix,
+                true)) {
+            sark_free(edges);
+            share_fail_empty(share);
+            return false;
+        }
+        connection_builder_free(&builder);
+        edges[edge + 1] = address;
+        if (connection_generator_rows_independent(
+                builder.config.connector_type)) {
+            uint32_t n_rows = builder.config.pre_hi - builder.config.pre_lo + 1;
+            n_items += (n_rows + rows_per_item - 1) / rows_per_item;
+        }
+    }
+    *region = edges[n_edges];
 
-    // Return success!
+    // Split the independent connectors into items, each with its own
+    // stream of numbers within that of this core
+    expander_item_t *items = NULL;
+    if (n_items > 0) {
+        items = sark_xalloc(sv->sdram_heap, n_items * sizeof(expander_item_t),
+                0, ALLOC_LOCK);
+        if (items == NULL) {
+            log_error("Could not allocate %u items to share", n_items);
+            sark_free(edges);
+            share_fail_empty(share);
+            return false;
+        }
+    }
+    rng_t rng = *core_rng;
+    uint32_t n_local = 0;
+    expander_item_t *next = items;
+    for (uint32_t edge = 0; edge < n_edges; edge++) {
+        connection_builder_config_t *edge_config = edges[edge];
+        if (!connection_generator_rows_independent(
+                edge_config->connector_type)) {
+            // Kept in order to be generated here
+            edges[n_local++] = edge_config;
+            continue;
+        }
+        for (uint32_t pre = edge_config->pre_lo; pre <= edge_config->pre_hi;
+                pre += rows_per_item) {
+            rng_long_jump(&rng);
+            next->params = edge_config;
+            next->pre_lo = pre;
+            next->pre_hi = min(pre + rows_per_item - 1, edge_config->pre_hi);
+            next->rng = rng;
+            next++;
+        }
+    }
+    share->config = sdram_config;
+    share->synaptic_matrix = synaptic_matrix;
+    share->items = items;
+    share->n_items = n_items;
+    share->next_item = 0;
+    share->n_done = 0;
+    share->n_helped = 0;
+    share->failed = 0;
+    share->ready = 1;
+    log_info("Sharing %u items of %u rows", n_items, rows_per_item);
+
+    // Generate the connectors that can't be split, in order, as their rows
+    // are only set up; on failure, the items are no longer given out, but
+    // those already taken are waited for below
+    for (uint32_t i = 0; i < n_local; i++) {
+        uint32_t start = expander_timing_now();
+        void *address = edges[i];
+        connection_builder_t builder;
+        if (!connection_builder_init(&builder, &address, synaptic_matrix,
+                false)) {
+            share_fail(share);
+            break;
+        }
+        bool success = connection_builder_generate(&builder,
+                builder.config.pre_lo, builder.config.pre_hi, config);
+        connection_builder_free(&builder);
+        if (!success) {
+            share_fail(share);
+            break;
+        }
+        connection_builder_record_time(&builder,
+                builder.config.pre_hi - builder.config.pre_lo + 1, start);
+    }
+    sark_free(edges);
+
+    // Generate the items of this core, then help the others until there is
+    // nothing left to take and the items of this core are all done, giving
+    // up if they stop being done
+    uint32_t item;
+    while (share_take(share, &item)) {
+        share_generate(share, item, false);
+    }
+    bool helped = true;
+    uint32_t n_done = share->n_done;
+    uint32_t stalled_us = 0;
+    while (helped || share->n_done < share->n_items) {
+        helped = share_help_others();
+        if (helped || share->n_done != n_done) {
+            n_done = share->n_done;
+            stalled_us = 0;
+        } else if (share->n_done < share->n_items) {
+            if (stalled_us >= EXPANDER_STALL_US) {
+                // The items still being done may read the list of items, so
+                // it is not freed
+                share_fail(share);
+                log_error("Only %u of %u items shared were done after "
+                        "waiting %u us", share->n_done, n_items, stalled_us);
+                return false;
+            }
+            spin1_delay_us(EXPANDER_WAIT_US);
+            stalled_us += EXPANDER_WAIT_US;
+        }
+    }
+    if (items != NULL) {
+        sark_xfree(sv->sdram_heap, items, ALLOC_LOCK);
+    }
+    if (share->failed) {
+        log_error("Could not generate all the items shared");
+        return false;
+    }
+    log_info("%u of %u items generated by other cores", share->n_helped,
+            n_items);
+
+    // The rows written by other cores weren't recorded, so they are all
+    // read back to make the bit fields
+    if (share->n_helped > 0) {
+        matrix_generator_free_rows();
+    }
     return true;
 }
+#endif
 
 /**
  * \brief Read the data for the expander
@@ -156,6 +595,14 @@ static bool run_synapse_expander(data_specification_metadata_t *ds_regions,
     // Store the RNGs
     population_rng = &(config->population_rng);
     core_rng = &(config->core_rng);
+#if EXPANDER_RNG_XOSHIRO
+    // Jump the population stream on to one that is unique to this core, so
+    // that the streams of the cores can't overlap
+    *core_rng = *population_rng;
+    for (uint32_t i = 0; i <= config->post_index; i++) {
+        rng_jump(core_rng);
+    }
+#endif
 
     log_info("Population RNG: %u %u %u %u", population_rng->seed[0],
             population_rng->seed[1], population_rng->seed[2],
@@ -167,16 +614,19 @@ static bool run_synapse_expander(data_specification_metadata_t *ds_regions,
 
     // Go through each connector and generate
     void *address = &(sdram_config->weight_scales[config->n_synapse_types]);
-    for (uint32_t edge = 0; edge < config->n_in_edges; edge++) {
-        if (!read_connection_builder_region(
-                &address, synaptic_matrix, config->post_slice_start,
-                config->post_slice_count, config->post_index,
-                config->weight_scales, config->timestep_per_delay)) {
-            return false;
-        }
+#if EXPANDER_WORK_SHARING
+    bool generated = (shares != NULL) ?
+            generate_shared(&address, synaptic_matrix, sdram_config, config) :
+            generate_all(&address, synaptic_matrix, config);
+#else
+    bool generated = generate_all(&address, synaptic_matrix, config);
+#endif
+    if (!generated) {
+        return false;
     }
 
-    // Do bitfield generation on the whole matrix
+    // Do bitfield generation on the whole matrix; the rows generated above
+    // have been recorded, so only those from the host are read
     uint32_t *n_atom_data_sdram = address;
     void *master_pop = data_specification_get_region(
             config->master_pop_region, ds_regions);
@@ -187,6 +637,13 @@ static bool run_synapse_expander(data_specification_metadata_t *ds_regions,
         structural_matrix = data_specification_get_region(
             config->structural_region, ds_regions);
     }
+    post_index_t *post_index = NULL;
+    if (config->post_index_region != INVALID_REGION_ID) {
+        post_index = data_specification_get_region(
+                config->post_index_region, ds_regions);
+        ds_regions->regions[config->post_index_region].n_words = 0;
+        ds_regions->regions[config->post_index_region].checksum = 0;
+    }
 
     // We are changing this region, so void the checksum
     ds_regions->regions[config->bitfield_filter_region].n_words = 0;
@@ -195,8 +652,10 @@ static bool run_synapse_expander(data_specification_metadata_t *ds_regions,
     		config->bitfield_filter_region,
 			&(ds_regions->regions[config->bitfield_filter_region].n_words),
 			&(ds_regions->regions[config->bitfield_filter_region].checksum));
-    return do_bitfield_generation(n_atom_data_sdram, master_pop,
-            synaptic_matrix, bitfield_filter, structural_matrix);
+    bool success = do_bitfield_generation(n_atom_data_sdram, master_pop,
+            synaptic_matrix, bitfield_filter, structural_matrix, post_index);
+    matrix_generator_free_rows();
+    return success;
 }
 
 //! Entry point
@@ -211,6 +670,16 @@ void c_main(void) {
     vcpu_t *virtual_processor_table = (vcpu_t*) SV_VCPU;
     uint user1 = virtual_processor_table[spin1_get_core_id()].user1;
 
+    // USER3 is where to put the timings, if they are wanted
+    expander_timing_init(virtual_processor_table[spin1_get_core_id()].user3);
+    uint32_t start = expander_timing_now();
+#if EXPANDER_WORK_SHARING
+    // USER2 is the table of work shared between the cores of the chip, if
+    // there is one
+    shares = (expander_share_t *)
+            virtual_processor_table[spin1_get_core_id()].user2;
+#endif
+
     // Get the addresses of the regions
     data_specification_metadata_t *ds_regions =
             data_specification_get_data_address();
@@ -222,6 +691,7 @@ void c_main(void) {
         log_info("!!!   Error reading SDRAM data   !!!");
         rt_error(RTE_ABORT);
     }
+    expander_timing_finish(start);
 
     log_info("Finished On Machine Connectors!");
 }
@@ -26,7 +26,8 @@ typedef enum type {
     S1615,
     UINT32,
     INT32,
-    U032
+    U032,
+    U1616
 } type;
 
 typedef void (*type_writer_func_t)(void *, accum);
@@ -57,11 +58,17 @@ static void write_u032(void *address, accum value) {
     values[0] = (unsigned long fract) value;
 }
 
+static void write_u1616(void *address, accum value) {
+    unsigned accum *values = (unsigned accum *) address;
+    values[0] = (unsigned accum) value;
+}
+
 static type_info type_writers[] = {
     {S1615, sizeof(accum), write_s1615},
     {UINT32, sizeof(uint32_t), write_uint32},
     {INT32, sizeof(int32_t), write_int32},
-    {U032, sizeof(unsigned long fract), write_u032}
+    {U032, sizeof(unsigned long fract), write_u032},
+    {U1616, sizeof(unsigned accum), write_u1616}
 };
 
 static type_info *get_type_writer(type t) {
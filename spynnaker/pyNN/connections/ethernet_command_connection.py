@@ -83,11 +83,11 @@ class EthernetCommandConnection(DatabaseConnection):
     def _start_resume_callback(self) -> None:
         # Send commands from each command container
         for command_container in self.__command_containers:
-            for command in command_container.start_resume_commands:
-                self.__translator.translate_control_packet(command)
+            self.__translator.translate_control_packets(
+                command_container.start_resume_commands)
 
     def _stop_pause_callback(self) -> None:
         # Send commands from each command container
         for command_container in self.__command_containers:
-            for command in command_container.pause_stop_commands:
-                self.__translator.translate_control_packet(command)
+            self.__translator.translate_control_packets(
+                command_container.pause_stop_commands)
@@ -12,7 +12,15 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
-from typing import Iterable, List, Optional
+from threading import Lock
+from time import perf_counter, sleep
+from typing import Callable, Iterable, List, Optional, Tuple
+import numpy
+from numpy import uint16, uint32
+from numpy.typing import ArrayLike, NDArray
+from spinnman.messages.eieio import EIEIOType
+from spinnman.messages.eieio.data_messages import (
+    EIEIODataHeader, EIEIODataMessage)
 from spinn_front_end_common.utilities.connections import LiveEventConnection
 from spinn_front_end_common.utilities.constants import NOTIFY_PORT
 
@@ -20,6 +28,78 @@ from spinn_front_end_common.utilities.constants import NOTIFY_PORT
 _MAX_FULL_KEYS_PER_PACKET = 63
 # The maximum number of 16-bit keys that will fit in a packet
 _MAX_HALF_KEYS_PER_PACKET = 127
+# The number of spikes of a time step that space is made for to start with
+_INITIAL_TIME_STEP_SPIKES = 1024
+
+#: The type of a callback given the spikes of a time step as an array
+_ArrayCallback = Callable[[str, int, NDArray[uint32]], None]
+
+
+class _TimeStepSpikes(object):
+    """
+    Gathers the spikes received from a population into one array for each
+    time step, reusing the same space for each time step.
+    """
+    __slots__ = (
+        "__label",
+        "__callback",
+        "__time",
+        "__ids",
+        "__n_ids",
+        "__lock")
+
+    def __init__(self, label: str, callback: _ArrayCallback):
+        """
+        :param str label: The label of the population
+        :param callable(str,int,~numpy.ndarray) callback:
+            What to give the spikes of each time step to
+        """
+        self.__label = label
+        self.__callback = callback
+        self.__time: Optional[int] = None
+        self.__ids = numpy.zeros(_INITIAL_TIME_STEP_SPIKES, dtype=uint32)
+        self.__n_ids = 0
+        self.__lock = Lock()
+
+    def add(self, _label: str, time: int, neuron_ids: List[int]):
+        """
+        Add the spikes of a packet, giving out those of the previous time
+        step if this packet is of a later one.
+
+        :param str _label: The label of the population
+        :param int time: The time step of the spikes
+        :param list(int) neuron_ids: The IDs that spiked
+        """
+        with self.__lock:
+            if self.__time is not None and time != self.__time:
+                self.__flush()
+            self.__time = time
+            end = self.__n_ids + len(neuron_ids)
+            if end > len(self.__ids):
+                ids = numpy.zeros(max(end, 2 * len(self.__ids)), dtype=uint32)
+                ids[:self.__n_ids] = self.__ids[:self.__n_ids]
+                self.__ids = ids
+            self.__ids[self.__n_ids:end] = neuron_ids
+            self.__n_ids = end
+
+    def flush(self, _label: str = "", _connection=None):
+        """
+        Give out the spikes of the time step being gathered, if any.
+
+        :param str _label: The label of the population
+        :param LiveEventConnection _connection: The connection
+        """
+        with self.__lock:
+            self.__flush()
+
+    def __flush(self):
+        if self.__time is None:
+            return
+        time = self.__time
+        n_ids = self.__n_ids
+        self.__time = None
+        self.__n_ids = 0
+        self.__callback(self.__label, time, self.__ids[:n_ids])
 
 
 class SpynnakerLiveSpikesConnection(LiveEventConnection):
@@ -80,3 +160,122 @@ class SpynnakerLiveSpikesConnection(LiveEventConnection):
             whether to send 16-bit neuron IDs directly
         """
         self.send_events(label, neuron_ids, send_full_keys)
+
+    @staticmethod
+    def encode_spike_array(
+            neuron_ids: ArrayLike) -> List[EIEIODataMessage]:
+        """
+        Pack the IDs of the neurons that spike in a time step into as few
+        messages of 16-bit neuron IDs as they will fit in.  This is done on
+        the whole array at once, so it is much faster than adding the spikes
+        one at a time for large numbers of spikes.
+
+        :param ~numpy.ndarray neuron_ids: The IDs of the neurons to spike
+        :rtype: list(~spinnman.messages.eieio.data_messages.EIEIODataMessage)
+        :raises ValueError: If an ID doesn't fit in 16 bits
+        """
+        ids = numpy.asarray(neuron_ids)
+        if not len(ids):
+            return []
+        if ids.min() < 0 or ids.max() > 0xFFFF:
+            raise ValueError(
+                "Neuron IDs must fit in 16 bits to be sent as an array")
+        ids = ids.astype(uint16)
+        return [
+            EIEIODataMessage(
+                EIEIODataHeader(EIEIOType.KEY_16_BIT, count=len(chunk)),
+                data=chunk.tobytes())
+            for chunk in numpy.split(ids, numpy.arange(
+                _MAX_HALF_KEYS_PER_PACKET, len(ids),
+                _MAX_HALF_KEYS_PER_PACKET))]
+
+    def send_spike_array(self, label: str, neuron_ids: ArrayLike):
+        """
+        Send the spikes of a time step held in a numpy array, as 16-bit
+        neuron IDs.
+
+        :param str label:
+            The label of the population from which the spikes will originate
+        :param ~numpy.ndarray neuron_ids: The IDs of the neurons to spike
+        :raises ValueError: If an ID doesn't fit in 16 bits
+        """
+        self.send_encoded_spikes(label, self.encode_spike_array(neuron_ids))
+
+    def send_encoded_spikes(
+            self, label: str, messages: Iterable[EIEIODataMessage]):
+        """
+        Send spikes already packed by :py:meth:`encode_spike_array`.
+
+        :param str label:
+            The label of the population from which the spikes will originate
+        :param messages: The packed spikes
+        :type messages:
+            iterable(~spinnman.messages.eieio.data_messages.EIEIODataMessage)
+        """
+        for message in messages:
+            self.send_eieio_message(message, label)
+
+    def send_spike_frames(
+            self, label: str, frames: Iterable[Tuple[int, ArrayLike]],
+            time_step_ms: float, lead_ms: float = 0.0):
+        """
+        Send the spikes of many time steps, each when its time step is due,
+        for example to replay a recording from an event camera.
+
+        Time is measured from when this is called, so it is best called from
+        a start callback so that time step 0 is when the simulation starts.
+        The spikes of each time step are packed before waiting for it to be
+        due, so that only the sending is left once it is.  This doesn't
+        return until all the spikes have been sent, so it should be run in
+        its own thread if anything else is to be done at the same time.
+
+        :param str label:
+            The label of the population from which the spikes will originate
+        :param frames:
+            The time steps and the IDs of the neurons to spike in each, in
+            time step order; this can be a generator, so that a long
+            recording need not be held in memory at once
+        :type frames: iterable(tuple(int, ~numpy.ndarray))
+        :param float time_step_ms:
+            The time between time steps on the machine in milliseconds; this
+            is the time step multiplied by the time scale factor
+        :param float lead_ms:
+            How long before it is due to send each time step, to allow for
+            the time it takes the spikes to get to the machine
+        """
+        start = perf_counter()
+        for time_step, neuron_ids in frames:
+            messages = self.encode_spike_array(neuron_ids)
+            due = start + (time_step * time_step_ms - lead_ms) / 1000.0
+            wait = due - perf_counter()
+            if wait > 0:
+                sleep(wait)
+            self.send_encoded_spikes(label, messages)
+
+    def add_receive_array_callback(
+            self, label: str, callback: _ArrayCallback,
+            translate_key: bool = True):
+        """
+        Add a callback for the spikes received from a population that is
+        given all the spikes of each time step together as a numpy array,
+        rather than a list for each packet.
+
+        The spikes of a time step are given once a packet of a later time
+        step arrives, or when the simulation pauses or stops.  The array is
+        a view of space that is used again for the next time step, so it
+        must be copied if it is to be kept after the callback returns.
+
+        .. note::
+            This needs the live output to have time stamps in the payload
+            prefix, which it does by default.
+
+        :param str label: The label of the population to receive from
+        :param callable(str,int,~numpy.ndarray) callback:
+            Called with the label, the time step, and the IDs of the neurons
+            that spiked in the time step
+        :param bool translate_key:
+            Whether to give the IDs of the neurons rather than the keys
+        """
+        spikes = _TimeStepSpikes(label, callback)
+        self.add_receive_callback(label, spikes.add, translate_key)
+        self.add_pause_stop_callback(label, spikes.flush)
@@ -32,7 +32,8 @@ from spynnaker.pyNN.external_devices_models import (
     AbstractEthernetController, AbstractEthernetSensor,
     ArbitraryFPGADevice, ExternalCochleaDevice, ExternalFPGARetinaDevice,
     MunichMotorDevice, MunichRetinaDevice, ExternalDeviceLifControl,
-    SPIFRetinaDevice, ICUBRetinaDevice, SPIFOutputDevice, SPIFInputDevice)
+    SPIFRetinaDevice, ICUBRetinaDevice, SPIFOutputDevice, SPIFInputDevice,
+    EventFilterDevice)
 from spynnaker.pyNN import model_binaries
 from spynnaker.pyNN.connections import (
     EthernetCommandConnection, EthernetControlConnection,
@@ -64,6 +65,7 @@ from spynnaker.pyNN.models.utility_models.spike_injector import (
 from spynnaker.pyNN import protocols
 from spynnaker.pyNN.spinnaker import SpiNNaker
 from spynnaker.pyNN.models.neuron import AbstractPopulationVertex
+from spynnaker.pyNN.utilities.constants import SPIKE_PARTITION_ID
 
 
 # useful functions
@@ -84,6 +86,7 @@ __all__ = [
     "MunichRetinaDevice", "MunichMotorDevice", "ArbitraryFPGADevice",
     "PushBotRetinaViewer", "ExternalDeviceLifControl", "SPIFRetinaDevice",
     "ICUBRetinaDevice", "SPIFOutputDevice", "SPIFInputDevice",
+    "EventFilterDevice",
 
     # PushBot Parameters
     "MunichIoSpiNNakerLinkProtocol",
@@ -329,6 +332,39 @@ def EthernetSensorPopulation(
     return population
 
 
+def EventFilterPopulation(
+        retina: Population, label: Optional[str] = None,
+        **kwargs) -> Population:
+    # pylint: disable=invalid-name
+    """
+    Create a pyNN population that receives the events of a retina and sends
+    on only those in a region of interest, pooled and rate-limited, so that a
+    high resolution retina does not overwhelm the cores it projects to.
+
+    :param ~spynnaker.pyNN.models.populations.Population retina:
+        The population of a :py:class:`SPIFRetinaDevice` or
+        :py:class:`ICUBRetinaDevice`
+    :param label: An optional label for the population
+    :type label: str or None
+    :param kwargs: Passed on to :py:class:`EventFilterDevice`
+    :return:
+        A pyNN Population which can be used as the source of a Projection,
+        with one neuron per pooled pixel.
+    :rtype: ~spynnaker.pyNN.models.populations.Population
+    :raises TypeError: If the retina is not a supported retina device
+    """
+    vertex = retina._vertex  # pylint: disable=protected-access
+    if not isinstance(vertex, (SPIFRetinaDevice, ICUBRetinaDevice)):
+        raise TypeError(
+            "The retina must be a SPIFRetinaDevice or ICUBRetinaDevice")
+    population = Population(
+        None, EventFilterDevice(vertex, label=label, **kwargs), label=label)
+    Plugins.add_edge(
+        vertex, population._vertex,  # pylint: disable=protected-access
+        SPIKE_PARTITION_ID)
+    return population
+
+
 def SpikeInjector(
         notify: bool = True, database_notify_host: Optional[str] = None,
         database_notify_port_num: Optional[int] = None,
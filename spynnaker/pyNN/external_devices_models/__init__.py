@@ -31,6 +31,7 @@ from .spif_retina_device import SPIFRetinaDevice
 from .icub_retina_device import ICUBRetinaDevice
 from .spif_output_device import SPIFOutputDevice
 from .spif_input_device import SPIFInputDevice
+from .event_filter_device import EventFilterDevice
 
 __all__ = ["AbstractEthernetController", "AbstractEthernetSensor",
            "AbstractEthernetTranslator", "ArbitraryFPGADevice",
@@ -39,4 +40,5 @@ __all__ = ["AbstractEthernetController", "AbstractEthernetSensor",
            "MachineMunichMotorDevice",
            "MunichMotorDevice", "MunichRetinaDevice", "SendType",
            "ThresholdTypeMulticastDeviceControl", "SPIFRetinaDevice",
-           "ICUBRetinaDevice", "SPIFOutputDevice", "SPIFInputDevice"]
+           "ICUBRetinaDevice", "SPIFOutputDevice", "SPIFInputDevice",
+           "EventFilterDevice"]
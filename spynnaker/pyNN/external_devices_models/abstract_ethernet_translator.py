@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+from typing import Iterable
 from spinn_utilities.abstract_base import AbstractBase, abstractmethod
 from spinn_front_end_common.utility_models import MultiCastCommand
 
@@ -35,3 +36,17 @@ class AbstractEthernetTranslator(object, metaclass=AbstractBase):
             ~spinnman.messages.eieio.data_messages.AbstractDataElement
         """
         raise NotImplementedError
+
+    def translate_control_packets(
+            self, multicast_packets: Iterable[MultiCastCommand]):
+        """
+        Translate several multicast packets in order.  By default each is
+        translated on its own, but translators that can send several
+        commands to the device at once should do so here.
+
+        :param multicast_packets: The received multicast packets
+        :type multicast_packets:
+            iterable(~spinn_front_end_common.utility_models.MultiCastCommand)
+        """
+        for multicast_packet in multicast_packets:
+            self.translate_control_packet(multicast_packet)
@@ -0,0 +1,131 @@
+# Copyright (c) 2026 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from typing import Optional, Tuple, Union
+from spinn_utilities.config_holder import get_config_int
+from spinn_utilities.overrides import overrides
+from pacman.model.graphs.application.abstract import (
+    AbstractOneAppOneMachineVertex)
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+from spynnaker.pyNN.models.common import PopulationApplicationVertex
+from .event_filter_machine_vertex import (
+    EventFilterMachineVertex, EventFilterParameters)
+from .icub_retina_device import ICUBRetinaDevice
+from .spif_retina_device import SPIFRetinaDevice
+
+#: The most output pixels of one filter core, as each has a word of DTCM
+MAX_OUTPUT_PIXELS = 8192
+
+
+class EventFilterDevice(
+        AbstractOneAppOneMachineVertex, PopulationApplicationVertex):
+    """
+    A core that takes the events of a 2D retina and sends on only those in a
+    region of interest, pooled into larger pixels, and no more often than
+    a refractory period per pooled pixel.  This reduces the events a high
+    resolution camera sends to the rest of the network.
+
+    The atoms are the pooled pixels, in the same x-then-y order as the
+    retina, so the filter can be the source of a convolution.
+    """
+
+    __slots__ = ("__params", "__n_colour_bits")
+
+    def __init__(
+            self, retina: Union[SPIFRetinaDevice, ICUBRetinaDevice],
+            x_min: int = 0, y_min: int = 0, width: Optional[int] = None,
+            height: Optional[int] = None, pool_x_shift: int = 0,
+            pool_y_shift: int = 0, refractory_steps: int = 0,
+            n_colour_bits: Optional[int] = None,
+            label: Optional[str] = None):
+        """
+        :param retina: The retina to filter the events of
+        :type retina: SPIFRetinaDevice or ICUBRetinaDevice
+        :param int x_min: The first x coordinate of the region of interest
+        :param int y_min: The first y coordinate of the region of interest
+        :param width:
+            The width of the region of interest, or `None` for the rest of
+            the retina
+        :type width: int or None
+        :param height:
+            The height of the region of interest, or `None` for the rest of
+            the retina
+        :type height: int or None
+        :param int pool_x_shift:
+            The log2 of the width of the retina pixels pooled into one
+        :param int pool_y_shift:
+            The log2 of the height of the retina pixels pooled into one
+        :param int refractory_steps:
+            The time steps after a pooled pixel sends an event before it can
+            send another; 0 to send every event
+        :param n_colour_bits:
+            The number of colour bits to send, or `None` for the default
+        :type n_colour_bits: int or None
+        :param str label:
+        """
+        # pylint: disable=too-many-arguments,protected-access
+        if width is None:
+            width = retina.width - x_min
+        if height is None:
+            height = retina.height - y_min
+        if (x_min < 0 or y_min < 0 or width <= 0 or height <= 0 or
+                x_min + width > retina.width or
+                y_min + height > retina.height):
+            raise ConfigurationException(
+                f"The region of interest ({x_min}, {y_min}) size {width} x "
+                f"{height} is not within the retina of {retina.width} x "
+                f"{retina.height}")
+        if pool_x_shift < 0 or pool_y_shift < 0 or refractory_steps < 0:
+            raise ConfigurationException(
+                "The pool shifts and refractory steps must not be negative")
+        self.__params = EventFilterParameters(
+            x_shift=retina._source_x_shift,
+            x_mask=(1 << retina._x_bits) - 1,
+            y_shift=retina._source_y_shift,
+            y_mask=(1 << retina._y_bits) - 1,
+            x_min=x_min, y_min=y_min, roi_width=width, roi_height=height,
+            pool_x_shift=pool_x_shift, pool_y_shift=pool_y_shift,
+            refractory_steps=refractory_steps)
+        n_atoms = self.__params.out_width * self.__params.out_height
+        if n_atoms > MAX_OUTPUT_PIXELS:
+            raise ConfigurationException(
+                f"The filter would have {n_atoms} output pixels but can "
+                f"have at most {MAX_OUTPUT_PIXELS}; please pool more or use "
+                "a smaller region of interest")
+        if n_colour_bits is None:
+            n_colour_bits = get_config_int("Simulation", "n_colour_bits")
+        self.__n_colour_bits = n_colour_bits
+        super().__init__(
+            EventFilterMachineVertex(
+                self.__params, n_colour_bits, label, app_vertex=self),
+            label, n_atoms)
+
+    @property
+    def filter_parameters(self) -> EventFilterParameters:
+        """
+        How the events are filtered.
+
+        :rtype: EventFilterParameters
+        """
+        return self.__params
+
+    @property
+    @overrides(PopulationApplicationVertex.atoms_shape)
+    def atoms_shape(self) -> Tuple[int, ...]:
+        return (self.__params.out_width, self.__params.out_height)
+
+    @property
+    @overrides(PopulationApplicationVertex.n_colour_bits)
+    def n_colour_bits(self) -> int:
+        return self.__n_colour_bits
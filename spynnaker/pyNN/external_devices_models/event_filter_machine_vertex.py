@@ -0,0 +1,209 @@
+# Copyright (c) 2026 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from typing import NamedTuple, Sequence
+from spinn_utilities.overrides import overrides
+from spinnman.model.enums import ExecutableType
+from pacman.model.graphs.common import MDSlice
+from pacman.model.graphs.machine import MachineVertex
+from pacman.model.placements import Placement
+from pacman.model.resources import ConstantSDRAM
+from spinn_front_end_common.abstract_models import (
+    AbstractHasAssociatedBinary, AbstractGeneratesDataSpecification)
+from spinn_front_end_common.interface.ds import DataSpecificationGenerator
+from spinn_front_end_common.interface.provenance import (
+    ProvidesProvenanceDataFromMachineImpl, ProvenanceWriter)
+from spinn_front_end_common.interface.simulation import simulation_utilities
+from spinn_front_end_common.utilities.constants import (
+    SYSTEM_BYTES_REQUIREMENT, SIMULATION_N_BYTES, BYTES_PER_WORD)
+from spynnaker.pyNN.data import SpynnakerDataView
+from spynnaker.pyNN.utilities.constants import SPIKE_PARTITION_ID
+
+
+class EventFilterParameters(NamedTuple):
+    """
+    How an event filter decodes, crops, pools and rate-limits events.
+    """
+    #: The shift to get the x coordinate from a received key
+    x_shift: int
+    #: The mask of the x coordinate after shifting
+    x_mask: int
+    #: The shift to get the y coordinate from a received key
+    y_shift: int
+    #: The mask of the y coordinate after shifting
+    y_mask: int
+    #: The first x coordinate of the region of interest
+    x_min: int
+    #: The first y coordinate of the region of interest
+    y_min: int
+    #: The width of the region of interest
+    roi_width: int
+    #: The height of the region of interest
+    roi_height: int
+    #: The log2 of the width of the pixels pooled into one output pixel
+    pool_x_shift: int
+    #: The log2 of the height of the pixels pooled into one output pixel
+    pool_y_shift: int
+    #: The time steps after an output pixel sends before it can send again
+    refractory_steps: int
+
+    @property
+    def out_width(self) -> int:
+        """
+        The width of the output in pooled pixels.
+
+        :rtype: int
+        """
+        return -(-self.roi_width >> self.pool_x_shift)
+
+    @property
+    def out_height(self) -> int:
+        """
+        The height of the output in pooled pixels.
+
+        :rtype: int
+        """
+        return -(-self.roi_height >> self.pool_y_shift)
+
+
+class EventFilterMachineVertex(
+        MachineVertex, AbstractGeneratesDataSpecification,
+        AbstractHasAssociatedBinary,
+        ProvidesProvenanceDataFromMachineImpl):
+    """
+    A core that crops, pools and rate-limits the events of a 2D sensor.
+    """
+    __slots__ = ("__params", "__n_colour_bits")
+
+    _SYSTEM_REGION = 0
+    _PARAMS_REGION = 1
+    _PROVENANCE_REGION = 2
+
+    _PROVENANCE_ELEMENTS = 4
+
+    _PARAMS_SIZE = 15 * BYTES_PER_WORD
+
+    #: The name of the provenance item counting events received
+    N_RECEIVED_NAME = "Events_received"
+
+    #: The name of the provenance item counting events outside the ROI
+    N_OUTSIDE_ROI_NAME = "Events_outside_region_of_interest"
+
+    #: The name of the provenance item counting refractory events
+    N_REFRACTORY_NAME = "Events_dropped_as_refractory"
+
+    #: The name of the provenance item counting events sent
+    N_SENT_NAME = "Events_sent"
+
+    def __init__(
+            self, params: EventFilterParameters, n_colour_bits: int,
+            label=None, app_vertex=None):
+        """
+        :param EventFilterParameters params: How to filter the events
+        :param int n_colour_bits: The number of colour bits to send
+        :param str label:
+        :param ~pacman.model.graphs.application.ApplicationVertex app_vertex:
+        """
+        shape = (params.out_width, params.out_height)
+        n_atoms = params.out_width * params.out_height
+        super().__init__(
+            label=label, app_vertex=app_vertex,
+            vertex_slice=MDSlice(0, n_atoms - 1, shape, (0, 0), shape))
+        self.__params = params
+        self.__n_colour_bits = n_colour_bits
+
+    @property
+    @overrides(MachineVertex.sdram_required)
+    def sdram_required(self) -> ConstantSDRAM:
+        return ConstantSDRAM(
+                SYSTEM_BYTES_REQUIREMENT + self._PARAMS_SIZE +
+                self.get_provenance_data_size(self._PROVENANCE_ELEMENTS))
+
+    @overrides(AbstractHasAssociatedBinary.get_binary_file_name)
+    def get_binary_file_name(self) -> str:
+        return "event_filter.aplx"
+
+    @overrides(AbstractHasAssociatedBinary.get_binary_start_type)
+    def get_binary_start_type(self) -> ExecutableType:
+        return ExecutableType.USES_SIMULATION_INTERFACE
+
+    @property
+    @overrides(ProvidesProvenanceDataFromMachineImpl._provenance_region_id)
+    def _provenance_region_id(self) -> int:
+        return self._PROVENANCE_REGION
+
+    @property
+    @overrides(ProvidesProvenanceDataFromMachineImpl._n_additional_data_items)
+    def _n_additional_data_items(self) -> int:
+        return self._PROVENANCE_ELEMENTS
+
+    @overrides(
+        ProvidesProvenanceDataFromMachineImpl.parse_extra_provenance_items)
+    def parse_extra_provenance_items(
+            self, label: str, x: int, y: int, p: int,
+            provenance_data: Sequence[int]):
+        n_received, n_outside_roi, n_refractory, n_sent = provenance_data
+
+        with ProvenanceWriter() as db:
+            db.insert_core(x, y, p, self.N_RECEIVED_NAME, n_received)
+            db.insert_core(x, y, p, self.N_OUTSIDE_ROI_NAME, n_outside_roi)
+            db.insert_core(x, y, p, self.N_REFRACTORY_NAME, n_refractory)
+            db.insert_core(x, y, p, self.N_SENT_NAME, n_sent)
+
+    @overrides(AbstractGeneratesDataSpecification.generate_data_specification)
+    def generate_data_specification(
+            self, spec: DataSpecificationGenerator, placement: Placement):
+        spec.comment("\n*** Spec for event filter ***\n\n")
+
+        # Reserve memory
+        spec.reserve_memory_region(
+            self._SYSTEM_REGION, SIMULATION_N_BYTES, label='setup')
+        spec.reserve_memory_region(
+            self._PARAMS_REGION, self._PARAMS_SIZE, label='params')
+        self.reserve_provenance_data_region(spec)
+
+        # handle simulation data
+        spec.switch_write_focus(self._SYSTEM_REGION)
+        spec.write_array(simulation_utilities.get_simulation_header_array(
+            self.get_binary_file_name()))
+
+        # Get the key
+        routing_info = SpynnakerDataView.get_routing_infos()
+        key = routing_info.get_key_from(placement.vertex, SPIKE_PARTITION_ID)
+
+        # write params to memory
+        params = self.__params
+        spec.switch_write_focus(region=self._PARAMS_REGION)
+        spec.write_value(params.x_shift)
+        spec.write_value(params.x_mask)
+        spec.write_value(params.y_shift)
+        spec.write_value(params.y_mask)
+        spec.write_value(params.x_min)
+        spec.write_value(params.y_min)
+        spec.write_value(params.roi_width)
+        spec.write_value(params.roi_height)
+        spec.write_value(params.pool_x_shift)
+        spec.write_value(params.pool_y_shift)
+        spec.write_value(params.out_width)
+        spec.write_value(params.out_height)
+        spec.write_value(params.refractory_steps)
+        spec.write_value(key)
+        spec.write_value(self.__n_colour_bits)
+
+        # End-of-Spec:
+        spec.end_specification()
+
+    @overrides(MachineVertex.get_n_keys_for_partition)
+    def get_n_keys_for_partition(self, partition_id: str) -> int:
+        return self.vertex_slice.n_atoms << self.__n_colour_bits
@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import math
 from typing import Optional, List
 from spinn_utilities.overrides import overrides
 from spinn_front_end_common.utilities.exceptions import ConfigurationException
@@ -38,6 +39,7 @@ class ExternalDeviceLifControl(AbstractPyNNNeuronModelStandard):
     """
     __slots__ = (
         "_create_edges",
+        "_decoded",
         "_devices",
         "_translator")
 
@@ -51,7 +53,7 @@ class ExternalDeviceLifControl(AbstractPyNNNeuronModelStandard):
             # default params for the neuron model type
             tau_m=20.0, cm=1.0, v_rest=0.0, v_reset=0.0, tau_syn_E=5.0,
             tau_syn_I=5.0, tau_refrac=0.1, i_offset=0.0, v=0.0,
-            isyn_exc=0.0, isyn_inh=0.0):
+            isyn_exc=0.0, isyn_inh=0.0, decode_weights=None):
         """
         :param list(AbstractMulticastControllableDevice) devices:
             The AbstractMulticastControllableDevice instances to be controlled
@@ -76,22 +78,33 @@ class ExternalDeviceLifControl(AbstractPyNNNeuronModelStandard):
             (defaulted LIF neuron state variable initial value)
         :param float isyn_inh:
             (defaulted LIF neuron state variable initial value)
+        :param decode_weights:
+            If given, a device may be listed for several neurons, and the
+            sum of their voltages times these weights is computed on the
+            machine and sent to the device as one command, instead of each
+            neuron sending its own; the neurons must then fit on one core
+        :type decode_weights: list(float) or None
         """
         # pylint: disable=too-many-arguments
 
         if not devices:
             raise ConfigurationException("No devices specified")
+        if decode_weights is not None and len(decode_weights) != len(devices):
+            raise ConfigurationException(
+                "There must be a decode weight for each device entry")
 
         neuron_model = NeuronModelLeakyIntegrateAndFire(
             v, v_rest, tau_m, cm, i_offset, v_reset, tau_refrac)
         synapse_type = SynapseTypeExponential(
             tau_syn_E, tau_syn_I, isyn_exc, isyn_inh)
         input_type = InputTypeCurrent()
-        threshold_type = ThresholdTypeMulticastDeviceControl(devices)
+        threshold_type = ThresholdTypeMulticastDeviceControl(
+            devices, decode_weights)
 
         self._devices = devices
         self._translator = translator
         self._create_edges = create_edges
+        self._decoded = decode_weights is not None
 
         super().__init__(
             model_name="ExternalDeviceLifControl",
@@ -109,6 +122,8 @@ class ExternalDeviceLifControl(AbstractPyNNNeuronModelStandard):
             drop_late_spikes: Optional[bool] = None,
             splitter: Optional[SplitterAbstractPopulationVertex] = None,
             seed: Optional[int] = None, n_colour_bits: Optional[int] = None,
+            direct_pop_table: Optional[bool] = None,
+            timestep_multiple: int = 1,
             n_steps_per_timestep: int = 1) -> AbstractPopulationVertex:
         if n_neurons != len(self._devices):
             raise ConfigurationException(
@@ -118,6 +133,11 @@ class ExternalDeviceLifControl(AbstractPyNNNeuronModelStandard):
         assert isinstance(model, NeuronImplStandard)
         model.n_steps_per_timestep = n_steps_per_timestep
         max_atoms = self.get_model_max_atoms_per_dimension_per_core()
+        if self._decoded and n_neurons > math.prod(
+                max_atoms if isinstance(max_atoms, tuple) else (max_atoms, )):
+            raise ConfigurationException(
+                f"The decoded devices of {label} need all {n_neurons} "
+                "neurons on one core")
         return ExternalDeviceLifControlVertex(
             devices=self._devices, create_edges=self._create_edges,
             max_atoms_per_core=max_atoms, neuron_impl=model, pynn_model=self,
@@ -126,4 +146,5 @@ class ExternalDeviceLifControl(AbstractPyNNNeuronModelStandard):
             max_expected_summed_weight=max_expected_summed_weight,
             incoming_spike_buffer_size=incoming_spike_buffer_size,
             drop_late_spikes=drop_late_spikes, splitter=splitter, seed=seed,
-            n_colour_bits=n_colour_bits)
+            n_colour_bits=n_colour_bits, direct_pop_table=direct_pop_table,
+            timestep_multiple=timestep_multiple)
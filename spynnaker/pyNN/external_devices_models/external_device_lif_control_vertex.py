@@ -13,7 +13,8 @@
 # limitations under the License.
 
 from __future__ import annotations
-from typing import Iterable, List, Optional, Sequence, Tuple, TYPE_CHECKING
+from typing import (
+    Dict, Iterable, List, Optional, Sequence, Tuple, TYPE_CHECKING)
 from spinn_utilities.overrides import overrides
 from pacman.model.graphs.application import (
     ApplicationVertex, ApplicationVirtualVertex)
@@ -66,7 +67,9 @@ class ExternalDeviceLifControlVertex(
             incoming_spike_buffer_size: Optional[int] = None,
             drop_late_spikes: Optional[bool] = None,
             splitter: Optional[SplitterAbstractPopulationVertex] = None,
-            seed: Optional[int] = None, n_colour_bits: Optional[int] = None):
+            seed: Optional[int] = None, n_colour_bits: Optional[int] = None,
+            direct_pop_table: Optional[bool] = None,
+            timestep_multiple: int = 1):
         """
         :param list(AbstractMulticastControllableDevice) devices:
             The AbstractMulticastControllableDevice instances to be controlled
@@ -88,12 +91,19 @@ class ExternalDeviceLifControlVertex(
         :param splitter: splitter from application vertices to machine vertices
         :type splitter: SplitterAbstractPopulationVertex or None
         :param int n_colour_bits: The number of colour bits to use
+        :param direct_pop_table:
+            Whether to try to index the master population table directly
+        :type direct_pop_table: bool or None
+        :param int timestep_multiple:
+            The number of simulation time steps in each neuron time step
         """
         # pylint: disable=too-many-arguments
         if drop_late_spikes is None:
             drop_late_spikes = False
-        extra_partition_ids = [
-            dev.device_control_partition_id for dev in devices]
+        # A device may be listed for several neurons if they are decoded
+        # together, but only needs one partition
+        extra_partition_ids = list(dict.fromkeys(
+            dev.device_control_partition_id for dev in devices))
         super().__init__(
             n_neurons=len(devices),
             label=f"ext_dev{devices}" if label is None else label,
@@ -104,15 +114,18 @@ class ExternalDeviceLifControlVertex(
             incoming_spike_buffer_size=incoming_spike_buffer_size,
             neuron_impl=neuron_impl, pynn_model=pynn_model,
             drop_late_spikes=drop_late_spikes, splitter=splitter, seed=seed,
-            n_colour_bits=n_colour_bits, extra_partitions=extra_partition_ids)
+            n_colour_bits=n_colour_bits, extra_partitions=extra_partition_ids,
+            direct_pop_table=direct_pop_table,
+            timestep_multiple=timestep_multiple)
 
         if not devices:
             raise ConfigurationException("No devices specified")
 
         self.__devices = {dev.device_control_partition_id: dev
                           for dev in devices}
-        self.__indices = {dev.device_control_partition_id: i
-                          for i, dev in enumerate(devices)}
+        self.__indices: Dict[str, int] = dict()
+        for i, dev in enumerate(devices):
+            self.__indices.setdefault(dev.device_control_partition_id, i)
         self.__message_translator = translator
 
         # Add the edges to the devices if required
@@ -123,9 +136,9 @@ class ExternalDeviceLifControlVertex(
     def __dependents(
             devices: Sequence[AbstractMulticastControllableDevice]) -> Tuple[
                 ApplicationVirtualVertex, ...]:
-        return tuple(
+        return tuple(dict.fromkeys(
             dev for dev in devices
-            if isinstance(dev, ApplicationVirtualVertex))
+            if isinstance(dev, ApplicationVirtualVertex)))
 
     @overrides(AbstractVertexWithEdgeToDependentVertices.dependent_vertices)
     def dependent_vertices(self) -> Iterable[ApplicationVertex]:
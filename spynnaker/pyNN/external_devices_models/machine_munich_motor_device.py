@@ -41,6 +41,9 @@ class MachineMunichMotorDevice(
     external device vertex.
     """
     __slots__ = (
+        "__batch_commands",
+        "__batch_delta_threshold",
+        "__batch_interval",
         "__continue_if_not_different",
         "__delay_time",
         "__delta_threshold",
@@ -62,7 +65,7 @@ class MachineMunichMotorDevice(
 
     _PROVENANCE_ELEMENTS = 1
 
-    _PARAMS_SIZE = 7 * BYTES_PER_WORD
+    _PARAMS_SIZE = 10 * BYTES_PER_WORD
 
     #: The name of the provenance item saying that packets were lost.
     INPUT_BUFFER_FULL_NAME = "Times_the_input_buffer_lost_packets"
@@ -70,7 +73,8 @@ class MachineMunichMotorDevice(
     def __init__(
             self, speed, sample_time, update_time, delay_time,
             delta_threshold, continue_if_not_different,
-            label=None, app_vertex=None):
+            label=None, app_vertex=None, batch_commands=False,
+            batch_interval=0, batch_delta_threshold=0):
         """
         :param int speed:
         :param int sample_time:
@@ -80,6 +84,13 @@ class MachineMunichMotorDevice(
         :param bool continue_if_not_different:
         :param str label:
         :param ~pacman.model.graphs.application.ApplicationVertex app_vertex:
+        :param bool batch_commands:
+            Whether to send the speeds of all the axes together in one
+            command, with a signed byte per axis in the payload
+        :param int batch_interval: The least time steps between batches
+        :param int batch_delta_threshold:
+            The total change in speed over the axes needed to send a batch
+            before the next update
         """
         super().__init__(
             label=label, app_vertex=app_vertex,
@@ -90,6 +101,9 @@ class MachineMunichMotorDevice(
         self.__delay_time = delay_time
         self.__delta_threshold = delta_threshold
         self.__continue_if_not_different = bool(continue_if_not_different)
+        self.__batch_commands = bool(batch_commands)
+        self.__batch_interval = batch_interval
+        self.__batch_delta_threshold = batch_delta_threshold
 
     @property
     @overrides(MachineVertex.sdram_required)
@@ -165,6 +179,9 @@ class MachineMunichMotorDevice(
         spec.write_value(data=self.__delay_time)
         spec.write_value(data=self.__delta_threshold)
         spec.write_value(data=int(self.__continue_if_not_different))
+        spec.write_value(data=int(self.__batch_commands))
+        spec.write_value(data=self.__batch_interval)
+        spec.write_value(data=self.__batch_delta_threshold)
 
         # End-of-Spec:
         spec.end_specification()
@@ -50,7 +50,8 @@ class MunichMotorDevice(
     def __init__(
             self, spinnaker_link_id, board_address=None, speed=30,
             sample_time=4096, update_time=512, delay_time=5,
-            delta_threshold=23, continue_if_not_different=True, label=None):
+            delta_threshold=23, continue_if_not_different=True, label=None,
+            batch_commands=False, batch_interval=0, batch_delta_threshold=0):
         """
         :param int spinnaker_link_id:
             The SpiNNaker link to which the motor is connected
@@ -64,11 +65,20 @@ class MunichMotorDevice(
         :param bool continue_if_not_different:
         :param str label:
         :type label: str or None
+        :param bool batch_commands:
+            Whether to send the speeds of all the axes together in one
+            command, with a signed byte per axis in the payload
+        :param int batch_interval: The least time steps between batches
+        :param int batch_delta_threshold:
+            The total change in speed over the axes needed to send a batch
+            before the next update
         """
         # pylint: disable=too-many-arguments
         m_vertex = MachineMunichMotorDevice(
             speed, sample_time, update_time, delay_time, delta_threshold,
-            continue_if_not_different, label, app_vertex=self)
+            continue_if_not_different, label, app_vertex=self,
+            batch_commands=batch_commands, batch_interval=batch_interval,
+            batch_delta_threshold=batch_delta_threshold)
         super().__init__(
             m_vertex, label, MachineMunichMotorDevice._N_ATOMS)
         self.__dependent_vertices = [
@@ -13,6 +13,7 @@
 # limitations under the License.
 
 from threading import RLock
+from typing import Tuple
 import numpy
 from spinnman.connections import ConnectionListener
 from spinn_front_end_common.utilities.constants import BYTES_PER_SHORT
@@ -30,6 +31,38 @@ _P_SHIFT = 7
 _P_MASK = 0x1
 
 
+def decode_retina_events(data: bytes) -> Tuple[numpy.ndarray, bytes]:
+    """
+    Split the bytes received from a PushBot retina into events.  Each event
+    is two bytes, the first of which has its most significant bit set.
+
+    A whole datagram of aligned events is viewed as an array without
+    copying; only a datagram that has lost its alignment is scanned byte by
+    byte to find the events again.
+
+    :param bytes data: The bytes received
+    :return: The events, and any trailing byte that starts an event that
+        continues in the next datagram
+    :rtype: tuple(~numpy.ndarray, bytes)
+    """
+    raw = numpy.frombuffer(data, dtype=numpy.uint8)
+    if len(raw) % _RETINA_PACKET_SIZE == 0 and numpy.all(raw[0::2] & 0x80):
+        return numpy.frombuffer(data, dtype=numpy.uint16), b''
+
+    events = bytearray()
+    i = 0
+    while i < len(data):
+        if not data[i] & 0x80:
+            i += 1
+        elif i + 1 < len(data):
+            events += data[i:i + _RETINA_PACKET_SIZE]
+            i += _RETINA_PACKET_SIZE
+        else:
+            return (numpy.frombuffer(bytes(events), dtype=numpy.uint16),
+                    bytes(data[i:]))
+    return numpy.frombuffer(bytes(events), dtype=numpy.uint16), b''
+
+
 class PushBotRetinaConnection(SpynnakerLiveSpikesConnection):
     """
     A connection that sends spikes from the PushBot retina to a spike injector
@@ -88,7 +121,7 @@ class PushBotRetinaConnection(SpynnakerLiveSpikesConnection):
         self.__pushbot_listener.start()
         self.__lock = RLock()
 
-        self.__next_data = None
+        self.__next_data = b''
         self.__ready = False
 
         self.add_start_resume_callback(
@@ -117,24 +150,10 @@ class PushBotRetinaConnection(SpynnakerLiveSpikesConnection):
             if not self.__ready:
                 return
 
-            if self.__next_data is not None:
-                data = data + self.__next_data
-                self.__next_data = None
-
-            # Go through the data and find pairs where the first of the pair
-            # has a 1 in the most significant bit
-            data_all = b''
-            # pylint: disable=consider-using-enumerate
-            for i in range(len(data)):
-                if data[i] > 128:
-                    if i + 1 < len(data):
-                        data_all += data[i:i+2]
-                        i += 1
-                    else:
-                        self.__next_data = data[i:i+1]
-
-            # Filter out the usable data
-            data_filtered = numpy.fromstring(data_all, dtype=numpy.uint16)
+            if self.__next_data:
+                data = self.__next_data + data
+
+            data_filtered, self.__next_data = decode_retina_events(data)
             y_values = (data_filtered >> self.__orig_y_shift) & self.__y_mask
             x_values = (data_filtered >> self.__orig_x_shift) & self.__x_mask
             polarity = (data_filtered >> _P_SHIFT) & _P_MASK
@@ -142,4 +161,4 @@ class PushBotRetinaConnection(SpynnakerLiveSpikesConnection):
                 (x_values << self.__x_shift) |
                 (y_values << self.__y_shift) |
                 (polarity << self.__p_shift))
-            self.send_spikes(self.__retina_injector_label, neuron_ids)
+            self.send_spike_array(self.__retina_injector_label, neuron_ids)
@@ -14,7 +14,7 @@
 
 import logging
 from time import sleep
-from typing import Optional
+from typing import Iterable, Optional
 
 from spinn_utilities.overrides import overrides
 from spinn_utilities.log import FormatAdapter
@@ -64,141 +64,158 @@ class PushBotTranslator(AbstractEthernetTranslator):
 
     @overrides(AbstractEthernetTranslator.translate_control_packet)
     def translate_control_packet(self, multicast_packet: MultiCastCommand):
+        self.translate_control_packets([multicast_packet])
+
+    @overrides(AbstractEthernetTranslator.translate_control_packets)
+    def translate_control_packets(
+            self, multicast_packets: Iterable[MultiCastCommand]):
+        """
+        Translate several multicast packets, sending the commands together
+        in as few Wi-Fi messages as possible.  Only disabling the retina
+        ends a message, as the PushBot needs time after it.
+
+        :param iterable(MultiCastCommand) multicast_packets:
+        """
+        pending = b''
+        for multicast_packet in multicast_packets:
+            command = self.encode_control_packet(multicast_packet)
+            if command is None:
+                continue
+            pending += command
+            if multicast_packet.key == self.__protocol.disable_retina_key:
+                self.__pushbot_wifi_connection.send(pending)
+                pending = b''
+                sleep(0.1)
+        if pending:
+            self.__pushbot_wifi_connection.send(pending)
+
+    def encode_control_packet(
+            self, multicast_packet: MultiCastCommand) -> Optional[bytes]:
+        """
+        Get the PushBot command for a multicast packet.
+
+        :param MultiCastCommand multicast_packet:
+        :return: The command to send, or `None` if there is nothing to send
+        :rtype: bytes or None
+        """
         # pylint: disable=too-many-statements, too-many-branches
+        # pylint: disable=too-many-return-statements
         key = multicast_packet.key
         # disable retina
         if key == self.__protocol.disable_retina_key:
             logger.debug("Sending retina disable")
-            self.__pushbot_wifi_connection.send(
-                MunichIoEthernetProtocol.disable_retina())
-            sleep(0.1)
+            return MunichIoEthernetProtocol.disable_retina()
 
         # set retina key (which doesn't do much for Ethernet)
-        elif key == self.__protocol.set_retina_transmission_key:
+        if key == self.__protocol.set_retina_transmission_key:
             logger.debug("Sending retina enable")
-            self.__pushbot_wifi_connection.send(
+            return (
                 MunichIoEthernetProtocol.set_retina_transmission(
                     munich_io_spinnaker_link_protocol.GET_RETINA_PAYLOAD_VALUE(
-                        multicast_packet.payload or 0)))
-            self.__pushbot_wifi_connection.send(
+                        multicast_packet.payload or 0)) +
                 MunichIoEthernetProtocol.enable_retina())
 
         # motor 0 leaky velocity command
-        elif key == self.__protocol.push_bot_motor_0_leaking_towards_zero_key:
+        if key == self.__protocol.push_bot_motor_0_leaking_towards_zero_key:
             speed = _signed_int(multicast_packet.payload)
             logger.debug("Sending Motor 0 Leaky Velocity = {}", speed)
-            self.__pushbot_wifi_connection.send(
-                MunichIoEthernetProtocol.motor_0_leaky_velocity(speed))
+            return MunichIoEthernetProtocol.motor_0_leaky_velocity(speed)
 
         # motor 0 permanent velocity command
-        elif key == self.__protocol.push_bot_motor_0_permanent_key:
+        if key == self.__protocol.push_bot_motor_0_permanent_key:
             speed = _signed_int(multicast_packet.payload)
             logger.debug("Sending Motor 0 Velocity = {}", speed)
-            self.__pushbot_wifi_connection.send(
-                MunichIoEthernetProtocol.motor_0_permanent_velocity(speed))
+            return MunichIoEthernetProtocol.motor_0_permanent_velocity(speed)
 
         # motor 1 leaky velocity command
-        elif key == self.__protocol.push_bot_motor_1_leaking_towards_zero_key:
+        if key == self.__protocol.push_bot_motor_1_leaking_towards_zero_key:
             speed = _signed_int(multicast_packet.payload)
             logger.debug("Sending Motor 1 Leaky Velocity = {}", speed)
-            self.__pushbot_wifi_connection.send(
-                MunichIoEthernetProtocol.motor_1_leaky_velocity(speed))
+            return MunichIoEthernetProtocol.motor_1_leaky_velocity(speed)
 
         # motor 1 permanent velocity command
-        elif key == self.__protocol.push_bot_motor_1_permanent_key:
+        if key == self.__protocol.push_bot_motor_1_permanent_key:
             speed = _signed_int(multicast_packet.payload)
             logger.debug("Sending Motor 1 Velocity = {}", speed)
-            self.__pushbot_wifi_connection.send(
-                MunichIoEthernetProtocol.motor_1_permanent_velocity(speed))
+            return MunichIoEthernetProtocol.motor_1_permanent_velocity(speed)
 
         # laser total period command
-        elif key == self.__protocol.push_bot_laser_config_total_period_key:
+        if key == self.__protocol.push_bot_laser_config_total_period_key:
             period = _signed_int(multicast_packet.payload)
             logger.debug("Sending Laser Period = {}", period)
-            self.__pushbot_wifi_connection.send(
-                MunichIoEthernetProtocol.laser_total_period(period))
+            return MunichIoEthernetProtocol.laser_total_period(period)
 
         # laser active time
-        elif key == self.__protocol.push_bot_laser_config_active_time_key:
+        if key == self.__protocol.push_bot_laser_config_active_time_key:
             time = _signed_int(multicast_packet.payload)
             logger.debug("Sending Laser Active Time = {}", time)
-            self.__pushbot_wifi_connection.send(
-                MunichIoEthernetProtocol.laser_active_time(time))
+            return MunichIoEthernetProtocol.laser_active_time(time)
 
         # laser frequency
-        elif key == self.__protocol.push_bot_laser_set_frequency_key:
+        if key == self.__protocol.push_bot_laser_set_frequency_key:
             frequency = _signed_int(multicast_packet.payload)
             logger.debug("Sending Laser Frequency = {}", frequency)
-            self.__pushbot_wifi_connection.send(
-                MunichIoEthernetProtocol.laser_frequency(frequency))
+            return MunichIoEthernetProtocol.laser_frequency(frequency)
 
         # led total period command
-        elif key == self.__protocol.push_bot_led_total_period_key:
+        if key == self.__protocol.push_bot_led_total_period_key:
             period = _signed_int(multicast_packet.payload)
             logger.debug("Sending LED Period = {}", period)
-            self.__pushbot_wifi_connection.send(
-                MunichIoEthernetProtocol.led_total_period(period))
+            return MunichIoEthernetProtocol.led_total_period(period)
 
         # front led active time
-        elif key == self.__protocol.push_bot_led_front_active_time_key:
+        if key == self.__protocol.push_bot_led_front_active_time_key:
             time = _signed_int(multicast_packet.payload)
             logger.debug("Sending Front LED Active Time = {}", time)
-            self.__pushbot_wifi_connection.send(
-                MunichIoEthernetProtocol.led_front_active_time(time))
+            return MunichIoEthernetProtocol.led_front_active_time(time)
 
         # back led active time
-        elif key == self.__protocol.push_bot_led_back_active_time_key:
+        if key == self.__protocol.push_bot_led_back_active_time_key:
             time = _signed_int(multicast_packet.payload)
             logger.debug("Sending Back LED Active Time = {}", time)
-            self.__pushbot_wifi_connection.send(
-                MunichIoEthernetProtocol.led_back_active_time(time))
+            return MunichIoEthernetProtocol.led_back_active_time(time)
 
         # led frequency
-        elif key == self.__protocol.push_bot_led_set_frequency_key:
+        if key == self.__protocol.push_bot_led_set_frequency_key:
             frequency = _signed_int(multicast_packet.payload)
             logger.debug("Sending LED Frequency = {}", frequency)
-            self.__pushbot_wifi_connection.send(
-                MunichIoEthernetProtocol.led_frequency(frequency))
+            return MunichIoEthernetProtocol.led_frequency(frequency)
 
         # speaker total period
-        elif key == self.__protocol.push_bot_speaker_config_total_period_key:
+        if key == self.__protocol.push_bot_speaker_config_total_period_key:
             period = _signed_int(multicast_packet.payload)
             logger.debug("Sending Speaker Period = {}", period)
-            self.__pushbot_wifi_connection.send(
-                MunichIoEthernetProtocol.speaker_total_period(period))
+            return MunichIoEthernetProtocol.speaker_total_period(period)
 
         # speaker active time
-        elif key == self.__protocol.push_bot_speaker_config_active_time_key:
+        if key == self.__protocol.push_bot_speaker_config_active_time_key:
             time = _signed_int(multicast_packet.payload)
             logger.debug("Sending Speaker Active Time = {}", time)
-            self.__pushbot_wifi_connection.send(
-                MunichIoEthernetProtocol.speaker_active_time(time))
+            return MunichIoEthernetProtocol.speaker_active_time(time)
 
         # speaker frequency
-        elif key == self.__protocol.push_bot_speaker_set_tone_key:
+        if key == self.__protocol.push_bot_speaker_set_tone_key:
             frequency = _signed_int(multicast_packet.payload)
             logger.debug("Sending Speaker Frequency = {}", frequency)
-            self.__pushbot_wifi_connection.send(
-                MunichIoEthernetProtocol.speaker_frequency(frequency))
+            return MunichIoEthernetProtocol.speaker_frequency(frequency)
 
         # motor enable
-        elif (key == self.__protocol.enable_disable_motor_key and
-              multicast_packet.payload == 1):
+        if (key == self.__protocol.enable_disable_motor_key and
+                multicast_packet.payload == 1):
             logger.debug("Sending Motor Enable")
-            self.__pushbot_wifi_connection.send(
-                MunichIoEthernetProtocol.enable_motor())
+            return MunichIoEthernetProtocol.enable_motor()
 
         # motor disable
-        elif (key == self.__protocol.enable_disable_motor_key and
-              multicast_packet.payload == 0):
+        if (key == self.__protocol.enable_disable_motor_key and
+                multicast_packet.payload == 0):
             logger.debug("Sending Motor Disable")
-            self.__pushbot_wifi_connection.send(
-                MunichIoEthernetProtocol.disable_motor())
+            return MunichIoEthernetProtocol.disable_motor()
 
         # detecting set mode (which has no context in Ethernet protocol
-        elif key == self.__protocol.set_mode().key:
+        if key == self.__protocol.set_mode().key:
             logger.debug("Ignoring set mode command")
+            return None
 
         # otherwise no idea what command is, so raise warning and ignore
-        else:
-            logger.warning("Unknown PushBot command: {}", multicast_packet)
+        logger.warning("Unknown PushBot command: {}", multicast_packet)
+        return None
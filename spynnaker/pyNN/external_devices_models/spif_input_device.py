@@ -12,7 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 import math
-from typing import Iterable, List, Tuple
+from typing import Iterable, List, Sequence, Tuple, Union
 from spinn_utilities.overrides import overrides
 from pacman.model.graphs.application import (
     ApplicationFPGAVertex, FPGAConnection)
@@ -38,6 +38,13 @@ class SPIFInputDevice(
         ApplicationFPGAVertex, PopulationApplicationVertex,
         AbstractSendMeMulticastCommandsVertex):
     """ A 1D input device connected to SpiNNaker using a SPIF board.
+
+    The device can be striped over more than one pipe, so that a sensor with
+    a high event rate can use the input bandwidth of each pipe.  The neurons
+    are then split into one contiguous stripe per pipe, each a whole number
+    of partitions, and the sensor sends the events of each stripe to its pipe
+    with the neuron IDs relative to the start of the stripe; see
+    :py:meth:`get_pipe_and_input_id`.
     """
 
     #: SPIF outputs to 8 FPGA output links, so we split all input into 8
@@ -50,7 +57,8 @@ class SPIFInputDevice(
         "__spif_mask",
         "__index_by_slice",
         "__base_key",
-        "__pipe",
+        "__pipes",
+        "__stripe_size",
         "__key_mask",
         "__m_vertex_mask",
         "__neuron_bits",
@@ -59,11 +67,15 @@ class SPIFInputDevice(
         "__input_mask",
         "__input_shift"]
 
-    def __init__(self, pipe, n_neurons, n_neurons_per_partition,
-                 base_key=None, board_address=None, chip_coords=None):
+    def __init__(self, pipe: Union[int, Sequence[int]], n_neurons,
+                 n_neurons_per_partition, base_key=None, board_address=None,
+                 chip_coords=None):
         """
 
-        :param int pipe: Which pipe on SPIF the retina is connected to
+        :param pipe:
+            Which pipe on SPIF the device is connected to, or a list of pipes
+            to stripe the neurons over
+        :type pipe: int or list(int)
         :param int n_neurons: The number of neurons in the device
         :param int height: The height of the retina in pixels
         :param int sub_width:
@@ -103,13 +115,32 @@ class SPIFInputDevice(
             raise ConfigurationException(
                 f"n_neurons_per_partition ({n_neurons_per_partition}) "
                 "must be a power of 2")
-        if pipe >= N_PIPES:
+        pipes = (pipe, ) if isinstance(pipe, int) else tuple(pipe)
+        if not pipes or len(set(pipes)) != len(pipes):
             raise ConfigurationException(
-                f"Pipe {pipe} is bigger than maximum allowed {N_PIPES}")
+                f"The pipes {pipes} must be at least one and all different")
+        for p in pipes:
+            if p >= N_PIPES:
+                raise ConfigurationException(
+                    f"Pipe {p} is bigger than maximum allowed {N_PIPES}")
 
         n_machine_vertices = int(
             math.ceil(n_neurons / n_neurons_per_partition))
 
+        # Each stripe is a whole number of partitions, so that no machine
+        # vertex gets events from more than one pipe
+        if n_machine_vertices < len(pipes):
+            raise ConfigurationException(
+                f"There are {n_machine_vertices} partitions, so the device "
+                f"can't be striped over {len(pipes)} pipes")
+        self.__pipes = pipes
+        self.__stripe_size = n_neurons_per_partition * int(
+            math.ceil(n_machine_vertices / len(pipes)))
+        if (len(pipes) - 1) * self.__stripe_size >= n_neurons:
+            raise ConfigurationException(
+                f"The {n_machine_vertices} partitions can't be split evenly "
+                f"enough to give each of {len(pipes)} pipes a stripe")
+
         # Call the super
         super().__init__(
             n_atoms=n_neurons,
@@ -141,7 +172,6 @@ class SPIFInputDevice(
         # A dictionary to get vertex index from FPGA and slice
         self.__index_by_slice = dict()
 
-        self.__pipe = pipe
         self.__base_key = base_key
         if self.__base_key is None:
             self.__base_key = SPIFInputDevice.__n_devices
@@ -150,9 +180,27 @@ class SPIFInputDevice(
 
         # Generate the shifts and masks to convert the SPIF Ethernet inputs to
         # output format
-        self.__input_mask = (1 << self.__neuron_bits) - 1
+        self.__input_mask = (1 << get_n_bits(self.__stripe_size)) - 1
         self.__input_shift = 0
 
+    @property
+    def pipes(self) -> Tuple[int, ...]:
+        """ The pipes the device is striped over, in stripe order
+
+        :rtype: tuple(int)
+        """
+        return self.__pipes
+
+    def get_pipe_and_input_id(self, neuron_id: int) -> Tuple[int, int]:
+        """ Get where the sensor should send the events of a neuron
+
+        :param int neuron_id: The neuron to send the events of
+        :return: The pipe to send to, and the ID to send
+        :rtype: tuple(int, int)
+        """
+        stripe, input_id = divmod(neuron_id, self.__stripe_size)
+        return self.__pipes[stripe], input_id
+
     def __is_power_of_2(self, v):
         """ Determine if a value is a power of 2
 
@@ -222,30 +270,50 @@ class SPIFInputDevice(
         commands.append(SPIFRegister.DROPPED_PKT_CNT.cmd(0))
         commands.append(SPIFRegister.IN_PERIPH_PKT_CNT.cmd(0))
 
+        for stripe, pipe in enumerate(self.__pipes):
+            commands.extend(self.__pipe_commands(stripe, pipe))
+
+        # Send the start signal
+        commands.append(SpiNNFPGARegister.START.cmd())
+
+        return commands
+
+    def __pipe_commands(
+            self, stripe: int, pipe: int) -> List[MultiCastCommand]:
+        """ Get the commands to configure one pipe to send one stripe
+
+        :param int stripe: The index of the stripe
+        :param int pipe: The pipe to configure
+        :rtype: list(MultiCastCommand)
+        """
+        start = stripe * self.__stripe_size
+        n_stripe_atoms = min(self.__stripe_size, self.n_atoms - start)
+        commands: List[MultiCastCommand] = list()
+
         # Configure the creation of packets from fields to keys using the
         # "standard" input to SPIF (X | P | Y) and convert to (Y | X)
         commands.extend([
-            set_field_mask(self.__pipe, 0, self.__input_mask),
-            set_field_shift(self.__pipe, 0, self.__input_shift),
-            set_field_limit(self.__pipe, 0, self.n_atoms)])
+            set_field_mask(pipe, 0, self.__input_mask),
+            set_field_shift(pipe, 0, self.__input_shift),
+            set_field_limit(pipe, 0, n_stripe_atoms - 1)])
 
         # These are unused but set them to be sure
         for i in range(1, N_FIELDS):
             commands.extend([
-                set_field_mask(self.__pipe, i, 0),
-                set_field_shift(self.__pipe, i, 0),
-                set_field_limit(self.__pipe, i, 0)])
+                set_field_mask(pipe, i, 0),
+                set_field_shift(pipe, i, 0),
+                set_field_limit(pipe, i, 0)])
 
         # Don't filter
         commands.extend([
-            set_filter_mask(self.__pipe, i, 0) for i in range(N_FILTERS)
+            set_filter_mask(pipe, i, 0) for i in range(N_FILTERS)
         ])
         commands.extend([
-            set_filter_value(self.__pipe, i, 1) for i in range(N_FILTERS)
+            set_filter_value(pipe, i, 1) for i in range(N_FILTERS)
         ])
 
         # Configure the output routing key
-        commands.append(set_mapper_key(self.__pipe, self.__base_key))
+        commands.append(set_mapper_key(pipe, self.__base_key + start))
 
         # Configure the links to send packets to the 8 FPGAs using the
         # lower bits; the input key is against the reversed links list because
@@ -253,18 +321,15 @@ class SPIFInputDevice(
         # we put out the fixed key and mask in the FPGA link order, so we need
         # to match that with what SPIF will output.
         commands.extend(
-            set_input_key(self.__pipe, i, self.__spif_key(f))
+            set_input_key(pipe, i, self.__spif_key(f))
             for i, f in enumerate(reversed(SPIF_INPUT_FPGA_LINKS)))
         commands.extend(
-            set_input_mask(self.__pipe, i, self.__spif_mask)
+            set_input_mask(pipe, i, self.__spif_mask)
             for i in range(len(SPIF_INPUT_FPGA_LINKS)))
         commands.extend(
-            set_input_route(self.__pipe, i, i)
+            set_input_route(pipe, i, i)
             for i in range(len(SPIF_INPUT_FPGA_LINKS)))
 
-        # Send the start signal
-        commands.append(SpiNNFPGARegister.START.cmd())
-
         return commands
 
     def __spif_key(self, fpga_link_id):
@@ -12,7 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
-from typing import Sequence
+from typing import Optional, Sequence
 
 from spinn_utilities.overrides import overrides
 from spinn_utilities.ranged.range_dictionary import RangeDictionary
@@ -32,18 +32,32 @@ _MAX = "max"
 _TS_INTER_SEND = "ts_inter_send"
 _TS_NEXT_SEND = "ts_next_send"
 _TYPE = "type"
+_DECODE_OFFSET = "decode_offset"
+_DECODE_WEIGHT = "decode_weight"
+
+#: The decode offset of a neuron that sends its own value
+NOT_DECODED = 0xFFFFFFFF
 
 
 class ThresholdTypeMulticastDeviceControl(AbstractThresholdType):
     """
     A threshold type that can send multicast keys with the value of
     membrane voltage as the payload.
+
+    If decode weights are given, the neurons of each device are decoded
+    together: the weighted sum of their voltages is sent as one command by
+    the first neuron of the device, with the parameters of that device.
     """
-    __slots__ = ("__devices", )
+    __slots__ = ("__devices", "__decode_weights")
 
-    def __init__(self, devices: Sequence[AbstractMulticastControllableDevice]):
+    def __init__(self, devices: Sequence[AbstractMulticastControllableDevice],
+                 decode_weights: Optional[Sequence[float]] = None):
         """
         :param list(AbstractMulticastControllableDevice) device:
+        :param decode_weights:
+            The weight of each neuron in the value sent to its device, or
+            `None` for each neuron to send its own value
+        :type decode_weights: list(float) or None
         """
         super().__init__(
             [Struct([
@@ -53,11 +67,23 @@ class ThresholdTypeMulticastDeviceControl(AbstractThresholdType):
                 (DataType.S1615, _MAX),
                 (DataType.UINT32, _TS_INTER_SEND),
                 (DataType.UINT32, _TS_NEXT_SEND),
-                (DataType.UINT32, _TYPE)])],
+                (DataType.UINT32, _TYPE),
+                (DataType.UINT32, _DECODE_OFFSET),
+                (DataType.S1615, _DECODE_WEIGHT)])],
             {_KEY: "", _SCALE: "", _MIN: "mV", _MAX: "mV",
              _TS_INTER_SEND: "time steps", _TS_NEXT_SEND: "time steps",
-             _TYPE: ""})
+             _TYPE: "", _DECODE_OFFSET: "", _DECODE_WEIGHT: ""})
         self.__devices = devices
+        self.__decode_weights = decode_weights
+
+    def __decode_offsets(self) -> Sequence[int]:
+        if self.__decode_weights is None:
+            return [NOT_DECODED] * len(self.__devices)
+        first = dict()
+        offsets = list()
+        for i, device in enumerate(self.__devices):
+            offsets.append(i - first.setdefault(id(device), i))
+        return offsets
 
     @overrides(AbstractThresholdType.add_parameters)
     def add_parameters(self, parameters: RangeDictionary[float]):
@@ -74,6 +100,10 @@ class ThresholdTypeMulticastDeviceControl(AbstractThresholdType):
             for d in self.__devices])
         parameters[_TYPE] = self._convert([
             d.device_control_send_type.value for d in self.__devices])
+        parameters[_DECODE_OFFSET] = self._convert(self.__decode_offsets())
+        parameters[_DECODE_WEIGHT] = self._convert(
+            [1.0] * len(self.__devices) if self.__decode_weights is None
+            else self.__decode_weights)
 
     @overrides(AbstractThresholdType.add_state_variables)
     def add_state_variables(self, state_variables: RangeDictionary[float]):
@@ -13,6 +13,7 @@
 # limitations under the License.
 from .connection_holder_finisher import finish_connection_holders
 from .redundant_packet_count_report import redundant_packet_count_report
+from .run_recommendations import run_recommendations_report
 from .spynnaker_connection_holder_generations import (
     SpYNNakerConnectionHolderGenerator)
 from .spynnaker_neuron_network_specification_report import (
@@ -25,7 +26,7 @@ from .neuron_expander import neuron_expander
 __all__ = [
     "delay_support_adder",
     "finish_connection_holders",
-    "redundant_packet_count_report",
+    "redundant_packet_count_report", "run_recommendations_report",
     "SpYNNakerConnectionHolderGenerator",
     "spynnaker_neuron_graph_network_specification_report",
     "SpYNNakerSynapticMatrixReport",
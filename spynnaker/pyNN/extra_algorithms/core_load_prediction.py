@@ -0,0 +1,269 @@
+# Copyright (c) 2026 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""
+A prediction of the clock cycles each core of a population will need in a
+time step, made from the connectors and expected rates of its projections
+before it is mapped, so that likely overruns are found before the machine
+is loaded, and so that the time scale factor at which the slowest core sets
+the pace of the run can be given.
+"""
+import logging
+import math
+from collections import defaultdict
+from typing import Callable, Dict, List, NamedTuple, Optional
+from spinn_utilities.config_holder import get_config_bool
+from spinn_utilities.log import FormatAdapter
+from spynnaker.pyNN.data import SpynnakerDataView
+from spynnaker.pyNN.models.neural_projections import (
+    ProjectionApplicationEdge, SynapseInformation)
+from spynnaker.pyNN.models.neuron import AbstractPopulationVertex
+from spynnaker.pyNN.models.neuron.implementations import NeuronImplStandard
+from spynnaker.pyNN.models.neuron.local_only import AbstractLocalOnly
+from spynnaker.pyNN.models.neuron.synapse_dynamics import (
+    AbstractPlasticSynapseDynamics)
+from spynnaker.pyNN.utilities.bit_field_utilities import (
+    get_spikes_per_second)
+from .run_recommendations import TARGET_USE
+from .splitter_components import (
+    SplitterAbstractPopulationVertexNeuronsSynapses)
+
+logger = FormatAdapter(logging.getLogger(__name__))
+
+#: The clock cycles of a core in each microsecond
+CLOCKS_PER_US = 200
+
+# These are rough costs of the inner loops of the binaries, which are
+# enough to find the cores that are well over their time; they are not
+# meant to say how close to its time a core will be.
+
+#: The clock cycles to update a neuron for each step of a time step
+NEURON_CLOCKS = 250
+
+#: The clock cycles to receive a spike and find and fetch its row
+SPIKE_CLOCKS = 350
+
+#: The clock cycles to add each static synapse of a row to its input
+STATIC_SYNAPSE_CLOCKS = 12
+
+#: The clock cycles to update and add each plastic synapse of a row
+PLASTIC_SYNAPSE_CLOCKS = 120
+
+#: The clock cycles to add the input of each target of a local-only spike
+LOCAL_ONLY_SYNAPSE_CLOCKS = 20
+
+
+class CoreLoad(NamedTuple):
+    """
+    The predicted clock cycles of each core of a population in a time step.
+    """
+    #: The clock cycles of updating the neurons of a core
+    neuron_clocks: float
+    #: The clock cycles of processing the spikes that arrive at a core
+    synapse_clocks: float
+    #: The synapse cores for each neuron core, or None if they are combined
+    n_synapse_cores: Optional[int]
+
+    @property
+    def max_clocks(self) -> float:
+        """
+        The clock cycles of the busiest core.
+
+        :rtype: float
+        """
+        if self.n_synapse_cores is None:
+            return self.neuron_clocks + self.synapse_clocks
+        return max(self.neuron_clocks,
+                   self.synapse_clocks / self.n_synapse_cores)
+
+
+def clocks_per_time_step() -> float:
+    """
+    The clock cycles each core can use in a time step.
+
+    :rtype: float
+    """
+    return (SpynnakerDataView.get_simulation_time_step_us() *
+            SpynnakerDataView.get_time_scale_factor() * CLOCKS_PER_US *
+            TARGET_USE)
+
+
+def time_scale_factor_for(max_clocks: float) -> int:
+    """
+    The smallest time scale factor at which a core that needs some clock
+    cycles in a time step would use no more than
+    :py:const:`~.run_recommendations.TARGET_USE` of it.
+
+    :param float max_clocks: The clock cycles of the busiest core
+    :rtype: int
+    """
+    step_clocks = (SpynnakerDataView.get_simulation_time_step_us() *
+                   CLOCKS_PER_US * TARGET_USE)
+    return max(1, math.ceil(max_clocks / step_clocks))
+
+
+def _row_length(synapse_info: SynapseInformation, n_atoms: int) -> int:
+    connector = synapse_info.connector
+    try:
+        return connector.get_n_connections_from_pre_vertex_maximum(
+            n_atoms, synapse_info)
+    except NotImplementedError:
+        return n_atoms
+
+
+def _synapse_clocks(synapse_info: SynapseInformation) -> int:
+    if isinstance(synapse_info.synapse_dynamics, AbstractLocalOnly):
+        return LOCAL_ONLY_SYNAPSE_CLOCKS
+    if isinstance(synapse_info.synapse_dynamics,
+                  AbstractPlasticSynapseDynamics):
+        return PLASTIC_SYNAPSE_CLOCKS
+    return STATIC_SYNAPSE_CLOCKS
+
+
+def predict_core_load(
+        app_vertex: AbstractPopulationVertex,
+        edges: List[ProjectionApplicationEdge], n_atoms: int) -> CoreLoad:
+    """
+    Predict the clock cycles each core of a population needs in a time step.
+
+    Each spike is assumed to hit the longest row of its projection, so the
+    prediction is of a busy time step rather than an average one.
+
+    :param AbstractPopulationVertex app_vertex: The population
+    :param list(ProjectionApplicationEdge) edges:
+        The edges of the projections into the population
+    :param int n_atoms: The neurons on each core
+    :rtype: CoreLoad
+    """
+    n_steps = 1
+    if isinstance(app_vertex.neuron_impl, NeuronImplStandard):
+        n_steps = app_vertex.neuron_impl.n_steps_per_timestep
+    neuron_clocks = n_atoms * n_steps * NEURON_CLOCKS
+
+    time_step_s = SpynnakerDataView.get_simulation_time_step_s()
+    local_only = isinstance(app_vertex.synapse_dynamics, AbstractLocalOnly)
+    synapse_clocks = 0.0
+    for edge in edges:
+        spikes = (edge.pre_vertex.n_atoms * time_step_s *
+                  get_spikes_per_second(edge.pre_vertex))
+        for synapse_info in edge.synapse_information:
+            row_clocks = (_row_length(synapse_info, n_atoms) *
+                          _synapse_clocks(synapse_info))
+            if not local_only:
+                row_clocks += SPIKE_CLOCKS
+            synapse_clocks += spikes * row_clocks
+
+    n_synapse_cores = None
+    if isinstance(app_vertex.splitter,
+                  SplitterAbstractPopulationVertexNeuronsSynapses):
+        n_synapse_cores = app_vertex.splitter.n_synapse_vertices
+    return CoreLoad(neuron_clocks, synapse_clocks, n_synapse_cores)
+
+
+def atoms_within_budget(
+        clocks_of: Callable[[int], float], max_atoms: int,
+        budget: float) -> int:
+    """
+    Find the most atoms on a core, up to a maximum, whose clock cycles are
+    within a budget, assuming that the cycles grow with the atoms.
+
+    :param callable(int, float) clocks_of: The clock cycles of some atoms
+    :param int max_atoms: The most atoms to consider
+    :param float budget: The clock cycles allowed
+    :return: The most atoms, or 0 if even 1 is over the budget
+    :rtype: int
+    """
+    low, high = 0, max_atoms
+    while low < high:
+        middle = (low + high + 1) // 2
+        if clocks_of(middle) <= budget:
+            low = middle
+        else:
+            high = middle - 1
+    return low
+
+
+def _check_population(
+        app_vertex: AbstractPopulationVertex,
+        edges: List[ProjectionApplicationEdge], budget: float,
+        resize: bool) -> float:
+    """
+    Warn if the cores of a population are predicted to overrun their time
+    step, and reduce its neurons per core if asked to and that helps.
+
+    :return: The clock cycles the slowest core of the population is
+        predicted to need, if it fits the time step, or else 0
+    :rtype: float
+    """
+    n_atoms = min(app_vertex.n_atoms, app_vertex.get_max_atoms_per_core())
+    load = predict_core_load(app_vertex, edges, n_atoms)
+    if load.max_clocks <= budget:
+        return load.max_clocks
+    fitting = atoms_within_budget(
+        lambda n: predict_core_load(app_vertex, edges, n).max_clocks,
+        n_atoms, budget)
+    if fitting == 0:
+        logger.warning(
+            "Population {} is predicted to need {:.0f} clock cycles of a "
+            "core in a busy time step, which has {:.0f}, and will "
+            "overrun whatever the neurons per core; consider a larger "
+            "time scale factor or more synapse cores",
+            app_vertex.label, load.max_clocks, budget)
+        return 0.0
+    logger.warning(
+        "Population {} is predicted to need {:.0f} clock cycles of a "
+        "core in a busy time step, which has {:.0f}; it might overrun "
+        "with {} neurons per core, but should not with {}",
+        app_vertex.label, load.max_clocks, budget, n_atoms, fitting)
+    if resize and len(app_vertex.atoms_shape) == 1:
+        app_vertex.set_max_atoms_per_dimension_per_core(fitting)
+        return predict_core_load(app_vertex, edges, fitting).max_clocks
+    return 0.0
+
+
+def predict_core_loads() -> None:
+    """
+    Warn about each population whose cores are predicted to overrun their
+    time step and, if configured, reduce the neurons on each core of those
+    that can be fixed that way.  Also say if the run could be faster, as the
+    slowest core is predicted to fit in a shorter time step than it has.
+    A population whose load can't be predicted is logged and skipped.
+    """
+    edges: Dict[AbstractPopulationVertex, List[ProjectionApplicationEdge]] = \
+        defaultdict(list)
+    for partition in SpynnakerDataView.iterate_partitions():
+        for edge in partition.edges:
+            if isinstance(edge, ProjectionApplicationEdge):
+                edges[edge.post_vertex].append(edge)
+
+    budget = clocks_per_time_step()
+    resize = get_config_bool("Mapping", "size_cores_by_predicted_load")
+    slowest = 0.0
+    for app_vertex in SpynnakerDataView.iterate_vertices():
+        if not isinstance(app_vertex, AbstractPopulationVertex):
+            continue
+        try:
+            slowest = max(slowest, _check_population(
+                app_vertex, edges[app_vertex], budget, resize))
+        except Exception as e:  # pylint: disable=broad-except
+            logger.exception(
+                "Error {} predicting the core load of {}:", e,
+                app_vertex.label)
+
+    time_scale_factor = SpynnakerDataView.get_time_scale_factor()
+    if slowest and time_scale_factor_for(slowest) < time_scale_factor:
+        logger.info(
+            "The slowest core is predicted to need {:.0f} clock cycles in a "
+            "busy time step, so this network could run with a time scale "
+            "factor of {} rather than {}",
+            slowest, time_scale_factor_for(slowest), time_scale_factor)
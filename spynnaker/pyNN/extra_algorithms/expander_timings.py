@@ -0,0 +1,263 @@
+# Copyright (c) 2026 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""
+The timing of the synapse and neuron expanders on each core, read into
+provenance and ranked in a report so that the slowest expansions can be
+found.
+"""
+import logging
+import os
+from collections import defaultdict
+from typing import Dict, Iterable, List, NamedTuple, TextIO, Tuple
+import numpy
+from spinn_utilities.log import FormatAdapter
+from spinnman.model.enums import UserRegister
+from pacman.model.placements import Placement
+from spinn_front_end_common.interface.provenance import ProvenanceWriter
+from spinn_front_end_common.utilities.constants import BYTES_PER_WORD
+from spynnaker.pyNN.data import SpynnakerDataView
+from spynnaker.pyNN.models.common.param_generator_data import (
+    PARAM_TYPE_BY_NAME, PARAM_TYPE_CONSTANT_ID)
+from spynnaker.pyNN.models.neural_projections.connectors.\
+    abstract_generate_connector_on_machine import ConnectorIDs
+from spynnaker.pyNN.models.neuron.synapse_dynamics.\
+    abstract_generate_on_machine import MatrixGeneratorID
+
+logger = FormatAdapter(logging.getLogger(__name__))
+
+#: The words before the records; these match expander_timing.h
+_HEADER_WORDS = 3
+
+#: The clock cycles in each tick of the timer
+TICK_CLOCKS = 16
+
+#: The most records kept by each core
+MAX_RECORDS = 256
+
+#: The words of each record of the synapse expander
+SYNAPSE_RECORD_WORDS = 6
+
+#: The words of each record of the neuron expander
+NEURON_RECORD_WORDS = 3
+
+#: The number of slowest cores and records to list in the report
+_N_SLOWEST = 20
+
+_FILE_NAME = "{}_expander_timings.rpt"
+
+#: The name of each type of parameter generator
+_PARAM_NAMES = {PARAM_TYPE_CONSTANT_ID: "constant"}
+for _param, _param_id in PARAM_TYPE_BY_NAME.items():
+    _PARAM_NAMES.setdefault(_param_id, _param)
+
+
+def _name(enum_type, value: int) -> str:
+    try:
+        return enum_type(value).name
+    except ValueError:
+        return f"unknown {value}"
+
+
+def _param_name(value: int) -> str:
+    return _PARAM_NAMES.get(value, f"unknown {value}")
+
+
+class CoreTiming(NamedTuple):
+    """
+    The timing of an expander on a core.
+    """
+    #: Where the expander ran
+    placement: Placement
+    #: The clock cycles of the whole expansion
+    clocks: int
+    #: The records, one row each, as written by the expander
+    records: numpy.ndarray
+    #: The number of records that didn't fit in the buffer
+    n_lost: int
+
+
+def allocate_timing_buffers(
+        placements: Iterable[Placement],
+        record_words: int) -> Dict[Placement, int]:
+    """
+    Give each expander core a buffer for its timings, using USER3.
+
+    .. note::
+        The buffers belong to the simulation rather than to the expander,
+        so that they are still there to be read once the expander has been
+        stopped.
+
+    :param iterable(~.Placement) placements: Where the expander will run
+    :param int record_words: The size of each record of the expander
+    :return: The address of the buffer of each core
+    :rtype: dict(~.Placement, int)
+    """
+    txrx = SpynnakerDataView.get_transceiver()
+    app_id = SpynnakerDataView.get_app_id()
+    n_bytes = (_HEADER_WORDS + MAX_RECORDS * record_words) * BYTES_PER_WORD
+    header = numpy.array([0, 0, MAX_RECORDS], dtype="uint32").tobytes()
+    buffers = dict()
+    for placement in placements:
+        x, y, p = placement.x, placement.y, placement.p
+        address = txrx.malloc_sdram(x, y, n_bytes, app_id)
+        txrx.write_memory(x, y, address, header)
+        txrx.write_user(x, y, p, UserRegister.USER_3, address)
+        buffers[placement] = address
+    return buffers
+
+
+def read_timings(buffers: Dict[Placement, int],
+                 record_words: int) -> List[CoreTiming]:
+    """
+    Read the timings that the expander cores wrote.
+
+    :param dict(~.Placement, int) buffers: The buffer of each core
+    :param int record_words: The size of each record of the expander
+    :rtype: list(CoreTiming)
+    """
+    timings = list()
+    for placement, address in buffers.items():
+        header = numpy.frombuffer(SpynnakerDataView.read_memory(
+            placement.x, placement.y, address,
+            _HEADER_WORDS * BYTES_PER_WORD), dtype="uint32")
+        total_ticks, n_records, max_records = (int(v) for v in header)
+        n_kept = min(n_records, max_records)
+        records = numpy.zeros((0, record_words), dtype="uint32")
+        if n_kept:
+            records = numpy.frombuffer(SpynnakerDataView.read_memory(
+                placement.x, placement.y,
+                address + _HEADER_WORDS * BYTES_PER_WORD,
+                n_kept * record_words * BYTES_PER_WORD),
+                dtype="uint32").reshape(n_kept, record_words)
+        timings.append(CoreTiming(
+            placement, total_ticks * TICK_CLOCKS, records,
+            n_records - n_kept))
+    return timings
+
+
+def _synapse_rows(timing: CoreTiming) -> List[Tuple[str, int, str]]:
+    """
+    The connectors of a core as (connector, clocks, details)
+    """
+    rows = list()
+    for (matrix, connector, weight, delay, n_rows,
+         ticks) in timing.records.tolist():
+        rows.append((
+            _name(ConnectorIDs, connector), ticks * TICK_CLOCKS,
+            f"{n_rows} rows, {_name(MatrixGeneratorID, matrix)}, "
+            f"weights {_param_name(weight)}, delays {_param_name(delay)}"))
+    return rows
+
+
+def _neuron_rows(timing: CoreTiming) -> List[Tuple[str, int, str]]:
+    """
+    The parameter generators of a core as (generator, clocks, details)
+    """
+    return [(_param_name(generator), ticks * TICK_CLOCKS, f"{n_values} values")
+            for generator, n_values, ticks in timing.records.tolist()]
+
+
+def _rows(timing: CoreTiming, is_synapse: bool):
+    return _synapse_rows(timing) if is_synapse else _neuron_rows(timing)
+
+
+def insert_timing_provenance(
+        timings: List[CoreTiming], is_synapse: bool) -> None:
+    """
+    Put the clock cycles of each core and of each type of generator on the
+    core into provenance.
+
+    :param list(CoreTiming) timings: The timings read
+    :param bool is_synapse: Whether the timings are of the synapse expander
+    """
+    prefix = "Synapse" if is_synapse else "Neuron"
+    with ProvenanceWriter() as db:
+        for timing in timings:
+            placement = timing.placement
+            x, y, p = placement.x, placement.y, placement.p
+            db.insert_core(x, y, p, f"{prefix} expander clocks", timing.clocks)
+            by_type: Dict[str, int] = defaultdict(int)
+            for name, clocks, _ in _rows(timing, is_synapse):
+                by_type[name] += clocks
+            for name, clocks in by_type.items():
+                db.insert_core(
+                    x, y, p, f"{prefix} expander clocks of {name}", clocks)
+            if timing.n_lost:
+                db.insert_core(
+                    x, y, p, f"{prefix} expander timings not kept",
+                    timing.n_lost)
+
+
+def write_timing_report(
+        timings: List[CoreTiming], is_synapse: bool) -> None:
+    """
+    Write a report of the slowest cores and the slowest connectors or
+    parameter generators, and the time taken by each type of generator.
+
+    :param list(CoreTiming) timings: The timings read
+    :param bool is_synapse: Whether the timings are of the synapse expander
+    """
+    file_name = os.path.join(
+        SpynnakerDataView.get_run_dir_path(),
+        _FILE_NAME.format("synapse" if is_synapse else "neuron"))
+    try:
+        with open(file_name, "w", encoding="utf-8") as f:
+            _write_report(f, timings, is_synapse)
+    except Exception as e:  # pylint: disable=broad-except
+        logger.exception(
+            "Error {} doing expander timing report {}:", e, file_name)
+
+
+def _core_name(placement: Placement) -> str:
+    return (f"{placement.x}, {placement.y}, {placement.p}: "
+            f"{placement.vertex.label}")
+
+
+def _write_report(output: TextIO, timings: List[CoreTiming],
+                  is_synapse: bool):
+    kind = "Synapse" if is_synapse else "Neuron"
+    item = "connectors" if is_synapse else "parameter generators"
+    output.write(f"{kind} expander\n\n")
+    if not timings:
+        output.write("    Nothing was expanded\n\n")
+        return
+    total = sum(timing.clocks for timing in timings)
+    output.write(f"    {len(timings)} cores took {total} clock cycles, "
+                 f"at most {max(t.clocks for t in timings)} on one core\n\n")
+
+    output.write("Slowest cores:\n")
+    for timing in sorted(timings, key=lambda t: -t.clocks)[:_N_SLOWEST]:
+        output.write(f"    {timing.clocks:>12} {_core_name(timing.placement)}"
+                     "\n")
+
+    by_type: Dict[str, int] = defaultdict(int)
+    records = list()
+    for timing in timings:
+        for name, clocks, details in _rows(timing, is_synapse):
+            by_type[name] += clocks
+            records.append((clocks, name, details, timing.placement))
+    output.write(f"\nSlowest {item}:\n")
+    for clocks, name, details, placement in sorted(
+            records, key=lambda r: -r[0])[:_N_SLOWEST]:
+        output.write(f"    {clocks:>12} {name} ({details}) on "
+                     f"{_core_name(placement)}\n")
+
+    output.write(f"\nClock cycles of each type of {item[:-1]}:\n")
+    for name, clocks in sorted(by_type.items(), key=lambda t: -t[1]):
+        output.write(f"    {clocks:>12} {name}\n")
+    n_lost = sum(timing.n_lost for timing in timings)
+    if n_lost:
+        output.write(f"\n{n_lost} {item} were not timed, as there were "
+                     f"more than {MAX_RECORDS} on a core\n")
+    output.write("\n")
@@ -25,6 +25,9 @@ from spinn_front_end_common.utilities.system_control_logic import (
 from spynnaker.pyNN.data import SpynnakerDataView
 from spynnaker.pyNN.models.abstract_models import (
     AbstractNeuronExpandable, NEURON_EXPANDER_APLX)
+from .expander_timings import (
+    allocate_timing_buffers, insert_timing_provenance, read_timings,
+    write_timing_report, NEURON_RECORD_WORDS)
 
 logger = FormatAdapter(logging.getLogger(__name__))
 
@@ -42,12 +45,21 @@ def neuron_expander() -> None:
     with ProgressBar(expander_cores.total_processors,
                      "Expanding Neuron Data") as progress:
         expander_app_id = SpynnakerDataView.get_new_id()
+        timing_buffers = None
+        if get_config_bool("Reports", "write_expander_timings"):
+            timing_buffers = allocate_timing_buffers(
+                (placement for _, placement in expanded_pop_vertices),
+                NEURON_RECORD_WORDS)
         run_system_application(
             expander_cores, expander_app_id,
             get_config_bool("Reports", "write_expander_iobuf") or False,
             None, frozenset({CPUState.FINISHED}), False,
             "neuron_expander_on_{}_{}_{}.txt", progress_bar=progress,
             logger=logger)
+        if timing_buffers is not None:
+            timings = read_timings(timing_buffers, NEURON_RECORD_WORDS)
+            insert_timing_provenance(timings, False)
+            write_timing_report(timings, False)
 
     _fill_in_initial_data(expanded_pop_vertices)
 
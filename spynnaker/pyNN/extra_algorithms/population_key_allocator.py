@@ -0,0 +1,311 @@
+# Copyright (c) 2026 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""
+An allocation of the keys of populations that puts the sources of spikes
+with the same targets next to each other in key space, each aligned to its
+size, so that the router entries towards those targets can be merged into a
+few maskable ranges; and a report of the router entries and master
+population table entries the cores of each population can expect.
+"""
+import logging
+import math
+import os
+from collections import defaultdict
+from typing import (
+    Dict, FrozenSet, Hashable, List, NamedTuple, Sequence, Set, TextIO,
+    Tuple)
+from spinn_utilities.log import FormatAdapter
+from pacman.model.graphs.application import ApplicationVertex
+from pacman.model.routing_info import BaseKeyAndMask
+from pacman.utilities.utility_calls import allocator_bits_needed
+from spynnaker.pyNN.data import SpynnakerDataView
+from spynnaker.pyNN.models.neuron import AbstractPopulationVertex
+from spynnaker.pyNN.models.neuron.local_only import AbstractLocalOnly
+from spynnaker.pyNN.utilities.constants import SPIKE_PARTITION_ID
+
+logger = FormatAdapter(logging.getLogger(__name__))
+
+_FILE_NAME = "population_keys.rpt"
+
+#: The first key given to a population; the keys of the vertices that are
+#: not planned are allocated as usual, from the bottom of the key space,
+#: except for fixed keys, which the planned keys are kept clear of
+KEY_BASE = 0x80000000
+
+#: The multicast router entries of a chip available to applications
+ROUTER_ENTRIES = 1023
+
+_KEY_SPACE = 1 << 32
+
+
+class KeySource(NamedTuple):
+    """
+    A source of spikes to allocate keys to.
+    """
+    #: What the keys are for
+    source: Hashable
+    #: The number of bits of key the source needs
+    n_bits: int
+    #: What the spikes are sent to
+    targets: FrozenSet[Hashable]
+
+
+class KeyPlan(NamedTuple):
+    """
+    The keys of some sources.
+    """
+    #: The key and mask of each source
+    keys: Dict[Hashable, BaseKeyAndMask]
+    #: The maskable ranges of the keys of the sources of each set of targets
+    n_ranges: Dict[FrozenSet[Hashable], int]
+
+
+def n_maskable_ranges(start: int, end: int) -> int:
+    """
+    The fewest key and mask pairs that match exactly the keys in a range.
+
+    :param int start: The first key
+    :param int end: One past the last key
+    :rtype: int
+    """
+    n_ranges = 0
+    while start < end:
+        size = start & -start if start else _KEY_SPACE
+        while start + size > end:
+            size >>= 1
+        start += size
+        n_ranges += 1
+    return n_ranges
+
+
+def _clear_of(
+        start: int, size: int, reserved: Sequence[Tuple[int, int]]) -> int:
+    """
+    The first key from an aligned start, aligned to a size, at which a range
+    of that size overlaps none of the reserved ranges.
+
+    :param int start: The first key to try, aligned to the size
+    :param int size: The size of the range, a power of 2
+    :param list(tuple(int,int)) reserved:
+        The first key and one past the last key of each reserved range
+    :rtype: int
+    """
+    moved = True
+    while moved:
+        moved = False
+        for first, end in reserved:
+            if start < end and first < start + size:
+                start = (end + size - 1) & -size
+                moved = True
+    return start
+
+
+def plan_keys(
+        sources: Sequence[KeySource], base: int = KEY_BASE,
+        reserved: Sequence[BaseKeyAndMask] = ()) -> KeyPlan:
+    """
+    Give the sources keys from a base, the sources with the same targets
+    together and each aligned to its size, so that the keys of each set of
+    targets are in one range that is covered by as few key and mask pairs as
+    possible.
+
+    The sets of targets, and the sources of each, go from the most keys to
+    the fewest, so that each is aligned with no gaps before it, other than
+    to keep clear of the reserved keys.
+
+    :param list(KeySource) sources: The sources to give keys to
+    :param int base: The first key, aligned to the keys of all the sources
+    :param list(~pacman.model.routing_info.BaseKeyAndMask) reserved:
+        Keys that are already in use, such as the fixed keys of devices
+    :rtype: KeyPlan
+    :raises ValueError: If the keys of the sources don't fit above the base
+    """
+    # A mask with gaps in it reserves the whole span of its keys
+    spans = [
+        (k.key & k.mask, (k.key | (~k.mask & (_KEY_SPACE - 1))) + 1)
+        for k in reserved]
+    groups: Dict[FrozenSet[Hashable], List[KeySource]] = defaultdict(list)
+    for source in sources:
+        groups[source.targets].append(source)
+    group_bits = {
+        targets: allocator_bits_needed(sum(1 << s.n_bits for s in members))
+        for targets, members in groups.items()}
+
+    keys: Dict[Hashable, BaseKeyAndMask] = dict()
+    n_ranges: Dict[FrozenSet[Hashable], int] = dict()
+    key = base
+    for targets in sorted(groups, key=lambda t: -group_bits[t]):
+        group_size = 1 << group_bits[targets]
+        key = _clear_of((key + group_size - 1) & -group_size, group_size,
+                        spans)
+        start = key
+        for source in sorted(groups[targets], key=lambda s: -s.n_bits):
+            mask = _KEY_SPACE - (1 << source.n_bits)
+            keys[source.source] = BaseKeyAndMask(key, mask)
+            key += 1 << source.n_bits
+        n_ranges[targets] = n_maskable_ranges(start, key)
+    if key > _KEY_SPACE:
+        raise ValueError(
+            f"The keys of the sources don't fit between {base:#x} and the "
+            f"end of the key space, clear of the {len(spans)} fixed keys")
+    return KeyPlan(keys, n_ranges)
+
+
+def _population_key_bits(vertex: AbstractPopulationVertex) -> int:
+    n_cores = math.ceil(vertex.n_atoms / vertex.get_max_atoms_per_core())
+    n_keys = min(vertex.n_atoms, vertex.get_max_atoms_per_core())
+    return (allocator_bits_needed(n_keys << vertex.n_colour_bits) +
+            allocator_bits_needed(n_cores))
+
+
+def _can_plan(vertex: ApplicationVertex, partition_id: str) -> bool:
+    # Multidimensional populations have keys for each dimension, and some
+    # populations already have keys of their own
+    return (isinstance(vertex, AbstractPopulationVertex) and
+            partition_id == SPIKE_PARTITION_ID and
+            len(vertex.atoms_shape) == 1 and
+            type(vertex).get_fixed_key_and_mask is
+            AbstractPopulationVertex.get_fixed_key_and_mask)
+
+
+def allocate_population_keys(apply: bool) -> None:
+    """
+    Plan the keys of the populations that send spikes, report the router
+    and master population table entries the cores of each population can
+    expect, and warn of those expected to need more router entries than a
+    chip has.  This needs the delay vertices to have been added.
+
+    :param bool apply: Whether to give the populations the planned keys
+    """
+    # Keys planned before are not kept, whether or not they are planned again
+    for vertex in SpynnakerDataView.iterate_vertices():
+        if isinstance(vertex, AbstractPopulationVertex):
+            vertex.set_fixed_key_and_mask(None)
+
+    sources: Dict[Tuple[ApplicationVertex, str], FrozenSet[Hashable]] = \
+        dict()
+    reserved: List[BaseKeyAndMask] = list()
+    for partition in SpynnakerDataView.iterate_partitions():
+        vertex, partition_id = partition.pre_vertex, partition.identifier
+        sources[vertex, partition_id] = frozenset(
+            edge.post_vertex for edge in partition.edges)
+        # The planned keys must not overlap keys fixed by anything else,
+        # such as a retina that sends with a key of its own
+        if not _can_plan(vertex, partition_id):
+            key_and_mask = vertex.get_fixed_key_and_mask(partition_id)
+            if key_and_mask is not None:
+                reserved.append(key_and_mask)
+    planned = [
+        KeySource(vertex, _population_key_bits(vertex), targets)
+        for (vertex, partition_id), targets in sources.items()
+        if _can_plan(vertex, partition_id)]
+    try:
+        plan = plan_keys(planned, reserved=reserved)
+    except ValueError as e:
+        logger.warning("The keys of the populations could not be planned: {}",
+                       e)
+        return
+
+    if apply:
+        for vertex in SpynnakerDataView.iterate_vertices():
+            if isinstance(vertex, AbstractPopulationVertex):
+                vertex.set_fixed_key_and_mask(plan.keys.get(vertex))
+
+    targets = sorted(
+        {t for ts in sources.values() for t in ts},
+        key=lambda t: str(t.label))
+    expected = _expected_entries(sources, plan)
+    for target in targets:
+        planned_entries, n_sources = expected[target]
+        n_entries = planned_entries if apply else n_sources
+        if n_entries > ROUTER_ENTRIES:
+            logger.warning(
+                "The routes to {} can expect to need {} router entries, more "
+                "than the {} of a chip, unless they can be compressed",
+                target.label, n_entries, ROUTER_ENTRIES)
+
+    file_name = os.path.join(SpynnakerDataView.get_run_dir_path(), _FILE_NAME)
+    try:
+        with open(file_name, "w", encoding="utf-8") as f:
+            _write_report(f, plan, targets, expected, apply)
+    except Exception as e:  # pylint: disable=broad-except
+        logger.exception(
+            "Error {} doing population keys report {}:", e, file_name)
+
+
+def _expected_entries(
+        sources: Dict[Tuple[ApplicationVertex, str], FrozenSet[Hashable]],
+        plan: KeyPlan) -> Dict[Hashable, Tuple[int, int]]:
+    """
+    The router entries the chips of each target need to receive its spikes
+    with the planned keys, and the number of sources of the target, which is
+    the router entries with a key range for each source and the entries of
+    its master population table.  A chip on a route needs at least one
+    router entry for each maskable range of keys that goes through it.
+
+    The entries are counted for each target, not each chip, as the keys are
+    planned before the routes are known.  A chip that the routes to several
+    targets go through needs the entries of all of them.
+    """
+    counted: Set[Tuple[FrozenSet[Hashable], Hashable]] = set()
+    planned: Dict[Hashable, int] = defaultdict(int)
+    n_sources: Dict[Hashable, int] = defaultdict(int)
+    for (vertex, _), targets in sources.items():
+        for target in targets:
+            n_sources[target] += 1
+            if vertex not in plan.keys:
+                planned[target] += 1
+            elif (targets, target) not in counted:
+                counted.add((targets, target))
+                planned[target] += plan.n_ranges[targets]
+    return {target: (planned[target], n_sources[target])
+            for target in n_sources}
+
+
+def _write_report(
+        output: TextIO, plan: KeyPlan, targets: List[ApplicationVertex],
+        expected: Dict[Hashable, Tuple[int, int]], apply: bool):
+    output.write(
+        f"{len(plan.keys)} populations can have their keys planned, in "
+        f"{sum(plan.n_ranges.values())} maskable ranges for "
+        f"{len(plan.n_ranges)} sets of targets")
+    if not apply:
+        output.write(
+            "; set Mapping.plan_population_keys to give them these keys")
+    output.write("\n\n")
+    for vertex, key_and_mask in plan.keys.items():
+        output.write(
+            f"    {key_and_mask.key:#010x}/{key_and_mask.mask:#010x}: "
+            f"{vertex.label}\n")
+
+    output.write(
+        "\nThe router entries the chips of each population can expect to "
+        "need, at least, to receive their spikes with the planned keys and "
+        "with a key range for each source, and the entries of the master "
+        "population table of each of its cores.  The router entries are "
+        "counted for each population, not each chip, as the keys are "
+        "planned before the routes are known; a chip that the routes to "
+        "several populations go through needs the entries of all of them:\n")
+    for target in targets:
+        planned, n_sources = expected[target]
+        output.write(
+            f"    {target.label}: {planned} or {n_sources} router entries; ")
+        if (isinstance(target, AbstractPopulationVertex) and
+                isinstance(target.synapse_dynamics, AbstractLocalOnly)):
+            output.write("local-only, with no population table\n")
+        else:
+            depth = allocator_bits_needed(n_sources + 1)
+            output.write(
+                f"{n_sources} population table entries, searched in up to "
+                f"{depth} steps\n")
@@ -0,0 +1,120 @@
+# Copyright (c) 2026 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""
+A report of the chips whose recording fills their SDRAM first, and so
+decide how often a run has to be paused for the recordings to be extracted.
+"""
+import logging
+import math
+import os
+from collections import defaultdict
+from typing import Dict, List, NamedTuple, TextIO, Tuple
+from spinn_utilities.log import FormatAdapter
+from pacman.model.placements import Placement
+from spinn_front_end_common.interface.buffer_management.buffer_models import (
+    AbstractReceiveBuffersToHost)
+from spynnaker.pyNN.data import SpynnakerDataView
+
+logger = FormatAdapter(logging.getLogger(__name__))
+
+_FILE_NAME = "recording_pauses.rpt"
+
+#: The number of chips to list in the report
+_N_CHIPS = 10
+
+
+class ChipRecording(NamedTuple):
+    """
+    The recording of the cores of a chip.
+    """
+    #: The x coordinate of the chip
+    x: int
+    #: The y coordinate of the chip
+    y: int
+    #: The time steps that can be recorded before the SDRAM of the chip fills
+    n_steps: int
+    #: The recording cores and the bytes each records each time step
+    cores: List[Tuple[Placement, int]]
+
+
+def chip_recordings() -> List[ChipRecording]:
+    """
+    Work out how many time steps of recording fit in the SDRAM of each chip
+    that records, fewest first.
+
+    :rtype: list(ChipRecording)
+    """
+    fixed: Dict[Tuple[int, int], int] = defaultdict(int)
+    per_timestep: Dict[Tuple[int, int], int] = defaultdict(int)
+    cores: Dict[Tuple[int, int], List[Tuple[Placement, int]]] = \
+        defaultdict(list)
+    for placement in SpynnakerDataView.iterate_placemements():
+        sdram = placement.vertex.sdram_required
+        xy = (placement.x, placement.y)
+        fixed[xy] += sdram.fixed
+        per_timestep[xy] += sdram.per_timestep
+        if (isinstance(placement.vertex, AbstractReceiveBuffersToHost)
+                and sdram.per_timestep):
+            cores[xy].append((placement, sdram.per_timestep))
+
+    chips = list()
+    for (x, y), recorders in cores.items():
+        free = SpynnakerDataView.get_chip_at(x, y).sdram - fixed[x, y]
+        chips.append(ChipRecording(
+            x, y, max(0, free) // per_timestep[x, y],
+            sorted(recorders, key=lambda r: -r[1])))
+    return sorted(chips, key=lambda c: c.n_steps)
+
+
+def recording_pauses_report() -> None:
+    """
+    Writes a report of how often the run was paused for recordings to be
+    extracted, and of the chips and cores whose recording caused it.
+    """
+    file_name = os.path.join(SpynnakerDataView.get_run_dir_path(), _FILE_NAME)
+    try:
+        with open(file_name, "w", encoding="utf-8") as f:
+            _write_report(f, chip_recordings())
+    except Exception as e:  # pylint: disable=broad-except
+        logger.exception(
+            "Error {} doing recording pauses report {}:", e, file_name)
+
+
+def _write_report(output: TextIO, chips: List[ChipRecording]):
+    if not chips:
+        output.write("Nothing was recorded\n")
+        return
+    max_steps = SpynnakerDataView.get_max_run_time_steps()
+    end_step = SpynnakerDataView.get_current_run_timesteps()
+    if end_step is None:
+        output.write(
+            f"The run was paused every {max_steps} time steps to extract "
+            "recordings\n\n")
+    else:
+        n_steps = end_step - SpynnakerDataView.get_first_machine_time_step()
+        n_pauses = max(0, math.ceil(n_steps / max_steps) - 1)
+        output.write(
+            f"The run of {n_steps} time steps was paused {n_pauses} times "
+            f"to extract recordings, as at most {max_steps} time steps can "
+            "be recorded between extractions\n\n")
+    output.write("Chips whose recording fills their SDRAM first:\n")
+    for chip in chips[:_N_CHIPS]:
+        output.write(f"    {chip.x}, {chip.y}: {chip.n_steps} time steps\n")
+        for placement, n_bytes in chip.cores:
+            output.write(
+                f"        {n_bytes:>10} bytes per time step on core "
+                f"{placement.p}: {placement.vertex.label}\n")
+    output.write(
+        "\nRecording fewer variables or neurons, or sampling less often, on "
+        "the cores of these chips would make the pauses less frequent\n")
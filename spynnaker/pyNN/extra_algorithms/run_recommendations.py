@@ -0,0 +1,513 @@
+# Copyright (c) 2026 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""
+Recommendations of the time scale factor, neurons per core, synapse cores,
+colour bits and incoming spike buffer size of each population, made from the
+provenance of a run, and applied to the next run if asked.
+"""
+import json
+import logging
+import math
+import os
+from collections import defaultdict
+from typing import (
+    Dict, Iterable, List, NamedTuple, Optional, TextIO, Tuple)
+from spinn_utilities.config_holder import (
+    get_config_bool, get_config_str_or_none)
+from spinn_utilities.log import FormatAdapter
+from pacman.model.graphs.application import ApplicationVertex
+from spinn_front_end_common.interface.provenance import ProvenanceReader
+from spynnaker.pyNN.data import SpynnakerDataView
+from spynnaker.pyNN.models.neural_projections import ProjectionApplicationEdge
+from spynnaker.pyNN.models.neuron import (
+    AbstractPopulationVertex, PopulationMachineLocalOnlyCombinedVertex,
+    PopulationMachineVertex, PopulationNeuronsMachineVertex,
+    PopulationSynapsesMachineVertexCommon)
+from spynnaker.pyNN.models.neuron.master_pop_table import MAX_COLOUR_BITS
+from spynnaker.pyNN.models.neuron.population_neurons_machine_vertex import (
+    N_TIME_STEP_USE_BINS)
+from spynnaker.pyNN.models.utility_models.delays import (
+    DelayExtensionMachineVertex)
+from .splitter_components import (
+    SplitterAbstractPopulationVertexNeuronsSynapses)
+
+logger = FormatAdapter(logging.getLogger(__name__))
+
+_REPORT_FILE_NAME = "run_recommendations.rpt"
+_FILE_NAME = "run_recommendations.json"
+
+#: The name of the timer overrun count of a core written by the common
+#: provenance of all cores
+_TIMER_OVERRUNS_NAME = "Times_the_timer_tic_over_ran"
+
+#: The fraction of the time step that cores are sized to use
+TARGET_USE = 0.8
+
+#: How much to scale the time when a core was overloaded by an unknown amount
+_OVERLOAD_SCALE = 2.0
+
+#: How many times the most spikes an incoming spike buffer held that it is
+#: sized to hold
+_SPIKE_BUFFER_HEADROOM = 2
+
+#: The fewest spikes an incoming spike buffer is sized to hold
+_MIN_SPIKE_BUFFER_SIZE = 16
+
+#: The cores that receive spikes into an incoming spike buffer
+_SPIKE_BUFFER_VERTICES = (
+    PopulationMachineVertex, PopulationMachineLocalOnlyCombinedVertex,
+    PopulationSynapsesMachineVertexCommon)
+
+
+class PopulationRecommendation(NamedTuple):
+    """
+    What to change of a population on the next run.
+    """
+    #: The neurons per core to use, or None to leave it
+    max_atoms_per_core: Optional[int]
+    #: The synapse cores per neuron core to use, or None to leave it
+    n_synapse_cores: Optional[int]
+    #: Why the changes are recommended
+    reasons: Tuple[str, ...]
+    #: The colour bits of the spikes of the population, or None to leave them
+    n_colour_bits: Optional[int] = None
+    #: The incoming spike buffer size to use, or None to leave it
+    incoming_spike_buffer_size: Optional[int] = None
+
+
+class RunRecommendations(NamedTuple):
+    """
+    What to change on the next run.
+    """
+    #: The time scale factor to use
+    time_scale_factor: int
+    #: The changes of each population by label
+    populations: Dict[str, PopulationRecommendation]
+
+
+class _PopulationLoad(object):
+    """
+    The provenance of the cores of one population that shows its load.
+    """
+
+    __slots__ = (
+        # The most atoms on any core
+        "max_atoms",
+        # The synapse cores per neuron core, or None if combined
+        "n_synapse_cores",
+        # Whether any neuron or combined core overran the time step
+        "neurons_overloaded",
+        # Whether any core that receives spikes lost or dropped them
+        "synapses_overloaded",
+        # Whether any core that receives spikes had them arrive late
+        "spikes_late",
+        # The most of the time step any neuron core used, if known
+        "max_use",
+        # The most spikes any incoming spike buffer held
+        "max_spike_buffer_fill",
+        # Whether any incoming spike buffer was full when a spike arrived
+        "spike_buffer_overflowed")
+
+    def __init__(self, n_synapse_cores: Optional[int]):
+        self.max_atoms = 0
+        self.n_synapse_cores = n_synapse_cores
+        self.neurons_overloaded = False
+        self.synapses_overloaded = False
+        self.spikes_late = False
+        self.max_use: Optional[float] = None
+        self.max_spike_buffer_fill = 0
+        self.spike_buffer_overflowed = False
+
+    @property
+    def scale(self) -> float:
+        """
+        How much longer the time step of the population could be when it
+        didn't overload, from the most of the time step any core used.
+        """
+        if self.max_use is None:
+            return 1.0
+        return self.max_use / TARGET_USE
+
+
+def _core_stats(db: ProvenanceReader) -> Dict[
+        Tuple[int, int, int], Dict[str, int]]:
+    stats: Dict[Tuple[int, int, int], Dict[str, int]] = defaultdict(dict)
+    for x, y, p, description, total in db.run_query(
+            "SELECT x, y, p, description, total FROM core_stats_view"):
+        stats[x, y, p][description] = int(total or 0)
+    return stats
+
+
+def _max_time_step_use(stats: Dict[str, int]) -> Optional[float]:
+    """
+    The upper bound of the highest bin of the time step use histogram of a
+    neuron core that has any time steps in it.
+    """
+    name = PopulationNeuronsMachineVertex.TIME_STEP_USE_NAME
+    for i in reversed(range(N_TIME_STEP_USE_BINS - 1)):
+        if stats.get(name.format(i * 10, (i + 1) * 10), 0) > 0:
+            return (i + 1) / 10
+    return None
+
+
+def _synapses_overloaded(stats: Dict[str, int]) -> bool:
+    return any(stats.get(name, 0) > 0 for name in (
+        PopulationSynapsesMachineVertexCommon.INPUT_BUFFER_FULL_NAME,
+        PopulationSynapsesMachineVertexCommon.N_LATE_SPIKES_NAME,
+        PopulationSynapsesMachineVertexCommon.N_TRANSFER_TIMER_OVERRUNS,
+        PopulationSynapsesMachineVertexCommon.N_SKIPPED_TIME_STEPS))
+
+
+def _population_loads(
+        stats: Dict[Tuple[int, int, int], Dict[str, int]]) -> Tuple[
+            Dict[AbstractPopulationVertex, _PopulationLoad], bool]:
+    """
+    Gather the load of each population from the provenance of its cores.
+
+    :return: The load of each population, and whether any delay core lost
+        packets
+    """
+    loads: Dict[AbstractPopulationVertex, _PopulationLoad] = dict()
+    delays_overloaded = False
+    for placement in SpynnakerDataView.iterate_placemements():
+        vertex = placement.vertex
+        core_stats = stats.get((placement.x, placement.y, placement.p), {})
+        if isinstance(vertex, DelayExtensionMachineVertex):
+            delays_overloaded |= core_stats.get(
+                DelayExtensionMachineVertex.INPUT_BUFFER_LOST_NAME, 0) > 0
+            continue
+        app_vertex = vertex.app_vertex
+        if not isinstance(app_vertex, AbstractPopulationVertex):
+            continue
+        if app_vertex not in loads:
+            splitter = app_vertex.splitter
+            n_synapse_cores = None
+            if isinstance(
+                    splitter, SplitterAbstractPopulationVertexNeuronsSynapses):
+                n_synapse_cores = splitter.n_synapse_vertices
+            loads[app_vertex] = _PopulationLoad(n_synapse_cores)
+        load = loads[app_vertex]
+
+        if isinstance(vertex, _SPIKE_BUFFER_VERTICES):
+            load.max_spike_buffer_fill = max(
+                load.max_spike_buffer_fill, core_stats.get(
+                    vertex.MAX_FILLED_SIZE_OF_INPUT_BUFFER_NAME, 0))
+            load.spike_buffer_overflowed |= core_stats.get(
+                vertex.INPUT_BUFFER_FULL_NAME, 0) > 0
+        if isinstance(vertex, PopulationSynapsesMachineVertexCommon):
+            load.synapses_overloaded |= _synapses_overloaded(core_stats)
+            load.spikes_late |= core_stats.get(
+                PopulationSynapsesMachineVertexCommon.N_LATE_SPIKES_NAME,
+                0) > 0
+            continue
+        load.max_atoms = max(load.max_atoms, vertex.vertex_slice.n_atoms)
+        if isinstance(vertex, PopulationNeuronsMachineVertex):
+            load.neurons_overloaded |= core_stats.get(
+                PopulationNeuronsMachineVertex.TIMER_TICK_OVERRUNS_NAME,
+                0) > 0
+            use = _max_time_step_use(core_stats)
+            if use is not None:
+                load.max_use = max(load.max_use or 0.0, use)
+        else:
+            load.neurons_overloaded |= core_stats.get(
+                _TIMER_OVERRUNS_NAME, 0) > 0
+            if isinstance(vertex, PopulationMachineVertex):
+                load.synapses_overloaded |= any(
+                    core_stats.get(name, 0) > 0 for name in (
+                        PopulationMachineVertex.INPUT_BUFFER_FULL_NAME,
+                        PopulationMachineVertex.N_LATE_SPIKES_NAME))
+                load.spikes_late |= core_stats.get(
+                    PopulationMachineVertex.N_LATE_SPIKES_NAME, 0) > 0
+    return loads, delays_overloaded
+
+
+def _recommend_colour_bits(
+        loads: Dict[AbstractPopulationVertex, _PopulationLoad],
+        populations: Dict[str, PopulationRecommendation]):
+    """
+    Add a colour bit to each population whose spikes arrived late at a
+    population, so that the cores that receive them can tell the time step
+    of spikes that arrive later still.
+    """
+    late_targets: Dict[AbstractPopulationVertex, List[str]] = \
+        defaultdict(list)
+    for partition in SpynnakerDataView.iterate_partitions():
+        for edge in partition.edges:
+            if (isinstance(edge, ProjectionApplicationEdge) and
+                    isinstance(edge.pre_vertex, AbstractPopulationVertex) and
+                    edge.post_vertex in loads and
+                    loads[edge.post_vertex].spikes_late):
+                late_targets[edge.pre_vertex].append(edge.post_vertex.label)
+    for app_vertex, targets in late_targets.items():
+        if app_vertex.n_colour_bits >= MAX_COLOUR_BITS:
+            continue
+        reason = (
+            f"its spikes arrived late at {', '.join(sorted(set(targets)))}, "
+            "so add a colour bit")
+        pop = populations.get(
+            app_vertex.label, PopulationRecommendation(None, None, ()))
+        populations[app_vertex.label] = pop._replace(
+            n_colour_bits=app_vertex.n_colour_bits + 1,
+            reasons=pop.reasons + (reason, ))
+
+
+def spike_buffer_size_for(
+        current_size: int, max_fill: int, overflowed: bool) -> int:
+    """
+    The size of an incoming spike buffer for the next run; a power of two,
+    as the buffer is rounded up to one anyway.
+
+    :param int current_size: The size of the buffer on the last run
+    :param int max_fill: The most spikes the buffer held on the last run
+    :param bool overflowed: Whether the buffer was full when a spike arrived
+    :rtype: int
+    """
+    if overflowed:
+        return 2 ** math.ceil(math.log2(max(current_size, 1) * 2))
+    wanted = max(_MIN_SPIKE_BUFFER_SIZE, max_fill * _SPIKE_BUFFER_HEADROOM)
+    return 2 ** math.ceil(math.log2(wanted))
+
+
+def _recommend_spike_buffer_sizes(
+        loads: Dict[AbstractPopulationVertex, _PopulationLoad],
+        populations: Dict[str, PopulationRecommendation]):
+    """
+    Size the incoming spike buffer of each population from the most spikes
+    that any of its buffers held, growing those that lost spikes and
+    shrinking those that were mostly empty, so that the DTCM they don't need
+    is left for the rest of the core.
+    """
+    for app_vertex, load in loads.items():
+        current_size = app_vertex.incoming_spike_buffer_size
+        size = spike_buffer_size_for(
+            current_size, load.max_spike_buffer_fill,
+            load.spike_buffer_overflowed)
+        if size == current_size:
+            continue
+        if load.spike_buffer_overflowed:
+            reason = (
+                "the incoming spike buffers lost spikes, so double their "
+                "size")
+        else:
+            reason = (
+                f"the incoming spike buffers held at most "
+                f"{load.max_spike_buffer_fill} spikes, so size them to "
+                f"{size}")
+        pop = populations.get(
+            app_vertex.label, PopulationRecommendation(None, None, ()))
+        populations[app_vertex.label] = pop._replace(
+            incoming_spike_buffer_size=size,
+            reasons=pop.reasons + (reason, ))
+
+
+def _recommend_population(
+        app_vertex: AbstractPopulationVertex,
+        load: _PopulationLoad) -> Tuple[PopulationRecommendation, float]:
+    """
+    Recommend changes to one population.
+
+    :return: The changes, and how much longer the time step needs to be
+        once they are made
+    """
+    max_atoms: Optional[int] = None
+    n_synapse_cores: Optional[int] = None
+    reasons: List[str] = list()
+    if not load.neurons_overloaded and not load.synapses_overloaded:
+        return PopulationRecommendation(None, None, ()), load.scale
+
+    # Multidimensional populations need the user to pick the shape
+    neurons_fixed = not load.neurons_overloaded
+    if (load.neurons_overloaded and len(app_vertex.atoms_shape) == 1 and
+            load.max_atoms > 1):
+        max_atoms = max(1, load.max_atoms // 2)
+        reasons.append(
+            "the neuron cores overran the time step, so halve the neurons "
+            "per core")
+        neurons_fixed = True
+    if load.synapses_overloaded:
+        if load.n_synapse_cores is None:
+            n_synapse_cores = 1
+            reasons.append(
+                "the cores lost or dropped spikes, so split the synapse "
+                "processing on to its own core")
+        else:
+            n_synapse_cores = load.n_synapse_cores + 1
+            reasons.append(
+                "the synapse cores lost or dropped spikes, so add a synapse "
+                "core")
+    if not neurons_fixed:
+        reasons.append(
+            "the neuron cores overran the time step, so run more slowly")
+    scale = 1.0 if neurons_fixed else _OVERLOAD_SCALE
+    return PopulationRecommendation(
+        max_atoms, n_synapse_cores, tuple(reasons)), scale
+
+
+def recommend_run_configuration() -> RunRecommendations:
+    """
+    Recommend the time scale factor, neurons per core and synapse cores of
+    each population from the provenance of the last run.
+
+    Populations whose cores overran or lost spikes are split over more
+    cores where possible; the time scale factor is otherwise raised for
+    overloaded cores, and lowered to where the busiest neuron core would use
+    :py:const:`TARGET_USE` of the time step.  Lowering it can overload
+    cores whose load isn't measured, which the next run will then show.
+    If configured, populations whose spikes arrived late are given another
+    colour bit, and the incoming spike buffers are sized from the most spikes
+    they held.
+
+    :rtype: RunRecommendations
+    """
+    with ProvenanceReader() as db:
+        stats = _core_stats(db)
+    loads, delays_overloaded = _population_loads(stats)
+
+    populations: Dict[str, PopulationRecommendation] = dict()
+    scale = _OVERLOAD_SCALE if delays_overloaded else 0.0
+    for app_vertex, load in loads.items():
+        recommendation, pop_scale = _recommend_population(app_vertex, load)
+        scale = max(scale, pop_scale)
+        if recommendation.reasons:
+            populations[app_vertex.label] = recommendation
+    if get_config_bool("Mapping", "widen_colour_bits_of_late_sources"):
+        _recommend_colour_bits(loads, populations)
+    if get_config_bool("Mapping", "size_spike_buffers_from_provenance"):
+        _recommend_spike_buffer_sizes(loads, populations)
+
+    time_scale_factor = SpynnakerDataView.get_time_scale_factor()
+    return RunRecommendations(
+        max(1, math.ceil(time_scale_factor * scale)), populations)
+
+
+def run_recommendations_report() -> None:
+    """
+    Writes the recommendations for the next run, both as a report and as a
+    file that the next run can apply by setting `run_recommendations` in the
+    `Mapping` section of the configuration to its path.
+    """
+    run_dir = SpynnakerDataView.get_run_dir_path()
+    try:
+        recommendations = recommend_run_configuration()
+        with open(os.path.join(run_dir, _REPORT_FILE_NAME), "w",
+                  encoding="utf-8") as f:
+            _write_report(f, recommendations)
+        write_run_recommendations(
+            os.path.join(run_dir, _FILE_NAME), recommendations)
+    except Exception as e:  # pylint: disable=broad-except
+        logger.exception(
+            "Error {} doing run_recommendations_report {}:", e, run_dir)
+
+
+def _write_report(output: TextIO, recommendations: RunRecommendations):
+    output.write(
+        f"Time scale factor: {SpynnakerDataView.get_time_scale_factor()} "
+        f"now, {recommendations.time_scale_factor} recommended\n")
+    for label, pop in recommendations.populations.items():
+        output.write(f"\nPopulation {label}\n")
+        if pop.max_atoms_per_core is not None:
+            output.write(
+                f"    Neurons per core: {pop.max_atoms_per_core}\n")
+        if pop.n_synapse_cores is not None:
+            output.write(
+                f"    Synapse cores per neuron core: {pop.n_synapse_cores}\n")
+        if pop.n_colour_bits is not None:
+            output.write(f"    Colour bits: {pop.n_colour_bits}\n")
+        if pop.incoming_spike_buffer_size is not None:
+            output.write(
+                "    Incoming spike buffer size: "
+                f"{pop.incoming_spike_buffer_size}\n")
+        for reason in pop.reasons:
+            output.write(f"    Because {reason}\n")
+
+
+def write_run_recommendations(
+        file_name: str, recommendations: RunRecommendations):
+    """
+    Write recommendations so that a later run can read them.
+
+    :param str file_name: The file to write
+    :param RunRecommendations recommendations: What to write
+    """
+    with open(file_name, "w", encoding="utf-8") as f:
+        json.dump({
+            "time_scale_factor": recommendations.time_scale_factor,
+            "populations": {
+                label: {
+                    "max_atoms_per_core": pop.max_atoms_per_core,
+                    "n_synapse_cores": pop.n_synapse_cores,
+                    "reasons": list(pop.reasons),
+                    "n_colour_bits": pop.n_colour_bits,
+                    "incoming_spike_buffer_size":
+                        pop.incoming_spike_buffer_size}
+                for label, pop in recommendations.populations.items()}},
+            f, indent=2)
+
+
+def read_run_recommendations() -> Optional[RunRecommendations]:
+    """
+    Read the recommendations named by `run_recommendations` in the `Mapping`
+    section of the configuration.
+
+    :return: The recommendations, or None if there are none to apply
+    :rtype: RunRecommendations or None
+    """
+    file_name = get_config_str_or_none("Mapping", "run_recommendations")
+    if file_name is None:
+        return None
+    if not os.path.isfile(file_name):
+        logger.warning(
+            "The run recommendations {} do not exist, so are not applied",
+            file_name)
+        return None
+    with open(file_name, encoding="utf-8") as f:
+        data = json.load(f)
+    return RunRecommendations(
+        int(data["time_scale_factor"]), {
+            label: PopulationRecommendation(
+                pop["max_atoms_per_core"], pop["n_synapse_cores"],
+                tuple(pop["reasons"]), pop.get("n_colour_bits"),
+                pop.get("incoming_spike_buffer_size"))
+            for label, pop in data["populations"].items()})
+
+
+def apply_population_recommendations(
+        recommendations: RunRecommendations,
+        app_vertices: Iterable[ApplicationVertex]):
+    """
+    Apply the neurons per core, synapse cores, colour bits and incoming spike
+    buffer sizes recommended for the populations, by label.  A population
+    that already has a splitter keeps it.
+
+    :param RunRecommendations recommendations: What to apply
+    :param iterable(ApplicationVertex) app_vertices: The vertices to apply to
+    """
+    for app_vertex in app_vertices:
+        if not isinstance(app_vertex, AbstractPopulationVertex):
+            continue
+        pop = recommendations.populations.get(app_vertex.label)
+        if pop is None:
+            continue
+        if pop.max_atoms_per_core is not None:
+            app_vertex.set_max_atoms_per_dimension_per_core(
+                pop.max_atoms_per_core)
+        if pop.n_synapse_cores is not None and not app_vertex.has_splitter:
+            app_vertex.splitter = \
+                SplitterAbstractPopulationVertexNeuronsSynapses(
+                    pop.n_synapse_cores)
+        if pop.n_colour_bits is not None:
+            app_vertex.set_n_colour_bits(pop.n_colour_bits)
+        if pop.incoming_spike_buffer_size is not None:
+            app_vertex.set_incoming_spike_buffer_size(
+                pop.incoming_spike_buffer_size)
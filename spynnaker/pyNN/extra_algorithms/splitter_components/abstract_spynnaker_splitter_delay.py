@@ -36,6 +36,17 @@ class AbstractSpynnakerSplitterDelay(object, metaclass=AbstractBase):
         """
         raise NotImplementedError
 
+    def max_ring_buffer_delay(self) -> int:
+        """
+        returns the max amount of delay the ring buffers of this post vertex
+        hold, which is less than :py:meth:`max_support_delay` if longer
+        delays are held elsewhere.
+
+        :return: max delay held in the ring buffers in ticks
+        :rtype: int
+        """
+        return self.max_support_delay()
+
     def accepts_edges_from_delay_vertex(self) -> bool:
         """
         Confirms that the splitter's vertices can handle spikes coming from a
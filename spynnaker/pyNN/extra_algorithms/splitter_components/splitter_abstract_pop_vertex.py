@@ -75,6 +75,26 @@ class SplitterAbstractPopulationVertex(
         assert self._max_delay is not None
         return self._max_delay
 
+    @property
+    def n_synapse_vertices(self) -> int:
+        """
+        The number of vertices that process the synapses of each neuron
+        vertex; the neuron vertices themselves unless overridden.
+
+        :rtype: int
+        """
+        return 1
+
+    @property
+    def wide_ring_buffers(self) -> bool:
+        """
+        Whether the cores that hold the ring buffers of the governed vertex
+        accumulate them in 32 bits rather than 16; false unless overridden.
+
+        :rtype: bool
+        """
+        return False
+
     @final
     def _get_fixed_slices(self) -> List[Slice]:
         """
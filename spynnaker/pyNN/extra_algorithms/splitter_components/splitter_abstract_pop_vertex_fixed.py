@@ -17,6 +17,7 @@ from typing import Dict, Iterable, List, Optional, Sequence, Tuple, cast
 from numpy import floating
 from numpy.typing import NDArray
 
+from spinn_utilities.config_holder import get_config_bool
 from spinn_utilities.overrides import overrides
 from spinn_utilities.ordered_set import OrderedSet
 
@@ -43,10 +44,12 @@ from spynnaker.pyNN.models.neuron.synapse_dynamics import (
     AbstractSynapseDynamicsStructural)
 from spynnaker.pyNN.models.neuron.local_only import AbstractLocalOnly
 from spynnaker.pyNN.models.utility_models.delays import DelayExtensionVertex
-from spynnaker.pyNN.models.neuron.synaptic_matrices import SynapticMatrices
+from spynnaker.pyNN.models.neuron.synaptic_matrices import (
+    SynapticMatrices, uses_eager_post)
 from spynnaker.pyNN.models.neuron.neuron_data import NeuronData
 from spynnaker.pyNN.models.neuron.population_machine_common import (
     PopulationMachineCommon)
+from spynnaker.pyNN.exceptions import SynapticConfigurationException
 
 from .splitter_abstract_pop_vertex import SplitterAbstractPopulationVertex
 from .abstract_spynnaker_splitter_delay import AbstractSpynnakerSplitterDelay
@@ -71,6 +74,10 @@ class SplitterAbstractPopulationVertexFixed(SplitterAbstractPopulationVertex):
     @overrides(AbstractSplitterCommon.create_machine_vertices)
     def create_machine_vertices(self, chip_counter: ChipCounter):
         app_vertex = self.governed_app_vertex
+        if uses_eager_post(app_vertex):
+            raise SynapticConfigurationException(
+                "eager_post_spikes needs the neurons and synapses of "
+                f"{app_vertex.label} to be on separate cores")
         app_vertex.synapse_recorder.add_region_offset(
             len(app_vertex.neuron_recorder.get_recordable_variables()))
 
@@ -299,7 +306,8 @@ class SplitterAbstractPopulationVertexFixed(SplitterAbstractPopulationVertex):
         sdram.add_cost(
             regions.pop_table,
             MasterPopTableAsBinarySearch.get_master_population_table_size(
-                self.governed_app_vertex.incoming_projections))
+                self.governed_app_vertex.incoming_projections,
+                self.governed_app_vertex.direct_pop_table, all_syn_block_sz))
         sdram.add_cost(regions.connection_builder,
                        self.governed_app_vertex.get_synapse_expander_size())
         sdram.add_cost(regions.bitfield_filter,
@@ -313,11 +321,37 @@ class SplitterAbstractPopulationVertexFixed(SplitterAbstractPopulationVertex):
         super().reset_called()
         self.__expect_delay_extension = None
 
+    @property
+    @overrides(SplitterAbstractPopulationVertex.wide_ring_buffers)
+    def wide_ring_buffers(self) -> bool:
+        return bool(get_config_bool("Simulation", "wide_ring_buffers"))
+
+    @property
+    def compact_ring_buffers(self) -> bool:
+        """
+        Whether the ring buffers of the cores have an entry for exactly each
+        neuron, rather than for the next power of two; local-only cores
+        always use the next power of two.
+
+        :rtype: bool
+        """
+        if isinstance(self.governed_app_vertex.synapse_dynamics,
+                      AbstractLocalOnly):
+            return False
+        return bool(get_config_bool("Simulation", "compact_ring_buffers"))
+
     @overrides(SplitterAbstractPopulationVertex._update_max_delay)
     def _update_max_delay(self) -> None:
+        # 32-bit ring buffer entries take twice the DTCM, so there can only
+        # be half as many of them
+        max_ring_buffer_bits = MAX_RING_BUFFER_BITS
+        if self.wide_ring_buffers:
+            max_ring_buffer_bits -= 1
+
         # Find the maximum delay from incoming synapses
         self._max_delay, self.__expect_delay_extension = \
-            self.governed_app_vertex.get_max_delay(MAX_RING_BUFFER_BITS)
+            self.governed_app_vertex.get_max_delay(
+                max_ring_buffer_bits, self.compact_ring_buffers)
 
     @overrides(AbstractSpynnakerSplitterDelay.accepts_edges_from_delay_vertex)
     def accepts_edges_from_delay_vertex(self) -> bool:
@@ -18,10 +18,12 @@ from typing import Dict, List, Optional, Sequence, Set, Tuple, Union, cast
 
 from numpy import floating
 from numpy.typing import NDArray
+from typing_extensions import TypeAlias
 
 from spinn_utilities.overrides import overrides
 from spinn_utilities.log import FormatAdapter
 from spinn_utilities.ordered_set import OrderedSet
+from spinn_utilities.config_holder import get_config_bool, get_config_int
 
 from pacman.model.resources import AbstractSDRAM, MultiRegionSDRAM
 from pacman.model.partitioner_splitters import AbstractSplitterCommon
@@ -42,6 +44,8 @@ from spynnaker.pyNN.models.neuron.synapse_dynamics import (
     AbstractSynapseDynamics)
 from spynnaker.pyNN.data import SpynnakerDataView
 from spynnaker.pyNN.models.common import PopulationApplicationVertex
+from spynnaker.pyNN.models.abstract_models import (
+    ReceivesSynapticInputsOverSDRAM)
 from spynnaker.pyNN.models.neuron import (
     PopulationNeuronsMachineVertex, PopulationSynapsesMachineVertexLead,
     PopulationSynapsesMachineVertexShared, NeuronProvenance, SynapseProvenance,
@@ -57,12 +61,14 @@ from spynnaker.pyNN.types import Delay_Types
 from spynnaker.pyNN.models.neuron.population_synapses_machine_vertex_common \
     import (
         SDRAM_PARAMS_SIZE as SYNAPSES_SDRAM_PARAMS_SIZE, KEY_CONFIG_SIZE,
+        ROW_CACHE_HINTS_SIZE, LATE_PACKET_CONFIG_SIZE, MAX_REDUCE_PARTNERS,
         PopulationSynapsesMachineVertexCommon)
 from spynnaker.pyNN.models.neuron.synaptic_matrices import (
-    SynapseRegionReferences)
+    SynapseRegionReferences, get_post_index_size, uses_eager_post)
 from spynnaker.pyNN.utilities.constants import (
     SYNAPSE_SDRAM_PARTITION_ID, SPIKE_PARTITION_ID)
-from spynnaker.pyNN.models.spike_source import SpikeSourcePoissonVertex
+from spynnaker.pyNN.models.spike_source import (
+    SpikeSourceArrayVertex, SpikeSourcePoissonVertex)
 from spynnaker.pyNN.models.neural_projections import ProjectionApplicationEdge
 from spynnaker.pyNN.models.neural_projections.connectors import (
     OneToOneConnector)
@@ -71,10 +77,13 @@ from spynnaker.pyNN.exceptions import SynapticConfigurationException
 from spynnaker.pyNN.models.neuron.master_pop_table import (
     MasterPopTableAsBinarySearch)
 from spynnaker.pyNN.utilities.bit_field_utilities import (
-    get_sdram_for_bit_field_region)
+    get_sdram_for_bit_field_region, get_spikes_per_second)
 from spynnaker.pyNN.models.spike_source.spike_source_poisson_machine_vertex \
     import (
         SpikeSourcePoissonMachineVertex)
+from spynnaker.pyNN.models.spike_source.\
+    spike_source_array_compact_machine_vertex import (
+        SpikeSourceArrayCompactMachineVertex)
 
 from .splitter_poisson_delegate import SplitterPoissonDelegate
 from .abstract_spynnaker_splitter_delay import AbstractSpynnakerSplitterDelay
@@ -88,9 +97,68 @@ logger = FormatAdapter(logging.getLogger(__name__))
 # fit in DTCM (14-bits = 16,384 16-bit ring buffer entries = 32Kb DTCM
 MAX_RING_BUFFER_BITS = 14
 
+# The maximum number of bits for the ring buffer index held in a synaptic
+# word, which limits the delays a delay wheel can hold
+_MAX_SYNAPTIC_WORD_DELAY_BITS = 16
+
+# The size of a delay wheel entry, which matches a ring buffer entry
+_DELAY_WHEEL_ENTRY_BYTES = 2
+
 # The maximum number of cores to consider acceptable for a single chip
 _MAX_CORES = 15
 
+# A source whose input can be sent over SDRAM
+_DirectSource: TypeAlias = Union[
+    SpikeSourcePoissonVertex, SpikeSourceArrayVertex]
+
+# A core of a source whose input is sent over SDRAM
+_DirectSourceCore: TypeAlias = Union[
+    SpikeSourcePoissonMachineVertex, SpikeSourceArrayCompactMachineVertex]
+
+# The cost of looking up and reading a row for a spike, in row words
+_ROW_OVERHEAD_WORDS = 8
+
+
+def _reduction_tree(n_cores: int) -> Tuple[
+        List[List[int]], List[Tuple[int, int]]]:
+    """
+    Work out how the synapse cores of a neuron core add up their inputs in
+    pairs before the first of them sends the total to the neuron core.
+
+    In each round, each core that is still adding takes in the inputs of the
+    core half the remaining distance away, so the first core takes in the
+    inputs of about log2(n) cores.  Every core must have written its inputs
+    by the time they are read, so the cores further down stop processing
+    spikes earlier.
+
+    :param int n_cores: The number of synapse cores
+    :return:
+        The indices of the cores that each core adds the inputs of, in the
+        order they are added, and the number of transfers and of reads of the
+        inputs of other cores that each core must leave time for at the end
+        of the time step
+    :rtype: tuple(list(list(int)), list(tuple(int, int)))
+    """
+    partners: List[List[int]] = [[] for _ in range(n_cores)]
+    step = 1
+    while step < n_cores:
+        for core in range(0, n_cores - step, 2 * step):
+            partners[core].append(core + step)
+        step *= 2
+
+    # Going down from the first core, the time by which each must have
+    # finished is when the core adding it starts to read it
+    timing: List[Tuple[int, int]] = [(1, 0)] * n_cores
+    to_visit = [(0, 0, 0)]
+    while to_visit:
+        core, n_transfers, n_reduces = to_visit.pop()
+        n_partners = len(partners[core])
+        timing[core] = (n_transfers + 1, n_reduces + n_partners)
+        for i, partner in enumerate(partners[core]):
+            to_visit.append(
+                (partner, n_transfers + 1, n_reduces + n_partners - i))
+    return partners, timing
+
 
 class SplitterAbstractPopulationVertexNeuronsSynapses(
         SplitterAbstractPopulationVertex, AbstractSupportsOneToOneSDRAMInput):
@@ -119,6 +187,8 @@ class SplitterAbstractPopulationVertexNeuronsSynapses(
         "__user_allow_delay_extension",
         # The next synapse core to use for an incoming machine edge
         "__next_synapse_index",
+        # The expected load on each synapse core of a neuron core so far
+        "__synapse_loads",
         # The incoming vertices cached
         "__incoming_vertices",
         # The internal multicast partitions
@@ -166,7 +236,9 @@ class SplitterAbstractPopulationVertexNeuronsSynapses(
             self.__expect_delay_extension = True
             if allow_delay_extension is None:
                 self.__user_allow_delay_extension = True
+        self.__ring_buffer_delay: Optional[int] = None
         self.__next_synapse_index = 0
+        self.__synapse_loads: List[float] = [0.0] * n_synapse_vertices
         # redefined by create_machine_vertices before first use so style
         self.__neuron_vertices: List[PopulationNeuronsMachineVertex] = []
         self.__synapse_vertices: List[
@@ -181,7 +253,7 @@ class SplitterAbstractPopulationVertexNeuronsSynapses(
             List[MachineVertex], AbstractSDRAM]] = []
         self.__neuromodulators: Set[ApplicationVertex] = set()
         self.__incoming_vertices: List[List[MachineVertex]] = []
-        self.__poisson_sources: Set[SpikeSourcePoissonVertex] = set()
+        self.__poisson_sources: Set[_DirectSource] = set()
 
     @overrides(AbstractSplitterCommon.create_machine_vertices)
     def create_machine_vertices(self, chip_counter: ChipCounter):
@@ -196,22 +268,37 @@ class SplitterAbstractPopulationVertexNeuronsSynapses(
                 " be run on a single synapse core.  Please ensure the number"
                 " of synapse cores is set to 1")
 
+        # Post-synaptic spikes can only be applied as they happen by a single
+        # synapse core, as each synapse must only see them once
+        if uses_eager_post(self.governed_app_vertex):
+            if self.__n_synapse_vertices != 1:
+                raise SynapticConfigurationException(
+                    "eager_post_spikes can only be used with a single synapse"
+                    " core.  Please ensure the number of synapse cores is set"
+                    " to 1")
+            if self.governed_app_vertex.synapse_dynamics.backprop_delay:
+                raise SynapticConfigurationException(
+                    "eager_post_spikes needs backprop_delay to be False")
+
         # Do some checks to make sure everything is likely to fit
         n_atom_bits = self.governed_app_vertex.get_n_atom_bits()
         n_synapse_types = \
             self.governed_app_vertex.neuron_impl.get_n_synapse_types()
         if (n_atom_bits + get_n_bits(n_synapse_types) +
-                get_n_bits(self.max_support_delay())) > MAX_RING_BUFFER_BITS:
+                get_n_bits(self.max_ring_buffer_delay())) > \
+                MAX_RING_BUFFER_BITS:
             raise SynapticConfigurationException(
                 "The combination of the number of neurons per core "
                 f"({n_atom_bits}), the number of synapse types "
                 f"({n_synapse_types}), and the maximum delay per core "
-                f"({self.max_support_delay()}) will require too much DTCM. "
+                f"({self.max_ring_buffer_delay()}) will require too much "
+                "DTCM. "
                 "Please reduce one or more of these values.")
 
         self.__neuron_vertices = list()
         self.__synapse_vertices = list()
         self.__synapse_verts_by_neuron = defaultdict(list)
+        self.__synapse_loads = [0.0] * self.__n_synapse_vertices
 
         incoming_direct_poisson = self.__handle_poisson_sources(label)
 
@@ -228,7 +315,9 @@ class SplitterAbstractPopulationVertexNeuronsSynapses(
         n_incoming = self.__n_synapse_vertices + len(self.__poisson_sources)
         edge_sdram = PopulationNeuronsMachineVertex.get_n_bytes_for_transfer(
             atoms_per_core, n_synapse_types)
-        sdram_edge_sdram = edge_sdram * n_incoming
+        sdram_edge_sdram = edge_sdram * n_incoming + (
+            self.__n_synapse_vertices *
+            ReceivesSynapticInputsOverSDRAM.N_BYTES_FOR_SYNAPSE_HEADER)
 
         # Get maximum resources for neurons for each split
         neuron_sdram = self.__get_neuron_sdram(
@@ -290,7 +379,7 @@ class SplitterAbstractPopulationVertexNeuronsSynapses(
             # Add resources for Poisson vertices up to core limit
             poisson_vertices = incoming_direct_poisson[vertex_slice]
             # remaining_poisson_vertices = list()
-            added_poisson_vertices: List[SpikeSourcePoissonMachineVertex] = []
+            added_poisson_vertices: List[_DirectSourceCore] = []
             for poisson_vertex, _possion_edge in poisson_vertices:
                 added_poisson_vertices.append(poisson_vertex)
                 chip_counter.add_core(poisson_vertex.sdram_required)
@@ -300,7 +389,20 @@ class SplitterAbstractPopulationVertexNeuronsSynapses(
             sdram_partition = SourceSegmentedSDRAMMachinePartition(
                 SYNAPSE_SDRAM_PARTITION_ID, source_vertices)
             self.__sdram_partitions.append(sdram_partition)
-            neuron_vertex.set_sdram_partition(sdram_partition)
+
+            # If the synapse cores add up their inputs first, the neuron core
+            # only reads those of the first of them
+            n_sources_read = None
+            if self.__reduce_synapse_inputs():
+                self.__set_reduction(synapse_vertices)
+                n_sources_read = len(added_poisson_vertices) + 1
+            neuron_vertex.set_sdram_partition(
+                sdram_partition, n_sources_read, len(added_poisson_vertices))
+
+            # Each synapse core has its own delay wheel, if needed
+            delay_wheel_size = self.get_delay_wheel_size(atoms_per_core)
+            for synapse_vertex in synapse_vertices:
+                synapse_vertex.set_delay_wheel_size(delay_wheel_size)
 
             # Add SDRAM edges for synapse vertices
             for source_vertex in source_vertices:
@@ -324,6 +426,35 @@ class SplitterAbstractPopulationVertexNeuronsSynapses(
             if edge.is_neuromodulation:
                 self.__neuromodulators.add(edge.pre_vertex)
 
+    def __reduce_synapse_inputs(self) -> bool:
+        """
+        Whether the synapse cores of each neuron core add up their inputs
+        between them before sending them to the neuron core.
+
+        :rtype: bool
+        """
+        reduce_from = get_config_int(
+            "Simulation", "reduce_synapse_inputs_from_n_cores")
+        n_cores = self.__n_synapse_vertices
+        return (bool(reduce_from) and n_cores >= reduce_from and
+                (n_cores - 1).bit_length() <= MAX_REDUCE_PARTNERS)
+
+    @staticmethod
+    def __set_reduction(
+            synapse_vertices: List[PopulationSynapsesMachineVertexCommon]):
+        """
+        Set up the synapse cores of a neuron core to add up their inputs.
+
+        :param list(PopulationSynapsesMachineVertexCommon) synapse_vertices:
+            The synapse cores, the first of which sends to the neuron core
+        """
+        partners, timing = _reduction_tree(len(synapse_vertices))
+        for vertex, core_partners, (n_transfers, n_reduces) in zip(
+                synapse_vertices, partners, timing):
+            vertex.set_reduction(
+                [synapse_vertices[i] for i in core_partners],
+                n_transfers, n_reduces)
+
     def __add_neuron_core(
             self, vertex_slice: Slice, sdram: AbstractSDRAM,
             label: str, index: int, rb_shifts: List[int],
@@ -485,17 +616,17 @@ class SplitterAbstractPopulationVertexNeuronsSynapses(
         return len(incoming) + self.__n_synapse_vertices + 1 > _MAX_CORES
 
     def __handle_poisson_sources(self, label: str) -> Dict[Slice, List[Tuple[
-            SpikeSourcePoissonMachineVertex, ProjectionApplicationEdge]]]:
+            _DirectSourceCore, ProjectionApplicationEdge]]]:
         """
-        Go through the incoming projections and find Poisson sources with
-        splitters that work with us, and one-to-one connections that will
-        then work with SDRAM.
+        Go through the incoming projections and find Poisson sources and
+        compact spike source arrays with splitters that work with us, and
+        one-to-one connections that will then work with SDRAM.
 
         :param str label: Base label to give to the Poisson cores
         """
         self.__poisson_sources = set()
         incoming_direct_poisson: Dict[Slice, List[Tuple[
-            SpikeSourcePoissonMachineVertex,
+            _DirectSourceCore,
             ProjectionApplicationEdge]]] = defaultdict(list)
         # If there are going to be too many to fit on a chip, don't do direct
         # Poisson
@@ -504,7 +635,7 @@ class SplitterAbstractPopulationVertexNeuronsSynapses(
         for proj in self.governed_app_vertex.incoming_poisson_projections:
             # pylint: disable=protected-access
             edge = proj._projection_edge
-            pre_vertex = cast(SpikeSourcePoissonVertex, edge.pre_vertex)
+            pre_vertex = cast(_DirectSource, edge.pre_vertex)
             conn = proj._synapse_information.connector
             dynamics = proj._synapse_information.synapse_dynamics
             delay = proj._synapse_information.delays
@@ -514,10 +645,11 @@ class SplitterAbstractPopulationVertexNeuronsSynapses(
                 # for the Poisson will create any others as needed
                 for vertex_slice in self._get_fixed_slices():
                     sdram = pre_vertex.get_sdram_used_by_atoms(vertex_slice)
-                    poisson_m_vertex = pre_vertex.create_machine_vertex(
-                        vertex_slice, sdram, label=(
-                            f"{label}_Poisson:"
-                            f"{vertex_slice.lo_atom}"))
+                    poisson_m_vertex = cast(
+                        _DirectSourceCore, pre_vertex.create_machine_vertex(
+                            vertex_slice, sdram, label=(
+                                f"{label}_Poisson:"
+                                f"{vertex_slice.lo_atom}")))
                     pre_vertex.remember_machine_vertex(poisson_m_vertex)
                     incoming_direct_poisson[vertex_slice].append(
                         (poisson_m_vertex, edge))
@@ -545,7 +677,8 @@ class SplitterAbstractPopulationVertexNeuronsSynapses(
             self, pre_vertex: ApplicationVertex, connector: AbstractConnector,
             dynamics: AbstractSynapseDynamics, delay: Delay_Types) -> bool:
         """
-        Determine if a given Poisson source can be created by this splitter.
+        Determine if a given Poisson source or compact spike source array
+        can be created by this splitter.
 
         :param ~pacman.model.graphs.application.ApplicationVertex pre_vertex:
             The vertex sending into the Projection
@@ -561,7 +694,8 @@ class SplitterAbstractPopulationVertexNeuronsSynapses(
             The delay in use in the Projection
         :rtype: bool
         """
-        return (isinstance(pre_vertex, SpikeSourcePoissonVertex) and
+        return (isinstance(pre_vertex, (
+                    SpikeSourcePoissonVertex, SpikeSourceArrayVertex)) and
                 isinstance(pre_vertex.splitter, SplitterPoissonDelegate) and
                 len(pre_vertex.outgoing_projections) == 1 and
                 pre_vertex.n_atoms == self.governed_app_vertex.n_atoms and
@@ -634,25 +768,79 @@ class SplitterAbstractPopulationVertexNeuronsSynapses(
         n_sources = len(sources)
         sources_per_vertex = max(1, int(2 ** math.ceil(math.log2(
             n_sources / self.__n_synapse_vertices))))
+        groups = [sources[start:start + sources_per_vertex]
+                  for start in range(0, n_sources, sources_per_vertex)]
 
-        # Start on a different index each time to "even things out"
-        index = self.__next_synapse_index
-        self.__next_synapse_index = (
-            (self.__next_synapse_index + 1) % self.__n_synapse_vertices)
         result: List[Tuple[MachineVertex, List[MachineVertex]]] = list()
-        for start in range(0, n_sources, sources_per_vertex):
-            end = min(start + sources_per_vertex, n_sources)
-            source_range = sources[start:end]
+        for source_range, index in zip(groups, self.__get_synapse_indices(
+                source_vertex, pre_vertex, groups)):
             for s_vertex in self.__incoming_vertices[index]:
                 targets_filtered = targets[s_vertex]
                 filtered = [s for s in source_range
                             if (s in targets_filtered or
                                 s.app_vertex in targets_filtered)]
                 result.append((s_vertex, filtered))
-            index = (index + 1) % self.__n_synapse_vertices
 
         return result
 
+    def __get_synapse_indices(
+            self, source_vertex: ApplicationVertex,
+            pre_vertex: PopulationApplicationVertex,
+            groups: List[Sequence[MachineVertex]]) -> List[int]:
+        """
+        Choose the synapse core of each neuron core to send each group of
+        sources of an incoming vertex to.
+
+        By default the groups go to the synapse cores in turn, starting on a
+        different core for each incoming vertex.  If
+        balance_synapse_cores_by_load is set, each group goes to the core with
+        the least expected load so far, largest group first, where the load of
+        a group is the number of row words it is expected to read each second.
+
+        :param source_vertex: The incoming vertex, which may be a delay
+        :param pre_vertex: The population the spikes come from
+        :param groups: The groups of machine vertices of the incoming vertex
+        :return: The index of the synapse core for each group
+        :rtype: list(int)
+        """
+        n_cores = self.__n_synapse_vertices
+        if not get_config_bool("Simulation", "balance_synapse_cores_by_load"):
+            # Start on a different index each time to "even things out"
+            start = self.__next_synapse_index
+            self.__next_synapse_index = (start + 1) % n_cores
+            return [(start + i) % n_cores for i in range(len(groups))]
+
+        # The words of the rows of each atom of the source, over all the
+        # projections from it
+        n_post_atoms = min(
+            self.governed_app_vertex.get_max_atoms_per_core(),
+            self.governed_app_vertex.n_atoms)
+        row_words = 0
+        for proj in self.governed_app_vertex.get_incoming_projections_from(
+                pre_vertex):
+            # pylint: disable=protected-access
+            max_row_info = self.governed_app_vertex.get_max_row_info(
+                proj._synapse_information, n_post_atoms,
+                proj._projection_edge)
+            if isinstance(source_vertex, DelayExtensionVertex):
+                n_words = max_row_info.delayed_max_words
+            else:
+                n_words = max_row_info.undelayed_max_words
+            if n_words > 0:
+                row_words += n_words + _ROW_OVERHEAD_WORDS
+        rate = get_spikes_per_second(pre_vertex)
+
+        indices = [0] * len(groups)
+        costs = [rate * row_words * sum(
+                     m_vertex.vertex_slice.n_atoms for m_vertex in group)
+                 for group in groups]
+        for group_index in sorted(
+                range(len(groups)), key=lambda i: -costs[i]):
+            index = min(range(n_cores), key=lambda i: self.__synapse_loads[i])
+            indices[group_index] = index
+            self.__synapse_loads[index] += costs[group_index]
+        return indices
+
     @overrides(AbstractSplitterCommon.machine_vertices_for_recording)
     def machine_vertices_for_recording(
             self, variable_to_record: str) -> Sequence[MachineVertex]:
@@ -666,7 +854,9 @@ class SplitterAbstractPopulationVertexNeuronsSynapses(
         self.__neuron_vertices = []
         self.__synapse_vertices = []
         self.__synapse_verts_by_neuron = {}
+        self.__synapse_loads = [0.0] * self.__n_synapse_vertices
         self._max_delay = self.__user_max_delay
+        self.__ring_buffer_delay = None
         if self.__user_max_delay is None:
             # to be calculated by __update_max_delay
             self.__expect_delay_extension = None
@@ -676,11 +866,9 @@ class SplitterAbstractPopulationVertexNeuronsSynapses(
         self.__sdram_partitions = []
         self.__same_chip_groups = []
 
+    @overrides(SplitterAbstractPopulationVertex.n_synapse_vertices)
     @property
     def n_synapse_vertices(self) -> int:
-        """
-        The number of synapse vertices per neuron vertex.
-        """
         return self.__n_synapse_vertices
 
     def __get_neuron_sdram(
@@ -734,13 +922,19 @@ class SplitterAbstractPopulationVertexNeuronsSynapses(
             self, n_atoms: int, all_syn_block_sz: int,
             structural_sz: int) -> MultiRegionSDRAM:
         independent_synapse_sdram = self.__independent_synapse_sdram()
-        proj_dependent_sdram = self.__proj_dependent_synapse_sdram()
+        proj_dependent_sdram = self.__proj_dependent_synapse_sdram(
+            all_syn_block_sz)
         dynamics_sz = self.governed_app_vertex.get_synapse_dynamics_size(
             n_atoms)
         dynamics_sz = max(dynamics_sz, BYTES_PER_WORD)
-        return self.__shared_synapse_sdram(
+        sdram = self.__shared_synapse_sdram(
             independent_synapse_sdram, proj_dependent_sdram,
             all_syn_block_sz, structural_sz, dynamics_sz)
+        if uses_eager_post(self.governed_app_vertex):
+            regions = PopulationSynapsesMachineVertexLead.SYNAPSE_REGIONS
+            sdram.add_cost(regions.post_index, get_post_index_size(
+                n_atoms, all_syn_block_sz))
+        return sdram
 
     def __get_synapse_sdram(
             self, n_atoms: int,
@@ -769,7 +963,11 @@ class SplitterAbstractPopulationVertexNeuronsSynapses(
             SYNAPSES_SDRAM_PARAMS_SIZE)
         sdram.add_cost(
             PopulationSynapsesMachineVertexLead.REGIONS.KEY_REGION,
-            KEY_CONFIG_SIZE)
+            KEY_CONFIG_SIZE + ROW_CACHE_HINTS_SIZE +
+            LATE_PACKET_CONFIG_SIZE)
+        sdram.add_cost(
+            PopulationSynapsesMachineVertexLead.REGIONS.DELAY_WHEEL,
+            self.get_delay_wheel_size(n_atoms))
         sdram.nest(
             len(PopulationSynapsesMachineVertexLead.REGIONS) + 1,
             variable_sdram)
@@ -793,12 +991,13 @@ class SplitterAbstractPopulationVertexNeuronsSynapses(
                 BYTES_PER_WORD))
         return sdram
 
-    def __proj_dependent_synapse_sdram(self) -> MultiRegionSDRAM:
+    def __proj_dependent_synapse_sdram(
+            self, all_syn_block_sz: int) -> MultiRegionSDRAM:
         """
         Get the SDRAM used by synapse cores dependent on the projections.
 
-        :param list(~spynnaker.pyNN.models.Projection) incoming_projections:
-            The projections to consider in the calculations
+        :param int all_syn_block_sz:
+            The size of the synaptic matrix the population table points into
         :rtype: ~pacman.model.resources.MultiRegionSDRAM
         """
         regions = PopulationSynapsesMachineVertexLead.SYNAPSE_REGIONS
@@ -806,7 +1005,8 @@ class SplitterAbstractPopulationVertexNeuronsSynapses(
         sdram.add_cost(
             regions.pop_table,
             max(MasterPopTableAsBinarySearch.get_master_population_table_size(
-                self.governed_app_vertex.incoming_projections),
+                self.governed_app_vertex.incoming_projections,
+                self.governed_app_vertex.direct_pop_table, all_syn_block_sz),
                 BYTES_PER_WORD))
         sdram.add_cost(
             regions.connection_builder,
@@ -819,14 +1019,66 @@ class SplitterAbstractPopulationVertexNeuronsSynapses(
                 BYTES_PER_WORD))
         return sdram
 
+    def __can_use_delay_wheel(self) -> bool:
+        """
+        Whether delays too long for the ring buffers can be held in a delay
+        wheel on the synapse cores, which is only done for static synapses.
+
+        :rtype: bool
+        """
+        if not get_config_bool("Simulation", "synapse_delay_wheel"):
+            return False
+        for proj in self.governed_app_vertex.incoming_projections:
+            # pylint: disable=protected-access
+            dynamics = proj._synapse_information.synapse_dynamics
+            if (not isinstance(dynamics, SynapseDynamicsStatic) or
+                    isinstance(dynamics, AbstractSynapseDynamicsStructural)):
+                return False
+        return True
+
     @overrides(SplitterAbstractPopulationVertex._update_max_delay)
     def _update_max_delay(self) -> None:
         # Find the maximum delay from incoming synapses
         self._max_delay, needs_delay_extension = \
             self.governed_app_vertex.get_max_delay(MAX_RING_BUFFER_BITS)
+        self.__ring_buffer_delay = self._max_delay
+
+        # Delays that don't fit in the ring buffers can go in a delay wheel,
+        # as long as they fit in the synaptic words
+        if needs_delay_extension and self.__can_use_delay_wheel():
+            self._max_delay, needs_delay_extension = \
+                self.governed_app_vertex.get_max_delay(
+                    _MAX_SYNAPTIC_WORD_DELAY_BITS)
+            self._max_delay = max(self._max_delay, self.__ring_buffer_delay)
         if self.__user_allow_delay_extension is None:
             self.__expect_delay_extension = needs_delay_extension
 
+    @overrides(AbstractSpynnakerSplitterDelay.max_ring_buffer_delay)
+    def max_ring_buffer_delay(self) -> int:
+        max_delay = self.max_support_delay()
+        if self.__ring_buffer_delay is None:
+            # The user has given the delay, so there is no delay wheel
+            return max_delay
+        return self.__ring_buffer_delay
+
+    def get_delay_wheel_size(self, n_atoms: int) -> int:
+        """
+        Get the size of the delay wheel of a synapse core, which holds the
+        synapses with delays too long for the ring buffers.
+
+        :param int n_atoms: The maximum number of atoms on a core
+        :return: The size in bytes, or 0 if there is no delay wheel
+        :rtype: int
+        """
+        max_delay = self.max_support_delay()
+        if max_delay <= self.max_ring_buffer_delay():
+            return 0
+        n_synapse_types = \
+            self.governed_app_vertex.neuron_impl.get_n_synapse_types()
+        n_bits = (get_n_bits(max_delay) + get_n_bits(n_atoms) +
+                  get_n_bits(n_synapse_types))
+        return _DELAY_WHEEL_ENTRY_BYTES * (2 ** n_bits)
+
     @overrides(AbstractSpynnakerSplitterDelay.accepts_edges_from_delay_vertex)
     def accepts_edges_from_delay_vertex(self) -> bool:
         if self.__user_allow_delay_extension is None:
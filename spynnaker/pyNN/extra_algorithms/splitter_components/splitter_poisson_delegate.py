@@ -11,7 +11,7 @@
 # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 # See the License for the specific language governing permissions and
 # limitations under the License.
-from typing import List, Sequence, Tuple
+from typing import List, Sequence, Tuple, Union
 from spinn_utilities.overrides import overrides
 from pacman.model.graphs.machine import MachineVertex
 from pacman.model.graphs.common import Slice
@@ -20,15 +20,17 @@ from pacman.model.partitioner_splitters import AbstractSplitterCommon
 from pacman.exceptions import PacmanConfigurationException
 from pacman.model.partitioner_splitters import SplitterFixedLegacy
 from pacman.utilities.utility_objs import ChipCounter
-from spynnaker.pyNN.models.spike_source import SpikeSourcePoissonVertex
+from spynnaker.pyNN.models.spike_source import (
+    SpikeSourceArrayVertex, SpikeSourcePoissonVertex)
 from .abstract_supports_one_to_one_sdram_input import (
     AbstractSupportsOneToOneSDRAMInput)
 
 
-class SplitterPoissonDelegate(SplitterFixedLegacy[SpikeSourcePoissonVertex]):
+class SplitterPoissonDelegate(SplitterFixedLegacy[
+        Union[SpikeSourcePoissonVertex, SpikeSourceArrayVertex]]):
     """
-    A splitter for Poisson sources that will ignore sources that are
-    one-to-one connected to a single Population.
+    A splitter for Poisson sources and compact spike source arrays that will
+    ignore sources that are one-to-one connected to a single Population.
     """
 
     @property
@@ -52,13 +54,17 @@ class SplitterPoissonDelegate(SplitterFixedLegacy[SpikeSourcePoissonVertex]):
         return post_vertex.splitter.handles_source_vertex(proj)
 
     @overrides(SplitterFixedLegacy.set_governed_app_vertex)
-    def set_governed_app_vertex(self, app_vertex: SpikeSourcePoissonVertex):
-        if not isinstance(app_vertex, SpikeSourcePoissonVertex):
+    def set_governed_app_vertex(self, app_vertex: Union[
+            SpikeSourcePoissonVertex, SpikeSourceArrayVertex]):
+        if not isinstance(app_vertex, SpikeSourcePoissonVertex) and not (
+                isinstance(app_vertex, SpikeSourceArrayVertex) and
+                app_vertex.compact):
             raise PacmanConfigurationException(
                 f"The vertex {app_vertex} cannot be supported by the "
-                "SplitterPoissonDelegate as the only vertex supported by this "
-                "splitter is a SpikeSourcePoissonVertex. Please use the "
-                "correct splitter for your vertex and try again.")
+                "SplitterPoissonDelegate as the only vertices supported by "
+                "this splitter are a SpikeSourcePoissonVertex and a compact "
+                "SpikeSourceArrayVertex. Please use the correct splitter for "
+                "your vertex and try again.")
         super().set_governed_app_vertex(app_vertex)
 
     @overrides(SplitterFixedLegacy.create_machine_vertices)
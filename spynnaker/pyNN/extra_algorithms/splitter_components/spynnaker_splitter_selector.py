@@ -83,7 +83,10 @@ def spynnaker_vertex_selector(app_vertex: ApplicationVertex):
         elif isinstance(app_vertex, ApplicationFPGAVertex):
             app_vertex.splitter = SplitterExternalDevice()
         elif isinstance(app_vertex, SpikeSourceArrayVertex):
-            app_vertex.splitter = SplitterFixedLegacy()
+            if app_vertex.compact and not _is_multidimensional(app_vertex):
+                app_vertex.splitter = SplitterPoissonDelegate()
+            else:
+                app_vertex.splitter = SplitterFixedLegacy()
         elif isinstance(app_vertex, SpikeSourcePoissonVertex):
             if _is_multidimensional(app_vertex):
                 app_vertex.splitter = SplitterFixedLegacy()
@@ -11,23 +11,62 @@
 # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 # See the License for the specific language governing permissions and
 # limitations under the License.
+import hashlib
 import logging
-from typing import List, Tuple, cast
-from spinn_utilities.config_holder import get_config_bool
+import os
+from typing import List, NamedTuple, Tuple, cast
+from spinn_utilities.config_holder import (
+    get_config_bool, get_config_str_or_none)
 from spinn_utilities.log import FormatAdapter
 from spinn_utilities.progress_bar import ProgressBar
 from spinnman.model.enums import ExecutableType
 from spinnman.model import ExecutableTargets
 from spinnman.model.enums import CPUState, UserRegister
 from pacman.model.placements import Placement
+from spinn_front_end_common.utilities.constants import BYTES_PER_WORD
 from spinn_front_end_common.utilities.system_control_logic import (
     run_system_application)
 from spynnaker.pyNN.data import SpynnakerDataView
 from spynnaker.pyNN.models.abstract_models import (
     AbstractSynapseExpandable, SYNAPSE_EXPANDER_APLX)
+from spynnaker._version import __version__
+from .expander_timings import (
+    allocate_timing_buffers, insert_timing_provenance, read_timings,
+    write_timing_report, SYNAPSE_RECORD_WORDS)
 
 logger = FormatAdapter(logging.getLogger(__name__))
 
+# The size of the table of work shared by the expander cores of a chip;
+# these match EXPANDER_N_CORES and expander_share_t in synapse_expander.c
+_N_SHARE_CORES = 18
+_SHARE_WORDS = 9
+_SHARE_TABLE_BYTES = _N_SHARE_CORES * _SHARE_WORDS * BYTES_PER_WORD
+
+
+class _CacheEntry(NamedTuple):
+    """
+    Where the expanded matrices of a core are to be saved once expanded.
+    """
+    placement: Placement
+    file_name: str
+    blocks: List[Tuple[int, int]]
+
+
+class _ExpansionPlan(NamedTuple):
+    """
+    Where the synapse expander is to run, and what to do around it.
+    """
+    #: The cores to run the expander on
+    expander_cores: ExecutableTargets
+    #: The placements whose synapses the expander makes
+    run_placements: List[Placement]
+    #: The placements whose synapses are expanded or loaded from the cache
+    expanded_placements: List[Placement]
+    #: The expanded matrices to save in the cache once made
+    to_cache: List[_CacheEntry]
+    #: An estimate of how long the expansion should be let run
+    timeout: float
+
 
 def synapse_expander() -> None:
     """
@@ -37,41 +76,143 @@ def synapse_expander() -> None:
         Needs to be done after data has been loaded.
     """
     # Find the places where the synapse expander and delay receivers should run
-    expander_cores, expanded_placements, timeout = _plan_expansion()
+    plan = _plan_expansion()
+    expander_cores = plan.expander_cores
 
     if expander_cores.total_processors:
         with ProgressBar(expander_cores.total_processors,
                          "Expanding Synapses") as progress:
             expander_app_id = SpynnakerDataView.get_new_id()
+            if get_config_bool("Simulation", "expander_work_sharing"):
+                _write_share_tables(expander_cores, expander_app_id)
+            timing_buffers = None
+            if get_config_bool("Reports", "write_expander_timings"):
+                timing_buffers = allocate_timing_buffers(
+                    plan.run_placements, SYNAPSE_RECORD_WORDS)
             run_system_application(
                 expander_cores, expander_app_id,
                 get_config_bool("Reports", "write_expander_iobuf") or False,
                 None, frozenset({CPUState.FINISHED}), False,
                 "synapse_expander_on_{}_{}_{}.txt",
-                progress_bar=progress, logger=logger, timeout=timeout)
+                progress_bar=progress, logger=logger, timeout=plan.timeout)
+            if timing_buffers is not None:
+                timings = read_timings(timing_buffers, SYNAPSE_RECORD_WORDS)
+                insert_timing_provenance(timings, True)
+                write_timing_report(timings, True)
+    if plan.to_cache:
+        _save_to_cache(plan.to_cache)
 
     # Once expander has run, fill in the connection data.
-    if expanded_placements:
-        with ProgressBar(len(expanded_placements),
+    if plan.expanded_placements:
+        with ProgressBar(len(plan.expanded_placements),
                          "Reading generated connections") as progress:
-            for placement in progress.over(expanded_placements):
+            for placement in progress.over(plan.expanded_placements):
                 vertex = cast(AbstractSynapseExpandable, placement.vertex)
                 vertex.read_generated_connection_holders(placement)
 
 
-def _plan_expansion() -> Tuple[ExecutableTargets, List[Placement], float]:
+def _write_share_tables(
+        expander_cores: ExecutableTargets, app_id: int) -> None:
+    """
+    Give the expander cores of each chip a table in which to share their
+    work, using USER2.
+
+    :param ~.ExecutableTargets expander_cores: Where the expander will run
+    :param int app_id: The application ID of the expander
+    """
+    txrx = SpynnakerDataView.get_transceiver()
+    for core_subset in expander_cores.all_core_subsets:
+        x, y = core_subset.x, core_subset.y
+        address = txrx.malloc_sdram(x, y, _SHARE_TABLE_BYTES, app_id)
+        txrx.write_memory(x, y, address, bytes(_SHARE_TABLE_BYTES))
+        for p in core_subset.processor_ids:
+            txrx.write_user(x, y, p, UserRegister.USER_2, address)
+
+
+def _versions_digest(synapse_bin: str) -> bytes:
+    """
+    Get a digest of the versions of the tools and the expander, which are
+    part of the key of every entry in the cache.
+
+    :param str synapse_bin: The path of the synapse expander executable
+    :rtype: bytes
+    """
+    digest = hashlib.sha256(__version__.encode())
+    with open(synapse_bin, "rb") as f:
+        digest.update(f.read())
+    return digest.digest()
+
+
+def _cache_file_name(
+        cache_dir: str, versions: bytes, vertex: AbstractSynapseExpandable,
+        placement: Placement, blocks: List[Tuple[int, int]]) -> str:
+    """
+    Get the file in the cache of the matrices expanded from the data that
+    the expander would read on a core into the given blocks.
+    """
+    address, size = vertex.get_generator_data_block(placement)
+    digest = hashlib.sha256(versions)
+    digest.update(SpynnakerDataView.get_transceiver().read_memory(
+        placement.x, placement.y, address, size))
+    digest.update(repr(blocks).encode())
+    return os.path.join(cache_dir, f"{digest.hexdigest()}.bin")
+
+
+def _load_from_cache(entry: _CacheEntry) -> bool:
+    """
+    Write the saved matrices of a core to the machine, if there are any.
+
+    :return: Whether they were written
+    """
+    if not os.path.isfile(entry.file_name):
+        return False
+    with open(entry.file_name, "rb") as f:
+        data = f.read()
+    if len(data) != sum(size for _, size in entry.blocks):
+        return False
+    txrx = SpynnakerDataView.get_transceiver()
+    offset = 0
+    for address, size in entry.blocks:
+        txrx.write_memory(
+            entry.placement.x, entry.placement.y, address,
+            data[offset:offset + size])
+        offset += size
+    return True
+
+
+def _save_to_cache(to_cache: List[_CacheEntry]) -> None:
+    """
+    Save the matrices made by the expander in the cache.
+    """
+    txrx = SpynnakerDataView.get_transceiver()
+    progress = ProgressBar(len(to_cache), "Saving expanded synapses")
+    for entry in progress.over(to_cache):
+        x, y = entry.placement.x, entry.placement.y
+        temp_name = f"{entry.file_name}.{os.getpid()}"
+        with open(temp_name, "wb") as f:
+            for address, size in entry.blocks:
+                f.write(txrx.read_memory(x, y, address, size))
+        os.replace(temp_name, entry.file_name)
+
+
+def _plan_expansion() -> _ExpansionPlan:
     """
     Plan the expansion of synapses and set up the regions using USER1.
+    Where the matrices of a core are in the cache, they are written instead.
 
-    :return: The places to load the synapse expander and delay expander
-        executables, the target machine vertices to read synapses back from,
-        and an estimated timeout for how long the expansion should be let run.
-    :rtype: tuple(~.ExecutableTargets, list(~.Placement), float)
+    :rtype: _ExpansionPlan
     """
     synapse_bin = SpynnakerDataView.get_executable_path(SYNAPSE_EXPANDER_APLX)
     expander_cores = ExecutableTargets()
-    expanded_placements = list()
+    run_placements: List[Placement] = list()
+    expanded_placements: List[Placement] = list()
+    to_cache: List[_CacheEntry] = list()
     txrx = SpynnakerDataView.get_transceiver()
+    cache_dir = get_config_str_or_none("Simulation", "synapse_expander_cache")
+    versions = b""
+    if cache_dir is not None:
+        os.makedirs(cache_dir, exist_ok=True)
+        versions = _versions_digest(synapse_bin)
 
     max_data = 0
     max_bit_field = 0
@@ -83,10 +224,21 @@ def _plan_expansion() -> Tuple[ExecutableTargets, List[Placement], float]:
         vertex = placement.vertex
         if isinstance(vertex, AbstractSynapseExpandable):
             if vertex.gen_on_machine():
+                expanded_placements.append(placement)
+                blocks = None
+                if cache_dir is not None:
+                    blocks = vertex.get_expanded_blocks(placement)
+                if cache_dir is not None and blocks is not None:
+                    entry = _CacheEntry(placement, _cache_file_name(
+                        cache_dir, versions, vertex, placement, blocks),
+                        blocks)
+                    if _load_from_cache(entry):
+                        continue
+                    to_cache.append(entry)
                 expander_cores.add_processor(
                     synapse_bin, placement.x, placement.y, placement.p,
                     executable_type=ExecutableType.SYSTEM)
-                expanded_placements.append(placement)
+                run_placements.append(placement)
                 # Write the region to USER1, as that is the best we can do
                 txrx.write_user(
                     placement.x, placement.y, placement.p, UserRegister.USER_1,
@@ -98,4 +250,6 @@ def _plan_expansion() -> Tuple[ExecutableTargets, List[Placement], float]:
     timeout = max(2.0, max_data / 1000.0)
     # Also allow 1s per 1000 bytes of bitfields
     timeout += max(2.0, max_bit_field / 1000.0)
-    return expander_cores, expanded_placements, timeout
+    return _ExpansionPlan(
+        expander_cores, run_placements, expanded_placements, to_cache,
+        timeout)
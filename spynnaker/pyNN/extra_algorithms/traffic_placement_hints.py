@@ -0,0 +1,228 @@
+# Copyright (c) 2026 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""
+Placement hints that put vertices that send each other a lot of spikes on
+the same or nearby chips.
+"""
+import logging
+import math
+from collections import defaultdict
+from typing import Dict, Hashable, List, Mapping, Sequence, Set, Tuple, TypeVar
+from spinn_utilities.config_holder import get_config_int
+from spinn_utilities.log import FormatAdapter
+from pacman.model.graphs.application import (
+    ApplicationVertex, ApplicationSpiNNakerLinkVertex, ApplicationFPGAVertex)
+from spynnaker.pyNN.data import SpynnakerDataView
+from spynnaker.pyNN.models.common import PopulationApplicationVertex
+from spynnaker.pyNN.models.neural_projections import ProjectionApplicationEdge
+from spynnaker.pyNN.models.neuron import AbstractPopulationVertex
+from spynnaker.pyNN.utilities.bit_field_utilities import (
+    get_spikes_per_second)
+from .splitter_components import (
+    SplitterAbstractPopulationVertexNeuronsSynapses)
+
+logger = FormatAdapter(logging.getLogger(__name__))
+
+#: The most passes of refinement of each bisection
+_MAX_REFINE_PASSES = 8
+
+V = TypeVar("V", bound=Hashable)
+
+
+def get_traffic_graph() -> Dict[Tuple[ApplicationVertex, ApplicationVertex],
+                                float]:
+    """
+    Get the expected packets per second between each pair of vertices
+    connected by projections.  Each spike of a source is one packet however
+    many projections it goes on, so it is counted once per target.
+
+    :return: The packets per second of each pair, in either direction
+    :rtype: dict(tuple(ApplicationVertex, ApplicationVertex), float)
+    """
+    traffic: Dict[Tuple[ApplicationVertex, ApplicationVertex], float] = \
+        defaultdict(float)
+    for partition in SpynnakerDataView.iterate_partitions():
+        pre_vertex = partition.pre_vertex
+        rate = pre_vertex.n_atoms * get_spikes_per_second(pre_vertex)
+        targets: Set[ApplicationVertex] = set()
+        for edge in partition.edges:
+            if (isinstance(edge, ProjectionApplicationEdge) and
+                    edge.post_vertex is not pre_vertex):
+                targets.add(edge.post_vertex)
+        for post_vertex in targets:
+            traffic[_pair(pre_vertex, post_vertex)] += rate
+    return traffic
+
+
+def _pair(a: V, b: V) -> Tuple[V, V]:
+    return (a, b) if id(a) < id(b) else (b, a)
+
+
+def partition_by_traffic(
+        vertices: Sequence[V], traffic: Mapping[Tuple[V, V], float],
+        sizes: Mapping[V, int], capacity: int) -> List[List[V]]:
+    """
+    Split vertices into groups that each fit within a capacity, cutting as
+    little traffic as possible between the groups.
+
+    This recursively bisects the vertices, refining each bisection by moving
+    the vertices whose move cuts the most traffic while keeping the halves
+    balanced, in the manner of Fiduccia and Mattheyses.  The groups are
+    returned in bisection order, so groups next to each other in the list
+    tend to share more traffic than those far apart.
+
+    :param list vertices: The vertices to split
+    :param dict traffic: The traffic between pairs of vertices, keyed either
+        way round
+    :param dict sizes: The size of each vertex, which must not exceed the
+        capacity
+    :param int capacity: The most total size of a group
+    :rtype: list(list)
+    """
+    neighbours: Dict[V, Dict[V, float]] = defaultdict(dict)
+    for (a, b), weight in traffic.items():
+        if a in sizes and b in sizes and a != b:
+            neighbours[a][b] = neighbours[a].get(b, 0.0) + weight
+            neighbours[b][a] = neighbours[b].get(a, 0.0) + weight
+    return _bisect(list(vertices), neighbours, sizes, capacity)
+
+
+def _bisect(
+        vertices: List[V], neighbours: Mapping[V, Dict[V, float]],
+        sizes: Mapping[V, int], capacity: int) -> List[List[V]]:
+    total = sum(sizes[v] for v in vertices)
+    if total <= capacity or len(vertices) < 2:
+        return [vertices]
+
+    # Grow the first half from the vertex with the most traffic, taking the
+    # neighbour with the most traffic into the half each time
+    members = set(vertices)
+    start = max(vertices, key=lambda v: sum(
+        w for n, w in neighbours[v].items() if n in members))
+    first: Set[V] = {start}
+    first_size = sizes[start]
+    gain: Dict[V, float] = defaultdict(float)
+    for n, w in neighbours[start].items():
+        gain[n] += w
+    while first_size < total / 2:
+        candidates = [v for v in vertices if v not in first]
+        best = max(candidates, key=lambda v: (gain[v], -sizes[v]))
+        if first_size + sizes[best] > total / 2 + sizes[best] / 2:
+            break
+        first.add(best)
+        first_size += sizes[best]
+        for n, w in neighbours[best].items():
+            gain[n] += w
+
+    _refine(vertices, first, neighbours, sizes, total)
+    first_half = [v for v in vertices if v in first]
+    second_half = [v for v in vertices if v not in first]
+    if not first_half or not second_half:
+        # Nothing to cut between; split in the given order instead
+        middle = len(vertices) // 2
+        first_half, second_half = vertices[:middle], vertices[middle:]
+    return (_bisect(first_half, neighbours, sizes, capacity) +
+            _bisect(second_half, neighbours, sizes, capacity))
+
+
+def _refine(
+        vertices: List[V], first: Set[V],
+        neighbours: Mapping[V, Dict[V, float]], sizes: Mapping[V, int],
+        total: int):
+    """
+    Move single vertices between the halves while that cuts less traffic
+    and keeps the larger half no bigger than it was.
+    """
+    members = set(vertices)
+    for _ in range(_MAX_REFINE_PASSES):
+        first_size = sum(sizes[v] for v in first)
+        limit = max(first_size, total - first_size)
+        best_gain = 0.0
+        best_vertex = None
+        for v in vertices:
+            internal = external = 0.0
+            for n, w in neighbours[v].items():
+                if n not in members:
+                    continue
+                if (n in first) == (v in first):
+                    internal += w
+                else:
+                    external += w
+            new_first = first_size + (-sizes[v] if v in first else sizes[v])
+            if max(new_first, total - new_first) > limit:
+                continue
+            if external - internal > best_gain:
+                best_gain = external - internal
+                best_vertex = v
+        if best_vertex is None:
+            return
+        if best_vertex in first:
+            first.remove(best_vertex)
+        else:
+            first.add(best_vertex)
+
+
+def _estimated_cores(vertex: ApplicationVertex) -> int:
+    n_cores = math.ceil(vertex.n_atoms / vertex.get_max_atoms_per_core())
+    if (isinstance(vertex, AbstractPopulationVertex) and
+            isinstance(vertex.splitter,
+                       SplitterAbstractPopulationVertexNeuronsSynapses)):
+        n_cores *= 1 + vertex.splitter.n_synapse_vertices
+    return n_cores
+
+
+def traffic_placement_hints() -> None:
+    """
+    Fix the chip of the vertices that send each other the most spikes, so
+    that they are placed on the same or nearby chips.
+
+    Only populations and spike sources that send or receive spikes, with no
+    fixed location, and whose cores are expected to fit on a single chip,
+    are given one.  The machine must already be known, for
+    example by calling `get_machine()` before running.
+    """
+    if not SpynnakerDataView.has_machine():
+        logger.warning(
+            "Traffic placement hints need the machine before mapping; call "
+            "get_machine() before running to use them")
+        return
+    capacity = get_config_int("Mapping", "traffic_placement_cores_per_chip")
+    traffic = get_traffic_graph()
+    connected = {vertex for pair in traffic for vertex in pair}
+    sizes: Dict[ApplicationVertex, int] = dict()
+    for vertex in SpynnakerDataView.iterate_vertices():
+        if (vertex not in connected or
+                not isinstance(vertex, PopulationApplicationVertex) or
+                isinstance(vertex, (ApplicationSpiNNakerLinkVertex,
+                                    ApplicationFPGAVertex)) or
+                vertex.get_fixed_location() is not None):
+            continue
+        n_cores = _estimated_cores(vertex)
+        if n_cores <= capacity:
+            sizes[vertex] = n_cores
+    groups = partition_by_traffic(list(sizes), traffic, sizes, capacity)
+
+    # Give the groups chips in order out from the origin, so that groups
+    # near each other in the list are also near each other on the machine
+    chips = sorted(
+        SpynnakerDataView.get_machine().chips,
+        key=lambda chip: (chip.x + chip.y, chip.x))
+    if len(groups) > len(chips):
+        logger.warning(
+            "There are more groups of vertices ({}) than chips ({}), so no "
+            "traffic placement hints are given", len(groups), len(chips))
+        return
+    for group, chip in zip(groups, chips):
+        for vertex in group:
+            vertex.set_fixed_location(chip.x, chip.y)
@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+from typing import List, Optional, Tuple
 from spinn_utilities.abstract_base import AbstractBase, abstractmethod
 from spinn_utilities.require_subclass import require_subclass
 from pacman.model.graphs.machine import MachineVertex
@@ -90,3 +91,31 @@ class AbstractSynapseExpandable(object, metaclass=AbstractBase):
         :rtype: int
         """
         raise NotImplementedError
+
+    @abstractmethod
+    def get_generator_data_block(
+            self, placement: Placement) -> Tuple[int, int]:
+        """
+        Get the block of SDRAM that the synapse expander reads.
+
+        :param ~pacman.model.placements.Placement placement:
+            Where the data is on the machine
+        :return: The address and size of the block
+        :rtype: tuple(int, int)
+        """
+        raise NotImplementedError
+
+    @abstractmethod
+    def get_expanded_blocks(
+            self, placement: Placement) -> Optional[List[Tuple[int, int]]]:
+        """
+        Get the blocks of SDRAM that the synapse expander writes, which can be
+        saved and written again rather than being expanded again.
+
+        :param ~pacman.model.placements.Placement placement:
+            Where the data is on the machine
+        :return: The address and size of each block, or None if they can't
+            be saved
+        :rtype: list(tuple(int, int)) or None
+        """
+        raise NotImplementedError
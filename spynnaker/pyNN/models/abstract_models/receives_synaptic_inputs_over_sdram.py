@@ -15,7 +15,8 @@ from numpy import floating
 from numpy.typing import NDArray
 from spinn_utilities.abstract_base import AbstractBase, abstractmethod
 from pacman.model.graphs import AbstractSupportsSDRAMEdges
-from spinn_front_end_common.utilities.constants import BYTES_PER_SHORT
+from spinn_front_end_common.utilities.constants import (
+    BYTES_PER_SHORT, BYTES_PER_WORD)
 
 
 class ReceivesSynapticInputsOverSDRAM(
@@ -30,11 +31,17 @@ class ReceivesSynapticInputsOverSDRAM(
     for the second, and so on for each synapse type.  Each input is an
     accumulated weight value for the timestep, scaled with the given weight
     scales.
+
+    A synapse core also has a header after its inputs, so that it can send
+    only those that are not zero when there are few of them.
     """
 
     # The size of each input in bytes
     N_BYTES_PER_INPUT = BYTES_PER_SHORT
 
+    # The size of the header after the inputs of a synapse core in bytes
+    N_BYTES_FOR_SYNAPSE_HEADER = BYTES_PER_WORD
+
     @property
     @abstractmethod
     def weight_scales(self) -> NDArray[floating]:
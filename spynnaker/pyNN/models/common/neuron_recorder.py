@@ -74,6 +74,8 @@ class NeuronRecorder(object):
         "__n_neurons",
         "__sampling_rates",
         "__data_types",
+        "__recorded_data_types",
+        "__aggregations",
         "__bitfield_variables",
         "__per_timestep_variables",
         "__per_timestep_datatypes",
@@ -89,6 +91,29 @@ class NeuronRecorder(object):
     _N_BYTES_PER_RATE = BYTES_PER_WORD
     _N_BYTES_PER_ENUM = BYTES_PER_WORD
     _N_BYTES_PER_GEN_ITEM = BYTES_PER_WORD
+    _N_BYTES_PER_ENCODING = BYTES_PER_WORD
+
+    #: encoding of a variable recorded with the data type it is written in
+    _ENCODING_NONE = 0
+
+    #: encoding of a variable recorded as the mean and variance of the
+    #: neurons, to which the fractional bits of the data type are added
+    _ENCODING_MOMENTS = 0x100
+
+    #: encoding of a bitfield recorded as the number of bits set in each
+    #: sampling interval
+    _BITFIELD_ENCODING_COUNTS = 1
+
+    #: aggregation of a bitfield variable (such as spikes) into the number
+    #: of times each neuron set it in each sampling interval
+    COUNT = "count"
+
+    #: aggregation of a variable into the mean and variance of the values of
+    #: the recording neurons on each core
+    MEAN = "mean"
+
+    #: data type of the counts of a bitfield variable
+    COUNT_TYPE = DataType.UINT16
 
     #: size of a index in terms of position into recording array
     _N_BYTES_PER_INDEX = DataType.UINT16.size  # currently uint16
@@ -120,6 +145,31 @@ class NeuronRecorder(object):
     #: packets-per-timestep data type
     PACKETS_TYPE = DataType.UINT32
 
+    #: timer cycles spent per timestep in each phase of synapse processing,
+    #: in the order of the regions that record them
+    SYNAPSE_PHASES = (
+        "dma-wait-cycles", "row-processing-cycles", "write-back-cycles",
+        "transfer-cycles", "pop-table-lookup-cycles")
+
+    #: synapse phase cycles data type
+    SYNAPSE_PHASES_TYPE = DataType.UINT32
+
+    #: timer cycles spent per timestep in each phase of neuron processing,
+    #: in the order of the regions that record them
+    NEURON_PHASES = (
+        "synaptic-input-cycles", "neuron-transfer-cycles",
+        "neuron-update-cycles", "neuron-recording-cycles")
+
+    #: neuron phase cycles data type
+    NEURON_PHASES_TYPE = DataType.UINT32
+
+    #: timer cycles before the end of each timestep at which the synapse
+    #: inputs were transferred to the neuron core
+    TRANSFER_OFFSET = "transfer-offset-cycles"
+
+    #: transfer offset data type
+    TRANSFER_OFFSET_TYPE = DataType.UINT32
+
     #: rewiring
     REWIRING = "rewiring"
 
@@ -156,6 +206,8 @@ class NeuronRecorder(object):
         self.__sampling_rates: Dict[str, int] = dict()
         self.__indexes: Dict[str, Optional[Sequence[int]]] = dict()
         self.__data_types = data_types
+        self.__recorded_data_types: Dict[str, DataType] = dict()
+        self.__aggregations: Dict[str, str] = dict()
         self.__n_neurons = n_neurons
         self.__bitfield_variables = bitfield_variables
 
@@ -396,7 +448,12 @@ class NeuronRecorder(object):
         :param str variable:
         :rtype: BufferDataType
         """
-        if variable == self.SPIKES:
+        aggregation = self.__aggregations.get(variable)
+        if aggregation == self.MEAN:
+            return BufferDataType.MOMENTS
+        elif aggregation == self.COUNT:
+            return BufferDataType.MATRIX
+        elif variable == self.SPIKES:
             return BufferDataType.NEURON_SPIKES
         elif variable == self.REWIRING:
             return BufferDataType.REWIRES
@@ -413,10 +470,148 @@ class NeuronRecorder(object):
         """
         if variable in self.__per_timestep_variables:
             return self.__per_timestep_datatypes[variable]
+        if self.__aggregations.get(variable) == self.COUNT:
+            return self.COUNT_TYPE
+        if variable in self.__recorded_data_types:
+            return self.__recorded_data_types[variable]
         if variable in self.__data_types:
             return self.__data_types[variable]
         return None
 
+    def set_recorded_data_type(self, variable: str, data_type: DataType):
+        """
+        Record a variable with a smaller data type than the one it is
+        written in by the neuron model, to use less recording space.
+
+        The values are converted on the core by dropping fractional bits
+        and saturating to the range of the new type, so the new type must
+        be a 16-bit signed type with no more fractional bits than the
+        original 32-bit signed type (such as `DataType.S87` for a variable
+        written as `DataType.S1615`).
+
+        :param str variable: The variable to record with the data type
+        :param ~data_specification.enums.DataType data_type:
+            The data type to record with
+        :raises ConfigurationException:
+            If the variable can't be recorded with the data type
+        """
+        if variable not in self.__data_types:
+            raise ConfigurationException(
+                f"The data type of {variable} can't be changed")
+        if data_type == self.__data_types[variable]:
+            self.__recorded_data_types.pop(variable, None)
+            return
+        if variable in self.__aggregations:
+            raise ConfigurationException(
+                f"{variable} can't be recorded with a smaller data type as "
+                "it is aggregated")
+        self.__narrowing_shift(self.__data_types[variable], data_type)
+        self.__recorded_data_types[variable] = data_type
+
+    def get_aggregation(self, variable: str) -> Optional[str]:
+        """
+        Get how the values of a variable are aggregated on the cores.
+
+        :param str variable:
+        :return: The aggregation, or `None` if each value is recorded
+        :rtype: str or None
+        """
+        return self.__aggregations.get(variable)
+
+    def set_aggregation(self, variable: str, aggregation: Optional[str]):
+        """
+        Aggregate the values of a variable on each core before recording
+        them, to use much less recording space.
+
+        A bitfield variable (such as spikes) can be aggregated by
+        :py:attr:`COUNT`, which records how many times each neuron set it in
+        each sampling interval, saturating at 65535.  A variable written as a
+        32-bit signed type can be aggregated by :py:attr:`MEAN`, which
+        records the mean and variance of the recording neurons of each core
+        at each sample; these are combined over the cores when read.
+
+        :param str variable: The variable to aggregate
+        :param aggregation: The aggregation, or `None` to record each value
+        :type aggregation: str or None
+        :raises ConfigurationException:
+            If the variable can't be aggregated that way
+        """
+        if aggregation is None:
+            self.__aggregations.pop(variable, None)
+            return
+        if aggregation == self.COUNT:
+            if variable not in self.__bitfield_variables:
+                raise ConfigurationException(
+                    f"Only {self.__bitfield_variables} can be aggregated by "
+                    f"{self.COUNT}, not {variable}")
+        elif aggregation == self.MEAN:
+            if variable not in self.__data_types:
+                raise ConfigurationException(
+                    f"{variable} can't be aggregated by {self.MEAN}")
+            if self.__data_types[variable].struct_encoding != "i":
+                raise ConfigurationException(
+                    f"Only values written as 32-bit signed types can be "
+                    f"aggregated by {self.MEAN}, not {variable}")
+            if variable in self.__recorded_data_types:
+                raise ConfigurationException(
+                    f"{variable} can't be aggregated as it is recorded with "
+                    "a smaller data type")
+        else:
+            raise ConfigurationException(
+                f"Unknown aggregation {aggregation}; use {self.COUNT} or "
+                f"{self.MEAN}")
+        self.__aggregations[variable] = aggregation
+
+    @staticmethod
+    def __narrowing_shift(written_type: DataType, data_type: DataType) -> int:
+        """
+        Get the number of bits to shift a value of one type right by to get
+        the value in another narrower type.
+
+        :param ~data_specification.enums.DataType written_type:
+        :param ~data_specification.enums.DataType data_type:
+        :rtype: int
+        :raises ConfigurationException: If the types can't be converted
+        """
+        if written_type.struct_encoding != "i":
+            raise ConfigurationException(
+                f"Only values written as 32-bit signed types can be recorded "
+                f"with a smaller type, not {written_type}")
+        if data_type.struct_encoding != "h":
+            raise ConfigurationException(
+                f"Values can only be recorded with a 16-bit signed type, "
+                f"not {data_type}")
+        ratio = written_type.scale / data_type.scale
+        shift = int(round(math.log2(ratio))) if ratio >= 1 else -1
+        if shift < 0 or 2 ** shift != ratio:
+            raise ConfigurationException(
+                f"Values of {written_type} can't be recorded as {data_type}"
+                " as it does not have fewer fractional bits")
+        return shift
+
+    def __encoding(self, variable: str) -> int:
+        """
+        Get how the core should encode the values of a variable when
+        recording them.
+
+        :param str variable:
+        :return: 0 for no encoding, 1 + the number of bits to shift right
+            before saturating to 16 bits, or the moments encoding + the
+            number of fractional bits of the values
+        :rtype: int
+        """
+        if variable in self.__bitfield_variables:
+            if self.__aggregations.get(variable) == self.COUNT:
+                return self._BITFIELD_ENCODING_COUNTS
+            return self._ENCODING_NONE
+        if self.__aggregations.get(variable) == self.MEAN:
+            return self._ENCODING_MOMENTS + int(round(math.log2(
+                self.__data_types[variable].scale)))
+        if variable not in self.__recorded_data_types:
+            return self._ENCODING_NONE
+        return 1 + self.__narrowing_shift(
+            self.__data_types[variable], self.__recorded_data_types[variable])
+
     def get_recordable_variables(self) -> List[str]:
         """
         :rtype: list(str)
@@ -831,14 +1026,22 @@ class NeuronRecorder(object):
                 self._N_BYTES_FOR_TIMESTAMP + size)
         if n_neurons == 0:
             return 0
+        aggregation = self.__aggregations.get(variable)
+        if aggregation == self.COUNT:
+            return self._N_BYTES_FOR_TIMESTAMP + (
+                n_neurons * self.COUNT_TYPE.size)
+        if aggregation == self.MEAN:
+            return self._N_BYTES_FOR_TIMESTAMP + (
+                2 * self.__data_types[variable].size)
         if variable in self.__bitfield_variables:
             # Overflow can be ignored as it is not save if in an extra word
             out_spike_words = int(math.ceil(n_neurons / BITS_PER_WORD))
             out_spike_bytes = out_spike_words * BYTES_PER_WORD
             return self._N_BYTES_FOR_TIMESTAMP + out_spike_bytes
         else:
-            size = self.__data_types[variable].size
-            return self._N_BYTES_FOR_TIMESTAMP + (n_neurons * size)
+            data_type = self.get_data_type(variable)
+            assert data_type is not None
+            return self._N_BYTES_FOR_TIMESTAMP + (n_neurons * data_type.size)
 
     def get_buffered_sdram_per_record(
             self, variable: str, vertex_slice: Slice) -> int:
@@ -971,11 +1174,12 @@ class NeuronRecorder(object):
         n_bytes_for_indices = n_indices * self._N_BYTES_PER_INDEX
         var_bytes = (
             (self._N_BYTES_PER_RATE + self._N_BYTES_PER_SIZE +
-             self._N_BYTES_PER_ENUM + n_bytes_for_indices) *
+             self._N_BYTES_PER_ENUM + self._N_BYTES_PER_ENCODING +
+             n_bytes_for_indices) *
             (len(self.__sampling_rates) - len(self.__bitfield_variables)))
         bitfield_bytes = (
             (self._N_BYTES_PER_RATE + self._N_BYTES_PER_SIZE +
-             n_bytes_for_indices) *
+             self._N_BYTES_PER_ENCODING + n_bytes_for_indices) *
             len(self.__bitfield_variables))
         return ((self._N_ITEM_TYPES * DataType.UINT32.size) + var_bytes +
                 bitfield_bytes)
@@ -991,12 +1195,13 @@ class NeuronRecorder(object):
         n_bytes_for_indices = n_indices * self._N_BYTES_PER_INDEX
         var_bytes = (
             (self._N_BYTES_PER_RATE + self._N_BYTES_PER_SIZE +
-             self._N_BYTES_PER_ENUM + self._N_BYTES_PER_GEN_ITEM +
-             n_bytes_for_indices) *
+             self._N_BYTES_PER_ENUM + self._N_BYTES_PER_ENCODING +
+             self._N_BYTES_PER_GEN_ITEM + n_bytes_for_indices) *
             (len(self.__sampling_rates) - len(self.__bitfield_variables)))
         bitfield_bytes = (
             (self._N_BYTES_PER_RATE + self._N_BYTES_PER_SIZE +
-             self._N_BYTES_PER_GEN_ITEM + n_bytes_for_indices) *
+             self._N_BYTES_PER_ENCODING + self._N_BYTES_PER_GEN_ITEM +
+             n_bytes_for_indices) *
             len(self.__bitfield_variables))
         return ((self._N_ITEM_TYPES * DataType.UINT32.size) + var_bytes +
                 bitfield_bytes)
@@ -1123,11 +1328,14 @@ class NeuronRecorder(object):
             rate, n_recording = self._rate_and_count_per_slice(
                 variable, vertex_slice)
             if variable in self.__bitfield_variables:
-                data.append(numpy.array([rate, n_recording], dtype=uint32))
+                data.append(numpy.array(
+                    [rate, n_recording, self.__encoding(variable)],
+                    dtype=uint32))
             else:
                 dtype = self.__data_types[variable]
                 data.append(numpy.array(
-                    [rate, n_recording, dtype.size], dtype=uint32))
+                    [rate, n_recording, dtype.size, self.__encoding(variable)],
+                    dtype=uint32))
             self.__add_indices(data, variable, rate, n_recording, vertex_slice)
 
         return numpy.concatenate(data)
@@ -1171,9 +1379,11 @@ class NeuronRecorder(object):
         for variable in self.__sampling_rates:
             rate = self.__sampling_rates[variable]
             if variable in self.__bitfield_variables:
-                data.append(rate)
+                data.extend([rate, self.__encoding(variable)])
             else:
-                data.extend([rate, self.__data_types[variable].size])
+                data.extend([
+                    rate, self.__data_types[variable].size,
+                    self.__encoding(variable)])
             if rate == 0:
                 data.extend([0, 0])
             else:
@@ -29,7 +29,8 @@ _GENERATOR_TYPES = {
     DataType.S1615: 0,
     DataType.UINT32: 1,
     DataType.INT32: 2,
-    DataType.U032: 3
+    DataType.U032: 3,
+    DataType.U1616: 4
 }
 
 
@@ -67,7 +68,8 @@ PARAM_TYPE_BY_NAME = {
     "normal_clipped": 3,
     "normal_clipped_to_boundary": 4,
     "exponential": 5,
-    "exponential_clipped": 6
+    "exponential_clipped": 6,
+    "lognormal": 7
 }
 
 _ParamType: TypeAlias = Union[int, float, RandomDistribution]
@@ -354,6 +354,38 @@ class PopulationApplicationVertex(ApplicationVertex, HasCustomAtomKeyMap):
             f"{type(self)} has recording variables so should implement "
             f"get_data_type")
 
+    def set_recorded_data_type(self, name: str, data_type: DataType):
+        """
+        Record a variable with a different (smaller) data type than the
+        one the C code writes it in, to use less recording space.
+
+        :param str name: The name of the variable to set the type of
+        :param ~data_specification.enums.DataType data_type:
+            The data type to record the variable with
+        :raise KeyError: If the variable isn't recordable
+        """
+        if name not in self.get_recordable_variables():
+            raise KeyError(f"{name} is not being recorded")
+        raise NotImplementedError(
+            f"{type(self)} does not support changing the data type of "
+            f"{name}")
+
+    def set_recording_aggregation(
+            self, name: str, aggregation: Optional[str]):
+        """
+        Aggregate the values of a variable on the machine before recording
+        them, to use less recording space.
+
+        :param str name: The name of the variable to aggregate
+        :param aggregation: How to aggregate it, or `None` to not
+        :type aggregation: str or None
+        :raise KeyError: If the variable isn't recordable
+        """
+        if name not in self.get_recordable_variables():
+            raise KeyError(f"{name} is not being recorded")
+        raise NotImplementedError(
+            f"{type(self)} does not support aggregating {name}")
+
     def get_recording_region(self, name: str) -> int:
         """
         Gets the recording region for the named variable.
@@ -12,12 +12,16 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import struct
 from typing import Dict, Mapping
 from spinn_utilities.overrides import overrides
+from spinnman.messages.sdp import SDPFlag, SDPHeader, SDPMessage
 from spinn_front_end_common.interface.ds import DataType
 from spinn_front_end_common.utilities.constants import BYTES_PER_WORD
 from spynnaker.pyNN.data import SpynnakerDataView
 from spynnaker.pyNN.exceptions import SpynnakerException
+from spynnaker.pyNN.utilities.constants import (
+    LIVE_PARAMETERS_SDP_PORT, LIVE_SET_DC_AMPLITUDE)
 from .abstract_current_source import (
     AbstractCurrentSource, CurrentSourceIDs, CurrentParameter)
 
@@ -75,6 +79,47 @@ class DCSource(AbstractCurrentSource):
             for m_vertex in self.app_vertex.machine_vertices:
                 m_vertex.set_reload_required(True)
 
+    def set_live_amplitude(self, amplitude: float):
+        """
+        Set the amplitude of the source while the simulation is running,
+        without pausing it.  Each core uses the new amplitude from the first
+        time step that starts after it gets it.
+
+        .. note::
+            This needs the neuron binaries to be built with
+            ``NEURON_LIVE_PARAMETERS=1``; other binaries ignore the change.
+
+        :param float amplitude: The new amplitude
+        """
+        self.__parameters['amplitude'] = amplitude
+        if (self.app_vertex is None or
+                not SpynnakerDataView.has_transceiver()):
+            # Not on the machine yet, so the amplitude is written on load
+            return
+
+        # Avoid circular import
+        # pylint: disable=import-outside-toplevel
+        from spynnaker.pyNN.models.neuron.population_machine_neurons import (
+            PopulationMachineNeurons)
+        txrx = SpynnakerDataView.get_transceiver()
+        value = int(DataType.S1615.encode_as_int(amplitude))
+        for m_vertex in self.app_vertex.machine_vertices:
+            if not isinstance(m_vertex, PopulationMachineNeurons):
+                continue
+            index = m_vertex.get_current_source_index(self)
+            if index is None:
+                continue
+            placement = SpynnakerDataView.get_placement_of_vertex(m_vertex)
+            header = SDPHeader(
+                flags=SDPFlag.REPLY_NOT_EXPECTED,
+                destination_port=LIVE_PARAMETERS_SDP_PORT,
+                destination_cpu=placement.p,
+                destination_chip_x=placement.x,
+                destination_chip_y=placement.y)
+            data = struct.pack(
+                "<HHIIIIi", LIVE_SET_DC_AMPLITUDE, 0, 1, 0, 0, index, value)
+            txrx.send_sdp_message(SDPMessage(header, data))
+
     @property
     @overrides(AbstractCurrentSource.parameters)
     def parameters(self) -> Mapping[str, CurrentParameter]:
@@ -402,12 +402,8 @@ class AbstractConnector(object, metaclass=AbstractBase):
         :param ~pacman.model.graphs.common.Slice post_vertex_slice:
         :rtype: ~numpy.ndarray
         """
-        key = (id(post_vertex_slice), id(values))
-        seed = self.__param_seeds.get(key, None)
-        if seed is None:
-            seed = int(values.rng.next() * 0x7FFFFFFF)
-            self.__param_seeds[key] = seed
-        new_rng = NumpyRNG(seed)
+        new_rng = NumpyRNG(self.__get_block_seed(
+            post_vertex_slice, values, values.rng))
         copy_rd = RandomDistribution(
             values.name, parameters_pos=None, rng=new_rng,
             **values.parameters)
@@ -415,6 +411,97 @@ class AbstractConnector(object, metaclass=AbstractBase):
             return numpy.array([copy_rd.next(1)], dtype=float64)
         return copy_rd.next(n_connections)
 
+    def __get_block_seed(
+            self, post_vertex_slice: Slice, owner: object,
+            rng: NumpyRNG) -> int:
+        """
+        Get the seed of the values drawn by an owner for a slice, drawing
+        it from the owner's RNG the first time it is asked for.
+
+        :param ~pacman.model.graphs.common.Slice post_vertex_slice:
+        :param owner: What the values are drawn for
+        :param ~pyNN.random.NumpyRNG rng: Where to draw the seed from
+        :rtype: int
+        """
+        key = (id(post_vertex_slice), id(owner))
+        seed = self.__param_seeds.get(key, None)
+        if seed is None:
+            seed = int(rng.next() * 0x7FFFFFFF)
+            self.__param_seeds[key] = seed
+        return seed
+
+    def _reserve_block_seed(
+            self, rng: Optional[NumpyRNG], post_vertex_slice: Slice):
+        """
+        Draw the seed of the connections of one post-vertex slice from the
+        given RNG.
+
+        :param rng: The RNG of the connector, or `None` if not seeded
+        :type rng: ~pyNN.random.NumpyRNG or None
+        :param ~pacman.model.graphs.common.Slice post_vertex_slice:
+        """
+        if rng is not None:
+            self.__get_block_seed(post_vertex_slice, rng, rng)
+
+    def _get_reserved_block_rng(
+            self, rng: Optional[NumpyRNG],
+            post_vertex_slice: Slice) -> Optional[NumpyRNG]:
+        """
+        Get an RNG for the connections of one post-vertex slice, seeded
+        with the seed reserved for it, so that each slice gets the same
+        connections whatever order the slices are generated in.
+
+        :param rng: The RNG of the connector, or `None` if not seeded
+        :type rng: ~pyNN.random.NumpyRNG or None
+        :param ~pacman.model.graphs.common.Slice post_vertex_slice:
+        :return: The RNG, or `None` if no seed was reserved for the slice
+        :rtype: ~pyNN.random.NumpyRNG or None
+        """
+        if rng is None:
+            return None
+        seed = self.__param_seeds.get((id(post_vertex_slice), id(rng)), None)
+        if seed is None:
+            return None
+        return NumpyRNG(seed)
+
+    def _get_block_rng(
+            self, rng: Optional[NumpyRNG],
+            post_vertex_slice: Slice) -> NumpyRNG:
+        """
+        Get an RNG for the connections of one post-vertex slice.  This is
+        seeded with the seed reserved for the slice if there is one, or is
+        otherwise the given RNG itself, so that blocks generated one at a
+        time draw from a single stream.
+
+        :param rng: The RNG of the connector, or `None` if not seeded
+        :type rng: ~pyNN.random.NumpyRNG or None
+        :param ~pacman.model.graphs.common.Slice post_vertex_slice:
+        :rtype: ~pyNN.random.NumpyRNG
+        """
+        block_rng = self._get_reserved_block_rng(rng, post_vertex_slice)
+        if block_rng is not None:
+            return block_rng
+        if rng is None:
+            return NumpyRNG()
+        return rng
+
+    def reserve_block_seeds(
+            self, post_slices: Sequence[Slice], post_vertex_slice: Slice,
+            synapse_info: SynapseInformation):
+        """
+        Draw the seeds of the random values of the synaptic block of a
+        post-vertex slice ahead of creating it.  Once this has been done for
+        all slices (in a fixed order), the blocks can be created in any
+        order, including concurrently, and still get the same values.
+
+        :param list(~pacman.model.graphs.common.Slice) post_slices:
+        :param ~pacman.model.graphs.common.Slice post_vertex_slice:
+        :param SynapseInformation synapse_info:
+        """
+        for values in (synapse_info.weights, synapse_info.delays):
+            if isinstance(values, RandomDistribution):
+                self.__get_block_seed(post_vertex_slice, values, values.rng)
+
     def _no_space_exception(self, values: Weight_Delay_Types, synapse_info):
         """
         Returns a SpynnakerException about there being no space defined
@@ -38,6 +38,7 @@ from .abstract_generate_connector_on_host import (
     AbstractGenerateConnectorOnHost)
 
 if TYPE_CHECKING:
+    from pacman.model.graphs.common import Slice
     from spynnaker.pyNN.models.neural_projections import (
         ProjectionApplicationEdge, SynapseInformation)
 
@@ -55,6 +56,10 @@ class ConnectorIDs(Enum):
     KERNEL_CONNECTOR = 6
     ALL_BUT_ME_CONNECTOR = 7
     ONE_TO_ONE_OFFSET_CONNECTOR = 8
+    FROM_LIST_CONNECTOR = 9
+    DISTANCE_DEPENDENT_CONNECTOR = 10
+    INDEX_BASED_CONNECTOR = 11
+    SMALL_WORLD_CONNECTOR = 12
 
 
 class AbstractGenerateConnectorOnMachine(
@@ -167,21 +172,28 @@ class AbstractGenerateConnectorOnMachine(
         raise NotImplementedError
 
     def gen_connector_params(
-            self, synapse_info: SynapseInformation) -> NDArray[uint32]:
+            self, synapse_info: SynapseInformation,
+            post_vertex_slice: Slice) -> NDArray[uint32]:
         """
-        Get the parameters of the on machine generation.
+        Get the parameters of the on machine generation for a slice of the
+        post-vertex.
 
         :param SynapseInformation synapse_info: The synaptic information
+        :param ~pacman.model.graphs.common.Slice post_vertex_slice:
+            The slice of the post-vertex the parameters are for
         :rtype: ~numpy.ndarray(uint32)
         """
         # pylint: disable=unused-argument
         return numpy.zeros(0, dtype="uint32")
 
-    @property
-    def gen_connector_params_size_in_bytes(self) -> int:
+    def gen_connector_params_size_in_bytes(
+            self, synapse_info: SynapseInformation) -> int:
         """
-        The size of the connector parameters, in bytes.
+        The size of the connector parameters of any one slice of the
+        post-vertex, in bytes.
 
+        :param SynapseInformation synapse_info: The synaptic information
         :rtype: int
         """
+        # pylint: disable=unused-argument
         return 0
@@ -239,7 +239,8 @@ class AllButMeConnector(AbstractGenerateConnectorOnMachine,
 
     @overrides(AbstractGenerateConnectorOnMachine.gen_connector_params)
     def gen_connector_params(
-            self, synapse_info: SynapseInformation) -> NDArray[uint32]:
+            self, synapse_info: SynapseInformation,
+            post_vertex_slice: Slice) -> NDArray[uint32]:
         n_values = self.__n_neurons_per_group
         if n_values is None:
             n_values = min(synapse_info.n_pre_neurons,
@@ -252,10 +253,10 @@ class AllButMeConnector(AbstractGenerateConnectorOnMachine,
             weights = DataType.S1615.encode_as_numpy_int_array(self.__weights)
         return numpy.concatenate((params, weights))
 
-    @property
     @overrides(
         AbstractGenerateConnectorOnMachine.gen_connector_params_size_in_bytes)
-    def gen_connector_params_size_in_bytes(self) -> int:
+    def gen_connector_params_size_in_bytes(
+            self, synapse_info: SynapseInformation) -> int:
         size = BYTES_PER_WORD * 2
         if self.__weights is not None:
             size += len(self.__weights) * BYTES_PER_WORD
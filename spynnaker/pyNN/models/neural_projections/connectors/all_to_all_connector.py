@@ -164,14 +164,15 @@ class AllToAllConnector(AbstractGenerateConnectorOnMachine,
 
     @overrides(AbstractGenerateConnectorOnMachine.gen_connector_params)
     def gen_connector_params(
-            self, synapse_info: SynapseInformation) -> NDArray[uint32]:
+            self, synapse_info: SynapseInformation,
+            post_vertex_slice: Slice) -> NDArray[uint32]:
         allow_self = (
             self.__allow_self_connections or
             synapse_info.pre_population != synapse_info.post_population)
         return numpy.array([int(allow_self)], dtype=uint32)
 
-    @property
     @overrides(
         AbstractGenerateConnectorOnMachine.gen_connector_params_size_in_bytes)
-    def gen_connector_params_size_in_bytes(self) -> int:
+    def gen_connector_params_size_in_bytes(
+            self, synapse_info: SynapseInformation) -> int:
         return BYTES_PER_WORD
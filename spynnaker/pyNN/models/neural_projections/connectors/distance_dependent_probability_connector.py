@@ -13,32 +13,44 @@
 # limitations under the License.
 
 from __future__ import annotations
+from dataclasses import dataclass
 import math
-from typing import Optional, Sequence, TYPE_CHECKING
+import re
+from typing import Optional, Sequence, Tuple, TYPE_CHECKING
 
 import numpy
 from numpy import (
     arccos, arcsin, arctan, arctan2, ceil, cos, cosh, exp, fabs, floor, fmod,
     hypot, ldexp, log, log10, modf, power, sin, sinh, sqrt, tan, tanh, maximum,
     minimum, e, pi, floating)
+from numpy import uint32
 from numpy.typing import NDArray
 
 from pyNN.random import NumpyRNG
+from pyNN.space import Space
 
 from spinn_utilities.overrides import overrides
 from spinn_utilities.safe_eval import SafeEval
 
 from pacman.model.graphs.common import Slice
 
+from spinn_front_end_common.interface.ds import DataType
+from spinn_front_end_common.utilities.constants import BYTES_PER_WORD
+
+from spynnaker.pyNN.utilities.expression_compiler import (
+    CompiledExpression, compile_expression)
 from spynnaker.pyNN.utilities.utility_calls import (
-    get_probable_maximum_selected, get_probable_minimum_selected)
+    get_probable_maximum_selected, get_probable_minimum_selected, check_rng)
 
 from .abstract_connector import AbstractConnector
 from .abstract_generate_connector_on_host import (
     AbstractGenerateConnectorOnHost)
+from .abstract_generate_connector_on_machine import (
+    AbstractGenerateConnectorOnMachine, ConnectorIDs)
 
 if TYPE_CHECKING:
-    from spynnaker.pyNN.models.neural_projections import SynapseInformation
+    from spynnaker.pyNN.models.neural_projections import (
+        ProjectionApplicationEdge, SynapseInformation)
 
 # support for arbitrary expression for the distance dependence
 _d_expr_context = SafeEval(math, numpy, arccos, arcsin, arctan, arctan2, ceil,
@@ -46,16 +58,202 @@ _d_expr_context = SafeEval(math, numpy, arccos, arcsin, arctan, arctan2, ceil,
                            log, log10, modf, power, sin, sinh, sqrt, tan, tanh,
                            maximum, minimum, e=e, pi=pi)
 
+# The families of distance expression that can be generated on the machine,
+# and the kind of any other expression that has been compiled
+_STEP, _EXPONENTIAL, _GAUSSIAN, _EXPRESSION = range(4)
+
+# Patterns of the families, with white space removed
+_NUMBER = r"(\d+(?:\.\d*)?(?:[eE][-+]?\d+)?|\.\d+)"
+_AMPLITUDE = rf"(?:{_NUMBER}\*)?"
+_D = r"(?:d|abs\(d\))"
+_STEP_RE = re.compile(rf"^{_AMPLITUDE}\(?{_D}(<=?){_NUMBER}\)?$")
+_EXPONENTIAL_RE = re.compile(
+    rf"^{_AMPLITUDE}exp\(-{_D}(?:/{_NUMBER})?\)$")
+_GAUSSIAN_RE = re.compile(
+    rf"^{_AMPLITUDE}exp\(-\(?{_D}\*\*2\)?/\(2\*{_NUMBER}\*\*2\)\)$")
+
+# The largest scaled coordinate sent to the machine, chosen so that the
+# squared distance between any two neurons fits in an accum
+_MAX_SCALED = 128.0
+
+# The smallest step between accum values
+_ACCUM_RESOLUTION = 2.0 ** -15
+
+# The largest exponent used; the probability beyond this is taken to be 0
+_MAX_EXPONENT = 16.0
+
+# The number of distances at which a compiled expression is checked
+_N_CHECKED_DISTANCES = 257
+
+#: The number of words in the layout of each population
+N_LATTICE_WORDS = 10
+
+# The number of words in the parameters on the machine
+_N_GEN_PARAMS = 5 + (2 * N_LATTICE_WORDS)
+
+
+@dataclass(frozen=True)
+class _DistanceFamily:
+    """
+    A distance expression that can be evaluated on the machine.
+    """
+    kind: int
+    amplitude: float
+    scale: float
+    inclusive: bool = False
+
+    def probabilities(self, d: NDArray[floating]) -> NDArray[floating]:
+        """
+        Evaluate the expression on the host.
+        """
+        if self.kind == _STEP:
+            inside = (d <= self.scale) if self.inclusive else (d < self.scale)
+            return self.amplitude * inside
+        if self.kind == _EXPONENTIAL:
+            return self.amplitude * numpy.exp(-d / self.scale)
+        return self.amplitude * numpy.exp(-(d ** 2) / (2 * self.scale ** 2))
+
+
+def _parse_d_expression(d_expression: str) -> Optional[_DistanceFamily]:
+    """
+    Work out if a distance expression is one of those that can be
+    evaluated on the machine.
+
+    :param str d_expression:
+    :rtype: _DistanceFamily or None
+    """
+    text = "".join(d_expression.split())
+    family = None
+    match = _STEP_RE.match(text)
+    if match:
+        amplitude, op, radius = match.groups()
+        family = _DistanceFamily(
+            _STEP, float(amplitude or 1.0), float(radius), op == "<=")
+    for kind, regex in ((_EXPONENTIAL, _EXPONENTIAL_RE),
+                        (_GAUSSIAN, _GAUSSIAN_RE)):
+        match = regex.match(text)
+        if match:
+            amplitude, scale = match.groups()
+            family = _DistanceFamily(
+                kind, float(amplitude or 1.0), float(scale or 1.0))
+    if family is None or family.scale <= 0 or not (
+            0 < family.amplitude <= 1):
+        return None
+
+    # Make sure the expression really does match, in case it was misread
+    d = numpy.linspace(0.0, 4.0 * family.scale, 41)
+    try:
+        probs = _d_expr_context.eval(d_expression, d=d)
+    except Exception:  # pylint: disable=broad-except
+        return None
+    if not numpy.allclose(probs, family.probabilities(d)):
+        return None
+    return family
+
+
+def _get_lattice(positions: NDArray[floating]) -> Optional[
+        Tuple[NDArray[floating], NDArray[floating], NDArray[floating], int]]:
+    """
+    Work out if positions are on a regular grid, where the position of
+    neuron ``i`` is ``origin + (i // n_minor) * major + (i % n_minor) * minor``
+
+    :param ~numpy.ndarray positions: The positions, one row per neuron
+    :return: The origin, major step, minor step and minor count, or None
+        if the positions are not on a grid
+    """
+    n_atoms = len(positions)
+    origin = positions[0]
+    zero = numpy.zeros_like(origin)
+    if n_atoms == 1:
+        return origin, zero, zero, 1
+    minor = positions[1] - origin
+    index = numpy.arange(n_atoms)
+
+    # The first row ends at the first position off the line of the minor step
+    off_line = numpy.flatnonzero(~numpy.all(numpy.isclose(
+        positions, origin + numpy.outer(index, minor)), axis=1))
+    if len(off_line) == 0:
+        return origin, zero, minor, n_atoms
+    n_minor = int(off_line[0])
+    major = positions[n_minor] - origin
+    rows, cols = numpy.divmod(index, n_minor)
+    expected = (origin + numpy.outer(rows, major) +
+                numpy.outer(cols, minor))
+    if not numpy.allclose(positions, expected):
+        return None
+    return origin, major, minor, n_minor
+
+
+def get_grid_layout(
+        space: Optional[Space], synapse_info: SynapseInformation) -> Optional[
+            Tuple[float, float, NDArray[uint32]]]:
+    """
+    Get the layout of the populations of a projection to send to the
+    machine, for connectors that depend on distance (see ``lattice.h``).
+
+    :param ~pyNN.space.Space space: The space of the connector
+    :param SynapseInformation synapse_info:
+    :return: The largest difference between positions in any one axis, the
+        length by which the positions are divided, and the layout of the
+        pre- and post-populations, or None if the populations can't be
+        laid out on the machine
+    """
+    if (space is None or space.periodic_boundaries is not None or
+            space.scale_factor != 1.0 or numpy.any(space.offset != 0)):
+        return None
+    # Views don't start at the start of the grid
+    if synapse_info.prepop_is_view or synapse_info.postpop_is_view:
+        return None
+    if (synapse_info.pre_population.structure is None or
+            synapse_info.post_population.structure is None):
+        return None
+
+    # Only the axes used by the space count towards the distance
+    axes = numpy.zeros(3)
+    axes[space.axes] = 1.0
+    pre_positions = synapse_info.pre_population.positions * axes
+    post_positions = synapse_info.post_population.positions * axes
+    pre_lattice = _get_lattice(pre_positions)
+    post_lattice = _get_lattice(post_positions)
+    if pre_lattice is None or post_lattice is None:
+        return None
+
+    # Move and scale the positions so they fit in an accum
+    low = numpy.minimum(numpy.min(pre_positions, axis=0),
+                        numpy.min(post_positions, axis=0))
+    high = numpy.maximum(numpy.max(pre_positions, axis=0),
+                         numpy.max(post_positions, axis=0))
+    extent = float(numpy.max(high - low))
+    length = extent / _MAX_SCALED if extent > 0 else 1.0
+    data = []
+    for origin, major, minor, n_minor in (pre_lattice, post_lattice):
+        data.append(DataType.S1615.encode_as_numpy_int_array(
+            numpy.concatenate(
+                ((origin - low) / length, major / length,
+                 minor / length))).astype(uint32))
+        data.append(numpy.array([n_minor], dtype=uint32))
+    return extent, length, numpy.concatenate(data)
+
 
 class DistanceDependentProbabilityConnector(
-        AbstractConnector, AbstractGenerateConnectorOnHost):
+        AbstractGenerateConnectorOnMachine, AbstractGenerateConnectorOnHost):
     """
     Make connections using a distribution which varies with distance.
+
+    .. note::
+        Expressions of the form ``A * (d < R)``, ``A * exp(-d / L)`` or
+        ``A * exp(-d**2 / (2 * S**2))`` between populations laid out on a
+        regular grid can be generated on the machine, as can other
+        expressions using only arithmetic, ``exp``, ``sqrt``, ``abs``,
+        ``min``, ``max`` and comparisons.
     """
 
     __slots__ = (
         "__allow_self_connections",
+        "__compiled",
         "__d_expression",
+        "__family",
+        "__layout",
         "__probs",
         "__rng")
 
@@ -97,24 +295,37 @@ class DistanceDependentProbabilityConnector(
         # pylint: disable=too-many-arguments
         super().__init__(safe, callback, verbose)
         self.__d_expression = d_expression
+        self.__family = _parse_d_expression(d_expression)
+        self.__compiled = self.__compile(d_expression)
         self.__allow_self_connections = allow_self_connections
         self.__rng = rng or NumpyRNG()
         self.__probs: Optional[NDArray[floating]] = None
+        self.__layout: Optional[Tuple[float, NDArray[uint32]]] = None
         if n_connections is not None:
             raise NotImplementedError(
                 "n_connections is not implemented for"
                 " DistanceDependentProbabilityConnector on this platform")
 
+    def __compile(self, d_expression: str) -> Optional[CompiledExpression]:
+        """
+        Compile an expression that isn't one of the families.
+        """
+        if self.__family is not None:
+            return None
+        return compile_expression(d_expression, ("d", ))
+
     @overrides(AbstractConnector.set_projection_information)
     def set_projection_information(self, synapse_info: SynapseInformation):
         super().set_projection_information(synapse_info)
-        self._set_probabilities(synapse_info)
+        # The probabilities are only worked out if needed, as there is one
+        # for every pair of neurons
+        self.__probs = None
+        self.__layout = self.__get_layout(synapse_info)
 
     def _set_probabilities(self, synapse_info: SynapseInformation):
         """
         :param SynapseInformation synapse_info:
         """
-        # Set the probabilities up-front for now
         # TODO: Work out how this can be done statistically
         expand_distances = self._expand_distances(self.__d_expression)
         pre_positions = synapse_info.pre_population.positions
@@ -136,12 +347,77 @@ class DistanceDependentProbabilityConnector(
 
         self.__probs = _d_expr_context.eval(self.__d_expression, d=d)
 
-    @property
-    def _probs(self) -> NDArray[floating]:
+    def _get_probs(
+            self, synapse_info: SynapseInformation) -> NDArray[floating]:
+        """
+        :param SynapseInformation synapse_info:
+        :rtype: ~numpy.ndarray
+        """
         if self.__probs is None:
-            raise ValueError("no projection information set")
+            self._set_probabilities(synapse_info)
+        assert self.__probs is not None
         return self.__probs
 
+    def __max_prob(self, synapse_info: SynapseInformation) -> float:
+        # On the machine, avoid working out every probability on host
+        if self.__family is not None and self.generate_on_machine(
+                synapse_info):
+            return self.__family.amplitude
+        return float(numpy.amax(self._get_probs(synapse_info)))
+
+    def __get_layout(self, synapse_info: SynapseInformation) -> Optional[
+            Tuple[float, NDArray[uint32]]]:
+        """
+        Get the layout of the populations to send to the machine.
+
+        :param SynapseInformation synapse_info:
+        :return: The length by which the positions are divided, and the
+            layout of the pre- and post-populations, or None if the
+            connector can't be generated on the machine
+        """
+        if (self.__family is None and self.__compiled is None) or \
+                self._expand_distances(self.__d_expression):
+            return None
+        layout = get_grid_layout(self.space, synapse_info)
+        if layout is None:
+            return None
+        extent, length, data = layout
+        if self.__family is None and not self.__check_compiled(
+                extent, length):
+            return None
+        return length, data
+
+    def __check_compiled(self, extent: float, length: float) -> bool:
+        """
+        Check that the machine gets close enough to the probabilities of the
+        compiled expression at the distances that can occur.
+
+        :param float extent: The largest difference in any one axis
+        :param float length: The length of a scaled unit
+        :rtype: bool
+        """
+        assert self.__compiled is not None
+        max_d = extent * math.sqrt(3)
+        if max_d >= float(DataType.S1615.max):
+            return False
+        d = numpy.linspace(0.0, max_d, _N_CHECKED_DISTANCES)
+        try:
+            probs = _d_expr_context.eval(self.__d_expression, d=d)
+        except Exception:  # pylint: disable=broad-except
+            return False
+        # The machine gets the distance by multiplying by the scaled length
+        machine_length = (
+            DataType.S1615.encode_as_int(length) / DataType.S1615.scale)
+        return self.__compiled.matches_probabilities(
+            numpy.broadcast_to(probs, d.shape),
+            d=d * (machine_length / length))
+
+    @overrides(AbstractGenerateConnectorOnMachine.generate_on_machine)
+    def generate_on_machine(self, synapse_info: SynapseInformation) -> bool:
+        if self.__layout is None:
+            return False
+        return super().generate_on_machine(synapse_info)
+
     @overrides(AbstractConnector.get_delay_maximum)
     def get_delay_maximum(self, synapse_info: SynapseInformation) -> float:
         return self._get_delay_maximum(
@@ -149,7 +425,7 @@ class DistanceDependentProbabilityConnector(
             get_probable_maximum_selected(
                 synapse_info.n_pre_neurons * synapse_info.n_post_neurons,
                 synapse_info.n_pre_neurons * synapse_info.n_post_neurons,
-                numpy.amax(self._probs)),
+                self.__max_prob(synapse_info)),
             synapse_info)
 
     @overrides(AbstractConnector.get_delay_minimum)
@@ -159,7 +435,7 @@ class DistanceDependentProbabilityConnector(
             get_probable_minimum_selected(
                 synapse_info.n_pre_neurons * synapse_info.n_post_neurons,
                 synapse_info.n_pre_neurons * synapse_info.n_post_neurons,
-                numpy.amax(self._probs)),
+                self.__max_prob(synapse_info)),
             synapse_info)
 
     @overrides(AbstractConnector.get_n_connections_from_pre_vertex_maximum)
@@ -167,7 +443,7 @@ class DistanceDependentProbabilityConnector(
             self, n_post_atoms: int, synapse_info: SynapseInformation,
             min_delay: Optional[float] = None,
             max_delay: Optional[float] = None) -> int:
-        max_prob = numpy.amax(self._probs)
+        max_prob = self.__max_prob(synapse_info)
         n_connections = get_probable_maximum_selected(
             synapse_info.n_pre_neurons * synapse_info.n_post_neurons,
             n_post_atoms, max_prob)
@@ -186,7 +462,7 @@ class DistanceDependentProbabilityConnector(
         return get_probable_maximum_selected(
             synapse_info.n_pre_neurons * synapse_info.n_post_neurons,
             synapse_info.n_post_neurons,
-            numpy.amax(self._probs))
+            self.__max_prob(synapse_info))
 
     @overrides(AbstractConnector.get_weight_maximum)
     def get_weight_maximum(self, synapse_info: SynapseInformation) -> float:
@@ -195,16 +471,26 @@ class DistanceDependentProbabilityConnector(
             get_probable_maximum_selected(
                 synapse_info.n_pre_neurons * synapse_info.n_post_neurons,
                 synapse_info.n_pre_neurons * synapse_info.n_post_neurons,
-                numpy.amax(self._probs)),
+                self.__max_prob(synapse_info)),
             synapse_info)
 
+    @overrides(AbstractConnector.reserve_block_seeds)
+    def reserve_block_seeds(
+            self, post_slices: Sequence[Slice], post_vertex_slice: Slice,
+            synapse_info: SynapseInformation):
+        super().reserve_block_seeds(
+            post_slices, post_vertex_slice, synapse_info)
+        self._reserve_block_seed(self.__rng, post_vertex_slice)
+
     @overrides(AbstractGenerateConnectorOnHost.create_synaptic_block)
     def create_synaptic_block(
             self, post_slices: Sequence[Slice], post_vertex_slice: Slice,
             synapse_type: int, synapse_info: SynapseInformation) -> NDArray:
-        probs = self._probs[:, post_vertex_slice.get_raster_ids()].reshape(-1)
+        probs = self._get_probs(synapse_info)[
+            :, post_vertex_slice.get_raster_ids()].reshape(-1)
         n_items = synapse_info.n_pre_neurons * post_vertex_slice.n_atoms
-        items = self.__rng.next(n_items)
+        items = self._get_block_rng(
+            self.__rng, post_vertex_slice).next(n_items)
 
         # If self connections are not allowed, remove the possibility of
         # self connections by setting them to a value of infinity
@@ -232,6 +518,71 @@ class DistanceDependentProbabilityConnector(
         block["synapse_type"] = synapse_type
         return block
 
+    @property
+    @overrides(AbstractGenerateConnectorOnMachine.gen_connector_id)
+    def gen_connector_id(self) -> int:
+        return ConnectorIDs.DISTANCE_DEPENDENT_CONNECTOR.value
+
+    @overrides(AbstractGenerateConnectorOnMachine.gen_connector_params)
+    def gen_connector_params(
+            self, synapse_info: SynapseInformation,
+            post_vertex_slice: Slice) -> NDArray[uint32]:
+        assert self.__layout is not None
+        length, layout = self.__layout
+        family = self.__family
+        allow_self = (
+            self.__allow_self_connections or
+            synapse_info.pre_population != synapse_info.post_population)
+        if family is None:
+            # The distance is in the original units, and not cut off
+            assert self.__compiled is not None
+            return numpy.concatenate((numpy.array([
+                int(allow_self), _EXPRESSION,
+                DataType.U032.encode_as_int(float(DataType.U032.max)),
+                DataType.S1615.encode_as_int(length),
+                DataType.S1615.encode_as_int(float(DataType.S1615.max))],
+                dtype=uint32), layout, self.__compiled.data))
+
+        # Work out the shape and cut-off in the scaled units
+        scale = family.scale / length
+        if family.kind == _STEP:
+            shape = 0.0
+            max_d2 = scale ** 2
+            if family.inclusive:
+                # The cut-off is exclusive on the machine
+                max_d2 += _ACCUM_RESOLUTION
+        elif family.kind == _EXPONENTIAL:
+            shape = 1.0 / scale
+            max_d2 = (_MAX_EXPONENT * scale) ** 2
+        else:
+            shape = 1.0 / (2 * scale ** 2)
+            max_d2 = _MAX_EXPONENT / shape
+        shape, max_d2 = numpy.clip(
+            [shape, max_d2], _ACCUM_RESOLUTION, float(DataType.S1615.max))
+
+        # Support 1.0 by using maximum U032, as in FixedProbabilityConnector
+        amplitude = min(family.amplitude, float(DataType.U032.max))
+        return numpy.concatenate((numpy.array([
+            int(allow_self), family.kind,
+            DataType.U032.encode_as_int(amplitude),
+            DataType.S1615.encode_as_int(shape),
+            DataType.S1615.encode_as_int(max_d2)], dtype=uint32), layout))
+
+    @overrides(
+        AbstractGenerateConnectorOnMachine.gen_connector_params_size_in_bytes)
+    def gen_connector_params_size_in_bytes(
+            self, synapse_info: SynapseInformation) -> int:
+        if self.__family is None and self.__compiled is not None:
+            return (_N_GEN_PARAMS + self.__compiled.n_words) * BYTES_PER_WORD
+        return _N_GEN_PARAMS * BYTES_PER_WORD
+
+    @overrides(AbstractConnector.validate_connection)
+    def validate_connection(
+            self, application_edge: ProjectionApplicationEdge,
+            synapse_info: SynapseInformation):
+        if self.generate_on_machine(synapse_info):
+            check_rng(self.__rng, "DistanceDependentProbabilityConnector")
+
     def __repr__(self):
         return f"DistanceDependentProbabilityConnector({self.__d_expression})"
 
@@ -258,3 +609,5 @@ class DistanceDependentProbabilityConnector(
     @d_expression.setter
     def d_expression(self, new_value: str):
         self.__d_expression = new_value
+        self.__family = _parse_d_expression(new_value)
+        self.__compiled = self.__compile(new_value)
@@ -222,6 +222,15 @@ class FixedNumberPreConnector(AbstractGenerateConnectorOnMachine,
            synapse_info.weights, self.__n_pre * synapse_info.n_post_neurons,
            synapse_info)
 
+    @overrides(AbstractConnector.reserve_block_seeds)
+    def reserve_block_seeds(
+            self, post_slices: Sequence[Slice], post_vertex_slice: Slice,
+            synapse_info: SynapseInformation):
+        super().reserve_block_seeds(
+            post_slices, post_vertex_slice, synapse_info)
+        # The connections of all slices are chosen together
+        self._get_pre_neurons(synapse_info)
+
     @overrides(AbstractGenerateConnectorOnHost.create_synaptic_block)
     def create_synaptic_block(
             self, post_slices: Sequence[Slice], post_vertex_slice: Slice,
@@ -283,7 +292,8 @@ class FixedNumberPreConnector(AbstractGenerateConnectorOnMachine,
 
     @overrides(AbstractGenerateConnectorOnMachine.gen_connector_params)
     def gen_connector_params(
-            self, synapse_info: SynapseInformation) -> NDArray[uint32]:
+            self, synapse_info: SynapseInformation,
+            post_vertex_slice: Slice) -> NDArray[uint32]:
         allow_self = (
             self.__allow_self_connections or
             synapse_info.pre_population != synapse_info.post_population)
@@ -292,10 +302,10 @@ class FixedNumberPreConnector(AbstractGenerateConnectorOnMachine,
             int(self.__with_replacement),
             self.__n_pre], dtype=uint32)
 
-    @property
     @overrides(
         AbstractGenerateConnectorOnMachine.gen_connector_params_size_in_bytes)
-    def gen_connector_params_size_in_bytes(self) -> int:
+    def gen_connector_params_size_in_bytes(
+            self, synapse_info: SynapseInformation) -> int:
         return 3 * BYTES_PER_WORD
 
     @overrides(AbstractConnector.validate_connection)
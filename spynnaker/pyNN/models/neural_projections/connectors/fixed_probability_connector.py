@@ -14,7 +14,7 @@
 from __future__ import annotations
 import logging
 import math
-from typing import Optional, Sequence, TYPE_CHECKING
+from typing import Optional, Sequence, Tuple, TYPE_CHECKING
 
 import numpy
 from numpy.typing import NDArray
@@ -44,7 +44,11 @@ if TYPE_CHECKING:
 
 logger = FormatAdapter(logging.getLogger(__name__))
 
-N_GEN_PARAMS = 6
+N_GEN_PARAMS = 4
+
+# At or below this probability, the machine skips straight to each
+# connection made, rather than drawing a number for each possible connection
+_MAX_SKIP_PROBABILITY = 0.25
 
 
 class FixedProbabilityConnector(AbstractGenerateConnectorOnMachine,
@@ -154,25 +158,32 @@ class FixedProbabilityConnector(AbstractGenerateConnectorOnMachine,
         return self._get_weight_maximum(
             synapse_info.weights, n_connections, synapse_info)
 
+    @overrides(AbstractConnector.reserve_block_seeds)
+    def reserve_block_seeds(
+            self, post_slices: Sequence[Slice], post_vertex_slice: Slice,
+            synapse_info: SynapseInformation):
+        super().reserve_block_seeds(
+            post_slices, post_vertex_slice, synapse_info)
+        self._reserve_block_seed(self.__rng, post_vertex_slice)
+
     @overrides(AbstractGenerateConnectorOnHost.create_synaptic_block)
     def create_synaptic_block(
             self, post_slices: Sequence[Slice], post_vertex_slice: Slice,
             synapse_type: int, synapse_info: SynapseInformation) -> NDArray:
-        rng = self.__rng or NumpyRNG()
+        rng = self._get_block_rng(self.__rng, post_vertex_slice)
         n_items = synapse_info.n_pre_neurons * post_vertex_slice.n_atoms
-        items = rng.next(n_items)
+        if 0.0 < self._p_connect <= _MAX_SKIP_PROBABILITY:
+            ids = self.__skip_ids(rng, n_items)
+        else:
+            ids = numpy.where(rng.next(n_items) < self._p_connect)[0]
 
-        # If self connections are not allowed, remove possibility the self
-        # connections by setting them to a value of infinity
+        # If self connections are not allowed, remove the self connections
         no_self = (
             not self.__allow_self_connections and
             synapse_info.pre_population == synapse_info.post_population)
         if no_self:
-            items[0:n_items:post_vertex_slice.n_atoms + 1] = numpy.inf
-
-        present = items < self._p_connect
-        ids = numpy.where(present)[0]
-        n_connections = numpy.sum(present)
+            ids = ids[ids % (post_vertex_slice.n_atoms + 1) != 0]
+        n_connections = len(ids)
 
         block = numpy.zeros(n_connections, dtype=self.NUMPY_SYNAPSES_DTYPE)
         block["source"] = ids // post_vertex_slice.n_atoms
@@ -187,6 +198,28 @@ class FixedProbabilityConnector(AbstractGenerateConnectorOnMachine,
         block["synapse_type"] = synapse_type
         return block
 
+    def __skip_ids(self, rng: NumpyRNG, n_items: int) -> NDArray:
+        """
+        Choose which of the possible connections are made by drawing the
+        gaps between them, as is done on the machine; this is much quicker
+        than drawing a number for every possible connection when sparse.
+
+        :param ~pyNN.random.NumpyRNG rng: The generator to draw from
+        :param int n_items: The number of possible connections
+        :rtype: ~numpy.ndarray
+        """
+        chunks = []
+        last = -1
+        while last < n_items:
+            # Enough to most likely reach the end in one go
+            n_gaps = int((n_items - last) * self._p_connect * 1.1) + 16
+            ids = last + numpy.cumsum(
+                rng.rng.geometric(self._p_connect, n_gaps))
+            chunks.append(ids)
+            last = int(ids[-1])
+        ids = numpy.concatenate(chunks)
+        return ids[ids < n_items]
+
     def __repr__(self) -> str:
         return f"FixedProbabilityConnector({self._p_connect})"
 
@@ -197,19 +230,38 @@ class FixedProbabilityConnector(AbstractGenerateConnectorOnMachine,
 
     @overrides(AbstractGenerateConnectorOnMachine.gen_connector_params)
     def gen_connector_params(
-            self, synapse_info: SynapseInformation) -> NDArray:
+            self, synapse_info: SynapseInformation,
+            post_vertex_slice: Slice) -> NDArray:
         allow_self = (
             self.__allow_self_connections or
             synapse_info.pre_population != synapse_info.post_population)
+        skip_scale, skip_shift = self.__skip_scale()
         return numpy.array([
             int(allow_self),
-            DataType.U032.encode_as_int(self._p_connect)], dtype="uint32")
+            DataType.U032.encode_as_int(self._p_connect),
+            skip_scale, skip_shift], dtype="uint32")
+
+    def __skip_scale(self) -> Tuple[int, int]:
+        """
+        Get -1 / ln(1 - p) as a 32-bit number and the shift it is scaled up
+        by, or 0 if connections are not to be skipped to.
+
+        :rtype: tuple(int, int)
+        """
+        if not 0.0 < self._p_connect <= _MAX_SKIP_PROBABILITY:
+            return 0, 0
+        skip_scale = -1.0 / math.log1p(-self._p_connect)
+        # Keep as many bits as fit in 32
+        _, exponent = math.frexp(skip_scale)
+        skip_shift = max(0, 32 - exponent)
+        return (min(round(skip_scale * (2 ** skip_shift)), 0xFFFFFFFF),
+                skip_shift)
 
-    @property
     @overrides(
         AbstractGenerateConnectorOnMachine.gen_connector_params_size_in_bytes)
-    def gen_connector_params_size_in_bytes(self) -> int:
-        return 2 * BYTES_PER_WORD
+    def gen_connector_params_size_in_bytes(
+            self, synapse_info: SynapseInformation) -> int:
+        return N_GEN_PARAMS * BYTES_PER_WORD
 
     @property
     def p_connect(self) -> float:
@@ -23,7 +23,10 @@ from numpy import floating, integer, int64, uint32
 from numpy.typing import NDArray
 from typing_extensions import TypeGuard
 
+from pyNN.random import RandomDistribution
+
 from spinn_utilities.overrides import overrides
+from spinn_utilities.config_holder import get_config_bool
 from spinn_utilities.log import FormatAdapter
 
 from pacman.model.graphs import AbstractVertex
@@ -31,13 +34,23 @@ from pacman.model.graphs.application import ApplicationVertex
 from pacman.model.graphs.machine import MachineVertex
 from pacman.model.graphs.common import Slice
 
+from spinn_front_end_common.interface.ds import DataType
+from spinn_front_end_common.utilities.constants import (
+    BYTES_PER_SHORT, BYTES_PER_WORD)
+
 from spynnaker.pyNN.data import SpynnakerDataView
 from spynnaker.pyNN.exceptions import InvalidParameterType
+from spynnaker.pyNN.models.common.param_generator_data import (
+    param_generator_params, param_generator_params_size_in_bytes,
+    param_generator_id, is_param_generatable)
 from spynnaker.pyNN.types import Delay_Types, Weight_Delay_Types, Weight_Types
+from spynnaker.pyNN.utilities.utility_calls import check_rng
 
 from .abstract_connector import AbstractConnector
 from .abstract_generate_connector_on_host import (
     AbstractGenerateConnectorOnHost)
+from .abstract_generate_connector_on_machine import (
+    AbstractGenerateConnectorOnMachine, ConnectorIDs)
 
 if TYPE_CHECKING:
     from spynnaker.pyNN.models.neural_projections import (
@@ -52,6 +65,17 @@ _SOURCE = 0
 _TARGET = 1
 _FIRST_PARAM = 2
 
+# Flags describing the list sent to the machine
+_PRE_16_BIT = 0x1
+_HAS_WEIGHTS = 0x2
+_HAS_DELAYS = 0x4
+
+# The words of the header of the list sent to the machine
+_N_HEADER_WORDS = 4
+
+# The largest pre-index that can be sent to the machine in 16 bits
+_MAX_16_BIT = 0xFFFF
+
 
 def _is_sequential(value: Weight_Delay_Types
                    ) -> TypeGuard[NDArray[numpy.float64]]:
@@ -67,9 +91,14 @@ class _ExtraParams:
     names: Sequence[str]
 
 
-class FromListConnector(AbstractConnector, AbstractGenerateConnectorOnHost):
+class FromListConnector(AbstractGenerateConnectorOnMachine,
+                        AbstractGenerateConnectorOnHost):
     """
     Make connections according to a list.
+
+    .. note::
+        Where possible the list is sent to the machine sorted by
+        post-neuron, so that each core only expands its own part of it.
     """
     __slots__ = (
         "__conn_list",
@@ -196,7 +225,6 @@ class FromListConnector(AbstractConnector, AbstractGenerateConnectorOnHost):
             self.__split_conn_list = {}
             return sources, targets, weights, delays
 
-        self.__split_post_slices = list(post_slices)
         m_vertex_mapping = self.__id_to_m_vertex_index(
             n_post_atoms, post_slices)
 
@@ -220,6 +248,9 @@ class FromListConnector(AbstractConnector, AbstractGenerateConnectorOnHost):
             for i, indices in enumerate(split_indices)
             if len(indices) > 0
         }
+        # Only marked as cached once complete, as blocks may be created
+        # in several threads at once
+        self.__split_post_slices = list(post_slices)
         return sources, targets, weights, delays
 
     @overrides(AbstractConnector.get_n_connections_from_pre_vertex_maximum)
@@ -323,6 +354,17 @@ class FromListConnector(AbstractConnector, AbstractGenerateConnectorOnHost):
         else:
             return float(numpy.var(numpy.abs(self.__weights)))
 
+    @overrides(AbstractConnector.reserve_block_seeds)
+    def reserve_block_seeds(
+            self, post_slices: Sequence[Slice], post_vertex_slice: Slice,
+            synapse_info: SynapseInformation):
+        super().reserve_block_seeds(
+            post_slices, post_vertex_slice, synapse_info)
+        # Split the list up front rather than in each block
+        self._split_connections(
+            synapse_info.n_pre_neurons, synapse_info.n_post_neurons,
+            post_slices)
+
     @overrides(AbstractGenerateConnectorOnHost.create_synaptic_block)
     def create_synaptic_block(
             self, post_slices: Sequence[Slice], post_vertex_slice: Slice,
@@ -364,6 +406,151 @@ class FromListConnector(AbstractConnector, AbstractGenerateConnectorOnHost):
         block["synapse_type"] = synapse_type
         return block
 
+    @overrides(AbstractGenerateConnectorOnMachine.generate_on_machine)
+    def generate_on_machine(self, synapse_info: SynapseInformation) -> bool:
+        if not get_config_bool("Simulation", "generate_from_list_on_machine"):
+            return False
+        # Extra parameters are set per synapse on host
+        if self.__extra_params is not None:
+            return False
+        # The list is indexed over the whole of each Population
+        if synapse_info.prepop_is_view or synapse_info.postpop_is_view:
+            return False
+        if (len(synapse_info.pre_vertex.atoms_shape) > 1 or
+                len(synapse_info.post_vertex.atoms_shape) > 1):
+            return False
+
+        # Anything not in the list must be generatable
+        if self.__weights is None:
+            if not is_param_generatable(synapse_info.weights):
+                return False
+            if isinstance(synapse_info.weights, RandomDistribution):
+                check_rng(
+                    synapse_info.weights.rng, "RandomDistribution in weight")
+        if self.__delays is None:
+            if not is_param_generatable(synapse_info.delays):
+                return False
+            if isinstance(synapse_info.delays, RandomDistribution):
+                check_rng(
+                    synapse_info.delays.rng, "RandomDistribution in delay")
+        return True
+
+    def __gen_values(self, in_list: bool, values):
+        # Values in the list are sent with it, so the generator is unused
+        return 0.0 if in_list else values
+
+    @overrides(AbstractGenerateConnectorOnMachine.gen_weights_id)
+    def gen_weights_id(self, weights: Weight_Types) -> int:
+        return param_generator_id(
+            self.__gen_values(self.__weights is not None, weights))
+
+    @overrides(AbstractGenerateConnectorOnMachine.gen_weights_params)
+    def gen_weights_params(self, weights: Weight_Types) -> NDArray[uint32]:
+        return param_generator_params(
+            self.__gen_values(self.__weights is not None, weights))
+
+    @overrides(
+        AbstractGenerateConnectorOnMachine.gen_weight_params_size_in_bytes)
+    def gen_weight_params_size_in_bytes(self, weights) -> int:
+        return param_generator_params_size_in_bytes(
+            self.__gen_values(self.__weights is not None, weights))
+
+    @overrides(AbstractGenerateConnectorOnMachine.gen_delays_id)
+    def gen_delays_id(self, delays: Delay_Types) -> int:
+        return param_generator_id(
+            self.__gen_values(self.__delays is not None, delays))
+
+    @overrides(AbstractGenerateConnectorOnMachine.gen_delay_params)
+    def gen_delay_params(self, delays: Delay_Types) -> NDArray[uint32]:
+        return param_generator_params(
+            self.__gen_values(self.__delays is not None, delays))
+
+    @overrides(
+        AbstractGenerateConnectorOnMachine.gen_delay_params_size_in_bytes)
+    def gen_delay_params_size_in_bytes(self, delays: Delay_Types) -> int:
+        return param_generator_params_size_in_bytes(
+            self.__gen_values(self.__delays is not None, delays))
+
+    @property
+    @overrides(AbstractGenerateConnectorOnMachine.gen_connector_id)
+    def gen_connector_id(self) -> int:
+        return ConnectorIDs.FROM_LIST_CONNECTOR.value
+
+    @overrides(AbstractGenerateConnectorOnMachine.gen_connector_params)
+    def gen_connector_params(
+            self, synapse_info: SynapseInformation,
+            post_vertex_slice: Slice) -> NDArray[uint32]:
+        # Only the connections to the neurons of the slice are sent
+        first_post = post_vertex_slice.lo_atom
+        input_filter = numpy.logical_and.reduce((
+            self.__targets >= first_post,
+            self.__targets <= post_vertex_slice.hi_atom,
+            self.__targets < synapse_info.n_post_neurons,
+            self.__sources < synapse_info.n_pre_neurons))
+        targets = self.__targets[input_filter]
+        sources = self.__sources[input_filter]
+        if len(targets) == 0:
+            return numpy.array([first_post, 0, 0, 0, 0], dtype=uint32)
+
+        # Sort by post-neuron, then pre-neuron, and index where each
+        # post-neuron of the slice starts
+        order = numpy.lexsort((sources, targets))
+        targets = targets[order]
+        sources = sources[order]
+        local_targets = targets.astype(int64) - first_post
+        n_post = int(local_targets[-1]) + 1
+        post_starts = numpy.zeros(n_post + 1, dtype=uint32)
+        post_starts[1:] = numpy.cumsum(numpy.bincount(
+            local_targets, minlength=n_post))
+
+        flags = 0
+        if numpy.max(sources) <= _MAX_16_BIT:
+            flags |= _PRE_16_BIT
+            pre = sources.astype(numpy.uint16)
+            if len(pre) % 2:
+                pre = numpy.concatenate((pre, numpy.zeros(1, numpy.uint16)))
+            pre = pre.view(uint32)
+        else:
+            pre = sources
+        extra_data = []
+        if self.__weights is not None:
+            flags |= _HAS_WEIGHTS
+            extra_data.append(DataType.S1615.encode_as_numpy_int_array(
+                self.__weights[input_filter][order]))
+        if self.__delays is not None:
+            flags |= _HAS_DELAYS
+            extra_data.append(DataType.S1615.encode_as_numpy_int_array(
+                self._clip_delays(self.__delays[input_filter][order])))
+        data = numpy.array(
+            [first_post, n_post, len(targets), flags], dtype=uint32)
+        return numpy.concatenate(
+            (data, post_starts, pre, *extra_data)).astype(uint32, copy=False)
+
+    @overrides(
+        AbstractGenerateConnectorOnMachine.gen_connector_params_size_in_bytes)
+    def gen_connector_params_size_in_bytes(
+            self, synapse_info: SynapseInformation) -> int:
+        # An upper bound for the slices of a whole vertex that is split into
+        # slices of the same size, as on-machine generation needs, from the
+        # most connections that target any one of those slices
+        size = _N_HEADER_WORDS * BYTES_PER_WORD
+        if len(self.__targets) == 0:
+            return size + BYTES_PER_WORD
+        n_atoms = synapse_info.post_vertex.get_max_atoms_per_core()
+        n_conns = int(numpy.max(numpy.bincount(
+            self.__targets.astype(int64) // n_atoms)))
+        size += (min(n_atoms, int(numpy.max(self.__targets)) + 1) + 1) * \
+            BYTES_PER_WORD
+        if numpy.max(self.__sources) <= _MAX_16_BIT:
+            size += ((n_conns + 1) // 2) * 2 * BYTES_PER_SHORT
+        else:
+            size += n_conns * BYTES_PER_WORD
+        if self.__weights is not None:
+            size += n_conns * BYTES_PER_WORD
+        if self.__delays is not None:
+            size += n_conns * BYTES_PER_WORD
+        return size
+
     def __repr__(self):
         return f"FromListConnector(n_connections={len(self.__sources)})"
 
@@ -20,7 +20,7 @@ import numpy
 from numpy import (
     arccos, arcsin, arctan, arctan2, ceil, cos, cosh, exp, fabs, floor, fmod,
     hypot, ldexp, log, log10, modf, power, sin, sinh, sqrt, tan, tanh, maximum,
-    minimum, e, pi)
+    minimum, e, pi, uint32)
 from numpy.typing import NDArray
 
 from pyNN.random import NumpyRNG
@@ -30,14 +30,20 @@ from spinn_utilities.safe_eval import SafeEval
 
 from pacman.model.graphs.common import Slice
 
+from spinn_front_end_common.utilities.constants import BYTES_PER_WORD
+
 from spynnaker.pyNN.utilities import utility_calls
+from spynnaker.pyNN.utilities.expression_compiler import compile_expression
 
 from .abstract_connector import AbstractConnector
 from .abstract_generate_connector_on_host import (
     AbstractGenerateConnectorOnHost)
+from .abstract_generate_connector_on_machine import (
+    AbstractGenerateConnectorOnMachine, ConnectorIDs)
 
 if TYPE_CHECKING:
-    from spynnaker.pyNN.models.neural_projections import SynapseInformation
+    from spynnaker.pyNN.models.neural_projections import (
+        ProjectionApplicationEdge, SynapseInformation)
 
 # support for arbitrary expression for the indices
 _index_expr_context = SafeEval(math, numpy, arccos, arcsin, arctan, arctan2,
@@ -45,16 +51,27 @@ _index_expr_context = SafeEval(math, numpy, arccos, arcsin, arctan, arctan2,
                                ldexp, log, log10, modf, power, sin, sinh, sqrt,
                                tan, tanh, maximum, minimum, e=e, pi=pi)
 
+# The most neurons in a population whose indices fit in an accum
+_MAX_INDEXED_NEURONS = 1 << 16
+
+# The most indices of each population checked against the machine
+_N_CHECKED_INDICES = 64
+
 
-class IndexBasedProbabilityConnector(AbstractConnector,
+class IndexBasedProbabilityConnector(AbstractGenerateConnectorOnMachine,
                                      AbstractGenerateConnectorOnHost):
     """
     Make connections using a probability distribution which varies
     dependent upon the indices of the pre- and post-populations.
+
+    .. note::
+        Expressions using only arithmetic, ``exp``, ``sqrt``, ``abs``,
+        ``min``, ``max`` and comparisons can be generated on the machine.
     """
 
     __slots = [
         "__allow_self_connections",
+        "__compiled",
         "__index_expression",
         "__probs",
         "__rng"]
@@ -95,6 +112,7 @@ class IndexBasedProbabilityConnector(AbstractConnector,
         super().__init__(safe, callback, verbose)
         self.__rng = rng or NumpyRNG()
         self.__index_expression = index_expression
+        self.__compiled = compile_expression(index_expression, ("i", "j"))
         self.__allow_self_connections = allow_self_connections
         self.__probs: Optional[NDArray] = None
 
@@ -112,6 +130,28 @@ class IndexBasedProbabilityConnector(AbstractConnector,
                 (synapse_info.n_pre_neurons, synapse_info.n_post_neurons))
         return self.__probs
 
+    @overrides(AbstractGenerateConnectorOnMachine.generate_on_machine)
+    def generate_on_machine(self, synapse_info: SynapseInformation) -> bool:
+        n_pre = synapse_info.n_pre_neurons
+        n_post = synapse_info.n_post_neurons
+        if (self.__compiled is None or n_pre > _MAX_INDEXED_NEURONS or
+                n_post > _MAX_INDEXED_NEURONS):
+            return False
+
+        # Check that the machine gets close enough to the probabilities on
+        # a grid of indices spread over the populations
+        probs = numpy.broadcast_to(
+            self._update_probs_from_index_expression(synapse_info),
+            (n_pre, n_post))
+        i = numpy.unique(numpy.linspace(
+            0, n_pre - 1, _N_CHECKED_INDICES, dtype=int))
+        j = numpy.unique(numpy.linspace(
+            0, n_post - 1, _N_CHECKED_INDICES, dtype=int))
+        if not self.__compiled.matches_probabilities(
+                probs[numpy.ix_(i, j)], i=i[:, None], j=j[None, :]):
+            return False
+        return super().generate_on_machine(synapse_info)
+
     @overrides(AbstractConnector.get_delay_maximum)
     def get_delay_maximum(self, synapse_info: SynapseInformation) -> float:
         probs = self._update_probs_from_index_expression(synapse_info)
@@ -169,6 +209,14 @@ class IndexBasedProbabilityConnector(AbstractConnector,
         return self._get_weight_maximum(
             synapse_info.weights, n_connections, synapse_info)
 
+    @overrides(AbstractConnector.reserve_block_seeds)
+    def reserve_block_seeds(
+            self, post_slices: Sequence[Slice], post_vertex_slice: Slice,
+            synapse_info: SynapseInformation):
+        super().reserve_block_seeds(
+            post_slices, post_vertex_slice, synapse_info)
+        self._reserve_block_seed(self.__rng, post_vertex_slice)
+
     @overrides(AbstractGenerateConnectorOnHost.create_synaptic_block)
     def create_synaptic_block(
             self, post_slices: Sequence[Slice], post_vertex_slice: Slice,
@@ -179,7 +227,8 @@ class IndexBasedProbabilityConnector(AbstractConnector,
         probs = probs[:, post_vertex_slice.get_raster_ids()].reshape(-1)
 
         n_items = synapse_info.n_pre_neurons * post_vertex_slice.n_atoms
-        items = self.__rng.next(n_items)
+        items = self._get_block_rng(
+            self.__rng, post_vertex_slice).next(n_items)
 
         # If self connections are not allowed, remove the possibility of self
         # connections by setting the probability to a value of infinity
@@ -207,6 +256,38 @@ class IndexBasedProbabilityConnector(AbstractConnector,
         block["synapse_type"] = synapse_type
         return block
 
+    @property
+    @overrides(AbstractGenerateConnectorOnMachine.gen_connector_id)
+    def gen_connector_id(self) -> int:
+        return ConnectorIDs.INDEX_BASED_CONNECTOR.value
+
+    @overrides(AbstractGenerateConnectorOnMachine.gen_connector_params)
+    def gen_connector_params(
+            self, synapse_info: SynapseInformation,
+            post_vertex_slice: Slice) -> NDArray[uint32]:
+        assert self.__compiled is not None
+        allow_self = (
+            self.__allow_self_connections or
+            synapse_info.pre_population != synapse_info.post_population)
+        return numpy.concatenate((
+            numpy.array([int(allow_self)], dtype=uint32),
+            self.__compiled.data))
+
+    @overrides(
+        AbstractGenerateConnectorOnMachine.gen_connector_params_size_in_bytes)
+    def gen_connector_params_size_in_bytes(
+            self, synapse_info: SynapseInformation) -> int:
+        assert self.__compiled is not None
+        return (1 + self.__compiled.n_words) * BYTES_PER_WORD
+
+    @overrides(AbstractConnector.validate_connection)
+    def validate_connection(
+            self, application_edge: ProjectionApplicationEdge,
+            synapse_info: SynapseInformation):
+        if self.generate_on_machine(synapse_info):
+            utility_calls.check_rng(
+                self.__rng, "IndexBasedProbabilityConnector")
+
     def __repr__(self):
         return f"IndexBasedProbabilityConnector({self.__index_expression})"
 
@@ -241,3 +322,4 @@ class IndexBasedProbabilityConnector(AbstractConnector,
         if self.__probs is None:
             raise ValueError("connectivity matrix already fixed")
         self.__index_expression = new_value
+        self.__compiled = compile_expression(new_value, ("i", "j"))
@@ -42,6 +42,7 @@ from .abstract_generate_connector_on_machine import (
     AbstractGenerateConnectorOnMachine, ConnectorIDs)
 from .abstract_generate_connector_on_host import (
     AbstractGenerateConnectorOnHost)
+from .convolution_connector import ConvolutionConnector
 
 if TYPE_CHECKING:
     from spynnaker.pyNN.models.neural_projections import (
@@ -458,6 +459,65 @@ class KernelConnector(AbstractGenerateConnectorOnMachine,
             return float(numpy.var(self._krn_weights))
         return super().get_weight_variance(weights, synapse_info)
 
+    def as_convolution_connector(
+            self, pre_shape: Tuple[int, ...], post_shape: Tuple[int, ...],
+            weights: Weight_Types, delays: Delay_Types) -> Optional[
+                Tuple[ConvolutionConnector, float]]:
+        """
+        Get a :py:class:`ConvolutionConnector` that makes the same
+        connections between populations of the given shapes, so that they can
+        share one kernel of weights on the local-only path rather than being
+        expanded into rows of synapses.
+
+        There is one when both populations have the 2D shape of the
+        pre-population, with no sampling steps or offsets, the kernel has odd
+        sides so that it has a centre, and the delays are all the same.
+
+        :param tuple(int,int) pre_shape:
+            The shape of the pre-population, as (width, height)
+        :param tuple(int,int) post_shape:
+            The shape of the post-population, as (width, height)
+        :param weights: The weights, used if there is no weight kernel
+        :type weights: int or float or ~pyNN.random.RandomDistribution
+        :param delays: The delays, used if there is no delay kernel
+        :type delays: int or float or ~pyNN.random.RandomDistribution
+        :return: The connector and the delay, or None if there isn't one
+        :rtype: tuple(ConvolutionConnector, float) or None
+        """
+        pre_w_h = (self._pre_w, self._pre_h)
+        if (tuple(pre_shape) != pre_w_h or tuple(post_shape) != pre_w_h or
+                tuple(self._shape_post) != tuple(self._shape_pre) or
+                tuple(self._shape_common) != tuple(self._shape_pre)):
+            return None
+        if (self._pre_step_w, self._pre_step_h, self._post_step_w,
+                self._post_step_h) != (1, 1, 1, 1):
+            return None
+        if (self._pre_start_w, self._pre_start_h, self._post_start_w,
+                self._post_start_h) != (0, 0, 0, 0):
+            return None
+        if self._kernel_w % 2 == 0 or self._kernel_h % 2 == 0:
+            return None
+
+        if self._krn_delays is not None:
+            if numpy.any(self._krn_delays != self._krn_delays.flat[0]):
+                return None
+            delay = float(self._krn_delays.flat[0])
+        elif isinstance(delays, (int, float)):
+            delay = float(delays)
+        else:
+            return None
+        kernel = self._krn_weights
+        if kernel is None:
+            kernel = self.__get_kernel_vals(weights)
+        if kernel is None:
+            return None
+
+        # Here a post-neuron takes the kernel centred on itself, whereas the
+        # convolution centres the kernel on the pre-neuron, so it is flipped
+        return ConvolutionConnector(
+            numpy.flip(numpy.asarray(kernel, dtype=float), (HEIGHT, WIDTH)),
+            padding=(self._hlf_k_h, self._hlf_k_w)), delay
+
     def __repr__(self):
         return \
             f"KernelConnector(shape_kernel[{self._kernel_w},{self._kernel_h}])"
@@ -493,7 +553,8 @@ class KernelConnector(AbstractGenerateConnectorOnMachine,
 
     @overrides(AbstractGenerateConnectorOnMachine.gen_connector_params)
     def gen_connector_params(
-            self, synapse_info: SynapseInformation) -> NDArray[uint32]:
+            self, synapse_info: SynapseInformation,
+            post_vertex_slice: Slice) -> NDArray[uint32]:
         data = numpy.array([
             shape2word(self._common_w, self._common_h),
             shape2word(self._pre_w, self._pre_h),
@@ -517,10 +578,10 @@ class KernelConnector(AbstractGenerateConnectorOnMachine,
             return numpy.concatenate((data, *extra_data))
         return data
 
-    @property
     @overrides(
         AbstractGenerateConnectorOnMachine.gen_connector_params_size_in_bytes)
-    def gen_connector_params_size_in_bytes(self) -> int:
+    def gen_connector_params_size_in_bytes(
+            self, synapse_info: SynapseInformation) -> int:
         size = N_KERNEL_PARAMS * BYTES_PER_WORD
         if self._krn_weights is not None:
             size += sum(len(x) for x in self._krn_weights) * BYTES_PER_WORD
@@ -230,6 +230,18 @@ class MultapseConnector(AbstractGenerateConnectorOnMachine,
         return self._get_weight_maximum(
             synapse_info.weights, self.__num_synapses, synapse_info)
 
+    @overrides(AbstractConnector.reserve_block_seeds)
+    def reserve_block_seeds(
+            self, post_slices: Sequence[Slice], post_vertex_slice: Slice,
+            synapse_info: SynapseInformation):
+        super().reserve_block_seeds(
+            post_slices, post_vertex_slice, synapse_info)
+        # The number of connections of all slices is chosen together
+        self._update_synapses_per_post_vertex(
+            post_slices, synapse_info.n_pre_neurons,
+            self.__rng or NumpyRNG())
+        self._reserve_block_seed(self.__rng, post_vertex_slice)
+
     @overrides(AbstractGenerateConnectorOnHost.create_synaptic_block)
     def create_synaptic_block(
             self, post_slices: Sequence[Slice], post_vertex_slice: Slice,
@@ -257,8 +269,13 @@ class MultapseConnector(AbstractGenerateConnectorOnMachine,
             pairs = pairs[pairs[:, 0] != pairs[:, 1]]
 
         # Now do the actual random choice from the available connections
+        choice = numpy.random.choice
+        block_rng = self._get_reserved_block_rng(
+            self.__rng, post_vertex_slice)
+        if block_rng is not None:
+            choice = block_rng.rng.choice
         try:
-            chosen = numpy.random.choice(
+            chosen = choice(
                 pairs.shape[0], size=n_connections,
                 replace=self.__with_replacement)
         except Exception as e:
@@ -289,7 +306,8 @@ class MultapseConnector(AbstractGenerateConnectorOnMachine,
 
     @overrides(AbstractGenerateConnectorOnMachine.gen_connector_params)
     def gen_connector_params(
-            self, synapse_info: SynapseInformation) -> NDArray[uint32]:
+            self, synapse_info: SynapseInformation,
+            post_vertex_slice: Slice) -> NDArray[uint32]:
         allow_self = (
             self.__allow_self_connections or
             synapse_info.pre_population != synapse_info.post_population)
@@ -298,10 +316,10 @@ class MultapseConnector(AbstractGenerateConnectorOnMachine,
             int(self.__with_replacement),
             self.__num_synapses], dtype=uint32)
 
-    @property
     @overrides(
         AbstractGenerateConnectorOnMachine.gen_connector_params_size_in_bytes)
-    def gen_connector_params_size_in_bytes(self) -> int:
+    def gen_connector_params_size_in_bytes(
+            self, synapse_info: SynapseInformation) -> int:
         return (3 * BYTES_PER_WORD)
 
     @overrides(AbstractConnector.validate_connection)
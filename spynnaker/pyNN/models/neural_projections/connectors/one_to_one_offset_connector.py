@@ -196,17 +196,18 @@ class OneToOneOffsetConnector(
 
     @overrides(AbstractGenerateConnectorOnMachine.gen_connector_params)
     def gen_connector_params(
-            self, synapse_info: SynapseInformation) -> NDArray[uint32]:
+            self, synapse_info: SynapseInformation,
+            post_vertex_slice: Slice) -> NDArray[uint32]:
         n_values = self.__n_neurons_per_group
         if n_values is None:
             n_values = synapse_info.n_pre_neurons
         return numpy.array([self.__offset, int(self.__wrap), n_values],
                            dtype=uint32)
 
-    @property
     @overrides(
         AbstractGenerateConnectorOnMachine.gen_connector_params_size_in_bytes)
-    def gen_connector_params_size_in_bytes(self) -> int:
+    def gen_connector_params_size_in_bytes(
+            self, synapse_info: SynapseInformation) -> int:
         return BYTES_PER_WORD * 3
 
     @overrides(AbstractConnector.validate_connection)
@@ -13,9 +13,10 @@
 # limitations under the License.
 from __future__ import annotations
 import math
-from typing import Optional, Sequence, TYPE_CHECKING
+from typing import Optional, Sequence, Tuple, TYPE_CHECKING
 
 import numpy
+from numpy import uint32
 from numpy.typing import NDArray
 
 from pyNN.random import NumpyRNG
@@ -24,31 +25,54 @@ from spinn_utilities.overrides import overrides
 
 from pacman.model.graphs.common import Slice
 
+from spinn_front_end_common.interface.ds import DataType
+from spinn_front_end_common.utilities.constants import BYTES_PER_WORD
 from spinn_front_end_common.utilities.exceptions import ConfigurationException
 
+from spynnaker.pyNN.utilities.utility_calls import check_rng
 from .abstract_connector import AbstractConnector
 from .abstract_generate_connector_on_host import (
     AbstractGenerateConnectorOnHost)
+from .abstract_generate_connector_on_machine import (
+    AbstractGenerateConnectorOnMachine, ConnectorIDs)
+from .distance_dependent_probability_connector import (
+    N_LATTICE_WORDS, get_grid_layout)
 
 if TYPE_CHECKING:
-    from spynnaker.pyNN.models.neural_projections import SynapseInformation
+    from spynnaker.pyNN.models.neural_projections import (
+        ProjectionApplicationEdge, SynapseInformation)
 
+# The number of words in the parameters on the machine
+_N_GEN_PARAMS = 3 + (2 * N_LATTICE_WORDS)
 
-class SmallWorldConnector(AbstractConnector, AbstractGenerateConnectorOnHost):
+# The number of pre-neurons whose distances are worked out at once when
+# only the number of connections is needed
+_N_ROWS_PER_BLOCK = 256
+
+
+class SmallWorldConnector(AbstractGenerateConnectorOnMachine,
+                          AbstractGenerateConnectorOnHost):
     """
     A connector that uses connection statistics based on the Small World
     network connectivity model.
 
     .. note::
         This is typically used from a population to itself.
+
+    .. note::
+        Populations laid out on a regular grid can be connected on the
+        machine.
     """
     __slots__ = (
-        "__allow_self_connections",  # TODO: currently ignored
+        "__allow_self_connections",
+        "__col_counts",
         "__degree",
+        "__layout",
         "__mask",
         "__n_connections",
         "__rewiring",
-        "__rng")
+        "__rng",
+        "__row_counts")
 
     def __init__(
             self, degree: float, rewiring: float,
@@ -90,6 +114,9 @@ class SmallWorldConnector(AbstractConnector, AbstractGenerateConnectorOnHost):
         self.__degree = degree
         self.__allow_self_connections = allow_self_connections
         self.__mask: Optional[NDArray] = None
+        self.__row_counts: Optional[NDArray] = None
+        self.__col_counts: Optional[NDArray] = None
+        self.__layout: Optional[Tuple[float, NDArray[uint32]]] = None
         self.__n_connections = 0
         self.__rng = rng or NumpyRNG()
 
@@ -101,14 +128,24 @@ class SmallWorldConnector(AbstractConnector, AbstractGenerateConnectorOnHost):
     @overrides(AbstractConnector.set_projection_information)
     def set_projection_information(self, synapse_info: SynapseInformation):
         super().set_projection_information(synapse_info)
+        if self.space is None:
+            raise ConfigurationException("a metric space is required")
+        layout = get_grid_layout(self.space, synapse_info)
+        self.__layout = None if layout is None else layout[1:]
         self._set_n_connections(synapse_info)
 
     def _set_n_connections(self, synapse_info: SynapseInformation):
         """
         :param SynapseInformation synapse_info:
         """
-        if self.space is None:
-            raise ConfigurationException("a metric space is required")
+        assert self.space is not None
+        self.__mask = None
+        self.__row_counts = None
+        self.__col_counts = None
+        if self.generate_on_machine(synapse_info):
+            self.__count_connections(synapse_info)
+            return
+
         # Get the probabilities up-front for now
         # TODO: Work out how this can be done statistically
         # space.distances(...) expects N,3 array in PyNN0.7, but 3,N in PyNN0.8
@@ -128,8 +165,38 @@ class SmallWorldConnector(AbstractConnector, AbstractGenerateConnectorOnHost):
             d = distances
 
         self.__mask = (d < self.__degree).astype(float)
+        if (not self.__allow_self_connections and
+                synapse_info.pre_population == synapse_info.post_population):
+            numpy.fill_diagonal(self.__mask, 0)
         self.__n_connections = int(math.ceil(numpy.sum(self.__mask)))
 
+    def __count_connections(self, synapse_info: SynapseInformation):
+        """
+        Count the local connections of each neuron, without keeping the
+        distance between every pair of neurons.
+
+        :param SynapseInformation synapse_info:
+        """
+        assert self.space is not None
+        pre_positions = synapse_info.pre_population.positions
+        post_positions = synapse_info.post_population.positions
+        n_pre = pre_positions.shape[0]
+        n_post = post_positions.shape[0]
+        row_counts = numpy.zeros(n_pre, dtype=int)
+        col_counts = numpy.zeros(n_post, dtype=int)
+        for start in range(0, n_pre, _N_ROWS_PER_BLOCK):
+            block = pre_positions[start:start + _N_ROWS_PER_BLOCK]
+            d = numpy.reshape(
+                self.space.distances(block, post_positions, False),
+                (block.shape[0], n_post))
+            local = d < self.__degree
+            row_counts[start:start + block.shape[0]] = numpy.sum(
+                local, axis=1)
+            col_counts += numpy.sum(local, axis=0)
+        self.__row_counts = row_counts
+        self.__col_counts = col_counts
+        self.__n_connections = int(numpy.sum(row_counts))
+
     @overrides(AbstractConnector.get_delay_maximum)
     def get_delay_maximum(self, synapse_info: SynapseInformation) -> float:
         return self._get_delay_maximum(
@@ -145,6 +212,17 @@ class SmallWorldConnector(AbstractConnector, AbstractGenerateConnectorOnHost):
             self, n_post_atoms: int, synapse_info: SynapseInformation,
             min_delay: Optional[float] = None,
             max_delay: Optional[float] = None) -> int:
+        if self.__row_counts is not None:
+            # Rewired connections stay on the same core, so no row gets
+            # longer
+            n_connections = min(
+                n_post_atoms, int(numpy.amax(self.__row_counts)))
+            if min_delay is None or max_delay is None:
+                return n_connections
+            return self._get_n_connections_from_pre_vertex_with_delay_maximum(
+                synapse_info.delays, self.__n_connections, n_connections,
+                min_delay, max_delay, synapse_info)
+
         assert self.__mask is not None
         # Break the array into n_post_atoms units
         split_positions = numpy.arange(
@@ -167,6 +245,8 @@ class SmallWorldConnector(AbstractConnector, AbstractGenerateConnectorOnHost):
     @overrides(AbstractConnector.get_n_connections_to_post_vertex_maximum)
     def get_n_connections_to_post_vertex_maximum(
             self, synapse_info: SynapseInformation) -> int:
+        if self.__col_counts is not None:
+            return int(numpy.amax(self.__col_counts))
         assert self.__mask is not None
         return numpy.amax([
             numpy.sum(self.__mask[:, i]) for i in range(
@@ -177,6 +257,14 @@ class SmallWorldConnector(AbstractConnector, AbstractGenerateConnectorOnHost):
         return self._get_weight_maximum(
             synapse_info.weights, self.__n_connections, synapse_info)
 
+    @overrides(AbstractConnector.reserve_block_seeds)
+    def reserve_block_seeds(
+            self, post_slices: Sequence[Slice], post_vertex_slice: Slice,
+            synapse_info: SynapseInformation):
+        super().reserve_block_seeds(
+            post_slices, post_vertex_slice, synapse_info)
+        self._reserve_block_seed(self.__rng, post_vertex_slice)
+
     @overrides(AbstractGenerateConnectorOnHost.create_synaptic_block)
     def create_synaptic_block(
             self, post_slices: Sequence[Slice], post_vertex_slice: Slice,
@@ -201,14 +289,57 @@ class SmallWorldConnector(AbstractConnector, AbstractGenerateConnectorOnHost):
         block["synapse_type"] = synapse_type
 
         # Re-wire some connections
+        rng = self._get_block_rng(self.__rng, post_vertex_slice)
         rewired = numpy.where(
-            self.__rng.next(n_connections) < self.__rewiring)[0]
+            rng.next(n_connections) < self.__rewiring)[0]
         block["target"][rewired] = (
-            (self.__rng.next(rewired.size) * (post_vertex_slice.n_atoms - 1)) +
+            (rng.next(rewired.size) * (post_vertex_slice.n_atoms - 1)) +
             post_vertex_slice.lo_atom)
 
         return block
 
+    @overrides(AbstractGenerateConnectorOnMachine.generate_on_machine)
+    def generate_on_machine(self, synapse_info: SynapseInformation) -> bool:
+        if self.__layout is None:
+            return False
+        return super().generate_on_machine(synapse_info)
+
+    @property
+    @overrides(AbstractGenerateConnectorOnMachine.gen_connector_id)
+    def gen_connector_id(self) -> int:
+        return ConnectorIDs.SMALL_WORLD_CONNECTOR.value
+
+    @overrides(AbstractGenerateConnectorOnMachine.gen_connector_params)
+    def gen_connector_params(
+            self, synapse_info: SynapseInformation,
+            post_vertex_slice: Slice) -> NDArray[uint32]:
+        assert self.__layout is not None
+        length, layout = self.__layout
+        allow_self = (
+            self.__allow_self_connections or
+            synapse_info.pre_population != synapse_info.post_population)
+
+        # Support 1.0 by using maximum U032, as in FixedProbabilityConnector
+        rewiring = min(self.__rewiring, float(DataType.U032.max))
+        max_d2 = min((self.__degree / length) ** 2,
+                     float(DataType.S1615.max))
+        return numpy.concatenate((numpy.array([
+            int(allow_self), DataType.U032.encode_as_int(rewiring),
+            DataType.S1615.encode_as_int(max_d2)], dtype=uint32), layout))
+
+    @overrides(
+        AbstractGenerateConnectorOnMachine.gen_connector_params_size_in_bytes)
+    def gen_connector_params_size_in_bytes(
+            self, synapse_info: SynapseInformation) -> int:
+        return _N_GEN_PARAMS * BYTES_PER_WORD
+
+    @overrides(AbstractConnector.validate_connection)
+    def validate_connection(
+            self, application_edge: ProjectionApplicationEdge,
+            synapse_info: SynapseInformation):
+        if self.generate_on_machine(synapse_info):
+            check_rng(self.__rng, "SmallWorldConnector")
+
     def __repr__(self):
         return ("SmallWorldConnector"
                 f"(degree={self.__degree}, rewiring={self.__rewiring})")
@@ -230,6 +230,16 @@ class SynapseInformation(object):
         """
         return self.__weights
 
+    def set_weights(self, weights: Weight_Types):
+        """
+        Change the synaptic weights.
+
+        :param weights: The new synaptic weights
+        :type weights: float or list(float) or ~numpy.ndarray(float) or
+            ~pyNN.random.RandomDistribution
+        """
+        self.__weights = weights
+
     @property
     def delays(self) -> Delay_Types:
         """
@@ -41,6 +41,7 @@ from spinn_utilities.ranged.abstract_list import Selector
 from pacman.exceptions import PacmanConfigurationException
 from pacman.model.graphs.common import Slice
 from pacman.model.resources import AbstractSDRAM, MultiRegionSDRAM
+from pacman.model.routing_info import BaseKeyAndMask
 from pacman.utilities.utility_calls import get_n_bits
 
 from spinn_front_end_common.abstract_models import (
@@ -81,21 +82,25 @@ from spynnaker.pyNN.models.neuron.synapse_dynamics import (
     SynapseDynamicsStatic)
 from spynnaker.pyNN.models.neuron.synapse_dynamics.types import (
     NUMPY_CONNECTORS_DTYPE)
-from spynnaker.pyNN.models.spike_source import SpikeSourcePoissonVertex
+from spynnaker.pyNN.models.spike_source import (
+    SpikeSourceArrayVertex, SpikeSourcePoissonVertex)
 
-from spynnaker.pyNN.utilities.bit_field_utilities import get_sdram_for_keys
+from spynnaker.pyNN.utilities.bit_field_utilities import (
+    get_spikes_per_second, get_sdram_for_keys)
 from spynnaker.pyNN.utilities.buffer_data_type import BufferDataType
 from spynnaker.pyNN.utilities.constants import (
-    POSSION_SIGMA_SUMMATION_LIMIT)
+    POSSION_SIGMA_SUMMATION_LIMIT, SPIKE_PARTITION_ID)
 from spynnaker.pyNN.utilities.utility_calls import (
     create_mars_kiss_seeds, check_rng)
 from spynnaker.pyNN.utilities.running_stats import RunningStats
 from spynnaker.pyNN.utilities.struct import StructRepeat
 
 from .generator_data import GeneratorData
-from .master_pop_table import MasterPopTableAsBinarySearch
+from .master_pop_table import MAX_COLOUR_BITS, MasterPopTableAsBinarySearch
 from .population_machine_neurons import PopulationMachineNeurons
-from .synaptic_matrices import SYNAPSES_BASE_GENERATOR_SDRAM_USAGE_IN_BYTES
+from .synaptic_matrices import (
+    SYNAPSES_BASE_GENERATOR_SDRAM_USAGE_IN_BYTES, get_dirty_rows_size,
+    get_event_counters_size)
 from .synapse_io import get_max_row_info
 
 if TYPE_CHECKING:
@@ -124,18 +129,42 @@ _NEURON_GENERATOR_PER_STRUCT = 4 * BYTES_PER_WORD
 _NEURON_GENERATOR_PER_PARAM = 2 * BYTES_PER_WORD
 _NEURON_GENERATOR_PER_ITEM = (2 * BYTES_PER_WORD) + MAX_PARAMS_BYTES
 
+# The number of words of generator data for each range of constant values,
+# against the one word per neuron of the parameter itself
+_NEURON_GENERATOR_WORDS_PER_RANGE = 3
+
 # 1 for number of neurons
 # 1 for number of synapse types
 # 1 for number of neuron bits
 # 1 for number of synapse type bits
 # 1 for number of delay bits
+# 1 for number of ring buffer delay bits
 # 1 for drop late packets,
 # 1 for incoming spike buffer size
-_SYNAPSES_BASE_SDRAM_USAGE_IN_BYTES = 7 * BYTES_PER_WORD
+# 1 for dirty rows offset
+# 1 for event counters offset
+# 1 for whether to profile the ring buffers
+_SYNAPSES_BASE_SDRAM_USAGE_IN_BYTES = 11 * BYTES_PER_WORD
+
+#: The largest value of a ring buffer, which it is held at when saturated
+_RING_BUFFER_MAX = 0xFFFF
+
+# The names the neuron components give to the time step of the neurons
+_TIME_STEP_NAMES = ("time_step", "timestep", "timestep_ms")
 
 _EXTRA_RECORDABLE_UNITS = {NeuronRecorder.SPIKES: "",
                            NeuronRecorder.PACKETS: "",
-                           NeuronRecorder.REWIRING: ""}
+                           NeuronRecorder.REWIRING: "",
+                           **{phase: "" for phase in
+                              NeuronRecorder.SYNAPSE_PHASES},
+                           **{phase: "" for phase in
+                              NeuronRecorder.NEURON_PHASES},
+                           NeuronRecorder.TRANSFER_OFFSET: ""}
+
+# The variables that only split neuron and synapse cores record
+_SPLIT_CORE_RECORDABLES = frozenset((
+    *NeuronRecorder.SYNAPSE_PHASES, *NeuronRecorder.NEURON_PHASES,
+    NeuronRecorder.TRANSFER_OFFSET))
 
 
 def _prod(iterable):
@@ -151,6 +180,11 @@ def _all_gen(rd):
     """
     Determine if all the values of a ranged dictionary can be generated.
 
+    .. note::
+        Values given per neuron are only generated if they have enough
+        runs of the same value that generating them is smaller than writing
+        them.
+
     :rtype: bool
     """
     for key in rd.keys():
@@ -158,11 +192,14 @@ def _all_gen(rd):
             if not is_param_generatable(rd[key]):
                 return False
         else:
+            max_ranges = None
             if not rd[key].range_based():
-                return False
-            for _start, _stop, val in rd[key].iter_ranges():
+                max_ranges = len(rd[key]) // _NEURON_GENERATOR_WORDS_PER_RANGE
+            for i, (_start, _stop, val) in enumerate(rd[key].iter_ranges()):
                 if not is_param_generatable(val):
                     return False
+                if max_ranges is not None and i >= max_ranges:
+                    return False
     return True
 
 
@@ -185,6 +222,27 @@ def _is_structural(dynamics) -> TypeGuard[AbstractSynapseDynamicsStructural]:
     return isinstance(dynamics, AbstractSynapseDynamicsStructural)
 
 
+def _scale_time_step(values: RangeDictionary[float], multiple: int):
+    """
+    Make the time step given to the neurons a multiple of the time step of
+    the simulation.
+    """
+    time_step_ms = SpynnakerDataView.get_simulation_time_step_ms()
+    for name in _TIME_STEP_NAMES:
+        if name in values:
+            values[name] = time_step_ms * multiple
+
+
+def _check_n_colour_bits(n_colour_bits: int):
+    """
+    Check that the master population table can hold a number of colour bits.
+    """
+    if not 0 <= n_colour_bits <= MAX_COLOUR_BITS:
+        raise SpynnakerException(
+            f"The number of colour bits must be between 0 and "
+            f"{MAX_COLOUR_BITS}, not {n_colour_bits}")
+
+
 class AbstractPopulationVertex(
         PopulationApplicationVertex, AbstractAcceptsIncomingSynapses,
         AbstractCanReset, SupportsStructure):
@@ -224,7 +282,12 @@ class AbstractPopulationVertex(
         "__have_read_initial_values",
         "__last_parameter_read_time",
         "__n_colour_bits",
-        "__extra_partitions")
+        "__extra_partitions",
+        "__direct_pop_table",
+        "__timestep_multiple",
+        "__measured_max_weights",
+        "__last_ring_buffer_shifts",
+        "__fixed_key_and_mask")
 
     #: recording region IDs
     _SPIKE_RECORDING_REGION = 0
@@ -242,8 +305,9 @@ class AbstractPopulationVertex(
     _SYNAPSE_BASE_N_CPU_CYCLES = 10
 
     # Elements before the start of global parameters
-    # 1. has key, 2. key, 3. n atoms, 4. n_atoms_peak 5. n_colour_bits
-    CORE_PARAMS_BASE_SIZE = 5 * BYTES_PER_WORD
+    # 1. has key, 2. n atoms, 3. n_atoms_peak 4. n_colour_bits,
+    # 5. reload params, 6. timestep multiple, 7. n synapse types
+    CORE_PARAMS_BASE_SIZE = 7 * BYTES_PER_WORD
 
     def __init__(
             self, *, n_neurons: int, label: str,
@@ -256,7 +320,9 @@ class AbstractPopulationVertex(
             pynn_model: AbstractPyNNNeuronModel, drop_late_spikes: bool,
             splitter: Optional[SplitterAbstractPopulationVertex],
             seed: Optional[int], n_colour_bits: Optional[int],
-            extra_partitions: Optional[List[str]] = None):
+            extra_partitions: Optional[List[str]] = None,
+            direct_pop_table: Optional[bool] = None,
+            timestep_multiple: int = 1):
         """
         :param int n_neurons: The number of neurons in the population
         :param str label: The label on the population
@@ -287,6 +353,13 @@ class AbstractPopulationVertex(
         :param extra_partitions:
             Extra partitions that are to be sent by the vertex
         :type extra_partitions: list(str) or None
+        :param direct_pop_table:
+            Whether to try to index the master population table directly
+            rather than searching it
+        :type direct_pop_table: bool or None
+        :param int timestep_multiple:
+            The number of simulation time steps in each time step of the
+            neurons, for populations that can be updated less often
         """
         # pylint: disable=too-many-arguments
         super().__init__(label, max_atoms_per_core, splitter)
@@ -321,6 +394,11 @@ class AbstractPopulationVertex(
                 "the number of synapses in the neuron model "
                 f"({neuron_impl.get_n_synapse_types()})")
 
+        # The peak summed weights measured on the machine, if profiled
+        self.__measured_max_weights: Optional[NDArray[numpy.floating]] = None
+        self.__last_ring_buffer_shifts: Optional[List[int]] = None
+        self.__fixed_key_and_mask: Optional[BaseKeyAndMask] = None
+
         self.__drop_late_spikes = drop_late_spikes
         if self.__drop_late_spikes is None:
             self.__drop_late_spikes = get_config_bool(
@@ -333,25 +411,50 @@ class AbstractPopulationVertex(
         self.__initial_state_variables: RangeDictionary[float] = \
             RangeDictionary(n_neurons)
         self.__neuron_impl.add_state_variables(self.__initial_state_variables)
+        if timestep_multiple < 1:
+            raise SpynnakerException(
+                f"The timestep multiple must be at least 1, not "
+                f"{timestep_multiple}")
+        self.__timestep_multiple = timestep_multiple
+        if timestep_multiple > 1:
+            _scale_time_step(self.__parameters, timestep_multiple)
+            _scale_time_step(
+                self.__initial_state_variables, timestep_multiple)
         self.__state_variables = self.__initial_state_variables.copy()
         if n_colour_bits is None:
-            self.__n_colour_bits = get_config_int(
-                "Simulation", "n_colour_bits")
+            n_colour_bits = get_config_int("Simulation", "n_colour_bits")
+        _check_n_colour_bits(n_colour_bits)
+        self.__n_colour_bits = n_colour_bits
+        if direct_pop_table is None:
+            self.__direct_pop_table = get_config_bool(
+                "Simulation", "direct_pop_table")
         else:
-            self.__n_colour_bits = n_colour_bits
+            self.__direct_pop_table = direct_pop_table
 
         # Set up for recording
         neuron_recordable_variables = list(
             self.__neuron_impl.get_recordable_variables())
         record_data_types = dict(
             self.__neuron_impl.get_recordable_data_types())
+        # The neuron phase cycles are only recorded by split neuron cores
         self.__neuron_recorder = NeuronRecorder(
             neuron_recordable_variables, record_data_types,
-            [NeuronRecorder.SPIKES], n_neurons, [], {}, [], {})
+            [NeuronRecorder.SPIKES], n_neurons,
+            list(NeuronRecorder.NEURON_PHASES),
+            {phase: NeuronRecorder.NEURON_PHASES_TYPE
+             for phase in NeuronRecorder.NEURON_PHASES}, [], {})
+        # The synapse phase cycles and transfer offset are only recorded by
+        # split synapse cores
         self.__synapse_recorder = NeuronRecorder(
             [], {}, [],
-            n_neurons, [NeuronRecorder.PACKETS],
-            {NeuronRecorder.PACKETS: NeuronRecorder.PACKETS_TYPE},
+            n_neurons,
+            [NeuronRecorder.PACKETS, *NeuronRecorder.SYNAPSE_PHASES,
+             NeuronRecorder.TRANSFER_OFFSET],
+            {NeuronRecorder.PACKETS: NeuronRecorder.PACKETS_TYPE,
+             **{phase: NeuronRecorder.SYNAPSE_PHASES_TYPE
+                for phase in NeuronRecorder.SYNAPSE_PHASES},
+             NeuronRecorder.TRANSFER_OFFSET:
+                 NeuronRecorder.TRANSFER_OFFSET_TYPE},
             [NeuronRecorder.REWIRING],
             {NeuronRecorder.REWIRING: NeuronRecorder.REWIRING_TYPE})
 
@@ -421,11 +524,18 @@ class AbstractPopulationVertex(
         # Circularity
         # pylint: disable=import-outside-toplevel
         from spynnaker.pyNN.extra_algorithms.splitter_components import (
-            SplitterAbstractPopulationVertex as ValidSplitter)
+            SplitterAbstractPopulationVertex as ValidSplitter,
+            SplitterAbstractPopulationVertexNeuronsSynapses as SplitSplitter)
         if not isinstance(splitter, ValidSplitter):
             raise PacmanConfigurationException(
                 f"The splitter object on {self._label} must be set to one "
                 "capable of handling an AbstractPopulationVertex.")
+        recording = _SPLIT_CORE_RECORDABLES.intersection(
+            self.get_recording_variables())
+        if recording and not isinstance(splitter, SplitSplitter):
+            raise PacmanConfigurationException(
+                f"The splitter object on {self._label} must split neuron "
+                f"and synapse cores to record {sorted(recording)}")
         self._splitter = cast(Any, splitter)
         splitter.set_governed_app_vertex(self)
 
@@ -434,9 +544,45 @@ class AbstractPopulationVertex(
         max_atoms = super().get_max_atoms_per_core()
 
         # Dynamically adjust depending on the needs of the synapse dynamics
-        return min(
+        max_atoms = min(
             max_atoms, self.__synapse_dynamics.absolute_max_atoms_per_core)
 
+        # Keep the expected synaptic events of each core within the budget,
+        # shared between the synapse cores of each neuron core where split;
+        # multidimensional populations have their shape set by the user
+        budget = get_config_int(
+            "Simulation", "synaptic_events_per_time_step_budget")
+        if budget > 0 and len(self.atoms_shape) == 1:
+            if self.has_splitter:
+                budget *= self.splitter.n_synapse_vertices
+            per_neuron = self.get_synaptic_events_per_time_step()
+            if per_neuron > 0:
+                max_atoms = min(max_atoms, max(1, int(budget / per_neuron)))
+        return max_atoms
+
+    def get_synaptic_events_per_time_step(self) -> float:
+        """
+        Get the expected synaptic events each neuron receives in a time step
+        from all the incoming projections.
+
+        Each source is expected to spike at the highest rate of a Poisson
+        source, or the spikes_per_second of a population, and each neuron to
+        receive the largest number of connections of the connector.
+
+        :rtype: float
+        """
+        events_per_second = 0.0
+        for proj in self.incoming_projections:
+            # pylint: disable=protected-access
+            s_info = proj._synapse_information
+            connector = s_info.connector
+            n_conns = connector.get_n_connections_to_post_vertex_maximum(
+                s_info)
+            events_per_second += n_conns * get_spikes_per_second(
+                proj._projection_edge.pre_vertex)
+        return (events_per_second /
+                SpynnakerDataView.get_simulation_time_step_per_s())
+
     @overrides(
         PopulationApplicationVertex.get_max_atoms_per_dimension_per_core)
     def get_max_atoms_per_dimension_per_core(self) -> Tuple[int, ...]:
@@ -499,6 +645,21 @@ class AbstractPopulationVertex(
         """
         return self.__synapse_dynamics.is_combined_core_capable
 
+    def __makes_split_cores(self) -> bool:
+        """
+        Whether the vertex is split into neuron and synapse cores, by the
+        splitter if set, or else by the one that will be chosen for it.
+
+        :rtype: bool
+        """
+        if not self.has_splitter:
+            return not self.combined_core_capable
+        # Circularity
+        # pylint: disable=import-outside-toplevel
+        from spynnaker.pyNN.extra_algorithms.splitter_components import (
+            SplitterAbstractPopulationVertexNeuronsSynapses as SplitSplitter)
+        return isinstance(self._splitter, SplitSplitter)
+
     @property
     def n_synapse_cores_required(self) -> int:
         """
@@ -556,7 +717,9 @@ class AbstractPopulationVertex(
         self.__incoming_projections[pre_vertex].append(projection)
         if pre_vertex == self:
             self.__self_projection = projection
-        if isinstance(pre_vertex, SpikeSourcePoissonVertex):
+        if isinstance(pre_vertex, SpikeSourcePoissonVertex) or (
+                isinstance(pre_vertex, SpikeSourceArrayVertex) and
+                pre_vertex.compact):
             self.__incoming_poisson_projections.append(projection)
 
     @property
@@ -598,6 +761,16 @@ class AbstractPopulationVertex(
         """
         return self.__incoming_spike_buffer_size
 
+    def set_incoming_spike_buffer_size(self, incoming_spike_buffer_size: int):
+        """
+        Set the size of the incoming spike buffer to be used on the cores.
+
+        :param int incoming_spike_buffer_size: The spikes the buffer can hold
+        """
+        if incoming_spike_buffer_size != self.__incoming_spike_buffer_size:
+            self.__incoming_spike_buffer_size = incoming_spike_buffer_size
+            SpynnakerDataView.set_requires_data_generation()
+
     @property
     def parameters(self) -> RangeDictionary[float]:
         """
@@ -895,9 +1068,13 @@ class AbstractPopulationVertex(
 
     @overrides(PopulationApplicationVertex.get_recordable_variables)
     def get_recordable_variables(self) -> List[str]:
-        return [
+        variables = [
             *self.__neuron_recorder.get_recordable_variables(),
             *self.__synapse_recorder.get_recordable_variables()]
+        if self.__makes_split_cores():
+            return variables
+        return [name for name in variables
+                if name not in _SPLIT_CORE_RECORDABLES]
 
     @overrides(PopulationApplicationVertex.get_buffer_data_type)
     def get_buffer_data_type(self, name: str) -> BufferDataType:
@@ -911,6 +1088,11 @@ class AbstractPopulationVertex(
     def set_recording(
             self, name: str, sampling_interval: Optional[float] = None,
             indices: Optional[Collection[int]] = None):
+        if (name in _SPLIT_CORE_RECORDABLES and
+                not self.__makes_split_cores()):
+            raise KeyError(
+                f"It is not possible to record {name} on combined neuron "
+                "and synapse cores")
         if self.__neuron_recorder.is_recordable(name):
             self.__neuron_recorder.set_recording(
                 name, True, sampling_interval, indices)
@@ -953,6 +1135,27 @@ class AbstractPopulationVertex(
             return self.__synapse_recorder.get_data_type(name)
         raise KeyError(f"It is not possible to record {name}")
 
+    @overrides(PopulationApplicationVertex.set_recorded_data_type)
+    def set_recorded_data_type(self, name: str, data_type: DataType):
+        if self.__neuron_recorder.is_recordable(name):
+            self.__neuron_recorder.set_recorded_data_type(name, data_type)
+            return
+        if self.__synapse_recorder.is_recordable(name):
+            self.__synapse_recorder.set_recorded_data_type(name, data_type)
+            return
+        raise KeyError(f"It is not possible to record {name}")
+
+    @overrides(PopulationApplicationVertex.set_recording_aggregation)
+    def set_recording_aggregation(
+            self, name: str, aggregation: Optional[str]):
+        if self.__neuron_recorder.is_recordable(name):
+            self.__neuron_recorder.set_aggregation(name, aggregation)
+            return
+        if self.__synapse_recorder.is_recordable(name):
+            self.__synapse_recorder.set_aggregation(name, aggregation)
+            return
+        raise KeyError(f"It is not possible to record {name}")
+
     @overrides(PopulationApplicationVertex.get_recording_region)
     def get_recording_region(self, name: str) -> int:
         if self.__neuron_recorder.is_recordable(name):
@@ -1010,6 +1213,34 @@ class AbstractPopulationVertex(
         """
         self.synapse_dynamics = synapse_dynamics
 
+    def rewrite_projection_weights(
+            self, app_edge: ProjectionApplicationEdge,
+            synapse_info: SynapseInformation) -> bool:
+        """
+        Arrange for the synapses of an incoming projection whose weights
+        have changed to be written again at the next run, without mapping
+        or generating data again.
+
+        :param ProjectionApplicationEdge app_edge:
+            The edge of the projection
+        :param SynapseInformation synapse_info:
+            The synapse information of the projection
+        :return: Whether this can be done
+        :rtype: bool
+        """
+        # pylint: disable=import-outside-toplevel
+        from .population_machine_synapses import PopulationMachineSynapses
+        self.clear_connection_cache()
+        matrices = {
+            # pylint: disable=protected-access
+            id(vertex._synaptic_matrices): vertex._synaptic_matrices
+            for vertex in self.machine_vertices
+            if isinstance(vertex, PopulationMachineSynapses)}
+        if not matrices:
+            return False
+        return all(m.rewrite_weights(app_edge, synapse_info)
+                   for m in matrices.values())
+
     def clear_connection_cache(self) -> None:
         """
         Flush the cache of connection information; needed for a second run.
@@ -1090,6 +1321,14 @@ class AbstractPopulationVertex(
         # Reset state variables
         self.__state_variables.copy_into(self.__initial_state_variables)
 
+        # If the ring buffers were profiled and need different shifts, map
+        # again so that the next run uses them
+        if (self.__measured_max_weights is not None and
+                self.__last_ring_buffer_shifts is not None):
+            last_shifts = self.__last_ring_buffer_shifts
+            if self.get_ring_buffer_shifts() != last_shifts:
+                SpynnakerDataView.set_requires_mapping()
+
         # If synapses change during the run also regenerate these to get
         # back to the initial state
         if self.__synapse_dynamics.changes_during_run:
@@ -1186,6 +1425,9 @@ class AbstractPopulationVertex(
         if self.__max_expected_summed_weight is not None:
             max_weights[:] = self.__max_expected_summed_weight
             max_weights *= self.__neuron_impl.get_global_weight_scale()
+        elif (self.__measured_max_weights is not None and
+                not self.splitter.wide_ring_buffers):
+            max_weights[:] = self.__measured_max_weights
         else:
             stats = _Stats(self.__neuron_impl, self.__spikes_per_second,
                            self.__ring_buffer_sigma)
@@ -1199,7 +1441,14 @@ class AbstractPopulationVertex(
                 stats.add_projection(proj)
 
             for synapse_type in range(n_synapse_types):
-                max_weights[synapse_type] = stats.get_max_weight(synapse_type)
+                if self.splitter.wide_ring_buffers:
+                    # The sums can't saturate a 32-bit ring buffer entry, so
+                    # it is enough that each weight fits in a synaptic word
+                    max_weights[synapse_type] = stats.biggest_weight[
+                        synapse_type]
+                else:
+                    max_weights[synapse_type] = stats.get_max_weight(
+                        synapse_type)
 
         # Convert these to powers; we could use int.bit_length() for this if
         # they were integers, but they aren't...
@@ -1213,7 +1462,8 @@ class AbstractPopulationVertex(
             w + 1 if (2 ** w) <= a else w
             for w, a in zip(max_weight_powers, max_weights))
 
-        return list(max_weight_powers)
+        self.__last_ring_buffer_shifts = list(max_weight_powers)
+        return self.__last_ring_buffer_shifts
 
     @staticmethod
     def __get_weight_scale(ring_buffer_to_input_left_shift: int) -> float:
@@ -1273,9 +1523,57 @@ class AbstractPopulationVertex(
         :rtype: int
         """
         # This will only hold ring buffer scaling for the neuron synapse
-        # types
+        # types, followed by their peak values if these are profiled, and
+        # then the delay bits each of them needs
         return (_SYNAPSES_BASE_SDRAM_USAGE_IN_BYTES +
-                (BYTES_PER_WORD * self.__neuron_impl.get_n_synapse_types()))
+                (3 * BYTES_PER_WORD *
+                 self.__neuron_impl.get_n_synapse_types()))
+
+    @property
+    def ring_buffer_peaks_offset(self) -> int:
+        """
+        The offset in the synapse parameters of the shift of each synapse
+        type, which is followed by the peak ring buffer value of each
+        synapse type if these are profiled.
+
+        :rtype: int
+        """
+        return _SYNAPSES_BASE_SDRAM_USAGE_IN_BYTES
+
+    @property
+    def profiles_ring_buffers(self) -> bool:
+        """
+        Whether the cores note the peak ring buffer value of each synapse
+        type, so that a later run can choose the ring buffer shifts from
+        these rather than from the estimated maximum summed weights.
+
+        :rtype: bool
+        """
+        return bool(get_config_bool("Simulation", "profile_ring_buffers"))
+
+    def add_ring_buffer_peaks(
+            self, ring_buffer_shifts: Sequence[int], peaks: Sequence[int]):
+        """
+        Add the peak ring buffer values measured on a core, which are used
+        to choose the ring buffer shifts when next mapped.
+
+        :param list(int) ring_buffer_shifts:
+            The shifts that the core used for each synapse type
+        :param list(int) peaks:
+            The peak ring buffer value of each synapse type
+        """
+        # A ring buffer value of 2^16 is a weight of 2^(shift + 1); one that
+        # saturated might have needed any amount more, so ask for at least
+        # double the range
+        max_weights = numpy.array([
+            (2.0 if peak >= _RING_BUFFER_MAX else peak / 2 ** 16) *
+            2 ** (shift + 1)
+            for shift, peak in zip(ring_buffer_shifts, peaks)])
+        if self.__measured_max_weights is None:
+            self.__measured_max_weights = max_weights
+        else:
+            self.__measured_max_weights = numpy.maximum(
+                self.__measured_max_weights, max_weights)
 
     def get_synapse_dynamics_size(self, n_atoms: int) -> int:
         """
@@ -1319,10 +1617,39 @@ class AbstractPopulationVertex(
         if isinstance(self.__synapse_dynamics, AbstractLocalOnly):
             return 0
         addr = 2 * BYTES_PER_WORD
-        for proj in self.incoming_projections:
+        for proj in self.incoming_projections_in_layout_order:
             addr = self.__add_matrix_size(addr, proj, n_post_atoms)
+        if self.tracks_dirty_rows:
+            addr += get_dirty_rows_size(addr)
+        if self.counts_projection_events:
+            # Each projection has at most an undelayed and a delayed item
+            addr += get_event_counters_size(
+                2 * len(self.incoming_projections_in_layout_order))
         return addr
 
+    @property
+    def tracks_dirty_rows(self) -> bool:
+        """
+        Whether the cores note the synaptic rows that they write back, so
+        that only the rows that have changed are read again.
+
+        :rtype: bool
+        """
+        return (self.__synapse_dynamics.changes_during_run and
+                bool(get_config_bool(
+                    "Simulation", "delta_plastic_weight_readout")))
+
+    @property
+    def counts_projection_events(self) -> bool:
+        """
+        Whether the cores count the rows fetched, the words of those rows
+        and the packets filtered out for each incoming projection.
+
+        :rtype: bool
+        """
+        return bool(get_config_bool(
+            "Simulation", "count_projection_events"))
+
     def __add_matrix_size(self, address: int, projection: Projection,
                           n_post_atoms: int) -> int:
         """
@@ -1414,13 +1741,22 @@ class AbstractPopulationVertex(
                                       vertex.n_atoms))
                 n_sub_edges = int(math.ceil(vertex.n_atoms / max_atoms))
             size += self.__generator_info_size(synapse_info) * n_sub_edges
+            # Connector parameters are only sent to each core once per
+            # projection, which matters when they include the connections
+            # to the neurons of the core themselves
+            if synapse_info.may_generate_on_machine():
+                connector = cast(AbstractGenerateConnectorOnMachine,
+                                 synapse_info.connector)
+                size += connector.gen_connector_params_size_in_bytes(
+                    synapse_info)
         size += get_sdram_for_keys(self.incoming_projections)
         return size
 
     @staticmethod
     def __generator_info_size(synapse_info: SynapseInformation) -> int:
         """
-        The number of bytes required by the generator information.
+        The number of bytes required by the generator information of each
+        sub-edge, not including the connector parameters.
 
         :param SynapseInformation synapse_info: The synapse information to use
         :rtype: int
@@ -1434,7 +1770,6 @@ class AbstractPopulationVertex(
             GeneratorData.BASE_SIZE
             + connector.gen_delay_params_size_in_bytes(synapse_info.delays)
             + connector.gen_weight_params_size_in_bytes(synapse_info.weights)
-            + connector.gen_connector_params_size_in_bytes
             + synapse_info.synapse_dynamics.gen_matrix_params_size_in_bytes)
 
     @property
@@ -1570,6 +1905,27 @@ class AbstractPopulationVertex(
         for proj_list in self.__incoming_projections.values():
             yield from proj_list
 
+    @property
+    def incoming_projections_in_layout_order(self) -> Sequence[Projection]:
+        """
+        The projections that target this population vertex, in the order
+        that their synaptic matrices are laid out in SDRAM.
+
+        The projections from one source are always next to each other, as a
+        spike from the source reads a row of each of them.  If configured,
+        the sources expected to spike most often go first, so that their
+        rows are close together.
+
+        :rtype: list(~spynnaker.pyNN.models.projection.Projection)
+        """
+        sources = list(self.__incoming_projections)
+        if get_config_bool("Simulation", "order_synaptic_matrices_by_rate"):
+            # Stable, so sources at the same rate stay in the order added
+            sources.sort(key=lambda source: -(
+                get_spikes_per_second(source)))
+        return [proj for source in sources
+                for proj in self.__incoming_projections[source]]
+
     def get_incoming_projections_from(
             self, source_vertex: PopulationApplicationVertex
             ) -> Iterable[Projection]:
@@ -1585,7 +1941,8 @@ class AbstractPopulationVertex(
     def incoming_poisson_projections(self) -> Sequence[Projection]:
         """
         The projections that target this population vertex which
-        originate from a Poisson source.
+        originate from a Poisson source or a compact spike source array,
+        either of which might be sent over SDRAM.
 
         :rtype: iterable(~spynnaker.pyNN.models.projection.Projection)
         """
@@ -1649,7 +2006,64 @@ class AbstractPopulationVertex(
     def n_colour_bits(self) -> int:
         return self.__n_colour_bits
 
-    def get_max_delay(self, max_ring_buffer_bits: int) -> Tuple[int, bool]:
+    def set_n_colour_bits(self, n_colour_bits: int):
+        """
+        Set the number of colour bits of the spikes of the population; more
+        bits let the cores that receive them tell the time step of spikes
+        that arrive later.
+
+        :param int n_colour_bits: The number of colour bits
+        :raises SpynnakerException:
+            If the master population table cannot hold that many
+        """
+        _check_n_colour_bits(n_colour_bits)
+        if n_colour_bits != self.__n_colour_bits:
+            self.__n_colour_bits = n_colour_bits
+            SpynnakerDataView.set_requires_mapping()
+
+    @overrides(PopulationApplicationVertex.get_fixed_key_and_mask)
+    def get_fixed_key_and_mask(
+            self, partition_id: str) -> Optional[BaseKeyAndMask]:
+        if partition_id == SPIKE_PARTITION_ID:
+            return self.__fixed_key_and_mask
+        return None
+
+    def set_fixed_key_and_mask(
+            self, key_and_mask: Optional[BaseKeyAndMask]):
+        """
+        Set the key and mask of the spikes of the population, as planned by
+        :py:func:`.allocate_population_keys`, or None to have them allocated
+        with the other vertices.
+
+        :param key_and_mask: The key and mask
+        :type key_and_mask: ~pacman.model.routing_info.BaseKeyAndMask or None
+        """
+        self.__fixed_key_and_mask = key_and_mask
+
+    @property
+    def timestep_multiple(self) -> int:
+        """
+        The number of simulation time steps in each time step of the
+        neurons; the neurons are only updated on the first of each of these,
+        with the input of the others added up until then.
+
+        :rtype: int
+        """
+        return self.__timestep_multiple
+
+    @property
+    def direct_pop_table(self) -> bool:
+        """
+        Whether the master population table should be indexed directly
+        where possible, rather than searched.
+
+        :rtype: bool
+        """
+        return bool(self.__direct_pop_table)
+
+    def get_max_delay(
+            self, max_ring_buffer_bits: int,
+            compact: bool = False) -> Tuple[int, bool]:
         """
         Get the maximum delay and whether a delay extension is needed
         for a given maximum number of ring buffer bits.
@@ -1657,6 +2071,9 @@ class AbstractPopulationVertex(
         :param int max_ring_buffer_bits:
             The maximum number of bits that can be used for the ring buffer
             identifier (i.e. delay, synapse type, neuron index)
+        :param bool compact:
+            Whether the ring buffers have an entry for exactly each neuron
+            and synapse type, rather than for the next power of two of each
         :return:
             Tuple of the maximum delay supported on the core and whether
             a delay extension is needed to support delays
@@ -1679,11 +2096,44 @@ class AbstractPopulationVertex(
         n_synapse_bits = get_n_bits(
             self.neuron_impl.get_n_synapse_types())
         n_delay_bits = max_ring_buffer_bits - (n_atom_bits + n_synapse_bits)
+        if compact:
+            # Each synapse type has as many delay slots as it needs, up to
+            # the number for the core, so find the most that fit
+            n_atoms = min(self.n_atoms, self.get_max_atoms_per_core())
+            type_bits = self.get_synapse_type_delay_bits()
+            n_delay_bits = 0
+            while (n_delay_bits < max_delay_bits and n_atoms * sum(
+                    1 << min(n_delay_bits + 1, b) for b in type_bits) <=
+                    (1 << max_ring_buffer_bits)):
+                n_delay_bits += 1
 
         # Pick the smallest between the two, so that not too many bits are used
         final_n_delay_bits = min(n_delay_bits, max_delay_bits)
         return 2 ** final_n_delay_bits, max_delay_bits > final_n_delay_bits
 
+    def get_synapse_type_delay_bits(self) -> List[int]:
+        """
+        Get the number of bits needed for the delays of the incoming
+        synapses of each synapse type, so that each can have ring buffers of
+        only the depth its synapses need.
+
+        :rtype: list(int)
+        """
+        max_delay_ms = [0.0] * self.__neuron_impl.get_n_synapse_types()
+        for proj in self.incoming_projections:
+            # pylint: disable=protected-access
+            s_info = proj._synapse_information
+            # Skip if this is a synapse dynamics synapse type
+            if s_info.synapse_type_from_dynamics:
+                continue
+            max_delay_ms[s_info.synapse_type] = max(
+                max_delay_ms[s_info.synapse_type],
+                s_info.synapse_dynamics.get_delay_maximum(
+                    s_info.connector, s_info))
+        time_step_ms = SpynnakerDataView.get_simulation_time_step_ms()
+        return [get_n_bits(math.ceil(d / time_step_ms))
+                for d in max_delay_ms]
+
     def get_n_atom_bits(self) -> int:
         """
         :rtype: int
@@ -30,7 +30,8 @@ _population_parameters: Dict[str, Any] = {
     "spikes_per_second": None, "ring_buffer_sigma": None,
     "max_expected_summed_weight": None,
     "incoming_spike_buffer_size": None, "drop_late_spikes": None,
-    "splitter": None, "seed": None, "n_colour_bits": None
+    "splitter": None, "seed": None, "n_colour_bits": None,
+    "direct_pop_table": None, "timestep_multiple": 1
 }
 
 
@@ -64,7 +65,10 @@ class AbstractPyNNNeuronModel(AbstractPyNNModel):
             drop_late_spikes: Optional[bool] = None,
             splitter: Optional[SplitterAbstractPopulationVertex] = None,
             seed: Optional[int] = None,
-            n_colour_bits: Optional[int] = None) -> AbstractPopulationVertex:
+            n_colour_bits: Optional[int] = None,
+            direct_pop_table: Optional[bool] = None,
+            timestep_multiple: int = 1
+            ) -> AbstractPopulationVertex:
         """
         :param float spikes_per_second:
         :param float ring_buffer_sigma:
@@ -74,6 +78,8 @@ class AbstractPyNNNeuronModel(AbstractPyNNModel):
         :type splitter: SplitterAbstractPopulationVertex or None
         :param int seed:
         :param int n_colour_bits:
+        :param bool direct_pop_table:
+        :param int timestep_multiple:
         """
         # pylint: disable=arguments-differ
         max_atoms = self.get_model_max_atoms_per_dimension_per_core()
@@ -85,7 +91,9 @@ class AbstractPyNNNeuronModel(AbstractPyNNModel):
             incoming_spike_buffer_size=incoming_spike_buffer_size,
             neuron_impl=self.__model, pynn_model=self,
             drop_late_spikes=drop_late_spikes or False,
-            splitter=splitter, seed=seed, n_colour_bits=n_colour_bits)
+            splitter=splitter, seed=seed, n_colour_bits=n_colour_bits,
+            direct_pop_table=direct_pop_table,
+            timestep_multiple=timestep_multiple)
 
     @property
     @overrides(AbstractPyNNModel.name)
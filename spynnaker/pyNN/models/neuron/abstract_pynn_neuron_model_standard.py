@@ -79,6 +79,8 @@ class AbstractPyNNNeuronModelStandard(AbstractPyNNNeuronModel):
             drop_late_spikes: Optional[bool] = None,
             splitter: Optional[SplitterAbstractPopulationVertex] = None,
             seed: Optional[int] = None, n_colour_bits: Optional[int] = None,
+            direct_pop_table: Optional[bool] = None,
+            timestep_multiple: int = 1,
             n_steps_per_timestep: int = 1) -> AbstractPopulationVertex:
         """
         :param int n_steps_per_timestep:
@@ -93,4 +95,6 @@ class AbstractPyNNNeuronModelStandard(AbstractPyNNNeuronModel):
             max_expected_summed_weight=max_expected_summed_weight,
             incoming_spike_buffer_size=incoming_spike_buffer_size,
             drop_late_spikes=drop_late_spikes,
-            splitter=splitter, seed=seed, n_colour_bits=n_colour_bits)
+            splitter=splitter, seed=seed, n_colour_bits=n_colour_bits,
+            direct_pop_table=direct_pop_table,
+            timestep_multiple=timestep_multiple)
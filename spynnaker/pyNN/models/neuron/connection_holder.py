@@ -12,13 +12,15 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import os
+import tempfile
 from typing import (
     Any, Callable, Iterator, List, Optional, Sequence, Tuple, Union)
 
 import numpy
 from numpy.lib.recfunctions import merge_arrays
 from numpy.typing import NDArray
-from typing_extensions import TypeAlias, TypeGuard
+from typing_extensions import TypeAlias
 
 from spynnaker.pyNN.models.neuron.synapse_dynamics.types import (
     ConnectionsArray)
@@ -27,8 +29,62 @@ _ItemType: TypeAlias = numpy.floating
 _Items: TypeAlias = Union[Tuple[NDArray[_ItemType], ...], NDArray[_ItemType]]
 
 
-def _is_listable(value: Any) -> TypeGuard[Sequence[Any]]:
-    return hasattr(value, "__len__")
+class _MappedConnections(object):
+    """
+    Connections held in a temporary file that is mapped into memory when
+    read, so that more can be held than fit in host memory.
+    """
+
+    __slots__ = (
+        # The file holding the connections
+        "__file",
+        # The dtype of the connections
+        "__dtype",
+        # The number of connections in the file
+        "__n_connections",
+        # The number of arrays of connections added
+        "__n_arrays")
+
+    def __init__(self) -> None:
+        self.__file = tempfile.TemporaryFile(prefix="connections_")
+        self.__dtype: Optional[numpy.dtype] = None
+        self.__n_connections = 0
+        self.__n_arrays = 0
+
+    def append(self, connections: ConnectionsArray):
+        """
+        Add connections to the end of the file.
+
+        :param ~numpy.ndarray connections: The connections to add
+        """
+        if self.__dtype is None:
+            self.__dtype = connections.dtype
+        self.__file.seek(0, os.SEEK_END)
+        connections.astype(self.__dtype, copy=False).tofile(self.__file)
+        self.__n_connections += len(connections)
+        self.__n_arrays += 1
+
+    @property
+    def n_arrays(self) -> int:
+        """
+        The number of arrays of connections added.
+
+        :rtype: int
+        """
+        return self.__n_arrays
+
+    def get_array(self) -> ConnectionsArray:
+        """
+        Get all the connections added, mapped from the file.
+
+        :rtype: ~numpy.ndarray
+        """
+        if self.__n_connections == 0:
+            return numpy.zeros(0, dtype=self.__dtype)
+        self.__file.flush()
+        return numpy.memmap(
+            self.__file, dtype=self.__dtype, mode="r",
+            shape=(self.__n_connections,))
 
 
 class ConnectionHolder(object):
@@ -53,6 +109,9 @@ class ConnectionHolder(object):
         # A list of the connections that have been added
         "__connections",
 
+        # The connections that have been added when held in a file instead
+        "__mapped",
+
         # The merged connections formed just before the data is read
         "__data_items",
 
@@ -70,7 +129,8 @@ class ConnectionHolder(object):
             n_pre_atoms: int, n_post_atoms: int,
             connections: Optional[List[ConnectionsArray]] = None,
             fixed_values: Optional[List[Tuple[str, int]]] = None,
-            notify: Optional[Callable[['ConnectionHolder'], None]] = None):
+            notify: Optional[Callable[['ConnectionHolder'], None]] = None,
+            memory_mapped: bool = False):
         """
         :param data_items_to_return: A list of data fields to be returned
         :type data_items_to_return: list(str) or tuple(str) or None
@@ -98,6 +158,10 @@ class ConnectionHolder(object):
             This should accept a single parameter, which will contain the
             data requested
         :type notify: callable(ConnectionHolder, None) or None
+        :param bool memory_mapped:
+            Whether to hold the connections added in a temporary file that is
+            mapped into memory, rather than in memory, for projections with
+            more synapses than fit in host memory
         """
         # pylint: disable=too-many-arguments
         self.__data_items_to_return = data_items_to_return
@@ -108,6 +172,9 @@ class ConnectionHolder(object):
         self.__data_items: Optional[_Items] = None
         self.__notify = notify
         self.__fixed_values = fixed_values
+        self.__mapped: Optional[_MappedConnections] = None
+        if memory_mapped:
+            self.__mapped = _MappedConnections()
 
     def add_connections(self, connections: ConnectionsArray):
         """
@@ -117,6 +184,9 @@ class ConnectionHolder(object):
             The connection to add, as a numpy structured array of
             source, target, weight and delay
         """
+        if self.__mapped is not None:
+            self.__mapped.append(connections)
+            return
         if self.__connections is None:
             self.__connections = list()
         self.__connections.append(connections)
@@ -128,8 +198,19 @@ class ConnectionHolder(object):
 
         :rtype: list(~numpy.ndarray)
         """
+        if self.__mapped is not None and self.__mapped.n_arrays:
+            return [self.__mapped.get_array()]
         return self.__connections or []
 
+    @property
+    def is_list(self) -> bool:
+        """
+        Whether the data is returned as a list rather than as matrices.
+
+        :rtype: bool
+        """
+        return self.__as_list
+
     def finish(self) -> None:
         """
         Finish adding connections.
@@ -145,6 +226,77 @@ class ConnectionHolder(object):
         if self.__data_items is not None:
             return self.__data_items
 
+        connections = self.__merged_connections()
+
+        # If we are returning a list...
+        if self.__as_list:
+            # ...sort by source then target
+            order = numpy.lexsort(
+                (connections["target"], connections["source"]))
+            data_items = self.__select_items(
+                self.__add_fixed_values(connections[order]))
+
+            # Return in a format which can be understood by a
+            # FromListConnector; converting the whole array at once is much
+            # faster than going through it an item at a time
+            items: List[Any] = data_items.tolist()
+            if data_items.dtype.names is not None:
+                items = [list(data_item) for data_item in items]
+            self.__data_items = tuple(items)
+
+        else:
+            if self.__data_items_to_return is None:
+                return ()
+            connections = self.__add_fixed_values(connections)
+
+            # Keep track of the matrices
+            merged: List[NDArray[_ItemType]] = []
+            for item in self.__data_items_to_return:
+                # Build an empty matrix and fill it with NAN
+                matrix = numpy.empty((self.__n_pre_atoms, self.__n_post_atoms))
+                matrix.fill(numpy.nan)
+
+                # Fill in the values that have data
+                # TODO: Change this to sum the items with the same
+                #       (source, target) pairs
+                matrix[connections["source"], connections["target"]] = \
+                    connections[item]
+
+                # Store the matrix generated
+                merged.append(matrix)
+
+            # If there is only one matrix, use it directly
+            # Otherwise use a tuple of the matrices
+            self.__data_items = (
+                merged[0] if len(merged) == 1 else tuple(merged))
+
+        return self.__data_items
+
+    def iter_list_chunks(self, chunk_size: int) -> Iterator[NDArray]:
+        """
+        Go through the data to be returned as a list, sorted by source then
+        target, a chunk at a time, without making the whole list.
+
+        :param int chunk_size: The number of connections in each chunk
+        :return: The items of each chunk of connections, as a structured
+            array, or a plain array if there is one item
+        :rtype: iterable(~numpy.ndarray)
+        """
+        connections = self.__merged_connections()
+        order = numpy.lexsort((connections["target"], connections["source"]))
+        for start in range(0, len(order), chunk_size):
+            yield self.__select_items(self.__add_fixed_values(
+                connections[order[start:start + chunk_size]]))
+
+    def __merged_connections(self) -> ConnectionsArray:
+        """
+        Get all the connections that have been added, as one array.
+
+        :rtype: ~numpy.ndarray
+        """
+        if self.__mapped is not None and self.__mapped.n_arrays:
+            return self.__mapped.get_array()
+
         if not self.__connections:
             # If there are no connections added, raise an exception
             if self.__connections is None:
@@ -163,9 +315,15 @@ class ConnectionHolder(object):
 
         # Join all the connections that have been added (probably over multiple
         # sub-vertices of a population)
-        connections: ConnectionsArray = numpy.concatenate(self.__connections)
+        return numpy.concatenate(self.__connections)
 
-        # If there are additional fixed values, merge them in
+    def __add_fixed_values(self, connections: ConnectionsArray) -> NDArray:
+        """
+        Add the fixed values to each of some connections, if there are any.
+
+        :param ~numpy.ndarray connections: The connections
+        :rtype: ~numpy.ndarray
+        """
         if self.__fixed_values:
             # Generate a numpy type for the fixed values
             fixed_dtypes = [
@@ -183,63 +341,24 @@ class ConnectionHolder(object):
             # Add the fixed values to the connections
             connections = merge_arrays(
                 (connections, fixed_values), flatten=True)
+        return connections
 
-        # If we are returning a list...
-        if self.__as_list:
-            # ...sort by source then target
-            order = numpy.lexsort(
-                (connections["target"], connections["source"]))
-
-            # There are no specific items to return, so just get
-            # all the data
-            if (self.__data_items_to_return is None or
-                    not self.__data_items_to_return):
-                data_items = connections[order]
-            # There is more than one item to return, so let numpy do its magic
-            elif len(self.__data_items_to_return) > 1:
-                data_items = \
-                    connections[order][self.__data_items_to_return]
-            # There is 1 item to return, so make sure only one item exists
-            else:
-                data_items = \
-                    connections[order][self.__data_items_to_return[0]]
-
-            # Return in a format which can be understood by a FromListConnector
-            items: List[Any] = []
-            # NB: The types in here are all wrong, but that's
-            for data_item in data_items:
-                if _is_listable(data_item):
-                    items.append(list(data_item))
-                else:
-                    items.append(data_item)
-            self.__data_items = tuple(items)
-
-        else:
-            if self.__data_items_to_return is None:
-                return ()
-
-            # Keep track of the matrices
-            merged: List[NDArray[_ItemType]] = []
-            for item in self.__data_items_to_return:
-                # Build an empty matrix and fill it with NAN
-                matrix = numpy.empty((self.__n_pre_atoms, self.__n_post_atoms))
-                matrix.fill(numpy.nan)
-
-                # Fill in the values that have data
-                # TODO: Change this to sum the items with the same
-                #       (source, target) pairs
-                matrix[connections["source"], connections["target"]] = \
-                    connections[item]
-
-                # Store the matrix generated
-                merged.append(matrix)
-
-            # If there is only one matrix, use it directly
-            # Otherwise use a tuple of the matrices
-            self.__data_items = (
-                merged[0] if len(merged) == 1 else tuple(merged))
+    def __select_items(self, connections: NDArray) -> NDArray:
+        """
+        Select the items to return from some connections to be returned as
+        a list.
 
-        return self.__data_items
+        :param ~numpy.ndarray connections: The connections
+        :rtype: ~numpy.ndarray
+        """
+        # There are no specific items to return, so just get all the data
+        if not self.__data_items_to_return:
+            return connections
+        # There is more than one item to return, so let numpy do its magic
+        if len(self.__data_items_to_return) > 1:
+            return connections[self.__data_items_to_return]
+        # There is 1 item to return, so make sure only one item exists
+        return connections[self.__data_items_to_return[0]]
 
     def __getitem__(self, s):
         data = self._get_data_items()
@@ -23,6 +23,7 @@ from spynnaker.pyNN.models.neural_projections.connectors import (
     AbstractGenerateConnectorOnMachine)
 
 if TYPE_CHECKING:
+    from pacman.model.graphs.common import Slice
     from spynnaker.pyNN.models.neural_projections import (
         ProjectionApplicationEdge, SynapseInformation)
     from spynnaker.pyNN.models.neuron.synapse_io import MaxRowInfo
@@ -44,7 +45,8 @@ class GeneratorData(object):
             delayed_synaptic_matrix_offset: Optional[int],
             app_edge: ProjectionApplicationEdge,
             synapse_information: SynapseInformation, max_row_info: MaxRowInfo,
-            max_pre_atoms_per_core: int, max_post_atoms_per_core: int):
+            max_pre_atoms_per_core: int, max_post_atoms_per_core: int,
+            post_vertex_slice: Slice):
         # Offsets are used in words in the generator, but only
         # if the values are valid
         if synaptic_matrix_offset is not None:
@@ -80,7 +82,8 @@ class GeneratorData(object):
             synaptic_matrix_offset, delayed_synaptic_matrix_offset, app_edge,
             synapse_information, max_row_info, max_pre_atoms_per_core,
             max_post_atoms_per_core))
-        self.__data.append(connector.gen_connector_params(synapse_information))
+        self.__data.append(connector.gen_connector_params(
+            synapse_information, post_vertex_slice))
         self.__data.append(connector.gen_weights_params(
             synapse_information.weights))
         self.__data.append(connector.gen_delay_params(
@@ -14,8 +14,7 @@
 from __future__ import annotations
 import ctypes
 import math
-from typing import (
-    Dict, Iterable, List, Sequence, Tuple, Type, TypeVar, TYPE_CHECKING)
+from typing import Dict, Iterable, List, NamedTuple, Tuple, TYPE_CHECKING
 
 import numpy
 from numpy import uint32
@@ -32,8 +31,6 @@ from spynnaker.pyNN.utilities.bit_field_utilities import BIT_IN_A_WORD
 
 if TYPE_CHECKING:
     from spynnaker.pyNN.models.projection import Projection
-    # pylint: disable=no-member, protected-access
-    _T = TypeVar("_T", bound=ctypes._CData)
 
 
 # Scale factor for an address; allows more addresses to be represented, but
@@ -69,20 +66,6 @@ def _n_bits(field) -> int:
     return _BITS_PER_BYTES * field.size
 
 
-def _make_array(ctype: Type[_T], n_items: int) -> ctypes.Array[_T]:
-    """
-    Make an array of ctype items; done separately as the syntax is a
-    little odd!
-
-    :param _ctypes.PyCSimpleType ctype: A ctype
-    :param int n_items: The number of items in the array
-    :return: a ctype array
-    :rtype: _ctypes.PyCArrayType
-    """
-    array_type = ctype * n_items
-    return array_type()
-
-
 class _MasterPopEntryCType(ctypes.LittleEndianStructure):
     """
     A Master Population Table Entry; matches the C struct.
@@ -141,200 +124,56 @@ _MAX_ADDRESS = (1 << _n_bits(_AddressListEntryCType.address)) - 2
 _MASTER_POP_ENTRY_SIZE_BYTES = ctypes.sizeof(_MasterPopEntryCType)
 _ADDRESS_LIST_ENTRY_SIZE_BYTES = ctypes.sizeof(_AddressListEntryCType)
 
-# Base size - 2 words for size of table and address list
-_BASE_SIZE_BYTES = 8
+# Base size - 3 words for size of table and address list, and format
+_BASE_SIZE_BYTES = 12
 
-# Number of times to multiply for delays
-_DELAY_SCALE = 2
+# The formats of the table
+_STANDARD_FORMAT = 0
+_EXTENDED_FORMAT = 1
 
-# A ctypes pointer to a uint32
-_UINT32_PTR = ctypes.POINTER(ctypes.c_uint32)
+# In the extended format, each entry has its start in a word, and each
+# address list entry is a word of row length and a word of offset in bytes
+_EXTENDED_START_SIZE_BYTES = BYTES_PER_WORD
+_EXTENDED_ADDRESS_LIST_ENTRY_SIZE_BYTES = 2 * BYTES_PER_WORD
 
+# The offset of an invalid address in the extended format
+_INVALID_EXTENDED_OFFSET = 0xFFFFFFFF
 
-def _to_numpy(array) -> NDArray[uint32]:
-    """
-    Convert a ctypes array to a numpy array of uint32.
+# The maximum address in the extended format, divided by _ADDRESS_SCALE
+_MAX_EXTENDED_ADDRESS = (_INVALID_EXTENDED_OFFSET - 1) // _ADDRESS_SCALE
 
-    .. note::
-        No data copying is done; it is pure type conversion.  Editing
-        the returned array will result in changes to the original.
+# Size of the direct lookup header - 2 words for shift and number of bits
+_DIRECT_LOOKUP_BASE_SIZE_BYTES = 8
 
-    :param _ctypes.PyCArrayType array: The array to convert
-    :rtype: numpy.ndarray
-    """
-    # Nothing to do if the array is 0 sized
-    if len(array) == 0:
-        return numpy.zeros(0, dtype=uint32)
+# The maximum number of key bits used to index the table directly
+_MAX_DIRECT_LOOKUP_BITS = 10
 
-    uint32_array = ctypes.cast(array, _UINT32_PTR)
-    n_words = (len(array) * ctypes.sizeof(array[0])) // BYTES_PER_WORD
-    return numpy.ctypeslib.as_array(uint32_array, (n_words,))
+# The maximum ratio of direct lookup index size to table entries
+_MAX_DIRECT_LOOKUP_SPARSITY = 4
 
+# The value of a direct lookup index with no entry
+_NO_DIRECT_ENTRY = 0xFFFF
 
-class _MasterPopEntry(object):
-    """
-    Internal class that contains a master population table entry.
-    """
-    __slots__ = (
-        "__addresses_and_row_lengths",
-        # The mask to match this entry on
-        "__mask",
-        # The routing key to match this entry on
-        "__routing_key",
-        # The part of the key where the core id is held after shifting (below)
-        "__core_mask",
-        # Where in the key that the core id is held
-        "__core_shift",
-        # The number of neurons on every core except the last
-        "__n_neurons",
-        # The number of bits reserved for the colour
-        "__n_colour_bits")
-
-    def __init__(self, routing_key: int, mask: int, core_mask: int,
-                 core_shift: int, n_neurons: int, n_colour_bits: int):
-        """
-        :param int routing_key: The key to match for this entry
-        :param int mask: The mask to match for this entry
-        :param int core_mask:
-            The part of the routing_key where the core id is held
-        :param int core_shift: Where in the routing_key the core_id is held
-        :param int n_neurons:
-            The number of neurons on each core, except the last
-        """
-        self.__routing_key = routing_key
-        self.__mask = mask
-        self.__core_mask = core_mask
-        self.__core_shift = core_shift
-        self.__n_neurons = n_neurons
-        self.__n_colour_bits = n_colour_bits
-        self.__addresses_and_row_lengths: List[Tuple[int, int, bool]] = list()
-
-    def append(self, address: int, row_length: int) -> int:
-        """
-        Add a synaptic matrix pointer to the entry.
-
-        :param int address: The address of the synaptic matrix
-        :param int row_length: The length of each row in the matrix
-        :return: The index of the pointer within the entry
-        :rtype: int
-        """
-        index = len(self.__addresses_and_row_lengths)
-        if index > _MAX_ADDRESS_COUNT:
-            raise SynapticConfigurationException(
-                f"{index} connections for the same source key "
-                f"(maximum {_MAX_ADDRESS_COUNT})")
-        self.__addresses_and_row_lengths.append(
-            (address, row_length, True))
-        return index
-
-    def append_invalid(self) -> int:
-        """
-        Add an invalid marker to the entry; used to ensure index alignment
-        between multiple entries when necessary.
-
-        :return: The index of the marker within the entry
-        :rtype: int
-        """
-        index = len(self.__addresses_and_row_lengths)
-        self.__addresses_and_row_lengths.append((0, 0, False))
-        return index
-
-    @property
-    def routing_key(self) -> int:
-        """
-        The key combo of this entry.
-
-        :rtype: int
-        """
-        return self.__routing_key
-
-    @property
-    def mask(self) -> int:
-        """
-        The mask of the key for this entry.
-
-        :rtype: int
-        """
-        return self.__mask
-
-    @property
-    def core_mask(self) -> int:
-        """
-        The mask of the key once shifted to get the source core ID.
-
-        :rtype: int
-        """
-        return self.__core_mask
-
-    @property
-    def core_shift(self) -> int:
-        """
-        The shift of the key to get the source core ID.
-
-        :rtype: int
-        """
-        return self.__core_shift
+# Number of times to multiply for delays
+_DELAY_SCALE = 2
 
-    @property
-    def n_neurons(self) -> int:
-        """
-        The number of neurons per source core.
+# Where the fields are in the words of a table entry, from the ctypes layout
+_START_SHIFT = 0
+_N_COLOUR_BITS_SHIFT = _n_bits(_MasterPopEntryCType.start)
+_COUNT_SHIFT = (
+    _N_COLOUR_BITS_SHIFT + _n_bits(_MasterPopEntryCType.n_colour_bits))
 
-        :rtype: int
-        """
-        return self.__n_neurons
+#: The most colour bits that a table entry can hold
+MAX_COLOUR_BITS = (1 << _n_bits(_MasterPopEntryCType.n_colour_bits)) - 1
+_MASK_SHIFT_SHIFT = _n_bits(_MasterPopEntryCType.core_mask)
+_N_WORDS_SHIFT = _n_bits(_MasterPopEntryCType.n_neurons)
+_ENTRY_WORDS = _MASTER_POP_ENTRY_SIZE_BYTES // BYTES_PER_WORD
 
-    @property
-    def addresses_and_row_lengths(self) -> Sequence[Tuple[int, int, bool]]:
-        """
-        The memory address that this master pop entry points at
-        (in the synaptic matrix).
+# Where the address is in an address list entry
+_ADDRESS_SHIFT = _n_bits(_AddressListEntryCType.row_length)
 
-        :rtype: list(tuple(int,int,bool))
-        """
-        return self.__addresses_and_row_lengths
-
-    def write_to_table(
-            self, entry: _MasterPopEntryCType,
-            address_list: ctypes.Array[_AddressListEntryCType],
-            start: int) -> int:
-        """
-        Write entries to the master population table.
-
-        :param _MasterPopEntryCType entry: The entry to write to
-        :param _AddressListEntryCType_Array address_list:
-            The address_list to write to
-        :param int start:
-            The index of the entry of the address list to start at
-        :return: The number of entries written to the address list
-        :rtype: int
-        """
-        entry.key = self.__routing_key
-        entry.mask = self.__mask
-        entry.start = start
-        count = len(self.__addresses_and_row_lengths)
-        entry.count = count
-
-        # Mark where the next entry starts and the number added; this might
-        # change if there is extra info
-        next_addr = start
-        n_entries = count
-
-        entry.n_colour_bits = self.__n_colour_bits
-        entry.core_mask = self.__core_mask
-        entry.n_words = int(math.ceil(self.__n_neurons / BIT_IN_A_WORD))
-        entry.n_neurons = self.__n_neurons
-        entry.mask_shift = self.__core_shift
-
-        for j, (address, row_length, is_valid) in enumerate(
-                self.__addresses_and_row_lengths):
-            address_entry = address_list[next_addr + j]
-            if not is_valid:
-                address_entry.address = _INVALID_ADDDRESS
-            else:
-                address_entry.row_length = row_length
-                address_entry.address = address
-        return n_entries
+# The number of columns given to make_pop_table_data for each address
+_N_COLUMNS = 9
 
 
 class MasterPopTableAsBinarySearch(object):
@@ -342,24 +181,36 @@ class MasterPopTableAsBinarySearch(object):
     Master population table, implemented as binary search master.
     """
     __slots__ = (
+        # The details of each key, to check that they match when added again
         "__entries",
-        "__n_addresses")
+        # The number of addresses of each key so far
+        "__counts",
+        # The columns of the address list, in the order added
+        "__columns")
 
     def __init__(self) -> None:
-        self.__entries: Dict[int, _MasterPopEntry] = {}
-        self.__n_addresses = 0
+        self.__entries: Dict[int, Tuple[int, int, int, int, int]] = {}
+        self.__counts: Dict[int, int] = {}
+        self.__columns: Tuple[List[int], ...] = tuple(
+            list() for _ in range(_N_COLUMNS))
 
     @staticmethod
     def get_master_population_table_size(
-            incoming_projections: Iterable[Projection]) -> int:
+            incoming_projections: Iterable[Projection],
+            direct_lookup: bool = False, synaptic_matrix_size: int = 0) -> int:
         """
-        Get the size of the master population table in SDRAM.
+        Get the size of the master population table in SDRAM.  This allows
+        for the extended format if the table is too big for the standard one.
 
         :param incoming_projections:
             The projections arriving at the vertex that are to be handled by
             this table
         :type incoming_projections:
             list(~spynnaker.pyNN.models.projection.Projection)
+        :param bool direct_lookup:
+            Whether space should be left for a direct lookup index
+        :param int synaptic_matrix_size:
+            The size of the synaptic matrix region the table points into
         :return: the size the master pop table will take in SDRAM (in bytes)
         :rtype: int
         """
@@ -384,10 +235,19 @@ class MasterPopTableAsBinarySearch(object):
                 if in_edge.n_delay_stages:
                     n_vertices += 1
 
+        if _needs_extended_format(
+                n_entries, synaptic_matrix_size // _ADDRESS_SCALE):
+            entry_size = (
+                _MASTER_POP_ENTRY_SIZE_BYTES + _EXTENDED_START_SIZE_BYTES)
+            address_size = _EXTENDED_ADDRESS_LIST_ENTRY_SIZE_BYTES
+        else:
+            entry_size = _MASTER_POP_ENTRY_SIZE_BYTES
+            address_size = _ADDRESS_LIST_ENTRY_SIZE_BYTES
         return (
             _BASE_SIZE_BYTES +
-            (n_vertices * _MASTER_POP_ENTRY_SIZE_BYTES) +
-            (n_entries * _ADDRESS_LIST_ENTRY_SIZE_BYTES))
+            (n_vertices * entry_size) + (n_entries * address_size) +
+            _DIRECT_LOOKUP_BASE_SIZE_BYTES +
+            (_direct_lookup_max_n_bytes(n_vertices) if direct_lookup else 0))
 
     @staticmethod
     def get_allowed_row_length(row_length: int) -> int:
@@ -418,7 +278,7 @@ class MasterPopTableAsBinarySearch(object):
             if the address is out of range
         """
         addr_scaled = (next_address + (_ADDRESS_SCALE - 1)) // _ADDRESS_SCALE
-        if addr_scaled > _MAX_ADDRESS:
+        if addr_scaled > _MAX_EXTENDED_ADDRESS:
             raise SynapticConfigurationException(
                 f"Address {hex(addr_scaled * _ADDRESS_SCALE)} is "
                 "out of range for this population table!")
@@ -429,7 +289,8 @@ class MasterPopTableAsBinarySearch(object):
         Initialise the master pop data structure.
         """
         self.__entries = dict()
-        self.__n_addresses = 0
+        self.__counts = dict()
+        self.__columns = tuple(list() for _ in range(_N_COLUMNS))
 
     def add_application_entry(
             self, block_start_addr: int, row_length: int,
@@ -498,16 +359,14 @@ class MasterPopTableAsBinarySearch(object):
                 f"Address {block_start_addr} is not compatible "
                 "with this table")
         start_addr = block_start_addr // _ADDRESS_SCALE
-        if start_addr > _MAX_ADDRESS:
+        if start_addr > _MAX_EXTENDED_ADDRESS:
             raise SynapticConfigurationException(
                 f"Address {block_start_addr} is too big for this table")
         row_length = self.get_allowed_row_length(row_length)
 
-        entry = self.__add_entry(
-            key_and_mask, core_mask, core_shift, n_neurons, n_colour_bits)
-        index = entry.append(start_addr, row_length - 1)
-        self.__n_addresses += 1
-        return index
+        return self.__add_entry(
+            key_and_mask, core_mask, core_shift, n_neurons, n_colour_bits,
+            start_addr, row_length - 1, True)
 
     def add_invalid_application_entry(
             self, key_and_mask: BaseKeyAndMask, core_mask: int,
@@ -569,63 +428,87 @@ class MasterPopTableAsBinarySearch(object):
         :return: The index of the added entry
         :rtype: int
         """
-        entry = self.__add_entry(
-            key_and_mask, core_mask, core_shift, n_neurons, n_colour_bits)
-        index = entry.append_invalid()
-        self.__n_addresses += 1
-        return index
+        return self.__add_entry(
+            key_and_mask, core_mask, core_shift, n_neurons, n_colour_bits,
+            0, 0, False)
 
     def __add_entry(
             self, key_and_mask: BaseKeyAndMask, core_mask: int,
-            core_shift: int, n_neurons: int,
-            n_colour_bits: int) -> _MasterPopEntry:
-        if self.__n_addresses >= _MAX_ADDRESS_START:
-            raise SynapticConfigurationException(
-                f"The table already contains {self.__n_addresses} entries;"
-                " adding another is too many")
-        if key_and_mask.key not in self.__entries:
-            entry = _MasterPopEntry(
-                key_and_mask.key, key_and_mask.mask, core_mask, core_shift,
-                n_neurons, n_colour_bits)
-            self.__entries[key_and_mask.key] = entry
-            return entry
-        entry = self.__entries[key_and_mask.key]
-        if (key_and_mask.mask != entry.mask or
-                core_mask != entry.core_mask or
-                core_shift != entry.core_shift or
-                n_neurons != entry.n_neurons):
+            core_shift: int, n_neurons: int, n_colour_bits: int,
+            address: int, row_length: int, is_valid: bool) -> int:
+        """
+        Add an address to the entry of a key, making the entry if needed.
+
+        :return: The index of the address within the entry
+        :rtype: int
+        """
+        key = key_and_mask.key
+        mask = key_and_mask.mask
+        if key not in self.__entries:
+            self.__entries[key] = (
+                mask, core_mask, core_shift, n_neurons, n_colour_bits)
+            self.__counts[key] = 0
+        else:
+            e_mask, e_core_mask, e_core_shift, e_n_neurons, _ = \
+                self.__entries[key]
+            if (mask != e_mask or core_mask != e_core_mask or
+                    core_shift != e_core_shift or n_neurons != e_n_neurons):
+                raise SynapticConfigurationException(
+                    f"Existing entry for key {key} doesn't match one "
+                    f"being added: Existing mask: {e_mask} "
+                    f"core_mask: {e_core_mask} core_shift: {e_core_shift} "
+                    f"n_neurons: {e_n_neurons} "
+                    f"Adding mask: {mask} core_mask: {core_mask} "
+                    f"core_shift: {core_shift} n_neurons: {n_neurons}")
+        index = self.__counts[key]
+        if is_valid and index > _MAX_ADDRESS_COUNT:
             raise SynapticConfigurationException(
-                f"Existing entry for key {key_and_mask.key} doesn't match one "
-                f"being added: Existing mask: {entry.mask} "
-                f"core_mask: {entry.core_mask} core_shift: {entry.core_shift} "
-                f"n_neurons: {entry.n_neurons} "
-                f"Adding mask: {key_and_mask.mask} core_mask: {core_mask} "
-                f"core_shift: {core_shift} n_neurons: {n_neurons}")
-        return entry
+                f"{index} connections for the same source key "
+                f"(maximum {_MAX_ADDRESS_COUNT})")
+        self.__counts[key] = index + 1
+        for column, value in zip(self.__columns, (
+                key, mask, core_mask, core_shift, n_neurons, n_colour_bits,
+                address, row_length, is_valid)):
+            column.append(value)
+        return index
+
+    @property
+    def n_addresses(self) -> int:
+        """
+        The number of items in the address list.
+
+        :rtype: int
+        """
+        return len(self.__columns[0])
+
+    def get_address_list_position(self, key: int, index: int) -> int:
+        """
+        Get the position in the address list written to the machine of an
+        item added, given that the entries are sorted by key.
+
+        :param int key: The key the item was added with
+        :param int index: The index returned when the item was added
+        :rtype: int
+        """
+        return sum(
+            count for entry_key, count in self.__counts.items()
+            if entry_key < key) + index
 
-    def get_pop_table_data(self) -> NDArray[uint32]:
+    def get_pop_table_data(
+            self, direct_lookup: bool = False) -> NDArray[uint32]:
         """
         Get the master pop table data as a numpy array.
 
+        :param bool direct_lookup:
+            Whether to try to generate an index that allows the table to be
+            looked up directly rather than searched
         :rtype: ~numpy.ndarray
         """
-        # sort entries by key
-        entries = sorted(
-            self.__entries.values(),
-            key=lambda a_entry: a_entry.routing_key)
-        n_entries = len(entries)
-        data = [numpy.array([n_entries, self.__n_addresses], dtype=uint32)]
-        # Generate the table and list as arrays
-        pop_table = _make_array(_MasterPopEntryCType, n_entries)
-        address_list = _make_array(_AddressListEntryCType, self.__n_addresses)
-        start = 0
-        for i, entry in enumerate(entries):
-            start += entry.write_to_table(pop_table[i], address_list, start)
-
-        # Add the arrays
-        data.append(_to_numpy(pop_table))
-        data.append(_to_numpy(address_list))
-        return numpy.concatenate(data)
+        return make_pop_table_data(
+            *(numpy.array(column, dtype=uint32)
+              for column in self.__columns[:-1]),
+            numpy.array(self.__columns[-1], dtype=bool),
+            direct_lookup=direct_lookup)
 
     @property
     def max_n_neurons_per_core(self) -> int:
@@ -655,3 +538,240 @@ class MasterPopTableAsBinarySearch(object):
         :rtype: int
         """
         return _MAX_ADDRESS_COUNT
+
+
+def _direct_lookup_max_n_bits(n_entries: int) -> int:
+    """
+    Get the maximum number of bits of direct lookup index allowed for a
+    table with the given number of entries.
+
+    :param int n_entries: The number of entries in the table
+    :rtype: int
+    """
+    if n_entries == 0:
+        return 0
+    max_entries = n_entries * _MAX_DIRECT_LOOKUP_SPARSITY
+    return min(_MAX_DIRECT_LOOKUP_BITS, int(math.ceil(math.log2(max_entries))))
+
+
+def _direct_lookup_max_n_bytes(n_entries: int) -> int:
+    """
+    Get the maximum size of the direct lookup index in bytes, excluding the
+    header.
+
+    :param int n_entries: The number of entries in the table
+    :rtype: int
+    """
+    n_bits = _direct_lookup_max_n_bits(n_entries)
+    if n_bits == 0:
+        return 0
+    # 16-bit items; at least 2 of them so a whole number of words
+    return (1 << n_bits) * 2
+
+
+def make_pop_table_data(
+        keys: NDArray[uint32], masks: NDArray[uint32],
+        core_masks: NDArray[uint32], core_shifts: NDArray[uint32],
+        n_neurons: NDArray[uint32], n_colour_bits: NDArray[uint32],
+        addresses: NDArray[uint32], row_lengths: NDArray[uint32],
+        is_valid: NDArray[numpy.bool_],
+        direct_lookup: bool = False) -> NDArray[uint32]:
+    """
+    Make the master pop table data from the columns of its address list, in
+    bulk.  Each index of the arrays is one address list item; items with the
+    same key are merged into one table entry, in the order given, and the
+    entries are sorted by key.  The extended format is used if the items
+    don't fit in the standard format.
+
+    :param ~numpy.ndarray keys: The key of each item
+    :param ~numpy.ndarray masks: The mask of the key of each item
+    :param ~numpy.ndarray core_masks:
+        The mask of the key once shifted to get the source core of each item
+    :param ~numpy.ndarray core_shifts:
+        The shift of the key to get the source core of each item
+    :param ~numpy.ndarray n_neurons:
+        The number of neurons of each source core of each item
+    :param ~numpy.ndarray n_colour_bits: The colour bits of each item
+    :param ~numpy.ndarray addresses:
+        The address of the synaptic matrix of each item, divided by
+        :py:const:`_ADDRESS_SCALE`
+    :param ~numpy.ndarray row_lengths:
+        The length of the rows of each item, less one
+    :param ~numpy.ndarray is_valid:
+        Whether each item points to a matrix, rather than keeping indices
+        in step between tables
+    :param bool direct_lookup:
+        Whether to try to generate an index that allows the table to be
+        looked up directly rather than searched
+    :rtype: ~numpy.ndarray
+    :raises SynapticConfigurationException:
+        If the items of a key don't match, or there are too many items for
+        one key
+    """
+    n_addresses = len(keys)
+    max_address = int(addresses[is_valid].max()) if is_valid.any() else 0
+    extended = _needs_extended_format(n_addresses, max_address)
+
+    # Sort by key, keeping the order of the items of each key
+    order = numpy.argsort(keys, kind="stable")
+    entry_keys, starts, counts = numpy.unique(
+        keys[order], return_index=True, return_counts=True)
+    if numpy.any(counts > _MAX_ADDRESS_COUNT + 1):
+        raise SynapticConfigurationException(
+            f"{counts.max()} connections for the same source key "
+            f"(maximum {_MAX_ADDRESS_COUNT})")
+
+    # Every item of an entry must match the first
+    first = order[starts]
+    entry_of_item = numpy.repeat(numpy.arange(len(entry_keys)), counts)
+    for column in (masks, core_masks, core_shifts, n_neurons):
+        if numpy.any(column[order] != column[first][entry_of_item]):
+            raise SynapticConfigurationException(
+                "The entries for a key don't all match")
+
+    entry_n_neurons = n_neurons[first].astype(uint32)
+    n_words = (entry_n_neurons + (BIT_IN_A_WORD - 1)) // BIT_IN_A_WORD
+    pop_table = numpy.empty((len(entry_keys), _ENTRY_WORDS), dtype=uint32)
+    pop_table[:, 0] = entry_keys
+    pop_table[:, 1] = masks[first]
+    # The extended format holds the starts separately
+    pop_table[:, 2] = (
+        (0 if extended else starts.astype(uint32) << _START_SHIFT) |
+        (n_colour_bits[first].astype(uint32) << _N_COLOUR_BITS_SHIFT) |
+        (counts.astype(uint32) << _COUNT_SHIFT))
+    pop_table[:, 3] = (
+        core_masks[first].astype(uint32) |
+        (core_shifts[first].astype(uint32) << _MASK_SHIFT_SHIFT))
+    pop_table[:, 4] = entry_n_neurons | (n_words << _N_WORDS_SHIFT)
+
+    if extended:
+        address_list = numpy.empty((n_addresses, 2), dtype=uint32)
+        address_list[:, 0] = row_lengths[order]
+        address_list[:, 1] = numpy.where(
+            is_valid[order],
+            addresses[order].astype(uint32) * uint32(_ADDRESS_SCALE),
+            uint32(_INVALID_EXTENDED_OFFSET))
+        table_data = [
+            pop_table.reshape(-1), starts.astype(uint32),
+            address_list.reshape(-1)]
+    else:
+        address_list = numpy.where(
+            is_valid[order],
+            row_lengths[order].astype(uint32) |
+            (addresses[order].astype(uint32) << _ADDRESS_SHIFT),
+            uint32(_INVALID_ADDDRESS << _ADDRESS_SHIFT)).astype(uint32)
+        table_data = [pop_table.reshape(-1), address_list]
+
+    shift, n_bits = 0, 0
+    if direct_lookup and len(entry_keys):
+        shift, n_bits = _find_direct_lookup_bits(
+            entry_keys, numpy.bitwise_and.reduce(masks[first]))
+    return numpy.concatenate([
+        numpy.array([
+            len(entry_keys), n_addresses,
+            _EXTENDED_FORMAT if extended else _STANDARD_FORMAT],
+            dtype=uint32),
+        *table_data, _get_direct_lookup_data(entry_keys, shift, n_bits)])
+
+
+class PopTableSummary(NamedTuple):
+    """
+    The size and shape of a master population table, as written.
+    """
+    #: The number of entries, one for each source key
+    n_entries: int
+    #: The number of entries that cover more than one source core
+    n_core_masked_entries: int
+    #: The number of items in the address list
+    n_addresses: int
+    #: Whether the table is in the extended format
+    extended: bool
+    #: The size of the table data in bytes
+    n_bytes: int
+
+    @property
+    def n_search_steps(self) -> int:
+        """
+        The most steps a binary search of the table takes.
+
+        :rtype: int
+        """
+        return self.n_entries.bit_length()
+
+
+def get_pop_table_summary(data: NDArray[uint32]) -> PopTableSummary:
+    """
+    Summarise the data made by :py:func:`make_pop_table_data`.
+
+    :param ~numpy.ndarray data: The table data
+    :rtype: PopTableSummary
+    """
+    n_entries = int(data[0])
+    header_words = _BASE_SIZE_BYTES // BYTES_PER_WORD
+    table = data[header_words:header_words + n_entries * _ENTRY_WORDS]
+    table = table.reshape(-1, _ENTRY_WORDS)
+    return PopTableSummary(
+        n_entries=n_entries,
+        n_core_masked_entries=int(numpy.count_nonzero(
+            table[:, 3] & _MAX_CORE_MASK)),
+        n_addresses=int(data[1]), extended=bool(data[2] == _EXTENDED_FORMAT),
+        n_bytes=len(data) * BYTES_PER_WORD)
+
+
+def _needs_extended_format(n_addresses: int, max_address: int) -> bool:
+    """
+    Whether a table needs the extended format, because its address list
+    is too long or reaches too far for the standard format.
+
+    :param int n_addresses: The number of items in the address list
+    :param int max_address:
+        The largest address in the list, divided by
+        :py:const:`_ADDRESS_SCALE`
+    :rtype: bool
+    """
+    return n_addresses > _MAX_ADDRESS_START or max_address > _MAX_ADDRESS
+
+
+def _find_direct_lookup_bits(
+        keys: NDArray[uint32], common_mask: int) -> Tuple[int, int]:
+    """
+    Find the smallest group of key bits that are inside the mask of every
+    entry and are different for every entry.
+
+    :param ~numpy.ndarray keys: The keys of the entries of the table
+    :param int common_mask: The bits that are in the mask of every entry
+    :return: The shift and number of bits of the group, or 0 bits if none
+    :rtype: tuple(int, int)
+    """
+    min_bits = max(1, int(math.ceil(math.log2(len(keys)))))
+    max_bits = _direct_lookup_max_n_bits(len(keys))
+    for n_bits in range(min_bits, max_bits + 1):
+        bits_mask = (1 << n_bits) - 1
+        for shift in range(BYTES_PER_WORD * _BITS_PER_BYTES - n_bits + 1):
+            if (int(common_mask) >> shift) & bits_mask != bits_mask:
+                continue
+            values = (keys >> uint32(shift)) & uint32(bits_mask)
+            if len(numpy.unique(values)) == len(keys):
+                return shift, n_bits
+    return 0, 0
+
+
+def _get_direct_lookup_data(
+        keys: NDArray[uint32], shift: int, n_bits: int) -> NDArray[uint32]:
+    """
+    Get the direct lookup index data for the sorted table keys.
+
+    :param ~numpy.ndarray keys: The sorted keys of the entries of the table
+    :param int shift: The shift of the key bits that index the table
+    :param int n_bits: The number of key bits that index the table, or 0 if
+        there is no index
+    :rtype: ~numpy.ndarray
+    """
+    header = numpy.array([shift, n_bits], dtype=uint32)
+    if n_bits == 0:
+        return header
+    index = numpy.full(1 << n_bits, _NO_DIRECT_ENTRY, dtype=numpy.uint16)
+    bits_mask = (1 << n_bits) - 1
+    index[(keys >> uint32(shift)) & uint32(bits_mask)] = numpy.arange(
+        len(keys), dtype=numpy.uint16)
+    return numpy.concatenate([header, index.view(uint32)])
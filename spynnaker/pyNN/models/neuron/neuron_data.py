@@ -11,11 +11,13 @@
 # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 # See the License for the specific language governing permissions and
 # limitations under the License.
-from typing import Iterator, MutableMapping, Optional, Tuple, cast
+from typing import (
+    Dict, Iterator, List, MutableMapping, Optional, Sequence, Tuple, cast)
 
 import numpy
 from numpy import uint32
 from numpy.typing import NDArray
+from pyNN.random import RandomDistribution
 
 from spinn_utilities.helpful_functions import is_singleton
 from spinn_utilities.ranged import RangeDictionary, RangedList
@@ -36,6 +38,11 @@ from spynnaker.pyNN.models.neuron.population_machine_neurons import (
     NeuronRegions)
 
 
+# The most ranges of values a slice can have for the values to be used as a
+# key to share the parameter data of the slice
+_MAX_PARAM_KEY_RANGES = 256
+
+
 def _all_one_val_gen(rd: RangeDictionary[float]) -> bool:
     """
     Determine if all the values of a dictionary are the same, assuming we
@@ -80,7 +87,10 @@ class NeuronData(object):
         "__generation_done",
 
         # Whether to generate things on the machine
-        "__gen_on_machine")
+        "__gen_on_machine",
+
+        # Parameter data made on host, by a key of the values it was made from
+        "__neuron_param_cache")
 
     def __init__(self, app_vertex: AbstractPopulationVertex):
         self.__app_vertex = app_vertex
@@ -89,6 +99,7 @@ class NeuronData(object):
         self.__generation_done = False
         self.__gen_on_machine = False
         self.__neuron_data_n_structs = 0
+        self.__neuron_param_cache: Dict[Tuple, NDArray[uint32]] = dict()
 
     @property
     def gen_on_machine(self) -> bool:
@@ -206,9 +217,55 @@ class NeuronData(object):
         structs = self.__app_vertex.neuron_impl.structs
         values = _MergedDict(self.__app_vertex.parameters,
                              self.__app_vertex.state_variables)
-        return numpy.concatenate([
+
+        # Slices with the same values have the same data, so make it once
+        key = self.__get_neuron_param_key(structs, values, vertex_slice)
+        if key is not None and key in self.__neuron_param_cache:
+            return self.__neuron_param_cache[key]
+        data = numpy.concatenate([
             self.__get_struct_data(struct, values, vertex_slice)
             for struct in structs])
+        if key is not None:
+            self.__neuron_param_cache[key] = data
+        return data
+
+    def __get_neuron_param_key(
+            self, structs: Sequence[Struct], values: '_MergedDict',
+            vertex_slice: Slice) -> Optional[Tuple]:
+        """
+        Get a key of the values that make up the parameter data of a slice.
+
+        :param list(Struct) structs: The structures that make up the data
+        :param RangeDictionary values: The values to fill the structures with
+        :param Slice vertex_slice: The slice to get the key of
+        :return: The key, or `None` if the data can't or shouldn't be shared,
+            which is when there are random values or too many ranges
+        :rtype: tuple or None
+        """
+        key: List = [vertex_slice.n_atoms]
+        ids = vertex_slice.get_raster_ids()
+        for struct in structs:
+            if struct.repeat_type == StructRepeat.GLOBAL:
+                # Global values are the same for every slice
+                continue
+            for _data_type, name in struct.fields:
+                if name not in values:
+                    continue
+                all_vals = values[name]
+                if is_singleton(all_vals):
+                    key.append(all_vals)
+                    continue
+                for start, stop, value in all_vals.iter_ranges_by_ids(ids):
+                    if isinstance(value, RandomDistribution):
+                        return None
+                    key.append((stop - start, value))
+                if len(key) > _MAX_PARAM_KEY_RANGES:
+                    return None
+        try:
+            hash(tuple(key))
+        except TypeError:
+            return None
+        return tuple(key)
 
     def __get_struct_data(self, struct: Struct, values: '_MergedDict',
                           vertex_slice: Slice) -> NDArray[uint32]:
@@ -338,6 +395,7 @@ class NeuronData(object):
         self.__generation_done = False
         self.__gen_on_machine = False
         self.__neuron_data_n_structs = 0
+        self.__neuron_param_cache.clear()
 
 
 class _MergedDict(MutableMapping[str, RangedList[float]]):
@@ -20,6 +20,11 @@ from numpy.typing import NDArray
 # Default value of fixed-point one for STDP
 STDP_FIXED_POINT_ONE = (1 << 11)
 
+#: The most entries in an exponential decay lookup table.  Longer decays
+#: use a coarser table, which the machine interpolates between, so that
+#: each table takes a fixed amount of DTCM
+MAX_LUT_SIZE = 256
+
 
 def float_to_fixed(value: float) -> int:
     """
@@ -30,11 +35,15 @@ def float_to_fixed(value: float) -> int:
 
 
 def get_exp_lut_array(time_step: float, time_constant: float,
-                      shift: int = 0) -> NDArray[uint32]:
+                      shift: int = 0,
+                      max_size: int = MAX_LUT_SIZE) -> NDArray[uint32]:
     """
     :param float time_step:
     :param float time_constant:
     :param int shift:
+        The smallest shift of time to table index; this is increased if
+        needed to fit the table in max_size entries
+    :param int max_size: The most entries in the table
     :rtype: ~numpy.ndarray
     """
     # Compute the actual exponential decay parameter
@@ -43,6 +52,8 @@ def get_exp_lut_array(time_step: float, time_constant: float,
 
     # Compute the size of the array, which must be a multiple of 2
     size = math.log(STDP_FIXED_POINT_ONE) / l_ambda
+    while size / (1 << shift) > max_size:
+        shift += 1
     size, extra = divmod(size / (1 << shift), 2)
     size = (int(size) + (extra > 0)) * 2
 
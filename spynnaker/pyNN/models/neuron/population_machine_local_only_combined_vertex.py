@@ -56,7 +56,10 @@ class LocalOnlyProvenance(ctypes.LittleEndianStructure):
         # overflowed
         ("n_spikes_lost_from_input", ctypes.c_uint32),
         # The maximum size of the spike input buffer during simulation
-        ("max_size_input_buffer", ctypes.c_uint32)
+        ("max_size_input_buffer", ctypes.c_uint32),
+        # The number of spikes merged with others of the same key in a time
+        # step
+        ("n_spikes_merged", ctypes.c_uint32)
     ]
 
     N_ITEMS = len(_fields_)
@@ -102,6 +105,7 @@ class PopulationMachineLocalOnlyCombinedVertex(
     N_LATE_SPIKES_NAME = "Number_of_late_spikes"
     MAX_FILLED_SIZE_OF_INPUT_BUFFER_NAME = "Max_filled_size_input_buffer"
     MAX_SPIKES_PER_TIME_STEP_NAME = "Max_spikes_per_time_step"
+    N_SPIKES_MERGED_NAME = "Number_of_spikes_merged_by_key"
     BACKGROUND_OVERLOADS_NAME = "Times_the_background_queue_overloaded"
     BACKGROUND_MAX_QUEUED_NAME = "Max_backgrounds_queued"
 
@@ -141,7 +145,8 @@ class PopulationMachineLocalOnlyCombinedVertex(
     _PROFILE_TAG_LABELS = {
         0: "TIMER",
         1: "DMA_READ",
-        2: "INCOMING_SPIKE"}
+        2: "INCOMING_SPIKE",
+        10: "LOCAL_ONLY_SPIKE"}
 
     def __init__(
             self, sdram: AbstractSDRAM, label: str,
@@ -325,7 +330,7 @@ class PopulationMachineLocalOnlyCombinedVertex(
     @overrides(AbstractRewritesDataSpecification.regenerate_data_specification)
     def regenerate_data_specification(
             self, spec: DataSpecificationReloader, placement: Placement):
-        self._rewrite_neuron_data_spec(spec)
+        self._rewrite_neuron_data_spec(spec, self.__ring_buffer_shifts)
 
         # close spec
         spec.end_specification()
@@ -367,6 +372,8 @@ class PopulationMachineLocalOnlyCombinedVertex(
             db.insert_core(
                 x, y, p, self.MAX_FILLED_SIZE_OF_INPUT_BUFFER_NAME,
                 prov.max_size_input_buffer)
+            db.insert_core(
+                x, y, p, self.N_SPIKES_MERGED_NAME, prov.n_spikes_merged)
 
             if prov.n_spikes_lost_from_input > 0:
                 db.insert_report(
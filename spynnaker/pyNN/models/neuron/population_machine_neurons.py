@@ -14,6 +14,7 @@
 from __future__ import annotations
 from collections.abc import Container
 import ctypes
+from enum import Enum
 from typing import (
     List, NamedTuple, Sequence, Set, Union, Optional, cast, TYPE_CHECKING)
 
@@ -44,6 +45,19 @@ if TYPE_CHECKING:
     from spynnaker.pyNN.models.current_sources import AbstractCurrentSource
 
 
+class KeyMode(Enum):
+    """
+    How the keys of the neurons are given to the binary; these match
+    neuron_key_mode in neuron.c.
+    """
+    #: The neurons don't send spikes
+    NO_KEY = 0
+    #: There is a key for each neuron
+    ARRAY = 1
+    #: The keys are the first key plus the index shifted by the colour bits
+    BASE = 2
+
+
 class NeuronProvenance(ctypes.LittleEndianStructure):
     """
     Provenance items from neuron processing.
@@ -249,7 +263,9 @@ class PopulationMachineNeurons(
         return routing_info.get_key_from(
             cast(AbstractVertex, self), next(iter(partition_ids)))
 
-    def _rewrite_neuron_data_spec(self, spec: DataSpecificationReloader):
+    def _rewrite_neuron_data_spec(
+            self, spec: DataSpecificationReloader,
+            ring_buffer_shifts: Sequence[int]):
         """
         Re-Write the data specification of the neuron data.
 
@@ -258,6 +274,10 @@ class PopulationMachineNeurons(
         :param list(int) ring_buffer_shifts:
             The shifts to apply to convert ring buffer values to S1615 values
         """
+        # Write the neuron core parameters, which tell the core that there
+        # are new parameters to load
+        self._write_neuron_core_parameters(spec, ring_buffer_shifts)
+
         # Write the current source parameters
         self._write_current_source_parameters(spec)
 
@@ -266,7 +286,7 @@ class PopulationMachineNeurons(
             spec, self._vertex_slice, self._neuron_regions, False)
 
     def _write_neuron_core_parameters(
-            self, spec: DataSpecificationGenerator,
+            self, spec: DataSpecificationBase,
             ring_buffer_shifts: Sequence[int]):
         """
         Write the neuron parameters region.
@@ -287,16 +307,23 @@ class PopulationMachineNeurons(
             label='Neuron Core Params')
         spec.switch_write_focus(self._neuron_regions.core_params)
 
-        # Write whether the key is to be used, and then the key, or 0 if it
-        # isn't to be used
+        # Write how the keys are given, and then the keys, or 0 if they
+        # aren't to be used; contiguous keys are worked out from the first,
+        # which saves keeping a key for each neuron in DTCM
         keys: Union[numpy.ndarray, List[int]]
+        n_colour_bits = self._pop_vertex.n_colour_bits
         if not self._has_key:
-            spec.write_value(data=0)
+            spec.write_value(data=KeyMode.NO_KEY.value)
             keys = [0] * n_atoms
         else:
-            spec.write_value(data=1)
-            keys = get_keys(
-                self._key, self._vertex_slice, self._pop_vertex.n_colour_bits)
+            keys = get_keys(self._key, self._vertex_slice, n_colour_bits)
+            contiguous = keys[0] + (
+                numpy.arange(n_atoms, dtype=numpy.uint32) << n_colour_bits)
+            if numpy.array_equal(keys, contiguous):
+                spec.write_value(data=KeyMode.BASE.value)
+                keys = keys[:1]
+            else:
+                spec.write_value(data=KeyMode.ARRAY.value)
 
         # Write the number of neurons in the block:
         spec.write_value(data=n_atoms)
@@ -307,6 +334,12 @@ class PopulationMachineNeurons(
         # Write the number of colour bits
         spec.write_value(self._pop_vertex.n_colour_bits)
 
+        # Write that the neuron parameters are to be loaded
+        spec.write_value(data=1)
+
+        # Write the number of simulation time steps in each neuron time step
+        spec.write_value(self._pop_vertex.timestep_multiple)
+
         # Write the ring buffer data
         # This is only the synapse types that need a ring buffer i.e. not
         # those stored in synapse dynamics
@@ -417,6 +450,24 @@ class PopulationMachineNeurons(
                                 value, cs_data_types[key]).item()
                             spec.write_value(data=value_convert)
 
+    def get_current_source_index(
+            self, current_source: AbstractCurrentSource) -> Optional[int]:
+        """
+        Get the index of a current source among the sources of the same type
+        on this core, as the core knows it.
+
+        :param AbstractCurrentSource current_source: The source to find
+        :return: The index, or `None` if the source is not on this core
+        :rtype: int or None
+        """
+        index = 0
+        for source in self.__get_current_sources_sorted():
+            if source is current_source:
+                return index
+            if source.current_source_id == current_source.current_source_id:
+                index += 1
+        return None
+
     def __get_current_sources_sorted(self) -> List[AbstractCurrentSource]:
         app_current_sources = self._pop_vertex.current_sources
         current_source_id_list = self._pop_vertex.current_source_id_list
@@ -12,9 +12,10 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 from __future__ import annotations
-from typing import List, Sequence, Tuple, TYPE_CHECKING
+from typing import List, Optional, Sequence, Tuple, TYPE_CHECKING
 
-from numpy import floating
+import numpy
+from numpy import floating, uint32
 from numpy.typing import NDArray
 
 from spinn_utilities.overrides import overrides
@@ -31,7 +32,10 @@ from spinn_front_end_common.abstract_models import (
 from spinn_front_end_common.interface.ds import DataSpecificationBase
 from spinn_front_end_common.interface.buffer_management.buffer_models import (
     AbstractReceiveRegionsToHost)
+from spinn_front_end_common.interface.provenance import ProvenanceWriter
+from spinn_front_end_common.utilities.constants import BYTES_PER_WORD
 
+from spynnaker.pyNN.data import SpynnakerDataView
 from spynnaker.pyNN.models.neuron.synapse_dynamics import (
     AbstractSynapseDynamicsStructural, AbstractSDRAMSynapseDynamics)
 from spynnaker.pyNN.utilities.utility_calls import get_n_bits
@@ -41,7 +45,8 @@ from spynnaker.pyNN.models.abstract_models import (
 from .abstract_population_vertex import AbstractPopulationVertex
 from .population_machine_synapses_provenance import (
     PopulationMachineSynapsesProvenance)
-from .synaptic_matrices import SynapseRegions, SynapseRegionReferences
+from .synaptic_matrices import (
+    EVENT_COUNTER_NAMES, SynapseRegions, SynapseRegionReferences)
 
 if TYPE_CHECKING:
     from spynnaker.pyNN.models.neuron.synaptic_matrices import SynapticMatrices
@@ -145,6 +150,27 @@ class PopulationMachineSynapses(
             synaptic_matrix_base_address,
             self._synaptic_matrices.on_chip_generated_matrix_size)]
 
+    @property
+    def _has_synapse_blocks_to_rewrite(self) -> bool:
+        """
+        Whether there are synaptic blocks to write to the machine again
+        because the weights of their projections have changed.
+
+        :rtype: bool
+        """
+        return self._synaptic_matrices.has_blocks_to_rewrite(
+            self.vertex_slice)
+
+    def _rewrite_synapse_blocks(self, placement: Placement):
+        """
+        Write any synaptic blocks whose projections have changed weights
+        straight to the machine.
+
+        :param ~pacman.model.placements.Placement placement:
+            Where the vertex is placed
+        """
+        self._synaptic_matrices.rewrite_blocks(placement, self.vertex_slice)
+
     def _write_synapse_data_spec(
             self, spec: DataSpecificationBase,
             ring_buffer_shifts: Sequence[int],
@@ -227,6 +253,8 @@ class PopulationMachineSynapses(
         # the ring buffers
         n_synapse_types = self._pop_vertex.neuron_impl.get_n_synapse_types()
         max_delay = self._pop_vertex.splitter.max_support_delay()
+        ring_buffer_delay = (
+            self._pop_vertex.splitter.max_ring_buffer_delay())
 
         # Write synapse parameters
         spec.switch_write_focus(self._synapse_regions.synapse_params)
@@ -235,10 +263,21 @@ class PopulationMachineSynapses(
         spec.write_value(get_n_bits(n_neurons))
         spec.write_value(get_n_bits(n_synapse_types))
         spec.write_value(get_n_bits(max_delay))
+        spec.write_value(get_n_bits(ring_buffer_delay))
         spec.write_value(int(self._pop_vertex.drop_late_spikes))
         spec.write_value(self._pop_vertex.incoming_spike_buffer_size)
+        spec.write_value(self._synaptic_matrices.dirty_rows_offset)
+        spec.write_value(self._synaptic_matrices.event_counters_offset)
+        spec.write_value(int(self._pop_vertex.profiles_ring_buffers))
         spec.write_array(ring_buffer_shifts)
 
+        # Leave space for the peaks, then write the delay bits of each type
+        spec.write_array([0] * n_synapse_types)
+        max_delay_bits = get_n_bits(ring_buffer_delay)
+        spec.write_array([
+            min(bits, max_delay_bits)
+            for bits in self._pop_vertex.get_synapse_type_delay_bits()])
+
     @overrides(AbstractSynapseExpandable.gen_on_machine)
     def gen_on_machine(self) -> bool:
         return self._synaptic_matrices.gen_on_machine
@@ -269,6 +308,94 @@ class PopulationMachineSynapses(
     def bit_field_size(self) -> int:
         return self._synaptic_matrices.bit_field_size
 
+    @overrides(AbstractSynapseExpandable.get_generator_data_block)
+    def get_generator_data_block(
+            self, placement: Placement) -> Tuple[int, int]:
+        return (locate_memory_region_for_placement(
+                    placement, self.connection_generator_region),
+                self._synaptic_matrices.get_generated_data_size(
+                    self.vertex_slice))
+
+    @overrides(AbstractSynapseExpandable.get_expanded_blocks)
+    def get_expanded_blocks(
+            self, placement: Placement) -> Optional[List[Tuple[int, int]]]:
+        return self._synaptic_matrices.get_expanded_blocks(placement)
+
+    @overrides(PopulationMachineSynapsesProvenance._parse_synapse_provenance)
+    def _parse_synapse_provenance(
+            self, label: str, x: int, y: int, p: int,
+            provenance_data: Sequence[int]):
+        PopulationMachineSynapsesProvenance._parse_synapse_provenance(
+            self, label, x, y, p, provenance_data)
+        self.__read_ring_buffer_peaks()
+
+        # The shape of the table is known on the host
+        summary = self._synaptic_matrices.pop_table_summary
+        if summary is None:
+            return
+        with ProvenanceWriter() as db:
+            db.insert_core(x, y, p, self.POP_TABLE_ENTRIES, summary.n_entries)
+            db.insert_core(
+                x, y, p, self.POP_TABLE_CORE_MASKED_ENTRIES,
+                summary.n_core_masked_entries)
+            db.insert_core(
+                x, y, p, self.POP_TABLE_ADDRESSES, summary.n_addresses)
+            db.insert_core(
+                x, y, p, self.POP_TABLE_SEARCH_STEPS, summary.n_search_steps)
+            db.insert_core(x, y, p, self.POP_TABLE_BYTES, summary.n_bytes)
+            if summary.extended:
+                db.insert_report(
+                    f"The master population table of {label} has "
+                    f"{summary.n_entries} entries and "
+                    f"{summary.n_addresses} addresses, so it uses the "
+                    "extended format, which takes more DTCM.")
+        self.__parse_event_counters()
+
+    def __read_ring_buffer_peaks(self) -> None:
+        """
+        Give the peak ring buffer values noted by the cores to the
+        application vertex, which uses them to choose the ring buffer shifts
+        when next mapped.
+        """
+        if not self._pop_vertex.profiles_ring_buffers:
+            return
+        placement = SpynnakerDataView.get_placement_of_vertex(self)
+        address = locate_memory_region_for_placement(
+            placement, self._synapse_regions.synapse_params)
+        address += self._pop_vertex.ring_buffer_peaks_offset
+        n_synapse_types = self._pop_vertex.neuron_impl.get_n_synapse_types()
+        data = numpy.frombuffer(SpynnakerDataView.read_memory(
+            placement.x, placement.y, address,
+            2 * n_synapse_types * BYTES_PER_WORD), dtype=uint32)
+        shifts = data[:n_synapse_types]
+        peaks = data[n_synapse_types:]
+        self._pop_vertex.add_ring_buffer_peaks(shifts, peaks)
+        with ProvenanceWriter() as db:
+            for synapse_type, peak in enumerate(peaks):
+                db.insert_core(
+                    placement.x, placement.y, placement.p,
+                    f"Peak_ring_buffer_value_of_synapse_type_{synapse_type}",
+                    int(peak))
+
+    def __parse_event_counters(self) -> None:
+        """
+        Add the events counted for each incoming projection to the
+        provenance, against the projection's connector.
+        """
+        placement = SpynnakerDataView.get_placement_of_vertex(self)
+        counters = self._synaptic_matrices.read_event_counters(placement)
+        if not counters:
+            return
+        with ProvenanceWriter() as db:
+            for (_app_edge, synapse_info), counts in counters.items():
+                for name, count in zip(EVENT_COUNTER_NAMES, counts):
+                    db.insert_connector(
+                        synapse_info.pre_population.label,
+                        synapse_info.post_population.label,
+                        synapse_info.connector.__class__.__name__,
+                        f"Projection_{name}_on_{placement.x}_{placement.y}"
+                        f"_{placement.p}", int(count))
+
     @overrides(AbstractReceiveRegionsToHost.get_download_regions)
     def get_download_regions(
             self, placement: Placement) -> Sequence[Tuple[int, int, int]]:
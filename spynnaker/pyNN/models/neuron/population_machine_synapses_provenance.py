@@ -16,6 +16,11 @@ from typing import Sequence
 from spinn_front_end_common.interface.provenance import ProvenanceWriter
 
 
+#: The number of bins of the histogram of spike lateness: one per time step
+#: late, with the last also counting anything later
+N_LATENESS_BINS = 4
+
+
 class SynapseProvenance(ctypes.LittleEndianStructure):
     """
     Provenance items from synapse processing.
@@ -40,10 +45,23 @@ class SynapseProvenance(ctypes.LittleEndianStructure):
         # The number of spikes detected as late
         ("n_late_spikes", ctypes.c_uint32),
         # The maximum lateness of a spike
-        ("max_late_spike", ctypes.c_uint32)
+        ("max_late_spike", ctypes.c_uint32),
+        # The number of pop table lookups that matched a recent entry
+        ("n_pop_table_cache_hits", ctypes.c_uint32),
+        # The number of pop table lookups that had to look up the table
+        ("n_pop_table_cache_misses", ctypes.c_uint32),
+        # The number of bitfields read in compressed to save DTCM
+        ("n_compressed_bitfield_reads", ctypes.c_uint32),
+        # The number of spikes tested against a Bloom filter
+        ("n_bloom_filter_tests", ctypes.c_uint32),
+        # The number of spikes that a Bloom filter wrongly passed
+        ("n_bloom_filter_false_positives", ctypes.c_uint32),
+        # The number of rows processed by how many time steps late the spike
+        # was
+        ("lateness_histogram", ctypes.c_uint32 * N_LATENESS_BINS)
     ]
 
-    N_ITEMS = len(_fields_)
+    N_ITEMS = len(_fields_) - 1 + N_LATENESS_BINS
 
 
 class PopulationMachineSynapsesProvenance(object):
@@ -63,6 +81,17 @@ class PopulationMachineSynapsesProvenance(object):
     INVALID_MASTER_POP_HITS = "Invalid Master Pop hits"
     BIT_FIELD_FILTERED_PACKETS = \
         "How many packets were filtered by the bitfield filterer."
+    POP_TABLE_CACHE_HITS = "Pop table lookups matching a recent entry"
+    POP_TABLE_CACHE_MISSES = "Pop table lookups not matching a recent entry"
+    BIT_FIELDS_COMPRESSED = "N bit fields read into DTCM compressed"
+    BLOOM_FILTER_TESTS = "Spikes tested against a Bloom filter"
+    BLOOM_FILTER_FALSE_POSITIVES = "Spikes wrongly passed by a Bloom filter"
+    POP_TABLE_ENTRIES = "Master population table entries"
+    POP_TABLE_CORE_MASKED_ENTRIES = (
+        "Master population table entries covering many source cores")
+    POP_TABLE_ADDRESSES = "Master population table address list items"
+    POP_TABLE_SEARCH_STEPS = "Master population table search steps"
+    POP_TABLE_BYTES = "Master population table bytes"
     SYNAPSES_SKIPPED = "Skipped synapses"
     LATE_SPIKES = "Late spikes"
     MAX_LATE_SPIKE = "Max late spike"
@@ -79,7 +108,10 @@ class PopulationMachineSynapsesProvenance(object):
         :param int p: virtual id of the core
         :param list(int) provenance_data: A list of data items to interpret
         """
-        synapse_prov = SynapseProvenance(*provenance_data)
+        synapse_prov = SynapseProvenance(
+            *provenance_data[:-N_LATENESS_BINS],
+            (ctypes.c_uint32 * N_LATENESS_BINS)(
+                *provenance_data[-N_LATENESS_BINS:]))
 
         with ProvenanceWriter() as db:
             db.insert_core(
@@ -132,6 +164,31 @@ class PopulationMachineSynapsesProvenance(object):
                 x, y, p, self.BIT_FIELD_FILTERED_PACKETS,
                 synapse_prov.n_filtered_by_bitfield)
 
+            db.insert_core(
+                x, y, p, self.BIT_FIELDS_COMPRESSED,
+                synapse_prov.n_compressed_bitfield_reads)
+            db.insert_core(
+                x, y, p, self.BLOOM_FILTER_TESTS,
+                synapse_prov.n_bloom_filter_tests)
+            db.insert_core(
+                x, y, p, self.BLOOM_FILTER_FALSE_POSITIVES,
+                synapse_prov.n_bloom_filter_false_positives)
+            if synapse_prov.n_bloom_filter_false_positives > 0:
+                rate = (synapse_prov.n_bloom_filter_false_positives /
+                        synapse_prov.n_bloom_filter_tests)
+                db.insert_report(
+                    f"On {label}, the Bloom filters used to save DTCM "
+                    f"wrongly passed {rate:.1%} of the spikes tested, which "
+                    "then had to be checked in SDRAM. "
+                    "Try reducing neurons per core.")
+
+            db.insert_core(
+                x, y, p, self.POP_TABLE_CACHE_HITS,
+                synapse_prov.n_pop_table_cache_hits)
+            db.insert_core(
+                x, y, p, self.POP_TABLE_CACHE_MISSES,
+                synapse_prov.n_pop_table_cache_misses)
+
             db.insert_core(
                 x, y, p, self.SYNAPSES_SKIPPED,
                 synapse_prov.n_skipped_synapses)
@@ -145,3 +202,12 @@ class PopulationMachineSynapsesProvenance(object):
                 x, y, p, self.LATE_SPIKES, synapse_prov.n_late_spikes)
             db.insert_core(
                 x, y, p, self.MAX_LATE_SPIKE, synapse_prov.max_late_spike)
+            lateness = synapse_prov.lateness_histogram
+            for i in range(N_LATENESS_BINS - 1):
+                db.insert_core(
+                    x, y, p, f"Rows of spikes {i} timesteps late",
+                    lateness[i])
+            db.insert_core(
+                x, y, p,
+                f"Rows of spikes {N_LATENESS_BINS - 1} or more timesteps late",
+                lateness[N_LATENESS_BINS - 1])
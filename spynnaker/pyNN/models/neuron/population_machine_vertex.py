@@ -342,8 +342,10 @@ class PopulationMachineVertex(
         AbstractRewritesDataSpecification.regenerate_data_specification)
     def regenerate_data_specification(
             self, spec: DataSpecificationReloader, placement: Placement):
+        self._rewrite_synapse_blocks(placement)
+
         if self.__regenerate_neuron_data:
-            self._rewrite_neuron_data_spec(spec)
+            self._rewrite_neuron_data_spec(spec, self.__ring_buffer_shifts)
             self.__regenerate_neuron_data = False
 
         if self.__regenerate_synapse_data:
@@ -357,7 +359,9 @@ class PopulationMachineVertex(
 
     @overrides(AbstractRewritesDataSpecification.reload_required)
     def reload_required(self) -> bool:
-        return self.__regenerate_neuron_data or self.__regenerate_synapse_data
+        return (self.__regenerate_neuron_data or
+                self.__regenerate_synapse_data or
+                self._has_synapse_blocks_to_rewrite)
 
     @overrides(AbstractRewritesDataSpecification.set_reload_required)
     def set_reload_required(self, new_value: bool):
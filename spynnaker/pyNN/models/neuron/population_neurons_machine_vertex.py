@@ -49,7 +49,13 @@ from .abstract_population_vertex import AbstractPopulationVertex
 # + 1 word for n_neurons + 1 word for n_synapse_types
 # + 1 word for number of synapse vertices
 # + 1 word for number of neuron bits needed
-SDRAM_PARAMS_SIZE = 6 * BYTES_PER_WORD
+# + 1 word for number of sources that are not synapse cores
+SDRAM_PARAMS_SIZE = 7 * BYTES_PER_WORD
+
+
+#: The number of bins of the histogram of the time step used: one per tenth
+#: of the time step, then one for overruns
+N_TIME_STEP_USE_BINS = 11
 
 
 class NeuronMainProvenance(ctypes.LittleEndianStructure):
@@ -59,9 +65,12 @@ class NeuronMainProvenance(ctypes.LittleEndianStructure):
     _fields_ = [
         # the maximum number of times the timer tick didn't complete in time
         ("n_timer_overruns", ctypes.c_uint32),
+        # the number of time steps by the tenth of the time step used, then
+        # the number that overran
+        ("time_step_use", ctypes.c_uint32 * N_TIME_STEP_USE_BINS)
     ]
 
-    N_ITEMS = len(_fields_)
+    N_ITEMS = 1 + N_TIME_STEP_USE_BINS
 
 
 class PopulationNeuronsMachineVertex(
@@ -77,6 +86,8 @@ class PopulationNeuronsMachineVertex(
     __slots__ = (
         "__key",
         "__sdram_partition",
+        "__n_sources_read",
+        "__n_dense_sources",
         "__ring_buffer_shifts",
         "__weight_scales",
         "__slice_index",
@@ -84,6 +95,10 @@ class PopulationNeuronsMachineVertex(
         "__max_atoms_per_core",
         "__regenerate_data")
 
+    TIMER_TICK_OVERRUNS_NAME = "Timer tick overruns"
+    #: Formatted with the lower and upper percentage of each bin
+    TIME_STEP_USE_NAME = "Timesteps using {}-{}% of the timestep"
+
     class REGIONS(IntEnum):
         """
         Regions for populations.
@@ -151,6 +166,8 @@ class PopulationNeuronsMachineVertex(
         self.__key: Optional[int] = None
         self.__sdram_partition: Optional[
             SourceSegmentedSDRAMMachinePartition] = None
+        self.__n_sources_read: Optional[int] = None
+        self.__n_dense_sources = 0
         self.__slice_index = slice_index
         self.__ring_buffer_shifts = ring_buffer_shifts
         self.__weight_scales = weight_scales
@@ -199,7 +216,9 @@ class PopulationNeuronsMachineVertex(
         return self.__max_atoms_per_core
 
     def set_sdram_partition(
-            self, sdram_partition: SourceSegmentedSDRAMMachinePartition):
+            self, sdram_partition: SourceSegmentedSDRAMMachinePartition,
+            n_sources_read: Optional[int] = None,
+            n_dense_sources: int = 0):
         """
         Set the SDRAM partition.  Must only be called once per instance.
 
@@ -207,11 +226,22 @@ class PopulationNeuronsMachineVertex(
             The SDRAM partition to receive synapses from
         :type sdram_partition:
             ~pacman.model.graphs.machine.SourceSegmentedSDRAMMachinePartition
+        :param n_sources_read:
+            The number of sources of the partition to read the inputs of,
+            from the first; by default all of them.  This is fewer when the
+            synapse cores add up their inputs before sending them.
+        :type n_sources_read: int or None
+        :param int n_dense_sources:
+            The number of sources of the partition, from the first, that are
+            not synapse cores, and so always send all their inputs with no
+            header after them
         """
         if self.__sdram_partition is not None:
             raise SynapticConfigurationException(
                 "Trying to set SDRAM partition more than once")
         self.__sdram_partition = sdram_partition
+        self.__n_sources_read = n_sources_read
+        self.__n_dense_sources = n_dense_sources
 
     @staticmethod
     def __get_binary_file_name(app_vertex: AbstractPopulationVertex) -> str:
@@ -236,11 +266,13 @@ class PopulationNeuronsMachineVertex(
         self._parse_neuron_provenance(
             x, y, p, provenance_data[:NeuronProvenance.N_ITEMS])
 
+        main_data = provenance_data[-NeuronMainProvenance.N_ITEMS:]
         neuron_prov = NeuronMainProvenance(
-            *provenance_data[-NeuronMainProvenance.N_ITEMS:])
+            main_data[0],
+            (ctypes.c_uint32 * N_TIME_STEP_USE_BINS)(*main_data[1:]))
 
         with ProvenanceWriter() as db:
-            db.insert_core(x, y, p, "Timer tick overruns",
+            db.insert_core(x, y, p, self.TIMER_TICK_OVERRUNS_NAME,
                            neuron_prov.n_timer_overruns)
             if neuron_prov.n_timer_overruns > 0:
                 db.insert_report(
@@ -250,6 +282,20 @@ class PopulationNeuronsMachineVertex(
                     " Try with fewer neurons per core, increasing the time"
                     " scale factor, or reducing the number of spikes sent")
 
+            use = neuron_prov.time_step_use
+            for i in range(N_TIME_STEP_USE_BINS - 1):
+                db.insert_core(
+                    x, y, p,
+                    self.TIME_STEP_USE_NAME.format(i * 10, (i + 1) * 10),
+                    use[i])
+            near_limit = use[N_TIME_STEP_USE_BINS - 2]
+            if near_limit > 0 and neuron_prov.n_timer_overruns == 0:
+                db.insert_report(
+                    f"Vertex {label} used over 90% of the timestep on "
+                    f"{near_limit} timesteps, so is close to overrunning. "
+                    "Recording the neuron phase cycles shows where the time"
+                    " goes.")
+
     @overrides(PopulationMachineCommon.get_recorded_region_ids)
     def get_recorded_region_ids(self) -> List[int]:
         ids = self._pop_vertex.neuron_recorder.recorded_ids_by_slice(
@@ -274,7 +320,11 @@ class PopulationNeuronsMachineVertex(
         spec.write_value(
             self.__sdram_partition.get_sdram_base_address_for(self))
         spec.write_value(self.n_bytes_for_transfer)
-        spec.write_value(len(self.__sdram_partition.pre_vertices))
+        n_sources_read = self.__n_sources_read
+        if n_sources_read is None:
+            n_sources_read = len(self.__sdram_partition.pre_vertices)
+        spec.write_value(n_sources_read)
+        spec.write_value(self.__n_dense_sources)
 
         # End the writing of this specification:
         spec.end_specification()
@@ -284,7 +334,7 @@ class PopulationNeuronsMachineVertex(
     def regenerate_data_specification(
             self, spec: DataSpecificationReloader, placement: Placement):
         # Write the other parameters
-        self._rewrite_neuron_data_spec(spec)
+        self._rewrite_neuron_data_spec(spec, self.__ring_buffer_shifts)
 
         # close spec
         spec.end_specification()
@@ -14,11 +14,12 @@
 from __future__ import annotations
 from enum import IntEnum
 import ctypes
-from typing import Optional, Sequence, TYPE_CHECKING
+from typing import List, Optional, Sequence, TYPE_CHECKING
 
 from spinn_utilities.overrides import overrides
 from spinn_utilities.abstract_base import abstractmethod
-from spinn_utilities.config_holder import get_config_int
+from spinn_utilities.config_holder import (
+    get_config_int, get_config_str)
 from pacman.model.resources import AbstractSDRAM
 from pacman.model.graphs.machine import (
     SDRAMMachineEdge, SourceSegmentedSDRAMMachinePartition)
@@ -26,10 +27,13 @@ from pacman.model.graphs.common import Slice
 from spinn_front_end_common.interface.ds import DataSpecificationGenerator
 from spinn_front_end_common.interface.provenance import ProvenanceWriter
 from spinn_front_end_common.utilities.constants import BYTES_PER_WORD
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
 from spynnaker.pyNN.data import SpynnakerDataView
 from spynnaker.pyNN.exceptions import SynapticConfigurationException
 from spynnaker.pyNN.models.abstract_models import (
     ReceivesSynapticInputsOverSDRAM, SendsSynapticInputsOverSDRAM)
+from spynnaker.pyNN.utilities.bit_field_utilities import (
+    get_hot_sources, get_priority_sources)
 from .population_machine_common import CommonRegions, PopulationMachineCommon
 from .synaptic_matrices import SynapseRegions
 from .population_machine_synapses_provenance import SynapseProvenance
@@ -38,15 +42,44 @@ if TYPE_CHECKING:
     from .population_neurons_machine_vertex import (
         PopulationNeuronsMachineVertex)
 
+#: The most other synapse cores whose inputs can be added to those of a core
+#: before they are sent to the neuron core
+MAX_REDUCE_PARTNERS = 5
+
 # Size of SDRAM params = 1 word for address + 1 word for size
-#  + 1 word for time to send
-SDRAM_PARAMS_SIZE = 3 * BYTES_PER_WORD
+#  + 1 word for time to send + 1 word for the number of reduce partners
+#  + 1 word for transfers and 1 word for reduces to stop before the end
+#  + 1 word for the address of each reduce partner
+SDRAM_PARAMS_SIZE = (6 + MAX_REDUCE_PARTNERS) * BYTES_PER_WORD
 
 # Size of the Key config params = 1 work for key + 1 word for mask
 #  + 1 word for spike mask + 1 word for colour shift
 #  + 1 word for self connection Boolean
 KEY_CONFIG_SIZE = 5 * BYTES_PER_WORD
 
+#: The most sources whose rows are hinted to the synaptic row cache
+MAX_HOT_SOURCES = 8
+
+# Size of the row cache hints = 1 word for the number of sources
+#  + 1 word for key and 1 word for mask of each source
+ROW_CACHE_HINTS_SIZE = (1 + 2 * MAX_HOT_SOURCES) * BYTES_PER_WORD
+
+#: The late packet policies of the configuration, by name
+LATE_PACKET_POLICIES = {"drop_all": 1, "drop_aged": 2, "keep_priority": 3}
+
+#: The most sources whose late packets can be kept by priority
+MAX_LATE_PRIORITY_SOURCES = 8
+
+# Size of the late packet config = 1 word for the policy + 1 word for the
+#  maximum age + 1 word for the colour mask + 1 word for the number of
+#  priority sources + 1 word for key and 1 word for mask of each source
+LATE_PACKET_CONFIG_SIZE = (
+    (4 + 2 * MAX_LATE_PRIORITY_SOURCES) * BYTES_PER_WORD)
+
+
+#: The number of bins of the histogram of when spikes arrive in the time step
+N_ARRIVAL_BINS = 8
+
 
 class SpikeProcessingFastProvenance(ctypes.LittleEndianStructure):
     """
@@ -81,10 +114,34 @@ class SpikeProcessingFastProvenance(ctypes.LittleEndianStructure):
         # The latest time a spike was received
         ("latest_receive", ctypes.c_uint32),
         # The maximum overflow of spikes in a time step
-        ("max_spikes_overflow", ctypes.c_uint32)
+        ("max_spikes_overflow", ctypes.c_uint32),
+        # The number of rows read as part of the DMA of an adjacent row
+        ("n_rows_coalesced", ctypes.c_uint32),
+        # The number of times a row was applied again for a repeated spike
+        ("n_repeated_row_applications", ctypes.c_uint32),
+        # The number of rows processed from the row cache
+        ("n_row_cache_hits", ctypes.c_uint32),
+        # The number of rows processed that were not in the row cache
+        ("n_row_cache_misses", ctypes.c_uint32),
+        # The number of plastic row write backs saved by the row cache
+        ("n_write_backs_deferred", ctypes.c_uint32),
+        # The number of words of unchanged plastic data not written back
+        ("n_write_back_words_saved", ctypes.c_uint32),
+        # The number of row write backs saved by keeping the plastic header
+        ("n_history_write_backs_deferred", ctypes.c_uint32),
+        # The number of plastic synapses updated as post-synaptic spikes
+        # happened
+        ("n_eager_post_updates", ctypes.c_uint32),
+        # The number of plastic write backs that waited for the read of the
+        # next rows while the rows after them were processed
+        ("n_write_backs_queued", ctypes.c_uint32),
+        # The number of late packets dropped by the late packet policy
+        ("n_late_packets_dropped", ctypes.c_uint32),
+        # The number of packets received in each eighth of the time step
+        ("arrival_histogram", ctypes.c_uint32 * N_ARRIVAL_BINS)
     ]
 
-    N_ITEMS = len(_fields_)
+    N_ITEMS = len(_fields_) - 1 + N_ARRIVAL_BINS
 
 
 class PopulationSynapsesMachineVertexCommon(
@@ -99,6 +156,7 @@ class PopulationSynapsesMachineVertexCommon(
     SPIKES_PROCESSED = "How many spikes were processed"
     N_REWIRES_NAME = "Number_of_rewires"
     N_LATE_SPIKES_NAME = "Number_of_late_spikes"
+    N_LATE_PACKETS_DROPPED_NAME = "Number_of_late_packets_dropped"
     MAX_FILLED_SIZE_OF_INPUT_BUFFER_NAME = "Max_filled_size_input_buffer"
     MAX_SPIKES_RECEIVED = "Max_spikes_received_in_time_step"
     MAX_SPIKES_PROCESSED = "Max_spikes_processed_in_time_step"
@@ -108,11 +166,27 @@ class PopulationSynapsesMachineVertexCommon(
     EARLIEST_RECEIVE = "Earliest_receive_time"
     LATEST_RECEIVE = "Latest_receive_time"
     MAX_SPIKE_OVERFLOW = "Max_spike_overflow_in_time_step"
+    N_ROWS_COALESCED = "Number_of_rows_read_with_an_adjacent_row"
+    N_REPEATED_ROW_APPLICATIONS = "Number_of_rows_applied_again_for_a_repeat"
+    N_ROW_CACHE_HITS = "Number_of_rows_found_in_the_row_cache"
+    N_ROW_CACHE_MISSES = "Number_of_rows_not_found_in_the_row_cache"
+    N_WRITE_BACKS_DEFERRED = "Number_of_plastic_row_write_backs_deferred"
+    N_WRITE_BACK_WORDS_SAVED = "Number_of_unchanged_plastic_words_not_written"
+    N_HISTORY_WRITE_BACKS_DEFERRED = \
+        "Number_of_plastic_row_write_backs_of_only_the_history_deferred"
+    N_EAGER_POST_UPDATES = \
+        "Number_of_plastic_synapses_updated_as_post_synaptic_spikes_happened"
+    N_WRITE_BACKS_QUEUED = \
+        "Number_of_plastic_row_write_backs_queued_behind_the_next_read"
 
     __slots__ = (
         "__sdram_partition",
         "__neuron_vertex",
-        "__partition_id")
+        "__partition_id",
+        "__reduce_partners",
+        "__n_transfers_before_end",
+        "__n_reduces_before_end",
+        "__delay_wheel_size")
 
     class REGIONS(IntEnum):
         """
@@ -131,6 +205,8 @@ class PopulationSynapsesMachineVertexCommon(
         SDRAM_EDGE_PARAMS = 10
         KEY_REGION = 11
         CONNECTOR_BUILDER = 12
+        DELAY_WHEEL = 13
+        POST_INDEX = 14
 
     # Regions for this vertex used by common parts
     COMMON_REGIONS = CommonRegions(
@@ -147,14 +223,20 @@ class PopulationSynapsesMachineVertexCommon(
         REGIONS.SYNAPSE_DYNAMICS,
         REGIONS.STRUCTURAL_DYNAMICS,
         REGIONS.BIT_FIELD_FILTER,
-        REGIONS.CONNECTOR_BUILDER)
+        REGIONS.CONNECTOR_BUILDER,
+        REGIONS.POST_INDEX)
 
     _PROFILE_TAG_LABELS = {
         0: "TIMER_SYNAPSES",
         1: "DMA_READ",
         2: "INCOMING_SPIKE",
         3: "PROCESS_FIXED_SYNAPSES",
-        4: "PROCESS_PLASTIC_SYNAPSES"}
+        4: "PROCESS_PLASTIC_SYNAPSES",
+        5: "DMA_WAIT",
+        6: "PROCESS_ROWS",
+        7: "WRITE_BACK",
+        8: "TRANSFER",
+        9: "POP_TABLE_LOOKUP"}
 
     def __init__(
             self, sdram: AbstractSDRAM, label: str,
@@ -176,6 +258,11 @@ class PopulationSynapsesMachineVertexCommon(
             SourceSegmentedSDRAMMachinePartition] = None
         self.__neuron_vertex: Optional[PopulationNeuronsMachineVertex] = None
         self.__partition_id: Optional[str] = None
+        self.__reduce_partners: List[
+            PopulationSynapsesMachineVertexCommon] = []
+        self.__n_transfers_before_end = 1
+        self.__n_reduces_before_end = 0
+        self.__delay_wheel_size = 0
 
     def set_sdram_partition(
             self, sdram_partition: SourceSegmentedSDRAMMachinePartition):
@@ -192,6 +279,41 @@ class PopulationSynapsesMachineVertexCommon(
                 "Trying to set SDRAM partition more than once")
         self.__sdram_partition = sdram_partition
 
+    def set_reduction(
+            self, partners: List[PopulationSynapsesMachineVertexCommon],
+            n_transfers_before_end: int, n_reduces_before_end: int):
+        """
+        Set the other synapse cores whose inputs are added to those of this
+        core before they are sent to the neuron core, and when to stop
+        processing spikes so that this can be done in time.
+
+        :param list(PopulationSynapsesMachineVertexCommon) partners:
+            The synapse cores to add the inputs of, in the order to add them
+        :param int n_transfers_before_end:
+            The number of transfers to leave time for at the end of the time
+            step
+        :param int n_reduces_before_end:
+            The number of reads of the inputs of other cores to leave time for
+            at the end of the time step
+        """
+        if len(partners) > MAX_REDUCE_PARTNERS:
+            raise SynapticConfigurationException(
+                f"At most {MAX_REDUCE_PARTNERS} synapse cores can be added "
+                "to another")
+        self.__reduce_partners = list(partners)
+        self.__n_transfers_before_end = n_transfers_before_end
+        self.__n_reduces_before_end = n_reduces_before_end
+
+    def set_delay_wheel_size(self, delay_wheel_size: int):
+        """
+        Set the size of the delay wheel, which holds the synapses with delays
+        too long for the ring buffers.
+
+        :param int delay_wheel_size:
+            The size of the delay wheel in bytes, or 0 if there isn't one
+        """
+        self.__delay_wheel_size = delay_wheel_size
+
     def set_neuron_vertex_and_partition_id(
             self, neuron_vertex: PopulationNeuronsMachineVertex,
             partition_id: str):
@@ -242,19 +364,48 @@ class PopulationSynapsesMachineVertexCommon(
         spec.switch_write_focus(self.REGIONS.SDRAM_EDGE_PARAMS)
 
         spec.write_value(base_addr)
-        spec.write_value(send_size)
+        spec.write_value(
+            send_size -
+            ReceivesSynapticInputsOverSDRAM.N_BYTES_FOR_SYNAPSE_HEADER)
         spec.write_value(get_config_int(
             "Simulation", "transfer_overhead_clocks"))
+        spec.write_value(len(self.__reduce_partners))
+        spec.write_value(self.__n_transfers_before_end)
+        spec.write_value(self.__n_reduces_before_end)
+        for i in range(MAX_REDUCE_PARTNERS):
+            if i < len(self.__reduce_partners):
+                spec.write_value(
+                    self.__sdram_partition.get_sdram_base_address_for(
+                        self.__reduce_partners[i]))
+            else:
+                spec.write_value(0)
+
+    def _write_delay_wheel_spec(self, spec: DataSpecificationGenerator):
+        """
+        Reserve the delay wheel region if there is a delay wheel; the core
+        initialises it itself.
+
+        :param DataSpecificationGenerator spec:
+            The generator of the specification to write
+        """
+        if self.__delay_wheel_size > 0:
+            spec.reserve_memory_region(
+                region=self.REGIONS.DELAY_WHEEL,
+                size=self.__delay_wheel_size, label="Delay Wheel")
 
     def _write_key_spec(self, spec: DataSpecificationGenerator):
         """
-        Write key configuration region.
+        Write key configuration region, followed by the sources whose
+        rows are worth keeping in the synaptic row cache and how to drop
+        late packets.
 
         :param DataSpecificationGenerator spec:
             The generator of the specification to write
         """
         spec.reserve_memory_region(
-            region=self.REGIONS.KEY_REGION, size=KEY_CONFIG_SIZE,
+            region=self.REGIONS.KEY_REGION,
+            size=(KEY_CONFIG_SIZE + ROW_CACHE_HINTS_SIZE +
+                  LATE_PACKET_CONFIG_SIZE),
             label="Key Config")
         spec.switch_write_focus(self.REGIONS.KEY_REGION)
 
@@ -276,11 +427,42 @@ class PopulationSynapsesMachineVertexCommon(
             spec.write_value(self._pop_vertex.n_colour_bits)
             spec.write_value(int(self._pop_vertex.self_projection is not None))
 
+        hot_sources = get_hot_sources(
+            self._pop_vertex.incoming_projections, MAX_HOT_SOURCES)
+        spec.write_value(len(hot_sources))
+        for key, mask in hot_sources:
+            spec.write_value(key)
+            spec.write_value(mask)
+        # The hints have a fixed space, so the late packet config follows it
+        for _ in range(len(hot_sources), MAX_HOT_SOURCES):
+            spec.write_value(0)
+            spec.write_value(0)
+
+        policy = get_config_str("Simulation", "late_spike_policy")
+        if policy not in LATE_PACKET_POLICIES:
+            raise ConfigurationException(
+                f"Unknown late_spike_policy {policy}; it must be one of "
+                f"{', '.join(LATE_PACKET_POLICIES)}")
+        priority_sources = []
+        if policy == "keep_priority":
+            priority_sources = get_priority_sources(
+                self._pop_vertex.incoming_projections,
+                MAX_LATE_PRIORITY_SOURCES)
+        spec.write_value(LATE_PACKET_POLICIES[policy])
+        spec.write_value(get_config_int("Simulation", "late_spike_max_age"))
+        spec.write_value(
+            (1 << get_config_int("Simulation", "n_colour_bits")) - 1)
+        spec.write_value(len(priority_sources))
+        for key, mask in priority_sources:
+            spec.write_value(key)
+            spec.write_value(mask)
+
     @overrides(SendsSynapticInputsOverSDRAM.sdram_requirement)
     def sdram_requirement(self, sdram_machine_edge: SDRAMMachineEdge) -> int:
         if isinstance(sdram_machine_edge.post_vertex,
                       ReceivesSynapticInputsOverSDRAM):
-            return sdram_machine_edge.post_vertex.n_bytes_for_transfer
+            return (sdram_machine_edge.post_vertex.n_bytes_for_transfer +
+                    ReceivesSynapticInputsOverSDRAM.N_BYTES_FOR_SYNAPSE_HEADER)
         raise SynapticConfigurationException(
             f"Unknown post vertex type in edge {sdram_machine_edge}")
 
@@ -321,7 +503,10 @@ class PopulationSynapsesMachineVertexCommon(
         :param int p: virtual id of the core
         :param list(int) provenance_data: A list of data items to interpret
         """
-        prov = SpikeProcessingFastProvenance(*provenance_data)
+        prov = SpikeProcessingFastProvenance(
+            *provenance_data[:-N_ARRIVAL_BINS],
+            (ctypes.c_uint32 * N_ARRIVAL_BINS)(
+                *provenance_data[-N_ARRIVAL_BINS:]))
 
         with ProvenanceWriter() as db:
             db.insert_core(
@@ -346,8 +531,22 @@ class PopulationSynapsesMachineVertexCommon(
 
             db.insert_core(
                 x, y, p, self.N_LATE_SPIKES_NAME, prov.n_late_packets)
+            db.insert_core(
+                x, y, p, self.N_LATE_PACKETS_DROPPED_NAME,
+                prov.n_late_packets_dropped)
             if prov.n_late_packets == 0:
                 pass
+            elif (self._pop_vertex.drop_late_spikes and
+                    prov.n_late_packets_dropped < prov.n_late_packets):
+                policy = get_config_str("Simulation", "late_spike_policy")
+                db.insert_report(
+                    f"On {label}, {prov.n_late_packets} packets (maximum of "
+                    f" {prov.max_spikes_overflow} per time step) arrived too "
+                    "late to be processed in a given time step, of which "
+                    f"{prov.n_late_packets_dropped} were dropped by the "
+                    f"{policy} late_spike_policy. Try increasing the "
+                    "time_scale_factor located within the .spynnaker.cfg file "
+                    "or in the pynn.setup() method.")
             elif self._pop_vertex.drop_late_spikes:
                 db.insert_report(
                     f"On {label}, {prov.n_late_packets} packets (maximum of "
@@ -405,3 +604,39 @@ class PopulationSynapsesMachineVertexCommon(
                 x, y, p, self.LATEST_RECEIVE, prov.latest_receive)
             db.insert_core(
                 x, y, p, self.MAX_SPIKE_OVERFLOW, prov.max_spikes_overflow)
+            db.insert_core(
+                x, y, p, self.N_ROWS_COALESCED, prov.n_rows_coalesced)
+            db.insert_core(
+                x, y, p, self.N_REPEATED_ROW_APPLICATIONS,
+                prov.n_repeated_row_applications)
+            db.insert_core(
+                x, y, p, self.N_ROW_CACHE_HITS, prov.n_row_cache_hits)
+            db.insert_core(
+                x, y, p, self.N_ROW_CACHE_MISSES, prov.n_row_cache_misses)
+            db.insert_core(
+                x, y, p, self.N_WRITE_BACKS_DEFERRED,
+                prov.n_write_backs_deferred)
+            db.insert_core(
+                x, y, p, self.N_WRITE_BACK_WORDS_SAVED,
+                prov.n_write_back_words_saved)
+            db.insert_core(
+                x, y, p, self.N_HISTORY_WRITE_BACKS_DEFERRED,
+                prov.n_history_write_backs_deferred)
+            db.insert_core(
+                x, y, p, self.N_EAGER_POST_UPDATES,
+                prov.n_eager_post_updates)
+            db.insert_core(
+                x, y, p, self.N_WRITE_BACKS_QUEUED,
+                prov.n_write_backs_queued)
+            arrivals = prov.arrival_histogram
+            for i in range(N_ARRIVAL_BINS):
+                db.insert_core(
+                    x, y, p,
+                    f"Packets received in eighth {i + 1} of the timestep",
+                    arrivals[i])
+            late_arrivals = arrivals[N_ARRIVAL_BINS - 1]
+            if late_arrivals > 0 and prov.n_late_packets > 0:
+                db.insert_report(
+                    f"On {label}, {late_arrivals} packets arrived in the last"
+                    " eighth of the timestep, leaving little time to process"
+                    " them. Try increasing the time_scale_factor.")
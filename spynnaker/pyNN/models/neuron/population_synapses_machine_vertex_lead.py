@@ -129,6 +129,9 @@ class PopulationSynapsesMachineVertexLead(
         # Write information about keys
         self._write_key_spec(spec)
 
+        # Reserve the delay wheel
+        self._write_delay_wheel_spec(spec)
+
         # End the writing of this specification:
         spec.end_specification()
 
@@ -142,13 +145,12 @@ class PopulationSynapsesMachineVertexLead(
     @overrides(AbstractRewritesDataSpecification.regenerate_data_specification)
     def regenerate_data_specification(
             self, spec: DataSpecificationReloader, placement: Placement):
-        # We don't need to do anything here because the originally written
-        # data can be used again
-        pass
+        # Otherwise the originally written data can be used again
+        self._rewrite_synapse_blocks(placement)
 
     @overrides(AbstractRewritesDataSpecification.reload_required)
     def reload_required(self) -> bool:
-        return self.__regenerate_data
+        return self.__regenerate_data or self._has_synapse_blocks_to_rewrite
 
     @overrides(AbstractRewritesDataSpecification.set_reload_required)
     def set_reload_required(self, new_value: bool):
@@ -74,6 +74,9 @@ class PopulationSynapsesMachineVertexShared(
         # Write information about keys
         self._write_key_spec(spec)
 
+        # Reserve the delay wheel
+        self._write_delay_wheel_spec(spec)
+
         # End the writing of this specification:
         spec.end_specification()
 
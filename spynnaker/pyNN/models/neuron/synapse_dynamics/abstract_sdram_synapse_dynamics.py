@@ -111,9 +111,12 @@ class AbstractSDRAMSynapseDynamics(
             The maximum number of synapses to generate in each row
         :rtype: list(~numpy.ndarray)
         """
-        return [
-            data[connection_row_indices == i][:max_n_synapses].reshape(-1)
-            for i in range(n_rows)]
+        # Group the items by row with one sort, keeping the order of the
+        # items within each row
+        order = numpy.argsort(connection_row_indices, kind="stable")
+        counts = numpy.bincount(connection_row_indices, minlength=n_rows)
+        rows = numpy.split(data[order], numpy.cumsum(counts)[:-1])
+        return [row[:max_n_synapses].reshape(-1) for row in rows[:n_rows]]
 
     def get_n_items(
             self, rows: List[NDArray], item_size: int) -> NDArray[uint32]:
@@ -276,8 +276,8 @@ class SynapseDynamicsNeuromodulation(
             max_atoms_per_core: int) -> ConnectionsArray:
         data = numpy.concatenate(fp_data)
         connections = numpy.zeros(data.size, dtype=NUMPY_CONNECTORS_DTYPE)
-        connections["source"] = numpy.concatenate(
-            [numpy.repeat(i, fp_size[i]) for i in range(len(fp_size))])
+        connections["source"] = numpy.repeat(
+            numpy.arange(len(fp_size)), fp_size)
         connections["target"] = data & 0xFFFF
         connections["weight"] = (data >> 16) & 0xFFFF
         connections["delay"] = 1
@@ -115,25 +115,46 @@ class SynapseDynamicsStatic(
             n_connections = self.__pad_to_length
         return n_connections
 
-    @overrides(AbstractStaticSynapseDynamics.get_static_synaptic_data)
-    def get_static_synaptic_data(
-            self, connections: ConnectionsArray,
-            connection_row_indices: NDArray[integer], n_rows: int,
-            n_synapse_types: int,
-            max_n_synapses: int, max_atoms_per_core: int) -> Tuple[
-                List[NDArray], NDArray]:
-        # pylint: disable=too-many-arguments
+    def get_static_words(
+            self, connections: ConnectionsArray, n_synapse_types: int,
+            max_atoms_per_core: int) -> NDArray[uint32]:
+        """
+        Get the static synaptic word of each connection.
+
+        :param ~numpy.ndarray connections: The connections to get the words of
+        :param int n_synapse_types: The number of synapse types available
+        :param int max_atoms_per_core: The maximum number of atoms on a core
+        :return: The word of each connection, in the order of the connections
+        :rtype: ~numpy.ndarray
+        """
         n_neuron_id_bits = get_n_bits(max_atoms_per_core)
         neuron_id_mask = (1 << n_neuron_id_bits) - 1
         n_synapse_type_bits = get_n_bits(n_synapse_types)
 
-        fixed_fixed = (
+        return (
             ((numpy.rint(numpy.abs(connections["weight"])).astype(uint32) &
               0xFFFF) << 16) |
             (connections["delay"].astype(uint32) <<
              (n_neuron_id_bits + n_synapse_type_bits)) |
             (connections["synapse_type"].astype(uint32) << n_neuron_id_bits) |
             (connections["target"] & neuron_id_mask))
+
+    @overrides(AbstractStaticSynapseDynamics.get_static_synaptic_data)
+    def get_static_synaptic_data(
+            self, connections: ConnectionsArray,
+            connection_row_indices: NDArray[integer], n_rows: int,
+            n_synapse_types: int,
+            max_n_synapses: int, max_atoms_per_core: int) -> Tuple[
+                List[NDArray], NDArray]:
+        # pylint: disable=too-many-arguments
+        fixed_fixed = self.get_static_words(
+            connections, n_synapse_types, max_atoms_per_core)
+
+        # Sort each row by delay, type and target, so that synapses to
+        # adjacent neurons are next to each other in the row
+        order = numpy.lexsort((fixed_fixed & 0xFFFF, connection_row_indices))
+        fixed_fixed = fixed_fixed[order]
+        connection_row_indices = connection_row_indices[order]
         fixed_fixed_rows = self.convert_per_connection_data_to_rows(
             connection_row_indices, n_rows,
             fixed_fixed.view(uint8).reshape((-1, BYTES_PER_WORD)),
@@ -180,8 +201,8 @@ class SynapseDynamicsStatic(
 
         data = numpy.concatenate(ff_data)
         connections = numpy.zeros(data.size, dtype=NUMPY_CONNECTORS_DTYPE)
-        connections["source"] = numpy.concatenate(
-            [numpy.repeat(i, ff_size[i]) for i in range(len(ff_size))])
+        connections["source"] = numpy.repeat(
+            numpy.arange(len(ff_size)), ff_size)
         connections["target"] = data & neuron_id_mask
         connections["weight"] = (data >> 16) & 0xFFFF
         connections["delay"] = (data & 0xFFFF) >> (
@@ -221,14 +242,16 @@ class SynapseDynamicsStatic(
             synapse_info.synapse_type, n_synapse_type_bits,
             n_synapse_index_bits, app_edge.n_delay_stages + 1,
             max_delay, max_delay_bits, app_edge.pre_vertex.n_atoms,
-            max_pre_atoms_per_core],
+            max_pre_atoms_per_core, int(max_row_info.dense),
+            int(max_row_info.byte_targets),
+            int(max_row_info.shared_weight)],
             dtype=uint32)
 
     @property
     @overrides(AbstractGenerateOnMachine.
                gen_matrix_params_size_in_bytes)
     def gen_matrix_params_size_in_bytes(self) -> int:
-        return 12 * BYTES_PER_WORD
+        return 15 * BYTES_PER_WORD
 
     @property
     @overrides(AbstractStaticSynapseDynamics.changes_during_run)
@@ -64,6 +64,12 @@ if TYPE_CHECKING:
 # How large are the time-stamps stored with each event
 TIME_STAMP_BYTES = BYTES_PER_WORD
 
+# The default number of post-synaptic events remembered for each neuron
+DEFAULT_POST_HISTORY_DEPTH = 16
+
+# The most post-synaptic events that can be remembered for each neuron
+_MAX_POST_HISTORY_DEPTH = 2 ** 15
+
 # The targets of neuromodulation
 NEUROMODULATION_TARGETS = {
     "reward": 0,
@@ -91,7 +97,11 @@ class SynapseDynamicsSTDP(
         # padding to add to a synaptic row for synaptic rewiring
         "__pad_to_length",
         # Whether to use back-propagation delay or not
-        "__backprop_delay")
+        "__backprop_delay",
+        # The number of post-synaptic events remembered for each neuron
+        "__post_history_depth",
+        # Whether to apply post-synaptic spikes to synapses as they happen
+        "__eager_post_spikes")
 
     def __init__(
             self, timing_dependence: AbstractTimingDependence,
@@ -100,7 +110,9 @@ class SynapseDynamicsSTDP(
             dendritic_delay_fraction: float = 1.0,
             weight: _In_Types = StaticSynapse.default_parameters['weight'],
             delay: _In_Types = None, pad_to_length: Optional[int] = None,
-            backprop_delay: bool = True):
+            backprop_delay: bool = True,
+            post_history_depth: int = DEFAULT_POST_HISTORY_DEPTH,
+            eager_post_spikes: bool = False):
         """
         :param AbstractTimingDependence timing_dependence:
         :param AbstractWeightDependence weight_dependence:
@@ -112,6 +124,17 @@ class SynapseDynamicsSTDP(
         :param pad_to_length:
         :type pad_to_length: int or None
         :param bool backprop_delay:
+        :param int post_history_depth:
+            The number of post-synaptic events remembered for each neuron;
+            rounded up to a power of two.  Spikes of a post-neuron that are
+            older than this many of its spikes are not seen by a synapse that
+            had no pre-synaptic spike while they happened.
+        :param bool eager_post_spikes:
+            Whether to apply each post-synaptic spike to the synapses of its
+            neuron while the synapse core is otherwise idle, rather than
+            waiting for the next pre-synaptic spike of each synapse.  Only
+            supported for the pair rule with additive or multiplicative
+            weights, without back-propagation delay or neuromodulation.
         """
         if timing_dependence is None or weight_dependence is None:
             raise NotImplementedError(
@@ -130,13 +153,28 @@ class SynapseDynamicsSTDP(
         self.__dendritic_delay_fraction = float(dendritic_delay_fraction)
         self.__pad_to_length = pad_to_length
         self.__backprop_delay = backprop_delay
+        self.post_history_depth = post_history_depth
         self.__neuromodulation: Optional[SynapseDynamicsNeuromodulation] = None
+        self.__eager_post_spikes = bool(eager_post_spikes)
 
         if self.__dendritic_delay_fraction != 1.0:
             raise NotImplementedError("All delays must be dendritic!")
+        if self.__eager_post_spikes:
+            if backprop_delay:
+                raise SynapticConfigurationException(
+                    "eager_post_spikes needs backprop_delay to be False")
+            if (timing_dependence.vertex_executable_suffix != "pair" or
+                    weight_dependence.vertex_executable_suffix not in (
+                        "additive", "multiplicative")):
+                raise SynapticConfigurationException(
+                    "eager_post_spikes is only supported for the pair rule "
+                    "with additive or multiplicative weights")
 
     def _merge_neuromodulation(
             self, neuromodulation: SynapseDynamicsNeuromodulation):
+        if self.__eager_post_spikes:
+            raise SynapticConfigurationException(
+                "eager_post_spikes can't be used with neuromodulation")
         if self.__neuromodulation is None:
             self.__neuromodulation = neuromodulation
         elif not self.__neuromodulation.is_neuromodulation_same_as(
@@ -171,6 +209,11 @@ class SynapseDynamicsSTDP(
                 # pylint: disable=protected-access
                 synapse_dynamics._merge_neuromodulation(self.__neuromodulation)
 
+            # Remember enough events for both
+            synapse_dynamics.post_history_depth = max(
+                self.__post_history_depth,
+                synapse_dynamics.post_history_depth)
+
             # If STDP part matches, return the other, as it might also be
             # structural
             return synapse_dynamics
@@ -181,6 +224,10 @@ class SynapseDynamicsSTDP(
         from .synapse_dynamics_structural_stdp import (
             SynapseDynamicsStructuralSTDP)
         if isinstance(synapse_dynamics, AbstractSynapseDynamicsStructural):
+            if self.__eager_post_spikes:
+                raise SynapticConfigurationException(
+                    "eager_post_spikes can't be used with structural "
+                    "plasticity")
             return SynapseDynamicsStructuralSTDP(
                 synapse_dynamics.partner_selection, synapse_dynamics.formation,
                 synapse_dynamics.elimination,
@@ -190,7 +237,8 @@ class SynapseDynamicsSTDP(
                 synapse_dynamics.f_rew, synapse_dynamics.initial_weight,
                 synapse_dynamics.initial_delay, synapse_dynamics.s_max,
                 seed=synapse_dynamics.seed,
-                backprop_delay=self.backprop_delay)
+                backprop_delay=self.backprop_delay,
+                post_history_depth=self.post_history_depth)
 
         # Otherwise, it is static or neuromodulation, so return ourselves
         return self
@@ -253,6 +301,35 @@ class SynapseDynamicsSTDP(
     def backprop_delay(self, backprop_delay):
         self.__backprop_delay = bool(backprop_delay)
 
+    @property
+    def post_history_depth(self) -> int:
+        """
+        The number of post-synaptic events remembered for each neuron.
+        Settable; rounded up to a power of two.
+
+        :rtype: int
+        """
+        return self.__post_history_depth
+
+    @post_history_depth.setter
+    def post_history_depth(self, post_history_depth: int):
+        depth = int(post_history_depth)
+        if depth < 1 or depth > _MAX_POST_HISTORY_DEPTH:
+            raise SynapticConfigurationException(
+                f"post_history_depth must be between 1 and "
+                f"{_MAX_POST_HISTORY_DEPTH}, not {post_history_depth}")
+        self.__post_history_depth = 1 << (depth - 1).bit_length()
+
+    @property
+    def eager_post_spikes(self) -> bool:
+        """
+        Whether post-synaptic spikes are applied to the synapses of their
+        neuron as they happen.
+
+        :rtype: bool
+        """
+        return self.__eager_post_spikes
+
     @property
     def neuromodulation(self) -> Optional[SynapseDynamicsNeuromodulation]:
         """
@@ -270,7 +347,8 @@ class SynapseDynamicsSTDP(
             self.__weight_dependence.is_same_as(
                 synapse_dynamics.weight_dependence) and
             (self.__dendritic_delay_fraction ==
-             synapse_dynamics.dendritic_delay_fraction))
+             synapse_dynamics.dendritic_delay_fraction) and
+            self.__eager_post_spikes == synapse_dynamics.eager_post_spikes)
 
     def get_vertex_executable_suffix(self) -> str:
         """
@@ -287,6 +365,8 @@ class SynapseDynamicsSTDP(
         else:
             name = "_stdp_mad_"
         name += timing_suffix + "_" + weight_suffix
+        if self.__eager_post_spikes:
+            name += "_eager_post"
         return name
 
     def get_parameters_sdram_usage_in_bytes(self, n_neurons, n_synapse_types):
@@ -295,8 +375,8 @@ class SynapseDynamicsSTDP(
         :param int n_synapse_types:
         :rtype: int
         """
-        # 32-bits for back-prop delay
-        size = BYTES_PER_WORD
+        # 32-bits for back-prop delay and for the post-event history depth
+        size = 2 * BYTES_PER_WORD
         size += self.__timing_dependence.get_parameters_sdram_usage_in_bytes()
         size += self.__weight_dependence.get_parameters_sdram_usage_in_bytes(
             n_synapse_types, self.__timing_dependence.n_weight_terms)
@@ -318,6 +398,9 @@ class SynapseDynamicsSTDP(
         # Whether to use back-prop delay
         spec.write_value(int(self.__backprop_delay))
 
+        # How many post-synaptic events to remember for each neuron
+        spec.write_value(self.__post_history_depth)
+
         # Write timing dependence parameters to region
         self.__timing_dependence.write_parameters(
             spec, global_weight_scale, synapse_weight_scales)
@@ -514,8 +597,8 @@ class SynapseDynamicsSTDP(
 
         connections = numpy.zeros(
             data_fixed.size, dtype=NUMPY_CONNECTORS_DTYPE)
-        connections["source"] = numpy.concatenate(
-            [numpy.repeat(i, fp_size[i]) for i in range(len(fp_size))])
+        connections["source"] = numpy.repeat(
+            numpy.arange(len(fp_size)), fp_size)
         connections["target"] = data_fixed & neuron_id_mask
         connections["weight"] = pp_half_words
         connections["delay"] = data_fixed >> (
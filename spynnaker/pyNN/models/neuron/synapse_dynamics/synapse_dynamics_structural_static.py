@@ -184,7 +184,8 @@ class SynapseDynamicsStructuralStatic(SynapseDynamicsStatic, _Common):
                 None, synapse_dynamics.dendritic_delay_fraction,
                 self.f_rew, self.initial_weight, self.initial_delay,
                 self.s_max, self.with_replacement, self.seed,
-                backprop_delay=synapse_dynamics.backprop_delay)
+                backprop_delay=synapse_dynamics.backprop_delay,
+                post_history_depth=synapse_dynamics.post_history_depth)
 
         # Otherwise, it is static, so return ourselves
         return self
@@ -31,7 +31,8 @@ from .abstract_synapse_dynamics import AbstractSynapseDynamics
 from .abstract_plastic_synapse_dynamics import AbstractPlasticSynapseDynamics
 from .abstract_synapse_dynamics_structural import (
     AbstractSynapseDynamicsStructural, InitialDelay)
-from .synapse_dynamics_stdp import SynapseDynamicsSTDP
+from .synapse_dynamics_stdp import (
+    SynapseDynamicsSTDP, DEFAULT_POST_HISTORY_DEPTH)
 from .synapse_dynamics_structural_common import (
     DEFAULT_F_REW, DEFAULT_INITIAL_WEIGHT, DEFAULT_INITIAL_DELAY,
     DEFAULT_S_MAX, SynapseDynamicsStructuralCommon)
@@ -115,7 +116,8 @@ class SynapseDynamicsStructuralSTDP(
             with_replacement: bool = True, seed: Optional[int] = None,
             weight: _In_Types = StaticSynapse.default_parameters['weight'],
             delay: _In_Types = None,
-            backprop_delay: bool = True):
+            backprop_delay: bool = True,
+            post_history_depth: int = DEFAULT_POST_HISTORY_DEPTH):
         """
         :param AbstractPartnerSelection partner_selection:
             The partner selection rule
@@ -151,11 +153,14 @@ class SynapseDynamicsStructuralSTDP(
             Use ``None`` to get the simulator default minimum delay.
         :type delay: float or None
         :param bool backprop_delay: Whether back-propagated delays are used
+        :param int post_history_depth:
+            The number of post-synaptic events remembered for each neuron
         """
         super().__init__(
             timing_dependence, weight_dependence, voltage_dependence,
             dendritic_delay_fraction, weight, delay, pad_to_length=s_max,
-            backprop_delay=backprop_delay)
+            backprop_delay=backprop_delay,
+            post_history_depth=post_history_depth)
         self.__partner_selection = partner_selection
         self.__formation = formation
         self.__elimination = elimination
@@ -199,6 +204,9 @@ class SynapseDynamicsStructuralSTDP(
                 raise SynapticConfigurationException(
                     "Synapse dynamics must match exactly when using multiple"
                     " edges to the same population")
+            # Remember enough events for both
+            self.post_history_depth = max(
+                self.post_history_depth, synapse_dynamics.post_history_depth)
 
         # If everything matches, return ourselves as supreme!
         return self
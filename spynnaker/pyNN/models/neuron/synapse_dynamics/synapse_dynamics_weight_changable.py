@@ -266,8 +266,8 @@ class SynapseDynamicsWeightChangable(
 
         connections = numpy.zeros(
             data_fixed.size, dtype=NUMPY_CONNECTORS_DTYPE)
-        connections["source"] = numpy.concatenate(
-            [numpy.repeat(i, fp_size[i]) for i in range(len(fp_size))])
+        connections["source"] = numpy.repeat(
+            numpy.arange(len(fp_size)), fp_size)
         connections["target"] = data_fixed & neuron_id_mask
         connections["weight"] = pp_half_words
         connections["delay"] = data_fixed >> (
@@ -197,8 +197,8 @@ class SynapseDynamicsWeightChanger(
         n_neuron_id_bits = get_n_bits(max_atoms_per_core)
         neuron_id_mask = (1 << n_neuron_id_bits) - 1
         connections = numpy.zeros(data.size, dtype=NUMPY_CONNECTORS_DTYPE)
-        connections["source"] = numpy.concatenate(
-            [numpy.repeat(i, fp_size[i]) for i in range(len(fp_size))])
+        connections["source"] = numpy.repeat(
+            numpy.arange(len(fp_size)), fp_size)
         connections["target"] = data & neuron_id_mask
         connections["weight"] = weight
         connections["delay"] = 1
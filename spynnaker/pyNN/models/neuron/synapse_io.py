@@ -25,13 +25,15 @@ from spinn_front_end_common.utilities.constants import BYTES_PER_WORD
 
 from spynnaker.pyNN.data import SpynnakerDataView
 from spynnaker.pyNN.models.neural_projections.connectors import (
-    AbstractConnector)
+    AbstractConnector, AllToAllConnector, FixedProbabilityConnector)
 from spynnaker.pyNN.exceptions import SynapseRowTooBigException
 from spynnaker.pyNN.models.neuron.synapse_dynamics import (
     AbstractStaticSynapseDynamics, AbstractSDRAMSynapseDynamics,
-    AbstractPlasticSynapseDynamics)
+    AbstractPlasticSynapseDynamics, AbstractSynapseDynamicsStructural,
+    SynapseDynamicsStatic)
 from spynnaker.pyNN.models.neuron.synapse_dynamics.types import (
     NUMPY_CONNECTORS_DTYPE, ConnectionsArray)
+from spynnaker.pyNN.utilities.utility_calls import get_n_bits
 
 from .master_pop_table import MasterPopTableAsBinarySearch
 
@@ -44,6 +46,29 @@ if TYPE_CHECKING:
     _RowData: TypeAlias = numpy.ndarray  # 2D
 
 _N_HEADER_WORDS = 3
+
+# Flags for the format of the fixed synapses of a row, held in the top bits
+# of the fixed-plastic size; these match synapse_row_format_flags in C
+_ROW_SINGLE_DELAY = 0x1
+_ROW_SINGLE_TYPE = 0x2
+_ROW_DENSE = 0x4
+_ROW_DELAY_SORTED = 0x8
+_ROW_BYTE_TARGETS = 0x10
+_ROW_SHARED_WEIGHT = 0x20
+_ROW_PLASTIC_ONLY = 0x40
+_ROW_FORMAT_SHIFT = 24
+# The mask of the number of plastic synapses in the fixed-plastic size
+_ROW_N_PLASTIC_MASK = (1 << _ROW_FORMAT_SHIFT) - 1
+# The shift of the number of weights in the header word of a dense row
+_DENSE_N_WEIGHTS_SHIFT = 16
+# The mask of the number of synapses in the header word of a byte target row
+_BYTE_TARGETS_N_MASK = 0xFFFF
+# The bits of a synaptic word that a byte target row holds for each synapse
+_BYTE_TARGET_BITS = 8
+# The number of header words of a shared weight row
+_SHARED_WEIGHT_N_HEADER_WORDS = 2
+# The probability of connection above which dense rows are considered
+_MIN_DENSE_P_CONNECT = 0.5
 # There are 16 slots, one per time step
 _STD_DELAY_SLOTS = 16
 
@@ -76,6 +101,18 @@ class MaxRowInfo(object):
     #: delayed matrix.
     delayed_max_words: int
 
+    #: Whether the rows are in the dense format, holding a weight for each
+    #: target neuron rather than a word for each synapse
+    dense: bool = False
+
+    #: Whether the rows are in the byte target format, holding one weight
+    #: for the row and a byte for each synapse rather than a word
+    byte_targets: bool = False
+
+    #: Whether the rows are in the shared weight format, holding one weight,
+    #: delay and type for the row and a half-word for each target
+    shared_weight: bool = False
+
 
 def get_maximum_delay_supported_in_ms(
         post_vertex_max_delay_ticks: int) -> float:
@@ -143,11 +180,48 @@ def get_max_row_info(
 
     # Get the row sizes
     dynamics = synapse_info.synapse_dynamics
+    dense = False
+    byte_targets = False
+    shared_weight = False
     if isinstance(dynamics, AbstractStaticSynapseDynamics):
         undelayed_n_words = dynamics.get_n_words_for_static_connections(
             max_undelayed_n_synapses)
         delayed_n_words = dynamics.get_n_words_for_static_connections(
             max_delayed_n_synapses)
+
+        # Use dense rows if they are smaller than sparse ones would be
+        dense_n_words = _get_n_dense_words(n_post_atoms)
+        if (_can_use_dense_rows(synapse_info) and
+                dense_n_words < max(undelayed_n_words, delayed_n_words)):
+            dense = True
+            if undelayed_n_words:
+                undelayed_n_words = dense_n_words
+            if delayed_n_words:
+                delayed_n_words = dense_n_words
+        # Otherwise use byte target rows if they are smaller
+        elif (_can_use_byte_target_rows(synapse_info, in_edge) and
+                _get_n_byte_target_words(max(
+                    max_undelayed_n_synapses, max_delayed_n_synapses)) <
+                max(undelayed_n_words, delayed_n_words)):
+            byte_targets = True
+            if undelayed_n_words:
+                undelayed_n_words = _get_n_byte_target_words(
+                    max_undelayed_n_synapses)
+            if delayed_n_words:
+                delayed_n_words = _get_n_byte_target_words(
+                    max_delayed_n_synapses)
+        # Otherwise use shared weight rows if they are smaller
+        elif (_can_use_shared_weight_rows(synapse_info) and
+                _get_n_shared_weight_words(max(
+                    max_undelayed_n_synapses, max_delayed_n_synapses)) <
+                max(undelayed_n_words, delayed_n_words)):
+            shared_weight = True
+            if undelayed_n_words:
+                undelayed_n_words = _get_n_shared_weight_words(
+                    max_undelayed_n_synapses)
+            if delayed_n_words:
+                delayed_n_words = _get_n_shared_weight_words(
+                    max_delayed_n_synapses)
     else:
         undelayed_n_words = dynamics.get_n_words_for_plastic_connections(
             max_undelayed_n_synapses)
@@ -172,7 +246,117 @@ def get_max_row_info(
     return MaxRowInfo(
         max_undelayed_n_synapses, max_delayed_n_synapses,
         undelayed_max_bytes, delayed_max_bytes,
-        undelayed_max_n_words, delayed_max_n_words)
+        undelayed_max_n_words, delayed_max_n_words, dense, byte_targets,
+        shared_weight)
+
+
+def _get_n_dense_words(n_post_atoms: int) -> int:
+    """
+    Get the number of words in a dense row, excluding the row headers.
+
+    :param int n_post_atoms: The number of atoms that can be targeted
+    :rtype: int
+    """
+    # A header word and then a half-word weight per target
+    return 1 + ((n_post_atoms + 1) // 2)
+
+
+def _can_use_dense_rows(synapse_info: SynapseInformation) -> bool:
+    """
+    Determine if the synapses can be represented by dense rows; this needs
+    static synapses of a single delay and a non-zero weight, since a zero
+    weight marks a missing synapse, from a connector which connects most
+    of the possible pairs of neurons.
+
+    :param SynapseInformation synapse_info: The synapses to check
+    :rtype: bool
+    """
+    dynamics = synapse_info.synapse_dynamics
+    if (not isinstance(dynamics, SynapseDynamicsStatic) or
+            isinstance(dynamics, AbstractSynapseDynamicsStructural) or
+            dynamics.pad_to_length is not None):
+        return False
+    connector = synapse_info.connector
+    if not (isinstance(connector, AllToAllConnector) or (
+            isinstance(connector, FixedProbabilityConnector) and
+            connector.p_connect > _MIN_DENSE_P_CONNECT)):
+        return False
+    weights = synapse_info.weights
+    return bool(
+        numpy.isscalar(synapse_info.delays) and numpy.isscalar(weights) and
+        weights != 0)
+
+
+def _get_n_byte_target_words(n_synapses: int) -> int:
+    """
+    Get the number of words in a byte target row, excluding the row headers.
+
+    :param int n_synapses: The number of synapses in the row
+    :rtype: int
+    """
+    if n_synapses == 0:
+        return 0
+    # A header word and then a byte per synapse
+    return 1 + ((n_synapses + 3) // 4)
+
+
+def _can_use_byte_target_rows(
+        synapse_info: SynapseInformation,
+        in_edge: ProjectionApplicationEdge) -> bool:
+    """
+    Determine if the synapses can be represented by byte target rows; this
+    needs static synapses of a single weight, on a core small enough that
+    the delay, synapse type and neuron index of a synaptic word fit in a
+    byte.
+
+    :param SynapseInformation synapse_info: The synapses to check
+    :param ProjectionApplicationEdge in_edge: The incoming edge
+    :rtype: bool
+    """
+    dynamics = synapse_info.synapse_dynamics
+    if (not isinstance(dynamics, SynapseDynamicsStatic) or
+            isinstance(dynamics, AbstractSynapseDynamicsStructural) or
+            dynamics.pad_to_length is not None or
+            not numpy.isscalar(synapse_info.weights)):
+        return False
+    post_vertex = in_edge.post_vertex
+    n_bits = (
+        get_n_bits(post_vertex.get_max_atoms_per_core()) +
+        get_n_bits(post_vertex.neuron_impl.get_n_synapse_types()) +
+        get_n_bits(post_vertex.splitter.max_support_delay()))
+    return n_bits <= _BYTE_TARGET_BITS
+
+
+def _get_n_shared_weight_words(n_synapses: int) -> int:
+    """
+    Get the number of words in a shared weight row, excluding the row
+    headers.
+
+    :param int n_synapses: The number of synapses in the row
+    :rtype: int
+    """
+    if n_synapses == 0:
+        return 0
+    # The header words and then a half-word index per synapse
+    return _SHARED_WEIGHT_N_HEADER_WORDS + ((n_synapses + 1) // 2)
+
+
+def _can_use_shared_weight_rows(synapse_info: SynapseInformation) -> bool:
+    """
+    Determine if the synapses can be represented by shared weight rows; this
+    needs static synapses of a single weight and delay.
+
+    :param SynapseInformation synapse_info: The synapses to check
+    :rtype: bool
+    """
+    dynamics = synapse_info.synapse_dynamics
+    if (not isinstance(dynamics, SynapseDynamicsStatic) or
+            isinstance(dynamics, AbstractSynapseDynamicsStructural) or
+            dynamics.pad_to_length is not None):
+        return False
+    return bool(
+        numpy.isscalar(synapse_info.delays) and
+        numpy.isscalar(synapse_info.weights))
 
 
 def _get_allowed_row_length(
@@ -286,7 +470,9 @@ def get_synapses(
             app_edge.pre_vertex.n_atoms, n_synapse_types,
             synapse_info.synapse_dynamics,
             max_row_info.undelayed_max_n_synapses,
-            max_row_info.undelayed_max_words, max_atoms_per_core)
+            max_row_info.undelayed_max_words, max_atoms_per_core,
+            max_row_info.dense, max_row_info.byte_targets,
+            max_row_info.shared_weight)
         del undelayed_row_indices
     del undelayed_connections
 
@@ -312,7 +498,9 @@ def get_synapses(
             app_edge.pre_vertex.n_atoms * n_delay_stages,
             n_synapse_types, synapse_info.synapse_dynamics,
             max_row_info.delayed_max_n_synapses,
-            max_row_info.delayed_max_words, max_atoms_per_core)
+            max_row_info.delayed_max_words, max_atoms_per_core,
+            max_row_info.dense, max_row_info.byte_targets,
+            max_row_info.shared_weight)
         del delayed_row_indices
     del delayed_connections
 
@@ -323,7 +511,9 @@ def _get_row_data(
         connections: ConnectionsArray, row_indices: NDArray[numpy.integer],
         n_rows: int, n_synapse_types: int,
         synapse_dynamics: AbstractSynapseDynamics, max_row_n_synapses: int,
-        max_row_n_words: int, max_atoms_per_core: int) -> _RowData:
+        max_row_n_words: int, max_atoms_per_core: int,
+        dense: bool = False, byte_targets: bool = False,
+        shared_weight: bool = False) -> _RowData:
     """
     :param ~numpy.ndarray connections:
         The connections to convert; the dtype is
@@ -338,21 +528,49 @@ def _get_row_data(
     :param int max_row_n_synapses: The maximum number of synapses in a row
     :param int max_row_n_words: The maximum number of words in a row
     :param int max_atoms_per_core: The maximum number of atoms per core
+    :param bool dense: Whether to write static rows in the dense format
+    :param bool byte_targets:
+        Whether to write static rows in the byte target format
+    :param bool shared_weight:
+        Whether to write static rows in the shared weight format
     :rtype: ~numpy.ndarray
     """
     # pylint: disable=too-many-arguments
     fp_data: Union[NDArray[uint32], List[NDArray[uint32]]]
     pp_data: Union[NDArray[uint32], List[NDArray[uint32]]]
+    if (not dense and not byte_targets and not shared_weight and
+            type(synapse_dynamics) is SynapseDynamicsStatic and
+            synapse_dynamics.pad_to_length is None):
+        # Plain static rows can be packed directly
+        return _get_packed_static_row_data(
+            synapse_dynamics.get_static_words(
+                connections, n_synapse_types, max_atoms_per_core),
+            row_indices, n_rows, n_synapse_types, max_row_n_synapses,
+            max_row_n_words, max_atoms_per_core)
     if isinstance(synapse_dynamics, AbstractStaticSynapseDynamics):
         # Get the static data
         ff_data, ff_size = synapse_dynamics.get_static_synaptic_data(
             connections, row_indices, n_rows, n_synapse_types,
             max_row_n_synapses, max_atoms_per_core)
 
-        # Blank the plastic data
+        # Blank the plastic data, but store the format of the static data
         fp_data = numpy.zeros((n_rows, 0), dtype=uint32)
         pp_data = numpy.zeros((n_rows, 0), dtype=uint32)
-        fp_size = numpy.zeros((n_rows, 1), dtype=uint32)
+        if dense:
+            ff_data, ff_size, fp_size = _get_dense_rows(
+                ff_data, ff_size, max_atoms_per_core)
+        elif byte_targets:
+            ff_data, ff_size, fp_size = _get_byte_target_rows(
+                ff_data, ff_size)
+        elif shared_weight:
+            ff_data, ff_size, fp_size = _get_shared_weight_rows(
+                ff_data, ff_size, max_atoms_per_core)
+        else:
+            _sort_static_rows_by_delay(
+                ff_data, ff_size, n_synapse_types, max_atoms_per_core)
+            fp_size = _get_static_row_formats(
+                ff_data, ff_size, n_synapse_types, max_atoms_per_core)
+            fp_size |= _ROW_DELAY_SORTED << _ROW_FORMAT_SHIFT
         pp_size = numpy.zeros((n_rows, 1), dtype=uint32)
     else:
         assert isinstance(synapse_dynamics, AbstractPlasticSynapseDynamics)
@@ -366,6 +584,9 @@ def _get_row_data(
                 connections, row_indices, n_rows, n_synapse_types,
                 max_row_n_synapses, max_atoms_per_core)
 
+        # There are no static synapses, so none need to be processed
+        fp_size = fp_size | uint32(_ROW_PLASTIC_ONLY << _ROW_FORMAT_SHIFT)
+
     # Add some padding
     row_lengths = [
         pp_data[i].size + fp_data[i].size + ff_data[i].size
@@ -383,6 +604,305 @@ def _get_row_data(
     return row_data
 
 
+def _get_packed_static_row_data(
+        words: NDArray[uint32], row_indices: NDArray[numpy.integer],
+        n_rows: int, n_synapse_types: int, max_row_n_synapses: int,
+        max_row_n_words: int, max_atoms_per_core: int) -> NDArray[uint32]:
+    """
+    Pack static synaptic words into rows, sorted and flagged as
+    :py:func:`_sort_static_rows_by_delay` and
+    :py:func:`_get_static_row_formats` would, but with a sort of all the
+    words at once and a scatter into a single buffer rather than work per
+    row.
+
+    :param ~numpy.ndarray words: The static synaptic word of each connection
+    :param ~numpy.ndarray row_indices:
+        The row into which each word should go; same length as words
+    :param int n_rows: The total number of rows
+    :param int n_synapse_types: The number of synapse types available
+    :param int max_row_n_synapses: The maximum number of synapses in a row
+    :param int max_row_n_words: The maximum number of words in a row
+    :param int max_atoms_per_core: The maximum number of atoms on a core
+    :rtype: ~numpy.ndarray
+    """
+    # pylint: disable=too-many-arguments
+    n_neuron_id_bits = get_n_bits(max_atoms_per_core)
+    n_synapse_type_bits = get_n_bits(n_synapse_types)
+    delay_shift = n_neuron_id_bits + n_synapse_type_bits
+    rows = row_indices.astype(numpy.int64)
+    low_words = (words & 0xFFFF).astype(numpy.int64)
+
+    # Drop what doesn't fit in a row, keeping the first by delay, type and
+    # target, as the rows would be cut when split up
+    counts = numpy.bincount(rows, minlength=n_rows)
+    if len(counts) and counts.max() > max_row_n_synapses:
+        order = numpy.argsort((rows << 16) | low_words, kind="stable")
+        rows = rows[order]
+        starts = numpy.cumsum(counts) - counts
+        keep = (numpy.arange(len(rows)) - starts[rows]) < max_row_n_synapses
+        order = order[keep]
+        rows = rows[keep]
+        words = words[order]
+        low_words = low_words[order]
+        counts = numpy.minimum(counts, max_row_n_synapses)
+
+    # Sort by row, then by delay with 0 (the maximum) last, then by type and
+    # target, with one sort of a combined key
+    delay_keys = ((low_words >> delay_shift) - 1) & (0xFFFF >> delay_shift)
+    order = numpy.argsort(
+        (rows << 32) | (delay_keys << 16) | low_words, kind="stable")
+    rows = rows[order]
+    words = words[order]
+    starts = numpy.cumsum(counts) - counts
+    positions = numpy.arange(len(rows)) - starts[rows]
+
+    # Work out the format of each row from how each word matches the first
+    # word of its row; an empty row matches everything
+    type_mask = ((1 << n_synapse_type_bits) - 1) << n_neuron_id_bits
+    delay_mask = 0xFFFF & ~(type_mask | ((1 << n_neuron_id_bits) - 1))
+    first_words = words[starts[rows]]
+    multi_delay = numpy.bincount(
+        rows, weights=((words ^ first_words) & delay_mask) != 0,
+        minlength=n_rows)
+    multi_type = numpy.bincount(
+        rows, weights=((words ^ first_words) & type_mask) != 0,
+        minlength=n_rows)
+    formats = numpy.full(n_rows, _ROW_DELAY_SORTED, dtype=uint32)
+    formats[multi_delay[:n_rows] == 0] |= _ROW_SINGLE_DELAY
+    formats[multi_type[:n_rows] == 0] |= _ROW_SINGLE_TYPE
+
+    # Write the headers and then the words into their places in the rows
+    row_n_words = max_row_n_words + _N_HEADER_WORDS
+    row_data = numpy.zeros(n_rows * row_n_words, dtype=uint32)
+    row_data[1::row_n_words] = counts[:n_rows]
+    row_data[2::row_n_words] = formats << _ROW_FORMAT_SHIFT
+    row_data[rows * row_n_words + _N_HEADER_WORDS + positions] = words
+    return row_data
+
+
+def _get_static_row_formats(
+        ff_data: List[NDArray[uint32]], ff_size: NDArray[integer],
+        n_synapse_types: int, max_atoms_per_core: int) -> NDArray[uint32]:
+    """
+    Work out the format flags of each row of static synaptic words, so that
+    the rows can be processed with a specialised handler.
+
+    :param list(~numpy.ndarray) ff_data: The static synaptic words of each row
+    :param ~numpy.ndarray ff_size: The number of synapses in each row
+    :param int n_synapse_types: The number of synapse types available
+    :param int max_atoms_per_core: The maximum number of atoms on a core
+    :return: The format flags, shifted into place, one per row
+    :rtype: ~numpy.ndarray
+    """
+    n_neuron_id_bits = get_n_bits(max_atoms_per_core)
+    n_synapse_type_bits = get_n_bits(n_synapse_types)
+    type_mask = ((1 << n_synapse_type_bits) - 1) << n_neuron_id_bits
+    delay_mask = 0xFFFF & ~(type_mask | ((1 << n_neuron_id_bits) - 1))
+    sizes = ff_size.reshape(-1)
+    formats = numpy.zeros((len(ff_data), 1), dtype=uint32)
+    for i, row in enumerate(ff_data):
+        # Ignore any padding after the synapses
+        words = row[:sizes[i]]
+        flags = 0
+        if numpy.all((words & delay_mask) == (words[:1] & delay_mask)):
+            flags |= _ROW_SINGLE_DELAY
+        if numpy.all((words & type_mask) == (words[:1] & type_mask)):
+            flags |= _ROW_SINGLE_TYPE
+        formats[i] = flags << _ROW_FORMAT_SHIFT
+    return formats
+
+
+def _sort_static_rows_by_delay(
+        ff_data: List[NDArray[uint32]], ff_size: NDArray[integer],
+        n_synapse_types: int, max_atoms_per_core: int):
+    """
+    Sort the static synaptic words of each row by delay, in place, so that
+    the synapses that are too late for a spike are at the start of the row.
+    A delay of 0 represents the maximum delay so is sorted last, and the
+    order of the words with the same delay is kept.
+
+    :param list(~numpy.ndarray) ff_data: The static synaptic words of each row
+    :param ~numpy.ndarray ff_size: The number of synapses in each row
+    :param int n_synapse_types: The number of synapse types available
+    :param int max_atoms_per_core: The maximum number of atoms on a core
+    """
+    delay_shift = get_n_bits(max_atoms_per_core) + get_n_bits(n_synapse_types)
+    delay_mask = (0xFFFF >> delay_shift)
+    sizes = ff_size.reshape(-1)
+    for i, row in enumerate(ff_data):
+        words = row[:sizes[i]]
+        keys = ((words >> delay_shift).astype(numpy.int64) - 1) & delay_mask
+        words[:] = words[numpy.argsort(keys, kind="stable")]
+
+
+def _get_dense_rows(
+        ff_data: List[NDArray[uint32]], ff_size: NDArray[integer],
+        max_atoms_per_core: int) -> Tuple[
+            List[NDArray[uint32]], NDArray[uint32], NDArray[uint32]]:
+    """
+    Convert rows of static synaptic words, which must all have the same
+    delay and synapse type, into dense rows.
+
+    :param list(~numpy.ndarray) ff_data: The static synaptic words of each row
+    :param ~numpy.ndarray ff_size: The number of synapses in each row
+    :param int max_atoms_per_core: The maximum number of atoms on a core
+    :return: The dense words of each row, the number of words in each row,
+        and the format flags, shifted into place, of each row
+    :rtype: tuple(list(~numpy.ndarray), ~numpy.ndarray, ~numpy.ndarray)
+    """
+    index_mask = (1 << get_n_bits(max_atoms_per_core)) - 1
+    sizes = ff_size.reshape(-1)
+    dense_data: List[NDArray[uint32]] = list()
+    for i, row in enumerate(ff_data):
+        words = row[:sizes[i]]
+        if not len(words):
+            dense_data.append(numpy.zeros(0, dtype=uint32))
+            continue
+        indices = words & index_mask
+        n_weights = int(indices.max()) + 1
+        # Repeated synapses are combined, saturating as in the ring buffer
+        weights = numpy.zeros(n_weights + (n_weights & 1), dtype=uint32)
+        numpy.add.at(weights, indices, words >> 16)
+        weights = numpy.minimum(weights, 0xFFFF).astype("<u2")
+        header = (
+            (int(words[0]) & 0xFFFF & ~index_mask) |
+            (n_weights << _DENSE_N_WEIGHTS_SHIFT))
+        dense_data.append(numpy.concatenate((
+            numpy.array([header], dtype=uint32), weights.view("<u4"))))
+    dense_size = numpy.array(
+        [[len(row)] for row in dense_data], dtype=uint32).reshape(-1, 1)
+    formats = numpy.full(
+        (len(ff_data), 1),
+        (_ROW_DENSE | _ROW_SINGLE_DELAY | _ROW_SINGLE_TYPE) <<
+        _ROW_FORMAT_SHIFT, dtype=uint32)
+    return dense_data, dense_size, formats
+
+
+def _expand_dense_row(
+        words: NDArray[uint32], max_atoms_per_core: int) -> NDArray[uint32]:
+    """
+    Convert a dense row back into static synaptic words, one for each
+    non-zero weight.
+
+    :param ~numpy.ndarray words: The dense words, header first
+    :param int max_atoms_per_core: The maximum number of atoms on a core
+    :rtype: ~numpy.ndarray
+    """
+    if not len(words):
+        return words
+    header = int(words[0])
+    n_weights = header >> _DENSE_N_WEIGHTS_SHIFT
+    weights = words[1:].astype("<u4").view("<u2")[:n_weights]
+    targets = numpy.nonzero(weights)[0].astype(uint32)
+    template = header & 0xFFFF & ~((1 << get_n_bits(max_atoms_per_core)) - 1)
+    return (
+        (weights[targets].astype(uint32) << 16) | template | targets).astype(
+            uint32)
+
+
+def _get_byte_target_rows(
+        ff_data: List[NDArray[uint32]], ff_size: NDArray[integer]) -> Tuple[
+            List[NDArray[uint32]], NDArray[uint32], NDArray[uint32]]:
+    """
+    Convert rows of static synaptic words, which must all have the same
+    weight and fit the rest in a byte, into byte target rows.
+
+    :param list(~numpy.ndarray) ff_data: The static synaptic words of each row
+    :param ~numpy.ndarray ff_size: The number of synapses in each row
+    :return: The byte target words of each row, the number of words in each
+        row, and the format flags, shifted into place, of each row
+    :rtype: tuple(list(~numpy.ndarray), ~numpy.ndarray, ~numpy.ndarray)
+    """
+    sizes = ff_size.reshape(-1)
+    byte_data: List[NDArray[uint32]] = list()
+    for i, row in enumerate(ff_data):
+        words = row[:sizes[i]]
+        if not len(words):
+            byte_data.append(numpy.zeros(0, dtype=uint32))
+            continue
+        n_words = _get_n_byte_target_words(len(words)) - 1
+        targets = numpy.zeros(n_words * BYTES_PER_WORD, dtype="<u1")
+        targets[:len(words)] = words & 0xFF
+        header = (int(words[0]) & 0xFFFF0000) | len(words)
+        byte_data.append(numpy.concatenate((
+            numpy.array([header], dtype=uint32), targets.view("<u4"))))
+    byte_size = numpy.array(
+        [[len(row)] for row in byte_data], dtype=uint32).reshape(-1, 1)
+    formats = numpy.full(
+        (len(ff_data), 1),
+        (_ROW_BYTE_TARGETS | _ROW_SINGLE_TYPE) << _ROW_FORMAT_SHIFT,
+        dtype=uint32)
+    return byte_data, byte_size, formats
+
+
+def _expand_byte_target_row(words: NDArray[uint32]) -> NDArray[uint32]:
+    """
+    Convert a byte target row back into static synaptic words.
+
+    :param ~numpy.ndarray words: The byte target words, header first
+    :rtype: ~numpy.ndarray
+    """
+    if not len(words):
+        return words
+    header = int(words[0])
+    n_synapses = header & _BYTE_TARGETS_N_MASK
+    targets = words[1:].astype("<u4").view("<u1")[:n_synapses]
+    return ((header & 0xFFFF0000) | targets.astype(uint32)).astype(uint32)
+
+
+def _get_shared_weight_rows(
+        ff_data: List[NDArray[uint32]], ff_size: NDArray[integer],
+        max_atoms_per_core: int) -> Tuple[
+            List[NDArray[uint32]], NDArray[uint32], NDArray[uint32]]:
+    """
+    Convert rows of static synaptic words, which must all have the same
+    weight, delay and synapse type, into shared weight rows.
+
+    :param list(~numpy.ndarray) ff_data: The static synaptic words of each row
+    :param ~numpy.ndarray ff_size: The number of synapses in each row
+    :param int max_atoms_per_core: The maximum number of atoms on a core
+    :return: The shared weight words of each row, the number of words in
+        each row, and the format flags, shifted into place, of each row
+    :rtype: tuple(list(~numpy.ndarray), ~numpy.ndarray, ~numpy.ndarray)
+    """
+    index_mask = (1 << get_n_bits(max_atoms_per_core)) - 1
+    sizes = ff_size.reshape(-1)
+    shared_data: List[NDArray[uint32]] = list()
+    for i, row in enumerate(ff_data):
+        words = row[:sizes[i]]
+        if not len(words):
+            shared_data.append(numpy.zeros(0, dtype=uint32))
+            continue
+        targets = numpy.zeros(len(words) + (len(words) & 1), dtype="<u2")
+        targets[:len(words)] = words & index_mask
+        header = int(words[0]) & ~index_mask
+        shared_data.append(numpy.concatenate((
+            numpy.array([header, len(words)], dtype=uint32),
+            targets.view("<u4"))))
+    shared_size = numpy.array(
+        [[len(row)] for row in shared_data], dtype=uint32).reshape(-1, 1)
+    formats = numpy.full(
+        (len(ff_data), 1),
+        (_ROW_SHARED_WEIGHT | _ROW_SINGLE_DELAY | _ROW_SINGLE_TYPE) <<
+        _ROW_FORMAT_SHIFT, dtype=uint32)
+    return shared_data, shared_size, formats
+
+
+def _expand_shared_weight_row(words: NDArray[uint32]) -> NDArray[uint32]:
+    """
+    Convert a shared weight row back into static synaptic words.
+
+    :param ~numpy.ndarray words: The shared weight words, header first
+    :rtype: ~numpy.ndarray
+    """
+    if not len(words):
+        return words
+    header, n_synapses = int(words[0]), int(words[1])
+    targets = words[_SHARED_WEIGHT_N_HEADER_WORDS:].astype("<u4").view(
+        "<u2")[:n_synapses]
+    return (header | targets.astype(uint32)).astype(uint32)
+
+
 def convert_to_connections(
         synapse_info: SynapseInformation, post_vertex_slice: Slice,
         n_pre_atoms: int, max_row_length: int, n_synapse_types: int,
@@ -502,15 +1022,18 @@ def read_all_synapses(
 
 
 def _parse_static_data(
-        row_data: _RowData,
-        dynamics: AbstractStaticSynapseDynamics) -> Tuple[
+        row_data: _RowData, dynamics: AbstractStaticSynapseDynamics,
+        max_atoms_per_core: int) -> Tuple[
             NDArray[numpy.integer], List[_RowData]]:
     """
-    Parse static synaptic data.
+    Parse static synaptic data; dense rows are expanded into a synaptic
+    word for each non-zero weight, and byte target and shared weight rows
+    into a synaptic word for each target.
 
     :param ~numpy.ndarray row_data: The raw row data
     :param AbstractStaticSynapseDynamics dynamics:
         The synapse dynamics that can decode the rows
+    :param int max_atoms_per_core: The maximum number of atoms on a core
     :return: A tuple of the recorded length of each row and the row data
         organised into rows
     :rtype: tuple(~numpy.ndarray, list(~numpy.ndarray))
@@ -520,9 +1043,24 @@ def _parse_static_data(
     ff_words = dynamics.get_n_static_words_per_row(ff_size)
     ff_start = _N_HEADER_WORDS
     ff_end = ff_start + ff_words
-    return (
-        ff_size,
-        [row_data[row, ff_start:ff_end[row]] for row in range(n_rows)])
+    ff_data = [row_data[row, ff_start:ff_end[row]] for row in range(n_rows)]
+    formats = row_data[:, 2] >> _ROW_FORMAT_SHIFT
+    dense = (formats & _ROW_DENSE) != 0
+    byte_targets = (formats & _ROW_BYTE_TARGETS) != 0
+    shared_weight = (formats & _ROW_SHARED_WEIGHT) != 0
+    if numpy.any(dense | byte_targets | shared_weight):
+        ff_size = ff_size.copy()
+        for row in numpy.nonzero(dense)[0]:
+            ff_data[row] = _expand_dense_row(
+                ff_data[row], max_atoms_per_core)
+            ff_size[row] = len(ff_data[row])
+        for row in numpy.nonzero(byte_targets)[0]:
+            ff_data[row] = _expand_byte_target_row(ff_data[row])
+            ff_size[row] = len(ff_data[row])
+        for row in numpy.nonzero(shared_weight)[0]:
+            ff_data[row] = _expand_shared_weight_row(ff_data[row])
+            ff_size[row] = len(ff_data[row])
+    return ff_size, ff_data
 
 
 def _read_static_data(
@@ -549,7 +1087,8 @@ def _read_static_data(
     """
     if row_data is None or not row_data.size:
         return numpy.zeros(0, dtype=NUMPY_CONNECTORS_DTYPE)
-    ff_size, ff_data = _parse_static_data(row_data, dynamics)
+    ff_size, ff_data = _parse_static_data(
+        row_data, dynamics, max_atoms_per_core)
     connections = dynamics.read_static_synaptic_data(
         n_synapse_types, ff_size, ff_data, max_atoms_per_core)
     if delayed:
@@ -580,7 +1119,8 @@ def _parse_plastic_data(
     n_rows = row_data.shape[0]
     pp_size = row_data[:, 0]
     pp_words = dynamics.get_n_plastic_plastic_words_per_row(pp_size)
-    fp_size = row_data[numpy.arange(n_rows), pp_words + 2]
+    fp_size = row_data[numpy.arange(n_rows), pp_words + 2] & \
+        _ROW_N_PLASTIC_MASK
     fp_words = dynamics.get_n_fixed_plastic_words_per_row(fp_size)
     fp_start = pp_size + _N_HEADER_WORDS
     fp_end = fp_start + fp_words
@@ -667,23 +1207,14 @@ def _convert_delayed_data(
     """
     # Work out the delay stage of each row; rows are the all the rows
     # from the first delay stage, then all from the second stage and so on
-    synapse_ids = range(len(n_synapses))
-    row_stage = numpy.array([
-        i // n_pre_atoms
-        for i in synapse_ids], dtype=uint32)
+    row_stage = numpy.arange(len(n_synapses), dtype=uint32) // n_pre_atoms
+    # Work out the stage of each connection from the stage of its row
+    connection_stage = numpy.repeat(row_stage, n_synapses)
     # Work out the delay for each stage
-    row_min_delay = (row_stage + 1) * post_vertex_max_delay_ticks
-    # Repeat the delay for all connections in the same row
-    connection_min_delay = numpy.concatenate([
-        numpy.repeat(row_min_delay[i], n_synapses[i])
-        for i in synapse_ids])
-    # Repeat the "extra" source id for all connections in the same row;
-    # this converts the row id back to a source neuron id
-    connection_source_extra = numpy.concatenate([
-        numpy.repeat(
-            row_stage[i] * uint32(n_pre_atoms),
-            n_synapses[i])
-        for i in synapse_ids])
+    connection_min_delay = (connection_stage + 1) * post_vertex_max_delay_ticks
+    # Work out the "extra" source id of each connection; this converts the
+    # row id back to a source neuron id
+    connection_source_extra = connection_stage * uint32(n_pre_atoms)
     # Do the conversions
     delayed_connections["source"] -= connection_source_extra
     delayed_connections["delay"] += connection_min_delay
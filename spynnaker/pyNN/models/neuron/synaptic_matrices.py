@@ -12,14 +12,18 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 from __future__ import annotations
+from concurrent.futures import ThreadPoolExecutor
 from dataclasses import dataclass
 from typing import (
-    Dict, List, NamedTuple, Optional, Sequence, Tuple, TYPE_CHECKING, cast)
+    Dict, List, NamedTuple, Optional, Sequence, Set, Tuple, Union,
+    TYPE_CHECKING, cast)
 
 import numpy
 from numpy import floating, uint32
 from numpy.typing import NDArray
 
+from spinn_utilities.config_holder import get_config_bool, get_config_int
+
 from pacman.model.graphs.common import Slice
 from pacman.model.placements import Placement
 from pacman.model.routing_info import (
@@ -30,17 +34,21 @@ from spinn_front_end_common.interface.ds import (
     DataType, DataSpecificationBase)
 
 from spinn_front_end_common.utilities.constants import BYTES_PER_WORD
+from spinn_front_end_common.utilities.helpful_functions import (
+    locate_memory_region_for_placement)
 
 from spynnaker.pyNN.data import SpynnakerDataView
 from spynnaker.pyNN.models.neuron.master_pop_table import (
-    MasterPopTableAsBinarySearch)
+    MasterPopTableAsBinarySearch, PopTableSummary, get_pop_table_summary)
 from spynnaker.pyNN.models.neuron.synapse_dynamics import (
-    AbstractSynapseDynamicsStructural)
+    AbstractSynapseDynamicsStructural, SynapseDynamicsSTDP)
 from spynnaker.pyNN.utilities.bit_field_utilities import (
     get_sdram_for_bit_field_region, get_bitfield_key_map_data,
     write_bitfield_init_data, is_sdram_poisson_source)
 from spynnaker.pyNN.models.common import PopulationApplicationVertex
-from spynnaker.pyNN.models.spike_source import SpikeSourcePoissonVertex
+from spynnaker.pyNN.models.spike_source import (
+    SpikeSourceArrayVertex, SpikeSourcePoissonVertex)
+from spynnaker.pyNN.utilities.utility_calls import get_n_bits
 
 from .synaptic_matrix_app import SynapticMatrixApp
 
@@ -54,6 +62,7 @@ if TYPE_CHECKING:
 # 1 for master pop region
 # 1 for bitfield filter region
 # 1 for structural region
+# 1 for post index region
 # 1 for n_edges
 # 1 for post_vertex_slice.lo_atom
 # 1 for post_vertex_slice.n_atoms
@@ -64,10 +73,90 @@ if TYPE_CHECKING:
 # 4 for Population RNG seed
 # 4 for core RNG seed
 SYNAPSES_BASE_GENERATOR_SDRAM_USAGE_IN_BYTES = (
-    1 + 1 + 1 + 1 + 1 + 1 + 1 + 1 + 1 + 1 + 1 + 4 + 4) * BYTES_PER_WORD
+    1 + 1 + 1 + 1 + 1 + 1 + 1 + 1 + 1 + 1 + 1 + 1 + 4 + 4) * BYTES_PER_WORD
 
 DIRECT_MATRIX_HEADER_COST_BYTES = 1 * BYTES_PER_WORD
 
+#: The dirty rows offset to tell the core not to note the rows written back
+DIRTY_ROWS_NONE = 0xFFFFFFFF
+
+
+def get_dirty_rows_size(n_bytes: int) -> int:
+    """
+    Get the size of the bit field that notes the rows written back, which
+    has a bit for each word of the synaptic matrix region before it.
+
+    :param int n_bytes: The size of the synaptic matrices
+    :rtype: int
+    """
+    n_words = (n_bytes + BYTES_PER_WORD - 1) // BYTES_PER_WORD
+    return ((n_words + 31) // 32) * BYTES_PER_WORD
+
+
+#: The event counters offset to tell the core not to count the events of
+#: each projection
+EVENT_COUNTERS_NONE = 0xFFFFFFFF
+
+#: The events counted for each master population table item: the rows
+#: fetched, the words of those rows and the packets filtered out
+EVENT_COUNTER_NAMES = ("rows_fetched", "words_fetched", "packets_filtered")
+
+
+def get_event_counters_size(n_items: int) -> int:
+    """
+    Get the size of the events counted for each item of a master population
+    table.
+
+    :param int n_items: The number of items in the address list
+    :rtype: int
+    """
+    return n_items * len(EVENT_COUNTER_NAMES) * BYTES_PER_WORD
+
+#: The header of the index of the plastic synapses of each neuron: the
+#: neurons, the neuron and synapse type bits and the most entries
+POST_INDEX_HEADER_WORDS = 4
+
+#: The size of each entry of the index: the row address, and the index and
+#: synapse type of the synapse in the row
+POST_INDEX_ENTRY_BYTES = 2 * BYTES_PER_WORD
+
+
+def uses_eager_post(app_vertex: AbstractPopulationVertex) -> bool:
+    """
+    Whether the synapse cores of a population apply post-synaptic spikes
+    to the plastic synapses of each neuron as they happen.
+
+    :param AbstractPopulationVertex app_vertex:
+    :rtype: bool
+    """
+    synapse_dynamics = app_vertex.synapse_dynamics
+    return (isinstance(synapse_dynamics, SynapseDynamicsSTDP) and
+            synapse_dynamics.eager_post_spikes)
+
+
+def get_post_max_entries(all_syn_block_sz: int) -> int:
+    """
+    Get the most entries the index of the plastic synapses of each neuron
+    can need, as each synapse takes at least a word of the matrices.
+
+    :param int all_syn_block_sz: The size of the synaptic matrices
+    :rtype: int
+    """
+    return all_syn_block_sz // BYTES_PER_WORD
+
+
+def get_post_index_size(n_neurons: int, all_syn_block_sz: int) -> int:
+    """
+    Get the size of the index of the plastic synapses of each neuron.
+
+    :param int n_neurons: The neurons of the core
+    :param int all_syn_block_sz: The size of the synaptic matrices
+    :rtype: int
+    """
+    return ((POST_INDEX_HEADER_WORDS + n_neurons + 1) * BYTES_PER_WORD +
+            get_post_max_entries(all_syn_block_sz) * POST_INDEX_ENTRY_BYTES)
+
+
 # Value to use when there is no region
 INVALID_REGION_ID = 0xFFFFFFFF
 
@@ -83,6 +172,7 @@ class SynapseRegions(NamedTuple):
     structural_dynamics: int
     bitfield_filter: int
     connection_builder: int
+    post_index: Optional[int] = None
 
 
 class SynapseRegionReferences(NamedTuple):
@@ -96,6 +186,7 @@ class SynapseRegionReferences(NamedTuple):
     structural_dynamics: Optional[int] = None
     bitfield_filter: Optional[int] = None
     connection_builder: Optional[int] = None
+    post_index: Optional[int] = None
 
 
 @dataclass(frozen=True)
@@ -171,7 +262,26 @@ class SynapticMatrices(object):
         # The bit field key map generated
         "__bit_field_key_map",
         # The maximum generated data, for calculating timeouts
-        "__max_gen_data")
+        "__max_gen_data",
+        # The on-host matrices to write to the machine again, with the
+        # post-vertex slices still to write them for
+        "__blocks_to_rewrite",
+        # The offset of the bit field of the rows written back, or None if
+        # these are not noted
+        "__dirty_rows_offset",
+        # The words starting rows written back and not yet read by each
+        # matrix, by post-vertex slice
+        "__dirty_rows",
+        # The offset of the events counted for each master population table
+        # item, or None if these are not counted
+        "__event_counters_offset",
+        # The number of master population table items
+        "__n_pop_table_items",
+        # The positions of the master population table items of each matrix
+        "__pop_table_positions",
+        # Whether the plastic synapses of each neuron are indexed to apply
+        # post-synaptic spikes as they happen
+        "__eager_post")
 
     def __init__(
             self, app_vertex: AbstractPopulationVertex,
@@ -190,6 +300,8 @@ class SynapticMatrices(object):
         self.__max_atoms_per_core = max_atoms_per_core
         self.__weight_scales = weight_scales
         self.__all_syn_block_sz = all_syn_block_sz
+        self.__eager_post = (
+            regions.post_index is not None and uses_eager_post(app_vertex))
 
         # Map of (app_edge, synapse_info) to SynapticMatrixApp
         self.__matrices: Dict[
@@ -206,11 +318,19 @@ class SynapticMatrices(object):
         self.__max_gen_data = 0
         self.__on_host_matrices: List[SynapticMatrixApp] = []
         self.__on_machine_matrices: List[SynapticMatrixApp] = []
-        self.__generated_data: Optional[NDArray[uint32]] = None
+        self.__generated_data: Optional[Dict[Slice, NDArray[uint32]]] = None
         self.__generated_data_size = 0
         self.__master_pop_data: Optional[NDArray[uint32]] = None
         self.__bit_field_size = 0
         self.__bit_field_key_map: Optional[NDArray[uint32]] = None
+        self.__blocks_to_rewrite: Dict[SynapticMatrixApp, Set[Slice]] = dict()
+        self.__dirty_rows_offset: Optional[int] = None
+        self.__dirty_rows: Dict[Slice, NDArray[numpy.bool_]] = dict()
+        self.__event_counters_offset: Optional[int] = None
+        self.__n_pop_table_items = 0
+        self.__pop_table_positions: Dict[
+            Tuple[ProjectionApplicationEdge, SynapseInformation],
+            List[int]] = dict()
 
     @property
     def max_gen_data(self) -> int:
@@ -230,6 +350,18 @@ class SynapticMatrices(object):
         """
         return self.__bit_field_size
 
+    @property
+    def pop_table_summary(self) -> Optional[PopTableSummary]:
+        """
+        The size and shape of the master population table, or `None` if
+        the data hasn't been generated.
+
+        :rtype: PopTableSummary or None
+        """
+        if self.__master_pop_data is None:
+            return None
+        return get_pop_table_summary(self.__master_pop_data)
+
     @property
     def host_generated_block_addr(self) -> int:
         """
@@ -254,6 +386,71 @@ class SynapticMatrices(object):
         return (self.__on_chip_generated_block_addr -
                 self.__host_generated_block_addr)
 
+    def get_generated_data_size(self, post_vertex_slice: Slice) -> int:
+        """
+        The size of the data that the synapse expander reads for a slice of
+        the post-vertex.
+
+        :param ~pacman.model.graphs.common.Slice post_vertex_slice:
+            The slice of the post-vertex
+        :rtype: int
+        """
+        size = self.__generated_data_size
+        if self.__generated_data is not None:
+            size += (len(self.__generated_data[post_vertex_slice]) *
+                     BYTES_PER_WORD)
+        return size
+
+    def get_expanded_blocks(
+            self, placement: Placement) -> Optional[List[Tuple[int, int]]]:
+        """
+        Get the blocks of SDRAM that the synapse expander writes, which can be
+        saved and written again rather than being expanded again.
+
+        :param ~pacman.model.placements.Placement placement:
+            Where the matrices are on the machine
+        :return: The address and size of each block, or None if the expander
+            also writes other data, such as the structural or post index data
+        :rtype: list(tuple(int, int)) or None
+        """
+        if self.__eager_post or isinstance(
+                self.__app_vertex.synapse_dynamics,
+                AbstractSynapseDynamicsStructural):
+            return None
+        matrix_address = locate_memory_region_for_placement(
+            placement, self.__regions.synaptic_matrix)
+        bit_field_address = locate_memory_region_for_placement(
+            placement, self.__regions.bitfield_filter)
+        return [
+            (matrix_address + self.__host_generated_block_addr,
+             self.on_chip_generated_matrix_size),
+            (bit_field_address, self.__bit_field_size)]
+
+    @property
+    def dirty_rows_offset(self) -> int:
+        """
+        The offset in the synaptic matrix region of the bit field of the rows
+        written back, or :py:const:`DIRTY_ROWS_NONE` if these are not noted.
+
+        :rtype: int
+        """
+        if self.__dirty_rows_offset is None:
+            return DIRTY_ROWS_NONE
+        return self.__dirty_rows_offset
+
+    @property
+    def event_counters_offset(self) -> int:
+        """
+        The offset in the synaptic matrix region of the events counted for
+        each projection, or :py:const:`EVENT_COUNTERS_NONE` if these are not
+        counted.
+
+        :rtype: int
+        """
+        if self.__event_counters_offset is None:
+            return EVENT_COUNTERS_NONE
+        return self.__event_counters_offset
+
     def generate_data(self) -> None:
         """
         Generates the data if it has not already been done.
@@ -261,11 +458,72 @@ class SynapticMatrices(object):
         # If the data has already been generated, stop
         if self.__data_generated:
             return
+
+        n_threads = get_config_int("Simulation", "n_host_synapse_threads")
+        if n_threads is None or n_threads <= 1:
+            # The blocks are made one at a time as they are written, from
+            # the RNG of each connector in turn as before
+            self.__prepare_data(reserve_seeds=False)
+            return
+        if get_config_bool(
+                "Simulation", "host_synapse_threads_across_populations"):
+            all_matrices = self.__all_synaptic_matrices()
+        else:
+            all_matrices = [self]
+
+        # Lay out each in turn, then generate the on-host blocks of all of
+        # them together
+        blocks: List[Tuple[SynapticMatrixApp, Slice]] = list()
+        for matrices in all_matrices:
+            if not matrices.__data_generated:
+                blocks.extend(matrices.__prepare_data(reserve_seeds=True))
+        with ThreadPoolExecutor(max_workers=n_threads) as executor:
+            futures = [
+                executor.submit(matrix.generate_row_data, post_slice)
+                for matrix, post_slice in blocks]
+            # Raise any error from the generation here
+            for future in futures:
+                future.result()
+
+    def __all_synaptic_matrices(self) -> List[SynapticMatrices]:
+        """
+        Get the synaptic matrices of every population, this one first.
+
+        :rtype: list(SynapticMatrices)
+        """
+        # pylint: disable=import-outside-toplevel
+        from .population_machine_synapses import PopulationMachineSynapses
+        all_matrices: List[SynapticMatrices] = [self]
+        seen = {id(self)}
+        for app_vertex in SpynnakerDataView.iterate_vertices():
+            for vertex in app_vertex.machine_vertices:
+                if not isinstance(vertex, PopulationMachineSynapses):
+                    continue
+                # pylint: disable=protected-access
+                matrices = vertex._synaptic_matrices
+                if id(matrices) not in seen:
+                    seen.add(id(matrices))
+                    all_matrices.append(matrices)
+        return all_matrices
+
+    def __prepare_data(self, reserve_seeds: bool) -> List[
+            Tuple[SynapticMatrixApp, Slice]]:
+        """
+        Lay out the data, and reserve the random seeds of the on-host
+        generated blocks if asked to.
+
+        :param bool reserve_seeds:
+            Whether to reserve the seeds of the on-host generated blocks
+        :return: The on-host generated blocks, which can then be generated
+            in any order if their seeds are reserved
+        :rtype:
+            list(tuple(SynapticMatrixApp, ~pacman.model.graphs.common.Slice))
+        """
         self.__data_generated = True
 
         # If there are no synapses, there is nothing to do!
         if self.__all_syn_block_sz == 0:
-            return
+            return []
 
         # Track writes inside the synaptic matrix region:
         block_addr = 0
@@ -277,7 +535,6 @@ class SynapticMatrices(object):
         # Set up other lists
         self.__on_host_matrices = list()
         self.__on_machine_matrices = list()
-        generated_data: List[NDArray[uint32]] = list()
 
         # Keep on-machine generated blocks together at the end
         self.__generated_data_size = (
@@ -285,7 +542,7 @@ class SynapticMatrices(object):
             (self.__n_synapse_types * DataType.U3232.size))
 
         # For each incoming machine vertex, reserve pop table space
-        for proj in self.__app_vertex.incoming_projections:
+        for proj in self.__app_vertex.incoming_projections_in_layout_order:
             # pylint: disable=protected-access
             app_edge = proj._projection_edge
             synapse_info = proj._synapse_information
@@ -309,26 +566,62 @@ class SynapticMatrices(object):
                 self.__on_host_matrices.append(app_matrix)
 
         self.__host_generated_block_addr = block_addr
+        host_blocks = self.__reserve_host_block_seeds(reserve_seeds)
 
         # Now add the blocks on machine to keep these all together
         self.__max_gen_data = 0
         for app_matrix in self.__on_machine_matrices:
             block_addr = app_matrix.reserve_matrices(block_addr, poptable)
-            gen_data = app_matrix.get_generator_data()
-            self.__generated_data_size += gen_data.size
-            generated_data.extend(gen_data.gen_data)
             self.__max_gen_data += app_matrix.gen_size
-        if generated_data:
-            self.__gen_on_machine = True
-            self.__generated_data = numpy.concatenate(generated_data)
-        else:
-            self.__gen_on_machine = True
-            self.__generated_data = numpy.zeros(0, dtype=uint32)
+        self.__gen_on_machine = True
+
+        # The connector parameters can differ for each slice, as a list of
+        # connections is sent only in part to each core
+        self.__generated_data = dict()
+        for post_slice in self.__app_vertex.splitter.get_in_coming_slices():
+            generated_data: List[NDArray[uint32]] = list()
+            for app_matrix in self.__on_machine_matrices:
+                generated_data.extend(
+                    app_matrix.get_generator_data(post_slice).gen_data)
+            if generated_data:
+                self.__generated_data[post_slice] = numpy.concatenate(
+                    generated_data)
+            else:
+                self.__generated_data[post_slice] = numpy.zeros(
+                    0, dtype=uint32)
 
         self.__on_chip_generated_block_addr = block_addr
 
+        # Note the rows written back after all the blocks, if there is space
+        self.__dirty_rows_offset = None
+        if self.__app_vertex.tracks_dirty_rows:
+            offset = (
+                (block_addr + BYTES_PER_WORD - 1) // BYTES_PER_WORD *
+                BYTES_PER_WORD)
+            if offset + get_dirty_rows_size(offset) <= \
+                    self.__all_syn_block_sz:
+                self.__dirty_rows_offset = offset
+
+        # Count the events of each projection after those, if there is space
+        self.__event_counters_offset = None
+        self.__n_pop_table_items = poptable.n_addresses
+        self.__pop_table_positions = {
+            key: [poptable.get_address_list_position(*item)
+                  for item in matrix.pop_table_items]
+            for key, matrix in self.__matrices.items()}
+        if self.__app_vertex.counts_projection_events:
+            offset = (
+                (block_addr + BYTES_PER_WORD - 1) // BYTES_PER_WORD *
+                BYTES_PER_WORD)
+            if self.__dirty_rows_offset is not None:
+                offset += get_dirty_rows_size(offset)
+            if offset + get_event_counters_size(self.__n_pop_table_items) <= \
+                    self.__all_syn_block_sz:
+                self.__event_counters_offset = offset
+
         # Store the master pop table
-        self.__master_pop_data = poptable.get_pop_table_data()
+        self.__master_pop_data = poptable.get_pop_table_data(
+            self.__app_vertex.direct_pop_table)
 
         # Store bit field data
         self.__bit_field_size = get_sdram_for_bit_field_region(
@@ -337,6 +630,89 @@ class SynapticMatrices(object):
             self.__app_vertex.incoming_projections)
         self.__generated_data_size += (
             len(self.__bit_field_key_map) * BYTES_PER_WORD)
+        return host_blocks
+
+    def __reserve_host_block_seeds(self, reserve_seeds: bool) -> List[
+            Tuple[SynapticMatrixApp, Slice]]:
+        """
+        Reserve the random seeds of the on-host generated blocks of every
+        post-vertex slice in a fixed order, so that the blocks can then be
+        generated in any order.
+
+        :param bool reserve_seeds: Whether to reserve the seeds, or only
+            list the blocks
+        :return: The blocks
+        :rtype:
+            list(tuple(SynapticMatrixApp, ~pacman.model.graphs.common.Slice))
+        """
+        post_slices = self.__app_vertex.splitter.get_in_coming_slices()
+        blocks: List[Tuple[SynapticMatrixApp, Slice]] = list()
+        for post_slice in post_slices:
+            for matrix in self.__on_host_matrices:
+                if reserve_seeds:
+                    matrix.reserve_block_seeds(post_slice)
+                blocks.append((matrix, post_slice))
+        return blocks
+
+    def rewrite_weights(
+            self, app_edge: ProjectionApplicationEdge,
+            synapse_info: SynapseInformation) -> bool:
+        """
+        Arrange for the synaptic blocks of a projection to be written
+        straight to the machine the next time the vertices are loaded, for
+        when only its weights have changed since they were written.
+
+        :param ProjectionApplicationEdge app_edge:
+            The edge of the projection
+        :param SynapseInformation synapse_info:
+            The synapse information of the projection
+        :return: Whether this can be done; if not, the data must be
+            generated again in full
+        :rtype: bool
+        """
+        matrix = self.__matrices.get((app_edge, synapse_info))
+        if (not self.__data_generated or matrix is None or
+                matrix not in self.__on_host_matrices or
+                synapse_info.synapse_dynamics.changes_during_run):
+            return False
+        # The weights must still fit the ring buffers in the same way
+        weight_scales = self.__app_vertex.get_weight_scales(
+            self.__app_vertex.get_ring_buffer_shifts())
+        if not numpy.array_equal(weight_scales, self.__weight_scales):
+            return False
+        self.__blocks_to_rewrite[matrix] = set(
+            self.__app_vertex.splitter.get_in_coming_slices())
+        return True
+
+    def has_blocks_to_rewrite(self, post_vertex_slice: Slice) -> bool:
+        """
+        Whether there are synaptic blocks to write to the machine again for
+        a slice of the post-vertex.
+
+        :param ~pacman.model.graphs.common.Slice post_vertex_slice:
+            The slice of the post-vertex
+        :rtype: bool
+        """
+        return any(post_vertex_slice in slices
+                   for slices in self.__blocks_to_rewrite.values())
+
+    def rewrite_blocks(self, placement: Placement, post_vertex_slice: Slice):
+        """
+        Write the synaptic blocks that are to be written again for a slice
+        of the post-vertex straight to the machine.
+
+        :param ~pacman.model.placements.Placement placement:
+            Where the synapses of the slice are
+        :param ~pacman.model.graphs.common.Slice post_vertex_slice:
+            The slice of the post-vertex
+        """
+        for matrix, slices in list(self.__blocks_to_rewrite.items()):
+            if post_vertex_slice not in slices:
+                continue
+            matrix.write_matrix_to_machine(post_vertex_slice, placement)
+            slices.remove(post_vertex_slice)
+            if not slices:
+                del self.__blocks_to_rewrite[matrix]
 
     def __write_pop_table(self, spec: DataSpecificationBase,
                           poptable_ref: Optional[int] = None):
@@ -365,6 +741,12 @@ class SynapticMatrices(object):
         spec.comment(
             "\nWriting Synaptic Matrix and Master Population Table:\n")
 
+        # The core will start noting the rows written back again, so what
+        # has been read from it before can't be used
+        self.__dirty_rows.pop(post_vertex_slice, None)
+        for matrix in self.__matrices.values():
+            matrix.clear_cached_blocks(post_vertex_slice)
+
         # Write the pop table
         self.__write_pop_table(spec, references.pop_table)
 
@@ -391,6 +773,33 @@ class SynapticMatrices(object):
             spec, self.__regions.bitfield_filter, self.__bit_field_size,
             references.bitfield_filter)
 
+        if self.__eager_post:
+            self.__write_post_index(spec, post_vertex_slice)
+
+    def __write_post_index(
+            self, spec: DataSpecificationBase, post_vertex_slice: Slice):
+        """
+        Write the header of the index of the plastic synapses of each
+        neuron; the synapse expander fills in the rest.
+
+        :param ~.DataSpecificationGenerator spec:
+            The specification to write to
+        :param ~pacman.model.graphs.common.Slice post_vertex_slice:
+            The slice of the post-vertex the index is for
+        """
+        assert self.__regions.post_index is not None
+        n_neurons = post_vertex_slice.n_atoms
+        spec.reserve_memory_region(
+            region=self.__regions.post_index,
+            size=get_post_index_size(n_neurons, self.__all_syn_block_sz),
+            label="PostIndex")
+        spec.switch_write_focus(self.__regions.post_index)
+        spec.write_value(n_neurons)
+        spec.write_value(get_n_bits(self.__max_atoms_per_core))
+        spec.write_value(get_n_bits(self.__n_synapse_types))
+        spec.write_value(get_post_max_entries(self.__all_syn_block_sz))
+        spec.write_array(numpy.zeros(n_neurons + 1, dtype=uint32))
+
     def __write_synapse_expander_data_spec(
             self, spec: DataSpecificationBase, post_vertex_slice: Slice,
             connection_builder_ref: Optional[int] = None):
@@ -416,7 +825,8 @@ class SynapticMatrices(object):
 
         spec.reserve_memory_region(
             region=self.__regions.connection_builder,
-            size=self.__generated_data_size, label="ConnectorBuilderRegion",
+            size=self.get_generated_data_size(post_vertex_slice),
+            label="ConnectorBuilderRegion",
             reference=connection_builder_ref)
         spec.switch_write_focus(self.__regions.connection_builder)
         spec.write_value(self.__regions.synaptic_matrix)
@@ -427,6 +837,10 @@ class SynapticMatrices(object):
             spec.write_value(self.__regions.structural_dynamics)
         else:
             spec.write_value(INVALID_REGION_ID)
+        if self.__eager_post:
+            spec.write_value(self.__regions.post_index)
+        else:
+            spec.write_value(INVALID_REGION_ID)
         spec.write_value(len(self.__on_machine_matrices))
         spec.write_value(post_vertex_slice.lo_atom)
         spec.write_value(post_vertex_slice.n_atoms)
@@ -434,6 +848,8 @@ class SynapticMatrices(object):
         spec.write_value(self.__n_synapse_types)
         spec.write_value(DataType.S1615.encode_as_int(
             SpynnakerDataView.get_simulation_time_step_per_ms()))
+        # Padding, to keep the weight scales on a double word boundary
+        spec.write_value(0)
         # Per-Population RNG
         spec.write_array(self.__app_vertex.pop_seed)
         # Per-Core RNG
@@ -446,7 +862,7 @@ class SynapticMatrices(object):
             dtype = DataType.U3232
             spec.write_value(data=min(w, dtype.max), data_type=dtype)
 
-        spec.write_array(self.__generated_data)
+        spec.write_array(self.__generated_data[post_vertex_slice])
         spec.write_array(self.__bit_field_key_map)
 
     def __get_app_key_and_mask(
@@ -540,10 +956,75 @@ class SynapticMatrices(object):
         :rtype: list(~numpy.ndarray)
         """
         if is_sdram_poisson_source(app_edge):
-            return cast(SpikeSourcePoissonVertex, app_edge.pre_vertex)\
-                .read_connections(synapse_info)
+            return cast(Union[SpikeSourcePoissonVertex,
+                              SpikeSourceArrayVertex],
+                        app_edge.pre_vertex).read_connections(synapse_info)
         matrix = self.__matrices[app_edge, synapse_info]
-        return matrix.get_connections(placement)
+        return matrix.get_connections(
+            placement, self.__read_dirty_rows(placement))
+
+    def __read_dirty_rows(
+            self, placement: Placement) -> Optional[NDArray[numpy.bool_]]:
+        """
+        Read and clear the bit field of the rows written back by a core,
+        adding them to those still to be read by each matrix.
+
+        :param ~pacman.model.placements.Placement placement:
+            Where the vertex is on the machine
+        :return: The words of the synaptic matrix region that start rows
+            written back since each matrix last read them, or None if these
+            are not noted
+        :rtype: ~numpy.ndarray or None
+        """
+        if self.__dirty_rows_offset is None:
+            return None
+        address = locate_memory_region_for_placement(
+            placement, self.__regions.synaptic_matrix)
+        address += self.__dirty_rows_offset
+        n_bytes = get_dirty_rows_size(self.__dirty_rows_offset)
+        data = SpynnakerDataView.read_memory(
+            placement.x, placement.y, address, n_bytes)
+        SpynnakerDataView.get_transceiver().write_memory(
+            placement.x, placement.y, address, bytes(n_bytes))
+        dirty = numpy.unpackbits(
+            numpy.frombuffer(data, dtype=numpy.uint8),
+            bitorder="little").astype(numpy.bool_)
+        vertex_slice = placement.vertex.vertex_slice
+        if vertex_slice in self.__dirty_rows:
+            self.__dirty_rows[vertex_slice] |= dirty
+        else:
+            self.__dirty_rows[vertex_slice] = dirty
+        return self.__dirty_rows[vertex_slice]
+
+    def read_event_counters(self, placement: Placement) -> Dict[
+            Tuple[ProjectionApplicationEdge, SynapseInformation],
+            NDArray[uint32]]:
+        """
+        Read the events counted by a core for each projection, adding
+        together those of the undelayed and delayed matrices.
+
+        :param ~pacman.model.placements.Placement placement:
+            Where the vertex is on the machine
+        :return: The counts, in the order of :py:const:`EVENT_COUNTER_NAMES`,
+            by application edge and synapse information; empty if the events
+            are not counted
+        :rtype: dict(tuple(ProjectionApplicationEdge, SynapseInformation),
+            ~numpy.ndarray)
+        """
+        if self.__event_counters_offset is None:
+            return {}
+        address = locate_memory_region_for_placement(
+            placement, self.__regions.synaptic_matrix)
+        address += self.__event_counters_offset
+        data = SpynnakerDataView.read_memory(
+            placement.x, placement.y, address,
+            get_event_counters_size(self.__n_pop_table_items))
+        counters = numpy.frombuffer(data, dtype=uint32).reshape(
+            -1, len(EVENT_COUNTER_NAMES))
+        return {
+            key: counters[positions].sum(axis=0, dtype=uint32)
+            for key, positions in self.__pop_table_positions.items()
+            if positions}
 
     def read_generated_connection_holders(self, placement: Placement):
         """
@@ -12,7 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 from __future__ import annotations
-from typing import List, Optional, Tuple, TYPE_CHECKING
+from typing import Dict, List, Optional, Tuple, TYPE_CHECKING
 
 import numpy
 from numpy import floating, uint32
@@ -87,7 +87,12 @@ class SynapticMatrixApp(object):
         # The download index for the undelayed synaptic matrix
         "__download_index",
         # The download index for the delayed synaptic matrix
-        "__download_delay_index")
+        "__download_delay_index",
+        # Connections and row data generated ahead of being appended
+        "__generated_row_data",
+        # The matrices last read from the machine, by post-vertex slice and
+        # whether delayed, for when only the rows written back are read again
+        "__cached_blocks")
 
     def __init__(
             self, synapse_info: SynapseInformation,
@@ -145,6 +150,11 @@ class SynapticMatrixApp(object):
         self.__download_index: Optional[int] = None
         self.__download_delay_index: Optional[int] = None
 
+        self.__generated_row_data: Dict[
+            Slice, Tuple[NDArray, NDArray, NDArray]] = dict()
+        self.__cached_blocks: Dict[
+            Tuple[Slice, bool], NDArray[uint32]] = dict()
+
     @property
     def gen_size(self) -> int:
         """
@@ -158,6 +168,27 @@ class SynapticMatrixApp(object):
         return (max_row_length * self.__app_edge.pre_vertex.n_atoms *
                 (self.__app_edge.n_delay_stages + 1))
 
+    @property
+    def pop_table_items(self) -> List[Tuple[int, int]]:
+        """
+        The key and the index within the items of that key of each master
+        population table item that points at a matrix of this projection,
+        once the matrices have been reserved.
+
+        :rtype: list(tuple(int, int))
+        """
+        items: List[Tuple[int, int]] = list()
+        if (self.__syn_mat_offset is not None and
+                self.__app_key_info is not None and
+                self.__index is not None):
+            items.append((self.__app_key_info.app_key, self.__index))
+        if (self.__delay_syn_mat_offset is not None and
+                self.__delay_app_key_info is not None and
+                self.__delay_index is not None):
+            items.append(
+                (self.__delay_app_key_info.app_key, self.__delay_index))
+        return items
+
     def reserve_matrices(
             self, block_addr: int,
             pop_table: MasterPopTableAsBinarySearch) -> int:
@@ -269,6 +300,30 @@ class SynapticMatrixApp(object):
                 f"{next_addr} of {self.__all_syn_block_sz} ")
         return next_addr
 
+    def reserve_block_seeds(self, post_vertex_slice: Slice):
+        """
+        Draw the seeds of any random values of the block for a slice, so
+        that blocks can then be generated in any order.
+
+        :param ~pacman.model.graphs.common.Slice post_vertex_slice:
+            The slice of the post-vertex the matrix is for
+        """
+        self.__synapse_info.connector.reserve_block_seeds(
+            self.__app_edge.post_vertex.splitter.get_in_coming_slices(),
+            post_vertex_slice, self.__synapse_info)
+
+    def generate_row_data(self, post_vertex_slice: Slice):
+        """
+        Generate the row data for a slice ahead of it being appended.
+        This changes nothing shared with other slices or matrices, so can be
+        done for several at once in different threads.
+
+        :param ~pacman.model.graphs.common.Slice post_vertex_slice:
+            The slice of the post-vertex the matrix is for
+        """
+        self.__generated_row_data[post_vertex_slice] = \
+            self.__make_row_data(post_vertex_slice)
+
     def append_matrix(
             self, post_vertex_slice: Slice,
             data_to_write: List[NDArray[uint32]],
@@ -298,6 +353,37 @@ class SynapticMatrixApp(object):
             block_addr += self.__delay_matrix_size
         return block_addr
 
+    def write_matrix_to_machine(
+            self, post_vertex_slice: Slice, placement: Placement):
+        """
+        Write the synaptic matrix for a slice straight to where it was
+        written on the machine before, for when only the weights have
+        changed.
+
+        :param ~pacman.model.graphs.common.Slice post_vertex_slice:
+            The slice of the post-vertex the matrix is for
+        :param ~pacman.model.placements.Placement placement:
+            Where the matrix is on the machine
+        """
+        row_data, delayed_row_data = self.__get_row_data(post_vertex_slice)
+        self.clear_cached_blocks(post_vertex_slice)
+        base_address = locate_memory_region_for_placement(
+            placement, self.__synaptic_matrix_region)
+        txrx = SpynnakerDataView.get_transceiver()
+        for offset, size, data in (
+                (self.__syn_mat_offset, self.__matrix_size, row_data),
+                (self.__delay_syn_mat_offset, self.__delay_matrix_size,
+                 delayed_row_data)):
+            if offset is None or data is None or not len(data):
+                continue
+            if data.nbytes > size:
+                raise ValueError(
+                    f"The synapses of {self.__app_edge.label} no longer fit "
+                    f"the space of {size} bytes reserved for them")
+            txrx.write_memory(
+                placement.x, placement.y, base_address + offset,
+                data.tobytes())
+
     def __get_padding(
             self, data_to_write: List[NDArray[uint32]],
             expected_offset: int, block_addr: int):
@@ -314,11 +400,34 @@ class SynapticMatrixApp(object):
     def __get_row_data(
             self, post_vertex_slice: Slice) -> Tuple[NDArray, NDArray]:
         """
-        Generate the row data for a synaptic matrix from the description.
+        Get the row data for a synaptic matrix, generating it if it has not
+        been generated already.
 
         :return: The data and the delayed data
         :rtype: tuple(~numpy.ndarray or None, ~numpy.ndarray or None)
         """
+        generated = self.__generated_row_data.pop(post_vertex_slice, None)
+        if generated is None:
+            generated = self.__make_row_data(post_vertex_slice)
+        connections, row_data, delayed_row_data = generated
+
+        # Set connections for structural plasticity
+        if isinstance(self.__synapse_info.synapse_dynamics,
+                      AbstractSynapseDynamicsStructural):
+            self.__synapse_info.synapse_dynamics.set_connections(
+                connections, post_vertex_slice, self.__app_edge,
+                self.__synapse_info)
+
+        return row_data, delayed_row_data
+
+    def __make_row_data(self, post_vertex_slice: Slice) -> Tuple[
+            NDArray, NDArray, NDArray]:
+        """
+        Generate the row data for a synaptic matrix from the description.
+
+        :return: The connections, the data and the delayed data
+        :rtype: tuple(~numpy.ndarray, ~numpy.ndarray, ~numpy.ndarray)
+        """
         # Get the actual connections
         post_slices =\
             self.__app_edge.post_vertex.splitter.get_in_coming_slices()
@@ -337,18 +446,12 @@ class SynapticMatrixApp(object):
             self.__max_row_info, self.__app_key_info is not None,
             self.__delay_app_key_info is not None, self.__max_atoms_per_core)
 
-        # Set connections for structural plasticity
-        if isinstance(self.__synapse_info.synapse_dynamics,
-                      AbstractSynapseDynamicsStructural):
-            self.__synapse_info.synapse_dynamics.set_connections(
-                connections, post_vertex_slice, self.__app_edge,
-                self.__synapse_info)
         if self.__app_edge.delay_edge is None and len(delayed_row_data) != 0:
             raise ValueError(
                 "Found delayed source IDs but no delay "
                 f"edge for {self.__app_edge.label}")
 
-        return row_data, delayed_row_data
+        return connections, row_data, delayed_row_data
 
     def __update_connection_holders(
             self, data: NDArray[uint32], delayed_data: NDArray[uint32],
@@ -371,10 +474,12 @@ class SynapticMatrixApp(object):
                 post_vertex_max_delay_ticks,
                 self.__max_row_info, self.__max_atoms_per_core))
 
-    def get_generator_data(self) -> GeneratorData:
+    def get_generator_data(self, post_vertex_slice: Slice) -> GeneratorData:
         """
         Prepare to write a matrix using an on-chip generator.
 
+        :param ~pacman.model.graphs.common.Slice post_vertex_slice:
+            The slice of the post-vertex the matrix is for
         :return: The data to generate with
         :rtype: GeneratorData
         """
@@ -384,7 +489,8 @@ class SynapticMatrixApp(object):
         return GeneratorData(
             self.__syn_mat_offset, self.__delay_syn_mat_offset,
             self.__app_edge, self.__synapse_info, self.__max_row_info,
-            max_pre_atoms_per_core, self.__max_atoms_per_core)
+            max_pre_atoms_per_core, self.__max_atoms_per_core,
+            post_vertex_slice)
 
     def read_generated_connection_holders(self, placement: Placement):
         """
@@ -400,12 +506,20 @@ class SynapticMatrixApp(object):
                 for holder in self.__synapse_info.pre_run_connection_holders:
                     holder.add_connections(conns)
 
-    def get_connections(self, placement: Placement) -> List[NDArray]:
+    def get_connections(
+            self, placement: Placement,
+            dirty_rows: Optional[NDArray[numpy.bool_]] = None
+            ) -> List[NDArray]:
         """
         Read connections from an address on the machine.
 
         :param ~pacman.model.placements.Placement placement:
             Where the matrix is on the machine
+        :param dirty_rows:
+            The words of the synaptic matrix region that start rows written
+            back since this matrix last read them, which are cleared here for
+            the rows read, or None to read all the rows
+        :type dirty_rows: ~numpy.ndarray or None
         :return: A list of arrays of connections, each with dtype
             :py:const:`~.NUMPY_CONNECTORS_DTYPE`
         :rtype: list(~numpy.ndarray)
@@ -430,7 +544,11 @@ class SynapticMatrixApp(object):
                     placement, self.__download_index)
             else:
                 assert synapses_address is not None
-                block = self.__get_block(placement, synapses_address)
+                block = self.__read_rows(
+                    placement, synapses_address, self.__syn_mat_offset,
+                    self.__matrix_size,
+                    self.__max_row_info.undelayed_max_bytes, False,
+                    dirty_rows)
             connections.append(convert_to_connections(
                 self.__synapse_info, vertex_slice,
                 self.__app_edge.pre_vertex.n_atoms,
@@ -444,7 +562,10 @@ class SynapticMatrixApp(object):
                     placement, self.__download_delay_index)
             else:
                 assert synapses_address is not None
-                block = self.__get_delayed_block(placement, synapses_address)
+                block = self.__read_rows(
+                    placement, synapses_address, self.__delay_syn_mat_offset,
+                    self.__delay_matrix_size,
+                    self.__max_row_info.delayed_max_bytes, True, dirty_rows)
             connections.append(convert_to_connections(
                 self.__synapse_info, vertex_slice,
                 self.__app_edge.pre_vertex.n_atoms,
@@ -454,38 +575,71 @@ class SynapticMatrixApp(object):
 
         return connections
 
-    def __get_block(
-            self, placement: Placement, synapses_address: int) -> bytes:
-        """
-        Get a block of data for undelayed synapses.
-
-        :param Placement placement: Where the matrix is on the machine
-        :param int synapses_address:
-            The base address of the synaptic matrix region
-        :return: The raw data from the synaptic matrix
-        :rtype: bytes
-        """
-        assert self.__syn_mat_offset is not None
-        address = self.__syn_mat_offset + synapses_address
-        return SpynnakerDataView.read_memory(
-            placement.x, placement.y, address, self.__matrix_size)
-
-    def __get_delayed_block(
-            self, placement: Placement, synapses_address: int) -> bytes:
+    def __read_rows(
+            self, placement: Placement, synapses_address: int, offset: int,
+            size: int, row_bytes: int, delayed: bool,
+            dirty_rows: Optional[NDArray[numpy.bool_]]
+            ) -> NDArray[uint32]:
         """
-        Get a block of data for delayed synapses.
+        Read a synaptic matrix from the machine.  If the rows written back
+        are given and the matrix has been read before, only those rows are
+        read, and the rest are taken from the last read.
 
         :param ~pacman.model.placements.Placement placement:
             Where the matrix is on the machine
         :param int synapses_address:
             The base address of the synaptic matrix region
-        :return: The raw data from the delayed synaptic matrix
-        :rtype: bytes
+        :param int offset: The offset of the matrix in the region
+        :param int size: The size of the matrix in bytes
+        :param int row_bytes: The size of each row in bytes
+        :param bool delayed: Whether this is the delayed matrix
+        :param dirty_rows:
+            The words of the region that start rows written back, or None
+        :type dirty_rows: ~numpy.ndarray or None
+        :return: The raw data of the matrix
+        :rtype: ~numpy.ndarray
+        """
+        key = (placement.vertex.vertex_slice, delayed)
+        block = self.__cached_blocks.get(key)
+        first_word = offset // BYTES_PER_WORD
+        last_word = first_word + (size // BYTES_PER_WORD)
+        if dirty_rows is None or block is None or row_bytes == 0:
+            block = numpy.frombuffer(SpynnakerDataView.read_memory(
+                placement.x, placement.y, synapses_address + offset, size),
+                dtype=uint32).copy()
+        else:
+            # Read each run of consecutive rows in one go
+            row_words = row_bytes // BYTES_PER_WORD
+            rows = numpy.flatnonzero(
+                dirty_rows[first_word:last_word:row_words])
+            runs = numpy.split(
+                rows, numpy.flatnonzero(numpy.diff(rows) != 1) + 1)
+            for run in runs:
+                if not len(run):
+                    continue
+                start = int(run[0])
+                n_rows = len(run)
+                data = SpynnakerDataView.read_memory(
+                    placement.x, placement.y,
+                    synapses_address + offset + (start * row_bytes),
+                    n_rows * row_bytes)
+                block[start * row_words:(start + n_rows) * row_words] = \
+                    numpy.frombuffer(data, dtype=uint32)
+        if dirty_rows is not None:
+            dirty_rows[first_word:last_word] = False
+            self.__cached_blocks[key] = block
+        return block
+
+    def clear_cached_blocks(self, post_vertex_slice: Slice):
+        """
+        Forget the matrices last read from the machine for a slice, because
+        they have been written again.
+
+        :param ~pacman.model.graphs.common.Slice post_vertex_slice:
+            The slice of the post-vertex
         """
-        assert self.__delay_syn_mat_offset is not None
-        address = self.__delay_syn_mat_offset + synapses_address
-        return SpynnakerDataView.read_memory(
-            placement.x, placement.y, address, self.__delay_matrix_size)
+        self.__cached_blocks.pop((post_vertex_slice, False), None)
+        self.__cached_blocks.pop((post_vertex_slice, True), None)
 
     def get_index(self) -> int:
         """
@@ -35,6 +35,7 @@ from spinn_utilities.log import FormatAdapter
 from spinn_utilities.logger_utils import warn_once
 from spinn_utilities.overrides import overrides
 
+from spinn_front_end_common.interface.ds import DataType
 from spinn_front_end_common.utilities.exceptions import ConfigurationException
 
 from spynnaker.pyNN.data import SpynnakerDataView
@@ -204,9 +205,11 @@ class Population(PopulationBase):
         """
         return variable in self.__vertex.get_recordable_variables()
 
-    @overrides(PopulationBase.record, extend_doc=False)
+    @overrides(PopulationBase.record, extend_doc=False,
+               additional_arguments={"aggregation"})
     def record(self, variables: Names, to_file: Optional[str] = None,
-               sampling_interval: Optional[int] = None):
+               sampling_interval: Optional[int] = None,
+               aggregation: Optional[str] = None):
         """
         Record the specified variable or variables for all cells in the
         Population or view.
@@ -221,9 +224,19 @@ class Population(PopulationBase):
         :type to_file: ~neo.io or ~neo.rawio or str
         :param int sampling_interval: a value in milliseconds, and an integer
             multiple of the simulation timestep.
+        :param aggregation:
+            sPyNNaker specific; how to aggregate the variables on the machine,
+            as in :py:meth:`set_recording_aggregation`, or `None` to record
+            each value
+        :type aggregation: str or None
         """
         self.__recorder.record(
             variables, to_file, sampling_interval, indexes=None)
+        if aggregation is not None:
+            if isinstance(variables, str):
+                variables = [variables]
+            for variable in variables:
+                self.set_recording_aggregation(variable, aggregation)
 
     def sample(self, n: int, rng: Optional[NumpyRNG] = None) -> PopulationView:
         """
@@ -379,7 +392,8 @@ class Population(PopulationBase):
 
     def spinnaker_get_data(
             self, variable: str, as_matrix: bool = False,
-            view_indexes: Optional[Sequence[int]] = None) -> NDArray[floating]:
+            view_indexes: Optional[Sequence[int]] = None,
+            mmap_file: Optional[str] = None) -> NDArray[floating]:
         """
         SsPyNNaker specific method for getting data as a numpy array,
         instead of the Neo-based object
@@ -389,6 +403,9 @@ class Population(PopulationBase):
         :param bool as_matrix: If set True the data is returned as a 2d matrix
         :param view_indexes: The indexes for which data should be returned.
             If ``None``, all data (view_index = data_indexes)
+        :param mmap_file: If given, the data is written to this ``.npy``
+            file and returned as a read-only memory map of it
+        :type mmap_file: str or None
         :return: array of the data
         :rtype: ~numpy.ndarray
         """
@@ -396,8 +413,9 @@ class Population(PopulationBase):
             logger, "spinnaker_get_data is non-standard PyNN and therefore "
             "will not be portable to other simulators.")
         with NeoBufferDatabase() as db:
-            return db.spinnaker_get_data(self.__recorder.recording_label,
-                                         variable, as_matrix, view_indexes)
+            return db.spinnaker_get_data(
+                self.__recorder.recording_label, variable, as_matrix,
+                view_indexes, mmap_file)
 
     @overrides(PopulationBase.get_spike_counts, extend_doc=False)
     def get_spike_counts(self, gather: bool = True) -> Dict[int, int]:
@@ -782,6 +800,56 @@ class Population(PopulationBase):
         # state that something has changed in the population
         SpynnakerDataView.set_requires_mapping()
 
+    # NON-PYNN API CALL
+    def set_recorded_data_type(self, variable: str, data_type: DataType):
+        """
+        Record a variable with a smaller data type than the one the model
+        computes it in, to fit more recording into the same space.
+
+        For example, `v` can be recorded as `DataType.S87` rather than
+        `DataType.S1615`, which halves its recording space at a resolution
+        of 1/128 mV and a range of +/-256 mV.
+
+        :param str variable: The name of the variable
+        :param ~data_specification.enums.DataType data_type:
+            The data type to record the variable with
+        :raises SimulatorRunningException: If `sim.run` is currently running
+        :raises SimulatorNotSetupException: If called before `sim.setup`
+        :raises SimulatorShutdownException: If called after `sim.end`
+        """
+        SpynnakerDataView.check_user_can_act()
+        self.__vertex.set_recorded_data_type(variable, data_type)
+        # state that something has changed in the population
+        SpynnakerDataView.set_requires_mapping()
+
+    # NON-PYNN API CALL
+    def set_recording_aggregation(
+            self, variable: str, aggregation: Optional[str]):
+        """
+        Aggregate a recorded variable on the machine, so that far less has
+        to be recorded and extracted.
+
+        `"count"` records how many times each neuron spiked in each sampling
+        interval rather than when, so `get_spike_counts` and the data as a
+        matrix give rates binned by the sampling interval.  `"mean"` records
+        only the mean and variance of a variable over the population at each
+        sample, which is given by `get_data` as a signal with a channel for
+        each; it can't be given for a view of the population.
+
+        :param str variable: The name of the variable
+        :param aggregation: `"count"`, `"mean"` or `None` to record each value
+        :type aggregation: str or None
+        :raises ConfigurationException:
+            If the variable can't be aggregated that way
+        :raises SimulatorRunningException: If `sim.run` is currently running
+        :raises SimulatorNotSetupException: If called before `sim.setup`
+        :raises SimulatorShutdownException: If called after `sim.end`
+        """
+        SpynnakerDataView.check_user_can_act()
+        self.__vertex.set_recording_aggregation(variable, aggregation)
+        # state that something has changed in the population
+        SpynnakerDataView.set_requires_mapping()
+
     @property
     def size(self) -> int:
         """
@@ -20,6 +20,7 @@ from typing import (
 
 import numpy
 from numpy import void
+from numpy.lib.recfunctions import structured_to_unstructured
 from numpy.typing import NDArray
 from typing_extensions import Literal, TypeAlias
 
@@ -40,13 +41,15 @@ from spynnaker.pyNN.models.abstract_models import (
 from spynnaker.pyNN.models.neural_projections import (
     SynapseInformation, ProjectionApplicationEdge)
 from spynnaker.pyNN.models.neural_projections.connectors import (
-    FromListConnector)
+    FromListConnector, KernelConnector)
 from spynnaker.pyNN.models.neuron import (
     AbstractPopulationVertex, ConnectionHolder)
 from spynnaker.pyNN.models.populations import Population, PopulationView
+from spynnaker.pyNN.models.neuron.local_only import LocalOnlyConvolution
 from spynnaker.pyNN.models.neuron.synapse_dynamics import (
     SynapseDynamicsStatic, AbstractHasParameterNames)
-from spynnaker.pyNN.models.spike_source import SpikeSourcePoissonVertex
+from spynnaker.pyNN.models.spike_source import (
+    SpikeSourceArrayVertex, SpikeSourcePoissonVertex)
 from spynnaker._version import __version__
 
 if TYPE_CHECKING:
@@ -58,6 +61,9 @@ if TYPE_CHECKING:
 
 logger = FormatAdapter(logging.getLogger(__name__))
 
+# The number of connections to write to a file at a time when saving a list
+_SAVE_CHUNK_SIZE = 1000000
+
 
 def _we_dont_do_this_now(*args):  # pylint: disable=unused-argument
     # pragma: no cover
@@ -129,6 +135,20 @@ class Projection(object):
         else:
             synapse_dynamics = synapse_type
 
+        # A static kernel connector between whole 2D populations can instead
+        # share its kernel on the local-only convolution path
+        if (isinstance(connector, KernelConnector) and
+                isinstance(synapse_dynamics, SynapseDynamicsStatic) and
+                not pre_is_view and not post_is_view and get_config_bool(
+                    "Simulation", "kernel_connectors_as_convolutions")):
+            convolution = connector.as_convolution_connector(
+                pre_synaptic_population._vertex.atoms_shape,
+                post_synaptic_population._vertex.atoms_shape,
+                synapse_dynamics.weight, synapse_dynamics.delay)
+            if convolution is not None:
+                connector, delay = convolution
+                synapse_dynamics = LocalOnlyConvolution(delay)
+
         # set the space function as required
         if space is None:
             space = PyNNSpace()
@@ -213,8 +233,10 @@ class Projection(object):
         if isinstance(post_vertex, AbstractPopulationVertex):
             post_vertex.add_incoming_projection(self)
 
-        # If the source is a poisson, add to the list of outgoing projections
-        if isinstance(pre_vertex, SpikeSourcePoissonVertex):
+        # If the source is a poisson or spike source array, add to the list of
+        # outgoing projections
+        if isinstance(pre_vertex, (
+                SpikeSourcePoissonVertex, SpikeSourceArrayVertex)):
             pre_vertex.add_outgoing_projection(self)
 
     @staticmethod
@@ -375,11 +397,16 @@ class Projection(object):
         :param data:
         :type data: ConnectionHolder or numpy.ndarray
         """
-        # Convert structured array to normal numpy array
-        if hasattr(data, "dtype") and hasattr(data.dtype, "names"):
-            dtype = [(name, "<f8") for name in data.dtype.names]
-            data = data.astype(dtype)
-        npdata = numpy.nan_to_num(cast(NDArray, data))
+        # A list is written a chunk at a time, so that the whole list is
+        # never made
+        chunks: Any
+        if isinstance(data, ConnectionHolder) and data.is_list:
+            chunks = (
+                numpy.nan_to_num(Projection.__to_float_array(chunk))
+                for chunk in data.iter_list_chunks(_SAVE_CHUNK_SIZE))
+        else:
+            chunks = [numpy.nan_to_num(
+                Projection.__to_float_array(cast(NDArray, data)))]
         if isinstance(save_file, str):
             data_file = open(save_file, mode='wb')
         else:
@@ -390,11 +417,25 @@ class Projection(object):
             header = "\n".join(header_lines) + '\n'
             data_file.write(header.encode('utf-8'))
             # write data
-            numpy.savetxt(data_file, npdata, delimiter='\t')
+            for npdata in chunks:
+                numpy.savetxt(data_file, npdata, delimiter='\t')
             data_file.close()
         finally:
             data_file.close()
 
+    @staticmethod
+    def __to_float_array(data: NDArray) -> NDArray:
+        """
+        Convert a structured array to a normal numpy array of floats.
+
+        :param ~numpy.ndarray data:
+        :rtype: ~numpy.ndarray
+        """
+        if hasattr(data, "dtype") and getattr(data.dtype, "names", None):
+            dtype = [(name, "<f8") for name in data.dtype.names]
+            return structured_to_unstructured(data.astype(dtype))
+        return data
+
     @property
     def pre(self) -> _Pop:
         """
@@ -499,7 +540,9 @@ class Projection(object):
         # possible later date
         connection_holder = ConnectionHolder(
             data_to_get, as_list, pre_vertex.n_atoms, post_vertex.n_atoms,
-            fixed_values=fixed_values, notify=notify)
+            fixed_values=fixed_values, notify=notify,
+            memory_mapped=bool(get_config_bool(
+                "Simulation", "memory_map_connections")))
 
         # If we haven't run, add the holder to get connections, and return it
         # and set up a callback for after run to fill in this connection holder
@@ -524,13 +567,33 @@ class Projection(object):
 
     # -----------------------------------------------------------------
 
-    def set(self, **attributes):  # @UnusedVariable
-        # pylint: disable=unused-argument
+    def set(self, **attributes):
         """
+        Set the weights of the connections.
+
+        After a run, if the synapses were made on the host and do not change
+        during a run, and the new weights need no change to the scaling of
+        the ring buffers, only the synapses of this projection are written
+        to the machine again at the next run; otherwise the network is
+        mapped again.
+
         .. warning::
-            Not implemented.
+            Only ``weight`` can be set.
+
+        :param weight: The new weights
+        :type weight: float or list(float) or ~numpy.ndarray(float) or
+            ~pyNN.random.RandomDistribution
         """
-        _we_dont_do_this_now()
+        if set(attributes) != {"weight"}:
+            _we_dont_do_this_now()
+        self.__synapse_information.set_weights(attributes["weight"])
+        if not SpynnakerDataView.is_ran_ever():
+            return
+        post_vertex = self.__projection_edge.post_vertex
+        if (not isinstance(post_vertex, AbstractPopulationVertex) or
+                not post_vertex.rewrite_projection_weights(
+                    self.__projection_edge, self.__synapse_information)):
+            SpynnakerDataView.set_requires_mapping()
 
     def size(self, gather=True):  # @UnusedVariable
         # pylint: disable=unused-argument
@@ -25,7 +25,8 @@ class SpikeSourceArray(AbstractPyNNModel):
     Model that creates a Spike Source Array Vertex
     """
     default_population_parameters = {
-        "splitter": None, "n_colour_bits": None}
+        "splitter": None, "n_colour_bits": None, "pattern_period": None,
+        "pattern_jitter": 0.0, "seed": None}
 
     def __init__(self, spike_times: Optional[Spikes] = None):
         if spike_times is None:
@@ -37,18 +38,30 @@ class SpikeSourceArray(AbstractPyNNModel):
     def create_vertex(
             self, n_neurons: int, label: str, *,
             splitter: Optional[AbstractSplitterCommon] = None,
-            n_colour_bits: Optional[int] = None) -> SpikeSourceArrayVertex:
+            n_colour_bits: Optional[int] = None,
+            pattern_period: Optional[float] = None,
+            pattern_jitter: float = 0.0,
+            seed: Optional[int] = None) -> SpikeSourceArrayVertex:
         """
         :param splitter:
         :type splitter:
             ~pacman.model.partitioner_splitters.AbstractSplitterCommon or None
         :param int n_colour_bits:
+        :param pattern_period:
+            If given, the spike times are a pattern that the machine plays
+            again every this many ms
+        :type pattern_period: float or None
+        :param float pattern_jitter:
+            The most ms that each repetition of the pattern can randomly
+            start late by
+        :param seed: The seed of the random start of each repetition
+        :type seed: int or None
         """
         # pylint: disable=arguments-differ
         max_atoms = self.get_model_max_atoms_per_dimension_per_core()
         return SpikeSourceArrayVertex(
             n_neurons, self.__spike_times, label, max_atoms, self, splitter,
-            n_colour_bits)
+            n_colour_bits, pattern_period, pattern_jitter, seed)
 
     @property
     def _spike_times(self) -> Spikes:
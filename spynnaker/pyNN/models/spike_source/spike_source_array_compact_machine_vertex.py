@@ -0,0 +1,501 @@
+# Copyright (c) 2024 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+from __future__ import annotations
+from enum import IntEnum
+import math
+from typing import List, NamedTuple, Optional, Tuple, cast, TYPE_CHECKING
+
+import numpy
+from numpy import uint8, uint16, uint32
+from numpy.typing import NDArray
+
+from spinn_utilities.overrides import overrides
+
+from spinnman.model.enums import ExecutableType
+
+from pacman.model.graphs import AbstractEdgePartition
+from pacman.model.graphs.common import Slice
+from pacman.model.graphs.machine import (
+    MachineVertex, AbstractSDRAMPartition, SDRAMMachineEdge)
+from pacman.model.placements import Placement
+from pacman.model.resources import (
+    AbstractSDRAM, ConstantSDRAM, VariableSDRAM)
+from pacman.utilities.utility_calls import get_keys
+
+from spinn_front_end_common.abstract_models import (
+    AbstractHasAssociatedBinary, AbstractGeneratesDataSpecification)
+from spinn_front_end_common.interface.buffer_management import (
+    recording_utilities)
+from spinn_front_end_common.interface.buffer_management.buffer_models import (
+    AbstractReceiveBuffersToHost)
+from spinn_front_end_common.interface.ds import DataSpecificationGenerator
+from spinn_front_end_common.interface.simulation import simulation_utilities
+from spinn_front_end_common.utilities.constants import (
+    SIMULATION_N_BYTES, SYSTEM_BYTES_REQUIREMENT, BYTES_PER_WORD)
+from spinn_front_end_common.utilities.helpful_functions import (
+    locate_memory_region_for_placement)
+
+from spynnaker.pyNN.data import SpynnakerDataView
+from spynnaker.pyNN.exceptions import SynapticConfigurationException
+from spynnaker.pyNN.models.abstract_models import (
+    SendsSynapticInputsOverSDRAM, ReceivesSynapticInputsOverSDRAM)
+from spynnaker.pyNN.models.neuron.synapse_dynamics.types import (
+    NUMPY_CONNECTORS_DTYPE, ConnectionsArray)
+
+from .spike_source_poisson_machine_vertex import (
+    SDRAM_EDGE_PARAMS_BASE_BYTES, SDRAM_EDGE_PARAMS_BYTES_PER_WEIGHT)
+
+if TYPE_CHECKING:
+    from .spike_source_array_vertex import SpikeSourceArrayVertex
+    from spynnaker.pyNN.models.neural_projections import SynapseInformation
+    from spynnaker.pyNN.models.neural_projections.connectors import (
+        AbstractGenerateConnectorOnHost)
+
+# 1. has_key; 2. n_sources; 3. n_colour_bits; 4. max_spikes_per_source;
+# 5. n_frames; 6. pattern_period; 7. pattern_jitter; 8-11. pattern_seed
+PARAMS_BASE_WORDS = 11
+
+# 1. time; 2. number of spikes and bit field flag
+FRAME_HEADER_WORDS = 2
+
+# The flag in a frame that says the spikes are held as a bit field
+_FRAME_IS_BIT_FIELD = 0x80000000
+
+# A byte of a difference that is not the last byte of it
+_DIFFERENCE_CONTINUES = 255
+
+# The number of time steps of recording to allow for on top of those run for
+_OVERFLOW_TIMESTEPS_FOR_SDRAM = 5
+
+
+class SpikeFrames(NamedTuple):
+    """
+    The spikes of a core of a spike source array, encoded as frames.
+    """
+    #: The encoded frames
+    words: NDArray[uint32]
+    #: The number of frames
+    n_frames: int
+    #: The most times any one source spikes in one time step
+    max_spikes_per_source: int
+
+
+class SpikePattern(NamedTuple):
+    """
+    How the spikes of a spike source array repeat as a pattern.
+    """
+    #: The number of time steps after which the pattern repeats
+    period: int
+    #: The most time steps a repetition of the pattern can start late by
+    jitter: int
+    #: The seed of the random start of each repetition
+    seed: Tuple[int, ...]
+
+
+def encode_spike_frames(
+        ticks: NDArray[numpy.integer], ids: NDArray[numpy.integer],
+        n_atoms: int) -> SpikeFrames:
+    """
+    Encode spikes as a frame for each time step with any, holding either
+    a bit field of the sources that spike, or the differences between the
+    indices of the sources that spike as runs of bytes, whichever is
+    smaller.
+
+    :param ~numpy.ndarray ticks: The time step of each spike
+    :param ~numpy.ndarray ids: The index on the core of the source of each
+        spike
+    :param int n_atoms: The number of sources on the core
+    :rtype: SpikeFrames
+    """
+    ticks = numpy.asarray(ticks, dtype=numpy.int64)
+    ids = numpy.asarray(ids, dtype=numpy.int64)
+    keep = ticks >= 0
+    ticks = ticks[keep]
+    ids = ids[keep]
+    if not len(ticks):
+        return SpikeFrames(numpy.zeros(0, dtype=uint32), 0, 0)
+    order = numpy.lexsort((ids, ticks))
+    ticks = ticks[order]
+    ids = ids[order]
+    frame_ticks, starts, counts = numpy.unique(
+        ticks, return_index=True, return_counts=True)
+    n_frames = len(frame_ticks)
+    _, repeats = numpy.unique(ticks * n_atoms + ids, return_counts=True)
+
+    # The difference of each spike from the one before in its frame
+    differences = ids.copy()
+    differences[1:] -= ids[:-1]
+    differences[starts] = ids[starts]
+    n_bytes = differences // _DIFFERENCE_CONTINUES + 1
+    frame_n_bytes = numpy.add.reduceat(n_bytes, starts)
+    list_words = (frame_n_bytes + BYTES_PER_WORD - 1) // BYTES_PER_WORD
+
+    # A bit field can't hold a source spiking more than once
+    repeated = numpy.zeros(len(ids), dtype=bool)
+    repeated[1:] = differences[1:] == 0
+    repeated[starts] = False
+    bit_field_words = int(math.ceil(n_atoms / 32))
+    use_bits = (bit_field_words < list_words) & ~numpy.logical_or.reduceat(
+        repeated, starts)
+
+    frame_words = FRAME_HEADER_WORDS + numpy.where(
+        use_bits, bit_field_words, list_words)
+    offsets = numpy.zeros(n_frames, dtype=numpy.int64)
+    offsets[1:] = numpy.cumsum(frame_words)[:-1]
+    words = numpy.zeros(int(frame_words.sum()), dtype=uint32)
+    words[offsets] = frame_ticks
+    words[offsets + 1] = counts | numpy.where(use_bits, _FRAME_IS_BIT_FIELD, 0)
+    data_offsets = offsets + FRAME_HEADER_WORDS
+    spike_frame = numpy.repeat(numpy.arange(n_frames), counts)
+
+    # Frames of differences; every byte but the last of each is 255
+    byte_frame = numpy.repeat(spike_frame, n_bytes)
+    in_list = ~use_bits[byte_frame]
+    all_bytes = numpy.full(int(n_bytes.sum()), _DIFFERENCE_CONTINUES, uint8)
+    all_bytes[numpy.cumsum(n_bytes) - 1] = (
+        differences % _DIFFERENCE_CONTINUES)
+    frame_first_byte = numpy.zeros(n_frames, dtype=numpy.int64)
+    frame_first_byte[1:] = numpy.cumsum(frame_n_bytes)[:-1]
+    positions = (
+        data_offsets[byte_frame] * BYTES_PER_WORD +
+        numpy.arange(len(all_bytes)) - frame_first_byte[byte_frame])
+    words.view(uint8)[positions[in_list]] = all_bytes[in_list]
+
+    # Frames of bit fields
+    in_bits = use_bits[spike_frame]
+    numpy.bitwise_or.at(
+        words, data_offsets[spike_frame[in_bits]] + ids[in_bits] // 32,
+        (1 << (ids[in_bits] % 32)).astype(uint32))
+
+    return SpikeFrames(words, n_frames, int(repeats.max()))
+
+
+def get_params_bytes(n_atoms: int) -> int:
+    """
+    Get the size of the parameters of a compact spike source array.
+
+    :param int n_atoms: The number of sources on the core
+    :rtype: int
+    """
+    return (PARAMS_BASE_WORDS + n_atoms) * BYTES_PER_WORD
+
+
+def get_sdram_edge_params_bytes(n_atoms: int) -> int:
+    """
+    Get the size of the parameters of sending input over SDRAM, with the
+    weights padded to a whole number of words.
+
+    :param int n_atoms: The number of sources on the core
+    :rtype: int
+    """
+    weight_words = int(math.ceil(
+        n_atoms * SDRAM_EDGE_PARAMS_BYTES_PER_WEIGHT / BYTES_PER_WORD))
+    return SDRAM_EDGE_PARAMS_BASE_BYTES + weight_words * BYTES_PER_WORD
+
+
+def get_recording_sdram(n_atoms: int, frames: SpikeFrames) -> AbstractSDRAM:
+    """
+    Get the SDRAM needed to record the spikes of a compact spike source
+    array.
+
+    :param int n_atoms: The number of sources on the core
+    :param SpikeFrames frames: The spikes to be sent
+    :rtype: ~pacman.model.resources.AbstractSDRAM
+    """
+    per_timestep = (2 + frames.max_spikes_per_source * int(
+        math.ceil(n_atoms / 32))) * BYTES_PER_WORD
+    return (VariableSDRAM(0, per_timestep) +
+            ConstantSDRAM(per_timestep * _OVERFLOW_TIMESTEPS_FOR_SDRAM))
+
+
+def get_sdram(n_atoms: int, frames: SpikeFrames) -> AbstractSDRAM:
+    """
+    Get the SDRAM needed by a core of a compact spike source array.
+
+    :param int n_atoms: The number of sources on the core
+    :param SpikeFrames frames: The spikes to be sent
+    :rtype: ~pacman.model.resources.AbstractSDRAM
+    """
+    return ConstantSDRAM(
+        SYSTEM_BYTES_REQUIREMENT + get_params_bytes(n_atoms) +
+        max(len(frames.words), 1) * BYTES_PER_WORD +
+        recording_utilities.get_recording_header_size(1) +
+        recording_utilities.get_recording_data_constant_size(1) +
+        get_sdram_edge_params_bytes(n_atoms)) + \
+        get_recording_sdram(n_atoms, frames)
+
+
+class SpikeSourceArrayCompactMachineVertex(
+        MachineVertex, AbstractHasAssociatedBinary,
+        AbstractGeneratesDataSpecification, AbstractReceiveBuffersToHost,
+        SendsSynapticInputsOverSDRAM):
+    """
+    A core of a spike source array that holds all its spikes in SDRAM in a
+    compact form, rather than having them sent from the host as it runs.
+
+    As with the Poisson source, if the sources are the only input of a
+    synapse type of a population, the input can be sent over SDRAM instead.
+    """
+
+    __slots__ = (
+        "__frames",
+        "__is_recording",
+        "__pattern",
+        "__sdram",
+        "__sdram_partition",
+        "__send_buffer_times")
+
+    class _Regions(IntEnum):
+        """
+        Memory region IDs for the compact spike source array.
+        """
+        #: System control information (simulation timestep, etc.)
+        SYSTEM_REGION = 0
+        #: The parameters of the sources.
+        PARAMS_REGION = 1
+        #: The spikes to send.
+        SPIKE_FRAMES_REGION = 2
+        #: Record of when spikes were actually sent.
+        SPIKE_HISTORY_REGION = 3
+        #: Parameters for an SDRAM edge.
+        SDRAM_EDGE_PARAMS = 4
+
+    def __init__(
+            self, sdram: AbstractSDRAM, frames: SpikeFrames,
+            label: Optional[str], app_vertex: SpikeSourceArrayVertex,
+            vertex_slice: Slice, pattern: Optional[SpikePattern] = None):
+        """
+        :param ~pacman.model.resources.AbstractSDRAM sdram:
+            The SDRAM used by the vertex
+        :param SpikeFrames frames: The spikes to be sent
+        :param str label: The label of the vertex
+        :param SpikeSourceArrayVertex app_vertex:
+            The application vertex this is part of
+        :param ~pacman.model.graphs.common.Slice vertex_slice:
+            The slice of the application vertex
+        :param pattern:
+            How the spikes repeat, or `None` if they are played once
+        :type pattern: SpikePattern or None
+        """
+        # pylint: disable=too-many-arguments
+        super().__init__(
+            label, app_vertex=app_vertex, vertex_slice=vertex_slice)
+        self.__sdram = sdram
+        self.__frames = frames
+        self.__pattern = pattern
+        self.__is_recording = False
+        self.__send_buffer_times = None
+        self.__sdram_partition: Optional[AbstractSDRAMPartition] = None
+
+    @property
+    def _pop_vertex(self) -> SpikeSourceArrayVertex:
+        return cast('SpikeSourceArrayVertex', self.app_vertex)
+
+    def set_sdram_partition(self, sdram_partition: AbstractSDRAMPartition):
+        """
+        Sets the SDRAM partition
+
+        :param AbstractSDRAMPartition sdram_partition:
+        """
+        self.__sdram_partition = sdram_partition
+
+    @staticmethod
+    def __conn(synapse_info: SynapseInformation
+               ) -> AbstractGenerateConnectorOnHost:
+        return cast(
+            'AbstractGenerateConnectorOnHost', synapse_info.connector)
+
+    @property
+    def __weight_scales(self) -> NDArray[numpy.floating]:
+        return next(iter(cast(AbstractEdgePartition,
+                              self.__sdram_partition).edges)
+                    ).post_vertex.weight_scales
+
+    @property
+    def send_buffer_times(self):
+        """
+        The spike times of the vertex; changing these needs the spikes to
+        be encoded again, which is done by mapping again.
+        """
+        return self.__send_buffer_times
+
+    @send_buffer_times.setter
+    def send_buffer_times(self, send_buffer_times):
+        self.__send_buffer_times = send_buffer_times
+
+    def enable_recording(self, new_state: bool = True):
+        """
+        Enable recording of the spikes sent.
+
+        :param bool new_state: Whether to record
+        """
+        self.__is_recording = new_state
+
+    @property
+    @overrides(MachineVertex.sdram_required)
+    def sdram_required(self) -> AbstractSDRAM:
+        return self.__sdram
+
+    @overrides(SendsSynapticInputsOverSDRAM.sdram_requirement)
+    def sdram_requirement(self, sdram_machine_edge: SDRAMMachineEdge) -> int:
+        if isinstance(sdram_machine_edge.post_vertex,
+                      ReceivesSynapticInputsOverSDRAM):
+            return sdram_machine_edge.post_vertex.n_bytes_for_transfer
+        raise SynapticConfigurationException(
+            f"Unknown post vertex type in edge {sdram_machine_edge}")
+
+    @overrides(MachineVertex.get_n_keys_for_partition)
+    def get_n_keys_for_partition(self, partition_id: str) -> int:
+        return self.vertex_slice.n_atoms << self._pop_vertex.n_colour_bits
+
+    @overrides(AbstractReceiveBuffersToHost.get_recorded_region_ids)
+    def get_recorded_region_ids(self) -> List[int]:
+        if self.__is_recording:
+            return [0]
+        return []
+
+    @overrides(AbstractReceiveBuffersToHost.get_recording_region_base_address)
+    def get_recording_region_base_address(self, placement: Placement) -> int:
+        return locate_memory_region_for_placement(
+            placement, self._Regions.SPIKE_HISTORY_REGION)
+
+    @overrides(AbstractHasAssociatedBinary.get_binary_file_name)
+    def get_binary_file_name(self) -> str:
+        return "spike_source_array.aplx"
+
+    @overrides(AbstractHasAssociatedBinary.get_binary_start_type)
+    def get_binary_start_type(self) -> ExecutableType:
+        return ExecutableType.USES_SIMULATION_INTERFACE
+
+    @overrides(AbstractGeneratesDataSpecification.generate_data_specification)
+    def generate_data_specification(
+            self, spec: DataSpecificationGenerator, placement: Placement):
+        spec.comment("\n*** Spec for compact SpikeSourceArray Instance ***\n")
+        n_atoms = self.vertex_slice.n_atoms
+
+        # write setup data
+        spec.reserve_memory_region(
+            region=self._Regions.SYSTEM_REGION,
+            size=SIMULATION_N_BYTES, label='setup')
+        spec.switch_write_focus(self._Regions.SYSTEM_REGION)
+        spec.write_array(simulation_utilities.get_simulation_header_array(
+            self.get_binary_file_name()))
+
+        # write recording data
+        spec.reserve_memory_region(
+            region=self._Regions.SPIKE_HISTORY_REGION,
+            size=recording_utilities.get_recording_header_size(1),
+            label="Recording")
+        spec.switch_write_focus(self._Regions.SPIKE_HISTORY_REGION)
+        sdram = get_recording_sdram(n_atoms, self.__frames)
+        spec.write_array(recording_utilities.get_recording_header_array(
+            [sdram.get_total_sdram(
+                SpynnakerDataView.get_max_run_time_steps())]))
+
+        # write parameters
+        spec.reserve_memory_region(
+            region=self._Regions.PARAMS_REGION,
+            size=get_params_bytes(n_atoms), label="SpikeArrayParams")
+        spec.switch_write_focus(self._Regions.PARAMS_REGION)
+        routing_info = SpynnakerDataView.get_routing_infos()
+        key = routing_info.get_single_key_from(self)
+        if key is None:
+            spec.write_value(0)
+            keys = numpy.zeros(n_atoms, dtype=uint32)
+        else:
+            spec.write_value(1)
+            keys = get_keys(
+                key, self.vertex_slice, self._pop_vertex.n_colour_bits)
+        spec.write_value(n_atoms)
+        spec.write_value(self._pop_vertex.n_colour_bits)
+        spec.write_value(self.__frames.max_spikes_per_source)
+        spec.write_value(self.__frames.n_frames)
+        if self.__pattern is None:
+            spec.write_array([0, 0, 0, 0, 0, 0])
+        else:
+            spec.write_value(self.__pattern.period)
+            spec.write_value(self.__pattern.jitter)
+            spec.write_array(self.__pattern.seed)
+        spec.write_array(keys)
+
+        # write the spikes
+        spec.reserve_memory_region(
+            region=self._Regions.SPIKE_FRAMES_REGION,
+            size=max(len(self.__frames.words), 1) * BYTES_PER_WORD,
+            label="SpikeFrames")
+        spec.switch_write_focus(self._Regions.SPIKE_FRAMES_REGION)
+        if len(self.__frames.words):
+            spec.write_array(self.__frames.words)
+
+        # write SDRAM edge parameters
+        spec.reserve_memory_region(
+            region=self._Regions.SDRAM_EDGE_PARAMS,
+            label="sdram edge params",
+            size=get_sdram_edge_params_bytes(n_atoms))
+        spec.switch_write_focus(self._Regions.SDRAM_EDGE_PARAMS)
+        if self.__sdram_partition is None:
+            spec.write_array([0, 0, 0])
+        else:
+            proj = self._pop_vertex.outgoing_projections[0]
+            # pylint: disable=protected-access
+            synapse_info = proj._synapse_information
+            spec.write_value(
+                self.__sdram_partition.get_sdram_base_address_for(self))
+            spec.write_value(
+                self.__sdram_partition.get_sdram_size_of_region_for(self))
+            synapse_type = synapse_info.synapse_type
+            spec.write_value(synapse_type * n_atoms)
+
+            # The connector must be one-to-one, so the weight of each source
+            # is that of its only connection
+            connections = self.__conn(synapse_info).create_synaptic_block(
+                (), self.vertex_slice, synapse_type, synapse_info)
+            weights = connections["weight"] * self.__weight_scales[
+                synapse_type]
+            weights = numpy.rint(numpy.abs(weights)).astype(uint16)
+            if len(weights) % 2 != 0:
+                weights = numpy.concatenate(
+                    (weights, numpy.zeros(1, dtype=uint16)))
+            spec.write_array(weights.view(uint32))
+
+        # End-of-Spec:
+        spec.end_specification()
+
+    def read_connections(
+            self, synapse_info: SynapseInformation) -> ConnectionsArray:
+        """
+        Read the connections sent over SDRAM from the machine.
+
+        :param SynapseInformation synapse_info:
+            The synapse information being read
+        :return: The connections read back
+        """
+        size = self.vertex_slice.n_atoms * SDRAM_EDGE_PARAMS_BYTES_PER_WEIGHT
+        placement = SpynnakerDataView.get_placement_of_vertex(self)
+        addr = locate_memory_region_for_placement(
+            placement, self._Regions.SDRAM_EDGE_PARAMS)
+        data = SpynnakerDataView.read_memory(
+            placement.x, placement.y, addr + SDRAM_EDGE_PARAMS_BASE_BYTES,
+            size)
+        weights = numpy.frombuffer(data, dtype=uint16).astype(float)
+        atoms = numpy.arange(
+            self.vertex_slice.lo_atom, self.vertex_slice.hi_atom + 1)
+        connections = numpy.zeros(
+            self.vertex_slice.n_atoms, dtype=NUMPY_CONNECTORS_DTYPE)
+        connections["source"] = atoms
+        connections["target"] = atoms
+        connections["weight"] = (
+            weights / self.__weight_scales[synapse_info.synapse_type])
+        connections["delay"] = SpynnakerDataView.get_simulation_time_step_ms()
+        return connections
@@ -15,7 +15,8 @@ from __future__ import annotations
 from collections import Counter
 import logging
 from typing import (
-    Collection, List, Optional, Sequence, Tuple, Union, TYPE_CHECKING)
+    Collection, Dict, List, Optional, Sequence, Tuple, Union, cast,
+    TYPE_CHECKING)
 
 import numpy
 from numpy.typing import ArrayLike, NDArray
@@ -25,7 +26,7 @@ from pyNN.space import Grid2D, Grid3D, BaseStructure
 
 from spinn_utilities.log import FormatAdapter
 from spinn_utilities.overrides import overrides
-from spinn_utilities.config_holder import get_config_int
+from spinn_utilities.config_holder import get_config_bool, get_config_int
 from spinn_utilities.ranged.abstract_sized import Selector
 
 from pacman.model.graphs.common import Slice
@@ -41,11 +42,19 @@ from spynnaker.pyNN.models.common import (
 from spynnaker.pyNN.models.common.types import (Names, Spikes)
 from spynnaker.pyNN.utilities.buffer_data_type import BufferDataType
 from spynnaker.pyNN.utilities.ranged import SpynnakerRangedList
+from spynnaker.pyNN.utilities.utility_calls import create_mars_kiss_seeds
 
 from .spike_source_array_machine_vertex import SpikeSourceArrayMachineVertex
+from .spike_source_array_compact_machine_vertex import (
+    SpikeFrames, SpikePattern, SpikeSourceArrayCompactMachineVertex,
+    encode_spike_frames, get_sdram)
 
 if TYPE_CHECKING:
     from .spike_source_array import SpikeSourceArray
+    from spynnaker.pyNN.models.neural_projections import SynapseInformation
+    from spynnaker.pyNN.models.neuron.synapse_dynamics.types import (
+        ConnectionsArray)
+    from spynnaker.pyNN.models.projection import Projection
 
 logger = FormatAdapter(logging.getLogger(__name__))
 
@@ -80,6 +89,36 @@ def _as_numpy_ticks(
         numpy.floor(numpy.array(times) * 1000.0) / time_step).astype("int64")
 
 
+def _spike_pattern(
+        period: Optional[float], jitter: float,
+        seed: Optional[int]) -> Optional[SpikePattern]:
+    """
+    Convert the pattern parameters in ms to time steps.
+
+    :param period: The period of the pattern in ms, or `None` if no repeat
+    :type period: float or None
+    :param float jitter: The most the pattern can start late by in ms
+    :param seed: The seed of the random start of each repetition
+    :type seed: int or None
+    :rtype: SpikePattern or None
+    """
+    if period is None:
+        if jitter:
+            raise ValueError("pattern_jitter needs a pattern_period")
+        return None
+    time_step = SpynnakerDataView.get_simulation_time_step_us()
+    period_steps = int(_as_numpy_ticks([period], time_step)[0])
+    jitter_steps = int(_as_numpy_ticks([jitter], time_step)[0])
+    if period_steps <= 0:
+        raise ValueError("pattern_period must be at least one time step")
+    if jitter_steps < 0 or jitter_steps >= period_steps:
+        raise ValueError(
+            "pattern_jitter must be at least 0 and less than pattern_period")
+    return SpikePattern(
+        period_steps, jitter_steps,
+        create_mars_kiss_seeds(numpy.random.RandomState(seed)))
+
+
 def _send_buffer_times(
         spike_times: Spikes, time_step: float) -> Union[
             NDArray[numpy.int64], List[NDArray[numpy.int64]]]:
@@ -105,7 +144,11 @@ class SpikeSourceArrayVertex(
         "__model",
         "__structure",
         "_spike_times",
-        "__n_colour_bits")
+        "__n_colour_bits",
+        "__compact",
+        "__compact_frames",
+        "__outgoing_projections",
+        "__pattern")
 
     #: ID of the recording region used for recording transmitted spikes.
     SPIKE_RECORDING_REGION_ID = 0
@@ -115,11 +158,19 @@ class SpikeSourceArrayVertex(
             max_atoms_per_core: Union[int, Tuple[int, ...]],
             model: SpikeSourceArray,
             splitter: Optional[AbstractSplitterCommon],
-            n_colour_bits: Optional[int]):
+            n_colour_bits: Optional[int],
+            pattern_period: Optional[float] = None,
+            pattern_jitter: float = 0.0, seed: Optional[int] = None):
         # pylint: disable=too-many-arguments
         self.__model_name = "SpikeSourceArray"
         self.__model = model
         self.__structure: Optional[BaseStructure] = None
+        self.__pattern = _spike_pattern(pattern_period, pattern_jitter, seed)
+        # Only the compact form can repeat a pattern on the machine
+        self.__compact = self.__pattern is not None or get_config_bool(
+            "Simulation", "compact_spike_source_array")
+        self.__compact_frames: Dict[str, SpikeFrames] = dict()
+        self.__outgoing_projections: List[Projection] = list()
 
         if spike_times is None:
             spike_times = []
@@ -143,10 +194,61 @@ class SpikeSourceArrayVertex(
         else:
             self.__n_colour_bits = n_colour_bits
 
+    def __get_compact_frames(self, vertex_slice: Slice) -> SpikeFrames:
+        """
+        Get the spikes of a slice encoded to be held on the machine.
+
+        :param ~pacman.model.graphs.common.Slice vertex_slice:
+        :rtype: SpikeFrames
+        """
+        key = str(vertex_slice)
+        if key not in self.__compact_frames:
+            n_atoms = vertex_slice.n_atoms
+            times = self._filtered_send_buffer_times(vertex_slice)
+            if times is None or not len(times):
+                ticks = numpy.zeros(0, dtype=numpy.int64)
+                ids = numpy.zeros(0, dtype=numpy.int64)
+            elif hasattr(times[0], "__len__"):
+                # Each atom has its own times
+                ticks = numpy.concatenate(
+                    [numpy.asarray(t, dtype=numpy.int64) for t in times])
+                ids = numpy.repeat(
+                    numpy.arange(n_atoms), [len(t) for t in times])
+            else:
+                # All atoms have the same times
+                atom_ticks = numpy.asarray(times, dtype=numpy.int64)
+                ticks = numpy.tile(atom_ticks, n_atoms)
+                ids = numpy.repeat(numpy.arange(n_atoms), len(atom_ticks))
+            if self.__pattern is not None and len(ticks) and (
+                    ticks.max() + self.__pattern.jitter >=
+                    self.__pattern.period):
+                raise ValueError(
+                    "The spike times of a repeating SpikeSourceArray plus "
+                    "the pattern_jitter must be less than the "
+                    "pattern_period")
+            self.__compact_frames[key] = encode_spike_frames(
+                ticks, ids, n_atoms)
+        return self.__compact_frames[key]
+
+    @overrides(ReverseIpTagMultiCastSource.get_sdram_used_by_atoms)
+    def get_sdram_used_by_atoms(self, vertex_slice: Slice) -> AbstractSDRAM:
+        if self.__compact:
+            return get_sdram(
+                vertex_slice.n_atoms, self.__get_compact_frames(vertex_slice))
+        return super().get_sdram_used_by_atoms(vertex_slice)
+
     @overrides(ReverseIpTagMultiCastSource.create_machine_vertex)
     def create_machine_vertex(
             self, vertex_slice: Slice, sdram: AbstractSDRAM,
-            label: Optional[str] = None) -> SpikeSourceArrayMachineVertex:
+            label: Optional[str] = None) -> Union[
+                SpikeSourceArrayMachineVertex,
+                SpikeSourceArrayCompactMachineVertex]:
+        if self.__compact:
+            compact_vertex = SpikeSourceArrayCompactMachineVertex(
+                sdram, self.__get_compact_frames(vertex_slice), label, self,
+                vertex_slice, self.__pattern)
+            compact_vertex.enable_recording(self._is_recording)
+            return compact_vertex
         send_buffer_times = self._filtered_send_buffer_times(vertex_slice)
         machine_vertex = SpikeSourceArrayMachineVertex(
             label=label, app_vertex=self, vertex_slice=vertex_slice,
@@ -254,7 +356,10 @@ class SpikeSourceArrayVertex(
         """
         time_step = SpynnakerDataView.get_simulation_time_step_us()
         # warn the user if they are asking for a spike time out of range
-        if _is_double_list(spike_times):
+        if self.__pattern is not None:
+            # The times of a pattern are relative to each repetition
+            pass
+        elif _is_double_list(spike_times):
             self._check_spikes_double_list(spike_times)
         elif _is_single_list(spike_times):
             self._to_early_spikes_single_list(spike_times)
@@ -265,6 +370,10 @@ class SpikeSourceArrayVertex(
             pass
         self.send_buffer_times = _send_buffer_times(spike_times, time_step)
         self._check_spike_density(spike_times)
+        if self.__compact:
+            # The spikes held on the machine have to be encoded again
+            self.__compact_frames.clear()
+            SpynnakerDataView.set_requires_mapping()
 
     def __read_parameter(self, name: str, selector: Selector):
         # pylint: disable=unused-argument
@@ -304,6 +413,8 @@ class SpikeSourceArrayVertex(
     @overrides(PopulationApplicationVertex.get_buffer_data_type)
     def get_buffer_data_type(self, name: str) -> BufferDataType:
         if name == "spikes":
+            if self.__compact:
+                return BufferDataType.MULTI_SPIKES
             return BufferDataType.EIEIO_SPIKES
         raise KeyError(f"Cannot record {name}")
 
@@ -386,3 +497,42 @@ class SpikeSourceArrayVertex(
     @overrides(PopulationApplicationVertex.n_colour_bits)
     def n_colour_bits(self) -> int:
         return self.__n_colour_bits
+
+    @property
+    def compact(self) -> bool:
+        """
+        Whether the spikes are held on the machine in the compact form.
+
+        :rtype: bool
+        """
+        return self.__compact
+
+    def add_outgoing_projection(self, projection: Projection):
+        """
+        Add an outgoing projection from this vertex.
+
+        :param Projection projection: The projection to add
+        """
+        self.__outgoing_projections.append(projection)
+
+    @property
+    def outgoing_projections(self) -> Sequence[Projection]:
+        """
+        The projections outgoing from this vertex.
+
+        :rtype: list(Projection)
+        """
+        return self.__outgoing_projections
+
+    def read_connections(
+            self, synapse_info: SynapseInformation) -> List[ConnectionsArray]:
+        """
+        Read the connections sent over SDRAM from the machine.
+
+        :param SynapseInformation synapse_info:
+            The synapse information of the data being read
+        :return: The set of connections from all machine vertices
+        """
+        return [cast(SpikeSourceArrayCompactMachineVertex, m_vertex)
+                .read_connections(synapse_info)
+                for m_vertex in self.machine_vertices]
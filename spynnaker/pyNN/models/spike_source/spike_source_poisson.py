@@ -21,7 +21,7 @@ from .spike_source_poisson_vertex import SpikeSourcePoissonVertex
 
 _population_parameters = {
     "seed": None, "max_rate": None, "splitter": None,
-    "n_colour_bits": None}
+    "n_colour_bits": None, "correlation": None}
 
 # Technically, this is ~2900 in terms of DTCM, but is timescale dependent
 # in terms of CPU (2900 at 10 times slow down is fine, but not at
@@ -55,7 +55,8 @@ class SpikeSourcePoisson(AbstractPyNNModel):
             self, n_neurons: int, label: str, *,
             seed: Optional[int] = None, max_rate: Optional[float] = None,
             splitter: Optional[AbstractSplitterCommon] = None,
-            n_colour_bits: Optional[int] = None) -> SpikeSourcePoissonVertex:
+            n_colour_bits: Optional[int] = None,
+            correlation: Optional[float] = None) -> SpikeSourcePoissonVertex:
         """
         :param float seed:
         :param float max_rate:
@@ -63,10 +64,15 @@ class SpikeSourcePoisson(AbstractPyNNModel):
         :type splitter:
             ~pacman.model.partitioner_splitters.AbstractSplitterCommon or None
         :param int n_colour_bits:
+        :param float correlation:
+            The correlation between sources at the maximum rate, made by
+            thinning a mother process shared by the sources of each core
+            on the machine, or `None` for independent sources
         """
         # pylint: disable=arguments-differ
         max_atoms = self.get_model_max_atoms_per_dimension_per_core()
         return SpikeSourcePoissonVertex(
             n_neurons, label, seed, max_atoms, self,
             rate=self.__rate, start=self.__start, duration=self.__duration,
-            max_rate=max_rate, splitter=splitter, n_colour_bits=n_colour_bits)
+            max_rate=max_rate, splitter=splitter, n_colour_bits=n_colour_bits,
+            correlation=correlation)
@@ -14,6 +14,7 @@
 from __future__ import annotations
 from enum import IntEnum
 from collections.abc import Sized
+import math
 import struct
 from typing import (
     Iterable, List, Optional, Sequence, TypeVar, Union,
@@ -152,9 +153,11 @@ def _u3232_to_uint64(array: numpy.ndarray) -> numpy.ndarray:
 # 7. unt32_t first_source_id; 8. uint32_t n_spike_sources;
 # 9. uint32_t max_spikes_per_timestep;
 # 10. uint32_t n_colour_bits;
-# 11,12,13,14 mars_kiss64_seed_t (uint[4]) spike_source_seed;
-# 15. Rate changed flag
-PARAMS_BASE_WORDS = 15
+# 11. REAL correlated_rate_per_tick; 12. UFRACT correlated_exp_minus_lambda;
+# 13. REAL correlated_sqrt_lambda;
+# 14,15,16,17 mars_kiss64_seed_t (uint[4]) spike_source_seed;
+# 18. Rate changed flag
+PARAMS_BASE_WORDS = 18
 
 # uint32_t n_rates; uint32_t index
 PARAMS_WORDS_PER_NEURON = 2
@@ -556,11 +559,35 @@ class SpikeSourcePoissonMachineVertex(
         # Write the number of colour bits
         spec.write_value(data=self._pop_vertex.n_colour_bits)
 
+        # Write the mother process of correlated sources, if any
+        self.__write_correlated_rate(spec)
+
         # Write the random seed (4 words), generated randomly!
         spec.write_array(self._pop_vertex.kiss_seed(self.vertex_slice))
 
         spec.write_array(keys)
 
+    def __write_correlated_rate(self, spec: DataSpecificationBase):
+        """
+        Write the rate per tick of the mother process of correlated sources
+        (0 if independent), and either exp(-rate) or sqrt(rate) depending on
+        how its spikes are to be generated.
+
+        :param ~data_specification.DataSpecification spec:
+            the data specification writer
+        """
+        rate_per_tick = (self._pop_vertex.correlated_rate *
+                         SpynnakerDataView.get_simulation_time_step_s())
+        exp_minus_lambda = 0.0
+        sqrt_lambda = 0.0
+        if rate_per_tick >= self.FAST_RATE_PER_TICK_CUTOFF:
+            sqrt_lambda = math.sqrt(rate_per_tick)
+        elif rate_per_tick > 0:
+            exp_minus_lambda = math.exp(-rate_per_tick)
+        spec.write_value(data=rate_per_tick, data_type=DataType.U1616)
+        spec.write_value(data=exp_minus_lambda, data_type=DataType.U032)
+        spec.write_value(data=sqrt_lambda, data_type=DataType.U1616)
+
     def set_rate_changed(self) -> None:
         """
         Records that the rates have changed.
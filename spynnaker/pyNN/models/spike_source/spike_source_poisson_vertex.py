@@ -159,7 +159,8 @@ class SpikeSourcePoissonVertex(
         "__incoming_control_edge",
         "__structure",
         "__allowed_parameters",
-        "__n_colour_bits")
+        "__n_colour_bits",
+        "__correlation")
 
     SPIKE_RECORDING_REGION_ID = 0
 
@@ -177,7 +178,8 @@ class SpikeSourcePoissonVertex(
                 Sequence[int], NDArray[numpy.integer], None] = None,
             max_rate: Optional[float] = None,
             splitter: Optional[AbstractSplitterCommon] = None,
-            n_colour_bits: Optional[int] = None):
+            n_colour_bits: Optional[int] = None,
+            correlation: Optional[float] = None):
         """
         :param int n_neurons:
         :param str label:
@@ -195,9 +197,19 @@ class SpikeSourcePoissonVertex(
         :type splitter:
             ~pacman.model.partitioner_splitters.AbstractSplitterCommon or None
         :param int n_colour_bits:
+        :param correlation:
+            If given, the sources of each core keep spikes of a shared
+            mother process, so that sources at the maximum rate have this
+            correlation between them
+        :type correlation: float or None
         """
         # pylint: disable=too-many-arguments
         super().__init__(label, max_atoms_per_core, splitter)
+        if correlation is not None and not 0.0 < correlation <= 1.0:
+            raise ValueError(
+                f"The correlation {correlation} must be more than 0 and at "
+                "most 1")
+        self.__correlation = correlation
 
         # atoms params
         self.__n_atoms = self.round_n_atoms(n_neurons, "n_neurons")
@@ -579,6 +591,18 @@ class SpikeSourcePoissonVertex(
         """
         return float(self.__max_rate)
 
+    @property
+    def correlated_rate(self) -> float:
+        """
+        The rate of the mother process of the sources if they are
+        correlated, or 0 if they are independent.
+
+        :rtype: float
+        """
+        if self.__correlation is None:
+            return 0.0
+        return self.max_rate / self.__correlation
+
     @property
     def max_n_rates(self) -> int:
         """
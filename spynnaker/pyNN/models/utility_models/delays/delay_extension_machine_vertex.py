@@ -159,10 +159,11 @@ class DelayExtensionMachineVertex(
                 db.insert_report(
                     f"The delay extension {label} has dropped {n_sat} packets "
                     f"because during certain time steps a neuron was asked to "
-                    f"spike more than 256 times. This causes a saturation on "
-                    f"the count tracker which is a uint8. "
-                    f"Reduce the packet rates, or modify the delay extension "
-                    f"to have larger counters.")
+                    f"spike more times than the count tracker can hold, "
+                    f"which is 255 unless it was built with "
+                    f"DELAY_WIDE_COUNTERS=1. "
+                    f"Reduce the packet rates, or rebuild the delay extension "
+                    f"with DELAY_WIDE_COUNTERS=1 to have 16-bit counters.")
 
             db.insert_core(
                 x, y, p, self.INVALID_NEURON_ID_COUNT_NAME,
@@ -299,16 +300,17 @@ class DelayExtensionMachineVertex(
 
         srcs = self.app_vertex.source_vertex.splitter.get_out_going_vertices(
             self.app_vertex.partition.identifier)
+        sources = list()
         for source_vertex in srcs:
             if source_vertex.vertex_slice == self.vertex_slice:
                 r_info = routing_infos.get_info_from(
                     source_vertex, self.app_vertex.partition.identifier)
-                incoming_key = r_info.key
                 incoming_mask = r_info.mask
+                sources.append((r_info.key, 0, self.vertex_slice.n_atoms))
                 break
 
         self.write_delay_parameters(
-            spec, self.vertex_slice, key, incoming_key, incoming_mask)
+            spec, self.vertex_slice, key, incoming_mask, sources)
 
         # End-of-Spec:
         spec.end_specification()
@@ -324,15 +326,17 @@ class DelayExtensionMachineVertex(
             binary_name))
 
     def write_delay_parameters(
-            self, spec, vertex_slice, key, incoming_key, incoming_mask):
+            self, spec, vertex_slice, key, incoming_mask, sources):
         """
         Generate Delay Parameter data.
 
         :param ~data_specification.DataSpecificationGenerator spec:
         :param ~pacman.model.graphs.common.Slice vertex_slice:
         :param int key:
-        :param int incoming_key:
-        :param int incoming_mask:
+        :param int incoming_mask: The mask shared by the source keys
+        :param list(tuple(int, int, int)) sources:
+            The key, first neuron on this core and number of neurons of each
+            source of spikes to delay
         """
         # pylint: disable=too-many-arguments
 
@@ -351,7 +355,6 @@ class DelayExtensionMachineVertex(
         else:
             spec.write_value(1)
             spec.write_value(data=key)
-        spec.write_value(data=incoming_key)
         spec.write_value(data=incoming_mask)
 
         # Write the number of neurons in the block:
@@ -369,3 +372,10 @@ class DelayExtensionMachineVertex(
 
         # Write the number of colour bits
         spec.write_value(data=app_vertex.n_colour_bits)
+
+        # Write the sources, which are found by their keys
+        spec.write_value(data=len(sources))
+        for source_key, first_neuron, n_neurons in sources:
+            spec.write_value(data=source_key)
+            spec.write_value(data=first_neuron)
+            spec.write_value(data=n_neurons)
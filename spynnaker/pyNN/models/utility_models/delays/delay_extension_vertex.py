@@ -28,6 +28,13 @@ if TYPE_CHECKING:
 
 _DELAY_PARAM_HEADER_WORDS = 9
 
+# The words of each source of spikes: key, first neuron, number of neurons
+_DELAY_SOURCE_WORDS = 3
+
+# The number of sources each delay core serves; the delayed synaptic matrices
+# are laid out by the slices of the source, so this is one
+_N_SOURCES_PER_CORE = 1
+
 
 class DelayExtensionVertex(ApplicationVertex, AbstractHasDelayStages):
     """
@@ -157,7 +164,9 @@ class DelayExtensionVertex(ApplicationVertex, AbstractHasDelayStages):
         """
         The size of the delay parameters.
         """
-        return BYTES_PER_WORD * _DELAY_PARAM_HEADER_WORDS
+        return BYTES_PER_WORD * (
+            _DELAY_PARAM_HEADER_WORDS +
+            _DELAY_SOURCE_WORDS * _N_SOURCES_PER_CORE)
 
     @property
     def partition(self) -> ApplicationEdgePartition:
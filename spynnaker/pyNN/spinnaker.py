@@ -48,10 +48,21 @@ from spynnaker.pyNN.extra_algorithms import (
     delay_support_adder, neuron_expander, synapse_expander,
     redundant_packet_count_report,
     spynnaker_neuron_graph_network_specification_report)
+from spynnaker.pyNN.extra_algorithms.core_load_prediction import (
+    predict_core_loads)
+from spynnaker.pyNN.extra_algorithms.population_key_allocator import (
+    allocate_population_keys)
+from spynnaker.pyNN.extra_algorithms.recording_pauses_report import (
+    recording_pauses_report)
+from spynnaker.pyNN.extra_algorithms.run_recommendations import (
+    apply_population_recommendations, read_run_recommendations,
+    run_recommendations_report)
 from spynnaker.pyNN.extra_algorithms.connection_holder_finisher import (
     finish_connection_holders)
 from spynnaker.pyNN.extra_algorithms.splitter_components import (
     spynnaker_splitter_selector)
+from spynnaker.pyNN.extra_algorithms.traffic_placement_hints import (
+    traffic_placement_hints)
 from spynnaker.pyNN.utilities.neo_buffer_database import NeoBufferDatabase
 
 
@@ -115,7 +126,12 @@ class SpiNNaker(AbstractSpinnakerBase, pynn_control.BaseState):
         super().__init__(SpynnakerDataWriter)
 
         self.__writer.set_n_required(n_boards_required, n_chips_required)
-        # set up machine targeted data
+        # set up machine targeted data, as recommended by a previous run if
+        # not given
+        if time_scale_factor is None:
+            recommendations = read_run_recommendations()
+            if recommendations is not None:
+                time_scale_factor = recommendations.time_scale_factor
         self._set_up_timings(timestep, min_delay, time_scale_factor)
 
         with GlobalProvenance() as db:
@@ -449,6 +465,8 @@ class SpiNNaker(AbstractSpinnakerBase, pynn_control.BaseState):
     def _do_provenance_reports(self) -> None:
         AbstractSpinnakerBase._do_provenance_reports(self)
         self._report_redundant_packet_count()
+        self._report_run_recommendations()
+        self._report_recording_pauses()
 
     def _report_redundant_packet_count(self) -> None:
         with FecTimer("Redundant packet count report",
@@ -458,10 +476,40 @@ class SpiNNaker(AbstractSpinnakerBase, pynn_control.BaseState):
                 return
             redundant_packet_count_report()
 
+    def _report_run_recommendations(self) -> None:
+        with FecTimer("Run recommendations report",
+                      TimerWork.REPORT) as timer:
+            if timer.skip_if_cfg_false(
+                    "Reports", "write_run_recommendations"):
+                return
+            run_recommendations_report()
+
+    def _report_recording_pauses(self) -> None:
+        with FecTimer("Recording pauses report", TimerWork.REPORT) as timer:
+            if timer.skip_if_cfg_false(
+                    "Reports", "write_recording_pauses_report"):
+                return
+            recording_pauses_report()
+
     @overrides(AbstractSpinnakerBase._execute_splitter_selector)
     def _execute_splitter_selector(self) -> None:
         with FecTimer("Spynnaker splitter selector", TimerWork.OTHER):
+            recommendations = read_run_recommendations()
+            if recommendations is not None:
+                apply_population_recommendations(
+                    recommendations, SpynnakerDataView.iterate_vertices())
             spynnaker_splitter_selector()
+        self._execute_core_load_prediction()
+        with FecTimer("Traffic placement hints", TimerWork.OTHER) as timer:
+            if timer.skip_if_cfg_false("Mapping", "traffic_placement_hints"):
+                return
+            traffic_placement_hints()
+
+    def _execute_core_load_prediction(self) -> None:
+        with FecTimer("Core load prediction", TimerWork.OTHER) as timer:
+            if timer.skip_if_cfg_false("Mapping", "predict_core_loads"):
+                return
+            predict_core_loads()
 
     @overrides(AbstractSpinnakerBase._execute_delay_support_adder,
                extend_doc=False)
@@ -483,6 +531,20 @@ class SpiNNaker(AbstractSpinnakerBase, pynn_control.BaseState):
             raise ConfigurationException(
                 f"Unexpected cfg setting delay_support_adder: {name}")
 
+    @overrides(AbstractSpinnakerBase._execute_splitter_partitioner)
+    def _execute_splitter_partitioner(self) -> None:
+        # The keys are planned once the delay vertices have been added
+        self._execute_population_key_allocator()
+        super()._execute_splitter_partitioner()
+
+    def _execute_population_key_allocator(self) -> None:
+        apply = get_config_bool("Mapping", "plan_population_keys")
+        with FecTimer("Population key allocator", TimerWork.OTHER) as timer:
+            if not apply and timer.skip_if_cfg_false(
+                    "Reports", "write_population_keys_report"):
+                return
+            allocate_population_keys(apply)
+
     @overrides(AbstractSpinnakerBase._execute_buffer_extractor)
     def _execute_buffer_extractor(self) -> None:
         super()._execute_buffer_extractor()
@@ -13,18 +13,22 @@
 # limitations under the License.
 from __future__ import annotations
 import math
-from typing import Iterable, Optional, TYPE_CHECKING, Tuple
+from typing import Iterable, List, Optional, TYPE_CHECKING, Tuple
 
 import numpy
 from numpy import uint32
 from numpy.typing import NDArray
 
-from spinn_front_end_common.interface.ds import DataSpecificationBase
+from spinn_utilities.config_holder import get_config_float
+
+from spinn_front_end_common.interface.ds import (
+    DataSpecificationBase, DataType)
 from spinn_front_end_common.utilities.constants import BYTES_PER_WORD
 
 from spynnaker.pyNN.data import SpynnakerDataView
 
 if TYPE_CHECKING:
+    from pacman.model.graphs.application import ApplicationVertex
     from spynnaker.pyNN.models.projection import Projection
     from spynnaker.pyNN.models.neural_projections import (
         ProjectionApplicationEdge)
@@ -36,6 +40,9 @@ FILTER_INFO_WORDS = 4
 #: n_filters, pointer for array
 FILTER_HEADER_WORDS = 2
 
+#: the position in the load order of the filter, after all the bit fields
+FILTER_ORDER_WORDS = 1
+
 #: the number of bits in a word
 # (WHY IS THIS NOT A CONSTANT SOMEWHERE!)
 BIT_IN_A_WORD = 32.0
@@ -92,17 +99,20 @@ def get_sdram_for_bit_field_region(
     for in_edge, _part_id in _unique_edges(incoming_projections):
         n_atoms = in_edge.pre_vertex.n_atoms
         n_words_for_atoms = int(math.ceil(n_atoms / BIT_IN_A_WORD))
-        sdram += (FILTER_INFO_WORDS + n_words_for_atoms) * BYTES_PER_WORD
+        sdram += (FILTER_INFO_WORDS + FILTER_ORDER_WORDS +
+                  n_words_for_atoms) * BYTES_PER_WORD
         # Also add for delay vertices if needed
         n_words_for_delays = int(math.ceil(
             n_atoms * in_edge.n_delay_stages / BIT_IN_A_WORD))
-        sdram += (FILTER_INFO_WORDS + n_words_for_delays) * BYTES_PER_WORD
+        sdram += (FILTER_INFO_WORDS + FILTER_ORDER_WORDS +
+                  n_words_for_delays) * BYTES_PER_WORD
     return sdram
 
 
 def get_sdram_for_keys(incoming_projections: Iterable[Projection]) -> int:
     """
-    Gets the space needed for keys.
+    Gets the space needed for the key map, which has the number of atoms
+    and the expected spike rate of each source.
 
     :param incoming_projections:
         The projections that target the vertex in question
@@ -114,17 +124,117 @@ def get_sdram_for_keys(incoming_projections: Iterable[Projection]) -> int:
     # basic sdram
     sdram = 0
     for in_edge, _part_id in _unique_edges(incoming_projections):
-        sdram += BYTES_PER_WORD
-        if in_edge.n_delay_stages:
-            sdram += BYTES_PER_WORD
+        sdram += 2 * BYTES_PER_WORD
+        if in_edge.delay_edge is not None:
+            sdram += 2 * BYTES_PER_WORD
     return sdram
 
 
+def get_spikes_per_second(pre_vertex: ApplicationVertex) -> float:
+    """
+    Get the expected rate at which each atom of a source sends spikes.
+
+    This is the highest rate of a Poisson source, or the spikes_per_second of
+    a population, or otherwise the spikes_per_second of the configuration.
+    It does not need the source to have been split into machine vertices.
+
+    :param ~pacman.model.graphs.application.ApplicationVertex pre_vertex:
+        The source to get the rate of
+    :rtype: float
+    """
+    # Avoid circular import
+    # pylint: disable=import-outside-toplevel
+    from spynnaker.pyNN.models.neuron import AbstractPopulationVertex
+    from spynnaker.pyNN.models.spike_source import SpikeSourcePoissonVertex
+    if isinstance(pre_vertex, SpikeSourcePoissonVertex):
+        return pre_vertex.max_rate
+    if isinstance(pre_vertex, AbstractPopulationVertex):
+        return pre_vertex.spikes_per_second
+    return get_config_float("Simulation", "spikes_per_second")
+
+
+def get_hot_sources(
+        incoming_projections: Iterable[Projection],
+        max_sources: int) -> List[Tuple[int, int]]:
+    """
+    Get the sources whose rows are worth keeping in the synaptic row cache.
+
+    These are the sources where each atom is expected to send spikes at
+    at least the hot_source_spikes_per_second of the configuration, fastest
+    first.
+
+    :param incoming_projections:
+        The projections that target the vertex in question
+    :type incoming_projections:
+        iterable(~spynnaker.pyNN.models.projection.Projection)
+    :param int max_sources: The most sources to return
+    :return: The key and mask of each hot source
+    :rtype: list(tuple(int, int))
+    """
+    min_rate = get_config_float("Simulation", "hot_source_spikes_per_second")
+    routing_infos = SpynnakerDataView.get_routing_infos()
+    sources = []
+    for in_edge, part_id in _unique_edges(incoming_projections):
+        rate = get_spikes_per_second(in_edge.pre_vertex)
+        if rate < min_rate:
+            continue
+        r_info = routing_infos.get_info_from(in_edge.pre_vertex, part_id)
+        sources.append((rate, r_info.key, r_info.mask))
+        if in_edge.delay_edge is not None:
+            r_info = routing_infos.get_info_from(
+                in_edge.delay_edge.pre_vertex, part_id)
+            sources.append((rate, r_info.key, r_info.mask))
+    sources.sort(key=lambda source: -source[0])
+    return [(key, mask) for _rate, key, mask in sources[:max_sources]]
+
+
+def get_priority_sources(
+        incoming_projections: Iterable[Projection],
+        max_sources: int) -> List[Tuple[int, int]]:
+    """
+    Get the sources whose late packets are kept when the rest are dropped.
+
+    These are the populations of neurons that target the vertex, rather than
+    the spike sources that often only provide background input, the least
+    frequently spiking first so that the fewest late packets are kept.
+
+    :param incoming_projections:
+        The projections that target the vertex in question
+    :type incoming_projections:
+        iterable(~spynnaker.pyNN.models.projection.Projection)
+    :param int max_sources: The most sources to return
+    :return: The key and mask of each priority source
+    :rtype: list(tuple(int, int))
+    """
+    # Avoid circular import
+    # pylint: disable=import-outside-toplevel
+    from spynnaker.pyNN.models.neuron import AbstractPopulationVertex
+    routing_infos = SpynnakerDataView.get_routing_infos()
+    sources = []
+    for in_edge, part_id in _unique_edges(incoming_projections):
+        if not isinstance(in_edge.pre_vertex, AbstractPopulationVertex):
+            continue
+        rate = get_spikes_per_second(in_edge.pre_vertex)
+        r_info = routing_infos.get_info_from(in_edge.pre_vertex, part_id)
+        sources.append((rate, r_info.key, r_info.mask))
+        if in_edge.delay_edge is not None:
+            r_info = routing_infos.get_info_from(
+                in_edge.delay_edge.pre_vertex, part_id)
+            sources.append((rate, r_info.key, r_info.mask))
+    sources.sort(key=lambda source: source[0])
+    return [(key, mask) for _rate, key, mask in sources[:max_sources]]
+
+
 def get_bitfield_key_map_data(
         incoming_projections: Iterable[Projection]) -> NDArray[uint32]:
     """
     Get data for the key map region.
 
+    This is the number of atoms of each source, followed by the rate at
+    which each atom of the source is expected to send spikes, both ordered
+    by key.  The rates let the bit fields that would filter the most spikes
+    per word be loaded into DTCM first.
+
     :param incoming_projections:
         The projections to generate bitfields for
     :type incoming_projections:
@@ -134,26 +244,34 @@ def get_bitfield_key_map_data(
     # Gather the source vertices that target this core
     routing_infos = SpynnakerDataView.get_routing_infos()
     sources = []
+    rates = []
     for in_edge, part_id in _unique_edges(incoming_projections):
         key = routing_infos.get_key_from(
             in_edge.pre_vertex, part_id)
+        rate = min(get_spikes_per_second(in_edge.pre_vertex),
+                   float(DataType.S1615.max))
         sources.append([key, in_edge.pre_vertex.n_atoms])
+        rates.append(rate)
         if in_edge.delay_edge is not None:
             delay_key = routing_infos.get_key_from(
                 in_edge.delay_edge.pre_vertex, part_id)
             n_delay_atoms = (
                 in_edge.pre_vertex.n_atoms * in_edge.n_delay_stages)
             sources.append([delay_key, n_delay_atoms])
+            rates.append(rate)
 
     if not sources:
         return numpy.array([], dtype=uint32)
 
     # Make keys and atoms, ordered by keys
     key_map = numpy.array(sources, dtype=uint32)
-    key_map = key_map[numpy.argsort(key_map[:, 0])]
+    order = numpy.argsort(key_map[:, 0])
 
-    # get the number of atoms per item
-    return key_map[:, 1]
+    # get the number of atoms and rate per item
+    return numpy.concatenate((
+        key_map[order, 1],
+        DataType.S1615.encode_as_numpy_int_array(
+            numpy.array(rates)[order]).astype(uint32)))
 
 
 def write_bitfield_init_data(
@@ -25,6 +25,7 @@ class BufferDataType(Enum):
     EIEIO_SPIKES = (auto())
     MULTI_SPIKES = (auto())
     MATRIX = (auto())
+    MOMENTS = (auto())
     REWIRES = (auto())
     NOT_NEO = (auto())
 
@@ -59,6 +59,12 @@ MIN_SUPPORTED_DELAY = 1
 #: The partition ID used for spike data
 SPIKE_PARTITION_ID = "SPIKE"
 
+#: The SDP port that changes to neuron parameters are sent to while running
+LIVE_PARAMETERS_SDP_PORT = 3
+
+#: The command to set the amplitudes of DC sources while running
+LIVE_SET_DC_AMPLITUDE = 0
+
 # names for recording components
 SPIKES = 'spikes'
 MEMBRANE_POTENTIAL = "v"
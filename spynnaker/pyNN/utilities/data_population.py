@@ -103,13 +103,15 @@ class DataPopulation(object):
     @overrides(Population.spinnaker_get_data)
     def spinnaker_get_data(
             self, variable: str, as_matrix: bool = False,
-            view_indexes: Optional[Sequence[int]] = None) -> NDArray[floating]:
+            view_indexes: Optional[Sequence[int]] = None,
+            mmap_file: Optional[str] = None) -> NDArray[floating]:
         # pylint: disable=missing-function-docstring
         if view_indexes:
-            return self[view_indexes].spinnaker_get_data(variable, as_matrix)
+            return self[view_indexes].spinnaker_get_data(
+                variable, as_matrix, mmap_file=mmap_file)
         with NeoBufferDatabase(self.__database_file) as db:
             return db.spinnaker_get_data(
-                self.__label, variable, as_matrix, self._indexes)
+                self.__label, variable, as_matrix, self._indexes, mmap_file)
 
     @overrides(Population.get_spike_counts)
     def get_spike_counts(self, gather: bool = True) -> Dict[int, int]:
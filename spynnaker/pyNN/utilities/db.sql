@@ -23,6 +23,9 @@ CREATE TABLE IF NOT EXISTS population (
     pop_size int NOT NULL,
     description TEXT NOT NULL);
 
+-- Populations are looked up by label
+CREATE INDEX IF NOT EXISTS population_label ON population(label);
+
 CREATE TABLE IF NOT EXISTS recording (
     rec_id INTEGER PRIMARY KEY AUTOINCREMENT,
     pop_id INTEGER NOT NULL
@@ -62,3 +65,9 @@ CREATE TABLE IF NOT EXISTS region_metadata(
     vertex_slice TEXT,
     base_key INT);
 
+-- The regions of a recording are looked up by the recording, in order of
+-- region; this covers that query
+CREATE INDEX IF NOT EXISTS region_metadata_rec
+    ON region_metadata(
+        rec_id ASC, region_id ASC, recording_neurons_st, vertex_slice,
+        base_key);
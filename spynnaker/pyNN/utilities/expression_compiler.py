@@ -0,0 +1,384 @@
+# Copyright (c) 2026 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""
+Compiles expressions, such as the probability of a connection, into the
+code of the stack machine of the synapse expander (see ``expression.h``),
+so that connectors with arbitrary expressions can be generated on the
+machine.
+"""
+
+from __future__ import annotations
+import ast
+from enum import IntEnum
+import math
+from typing import Dict, List, Mapping, Optional, Sequence, Tuple, Union
+
+import numpy
+from numpy import floating, uint32
+from numpy.typing import NDArray
+
+# The bits after the point of an S16.15 value
+_FRACTION_BITS = 15
+_ONE = 1 << _FRACTION_BITS
+_INT32_MIN = -(1 << 31)
+_INT32_MAX = (1 << 31) - 1
+
+#: The deepest stack an expression can use on the machine
+MAX_STACK = 16
+
+# The largest argument of exp() whose result fits, as on the machine
+_MAX_EXP = 11 * _ONE
+
+#: The most by which a probability on the machine can differ from Python
+PROBABILITY_TOLERANCE = 1e-3
+
+# The largest integer power expanded into multiplications
+_MAX_POWER = 8
+
+#: The variables an expression can use, and their index on the machine;
+#: these match expression_var in expression.h
+VARIABLES: Mapping[str, int] = {"i": 0, "j": 1, "d": 2}
+
+# Named constants that can be used
+_CONSTANTS = {"e": math.e, "pi": math.pi}
+
+
+class _Op(IntEnum):
+    """
+    The operations of the stack machine; these match expression_op in
+    expression.h.
+    """
+    CONST = 0
+    VAR = 1
+    ADD = 2
+    SUB = 3
+    MUL = 4
+    NEG = 5
+    ABS = 6
+    EXP = 7
+    SQRT = 8
+    LT = 9
+    LE = 10
+    MIN = 11
+    MAX = 12
+
+
+# Functions of one argument, by the names they can be called
+_UNARY = {"exp": _Op.EXP, "sqrt": _Op.SQRT, "abs": _Op.ABS, "fabs": _Op.ABS}
+
+# Functions of two arguments, by the names they can be called
+_BINARY = {"min": _Op.MIN, "minimum": _Op.MIN, "max": _Op.MAX,
+           "maximum": _Op.MAX}
+
+# Binary operators that map directly to an operation
+_BIN_OPS = {ast.Add: _Op.ADD, ast.Sub: _Op.SUB, ast.Mult: _Op.MUL}
+
+# How the host works out each operation on constants
+_FOLD = {
+    _Op.ADD: lambda a, b: a + b, _Op.SUB: lambda a, b: a - b,
+    _Op.MUL: lambda a, b: a * b, _Op.NEG: lambda a: -a,
+    _Op.ABS: abs, _Op.EXP: math.exp, _Op.SQRT: math.sqrt,
+    _Op.LT: lambda a, b: float(a < b), _Op.LE: lambda a, b: float(a <= b),
+    _Op.MIN: min, _Op.MAX: max}
+
+
+class _Unsupported(Exception):
+    """
+    Raised when an expression uses something the machine can't do.
+    """
+
+
+# Code compiled so far: either a constant still to be folded, or the words
+# of the code and the depth of stack it needs
+_Code = Union[float, Tuple[List[int], int]]
+
+
+def _to_bits(value: float) -> int:
+    """
+    Convert a value to the bits of a saturated S16.15 number.
+    """
+    return int(min(max(round(value * _ONE), _INT32_MIN), _INT32_MAX))
+
+
+def _emit(code: _Code) -> Tuple[List[int], int]:
+    """
+    Get the words and stack depth of compiled code, pushing a constant if
+    that is what it is.
+    """
+    if isinstance(code, tuple):
+        return code
+    return [_Op.CONST, _to_bits(code) & 0xFFFFFFFF], 1
+
+
+def _unary(op: _Op, a: _Code) -> _Code:
+    if not isinstance(a, tuple):
+        try:
+            return float(_FOLD[op](a))
+        except (ValueError, OverflowError) as e:
+            raise _Unsupported() from e
+    words, depth = a
+    return words + [op], depth
+
+
+def _binary(op: _Op, a: _Code, b: _Code) -> _Code:
+    if not isinstance(a, tuple) and not isinstance(b, tuple):
+        return float(_FOLD[op](a, b))
+    a_words, a_depth = _emit(a)
+    b_words, b_depth = _emit(b)
+    return a_words + b_words + [op], max(a_depth, b_depth + 1)
+
+
+class _Compiler(object):
+    """
+    Compiles the nodes of a parsed Python expression.
+    """
+
+    __slots__ = ("__variables", )
+
+    def __init__(self, variables: Sequence[str]):
+        self.__variables = variables
+
+    def compile(self, node: ast.AST) -> _Code:
+        """
+        Compile a node of the expression.
+
+        :raises _Unsupported: If the node can't be done on the machine
+        """
+        # pylint: disable=too-many-return-statements
+        if isinstance(node, ast.Expression):
+            return self.compile(node.body)
+        if isinstance(node, ast.Constant):
+            if isinstance(node.value, (bool, int, float)):
+                return float(node.value)
+            raise _Unsupported()
+        if isinstance(node, ast.Name):
+            if node.id in self.__variables:
+                return [_Op.VAR, VARIABLES[node.id]], 1
+            if node.id in _CONSTANTS:
+                return _CONSTANTS[node.id]
+            raise _Unsupported()
+        if isinstance(node, ast.UnaryOp):
+            if isinstance(node.op, ast.UAdd):
+                return self.compile(node.operand)
+            if isinstance(node.op, ast.USub):
+                return _unary(_Op.NEG, self.compile(node.operand))
+            raise _Unsupported()
+        if isinstance(node, ast.BinOp):
+            return self.__bin_op(node)
+        if isinstance(node, ast.Compare):
+            return self.__compare(node)
+        if isinstance(node, ast.Call):
+            return self.__call(node)
+        raise _Unsupported()
+
+    def __bin_op(self, node: ast.BinOp) -> _Code:
+        a = self.compile(node.left)
+        b = self.compile(node.right)
+        op_type = type(node.op)
+        if op_type in _BIN_OPS:
+            return _binary(_BIN_OPS[op_type], a, b)
+        if op_type is ast.Div:
+            # Only division by a constant, which is a multiplication
+            if isinstance(b, tuple) or b == 0:
+                raise _Unsupported()
+            return _binary(_Op.MUL, a, 1.0 / b)
+        if op_type is ast.Pow:
+            if isinstance(b, tuple):
+                raise _Unsupported()
+            if not isinstance(a, tuple):
+                return float(a ** b)
+            if b == 0.5:
+                return _unary(_Op.SQRT, a)
+            if b != int(b) or not 1 <= b <= _MAX_POWER:
+                raise _Unsupported()
+            result: _Code = a
+            for _ in range(int(b) - 1):
+                result = _binary(_Op.MUL, result, a)
+            return result
+        raise _Unsupported()
+
+    def __compare(self, node: ast.Compare) -> _Code:
+        if len(node.ops) != 1:
+            raise _Unsupported()
+        a = self.compile(node.left)
+        b = self.compile(node.comparators[0])
+        op = node.ops[0]
+        if isinstance(op, ast.Lt):
+            return _binary(_Op.LT, a, b)
+        if isinstance(op, ast.LtE):
+            return _binary(_Op.LE, a, b)
+        if isinstance(op, ast.Gt):
+            return _binary(_Op.LT, b, a)
+        if isinstance(op, ast.GtE):
+            return _binary(_Op.LE, b, a)
+        raise _Unsupported()
+
+    def __call(self, node: ast.Call) -> _Code:
+        func = node.func
+        # Allow numpy.exp and math.exp as well as exp
+        if isinstance(func, ast.Attribute) and isinstance(
+                func.value, ast.Name) and func.value.id in ("numpy", "math"):
+            name = func.attr
+        elif isinstance(func, ast.Name):
+            name = func.id
+        else:
+            raise _Unsupported()
+        if node.keywords:
+            raise _Unsupported()
+        args = [self.compile(arg) for arg in node.args]
+        if name in _UNARY and len(args) == 1:
+            return _unary(_UNARY[name], args[0])
+        if name in _BINARY and len(args) == 2:
+            return _binary(_BINARY[name], args[0], args[1])
+        raise _Unsupported()
+
+
+class CompiledExpression(object):
+    """
+    An expression compiled for the stack machine of the synapse expander.
+    """
+
+    __slots__ = ("__code", )
+
+    def __init__(self, code: List[int]):
+        """
+        :param list(int) code: The words of the code
+        """
+        self.__code = numpy.array(code, dtype=uint32)
+
+    @property
+    def data(self) -> NDArray[uint32]:
+        """
+        The expression as written to the machine; the number of words of
+        code followed by the code.
+
+        :rtype: ~numpy.ndarray
+        """
+        return numpy.concatenate(
+            (numpy.array([len(self.__code)], dtype=uint32), self.__code))
+
+    @property
+    def n_words(self) -> int:
+        """
+        The number of words of :py:attr:`data`.
+
+        :rtype: int
+        """
+        return len(self.__code) + 1
+
+    def evaluate(self, **variables: NDArray[floating]) -> NDArray[floating]:
+        """
+        Evaluate the expression as the machine would, to check that the
+        result is close enough to that of Python.
+
+        :param variables: The values of the variables, all the same shape
+        :rtype: ~numpy.ndarray
+        """
+        # pylint: disable=too-many-branches
+        shape = numpy.broadcast(*variables.values()).shape \
+            if variables else ()
+        values: Dict[int, NDArray[numpy.int64]] = {
+            VARIABLES[name]: numpy.broadcast_to(
+                numpy.clip(numpy.round(numpy.asarray(value) * _ONE),
+                           _INT32_MIN, _INT32_MAX).astype(numpy.int64),
+                shape)
+            for name, value in variables.items()}
+        stack: List[NDArray[numpy.int64]] = []
+        code = [int(word) for word in self.__code]
+        pos = 0
+        while pos < len(code):
+            op = code[pos]
+            pos += 1
+            if op == _Op.CONST:
+                value = code[pos]
+                if value > _INT32_MAX:
+                    value -= 1 << 32
+                stack.append(numpy.full(shape, value, dtype=numpy.int64))
+                pos += 1
+            elif op == _Op.VAR:
+                stack.append(values[code[pos]])
+                pos += 1
+            elif op == _Op.NEG:
+                stack[-1] = -stack[-1]
+            elif op == _Op.ABS:
+                stack[-1] = numpy.abs(stack[-1])
+            elif op == _Op.EXP:
+                a = stack[-1]
+                stack[-1] = numpy.where(
+                    a > _MAX_EXP, _INT32_MAX, numpy.round(numpy.exp(
+                        numpy.minimum(a, _MAX_EXP) / _ONE) * _ONE))
+            elif op == _Op.SQRT:
+                a = stack[-1]
+                stack[-1] = numpy.round(
+                    numpy.sqrt(numpy.maximum(a, 0) / _ONE) * _ONE)
+            else:
+                b = stack.pop()
+                a = stack[-1]
+                if op == _Op.ADD:
+                    stack[-1] = a + b
+                elif op == _Op.SUB:
+                    stack[-1] = a - b
+                elif op == _Op.MUL:
+                    stack[-1] = (a * b) >> _FRACTION_BITS
+                elif op == _Op.LT:
+                    stack[-1] = numpy.where(a < b, _ONE, 0)
+                elif op == _Op.LE:
+                    stack[-1] = numpy.where(a <= b, _ONE, 0)
+                elif op == _Op.MIN:
+                    stack[-1] = numpy.minimum(a, b)
+                else:
+                    stack[-1] = numpy.maximum(a, b)
+            stack[-1] = numpy.clip(
+                stack[-1], _INT32_MIN, _INT32_MAX).astype(numpy.int64)
+        return stack[-1] / _ONE
+
+    def matches_probabilities(
+            self, expected: NDArray[floating],
+            **variables: NDArray[floating]) -> bool:
+        """
+        Determine if the machine gets close enough to the probabilities
+        that Python does; values outside [0, 1] count as their nearest.
+
+        :param ~numpy.ndarray expected: The probabilities from Python
+        :param variables: The values of the variables they are from
+        :rtype: bool
+        """
+        actual = self.evaluate(**variables)
+        return bool(numpy.allclose(
+            numpy.clip(actual, 0.0, 1.0), numpy.clip(expected, 0.0, 1.0),
+            rtol=0.0, atol=PROBABILITY_TOLERANCE))
+
+
+def compile_expression(
+        expression: str,
+        variables: Sequence[str]) -> Optional[CompiledExpression]:
+    """
+    Compile an expression for the stack machine of the synapse expander.
+
+    :param str expression: The Python expression
+    :param list(str) variables:
+        The names of the variables the expression can use, from
+        :py:const:`VARIABLES`
+    :return: The compiled expression, or `None` if the expression uses
+        something that the machine can't do
+    :rtype: CompiledExpression or None
+    """
+    try:
+        tree = ast.parse(expression.strip(), mode="eval")
+        words, depth = _emit(_Compiler(variables).compile(tree))
+    except (SyntaxError, _Unsupported):
+        return None
+    if depth > MAX_STACK:
+        return None
+    return CompiledExpression(words)
@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 from __future__ import annotations
+from concurrent.futures import ThreadPoolExecutor
 import csv
 from datetime import datetime
 import logging
@@ -20,8 +21,8 @@ import os
 import re
 import struct
 from typing import (
-    Any, Collection, Dict, Iterable, List, Optional, Sequence, Tuple, Union,
-    TYPE_CHECKING)
+    Any, Callable, Collection, Dict, Iterable, Iterator, List, Optional,
+    Sequence, Tuple, TypeVar, Union, TYPE_CHECKING)
 
 import numpy
 from numpy import floating, integer, uint8, uint32
@@ -29,6 +30,7 @@ from numpy.typing import NDArray
 import quantities
 import neo  # type: ignore[import]
 
+from spinn_utilities.config_holder import get_config_int
 from spinn_utilities.log import FormatAdapter
 from spinnman.messages.eieio.data_messages import EIEIODataHeader
 
@@ -66,6 +68,31 @@ if TYPE_CHECKING:
 
 logger = FormatAdapter(logging.getLogger(__name__))
 
+#: :meta private:
+T = TypeVar("T")
+
+
+def _decode_regions(decode: Callable[..., T],
+                    regions: List[Tuple[Any, ...]]) -> List[T]:
+    """
+    Decode the data of each region, in threads if asked for.
+
+    The data must have been read from the database already, as the
+    connection to it can only be used by the thread that made it; the
+    decoding is mostly in numpy, which lets the other threads run.
+
+    :param callable decode: The function to decode one region with
+    :param list(tuple) regions: The arguments of each call to decode
+    :return: The decoded data of each region, in order
+    :rtype: list
+    """
+    n_threads = get_config_int("Simulation", "n_host_decode_threads")
+    if n_threads is None or n_threads <= 1 or len(regions) <= 1:
+        return [decode(*region) for region in regions]
+    with ThreadPoolExecutor(max_workers=n_threads) as executor:
+        futures = [executor.submit(decode, *region) for region in regions]
+        return [future.result() for future in futures]
+
 
 class NeoBufferDatabase(BufferDatabase, NeoCsv):
     """
@@ -531,82 +558,161 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
                        row["base_key"], index)
             index += 1
 
-    def __get_spikes_by_region(
-            self, region_id: int, neurons: NDArray[integer],
-            simulation_time_step_ms: float, selective_recording: bool,
-            spike_times: List[float], spike_ids: List[int]) -> None:
+    @staticmethod
+    def __unpack_bitfields(
+            bitfield_bytes: NDArray[uint8]) -> NDArray[uint8]:
         """
-        Adds spike data for this region to the lists.
+        Unpacks rows of little-endian 32-bit bitfield words into one value per
+        bit, in order of bit index.
 
-        :param int region_id: Region data came from
+        :param ~numpy.ndarray bitfield_bytes: 2D array of the bytes of the
+            words of each row
+        :return: 2D array of 0 or 1 for each bit of each row
+        :rtype: ~numpy.ndarray
+        """
+        return numpy.unpackbits(bitfield_bytes, axis=1, bitorder="little")
+
+    @classmethod
+    def __decode_spikes(
+            cls, record_raw: bytes, neurons: NDArray[integer],
+            simulation_time_step_ms: float,
+            window: Optional[Tuple[int, int]]) -> Optional[Tuple[
+                NDArray[integer], NDArray[floating]]]:
+        """
+        Decodes the spike data of a region.
+
+        :param bytes record_raw: The data read from the region
         :param array(int) neurons: mapping of local ID to global ID
         :param float simulation_time_step_ms:
-        :param bool selective_recording: flag to say if
-        :param list(float) spike_times: List to add spike times to
-        :param list(int) spike_ids: List to add spike IDs to
+        :param window:
+            First and past the last time step to include, or `None` for all
+        :type window: tuple(int, int) or None
+        :return: The spike IDs and times, or `None` if there are none
+        :rtype: tuple(~numpy.ndarray, ~numpy.ndarray) or None
         """
         neurons_recording = len(neurons)
-        if neurons_recording == 0:
-            return
         n_words = int(math.ceil(neurons_recording / BITS_PER_WORD))
-        n_bytes = n_words * BYTES_PER_WORD
-        n_words_with_timestamp = n_words + 1
+        n_bytes_with_timestamp = (n_words + 1) * BYTES_PER_WORD
 
-        record_raw = self._read_recording(region_id)
+        if len(record_raw) == 0:
+            return None
+
+        raw_data = numpy.asarray(record_raw, dtype=uint8).reshape(
+            [-1, n_bytes_with_timestamp])
+        record_steps = raw_data[:, :BYTES_PER_WORD].copy().view("<i4")[:, 0]
+        if window is not None:
+            # Only unpack the rows in the window
+            in_window = ((record_steps >= window[0]) &
+                         (record_steps < window[1]))
+            raw_data = raw_data[in_window]
+            record_steps = record_steps[in_window]
+        record_time = record_steps * simulation_time_step_ms
+        bits = cls.__unpack_bitfields(raw_data[:, BYTES_PER_WORD:])
+
+        # Bits past the neurons recording are used by those not recording
+        time_indices, local_indices = numpy.nonzero(
+            bits[:, :neurons_recording])
+        return neurons[local_indices], record_time[time_indices]
+
+    @classmethod
+    def __count_spikes(
+            cls, record_raw: bytes,
+            neurons: NDArray[integer]) -> NDArray[integer]:
+        """
+        Counts the spikes of each neuron in the spike data of a region,
+        without working out when they were.
 
+        :param bytes record_raw: The data read from the region
+        :param array(int) neurons: mapping of local ID to global ID
+        :return: The number of spikes of each neuron
+        :rtype: ~numpy.ndarray
+        """
+        neurons_recording = len(neurons)
         if len(record_raw) == 0:
-            return
+            return numpy.zeros(neurons_recording, dtype=numpy.int64)
+        n_words = int(math.ceil(neurons_recording / BITS_PER_WORD))
+        n_bytes_with_timestamp = (n_words + 1) * BYTES_PER_WORD
+        raw_data = numpy.asarray(record_raw, dtype=uint8).reshape(
+            [-1, n_bytes_with_timestamp])
+        bits = cls.__unpack_bitfields(raw_data[:, BYTES_PER_WORD:])
+        return bits[:, :neurons_recording].sum(axis=0, dtype=numpy.int64)
 
-        raw_data = (
-            numpy.asarray(record_raw, dtype=uint8).view(
-                dtype="<i4")).reshape([-1, n_words_with_timestamp])
-
-        record_time = (raw_data[:, 0] * simulation_time_step_ms)
-        spikes = raw_data[:, 1:].byteswap().view(uint8)
-        bits = numpy.fliplr(numpy.unpackbits(spikes).reshape(
-            (-1, 32))).reshape((-1, n_bytes * 8))
-        time_indices, local_indices = numpy.where(bits == 1)
-        if selective_recording:
-            for time_indice, local in zip(time_indices, local_indices):
-                if local < neurons_recording:
-                    spike_ids.append(neurons[local])
-                    spike_times.append(record_time[time_indice])
-        else:
-            indices = neurons[local_indices]
-            times = record_time[time_indices].reshape((-1))
-            spike_ids.extend(indices)
-            spike_times.extend(times)
+    def __count_neuron_spikes(
+            self, rec_id: int, view_indexes: Union[
+                Sequence[int], NDArray[integer]],
+            pop_size: int) -> NDArray[integer]:
+        """
+        Counts the spikes of each neuron for this population/recording ID.
 
-    def __get_neuron_spikes(self, rec_id: int) -> Tuple[
-            NDArray, List[int]]:
+        :param int rec_id:
+        :param list(int) view_indexes: The indexes to be counted
+        :param int pop_size:
+        :return: The number of spikes of each neuron of the population
+        :rtype: ~numpy.ndarray
+        """
+        counts = numpy.zeros(pop_size, dtype=numpy.int64)
+        indexes: List[int] = []
+        regions: List[Tuple[Any, ...]] = []
+        for region_id, neurons, _, selective_recording, _, _ in \
+                self.__get_region_metadata(rec_id):
+            if neurons is None or selective_recording is None:
+                continue
+            indexes.extend(neurons)
+            if len(neurons):
+                regions.append((self._read_recording(region_id), neurons))
+        for (_, neurons), region_counts in zip(
+                regions, _decode_regions(self.__count_spikes, regions)):
+            numpy.add.at(counts, neurons, region_counts)
+
+        # Warn about any in the view that are not recording
+        if list(view_indexes) != indexes:
+            self.__combine_indexes(view_indexes, indexes, SPIKES)
+        return counts
+
+    def __get_neuron_spikes(
+            self, rec_id: int, window: Optional[Tuple[int, int]]) -> Tuple[
+                NDArray, List[int]]:
         """
         Gets the spikes for this population/recording ID.
 
         :param int rec_id:
+        :param window:
+            First and past the last time step to include, or `None` for all
+        :type window: tuple(int, int) or None
         :return: numpy array of spike IDs and spike times, all IDs recording
         :rtype: tuple(~numpy.ndarray, list(int))
         """
-        spike_times: List[float] = []
-        spike_ids: List[int] = []
+        spike_times: List[NDArray[floating]] = []
+        spike_ids: List[NDArray[integer]] = []
         simulation_time_step_ms = self.__get_simulation_time_step_ms()
         indexes: List[int] = []
+        regions: List[Tuple[Any, ...]] = []
         for region_id, neurons, _, selective_recording, _, _ in \
                 self.__get_region_metadata(rec_id):
             if neurons is None or selective_recording is None:
                 continue
             indexes.extend(neurons)
-            self.__get_spikes_by_region(
-                region_id, neurons, simulation_time_step_ms,
-                selective_recording, spike_times, spike_ids)
-
-        result = numpy.column_stack((spike_ids, spike_times))
+            if len(neurons):
+                regions.append((
+                    self._read_recording(region_id), neurons,
+                    simulation_time_step_ms, window))
+        for decoded in _decode_regions(self.__decode_spikes, regions):
+            if decoded is not None:
+                spike_ids.append(decoded[0])
+                spike_times.append(decoded[1])
+
+        if not spike_ids:
+            return numpy.zeros((0, 2)), indexes
+        result = numpy.column_stack((
+            numpy.concatenate(spike_ids), numpy.concatenate(spike_times)))
         return result[numpy.lexsort(result.T[::-1])], indexes
 
     def __get_eieio_spike_by_region(
             self, region_id: int,
             simulation_time_step_ms: float, base_key: int,
             vertex_slice: Slice, n_colour_bits: int,
-            results: List[NDArray]) -> NDArray[integer]:
+            results: List[NDArray],
+            window: Optional[Tuple[int, int]]) -> NDArray[integer]:
         """
         Adds spike data for this region to the list.
 
@@ -616,6 +722,9 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
         :param ~pacman.model.graphs.common.Slice vertex_slice:
         :param int n_colour_bits:
         :param results: Where to add spike data to
+        :param window:
+            First and past the last time step to include, or `None` for all
+        :type window: tuple(int, int) or None
         :return: all recording indexes spikes or not
         :rtype: list(int)
         """
@@ -623,14 +732,19 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
 
         number_of_bytes_written = len(spike_data)
         offset = 0
-        indices = {
-            key: index for index, key in enumerate(
-                get_keys(base_key, vertex_slice, n_colour_bits))}
+        slice_keys = numpy.array(
+            list(get_keys(base_key, vertex_slice, n_colour_bits)),
+            dtype=uint32)
+        key_order = numpy.argsort(slice_keys)
+        sorted_keys = slice_keys[key_order]
         slice_ids = vertex_slice.get_raster_ids()
         colour_mask = (2 ** n_colour_bits) - 1
         inv_colour_mask = ~colour_mask & 0xFFFFFFFF
         while offset < number_of_bytes_written:
             length, time = self.__TWO_WORDS.unpack_from(spike_data, offset)
+            if window is not None and not window[0] <= time < window[1]:
+                offset += length + 2 * BYTES_PER_WORD
+                continue
             time *= simulation_time_step_ms
             data_offset = offset + 2 * BYTES_PER_WORD
 
@@ -646,7 +760,13 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
                 spike_data, dtype=f"<u{key_bytes}",
                 count=eieio_header.count, offset=data_offset).astype(uint32)
             keys = numpy.bitwise_and(keys, inv_colour_mask)
-            local_ids = numpy.array([indices[key] for key in keys])
+            positions = numpy.minimum(
+                numpy.searchsorted(sorted_keys, keys), len(sorted_keys) - 1)
+            if not numpy.array_equal(sorted_keys[positions], keys):
+                raise KeyError(
+                    f"Spike keys not from this vertex found in region "
+                    f"{region_id}")
+            local_ids = key_order[positions]
             neuron_ids = slice_ids[local_ids]
             offset += length + 2 * BYTES_PER_WORD
             results.append(numpy.dstack((neuron_ids, timestamps))[0])
@@ -654,13 +774,16 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
         return slice_ids
 
     def __get_eieio_spikes(
-            self, rec_id: int, n_colour_bits: int) -> Tuple[
-                NDArray, List[int]]:
+            self, rec_id: int, n_colour_bits: int,
+            window: Optional[Tuple[int, int]]) -> Tuple[NDArray, List[int]]:
         """
         Gets the spikes for this population/recording ID.
 
         :param int rec_id:
         :param int n_colour_bits:
+        :param window:
+            First and past the last time step to include, or `None` for all
+        :type window: tuple(int, int) or None
         :return: numpy array of spike IDs and spike times, all IDs recording
         :rtype: tuple(~numpy.ndarray, list(int))
         """
@@ -675,7 +798,7 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
                     "Unable to handle selective recording")
             indexes.extend(self.__get_eieio_spike_by_region(
                 region_id, simulation_time_step_ms,
-                base_key, vertex_slice, n_colour_bits, results))
+                base_key, vertex_slice, n_colour_bits, results, window))
 
         if not results:
             return numpy.empty(shape=(0, 2)), indexes
@@ -686,7 +809,8 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
             self, region_id: int, neurons: NDArray[integer],
             simulation_time_step_ms: float,
             spike_times: List[NDArray[floating]],
-            spike_ids: List[NDArray[integer]]):
+            spike_ids: List[NDArray[integer]],
+            window: Optional[Tuple[int, int]]):
         """
         Adds spike data for this region to the lists.
 
@@ -695,6 +819,9 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
         :param float simulation_time_step_ms:
         :param list(float) spike_times: List to add spike times to
         :param list(int) spike_ids: List to add spike IDs to
+        :param window:
+            First and past the last time step to include, or `None` for all
+        :type window: tuple(int, int) or None
         """
         raw_data = self._read_recording(region_id)
 
@@ -704,14 +831,16 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
         while offset < len(raw_data):
             time, n_blocks = self.__TWO_WORDS.unpack_from(raw_data, offset)
             offset += self.__TWO_WORDS.size
+            if window is not None and not window[0] <= time < window[1]:
+                offset += n_bytes_per_block * n_blocks
+                continue
             spike_data = numpy.frombuffer(
                 raw_data, dtype=uint8,
                 count=n_bytes_per_block * n_blocks, offset=offset)
             offset += n_bytes_per_block * n_blocks
 
-            spikes = spike_data.view("<i4").byteswap().view(uint8)
-            bits = numpy.fliplr(numpy.unpackbits(spikes).reshape(
-                (-1, 32))).reshape((-1, n_bytes_per_block * 8))
+            bits = self.__unpack_bitfields(
+                spike_data.reshape((-1, n_bytes_per_block)))
             local_indices = numpy.nonzero(bits)[1]
             indices = neurons[local_indices]
             times = numpy.repeat(
@@ -720,12 +849,16 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
             spike_ids.append(indices)
             spike_times.append(times)
 
-    def __get_multi_spikes(self, rec_id: int) -> Tuple[
-            NDArray, List[int]]:
+    def __get_multi_spikes(
+            self, rec_id: int, window: Optional[Tuple[int, int]]) -> Tuple[
+                NDArray, List[int]]:
         """
         Gets the spikes for this population/recording ID.
 
         :param int rec_id:
+        :param window:
+            First and past the last time step to include, or `None` for all
+        :type window: tuple(int, int) or None
         :return: numpy array of spike IDs and spike times, all IDs recording
         :rtype: tuple(~numpy.ndarray, list(int))
         """
@@ -742,7 +875,7 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
             indexes.extend(neurons)
             self.__get_multi_spikes_by_region(
                 region_id, neurons, simulation_time_step_ms,
-                spike_times_l, spike_ids_l)
+                spike_times_l, spike_ids_l, window)
 
         if not spike_ids_l:
             return numpy.zeros((0, 2)), indexes
@@ -765,20 +898,21 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
         :rtype: list
         """
         # keep just the view indexes in the data
-        data_set = set(data_indexes)
-        indexes = [i for i in view_indexes if i in data_set]
+        view_a = numpy.asarray(view_indexes)
+        data_a = numpy.asarray(data_indexes)
+        indexes = view_a[numpy.isin(view_a, data_a)]
         # check for missing and report
-        view_set = set(view_indexes)
-        missing = view_set.difference(data_indexes)
-        if missing:
+        missing = numpy.setdiff1d(view_a, data_a)
+        if len(missing):
             logger.warning("No {} available for neurons {}",
-                           variable, sorted(missing))
-        return numpy.array(indexes)
+                           variable, missing.tolist())
+        return indexes
 
     def __get_spikes(
             self, rec_id: int, view_indexes: ViewIndices,
             buffer_type: BufferDataType, n_colour_bits: int,
-            variable: str) -> Tuple[NDArray, NDArray[integer]]:
+            variable: str, window: Optional[Tuple[int, int]] = None) -> Tuple[
+                NDArray, NDArray[integer]]:
         """
         Gets the data as a Numpy array for one population and variable.
 
@@ -787,18 +921,21 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
         :param buffer_type:
         :param int n_colour_bits:
         :param str variable:
+        :param window:
+            First and past the last time step to include, or `None` for all
+        :type window: tuple(int, int) or None
         :raises \
             ~spinn_front_end_common.utilities.exceptions.ConfigurationException:
             If the recording metadata not setup correctly
         :rtype: tuple(~numpy.ndarray, list(int))
         """
         if buffer_type == BufferDataType.NEURON_SPIKES:
-            spikes, data_indexes = self.__get_neuron_spikes(rec_id)
+            spikes, data_indexes = self.__get_neuron_spikes(rec_id, window)
         elif buffer_type == BufferDataType.EIEIO_SPIKES:
             spikes, data_indexes = self.__get_eieio_spikes(
-                rec_id, n_colour_bits)
+                rec_id, n_colour_bits, window)
         elif buffer_type == BufferDataType.MULTI_SPIKES:
-            spikes, data_indexes = self.__get_multi_spikes(rec_id)
+            spikes, data_indexes = self.__get_multi_spikes(rec_id, window)
         else:
             raise NotImplementedError(buffer_type)
 
@@ -813,35 +950,39 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
 
         return spikes, indexes
 
-    def __get_matrix_data_by_region(
-            self, region_id: int, neurons: NDArray[integer],
-            data_type: DataType) -> Tuple[
+    @classmethod
+    def __decode_matrix_data(
+            cls, record_raw: bytes, neurons: NDArray[integer],
+            data_type: DataType, rows: Optional[Tuple[int, int]]) -> Tuple[
                 NDArray[floating], NDArray[floating]]:
         """
-        Extracts data for this region.
+        Decodes the matrix data of a region.
 
-        :param int region_id: Region data came from
+        :param bytes record_raw: The data read from the region
         :param array(int) neurons: mapping of local ID to global ID
         :param DataType data_type: type of data to extract
+        :param rows: First and past the last row to extract, or `None` for all
+        :type rows: tuple(int, int) or None
         :return: times, data
         :rtype: tuple(~numpy.ndarray, ~numpy.ndarray)
         """
-        # for buffering output info is taken form the buffer manager
-        record_raw = self._read_recording(region_id)
-        record_length = len(record_raw)
-
         # There is one column for time and one for each neuron recording
         data_row_length = len(neurons) * data_type.size
-        full_row_length = data_row_length + self.__N_BYTES_FOR_TIMESTAMP
+        full_row_length = data_row_length + cls.__N_BYTES_FOR_TIMESTAMP
+        if rows is not None:
+            # Only decode the bytes of the rows asked for
+            record_raw = record_raw[
+                rows[0] * full_row_length: rows[1] * full_row_length]
+        record_length = len(record_raw)
         n_rows = record_length // full_row_length
         row_data = numpy.asarray(record_raw, dtype=uint8).reshape(
             n_rows, full_row_length)
 
         time_bytes = (
-            row_data[:, 0: self.__N_BYTES_FOR_TIMESTAMP].reshape(
-                n_rows * self.__N_BYTES_FOR_TIMESTAMP))
+            row_data[:, 0: cls.__N_BYTES_FOR_TIMESTAMP].reshape(
+                n_rows * cls.__N_BYTES_FOR_TIMESTAMP))
         times = time_bytes.view("<i4").reshape(n_rows, 1)
-        var_data = (row_data[:, self.__N_BYTES_FOR_TIMESTAMP:].reshape(
+        var_data = (row_data[:, cls.__N_BYTES_FOR_TIMESTAMP:].reshape(
             n_rows * data_row_length))
         placement_data = data_type.decode_array(var_data).reshape(
             n_rows, len(neurons))
@@ -850,8 +991,9 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
 
     def __get_matrix_data(
             self, rec_id: int, data_type: DataType,
-            view_indexes: ViewIndices, pop_size: int,
-            variable: str) -> Tuple[NDArray[floating], NDArray[integer]]:
+            view_indexes: ViewIndices, pop_size: int, variable: str,
+            rows: Optional[Tuple[int, int]] = None) -> Tuple[
+                NDArray[floating], NDArray[integer]]:
         """
         Gets the matrix data  for this population/recording ID.
 
@@ -862,13 +1004,16 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
         :type view_indexes: list(int) or None
         :param int pop_size:
         :param str variable:
+        :param rows: First and past the last row to extract, or `None` for all
+        :type rows: tuple(int, int) or None
         :return: numpy array of the data, neurons
         :rtype: tuple(~numpy.ndarray, ~numpy.ndarray)
         """
-        signal_array: Optional[NDArray[floating]] = None
+        region_data: List[NDArray[floating]] = []
         pop_times: Optional[NDArray[floating]] = None
         pop_neurons: List[None] = []
         indexes: List[int] = []
+        regions: List[Tuple[Any, ...]] = []
 
         for region_id, neurons, _, _, _, index in \
                 self.__get_region_metadata(rec_id):
@@ -877,18 +1022,23 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
             else:
                 indexes.append(index)
                 neurons = numpy.array([index], dtype=integer)
-            times, data = self.__get_matrix_data_by_region(
-                region_id, neurons, data_type)
-            if signal_array is None or pop_times is None:
-                signal_array = data
+            regions.append((
+                self._read_recording(region_id), neurons, data_type, rows))
+        for times, data in _decode_regions(
+                self.__decode_matrix_data, regions):
+            if pop_times is None:
                 pop_times = times
-            elif numpy.array_equal(pop_times, times):
-                signal_array = numpy.append(
-                    signal_array, data, axis=1)
-            else:
+            elif not numpy.array_equal(pop_times, times):
                 raise NotImplementedError("times differ")
-        if signal_array is None:
+            region_data.append(data)
+
+        # Join the columns of all the regions in one go
+        if not region_data:
             signal_array = numpy.zeros((0,), dtype=floating)
+        elif len(region_data) == 1:
+            signal_array = region_data[0]
+        else:
+            signal_array = numpy.concatenate(region_data, axis=1)
 
         if len(indexes) > 0:
             assert (len(pop_neurons) == 0)
@@ -906,12 +1056,58 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
             # keep just the view indexes in the data
             indexes_a = self.__combine_indexes(
                 view_indexes, data_indexes, variable)
-            # keep just data columns in the view
-            map_indexes = [list(data_indexes).index(i) for i in indexes_a]
+            # keep just data columns in the view, finding the first column of
+            # each index
+            data_order = numpy.argsort(data_indexes, kind="stable")
+            map_indexes = data_order[numpy.searchsorted(
+                data_indexes[data_order], indexes_a)]
             signal_array = signal_array[:, map_indexes]
 
         return signal_array, indexes_a
 
+    def __get_moments(
+            self, rec_id: int, data_type: DataType) -> NDArray[floating]:
+        """
+        Gets the mean and variance of a variable over the population, from
+        those of the recording neurons of each core.
+
+        :param int rec_id:
+        :param DataType data_type: type of data to extract
+        :return: a row of the mean and variance of each sample
+        :rtype: ~numpy.ndarray
+        """
+        regions: List[Tuple[Any, ...]] = []
+        weights: List[int] = []
+        for region_id, neurons, _, _, _, _ in \
+                self.__get_region_metadata(rec_id):
+            weights.append(1 if neurons is None else len(neurons))
+            regions.append((
+                self._read_recording(region_id), numpy.arange(2), data_type,
+                None))
+        if not regions:
+            return numpy.zeros((0, 2), dtype=floating)
+
+        # The moments of each core are pooled, weighted by its neurons
+        pop_times = None
+        total = 0
+        sums = None
+        sums_sq = None
+        for (times, data), weight in zip(_decode_regions(
+                self.__decode_matrix_data, regions), weights):
+            if pop_times is None:
+                pop_times = times
+                sums = numpy.zeros(len(data))
+                sums_sq = numpy.zeros(len(data))
+            elif not numpy.array_equal(pop_times, times):
+                raise NotImplementedError("times differ")
+            mean = data[:, 0]
+            sums += weight * mean
+            sums_sq += weight * (data[:, 1] + mean * mean)
+            total += weight
+        pop_mean = sums / total
+        return numpy.column_stack(
+            (pop_mean, sums_sq / total - pop_mean * pop_mean))
+
     def __get_rewires_by_region(
             self, region_id: int, vertex_slice: Slice,
             rewire_values: List[int], rewire_postids: List[int],
@@ -1022,7 +1218,8 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
 
     def spinnaker_get_data(
             self, pop_label: str, variable: str, as_matrix: bool = False,
-            view_indexes: ViewIndices = None) -> NDArray[floating]:
+            view_indexes: ViewIndices = None,
+            mmap_file: Optional[str] = None) -> NDArray[floating]:
         """
         SsPyNNaker specific method for getting data as a numpy array,
         instead of the Neo-based object
@@ -1034,11 +1231,53 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
         :param view_indexes: The indexes for which data should be returned.
             If ``None``, all data (view_index = data_indexes)
         :type view_indexes: None or iter(int)
+        :param mmap_file: If given, the data is written to this ``.npy``
+            file and returned as a read-only memory map of it, so it can be
+            paged out of memory and reopened with ``numpy.load`` without
+            being extracted again
+        :type mmap_file: str or None
         :return: array of the data
         :rtype: ~numpy.ndarray
         :raises ConfigurationException:
             If variable is a list of a length other than 1
         """
+        return self.__to_mmap(self.__spinnaker_get_data(
+            pop_label, variable, as_matrix, view_indexes), mmap_file)
+
+    @staticmethod
+    def __to_mmap(data: NDArray, mmap_file: Optional[str]) -> NDArray:
+        """
+        Write data to a file and memory map it, if a file is given.
+
+        :param ~numpy.ndarray data: The data to write
+        :param mmap_file: The ``.npy`` file to write to, or `None`
+        :type mmap_file: str or None
+        :return: The memory map, or the data if there is no file
+        :rtype: ~numpy.ndarray
+        """
+        if mmap_file is None:
+            return data
+        out = numpy.lib.format.open_memmap(
+            mmap_file, mode="w+", dtype=data.dtype, shape=data.shape)
+        out[...] = data
+        out.flush()
+        del out
+        return numpy.load(mmap_file, mmap_mode="r")
+
+    def __spinnaker_get_data(
+            self, pop_label: str, variable: str, as_matrix: bool,
+            view_indexes: ViewIndices) -> NDArray[floating]:
+        """
+        Get data as a numpy array; see :py:meth:`spinnaker_get_data`.
+
+        :param str pop_label: label for the Population
+        :param variable: Single variable name.
+        :type variable: str or list(str)
+        :param as_matrix: If set True the data is returned as a 2d matrix
+        :param view_indexes: The indexes for which data should be returned.
+        :type view_indexes: None or iter(int)
+        :rtype: ~numpy.ndarray
+        """
         if not isinstance(variable, str):
             if len(variable) != 1:
                 raise ConfigurationException(
@@ -1055,6 +1294,17 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
             return self.__get_recorded_pynn7(
                 rec_id, data_type, sampling_interval_ms,
                 as_matrix, view_indexes, pop_size, variable)
+        if buffered_type == BufferDataType.MOMENTS:
+            assert data_type is not None
+            if view_indexes is not None:
+                raise SpynnakerException(
+                    f"{variable} is aggregated so can not be extracted using "
+                    "a view")
+            moments = self.__get_moments(rec_id, data_type)
+            if as_matrix:
+                return moments
+            times = numpy.arange(len(moments)) * sampling_interval_ms
+            return numpy.column_stack((times, moments))
         # NO BufferedDataType.REWIRES get_spike will go boom
         else:
             if as_matrix:
@@ -1063,6 +1313,255 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
                 rec_id, view_indexes, buffered_type,
                 n_colour_bits, variable)[0]
 
+    def __iter_windows(self, chunk_ms: float) -> Iterator[Tuple[int, int]]:
+        """
+        Splits the recorded time into windows of whole time steps.
+
+        :param float chunk_ms: The length of each window, in ms
+        :return: The first and past the last time step of each window
+        :rtype: iterable(tuple(int, int))
+        :raises ConfigurationException: If chunk_ms is not positive
+        """
+        if chunk_ms <= 0:
+            raise ConfigurationException(
+                f"chunk_ms must be positive, not {chunk_ms}")
+        _, _, t_stop, _, _ = self.__get_segment_info()
+        time_step_ms = self.__get_simulation_time_step_ms()
+        chunk_steps = max(1, int(round(chunk_ms / time_step_ms)))
+        last_step = int(round(t_stop / time_step_ms))
+        for first in range(0, last_step, chunk_steps):
+            yield first, min(first + chunk_steps, last_step)
+
+    def __window_rows(
+            self, window: Tuple[int, int], t_start: float,
+            sampling_interval_ms: float) -> Tuple[int, int]:
+        """
+        Finds the rows of matrix data that were sampled in a window.
+
+        :param tuple(int, int) window:
+            First and past the last time step of the window
+        :param float t_start: The time the first row was sampled, in ms
+        :param float sampling_interval_ms: The time between rows, in ms
+        :return: First and past the last row in the window
+        :rtype: tuple(int, int)
+        """
+        time_step_ms = self.__get_simulation_time_step_ms()
+        first_step = int(round(t_start / time_step_ms))
+        steps_per_row = max(1, int(round(
+            sampling_interval_ms / time_step_ms)))
+        # Rounded up, as a row is in the window if it starts in it
+        return tuple(
+            max(0, -((first_step - step) // steps_per_row))
+            for step in window)  # type: ignore[return-value]
+
+    def iter_spinnaker_data(
+            self, pop_label: str, variable: str, chunk_ms: float,
+            view_indexes: ViewIndices = None) -> Iterator[
+                Tuple[float, float, NDArray[floating]]]:
+        """
+        Iterates over the data of one variable in windows of simulation
+        time, so a long recording never has to be held in memory at once.
+
+        Each window is only read from the database when it is asked for.
+        Spikes are given as ``(id, time)`` rows, as
+        :py:meth:`spinnaker_get_data` gives them; any other variable is
+        given as a matrix with a row for each sample in the window.
+
+        .. note::
+            The data of each core is read again for each window, so larger
+            windows take less time in total but more memory each.
+
+        :param str pop_label: label for the Population
+        :param str variable: Single variable name.
+        :param float chunk_ms:
+            The length of each window, in ms, rounded to whole time steps
+        :param view_indexes: The indexes for which data should be returned.
+            If ``None``, all data (view_index = data_indexes)
+        :type view_indexes: None or iter(int)
+        :return: The start and end time of each window and its data
+        :rtype: iterable(tuple(float, float, ~numpy.ndarray))
+        :raises ConfigurationException: If chunk_ms is not positive
+        :raises SpynnakerException: If the variable is rewires
+        """
+        (rec_id, data_type, buffered_type, t_start, sampling_interval_ms,
+         pop_size, _, n_colour_bits) = \
+            self.__get_recording_metadata(pop_label, variable)
+        if buffered_type in (BufferDataType.REWIRES, BufferDataType.MOMENTS):
+            raise SpynnakerException(
+                f"{variable} can not be extracted in windows")
+        time_step_ms = self.__get_simulation_time_step_ms()
+        for window in self.__iter_windows(chunk_ms):
+            if buffered_type == BufferDataType.MATRIX:
+                assert data_type is not None
+                data, _ = self.__get_matrix_data(
+                    rec_id, data_type, view_indexes, pop_size, variable,
+                    self.__window_rows(
+                        window, t_start, sampling_interval_ms))
+            else:
+                data, _ = self.__get_spikes(
+                    rec_id, view_indexes, buffered_type, n_colour_bits,
+                    variable, window)
+            yield window[0] * time_step_ms, window[1] * time_step_ms, data
+
+    def iter_segments(
+            self, pop_label: str, variables: Names, chunk_ms: float,
+            view_indexes: ViewIndices = None,
+            annotations: Annotations = None) -> Iterator[neo.Segment]:
+        """
+        Iterates over the data of this segment in windows of simulation
+        time, giving each window as the only segment of a block of its own.
+
+        Each window is only read from the database when it is asked for,
+        so a consumer that drops each segment once done with it only ever
+        holds one window of data.
+
+        :param str pop_label: The label for the population of interest
+
+            .. note::
+                This is actually the label of the Application Vertex.
+                Typically the Population label, corrected for `None` or
+                duplicate values
+
+        :param variables:
+            One or more variable names or `None` for all available
+        :type variables: str, list(str) or None
+        :param float chunk_ms:
+            The length of each window, in ms, rounded to whole time steps
+        :param view_indexes: List of neurons IDs to include or `None` for all
+        :type view_indexes: None or list(int)
+        :param annotations: annotations to put on each neo block
+        :type annotations: None or dict(str, ...)
+        :return: A segment for each window
+        :rtype: iterable(~neo.core.Segment)
+        :raises \
+            ~spinn_front_end_common.utilities.exceptions.ConfigurationException:
+            If the recording metadata not setup correctly
+        """
+        segment_number, rec_datetime, _, _, _ = self.__get_segment_info()
+        variables_t = self.__clean_variables(variables, pop_label)
+        time_step_ms = self.__get_simulation_time_step_ms()
+        for window in self.__iter_windows(chunk_ms):
+            block = self.__get_empty_block(pop_label, annotations)
+            segment = self._insert_empty_segment(
+                block, segment_number, rec_datetime)
+            for variable in variables_t:
+                self.__add_data(
+                    pop_label, variable, segment, view_indexes,
+                    window[1] * time_step_ms, window)
+            yield segment
+
+    def export_parquet(
+            self, directory: str, pop_label: str, variables: Names = None,
+            chunk_ms: Optional[float] = None,
+            view_indexes: ViewIndices = None) -> List[str]:
+        """
+        Writes the data of a population straight to Parquet files, one for
+        each variable, without making any Neo objects.
+
+        Spikes are written as an ``index`` and a ``time`` column.  Any
+        other variable is written as a ``time`` column and a column for
+        each neuron, named by its index, with a row for each sample.  The
+        units and sampling interval are kept in the metadata of the file.
+
+        .. note::
+            This needs ``pyarrow``, which is installed with the ``parquet``
+            extra of sPyNNaker.  Rewires are not exported.
+
+        :param str directory: The directory to write the files to
+        :param str pop_label: The label for the population of interest
+        :param variables:
+            One or more variable names or `None` for all available
+        :type variables: str, list(str) or None
+        :param chunk_ms:
+            If given, the data is read and written in windows of this many
+            ms, each as a row group of its own, so a long recording never
+            has to be held in memory at once
+        :type chunk_ms: float or None
+        :param view_indexes: List of neurons IDs to include or `None` for all
+        :type view_indexes: None or list(int)
+        :return: The paths of the files written
+        :rtype: list(str)
+        :raises SpynnakerException: If pyarrow is not installed
+        """
+        try:
+            # pylint: disable=import-outside-toplevel
+            import pyarrow  # type: ignore[import]
+            import pyarrow.parquet  # type: ignore[import]
+        except ImportError as e:
+            raise SpynnakerException(
+                "pyarrow must be installed to export to Parquet") from e
+
+        # called to trigger the virtual data warning if applicable
+        self.__get_segment_info()
+        windows: List[Optional[Tuple[int, int]]] = [None]
+        if chunk_ms is not None:
+            windows = list(self.__iter_windows(chunk_ms))
+        paths = list()
+        for variable in self.__clean_variables(variables, pop_label):
+            (rec_id, data_type, buffered_type, t_start, sampling_interval_ms,
+             pop_size, units, n_colour_bits) = \
+                self.__get_recording_metadata(pop_label, variable)
+            if buffered_type in (
+                    BufferDataType.REWIRES, BufferDataType.MOMENTS):
+                logger.warning("{} can not be exported to Parquet", variable)
+                continue
+            metadata = {"units": units or "",
+                        "sampling_interval_ms": str(sampling_interval_ms)}
+            path = os.path.join(directory, f"{pop_label}_{variable}.parquet")
+            writer = None
+            try:
+                for window in windows:
+                    if buffered_type == BufferDataType.MATRIX:
+                        assert data_type is not None
+                        columns = self.__matrix_columns(
+                            rec_id, data_type, view_indexes, pop_size,
+                            variable, window, t_start, sampling_interval_ms)
+                    else:
+                        spikes, _ = self.__get_spikes(
+                            rec_id, view_indexes, buffered_type,
+                            n_colour_bits, variable, window)
+                        columns = {
+                            "index": spikes[:, 0].astype(numpy.int64),
+                            "time": spikes[:, 1]}
+                    table = pyarrow.table(columns, metadata=metadata)
+                    if writer is None:
+                        writer = pyarrow.parquet.ParquetWriter(
+                            path, table.schema)
+                    writer.write_table(table)
+            finally:
+                if writer is not None:
+                    writer.close()
+            if writer is not None:
+                paths.append(path)
+        return paths
+
+    def __matrix_columns(
+            self, rec_id: int, data_type: DataType,
+            view_indexes: ViewIndices, pop_size: int, variable: str,
+            window: Optional[Tuple[int, int]], t_start: float,
+            sampling_interval_ms: float) -> Dict[str, NDArray]:
+        """
+        Gets the matrix data of a window as a time column and a column for
+        each neuron.
+
+        :param window:
+            First and past the last time step of the window, or `None` for
+            all of the data
+        :type window: tuple(int, int) or None
+        :rtype: dict(str, ~numpy.ndarray)
+        """
+        rows = None
+        if window is not None:
+            rows = self.__window_rows(window, t_start, sampling_interval_ms)
+        data, indexes = self.__get_matrix_data(
+            rec_id, data_type, view_indexes, pop_size, variable, rows)
+        first_row = 0 if rows is None else rows[0]
+        columns = {"time": t_start + sampling_interval_ms * numpy.arange(
+            first_row, first_row + len(data), dtype=numpy.float64)}
+        for column, index in enumerate(indexes):
+            columns[str(index)] = data[:, column]
+        return columns
+
     def get_spike_counts(
             self, pop_label: str,
             view_indexes: ViewIndices = None) -> Dict[int, int]:
@@ -1077,11 +1576,29 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
         """
         # called to trigger the virtual data warning if applicable
         self.__get_segment_info()
-        (rec_id, _, buffered_type, _, _, pop_size, _, n_colour_bits) = \
-            self.__get_recording_metadata(pop_label, SPIKES)
+        (rec_id, data_type, buffered_type, _, _, pop_size, _,
+         n_colour_bits) = self.__get_recording_metadata(pop_label, SPIKES)
         if view_indexes is None:
             view_indexes = range(pop_size)
 
+        # Spikes recorded as bit fields can be counted without decoding
+        # when they happened
+        if buffered_type == BufferDataType.NEURON_SPIKES:
+            counts = self.__count_neuron_spikes(
+                rec_id, view_indexes, pop_size)
+            return {i: counts[i] for i in view_indexes}
+
+        # Spikes counted on the cores are summed over the windows
+        if buffered_type == BufferDataType.MATRIX:
+            assert data_type is not None
+            data, indexes = self.__get_matrix_data(
+                rec_id, data_type, view_indexes, pop_size, SPIKES)
+            sums = numpy.sum(data, axis=0) if len(data) else numpy.zeros(
+                len(indexes))
+            counts = numpy.zeros(pop_size, dtype=numpy.int64)
+            counts[indexes] = sums.astype(numpy.int64)
+            return {i: counts[i] for i in view_indexes}
+
         # get_spike will go boom if buffered_type not spikes
         spikes = self.__get_spikes(
             rec_id, view_indexes, buffered_type,
@@ -1092,7 +1609,8 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
 
     def __add_data(
             self, pop_label: str, variable: str,
-            segment: neo.Segment, view_indexes: ViewIndices, t_stop: float):
+            segment: neo.Segment, view_indexes: ViewIndices, t_stop: float,
+            window: Optional[Tuple[int, int]] = None):
         """
         Gets the data as a Numpy array for one population and variable.
 
@@ -1106,6 +1624,9 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
         :param str variable:
         :param ~neo.core.Segment segment: Segment to add data to
         :param float t_stop:
+        :param window:
+            First and past the last time step to add, or `None` for all
+        :type window: tuple(int, int) or None
         :raises \
             ~spinn_front_end_common.utilities.exceptions.ConfigurationException:
             If the recording metadata not setup correctly
@@ -1116,26 +1637,57 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
 
         if buffer_type == BufferDataType.MATRIX:
             assert data_type is not None
+            rows = None
+            if window is not None:
+                rows = self.__window_rows(
+                    window, t_start, sampling_interval_ms)
+                t_start += rows[0] * sampling_interval_ms
             signal_array, indexes = self.__get_matrix_data(
-                rec_id, data_type, view_indexes, pop_size, variable)
+                rec_id, data_type, view_indexes, pop_size, variable, rows)
             sampling_rate = 1000/sampling_interval_ms * quantities.Hz
             t_start = t_start * quantities.ms
             self._insert_matrix_data(
                 variable, segment, signal_array,
                 indexes, t_start, sampling_rate, units)
+        elif buffer_type == BufferDataType.MOMENTS:
+            assert data_type is not None
+            if view_indexes is not None:
+                raise SpynnakerException(
+                    f"{variable} is aggregated so can not be extracted using "
+                    "a view")
+            signal_array = self.__get_moments(rec_id, data_type)
+            if window is not None:
+                rows = self.__window_rows(
+                    window, t_start, sampling_interval_ms)
+                signal_array = signal_array[rows[0]:rows[1]]
+                t_start += rows[0] * sampling_interval_ms
+            self._insert_moments_data(
+                variable, segment, signal_array, t_start * quantities.ms,
+                1000 / sampling_interval_ms * quantities.Hz, units)
         elif buffer_type == BufferDataType.REWIRES:
             if view_indexes is not None:
                 raise SpynnakerException(
                     f"{variable} can not be extracted using a view")
             event_array = self.__get_rewires(
                 rec_id, sampling_interval_ms)
+            if window is not None:
+                # Rewires are few, so are filtered once read
+                time_step_ms = self.__get_simulation_time_step_ms()
+                times = event_array[:, 0]
+                event_array = event_array[
+                    (times >= window[0] * time_step_ms) &
+                    (times < window[1] * time_step_ms)]
             self._insert_neo_rewirings(segment, event_array, variable)
         else:
             if view_indexes is None:
                 view_indexes = range(pop_size)
             spikes, indexes = self.__get_spikes(
                 rec_id, view_indexes, buffer_type,
-                n_colour_bits, variable)
+                n_colour_bits, variable, window)
+            if window is not None:
+                t_start = max(
+                    t_start,
+                    window[0] * self.__get_simulation_time_step_ms())
             sampling_rate = 1000 / sampling_interval_ms * quantities.Hz
             self._insert_spike_data(
                 view_indexes, segment, spikes, t_start, t_stop,
@@ -1172,6 +1724,9 @@ class NeoBufferDatabase(BufferDatabase, NeoCsv):
             signal_array, indexes = self.__get_matrix_data(
                 rec_id, data_type, view_indexes, pop_size, variable)
             self._csv_matrix_data(csv_writer, signal_array, indexes)
+        elif buffer_type == BufferDataType.MOMENTS:
+            raise SpynnakerException(
+                f"{variable} is aggregated so can not be written to CSV")
         elif buffer_type == BufferDataType.REWIRES:
             self._csv_variable_metdata(
                 csv_writer, self._EVENT, variable, t_start, t_stop,
@@ -293,6 +293,34 @@ class NeoCsv(object):
         data_array.shape = (data_array.shape[0], data_array.shape[1])
         segment.analogsignals.append(data_array)
 
+    def _insert_moments_data(
+            self, variable: str, segment: Segment, signal_array: NDArray,
+            t_start: float, sampling_rate: Quantity,
+            units: Union[Quantity, str, None]):
+        """
+        Adds the mean and variance of a variable over a population to a neo
+        segment, as an analog signal with a channel for each.
+
+        :param str variable: the variable name
+        :param ~neo.core.Segment segment: Segment to add data to
+        :param ~numpy.ndarray signal_array: the mean and variance columns
+        :type t_start: float or int
+        :param ~quantities.Quantity sampling_rate: Rate a neuron is recorded
+        :param units: the units of the recorded value
+        :type units: quantities.quantity.Quantity or str
+        """
+        if units is None:
+            units = "dimensionless"
+        data_array = AnalogSignal(
+            signal_array,
+            units=units,
+            t_start=t_start,
+            sampling_rate=sampling_rate,
+            name=variable,
+            source_population=segment.block.name,
+            channel_names=["mean", "variance"])
+        segment.analogsignals.append(data_array)
+
     def _csv_matrix_data(
             self, csv_writer: CSVWriter, signal_array: NDArray,
             indexes: NDArray[integer]):
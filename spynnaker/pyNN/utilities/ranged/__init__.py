@@ -12,5 +12,6 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
-from .spynnaker_ranged_list import SpynnakerRangedList
-__all__ = ["SpynnakerRangedList"]
+from .spynnaker_ranged_list import (
+    SpynnakerRangedList, set_values_by_ids, values_as_array)
+__all__ = ["SpynnakerRangedList", "set_values_by_ids", "values_as_array"]
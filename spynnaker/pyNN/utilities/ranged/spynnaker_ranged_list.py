@@ -13,11 +13,14 @@
 # limitations under the License.
 
 from typing import Callable, List, Optional, Sequence, Union
+import numpy
+from numpy import floating, integer
+from numpy.typing import NDArray
 from typing_extensions import TypeAlias
 from pyNN.random import RandomDistribution
 from spinn_utilities.overrides import overrides
 from spinn_utilities.ranged.ranged_list import RangedList
-from spinn_utilities.ranged.abstract_list import IdsType, T
+from spinn_utilities.ranged.abstract_list import AbstractList, IdsType, T
 
 # The type of things we consider to be a list of values
 _ListType: TypeAlias = Union[Callable[[int], T], Sequence[T],
@@ -47,3 +50,62 @@ class SpynnakerRangedList(RangedList):
             return value.next(n=size)
 
         return super().as_list(value, size, ids)
+
+
+def values_as_array(
+        values: AbstractList[float],
+        ids: Optional[IdsType] = None) -> NDArray[floating]:
+    """
+    Get the values of a list as an array, filling each range at once
+    rather than each value in turn.
+
+    Any random distribution in the list is drawn from here, once for each
+    of its ids.
+
+    :param ~spinn_utilities.ranged.AbstractList values: The list to read
+    :param ids: The ids to get the values of, or `None` for all
+    :type ids: None or iterable(int)
+    :rtype: ~numpy.ndarray
+    """
+    if ids is None:
+        ids = range(len(values))
+    result = numpy.empty(len(ids), dtype=floating)
+    pos = 0
+    for start, stop, value in values.iter_ranges_by_ids(ids):
+        n_values = stop - start
+        if isinstance(value, RandomDistribution):
+            result[pos:pos + n_values] = value.next(n_values)
+        else:
+            result[pos:pos + n_values] = value
+        pos += n_values
+    return result
+
+
+def set_values_by_ids(
+        values: AbstractList[float], ids: NDArray[integer],
+        new_values: NDArray[floating]):
+    """
+    Set the values of some ids of a list from an array at once.
+
+    The list is replaced by one with a value for each id, which takes time
+    in proportion to the length of the list, where setting each id in turn
+    can take time in proportion to its square.  If any other id has a
+    random distribution not yet drawn, the ids are set in turn instead, so
+    that it stays undrawn.
+
+    :param ~spinn_utilities.ranged.AbstractList values: The list to update
+    :param ~numpy.ndarray ids: The ids to set
+    :param ~numpy.ndarray new_values: The value of each id
+    """
+    n_values = len(values)
+    others = numpy.ones(n_values, dtype=bool)
+    others[ids] = False
+    if any(isinstance(value, RandomDistribution)
+           for _, _, value in values.iter_ranges_by_ids(
+               numpy.flatnonzero(others))):
+        values.set_value_by_ids(ids, new_values)
+        return
+    all_values = values_as_array(values) if others.any() else numpy.empty(
+        n_values, dtype=floating)
+    all_values[ids] = new_values
+    values.set_value(all_values.tolist())
@@ -18,7 +18,6 @@ from typing import Any, Dict, List, Mapping, Optional, Sequence, Tuple, Union
 import numpy
 from numpy import uint8, uint32, integer
 from numpy.typing import NDArray
-from pyNN.random import RandomDistribution
 from typing_extensions import TypeAlias
 
 from spinn_utilities.helpful_functions import is_singleton
@@ -30,7 +29,10 @@ from pacman.model.graphs.common import Slice
 from spinn_front_end_common.interface.ds import DataType
 from spinn_front_end_common.utilities.constants import BYTES_PER_WORD
 
-from spynnaker.pyNN.utilities.utility_calls import convert_to
+from spynnaker.pyNN.utilities.ranged import (
+    set_values_by_ids, values_as_array)
+from spynnaker.pyNN.utilities.utility_calls import (
+    convert_array_to, convert_to)
 from spynnaker.pyNN.models.common.param_generator_data import (
     get_generator_type, param_generator_id, param_generator_params,
     type_has_generator)
@@ -193,21 +195,11 @@ class Struct(object):
         """
         Get the data for a single value from a vertex slice.
         """
-        # If there is a list of values, convert it
-        ids = vertex_slice.get_raster_ids()
-        data_pos = 0
-        for start, stop, value in all_vals.iter_ranges_by_ids(ids):
-            # Get the values and convert to the correct data type
-            n_values = stop - start
-            if isinstance(value, RandomDistribution):
-                r_vals = value.next(n_values)
-                data[name][data_pos:data_pos + n_values] = [
-                    convert_to(v, data_type) for v in r_vals]
-            else:
-                data[name][data_pos:data_pos + n_values] = convert_to(
-                    value, data_type)
-
-            data_pos += n_values
+        # Get all the values at once, drawing any random ones, and convert
+        # them together rather than one at a time
+        data[name] = convert_array_to(
+            values_as_array(all_vals, vertex_slice.get_raster_ids()),
+            data_type)
 
     def get_generator_data(
             self, values: ValueMap,
@@ -397,4 +389,4 @@ class Struct(object):
                 if self.__repeat_type == StructRepeat.GLOBAL:
                     values[name] = value[0]
                 else:
-                    values[name].set_value_by_ids(ids, value)
+                    set_values_by_ids(values[name], ids, value)
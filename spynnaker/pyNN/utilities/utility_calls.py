@@ -131,6 +131,21 @@ def convert_to(value, data_type: DataType) -> uint32:
         data_type.struct_encoding)
 
 
+def convert_array_to(values: NDArray, data_type: DataType) -> NDArray:
+    """
+    Convert an array of values to a given data type all at once.
+
+    :param ~numpy.ndarray values: The values to convert
+    :param ~data_specification.enums.DataType data_type:
+        The data type to convert to
+    :return: The converted data
+    :rtype: ~numpy.ndarray
+    """
+    return data_type.encode_as_numpy_int_array(
+        numpy.asarray(values, dtype=floating)).astype(
+            data_type.struct_encoding)
+
+
 def read_in_data_from_file(
         file_path: str, min_atom: int, max_atom: int,
         min_time: float, max_time: float, extra: bool = False) -> NDArray:
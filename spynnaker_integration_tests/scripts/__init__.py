@@ -16,6 +16,11 @@ from .checker import check_data, check_neuron_data
 from .pattern_spiker import PatternSpiker
 from .synfire_npop_run import do_synfire_npop
 from .synfire_runner import SynfireRunner
+from .synaptic_throughput import (
+    BINARIES, ThroughputBinary, ThroughputResult, max_sustainable,
+    report_throughput, run_throughput, sweep_throughput)
 
-__all__ = ["check_data", "check_neuron_data", "do_synfire_npop",
-           "PatternSpiker", "SynfireRunner"]
+__all__ = ["BINARIES", "check_data", "check_neuron_data", "do_synfire_npop",
+           "max_sustainable", "PatternSpiker", "report_throughput",
+           "run_throughput", "SynfireRunner", "sweep_throughput",
+           "ThroughputBinary", "ThroughputResult"]
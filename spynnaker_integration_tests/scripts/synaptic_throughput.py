@@ -0,0 +1,257 @@
+# Copyright (c) 2026 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Synaptic event throughput benchmark.
+
+Drives a single target population from Poisson sources with fixed
+connectivity, sweeping the input rate, and reads the provenance counters of
+the target cores to find the highest rate each binary sustains in real time.
+"""
+import sys
+from typing import Callable, Dict, Iterable, List, NamedTuple, Optional
+import pyNN.spiNNaker as sim
+from spinn_front_end_common.interface.provenance import ProvenanceReader
+from spynnaker.pyNN.extra_algorithms.splitter_components import (
+    SplitterAbstractPopulationVertexNeuronsSynapses)
+from spynnaker.pyNN.models.neuron import (
+    PopulationMachineVertex, PopulationSynapsesMachineVertexCommon)
+from spynnaker.pyNN.models.neuron.population_machine_synapses_provenance \
+    import PopulationMachineSynapsesProvenance
+
+#: Rates (Hz per source) swept by default
+DEFAULT_RATES = (5.0, 10.0, 20.0, 40.0, 80.0, 160.0)
+
+
+class ThroughputBinary(NamedTuple):
+    """
+    How to build a target population that runs one of the neuron binaries.
+    """
+    #: The binary name as in makefiles/neuron or makefiles/synapse_only
+    name: str
+    #: Makes the cell type of the target
+    cell: Callable[[], object]
+    #: Makes the synapse type of the projection
+    synapse: Callable[[], object]
+    #: The number of synapse cores, or None for combined neuron and synapses
+    n_synapse_cores: Optional[int] = None
+
+
+def _stdp_pair_additive():
+    return sim.STDPMechanism(
+        timing_dependence=sim.SpikePairRule(
+            tau_plus=20.0, tau_minus=20.0, A_plus=0.01, A_minus=0.012),
+        weight_dependence=sim.AdditiveWeightDependence(w_min=0, w_max=0.1),
+        weight=0.01, delay=1.0)
+
+
+def _static():
+    return sim.StaticSynapse(weight=0.01, delay=1.0)
+
+
+#: The binaries measured by default
+BINARIES = (
+    ThroughputBinary("IF_curr_exp", sim.IF_curr_exp, _static),
+    ThroughputBinary("IF_cond_exp", sim.IF_cond_exp, _static),
+    ThroughputBinary(
+        "IF_curr_exp_stdp_mad_pair_additive", sim.IF_curr_exp,
+        _stdp_pair_additive),
+    ThroughputBinary("synapses", sim.IF_curr_exp, _static, 1),
+    ThroughputBinary(
+        "synapses_stdp_mad_pair_additive", sim.IF_curr_exp,
+        _stdp_pair_additive, 1))
+
+
+class ThroughputResult(NamedTuple):
+    """
+    The provenance of the target cores for one rate of one binary.
+    """
+    #: The rate of each source in Hz
+    rate: float
+    #: Synaptic events processed per second per core
+    events_per_second: float
+    #: Late spikes over all target cores
+    late_spikes: int
+    #: Input packets lost over all target cores
+    lost_packets: int
+    #: Transfer timer overruns over all synapse cores
+    transfer_overruns: int
+    #: Highest spikes processed in a time step by any synapse core
+    max_spikes_processed: int
+
+    @property
+    def sustainable(self) -> bool:
+        """
+        Whether the cores kept up with the input at this rate.
+        """
+        return (self.late_spikes == 0 and self.lost_packets == 0 and
+                self.transfer_overruns == 0)
+
+
+def _sum_provenance(db: ProvenanceReader, description: str) -> int:
+    total = 0
+    for row in db.run_query(
+            "SELECT SUM(total) FROM core_stats_view WHERE description = ?",
+            [description]):
+        total = int(row[0] or 0)
+    return total
+
+
+def _max_provenance(db: ProvenanceReader, description: str) -> int:
+    highest = 0
+    for row in db.run_query(
+            "SELECT MAX(total) FROM core_stats_view WHERE description = ?",
+            [description]):
+        highest = int(row[0] or 0)
+    return highest
+
+
+def _count_cores(db: ProvenanceReader, description: str) -> int:
+    n_cores = 0
+    for row in db.run_query(
+            "SELECT COUNT(*) FROM core_stats_view WHERE description = ?",
+            [description]):
+        n_cores = int(row[0] or 0)
+    return n_cores
+
+
+def run_throughput(
+        binary: ThroughputBinary, rate: float, n_sources: int = 1000,
+        n_targets: int = 256, fan_in: int = 100, run_time: float = 1000.0,
+        seed: int = 1) -> ThroughputResult:
+    """
+    Run the target of one binary at one input rate in real time.
+
+    :param ThroughputBinary binary: The binary to measure
+    :param float rate: The rate of each Poisson source in Hz
+    :param int n_sources: The number of Poisson sources
+    :param int n_targets: The number of target neurons, all on one core
+    :param int fan_in: The number of sources connected to each target
+    :param float run_time: How long to run for in ms
+    :param int seed: Seeds the sources and the connectivity
+    :rtype: ThroughputResult
+    """
+    sim.setup(1.0, time_scale_factor=1)
+    sim.set_number_of_neurons_per_core(binary.cell, n_targets)
+    sources = sim.Population(
+        n_sources, sim.SpikeSourcePoisson(rate=rate),
+        additional_parameters={"seed": seed}, label="sources")
+    additional = {}
+    if binary.n_synapse_cores is not None:
+        additional["splitter"] = \
+            SplitterAbstractPopulationVertexNeuronsSynapses(
+                binary.n_synapse_cores)
+    target = sim.Population(
+        n_targets, binary.cell(), additional_parameters=additional,
+        label="target")
+    sim.Projection(
+        sources, target,
+        sim.FixedNumberPreConnector(fan_in, rng=sim.NumpyRNG(seed=seed)),
+        binary.synapse())
+    sim.run(run_time)
+
+    # The combined and synapse-only cores use the same names for these
+    events_name = PopulationMachineSynapsesProvenance.\
+        TOTAL_PRE_SYNAPTIC_EVENT_NAME
+    with ProvenanceReader() as db:
+        n_cores = max(_count_cores(db, events_name), 1)
+        events = _sum_provenance(db, events_name)
+        result = ThroughputResult(
+            rate=rate,
+            events_per_second=events * 1000.0 / (run_time * n_cores),
+            late_spikes=_sum_provenance(
+                db, PopulationMachineVertex.N_LATE_SPIKES_NAME),
+            lost_packets=_sum_provenance(
+                db, PopulationMachineVertex.INPUT_BUFFER_FULL_NAME),
+            transfer_overruns=_sum_provenance(
+                db, PopulationSynapsesMachineVertexCommon.
+                N_TRANSFER_TIMER_OVERRUNS),
+            max_spikes_processed=_max_provenance(
+                db, PopulationSynapsesMachineVertexCommon.
+                MAX_SPIKES_PROCESSED))
+    sim.end()
+    return result
+
+
+def sweep_throughput(
+        binary: ThroughputBinary, rates: Iterable[float] = DEFAULT_RATES,
+        **kwargs) -> List[ThroughputResult]:
+    """
+    Run one binary at increasing rates until it stops keeping up.
+
+    :param ThroughputBinary binary: The binary to measure
+    :param iterable(float) rates: The rates to try, in increasing order
+    :param kwargs: Passed on to :py:func:`run_throughput`
+    :return: The result of each rate run; the last is unsustainable unless
+        every rate was sustained
+    :rtype: list(ThroughputResult)
+    """
+    results = list()
+    for rate in rates:
+        result = run_throughput(binary, rate, **kwargs)
+        results.append(result)
+        if not result.sustainable:
+            break
+    return results
+
+
+def max_sustainable(results: Iterable[ThroughputResult]) -> \
+        Optional[ThroughputResult]:
+    """
+    Get the highest rate result that was sustained.
+
+    :param iterable(ThroughputResult) results: The results of a sweep
+    :rtype: ThroughputResult or None
+    """
+    best = None
+    for result in results:
+        if result.sustainable and (best is None or result.rate > best.rate):
+            best = result
+    return best
+
+
+def report_throughput(
+        binaries: Iterable[ThroughputBinary] = BINARIES,
+        rates: Iterable[float] = DEFAULT_RATES, output=sys.stdout,
+        **kwargs) -> Dict[str, Optional[ThroughputResult]]:
+    """
+    Sweep each binary and write the highest sustained rate of each.
+
+    :param iterable(ThroughputBinary) binaries: The binaries to measure
+    :param iterable(float) rates: The rates to try, in increasing order
+    :param output: Where to write the table
+    :param kwargs: Passed on to :py:func:`run_throughput`
+    :return: The highest sustained result of each binary by name
+    :rtype: dict(str, ThroughputResult or None)
+    """
+    rates = list(rates)
+    best_by_binary = dict()
+    output.write(
+        f"{'binary':40} {'rate Hz':>8} {'events/s/core':>14} "
+        f"{'max spikes/step':>16}\n")
+    for binary in binaries:
+        best = max_sustainable(sweep_throughput(binary, rates, **kwargs))
+        best_by_binary[binary.name] = best
+        if best is None:
+            output.write(f"{binary.name:40} {'none':>8}\n")
+        else:
+            output.write(
+                f"{binary.name:40} {best.rate:8.1f} "
+                f"{best.events_per_second:14.0f} "
+                f"{best.max_spikes_processed:16d}\n")
+    return best_by_binary
+
+
+if __name__ == "__main__":
+    report_throughput()
@@ -0,0 +1,43 @@
+# Copyright (c) 2026 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from spinnaker_testbase import BaseTestCase
+from spynnaker_integration_tests.scripts import (
+    BINARIES, max_sustainable, report_throughput, sweep_throughput)
+
+
+class TestSynapticThroughput(BaseTestCase):
+
+    def do_sweep(self):
+        results = sweep_throughput(
+            BINARIES[0], rates=[1.0, 1000.0], n_sources=500, fan_in=50)
+        self.assertEqual(2, len(results))
+        # A low rate must be kept up with, and a silly one must not be
+        best = max_sustainable(results)
+        self.assertIsNotNone(best)
+        self.assertEqual(1.0, best.rate)
+        self.assertGreater(best.events_per_second, 0)
+        self.assertFalse(results[-1].sustainable)
+
+    def test_sweep(self):
+        self.runsafe(self.do_sweep)
+
+    def do_report(self):
+        with open(self.report_file(), "a", encoding="utf-8") as output:
+            best = report_throughput(output=output)
+        self.assertEqual(len(BINARIES), len(best))
+
+    def test_report(self):
+        # Only a benchmark; the numbers go to the report file
+        self.runsafe(self.do_report)
@@ -0,0 +1,72 @@
+# Copyright (c) 2024 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy
+import pytest
+from pyNN.space import Grid2D, Line
+from spynnaker.pyNN.config_setup import unittest_setup
+from spynnaker.pyNN.models.neural_projections.connectors.\
+    distance_dependent_probability_connector import (
+        _parse_d_expression, _get_lattice, _STEP, _EXPONENTIAL, _GAUSSIAN)
+
+
+@pytest.mark.parametrize(
+    "d_expression, kind, amplitude, scale", [
+        ("d < 3", _STEP, 1.0, 3.0),
+        ("0.5 * (d <= 2.5)", _STEP, 0.5, 2.5),
+        ("exp(-abs(d))", _EXPONENTIAL, 1.0, 1.0),
+        ("0.2 * exp(-d / 10)", _EXPONENTIAL, 0.2, 10.0),
+        ("exp(-d**2 / (2 * 5**2))", _GAUSSIAN, 1.0, 5.0),
+        ("0.1*exp(-(d**2)/(2*1.5**2))", _GAUSSIAN, 0.1, 1.5),
+    ])
+def test_parse_supported(d_expression, kind, amplitude, scale):
+    unittest_setup()
+    family = _parse_d_expression(d_expression)
+    assert family is not None
+    assert family.kind == kind
+    assert family.amplitude == pytest.approx(amplitude)
+    assert family.scale == pytest.approx(scale)
+
+
+@pytest.mark.parametrize(
+    "d_expression", [
+        "d[0] < 3", "exp(-d / 10) + 0.1", "2 * exp(-d)", "d > 3",
+        "exp(-d**3 / (2 * 5**2))", "1 / d"])
+def test_parse_unsupported(d_expression):
+    unittest_setup()
+    assert _parse_d_expression(d_expression) is None
+
+
+@pytest.mark.parametrize(
+    "structure, n_atoms", [
+        (Line(dx=2.0, x0=1.0), 10),
+        (Grid2D(aspect_ratio=1.0, dx=1.5, dy=0.5), 16),
+        (Grid2D(aspect_ratio=4.0, dx=1.0, dy=2.0, x0=3.0), 36),
+    ])
+def test_lattice(structure, n_atoms):
+    unittest_setup()
+    positions = structure.generate_positions(n_atoms).T
+    lattice = _get_lattice(positions)
+    assert lattice is not None
+    origin, major, minor, n_minor = lattice
+    index = numpy.arange(n_atoms)
+    rows, cols = numpy.divmod(index, n_minor)
+    expected = (origin + numpy.outer(rows, major) + numpy.outer(cols, minor))
+    assert numpy.allclose(positions, expected)
+
+
+def test_no_lattice():
+    unittest_setup()
+    positions = numpy.random.default_rng(0).random((20, 3))
+    assert _get_lattice(positions) is None
@@ -162,6 +162,9 @@ class MockAppVertex(object):
         # All of them are 1D so this is good enough
         return indices
 
+    def get_max_atoms_per_core(self):
+        return max(s.n_atoms for s in self.splitter.get_in_coming_slices())
+
 
 class MockMachineVertex(object):
 
@@ -200,3 +203,36 @@ def __get_n_connections(pairs, pre_slice, post_slice):
     conns = conns[(conns[:, 1] >= post_slice.lo_atom) &
                   (conns[:, 1] <= post_slice.hi_atom)]
     return len(conns)
+
+
+def test_gen_connector_params():
+    unittest_setup()
+    pairs = numpy.array([
+        [3, 7, 0.5, 1.0], [1, 5, 1.5, 2.0], [0, 7, 2.5, 3.0], [2, 5, 3.5, 4.0],
+        [12, 6, 4.5, 5.0], [4, 1, 5.5, 6.0]])
+    connector = FromListConnector(pairs)
+    post_slices = [Slice(0, 4), Slice(5, 9)]
+    pre_pop = MockPopulation(10, "Pre", MockAppVertex(10, [Slice(0, 9)]))
+    post_pop = MockPopulation(10, "Post", MockAppVertex(10, post_slices))
+    s_info = SynapseInformation(None, pre_pop, post_pop, False, False,
+                                None, 1, None, None, 1.0, 1.0)
+    size = connector.gen_connector_params_size_in_bytes(s_info)
+    for post_slice in post_slices:
+        params = connector.gen_connector_params(s_info, post_slice)
+        assert len(params) * 4 <= size
+
+    # Only the connections to the slice are sent; the out of range source is
+    # not sent, and the rest are sorted by target
+    params = connector.gen_connector_params(s_info, post_slices[1])
+    first_post, n_post, n_conns, flags = params[:4]
+    assert (first_post, n_post, n_conns) == (5, 3, 4)
+    assert flags == 0x7
+    post_starts = params[4:4 + n_post + 1]
+    assert list(post_starts) == [0, 2, 2, 4]
+    offset = 4 + n_post + 1
+    pre = params[offset:offset + 2].view(numpy.uint16)
+    assert list(pre) == [1, 2, 0, 3]
+    weights = params[offset + 2:offset + 6].view(numpy.int32) / 32768.0
+    assert list(weights) == [1.5, 3.5, 2.5, 0.5]
+    delays = params[offset + 6:].view(numpy.int32) / 32768.0
+    assert list(delays) == [2.0, 4.0, 3.0, 1.0]
@@ -46,7 +46,15 @@ def as_list(request):
     return request.param
 
 
-def test_connection_holder(data_items, fixed_values, as_list):
+@pytest.fixture(
+    scope="module",
+    params=[False, True],
+    ids=["InMemory", "MemoryMapped"])
+def memory_mapped(request):
+    return request.param
+
+
+def test_connection_holder(data_items, fixed_values, as_list, memory_mapped):
     unittest_setup()
     all_values = None
     n_items = 0
@@ -66,7 +74,8 @@ def test_connection_holder(data_items, fixed_values, as_list):
 
     connection_holder = ConnectionHolder(
         data_items_to_return=all_values, as_list=as_list, n_pre_atoms=2,
-        n_post_atoms=2, fixed_values=fixed_values)
+        n_post_atoms=2, fixed_values=fixed_values,
+        memory_mapped=memory_mapped)
     connections = numpy.array(
         [(0, 0, 1, 10), (0, 0, 2, 20), (0, 1, 3, 30)],
         NUMPY_CONNECTORS_DTYPE)
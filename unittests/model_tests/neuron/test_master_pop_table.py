@@ -0,0 +1,150 @@
+# Copyright (c) 2024 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+import numpy
+from pacman.model.routing_info import BaseKeyAndMask
+from spynnaker.pyNN.config_setup import unittest_setup
+from spynnaker.pyNN.models.neuron.master_pop_table import (
+    MasterPopTableAsBinarySearch, get_pop_table_summary, make_pop_table_data)
+
+# Words of header, per table entry and per address list entry
+_HEADER_WORDS = 3
+_ENTRY_WORDS = 5
+_ADDRESS_WORDS = 1
+
+
+def _make_table(keys, mask):
+    table = MasterPopTableAsBinarySearch()
+    table.initialise_table()
+    for i, key in enumerate(keys):
+        table.add_application_entry(
+            i * 1024, 10, BaseKeyAndMask(key, mask), 0, 0, 0, 0)
+    return table
+
+
+def _direct_part(data):
+    n_entries, n_addresses = data[0], data[1]
+    return data[_HEADER_WORDS + (n_entries * _ENTRY_WORDS) +
+                (n_addresses * _ADDRESS_WORDS):]
+
+
+def test_direct_lookup():
+    unittest_setup()
+    keys = [0x30000, 0x70000, 0x90000, 0x140000]
+    table = _make_table(keys, 0xFFFF0000)
+    data = table.get_pop_table_data(direct_lookup=True)
+    direct = _direct_part(data)
+    shift, n_bits = direct[0], direct[1]
+    assert n_bits > 0
+    assert shift >= 16
+    index = direct[2:].view(numpy.uint16)
+    assert len(index) == 1 << n_bits
+    bits_mask = (1 << n_bits) - 1
+    for i, key in enumerate(sorted(keys)):
+        assert index[(key >> shift) & bits_mask] == i
+    assert numpy.count_nonzero(index != 0xFFFF) == len(keys)
+
+
+def test_no_direct_lookup():
+    unittest_setup()
+    table = _make_table([0x10000, 0x20000], 0xFFFF0000)
+    direct = _direct_part(table.get_pop_table_data(direct_lookup=False))
+    assert list(direct) == [0, 0]
+
+
+def test_direct_lookup_not_possible():
+    unittest_setup()
+    # The keys only differ in bits too far apart to index with few bits
+    table = _make_table([0x0, 0x80000000, 0x10000], 0xFFFF0000)
+    direct = _direct_part(table.get_pop_table_data(direct_lookup=True))
+    assert list(direct) == [0, 0]
+
+
+def test_make_pop_table_data_merges_keys():
+    unittest_setup()
+    keys = numpy.array([0x20000, 0x10000, 0x20000], dtype=numpy.uint32)
+    masks = numpy.full(3, 0xFFFF0000, dtype=numpy.uint32)
+    zeros = numpy.zeros(3, dtype=numpy.uint32)
+    addresses = numpy.array([1, 2, 3], dtype=numpy.uint32)
+    row_lengths = numpy.array([4, 5, 6], dtype=numpy.uint32)
+    valid = numpy.array([True, True, False])
+    data = make_pop_table_data(
+        keys, masks, zeros, zeros, zeros, zeros, addresses, row_lengths,
+        valid)
+    assert list(data[:_HEADER_WORDS]) == [2, 3, 0]
+    table = data[_HEADER_WORDS:_HEADER_WORDS + 2 * _ENTRY_WORDS].reshape(
+        2, _ENTRY_WORDS)
+    assert list(table[:, 0]) == [0x10000, 0x20000]
+    # start in the low bits, count from bit 16
+    assert list(table[:, 2]) == [0 | (1 << 16), 1 | (2 << 16)]
+    start = _HEADER_WORDS + 2 * _ENTRY_WORDS
+    address_list = data[start:start + 3]
+    assert address_list[0] == 5 | (2 << 8)
+    assert address_list[1] == 4 | (1 << 8)
+    assert address_list[2] >> 8 == 0xFFFFFF
+
+
+def test_make_pop_table_data_extended():
+    unittest_setup()
+    # An address beyond the reach of the standard format
+    keys = numpy.array([0x20000, 0x10000], dtype=numpy.uint32)
+    masks = numpy.full(2, 0xFFFF0000, dtype=numpy.uint32)
+    zeros = numpy.zeros(2, dtype=numpy.uint32)
+    addresses = numpy.array([1, 1 << 24], dtype=numpy.uint32)
+    row_lengths = numpy.array([4, 5], dtype=numpy.uint32)
+    valid = numpy.array([True, True])
+    data = make_pop_table_data(
+        keys, masks, zeros, zeros, zeros, zeros, addresses, row_lengths,
+        valid)
+    assert list(data[:_HEADER_WORDS]) == [2, 2, 1]
+    start = _HEADER_WORDS + 2 * _ENTRY_WORDS
+    assert list(data[start:start + 2]) == [0, 1]
+    address_list = data[start + 2:start + 6]
+    assert list(address_list) == [5, (1 << 24) * 16, 4, 16]
+
+
+def test_pop_table_summary():
+    unittest_setup()
+    table = MasterPopTableAsBinarySearch()
+    table.initialise_table()
+    table.add_application_entry(
+        0, 10, BaseKeyAndMask(0x10000, 0xFFFF0000), 0x3, 8, 256, 0)
+    table.add_application_entry(
+        1024, 10, BaseKeyAndMask(0x10000, 0xFFFF0000), 0x3, 8, 256, 0)
+    table.add_application_entry(
+        2048, 10, BaseKeyAndMask(0x20000, 0xFFFF0000), 0, 0, 0, 0)
+    data = table.get_pop_table_data()
+    summary = get_pop_table_summary(data)
+    assert summary.n_entries == 2
+    assert summary.n_core_masked_entries == 1
+    assert summary.n_addresses == 3
+    assert not summary.extended
+    assert summary.n_bytes == len(data) * 4
+    assert summary.n_search_steps == 2
+
+
+def test_address_list_position():
+    unittest_setup()
+    table = MasterPopTableAsBinarySearch()
+    table.initialise_table()
+    # Add out of key order; the machine sees the items sorted by key
+    high = table.add_application_entry(
+        0, 10, BaseKeyAndMask(0x20000, 0xFFFF0000), 0, 0, 0, 0)
+    low_0 = table.add_application_entry(
+        1024, 10, BaseKeyAndMask(0x10000, 0xFFFF0000), 0, 0, 0, 0)
+    low_1 = table.add_invalid_application_entry(
+        BaseKeyAndMask(0x10000, 0xFFFF0000), 0, 0, 0, 0)
+    assert table.n_addresses == 3
+    assert table.get_address_list_position(0x10000, low_0) == 0
+    assert table.get_address_list_position(0x10000, low_1) == 1
+    assert table.get_address_list_position(0x20000, high) == 2
@@ -11,7 +11,9 @@
 # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 # See the License for the specific language governing permissions and
 # limitations under the License.
+import pytest
 from spinn_front_end_common.interface.ds import DataType
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
 from spynnaker.pyNN.config_setup import unittest_setup
 from spynnaker.pyNN.models.common import NeuronRecorder
 
@@ -50,3 +52,70 @@ def test_recording_variables():
     nr.set_recording("gsyn_inh", True)
     assert ["v", "gsyn_inh"] == list(nr.recording_variables)
     assert [0, 2] == list(nr.recorded_region_ids)
+
+
+def test_recorded_data_type():
+    unittest_setup()
+    recordables = ["v", "gsyn_exc", "gsyn_inh"]
+
+    data_types = {
+        "v": DataType.S1615,
+        "gsyn_exc": DataType.S1615,
+        "gsyn_inh": DataType.S1615
+    }
+
+    nr = NeuronRecorder(recordables, data_types, [], 100, [], [], [], [])
+    nr.set_recording("v", True)
+    full_size = nr._get_buffered_sdram_per_record("v", 100)
+    nr.set_recorded_data_type("v", DataType.S87)
+    assert DataType.S87 == nr.get_data_type("v")
+    assert DataType.S1615 == nr.get_data_type("gsyn_exc")
+    assert (full_size - 200) == nr._get_buffered_sdram_per_record("v", 100)
+
+    # Going back to the original type removes the encoding
+    nr.set_recorded_data_type("v", DataType.S1615)
+    assert DataType.S1615 == nr.get_data_type("v")
+    assert full_size == nr._get_buffered_sdram_per_record("v", 100)
+
+
+def test_recorded_data_type_not_possible():
+    unittest_setup()
+    recordables = ["v"]
+    data_types = {"v": DataType.S1615}
+    nr = NeuronRecorder(recordables, data_types, [], 100, [], [], [], [])
+    with pytest.raises(ConfigurationException):
+        nr.set_recorded_data_type("v", DataType.S3231)
+    with pytest.raises(ConfigurationException):
+        nr.set_recorded_data_type("v", DataType.U88)
+    with pytest.raises(ConfigurationException):
+        nr.set_recorded_data_type("spikes", DataType.S87)
+
+
+def test_aggregation():
+    unittest_setup()
+    recordables = ["v"]
+    data_types = {"v": DataType.S1615}
+    nr = NeuronRecorder(
+        recordables, data_types, ["spikes"], 100, [], [], [], [])
+    nr.set_recording("v", True)
+    nr.set_recording("spikes", True)
+
+    nr.set_aggregation("spikes", NeuronRecorder.COUNT)
+    assert DataType.UINT16 == nr.get_data_type("spikes")
+    assert 4 + 200 == nr._get_buffered_sdram_per_record("spikes", 100)
+
+    nr.set_aggregation("v", NeuronRecorder.MEAN)
+    assert 4 + 8 == nr._get_buffered_sdram_per_record("v", 100)
+    with pytest.raises(ConfigurationException):
+        nr.set_recorded_data_type("v", DataType.S87)
+
+    # Removing the aggregation records each value again
+    nr.set_aggregation("v", None)
+    assert 4 + 400 == nr._get_buffered_sdram_per_record("v", 100)
+
+    with pytest.raises(ConfigurationException):
+        nr.set_aggregation("v", NeuronRecorder.COUNT)
+    with pytest.raises(ConfigurationException):
+        nr.set_aggregation("spikes", NeuronRecorder.MEAN)
+    with pytest.raises(ConfigurationException):
+        nr.set_aggregation("v", "median")
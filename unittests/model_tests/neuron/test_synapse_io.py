@@ -12,13 +12,20 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import numpy
 import pytest
 from spynnaker.pyNN.exceptions import SynapseRowTooBigException
 from spynnaker.pyNN.models.neural_projections import (
     ProjectionApplicationEdge, SynapseInformation)
 from spynnaker.pyNN.models.neuron.synapse_dynamics import (
     SynapseDynamicsStatic, SynapseDynamicsSTDP)
-from spynnaker.pyNN.models.neuron.synapse_io import _get_allowed_row_length
+from spynnaker.pyNN.models.neuron.synapse_io import (
+    _get_allowed_row_length, _get_static_row_formats, _get_dense_rows,
+    _expand_dense_row, _sort_static_rows_by_delay, _get_byte_target_rows,
+    _expand_byte_target_row, _get_shared_weight_rows,
+    _expand_shared_weight_row, _get_row_data, _parse_plastic_data)
+from spynnaker.pyNN.models.neural_projections.connectors import (
+    AbstractConnector)
 from spynnaker.pyNN.models.neuron.plasticity.stdp.weight_dependence import (
     WeightDependenceAdditive)
 from spynnaker.pyNN.models.neuron.plasticity.stdp.timing_dependence import (
@@ -68,3 +75,119 @@ def test_get_allowed_row_length(
     else:
         actual_size = _get_allowed_row_length(size, dynamics, in_edge, size)
         assert actual_size == max_size
+
+
+def test_get_static_row_formats():
+    # 2 neuron id bits, 1 synapse type bit, delay above
+    def word(delay, s_type, target):
+        return (1 << 16) | (delay << 3) | (s_type << 2) | target
+    rows = [
+        numpy.array([word(1, 0, 0), word(1, 0, 1)], dtype="uint32"),
+        numpy.array([word(1, 0, 0), word(2, 0, 1)], dtype="uint32"),
+        numpy.array([word(1, 0, 0), word(1, 1, 1)], dtype="uint32"),
+        # Padding after the synapses is ignored
+        numpy.array([word(3, 1, 2), 0], dtype="uint32"),
+        numpy.zeros(0, dtype="uint32")]
+    sizes = numpy.array([2, 2, 2, 1, 0], dtype="uint32").reshape((-1, 1))
+    formats = _get_static_row_formats(rows, sizes, 2, 4)
+    assert list(formats.reshape(-1) >> 24) == [3, 2, 1, 3, 3]
+
+
+def test_dense_rows():
+    # 2 neuron id bits, 1 synapse type bit, delay above
+    def word(weight, target):
+        return (weight << 16) | (1 << 3) | (1 << 2) | target
+    rows = [
+        numpy.array([word(5, 0), word(6, 2)], dtype="uint32"),
+        numpy.array([word(7, 3), word(8, 1), word(9, 0)], dtype="uint32"),
+        numpy.zeros(0, dtype="uint32")]
+    sizes = numpy.array([2, 3, 0], dtype="uint32").reshape((-1, 1))
+    dense, dense_sizes, formats = _get_dense_rows(rows, sizes, 4)
+    assert list(dense_sizes.reshape(-1)) == [3, 3, 0]
+    assert list(formats.reshape(-1) >> 24) == [7, 7, 7]
+    # The header has the number of weights, delay and type but no target
+    assert dense[0][0] == (3 << 16) | (1 << 3) | (1 << 2)
+    assert dense[1][0] == (4 << 16) | (1 << 3) | (1 << 2)
+    assert list(dense[1][1:].view("<u2")) == [9, 8, 0, 7]
+    for row, dense_row in zip(rows, dense):
+        assert sorted(_expand_dense_row(dense_row, 4)) == sorted(row)
+
+
+def test_byte_target_rows():
+    # 2 neuron id bits, 1 synapse type bit, delay above
+    def word(delay, target):
+        return (5 << 16) | (delay << 3) | (1 << 2) | target
+    rows = [
+        numpy.array([word(1, 0), word(2, 2), word(3, 1), word(1, 3),
+                     word(2, 0)], dtype="uint32"),
+        numpy.array([word(4, 3), 0], dtype="uint32"),
+        numpy.zeros(0, dtype="uint32")]
+    sizes = numpy.array([5, 1, 0], dtype="uint32").reshape((-1, 1))
+    byte_rows, byte_sizes, formats = _get_byte_target_rows(rows, sizes)
+    assert list(byte_sizes.reshape(-1)) == [3, 2, 0]
+    assert list(formats.reshape(-1) >> 24) == [0x12, 0x12, 0x12]
+    # The header has the weight and the number of synapses
+    assert byte_rows[0][0] == (5 << 16) | 5
+    assert list(byte_rows[1][1:].view("<u1")) == [word(4, 3) & 0xFF, 0, 0, 0]
+    for row, size, byte_row in zip(rows, sizes.reshape(-1), byte_rows):
+        assert list(_expand_byte_target_row(byte_row)) == list(row[:size])
+
+
+def test_shared_weight_rows():
+    # 2 neuron id bits, 1 synapse type bit, delay above
+    def word(target):
+        return (5 << 16) | (2 << 3) | (1 << 2) | target
+    rows = [
+        numpy.array([word(2), word(0), word(3)], dtype="uint32"),
+        numpy.array([word(1), 0], dtype="uint32"),
+        numpy.zeros(0, dtype="uint32")]
+    sizes = numpy.array([3, 1, 0], dtype="uint32").reshape((-1, 1))
+    shared, shared_sizes, formats = _get_shared_weight_rows(rows, sizes, 4)
+    assert list(shared_sizes.reshape(-1)) == [4, 3, 0]
+    assert list(formats.reshape(-1) >> 24) == [0x23, 0x23, 0x23]
+    # The header has the weight, delay and type but no target
+    assert shared[0][0] == (5 << 16) | (2 << 3) | (1 << 2)
+    assert shared[0][1] == 3
+    assert list(shared[0][2:].view("<u2")) == [2, 0, 3, 0]
+    for row, size, shared_row in zip(rows, sizes.reshape(-1), shared):
+        assert list(_expand_shared_weight_row(shared_row)) == list(
+            row[:size])
+
+
+def test_sort_static_rows_by_delay():
+    # 2 neuron id bits, 1 synapse type bit, delay above
+    def word(delay, target):
+        return (1 << 16) | (delay << 3) | target
+    rows = [
+        numpy.array([word(0, 0), word(3, 1), word(1, 2), word(3, 3)],
+                    dtype="uint32"),
+        numpy.array([word(2, 0), word(1, 1), 0], dtype="uint32")]
+    sizes = numpy.array([4, 2], dtype="uint32").reshape((-1, 1))
+    _sort_static_rows_by_delay(rows, sizes, 2, 4)
+    # Delay 0 is the maximum so goes last; equal delays keep their order
+    assert list(rows[0]) == [word(1, 2), word(3, 1), word(3, 3), word(0, 0)]
+    # Padding after the synapses is left alone
+    assert list(rows[1]) == [word(1, 1), word(2, 0), 0]
+
+
+def test_plastic_only_rows():
+    sim.setup()
+    dynamics = SynapseDynamicsSTDP(
+        TimingDependenceSpikePair(), WeightDependenceAdditive())
+    connections = numpy.zeros(
+        3, dtype=AbstractConnector.NUMPY_SYNAPSES_DTYPE)
+    connections["source"] = [0, 0, 1]
+    connections["target"] = [0, 2, 1]
+    connections["weight"] = [1, 2, 3]
+    connections["delay"] = [1, 1, 1]
+    n_words = dynamics.get_n_words_for_plastic_connections(2)
+    row_data = _get_row_data(
+        connections, connections["source"], 2, 2, dynamics, 2, n_words, 4)
+    rows = row_data.reshape((2, -1))
+    # The rows are flagged as having only plastic synapses, but the number
+    # of synapses read back is without the flag
+    pp_words = dynamics.get_n_plastic_plastic_words_per_row(rows[:, 0])
+    fp_sizes = rows[numpy.arange(2), pp_words + 2]
+    assert list(fp_sizes >> 24) == [0x40, 0x40]
+    _, _, fp_size, _ = _parse_plastic_data(rows, dynamics)
+    assert list(fp_size) == [2, 1]
@@ -0,0 +1,92 @@
+# Copyright (c) 2024 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy
+import pytest
+from spynnaker.pyNN.config_setup import unittest_setup
+from spynnaker.pyNN.models.spike_source.\
+    spike_source_array_compact_machine_vertex import encode_spike_frames
+from spynnaker.pyNN.models.spike_source.spike_source_array_vertex import (
+    _spike_pattern)
+
+
+def _decode(words, n_frames, n_atoms):
+    """ Decode the frames as the binary on the machine does
+    """
+    n_bit_words = (n_atoms + 31) // 32
+    data = words.view(numpy.uint8)
+    spikes = list()
+    pos = 0
+    for _ in range(n_frames):
+        time, info = int(words[pos]), int(words[pos + 1])
+        pos += 2
+        n_spikes = info & 0x7FFFFFFF
+        if info & 0x80000000:
+            for i in range(n_atoms):
+                if (words[pos + i // 32] >> (i % 32)) & 1:
+                    spikes.append((time, i))
+            pos += n_bit_words
+            continue
+        byte = pos * 4
+        index = 0
+        for _ in range(n_spikes):
+            while data[byte] == 255:
+                index += 255
+                byte += 1
+            index += int(data[byte])
+            byte += 1
+            spikes.append((time, index))
+        pos = (byte + 3) // 4
+    assert pos == len(words)
+    return spikes
+
+
+def test_encode_spike_frames():
+    unittest_setup()
+    n_atoms = 600
+    # A sparse time step, one with big gaps and a repeat, and a dense one
+    ticks = [3, 3, 7, 7, 7, 7, 12] + [20] * 500 + [-1]
+    ids = [5, 1, 0, 599, 300, 300, 2] + list(range(500)) + [4]
+    frames = encode_spike_frames(
+        numpy.array(ticks), numpy.array(ids), n_atoms)
+    assert frames.n_frames == 4
+    assert frames.max_spikes_per_source == 2
+    expected = sorted((t, i) for t, i in zip(ticks, ids) if t >= 0)
+    assert _decode(frames.words, frames.n_frames, n_atoms) == expected
+
+    # Headers, then differences for all but the dense time step, which is
+    # held as a bit field
+    assert len(frames.words) == 4 * 2 + 1 + 2 + 1 + 19
+
+
+def test_encode_no_spikes():
+    unittest_setup()
+    frames = encode_spike_frames(numpy.array([]), numpy.array([]), 10)
+    assert frames.n_frames == 0
+    assert len(frames.words) == 0
+
+
+def test_spike_pattern():
+    unittest_setup()
+    assert _spike_pattern(None, 0.0, None) is None
+    pattern = _spike_pattern(50.0, 5.0, 1)
+    assert pattern.period == 50
+    assert pattern.jitter == 5
+    assert pattern == _spike_pattern(50.0, 5.0, 1)
+    with pytest.raises(ValueError):
+        _spike_pattern(None, 5.0, None)
+    with pytest.raises(ValueError):
+        _spike_pattern(50.0, 50.0, None)
+    with pytest.raises(ValueError):
+        _spike_pattern(0.0, 0.0, None)
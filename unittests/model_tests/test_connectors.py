@@ -17,6 +17,7 @@ import numpy
 import pytest
 import random
 import sys
+from pyNN.random import NumpyRNG, RandomDistribution
 from pacman.model.graphs.common import Slice
 from spynnaker.pyNN.config_setup import unittest_setup
 from spynnaker.pyNN.models.neural_projections.connectors import (
@@ -162,3 +163,60 @@ def test_connectors(
             print(max_delay, matrix_max_delay, synaptic_block["delay"])
     print(connector, n_pre, n_post, n_in_slice, max_row_length,
           max_source, max_col_length, max_target)
+
+
+@pytest.mark.parametrize("create_seeded_connector", [
+    functools.partial(FixedProbabilityConnector, 0.5),
+    functools.partial(FixedProbabilityConnector, 0.1),
+    functools.partial(IndexBasedProbabilityConnector, "1 / (i + j + 1)")])
+def test_block_seeds_independent_of_order(create_seeded_connector):
+    unittest_setup()
+    post_slices = [Slice(i, i + 9) for i in range(0, 30, 10)]
+
+    def create_blocks(slice_order):
+        connector = create_seeded_connector(rng=NumpyRNG(seed=7))
+        synapse_info = SynapseInformation(
+            connector=None, pre_population=MockPopulation(20, "Pre"),
+            post_population=MockPopulation(30, "Post"),
+            prepop_is_view=False, postpop_is_view=False,
+            synapse_dynamics=None, synapse_type=None, receptor_type=None,
+            synapse_type_from_dynamics=False,
+            weights=RandomDistribution(
+                "uniform", (0.0, 1.0), rng=NumpyRNG(seed=3)),
+            delays=1)
+        connector.set_projection_information(synapse_info=synapse_info)
+        for post_slice in post_slices:
+            connector.reserve_block_seeds(
+                post_slices, post_slice, synapse_info)
+        return {
+            post_slices.index(post_slice): connector.create_synaptic_block(
+                post_slices, post_slice, 0, synapse_info)
+            for post_slice in slice_order}
+
+    forward = create_blocks(post_slices)
+    backward = create_blocks(post_slices[::-1])
+    for index, block in forward.items():
+        assert numpy.array_equal(block, backward[index])
+
+
+@pytest.mark.parametrize("p_connect", [0.01, 0.1, 0.25, 0.5])
+def test_fixed_probability_skip_params(p_connect):
+    unittest_setup()
+    connector = FixedProbabilityConnector(p_connect)
+    synapse_info = SynapseInformation(
+        connector=None, pre_population=MockPopulation(20, "Pre"),
+        post_population=MockPopulation(30, "Post"),
+        prepop_is_view=False, postpop_is_view=False,
+        synapse_dynamics=None, synapse_type=None, receptor_type=None,
+        synapse_type_from_dynamics=False, weights=1.0, delays=1)
+    params = connector.gen_connector_params(synapse_info, Slice(0, 29))
+    assert len(params) * 4 == connector.gen_connector_params_size_in_bytes(
+        synapse_info)
+    skip_scale, skip_shift = params[2:]
+    if p_connect > 0.25:
+        assert skip_scale == 0
+    else:
+        # The scale is -1 / ln(1 - p) with as many bits as fit
+        assert skip_scale >= 0x80000000
+        assert (skip_scale / (2 ** int(skip_shift))) == pytest.approx(
+            -1.0 / numpy.log1p(-p_connect))
@@ -0,0 +1,51 @@
+# Copyright (c) 2026 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+from spynnaker.pyNN.config_setup import unittest_setup
+from spynnaker.pyNN.data.spynnaker_data_writer import SpynnakerDataWriter
+from spynnaker.pyNN.extra_algorithms.core_load_prediction import (
+    CoreLoad, atoms_within_budget, time_scale_factor_for)
+
+
+class TestCoreLoadPrediction(unittest.TestCase):
+
+    def setUp(self):
+        unittest_setup()
+
+    def test_max_clocks(self):
+        self.assertEqual(CoreLoad(100, 300, None).max_clocks, 400)
+        self.assertEqual(CoreLoad(100, 300, 2).max_clocks, 150)
+        self.assertEqual(CoreLoad(200, 300, 3).max_clocks, 200)
+
+    def test_atoms_within_budget(self):
+        self.assertEqual(
+            atoms_within_budget(lambda n: 100 + 10 * n, 256, 1000), 90)
+        self.assertEqual(
+            atoms_within_budget(lambda n: 100 + 10 * n, 50, 1000), 50)
+        self.assertEqual(
+            atoms_within_budget(lambda n: 2000 + n, 256, 1000), 0)
+
+    def test_time_scale_factor_for(self):
+        writer = SpynnakerDataWriter.setup()
+        writer.set_up_timings(1000, 1)
+        # A 1ms time step has 160000 clock cycles at the target use
+        self.assertEqual(time_scale_factor_for(1000), 1)
+        self.assertEqual(time_scale_factor_for(160000), 1)
+        self.assertEqual(time_scale_factor_for(160001), 2)
+        self.assertEqual(time_scale_factor_for(1000000), 7)
+
+
+if __name__ == '__main__':
+    unittest.main()
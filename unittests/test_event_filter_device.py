@@ -0,0 +1,59 @@
+# Copyright (c) 2026 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+from spynnaker.pyNN.config_setup import unittest_setup
+from spynnaker.pyNN.external_devices_models import (
+    EventFilterDevice, SPIFRetinaDevice)
+
+
+class TestEventFilterDevice(unittest.TestCase):
+
+    def setUp(self):
+        unittest_setup()
+        self.retina = SPIFRetinaDevice(
+            pipe=0, width=64, height=48, sub_width=16, sub_height=8)
+
+    def test_whole_retina(self):
+        device = EventFilterDevice(self.retina)
+        self.assertEqual(device.atoms_shape, (64, 48))
+        self.assertEqual(device.n_atoms, 64 * 48)
+
+    def test_pooled_roi(self):
+        device = EventFilterDevice(
+            self.retina, x_min=8, y_min=4, width=30, height=20,
+            pool_x_shift=2, pool_y_shift=1, refractory_steps=3)
+        params = device.filter_parameters
+        self.assertEqual((params.out_width, params.out_height), (8, 10))
+        self.assertEqual(device.atoms_shape, (8, 10))
+        self.assertEqual(params.refractory_steps, 3)
+
+    def test_roi_outside_retina(self):
+        with self.assertRaises(ConfigurationException):
+            EventFilterDevice(self.retina, x_min=40, width=32)
+        with self.assertRaises(ConfigurationException):
+            EventFilterDevice(self.retina, y_min=-1)
+
+    def test_too_many_pixels(self):
+        retina = SPIFRetinaDevice(
+            pipe=1, width=256, height=128, sub_width=32, sub_height=16)
+        with self.assertRaises(ConfigurationException):
+            EventFilterDevice(retina)
+        device = EventFilterDevice(retina, pool_x_shift=1, pool_y_shift=1)
+        self.assertEqual(device.n_atoms, 128 * 64)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,50 @@
+# Copyright (c) 2024 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy
+import pytest
+from spynnaker.pyNN.config_setup import unittest_setup
+from spynnaker.pyNN.connections.spynnaker_live_spikes_connection import (
+    SpynnakerLiveSpikesConnection, _TimeStepSpikes)
+
+
+def test_time_step_spikes():
+    unittest_setup()
+    received = list()
+    spikes = _TimeStepSpikes(
+        "pop", lambda label, time, ids: received.append(
+            (label, time, ids.tolist())))
+
+    # Packets of the same time step are given out together
+    spikes.add("pop", 1, [1, 2, 3])
+    spikes.add("pop", 1, [7])
+    assert received == []
+    spikes.add("pop", 2, list(range(2000)))
+    assert received == [("pop", 1, [1, 2, 3, 7])]
+
+    # The last time step is given out on a flush, and only once
+    spikes.flush()
+    spikes.flush()
+    assert received[1:] == [("pop", 2, list(range(2000)))]
+
+
+def test_encode_spike_array():
+    unittest_setup()
+    ids = numpy.arange(300)
+    messages = SpynnakerLiveSpikesConnection.encode_spike_array(ids)
+    assert [message.eieio_header.count for message in messages] == [
+        127, 127, 46]
+    assert SpynnakerLiveSpikesConnection.encode_spike_array([]) == []
+    with pytest.raises(ValueError):
+        SpynnakerLiveSpikesConnection.encode_spike_array([0x10000])
@@ -15,6 +15,7 @@
 import csv
 import os
 import pickle
+import tempfile
 import numpy
 import pytest
 from spinn_front_end_common.utilities.exceptions import ConfigurationException
@@ -223,6 +224,63 @@ class TestDataPopulation(BaseTestCase):
             # Only one type of data at a time is supported
             pop.spinnaker_get_data(["v", "spikes"])
 
+    def test_spinnaker_get_data_mmap(self):
+        my_dir = os.path.dirname(os.path.abspath(__file__))
+        my_buffer = os.path.join(my_dir, "all_data.sqlite3")
+        with NeoBufferDatabase(my_buffer) as db:
+            pop = db.get_population("pop_1")
+
+        with tempfile.TemporaryDirectory() as tmp_dir:
+            mmap_file = os.path.join(tmp_dir, "v.npy")
+            v = pop.spinnaker_get_data(
+                "v", as_matrix=True, mmap_file=mmap_file)
+            assert isinstance(v, numpy.memmap)
+            assert numpy.array_equal(v, self.v_expected)
+            assert numpy.array_equal(numpy.load(mmap_file), self.v_expected)
+            del v
+
+    def test_iter_spinnaker_data(self):
+        my_dir = os.path.dirname(os.path.abspath(__file__))
+        my_buffer = os.path.join(my_dir, "all_data.sqlite3")
+        with NeoBufferDatabase(my_buffer) as db:
+            v_chunks = list(db.iter_spinnaker_data("pop_1", "v", 10))
+            spike_chunks = list(db.iter_spinnaker_data("pop_1", "spikes", 10))
+            segments = list(db.iter_segments("pop_1", ["spikes", "v"], 10))
+            with pytest.raises(ConfigurationException):
+                next(db.iter_spinnaker_data("pop_1", "v", 0))
+
+        assert len(v_chunks) == len(spike_chunks) == len(segments) == 4
+        v = numpy.concatenate([data for _, _, data in v_chunks])
+        assert numpy.array_equal(v, self.v_expected)
+        for t_start, t_stop, spikes in spike_chunks:
+            assert all(t_start <= t < t_stop for t in spikes[:, 1])
+        spikes = numpy.concatenate([data for _, _, data in spike_chunks])
+        spikes = spikes[numpy.lexsort((spikes[:, 1], spikes[:, 0]))]
+        assert numpy.array_equal(spikes, self.spikes_expected)
+        n_samples = sum(
+            len(segment.filter(name="v")[0]) for segment in segments)
+        assert n_samples == len(self.v_expected)
+
+    def test_export_parquet(self):
+        parquet = pytest.importorskip("pyarrow.parquet")
+        my_dir = os.path.dirname(os.path.abspath(__file__))
+        my_buffer = os.path.join(my_dir, "all_data.sqlite3")
+        with tempfile.TemporaryDirectory() as tmp_dir:
+            with NeoBufferDatabase(my_buffer) as db:
+                paths = db.export_parquet(
+                    tmp_dir, "pop_1", ["spikes", "v"], chunk_ms=10)
+            spikes = parquet.read_table(paths[0])
+            v = parquet.read_table(paths[1])
+
+        spikes = numpy.column_stack((
+            spikes.column("index").to_numpy(),
+            spikes.column("time").to_numpy()))
+        spikes = spikes[numpy.lexsort((spikes[:, 1], spikes[:, 0]))]
+        assert numpy.array_equal(spikes, self.spikes_expected)
+        v = numpy.column_stack([
+            v.column(str(i)).to_numpy() for i in range(N_NEURONS)])
+        assert numpy.array_equal(v, self.v_expected)
+
     def test_spinnaker_get_data_view(self):
         my_dir = os.path.dirname(os.path.abspath(__file__))
         my_buffer = os.path.join(my_dir, "view_data.sqlite3")
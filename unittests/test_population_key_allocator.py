@@ -0,0 +1,81 @@
+# Copyright (c) 2026 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+from pacman.model.routing_info import BaseKeyAndMask
+from spynnaker.pyNN.config_setup import unittest_setup
+from spynnaker.pyNN.extra_algorithms.population_key_allocator import (
+    KEY_BASE, KeySource, n_maskable_ranges, plan_keys)
+
+
+class TestPopulationKeyAllocator(unittest.TestCase):
+
+    def setUp(self):
+        unittest_setup()
+
+    def test_maskable_ranges(self):
+        self.assertEqual(n_maskable_ranges(0, 16), 1)
+        self.assertEqual(n_maskable_ranges(0, 24), 2)
+        self.assertEqual(n_maskable_ranges(8, 24), 2)
+        self.assertEqual(n_maskable_ranges(4, 12), 2)
+        self.assertEqual(n_maskable_ranges(5, 5), 0)
+
+    def test_sources_with_the_same_targets_merge(self):
+        a, b = frozenset(["a"]), frozenset(["b"])
+        sources = [
+            KeySource("s0", 8, a), KeySource("t0", 6, b),
+            KeySource("s1", 8, a), KeySource("t1", 4, b),
+            KeySource("s2", 9, a)]
+        plan = plan_keys(sources)
+
+        # Each source is aligned to its size
+        for source in sources:
+            key_and_mask = plan.keys[source.source]
+            self.assertEqual(key_and_mask.key % (1 << source.n_bits), 0)
+            self.assertEqual(
+                key_and_mask.mask, 0xFFFFFFFF - (1 << source.n_bits) + 1)
+
+        # The keys of each set of targets are in one maskable range
+        self.assertEqual(plan.n_ranges, {a: 1, b: 2})
+        keys = sorted(k.key for k in plan.keys.values())
+        self.assertEqual(keys[0], KEY_BASE)
+        self.assertEqual(
+            [plan.keys[s].key for s in ["s2", "s0", "s1"]],
+            [KEY_BASE, KEY_BASE + 512, KEY_BASE + 768])
+        self.assertEqual(plan.keys["t0"].key, KEY_BASE + 1024)
+        self.assertEqual(plan.keys["t1"].key, KEY_BASE + 1088)
+
+    def test_fixed_keys_are_kept_clear_of(self):
+        a, b = frozenset(["a"]), frozenset(["b"])
+        sources = [KeySource("s0", 8, a), KeySource("t0", 6, b)]
+
+        # A device key in the middle of where the first group would go
+        device = BaseKeyAndMask(KEY_BASE + 0x10000, 0xFFFF8000)
+        plan = plan_keys(
+            [KeySource("s", 16, a)] + sources, reserved=[device])
+        self.assertEqual(plan.keys["s"].key, KEY_BASE + 0x20000)
+        self.assertEqual(plan.keys["t0"].key, KEY_BASE + 0x30100)
+
+        # Keys below the base make no difference
+        plan = plan_keys(
+            sources, reserved=[BaseKeyAndMask(0x00FE0000, 0xFFFF8000)])
+        self.assertEqual(plan.keys["s0"].key, KEY_BASE)
+
+    def test_too_many_keys(self):
+        with self.assertRaises(ValueError):
+            plan_keys([KeySource("s", 32, frozenset())])
+
+
+if __name__ == '__main__':
+    unittest.main()
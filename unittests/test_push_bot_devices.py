@@ -16,6 +16,8 @@ import unittest
 from spynnaker.pyNN.config_setup import unittest_setup
 from spynnaker.pyNN.external_devices_models.push_bot.parameters import (
     PushBotLaser, PushBotMotor, PushBotSpeaker, PushBotLED)
+from spynnaker.pyNN.external_devices_models.push_bot.ethernet.\
+    push_bot_retina_connection import decode_retina_events
 
 
 class Test(unittest.TestCase):
@@ -44,6 +46,17 @@ class Test(unittest.TestCase):
     def test_speaker_device(self):
         self._test_device_enum(PushBotSpeaker)
 
+    def test_decode_aligned_retina_events(self):
+        events, rest = decode_retina_events(bytes([0x81, 0x02, 0xFF, 0x83]))
+        self.assertEqual(list(events), [0x0281, 0x83FF])
+        self.assertEqual(rest, b'')
+
+    def test_decode_unaligned_retina_events(self):
+        events, rest = decode_retina_events(
+            bytes([0x02, 0x81, 0x02, 0x05, 0xFF, 0x83, 0x90]))
+        self.assertEqual(list(events), [0x0281, 0x83FF])
+        self.assertEqual(rest, bytes([0x90]))
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -0,0 +1,59 @@
+# Copyright (c) 2026 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+import tempfile
+import unittest
+from spinn_utilities.config_holder import set_config
+from spynnaker.pyNN.config_setup import unittest_setup
+from spynnaker.pyNN.extra_algorithms.run_recommendations import (
+    PopulationRecommendation, RunRecommendations, read_run_recommendations,
+    spike_buffer_size_for, write_run_recommendations)
+
+
+class TestRunRecommendations(unittest.TestCase):
+
+    def setUp(self):
+        unittest_setup()
+
+    def test_none_without_config(self):
+        self.assertIsNone(read_run_recommendations())
+
+    def test_missing_file(self):
+        set_config("Mapping", "run_recommendations",
+                   os.path.join(tempfile.gettempdir(), "not_a_file.json"))
+        self.assertIsNone(read_run_recommendations())
+
+    def test_write_then_read(self):
+        recommendations = RunRecommendations(3, {
+            "pop_1": PopulationRecommendation(128, None, ("slow", )),
+            "pop_2": PopulationRecommendation(None, 2, ("lost", "late")),
+            "pop_3": PopulationRecommendation(None, None, ("late", ), 5),
+            "pop_4": PopulationRecommendation(
+                None, None, ("empty", ), None, 32)})
+        with tempfile.TemporaryDirectory() as tmp:
+            file_name = os.path.join(tmp, "run_recommendations.json")
+            write_run_recommendations(file_name, recommendations)
+            set_config("Mapping", "run_recommendations", file_name)
+            self.assertEqual(read_run_recommendations(), recommendations)
+
+    def test_spike_buffer_size(self):
+        self.assertEqual(spike_buffer_size_for(256, 0, False), 16)
+        self.assertEqual(spike_buffer_size_for(256, 20, False), 64)
+        self.assertEqual(spike_buffer_size_for(256, 128, False), 256)
+        self.assertEqual(spike_buffer_size_for(256, 256, True), 512)
+
+
+if __name__ == '__main__':
+    unittest.main()
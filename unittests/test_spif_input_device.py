@@ -0,0 +1,60 @@
+# Copyright (c) 2026 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+from spynnaker.pyNN.config_setup import unittest_setup
+from spynnaker.pyNN.external_devices_models import SPIFInputDevice
+from spynnaker.pyNN.external_devices_models.spif_devices import (
+    set_mapper_key)
+
+
+class TestSPIFInputDevice(unittest.TestCase):
+
+    def setUp(self):
+        unittest_setup()
+
+    def test_single_pipe(self):
+        device = SPIFInputDevice(1, 100, 16, base_key=0)
+        self.assertEqual(device.pipes, (1, ))
+        self.assertEqual(device.get_pipe_and_input_id(99), (1, 99))
+
+    def test_striped(self):
+        device = SPIFInputDevice((0, 1), 100, 16, base_key=0)
+        self.assertEqual(device.pipes, (0, 1))
+        # 7 partitions of 16 split into stripes of 4 partitions
+        self.assertEqual(device.get_pipe_and_input_id(63), (0, 63))
+        self.assertEqual(device.get_pipe_and_input_id(64), (1, 0))
+        self.assertEqual(device.get_pipe_and_input_id(99), (1, 35))
+
+        # Each pipe adds the start of its stripe to the key
+        mapper_keys = {
+            command.key: command.payload
+            for command in device.start_resume_commands
+            if command.key in (set_mapper_key(0, 0).key,
+                               set_mapper_key(1, 0).key)}
+        self.assertEqual(mapper_keys, {
+            set_mapper_key(0, 0).key: 0, set_mapper_key(1, 0).key: 64})
+
+    def test_bad_pipes(self):
+        with self.assertRaises(ConfigurationException):
+            SPIFInputDevice((0, 0), 100, 16)
+        with self.assertRaises(ConfigurationException):
+            SPIFInputDevice((0, 2), 100, 16)
+        with self.assertRaises(ConfigurationException):
+            SPIFInputDevice((0, 1), 16, 16)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,56 @@
+# Copyright (c) 2026 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+from spynnaker.pyNN.config_setup import unittest_setup
+from spynnaker.pyNN.extra_algorithms.traffic_placement_hints import (
+    partition_by_traffic)
+
+
+class TestTrafficPlacementHints(unittest.TestCase):
+
+    def setUp(self):
+        unittest_setup()
+
+    def test_keeps_clusters_together(self):
+        # Two groups that talk a lot within themselves, interleaved
+        vertices = [f"{g}{i}" for i in range(6) for g in "ab"]
+        traffic = {}
+        for g in "ab":
+            for i in range(6):
+                for j in range(i + 1, 6):
+                    traffic[f"{g}{i}", f"{g}{j}"] = 10.0
+        traffic["a0", "b0"] = 1.0
+        sizes = {v: 2 for v in vertices}
+        groups = partition_by_traffic(vertices, traffic, sizes, 12)
+        self.assertEqual(len(groups), 2)
+        for group in groups:
+            self.assertEqual(len({v[0] for v in group}), 1)
+
+    def test_groups_fit(self):
+        vertices = list(range(10))
+        traffic = {(i, i + 1): 1.0 for i in range(9)}
+        sizes = {v: 1 + v % 3 for v in vertices}
+        groups = partition_by_traffic(vertices, traffic, sizes, 5)
+        self.assertEqual(sorted(v for g in groups for v in g), vertices)
+        for group in groups:
+            self.assertLessEqual(sum(sizes[v] for v in group), 5)
+
+    def test_fits_in_one(self):
+        groups = partition_by_traffic(["a", "b"], {}, {"a": 1, "b": 1}, 4)
+        self.assertEqual(groups, [["a", "b"]])
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,87 @@
+# Copyright (c) 2026 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+from unittest import mock
+from spinn_front_end_common.utilities.constants import BYTES_PER_WORD
+from spynnaker.pyNN.config_setup import unittest_setup
+from spynnaker.pyNN.data import SpynnakerDataView
+from spynnaker.pyNN.utilities.bit_field_utilities import (
+    get_bitfield_key_map_data, get_sdram_for_keys)
+
+
+class MockRoutingInfos(object):
+
+    def __init__(self):
+        self.__keys = dict()
+
+    def get_key_from(self, vertex, partition_id):
+        return self.__keys.setdefault(
+            (vertex, partition_id), len(self.__keys) << 16)
+
+
+class MockVertex(object):
+
+    def __init__(self, n_atoms):
+        self.n_atoms = n_atoms
+        self.splitter = None
+        self.machine_vertices = []
+
+
+class MockEdge(object):
+
+    def __init__(self, pre_vertex, n_delay_stages=0):
+        self.pre_vertex = pre_vertex
+        self.n_delay_stages = n_delay_stages
+        self.delay_edge = None
+        if n_delay_stages:
+            self.delay_edge = MockEdge(
+                MockVertex(pre_vertex.n_atoms * n_delay_stages))
+
+
+class MockSynapseInfo(object):
+    partition_id = "SPIKES"
+
+
+class MockProjection(object):
+
+    def __init__(self, n_atoms, n_delay_stages):
+        self._projection_edge = MockEdge(MockVertex(n_atoms), n_delay_stages)
+        self._synapse_information = MockSynapseInfo()
+
+
+class TestBitFieldUtilities(unittest.TestCase):
+
+    def setUp(self):
+        unittest_setup()
+
+    def test_sdram_for_keys_fits_key_map(self):
+        projections = [
+            MockProjection(100, 0), MockProjection(50, 2),
+            MockProjection(10, 0)]
+        # The same edge twice is only counted once
+        projections.append(projections[1])
+        with mock.patch.object(
+                SpynnakerDataView, "get_routing_infos",
+                return_value=MockRoutingInfos()):
+            key_map = get_bitfield_key_map_data(projections)
+        self.assertEqual(
+            get_sdram_for_keys(projections), len(key_map) * BYTES_PER_WORD)
+
+    def test_no_keys(self):
+        self.assertEqual(get_sdram_for_keys([]), 0)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,67 @@
+# Copyright (c) 2026 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+import numpy
+from spynnaker.pyNN.config_setup import unittest_setup
+from spynnaker.pyNN.utilities.expression_compiler import compile_expression
+
+
+class TestExpressionCompiler(unittest.TestCase):
+
+    def setUp(self):
+        unittest_setup()
+
+    def test_index_expression(self):
+        compiled = compile_expression(
+            "exp(-abs(i - j) / 10.0) * (i != j or 1)", ("i", "j"))
+        self.assertIsNone(compiled)
+        compiled = compile_expression(
+            "exp(-abs(i - j) / 10.0)", ("i", "j"))
+        self.assertIsNotNone(compiled)
+        i = numpy.arange(50)[:, None]
+        j = numpy.arange(50)[None, :]
+        self.assertTrue(compiled.matches_probabilities(
+            numpy.exp(-numpy.abs(i - j) / 10.0), i=i, j=j))
+
+    def test_distance_expression(self):
+        compiled = compile_expression(
+            "0.5 * (d <= 3) + min(d**2, 1) / (2 * pi)", ("d", ))
+        d = numpy.arange(41) / 4.0
+        self.assertTrue(compiled.matches_probabilities(
+            0.5 * (d <= 3) + numpy.minimum(d ** 2, 1) / (2 * numpy.pi), d=d))
+        self.assertFalse(compiled.matches_probabilities(
+            0.5 * (d < 3) + numpy.minimum(d ** 2, 1) / (2 * numpy.pi), d=d))
+
+    def test_constants_folded(self):
+        compiled = compile_expression("sqrt(4) / 2 + e - e", ("d", ))
+        self.assertEqual(compiled.n_words, 3)
+        self.assertEqual(list(compiled.data), [2, 0, 1 << 15])
+
+    def test_unsupported(self):
+        for expression in ("log(d)", "d / d", "d ** 1.5", "sin(d)",
+                           "j", "1 < d < 2", "d +"):
+            self.assertIsNone(compile_expression(expression, ("d", )))
+
+    def test_saturation(self):
+        compiled = compile_expression("d * 1000 * 1000 - 1", ("d", ))
+        self.assertEqual(compiled.evaluate(d=numpy.array([1.0]))[0],
+                         65536.0 - 2 ** -15 - 1)
+        compiled = compile_expression("exp(d)", ("d", ))
+        self.assertGreater(compiled.evaluate(d=numpy.array([20.0]))[0],
+                           65535.0)
+
+
+if __name__ == '__main__':
+    unittest.main()
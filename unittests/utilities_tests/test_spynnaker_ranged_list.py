@@ -0,0 +1,59 @@
+# Copyright (c) 2026 The University of Manchester
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+import numpy
+from pyNN.random import RandomDistribution
+from spinn_utilities.ranged import RangedList
+from spynnaker.pyNN.config_setup import unittest_setup
+from spynnaker.pyNN.utilities.ranged import (
+    set_values_by_ids, values_as_array)
+
+
+class TestSpynnakerRangedList(unittest.TestCase):
+
+    def setUp(self):
+        unittest_setup()
+
+    def test_values_as_array(self):
+        values = RangedList(10, 1.0)
+        values.set_value_by_slice(2, 5, 3.0)
+        values.set_value_by_slice(
+            7, 10, RandomDistribution("uniform", [4.0, 5.0]))
+        array = values_as_array(values)
+        self.assertEqual(list(array[:7]), [1, 1, 3, 3, 3, 1, 1])
+        self.assertTrue(all(4.0 <= v <= 5.0 for v in array[7:]))
+        self.assertEqual(
+            list(values_as_array(values, numpy.array([3, 5]))), [3, 1])
+
+    def test_set_values_by_ids(self):
+        values = RangedList(10, 1.0)
+        set_values_by_ids(values, numpy.array([2, 3, 8]),
+                          numpy.array([5.0, 6.0, 7.0]))
+        self.assertEqual(list(values), [1, 1, 5, 6, 1, 1, 1, 1, 7, 1])
+        set_values_by_ids(values, numpy.arange(10), numpy.arange(10.0))
+        self.assertEqual(list(values), list(range(10)))
+
+    def test_set_values_keeps_random(self):
+        values = RangedList(10, 1.0)
+        random = RandomDistribution("uniform", [4.0, 5.0])
+        values.set_value_by_slice(5, 10, random)
+        set_values_by_ids(values, numpy.array([0, 1]),
+                          numpy.array([2.0, 3.0]))
+        self.assertEqual(list(values)[:5], [2, 3, 1, 1, 1])
+        self.assertIs(values[7], random)
+
+
+if __name__ == '__main__':
+    unittest.main()